@@ -21,6 +21,7 @@ set(
   IRODS_LIB_CORE_INCLUDE_HEADERS
   ${CMAKE_SOURCE_DIR}/lib/core/include/alignPointer.hpp
   ${CMAKE_SOURCE_DIR}/lib/core/include/apiHandler.hpp
+  ${CMAKE_SOURCE_DIR}/lib/core/include/api_request_batch.hpp
   ${CMAKE_SOURCE_DIR}/lib/core/include/base64.h
   ${CMAKE_SOURCE_DIR}/lib/core/include/bunUtil.h
   ${CMAKE_SOURCE_DIR}/lib/core/include/chksumUtil.h
@@ -98,6 +99,7 @@ set(
   ${CMAKE_SOURCE_DIR}/lib/core/include/irods_threads.hpp
   ${CMAKE_SOURCE_DIR}/lib/core/include/irods_virtual_path.hpp
   ${CMAKE_SOURCE_DIR}/lib/core/include/key_value_proxy.hpp
+  ${CMAKE_SOURCE_DIR}/lib/core/include/latency_histograms.hpp
   ${CMAKE_SOURCE_DIR}/lib/core/include/lifetime_manager.hpp
   ${CMAKE_SOURCE_DIR}/lib/core/include/lsUtil.h
   ${CMAKE_SOURCE_DIR}/lib/core/include/mcollUtil.h
@@ -150,6 +152,7 @@ set(
   ${CMAKE_SOURCE_DIR}/lib/core/include/rodsUser.h
   ${CMAKE_SOURCE_DIR}/lib/core/include/rsyncUtil.h
   ${CMAKE_SOURCE_DIR}/lib/core/include/scanUtil.h
+  ${CMAKE_SOURCE_DIR}/lib/core/include/shared_memory_hash_table.hpp
   ${CMAKE_SOURCE_DIR}/lib/core/include/shared_memory_object.hpp
   ${CMAKE_SOURCE_DIR}/lib/core/include/sockComm.h
   ${CMAKE_SOURCE_DIR}/lib/core/include/sockCommNetworkInterface.hpp
@@ -158,6 +161,7 @@ set(
   ${CMAKE_SOURCE_DIR}/lib/core/include/stringOpr.h
   ${CMAKE_SOURCE_DIR}/lib/core/include/termiosUtil.hpp
   ${CMAKE_SOURCE_DIR}/lib/core/include/thread_pool.hpp
+  ${CMAKE_SOURCE_DIR}/lib/core/include/transfer_scheduler.hpp
   ${CMAKE_SOURCE_DIR}/lib/core/include/trimUtil.h
   ${CMAKE_SOURCE_DIR}/lib/core/include/user.hpp
   ${CMAKE_SOURCE_DIR}/lib/core/include/user_administration.hpp
@@ -192,12 +196,14 @@ set(
   ${CMAKE_SOURCE_DIR}/lib/api/include/authenticate.h
   ${CMAKE_SOURCE_DIR}/lib/api/include/bulkDataObjPut.h
   ${CMAKE_SOURCE_DIR}/lib/api/include/bulkDataObjReg.h
+  ${CMAKE_SOURCE_DIR}/lib/api/include/bulk_data_object_register.h
   ${CMAKE_SOURCE_DIR}/lib/api/include/chkNVPathPerm.h
   ${CMAKE_SOURCE_DIR}/lib/api/include/chkObjPermAndStat.h
   ${CMAKE_SOURCE_DIR}/lib/api/include/client_hints.h
   ${CMAKE_SOURCE_DIR}/lib/api/include/closeCollection.h
   ${CMAKE_SOURCE_DIR}/lib/api/include/collCreate.h
   ${CMAKE_SOURCE_DIR}/lib/api/include/collRepl.h
+  ${CMAKE_SOURCE_DIR}/lib/api/include/collection_checksum.h
   ${CMAKE_SOURCE_DIR}/lib/api/include/data_object_finalize.h
   ${CMAKE_SOURCE_DIR}/lib/api/include/data_object_modify_info.h
   ${CMAKE_SOURCE_DIR}/lib/api/include/dataCopy.h
@@ -269,6 +275,7 @@ set(
   ${CMAKE_SOURCE_DIR}/lib/api/include/ies_client_hints.h
   ${CMAKE_SOURCE_DIR}/lib/api/include/l3FileGetSingleBuf.h
   ${CMAKE_SOURCE_DIR}/lib/api/include/l3FilePutSingleBuf.h
+  ${CMAKE_SOURCE_DIR}/lib/api/include/list_collection.h
   ${CMAKE_SOURCE_DIR}/lib/api/include/modAVUMetadata.h
   ${CMAKE_SOURCE_DIR}/lib/api/include/modAccessControl.h
   ${CMAKE_SOURCE_DIR}/lib/api/include/modColl.h
@@ -318,6 +325,7 @@ set(
   ${CMAKE_SOURCE_DIR}/lib/api/include/subStructFileUnlink.h
   ${CMAKE_SOURCE_DIR}/lib/api/include/subStructFileWrite.h
   ${CMAKE_SOURCE_DIR}/lib/api/include/syncMountedColl.h
+  ${CMAKE_SOURCE_DIR}/lib/api/include/sync_manifest_diff.h
   ${CMAKE_SOURCE_DIR}/lib/api/include/replica_open.h
   ${CMAKE_SOURCE_DIR}/lib/api/include/replica_close.h
   ${CMAKE_SOURCE_DIR}/lib/api/include/ticketAdmin.h
@@ -484,10 +492,16 @@ set(
   ${CMAKE_SOURCE_DIR}/server/core/include/client_api_whitelist.hpp
   ${CMAKE_SOURCE_DIR}/server/core/include/collection.hpp
   ${CMAKE_SOURCE_DIR}/server/core/include/dataObjOpr.hpp
+  ${CMAKE_SOURCE_DIR}/server/core/include/data_object_finalize_writer.hpp
   ${CMAKE_SOURCE_DIR}/server/core/include/replica_access_table.hpp
   ${CMAKE_SOURCE_DIR}/server/core/include/replica_state_table.hpp
   ${CMAKE_SOURCE_DIR}/server/core/include/fileOpr.hpp
   ${CMAKE_SOURCE_DIR}/server/core/include/finalize_utilities.hpp
+  ${CMAKE_SOURCE_DIR}/server/core/include/hierarchy_resolution_cache.hpp
+  ${CMAKE_SOURCE_DIR}/server/core/include/catalog_permission_cache.hpp
+  ${CMAKE_SOURCE_DIR}/server/core/include/read_ahead_buffer.hpp
+  ${CMAKE_SOURCE_DIR}/server/core/include/bulk_data_object_removal.hpp
+  ${CMAKE_SOURCE_DIR}/server/core/include/collection_checksum.hpp
   ${CMAKE_SOURCE_DIR}/server/core/include/initServer.hpp
   ${CMAKE_SOURCE_DIR}/server/core/include/irodsReServer.hpp
   ${CMAKE_SOURCE_DIR}/server/core/include/irods_api_calling_functions.hpp
@@ -531,7 +545,9 @@ set(
   ${CMAKE_SOURCE_DIR}/server/core/include/objMetaOpr.hpp
   ${CMAKE_SOURCE_DIR}/server/core/include/physPath.hpp
   ${CMAKE_SOURCE_DIR}/server/core/include/procLog.h
+  ${CMAKE_SOURCE_DIR}/server/core/include/quota_usage.hpp
   ${CMAKE_SOURCE_DIR}/server/core/include/resource.hpp
+  ${CMAKE_SOURCE_DIR}/server/core/include/resource_tree_snapshot.hpp
   ${CMAKE_SOURCE_DIR}/server/core/include/rodsAgent.hpp
   ${CMAKE_SOURCE_DIR}/server/core/include/rodsConnect.h
   ${CMAKE_SOURCE_DIR}/server/core/include/rodsServer.hpp
@@ -9,16 +9,17 @@ struct RcComm;
 extern "C" {
 #endif
 
-/// Executes a list of metadata operations on a single object atomically.
+/// Executes a list of metadata operations on one or more objects atomically.
 ///
-/// Sequentially executes all \p operations on \p entity_name as a single transaction. If an
-/// error occurs, all updates are rolled back and an error is returned. \p json_output will
-/// contain specific information about the error.
+/// Executes all \p operations on \p entity_name (or every entity in \p entity_names) as a
+/// single transaction. If an error occurs, all updates are rolled back and an error is
+/// returned. \p json_output will contain specific information about the error.
 ///
 /// \p json_input must have the following JSON structure:
 /// \code{.js}
 /// {
 ///   "entity_name": string,
+///   "entity_names": [string],
 ///   "entity_type": string,
 ///   "operations": [
 ///     {
@@ -31,6 +32,10 @@ extern "C" {
 /// }
 /// \endcode
 ///
+/// Exactly one of \p entity_name and \p entity_names must be present. \p entity_names
+/// applies the same \p operations to many entities of the same \p entity_type. If any of
+/// the entities does not exist or cannot be modified by the user, no entity is modified.
+///
 /// \p entity_name must be one of the following:
 /// - A logical path pointing to a data object.
 /// - A logical path pointing to a collection.
@@ -43,8 +48,10 @@ extern "C" {
 /// - resource
 /// - user
 ///
-/// \p operations is the list of metadata operations to execute atomically. They will be
-/// executed in order.
+/// \p operations is the list of metadata operations to execute atomically. The result is
+/// the same as executing them in order. Operations are grouped by kind and applied to all
+/// entities with a handful of set-based statements, rather than one statement per operation
+/// and entity.
 ///
 /// \p operation must be one of the following:
 /// - add
@@ -69,7 +76,7 @@ extern "C" {
 /// \retval 0        On success.
 /// \retval non-zero On failure.
 ///
-/// \since 4.2.8
+/// \since 4.2.8 (\p entity_names since 4.3.0)
 int rc_atomic_apply_metadata_operations(struct RcComm* _comm, const char* _json_input, char** _json_output);
 
 #ifdef __cplusplus
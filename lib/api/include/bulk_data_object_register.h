@@ -0,0 +1,73 @@
+#ifndef IRODS_BULK_DATA_OBJECT_REGISTER_H
+#define IRODS_BULK_DATA_OBJECT_REGISTER_H
+
+/// \file
+
+struct RcComm;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Registers many existing files as new data objects in a single catalog transaction.
+///
+/// The parent collection of each data object is checked once per collection and the
+/// catalog rows are inserted with multi-row statements, which allows a registration
+/// tool to avoid several round trips per file. Either every data object is registered
+/// or none of them are.
+///
+/// Requires rodsadmin level privileges.
+///
+/// \param[in]  _comm        A pointer to a RcComm.
+/// \param[in]  _json_input  \parblock
+/// A JSON string describing the data objects.
+///
+/// The JSON string must have the following structure:
+/// \code{.js}
+/// {
+///   "data_objects": [
+///     {
+///       "logical_path": string,
+///       "resource_hierarchy": string,
+///       "physical_path": string,
+///       "data_size": integer,
+///       "data_type": string,
+///       "data_mode": string,
+///       "checksum": string
+///     }
+///   ]
+/// }
+/// \endcode
+///
+/// "data_type" defaults to "generic". "data_mode" and "checksum" are optional.
+/// \endparblock
+/// \param[out] _json_output \parblock
+/// A JSON string holding the ID assigned to each data object, in input order.
+///
+/// The JSON string will have the following structure:
+/// \code{.js}
+/// {
+///   "data_objects": [
+///     {
+///       "logical_path": string,
+///       "data_id": integer
+///     }
+///   ]
+/// }
+/// \endcode
+///
+/// The caller must free the string.
+/// \endparblock
+///
+/// \return An integer.
+/// \retval 0        On success.
+/// \retval Non-zero On failure.
+///
+/// \since 4.3.0
+int rc_bulk_data_object_register(struct RcComm* _comm, const char* _json_input, char** _json_output);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // IRODS_BULK_DATA_OBJECT_REGISTER_H
@@ -0,0 +1,103 @@
+#ifndef IRODS_COLLECTION_CHECKSUM_H
+#define IRODS_COLLECTION_CHECKSUM_H
+
+/// \file
+
+struct RcComm;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Verifies or computes the checksums of the replicas under a collection on the server.
+///
+/// The catalog provider runs a checksum job over the collection and all of its sub-collections.
+/// Each call processes the next batch of replicas and returns the replicas which did not verify,
+/// along with the progress of the job. The checksums of a batch are calculated concurrently by the
+/// servers hosting the replicas, with a limit on the number of checksums run at once on each leaf
+/// resource.
+///
+/// \param[in]  _comm        A pointer to a RcComm.
+/// \param[in]  _json_input  \parblock
+/// A JSON string which either starts a job or continues one.
+///
+/// To start a job, the JSON string must have the following structure:
+/// \code{.js}
+/// {
+///   "collection": string,
+///   "verify_only": boolean,
+///   "compute_missing": boolean,
+///   "all_replicas": boolean,
+///   "admin_mode": boolean,
+///   "batch_size": integer
+/// }
+/// \endcode
+///
+/// "collection" is an absolute logical path. If "verify_only" is set, nothing is written to the
+/// catalog. Otherwise, if "compute_missing" is set, the checksums of replicas without one are
+/// computed and registered. "all_replicas" includes stale replicas. "admin_mode" skips permission
+/// checks and requires a privileged user. The booleans default to false. "batch_size" defaults
+/// to 1000 and cannot exceed 10000.
+///
+/// To continue or cancel a job, the JSON string must have the following structure:
+/// \code{.js}
+/// {
+///   "handle": integer,
+///   "close": boolean
+/// }
+/// \endcode
+///
+/// "close" is optional. Jobs are closed automatically once their last batch is processed.
+/// \endparblock
+/// \param[out] _json_output \parblock
+/// A JSON string containing the results of the batch.
+///
+/// The JSON string will have the following structure:
+/// \code{.js}
+/// {
+///   "results": [
+///     {
+///       "logical_path": string,
+///       "replica_number": integer,
+///       "resource_hierarchy": string,
+///       "status": string,
+///       "catalog_checksum": string,
+///       "computed_checksum": string,
+///       "error_code": integer
+///     }
+///   ],
+///   "progress": {
+///     "replicas": integer,
+///     "verified": integer,
+///     "computed": integer,
+///     "missing": integer,
+///     "mismatched": integer,
+///     "failed": integer,
+///     "skipped": integer
+///   },
+///   "handle": integer
+/// }
+/// \endcode
+///
+/// "status" is "mismatch", "missing", "computed" or "error". Replicas whose checksum verified are
+/// only counted in "progress", which holds the totals of the job so far. Locked and intermediate
+/// replicas are counted as "skipped".
+///
+/// "handle" is only present if more replicas may remain. The caller must free the string.
+///
+/// Special collections (e.g. mounted collections) and collections of other zones are not
+/// supported.
+/// \endparblock
+///
+/// \return An integer.
+/// \retval 0        On success.
+/// \retval Non-zero On failure.
+///
+/// \since 4.3.0
+int rc_collection_checksum(struct RcComm* _comm, const char* _json_input, char** _json_output);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // IRODS_COLLECTION_CHECKSUM_H
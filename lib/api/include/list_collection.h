@@ -0,0 +1,89 @@
+#ifndef IRODS_LIST_COLLECTION_H
+#define IRODS_LIST_COLLECTION_H
+
+/// \file
+
+struct RcComm;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Lists the contents of a collection in pages of compact entries.
+///
+/// The server runs one catalog query for the data objects and one for the sub-collections
+/// of the collection and streams their rows through an open listing. Each call returns the
+/// next page. The replicas of a data object are folded into a single entry.
+///
+/// \param[in]  _comm        A pointer to a RcComm.
+/// \param[in]  _json_input  \parblock
+/// A JSON string which either opens a listing or continues one.
+///
+/// To open a listing, the JSON string must have the following structure:
+/// \code{.js}
+/// {
+///   "collection": string,
+///   "columns": [string],
+///   "sort": string,
+///   "descending": boolean,
+///   "page_size": integer
+/// }
+/// \endcode
+///
+/// "collection" is an absolute logical path. "columns" holds the properties to return for each
+/// entry in addition to its type and name. It may contain "id", "size", "ctime", "mtime", "owner",
+/// "data_type", "mode", "replicas" and "checksum", and defaults to no additional properties.
+/// "sort" is one of "name", "size" or "mtime" and defaults to "name". "page_size" defaults to 1000
+/// and cannot exceed 10000.
+///
+/// To continue or close a listing, the JSON string must have the following structure:
+/// \code{.js}
+/// {
+///   "handle": integer,
+///   "close": boolean
+/// }
+/// \endcode
+///
+/// "close" is optional. Listings are closed automatically once their last page is returned.
+/// \endparblock
+/// \param[out] _json_output \parblock
+/// A JSON string containing the next page.
+///
+/// The JSON string will have the following structure:
+/// \code{.js}
+/// {
+///   "columns": [string],
+///   "entries": [
+///     [string, string, ...]
+///   ],
+///   "handle": integer
+/// }
+/// \endcode
+///
+/// "columns" names the elements of every entry: "type", "name" and then the requested columns.
+/// "type" is "d" for data objects and "c" for collections. "name" is the last element of the
+/// logical path. Properties which do not apply to an entry (e.g. the size of a collection) are
+/// null. "replicas" is the number of replicas. The size, modification time and checksum of a data
+/// object are those of its most recently modified good replica. Data objects are listed before
+/// collections.
+///
+/// "handle" is only present if more entries may remain, so the last page may be empty. The
+/// caller must free the string.
+///
+/// Special collections (e.g. mounted collections) and collections whose path contains a single
+/// quote are not supported. SYS_NOT_SUPPORTED is returned for them and the caller is expected to
+/// use rcOpenCollection instead.
+/// \endparblock
+///
+/// \return An integer.
+/// \retval 0        On success.
+/// \retval Non-zero On failure.
+///
+/// \since 4.3.0
+int rc_list_collection(struct RcComm* _comm, const char* _json_input, char** _json_output);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // IRODS_LIST_COLLECTION_H
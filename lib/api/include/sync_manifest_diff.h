@@ -0,0 +1,76 @@
+#ifndef IRODS_SYNC_MANIFEST_DIFF_H
+#define IRODS_SYNC_MANIFEST_DIFF_H
+
+/// \file
+
+struct RcComm;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Compares a manifest of local files against the catalog and returns only the
+/// entries that need to be transferred.
+///
+/// The server resolves every collection named by the manifest in a small number of
+/// catalog queries, which allows a synchronization tool to avoid a round trip per file.
+///
+/// \param[in]  _comm        A pointer to a RcComm.
+/// \param[in]  _json_input  \parblock
+/// A JSON string containing the manifest.
+///
+/// The JSON string must have the following structure:
+/// \code{.js}
+/// {
+///   "collection": string,
+///   "comparison": string,
+///   "collections": [string],
+///   "entries": [
+///     {
+///       "path": string,
+///       "size": integer,
+///       "mtime": integer,
+///       "checksum": string
+///     }
+///   ]
+/// }
+/// \endcode
+///
+/// "collection" is the absolute path of the target collection. All other paths are
+/// relative to it. "comparison" is one of "size", "size_and_mtime" or "checksum"
+/// and defaults to "checksum". "mtime" and "checksum" are optional.
+/// \endparblock
+/// \param[out] _json_output \parblock
+/// A JSON string describing the differences.
+///
+/// The JSON string will have the following structure:
+/// \code{.js}
+/// {
+///   "missing_collections": [string],
+///   "entries": [
+///     {
+///       "path": string,
+///       "reason": string,
+///       "data_size": integer,
+///       "checksum": string
+///     }
+///   ]
+/// }
+/// \endcode
+///
+/// "reason" is one of "missing", "stale", "size", "mtime", "checksum", "no_checksum",
+/// "checksum_scheme" or "unresolved". The caller must free the string.
+/// \endparblock
+///
+/// \return An integer.
+/// \retval 0        On success.
+/// \retval Non-zero On failure.
+///
+/// \since 4.3.0
+int rc_sync_manifest_diff(struct RcComm* _comm, const char* _json_input, char** _json_output);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // IRODS_SYNC_MANIFEST_DIFF_H
@@ -0,0 +1,131 @@
+#ifndef IRODS_API_REQUEST_BATCH_HPP
+#define IRODS_API_REQUEST_BATCH_HPP
+
+/// \file
+
+#include "rodsDef.h"
+
+#include <vector>
+
+/// Forward declaration of the underlying connection type.
+struct RcComm;
+
+namespace irods::experimental
+{
+    /// Sends many independent API requests to the server in one message and reads the
+    /// replies as they are streamed back.
+    ///
+    /// \parblock
+    /// Every request sent with procApiRequest costs a full round trip. A batch pays for a
+    /// single round trip regardless of the number of requests it holds, which makes a large
+    /// difference for clients issuing many small requests (stats, metadata and permission
+    /// changes) over high latency links.
+    ///
+    /// The server executes the requests in the order they were added, one after another,
+    /// exactly as if each had been sent on its own. Each request is authorized and may fail
+    /// independently of the others. The batch is not a transaction.
+    ///
+    /// Only requests which receive a single reply may be batched. APIs which exchange further
+    /// messages with the client, such as parallel transfers and collection operations which
+    /// report progress, are answered with SYS_NOT_SUPPORTED without being executed.
+    ///
+    /// Requires the batch_api_requests API plugin on the client and the server.
+    /// \endparblock
+    ///
+    /// \since 4.3.0
+    class api_request_batch
+    {
+    public:
+        /// Options which control how the server executes a batch.
+        ///
+        /// \since 4.3.0
+        struct options
+        {
+            /// If true, the requests following the first failed request are not executed.
+            /// Their status is SYS_BATCH_REQUEST_SKIPPED.
+            bool stop_on_error = false;
+        }; // struct options
+
+        api_request_batch() = default;
+
+        api_request_batch(const api_request_batch&) = delete;
+        auto operator=(const api_request_batch&) -> api_request_batch& = delete;
+
+        api_request_batch(api_request_batch&&) = default;
+        auto operator=(api_request_batch&&) -> api_request_batch& = default;
+
+        ~api_request_batch() = default;
+
+        /// Appends a request to the batch.
+        ///
+        /// The arguments have the same meaning as the arguments of procApiRequest. The
+        /// pointers must remain valid until \ref execute returns. Output structures are
+        /// allocated by \ref execute and must be freed by the caller, as with procApiRequest.
+        ///
+        /// \param[in]  _api_number The API number of the request.
+        /// \param[in]  _input      The input structure, or nullptr if the API takes none.
+        /// \param[in]  _input_bs   The input byte stream, or nullptr if the API takes none.
+        /// \param[out] _output     Receives the output structure, or nullptr if the API returns none.
+        /// \param[out] _output_bs  Receives the output byte stream, or nullptr if the API returns none.
+        ///
+        /// \since 4.3.0
+        auto add(int _api_number,
+                 const void* _input,
+                 const bytesBuf_t* _input_bs = nullptr,
+                 void** _output = nullptr,
+                 bytesBuf_t* _output_bs = nullptr) -> api_request_batch&;
+
+        /// Returns the number of requests in the batch.
+        ///
+        /// \since 4.3.0
+        auto size() const noexcept -> std::size_t;
+
+        /// Returns whether the batch holds no requests.
+        ///
+        /// \since 4.3.0
+        auto empty() const noexcept -> bool;
+
+        /// Removes all requests from the batch.
+        ///
+        /// \since 4.3.0
+        auto clear() noexcept -> void;
+
+        /// Sends the requests to the server and reads every reply.
+        ///
+        /// Error messages returned by the server for the requests are collected in the
+        /// connection's error stack, in request order.
+        ///
+        /// \param[in] _comm    The connection to send the requests on.
+        /// \param[in] _options The options which control how the server executes the batch.
+        ///
+        /// \throws irods::exception If the batch could not be sent, was rejected by the server,
+        ///                          or a request could not be packed. No request was executed
+        ///                          if the batch was rejected.
+        ///
+        /// \return The status of each request, in the order the requests were added.
+        ///
+        /// \since 4.3.0
+        auto execute(RcComm& _comm, const options& _options) -> std::vector<int>;
+
+        /// Sends the requests to the server with the default options and reads every reply.
+        ///
+        /// \see execute(RcComm&, const options&)
+        ///
+        /// \since 4.3.0
+        auto execute(RcComm& _comm) -> std::vector<int>;
+
+    private:
+        struct request
+        {
+            int api_number;
+            const void* input;
+            const bytesBuf_t* input_bs;
+            void** output;
+            bytesBuf_t* output_bs;
+        }; // struct request
+
+        std::vector<request> requests_;
+    }; // class api_request_batch
+} // namespace irods::experimental
+
+#endif // IRODS_API_REQUEST_BATCH_HPP
@@ -6,12 +6,39 @@
 #include <memory>
 #include <vector>
 #include <mutex>
-#include <atomic>
+#include <condition_variable>
+#include <thread>
+#include <chrono>
 #include <string>
 #include <functional>
 
 namespace irods
 {
+    /// \brief The sizing and maintenance policy of a connection_pool.
+    ///
+    /// \since 4.3.0
+    struct connection_pool_options
+    {
+        /// The number of connections created on construction. Idle connections are
+        /// never closed below this number. Must be at least one.
+        int min_size = 1;
+
+        /// The maximum number of connections. New connections are created on demand
+        /// while all existing connections are in use. get_connection() blocks once
+        /// this number of connections is in use.
+        int max_size = 1;
+
+        /// Connections which have not been used for this long are closed, down to
+        /// \p min_size. Zero disables shrinking.
+        std::chrono::seconds idle_timeout{0};
+
+        /// How often a background thread checks that idle connections are still
+        /// alive. Dead connections are replaced before they are handed out. Zero
+        /// disables the background thread, in which case connections are checked
+        /// every time they are handed out.
+        std::chrono::seconds health_check_interval{0};
+    }; // struct connection_pool_options
+
     class connection_pool
     {
     public:
@@ -54,22 +81,40 @@ namespace irods
                         const std::string& _zone,
                         const int _refresh_time);
 
+        /// \since 4.3.0
+        connection_pool(const connection_pool_options& _options,
+                        const std::string& _host,
+                        const int _port,
+                        const std::string& _username,
+                        const std::string& _zone,
+                        const int _refresh_time);
+
         connection_pool(const connection_pool&) = delete;
         connection_pool& operator=(const connection_pool&) = delete;
 
+        ~connection_pool();
+
+        // Blocks until a connection is available.
         connection_proxy get_connection();
 
+        /// \brief Waits up to \p _timeout for a connection to become available.
+        ///
+        /// \return A connection proxy which evaluates to false if the timeout expired.
+        ///
+        /// \since 4.3.0
+        connection_proxy try_get_connection(std::chrono::milliseconds _timeout);
+
     private:
         using connection_pointer = std::unique_ptr<rcComm_t, int(*)(rcComm_t*)>;
+        using clock_type = std::chrono::steady_clock;
 
         struct connection_context
         {
-            std::mutex mutex{};
-            std::atomic<bool> in_use{};
-            bool refresh{};
+            bool in_use{};
             connection_pointer conn{nullptr, rcDisconnect};
             rErrMsg_t error{};
             std::time_t creation_time{};
+            clock_type::time_point last_used{};
         };
 
         void create_connection(int _index,
@@ -80,20 +125,43 @@ namespace irods
 
         bool verify_connection(int _index);
 
+        bool is_expired(int _index) const noexcept;
+
+        // Claims a connection context. The caller must hold mutex_.
+        int acquire_context() noexcept;
+
+        connection_proxy make_proxy(int _index);
+
         void return_connection(int _index);
 
         void release_connection(int _index);
 
+        void run_maintenance();
+
+        void maintain_idle_connections();
+
         const std::string host_;
         const int port_;
         const std::string username_;
         const std::string zone_;
         const int refresh_time_;
+        const connection_pool_options options_;
+
+        // Holds max_size contexts. Contexts without a connection are slots the pool
+        // may grow into.
         std::vector<connection_context> conn_ctxs_;
+
+        std::mutex mutex_;
+        std::condition_variable available_;
+        std::condition_variable stop_requested_;
+        bool stop_;
+        std::thread maintenance_thread_;
     };
 
     std::shared_ptr<connection_pool> make_connection_pool(int size = 1);
+
+    /// \since 4.3.0
+    std::shared_ptr<connection_pool> make_connection_pool(const connection_pool_options& _options);
 } // namespace irods
 
 #endif // IRODS_CONNECTION_POOL_HPP
-
@@ -44,7 +44,8 @@ namespace irods::experimental::net::dns_cache
     ///
     /// \return A boolean value.
     /// \retval true  If a new entry was inserted.
-    /// \retval false If an existing entry was updated.
+    /// \retval false If an existing entry was updated or the entry could not be stored
+    ///               (e.g. \p _key is longer than 255 characters).
     ///
     /// \since 4.2.9
     auto insert_or_assign(const std::string_view _key,
@@ -15,6 +15,7 @@
 
 // =-=-=-=-=-=-=-
 // stl includes
+#include <algorithm>
 #include <sstream>
 #include <string>
 #include <iostream>
@@ -261,10 +262,12 @@ namespace irods::experimental::api {
           , uint64_t           total
           , locking_json&      b_board
           , thread_pool&       t_pool
-          , flag_type&         e_flag) :
+          , flag_type&         e_flag
+          , bool               estimated = false) :
             exit_flag_{e_flag}
           , count_{}
           , total_{total}
+          , estimated_{estimated}
           , blackboard_{b_board}
         {
             try {
@@ -272,7 +275,19 @@ namespace irods::experimental::api {
                 thread_pool::post(t_pool, [&]() {
                     while(!exit_flag_ && !complete()) {
                         sleep();
-                        auto t = static_cast<uint64_t>(100*(double)count_/(double)total_);
+
+                        const uint64_t total = total_;
+                        if(0 == total) {
+                            continue;
+                        }
+
+                        auto t = static_cast<uint64_t>(100*(double)count_/(double)total);
+
+                        // an estimated total may still grow, never report completion early
+                        if(estimated_) {
+                            t = std::min<uint64_t>(t, 99);
+                        }
+
                         blackboard_.update({{constants::progress, std::to_string(t)}});
                     }
                 });
@@ -286,12 +301,19 @@ namespace irods::experimental::api {
 
         void operator++(int) { count_++; }
 
-        bool complete() const { return count_ >= total_; }
+        // grow the total of an estimated progress handler as work is discovered
+        void add_to_estimate(uint64_t n) { total_ += n; }
+
+        // the total is now known to be whatever has been counted so far
+        void finalize() { total_ = count_.load(); estimated_ = false; }
+
+        bool complete() const { return !estimated_ && count_ >= total_; }
 
     private:
         flag_type&           exit_flag_;
         std::atomic_uint64_t count_;
         std::atomic_uint64_t total_;
+        std::atomic_bool     estimated_;
         locking_json&        blackboard_;
     }; // class progress_handler
 
@@ -13,6 +13,9 @@ namespace irods
     extern const std::string CFG_PAM_PASSWORD_MIN_TIME_KW;
     extern const std::string CFG_PAM_PASSWORD_MAX_TIME_KW;
 
+    extern const std::string CFG_DB_HOST_KW;
+    extern const std::string CFG_DB_PORT_KW;
+    extern const std::string CFG_DB_NAME_KW;
     extern const std::string CFG_DB_USERNAME_KW;
     extern const std::string CFG_DB_PASSWORD_KW;
     extern const std::string CFG_DB_SSLMODE_KW;
@@ -64,6 +67,11 @@ namespace irods
     extern const std::string CFG_MAX_TEMP_PASSWORD_LIFETIME;
     extern const std::string CFG_MAX_NUMBER_OF_CONCURRENT_RE_PROCS;
     extern const std::string DEFAULT_LOG_ROTATION_IN_DAYS;
+    extern const std::string CFG_CATALOG_OBJECT_ID_BLOCK_SIZE_KW;
+    extern const std::string CFG_QUOTA_ACCOUNTING_MODE_KW;
+    extern const std::string CFG_MAX_READ_AHEAD_BUFFER_SIZE_KW;
+    extern const std::string CFG_NUMBER_OF_CONCURRENT_BULK_REMOVAL_THREADS_KW;
+    extern const std::string CFG_NUMBER_OF_CONCURRENT_CHECKSUM_OPERATIONS_PER_RESOURCE_KW;
 
     extern const std::string CFG_RE_CACHE_SALT_KW;
     extern const std::string CFG_RE_SERVER_SLEEP_TIME;
@@ -71,6 +79,9 @@ namespace irods
 
     extern const std::string CFG_DNS_CACHE_KW;
     extern const std::string CFG_HOSTNAME_CACHE_KW;
+    extern const std::string CFG_HIERARCHY_RESOLUTION_CACHE_KW;
+    extern const std::string CFG_CATALOG_PERMISSION_CACHE_KW;
+    extern const std::string CFG_RESOURCE_TREE_SNAPSHOT_KW;
 
     extern const std::string CFG_SHARED_MEMORY_SIZE_IN_BYTES_KW;
     extern const std::string CFG_EVICTION_AGE_IN_SECONDS_KW;
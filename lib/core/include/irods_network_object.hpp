@@ -60,6 +60,11 @@ namespace irods {
                 return socket_handle_;
             }
 
+            // the protocol negotiated by the startup pack of the connection
+            virtual irodsProt_t protocol() const {
+                return protocol_;
+            }
+
             // =-=-=-=-=-=-=-
             // Mutators
             virtual void socket_handle( int _s ) {
@@ -70,6 +75,7 @@ namespace irods {
             // =-=-=-=-=-=-=-
             // Attributes
             int socket_handle_; // socket descriptor
+            irodsProt_t protocol_; // negotiated protocol
 
     }; // network_object
 
@@ -21,6 +21,7 @@
 #include "irods_error.hpp"
 #include "irods_lookup_table.hpp"
 #include "irods_plugin_context.hpp"
+#include "latency_histograms.hpp"
 
 static double PLUGIN_INTERFACE_VERSION = 2.0;
 
@@ -167,6 +168,7 @@ namespace irods
                 using adapted_func_type = std::function<error(plugin_context&, std::string*, types_t...)>;
                 
                 adapted_func_type adapted_fcn = [this, &_operation_name](plugin_context& _ctx, std::string* _out_param, types_t... _t) {
+                    experimental::latency_histograms::scoped_timer timer{_operation_name};
                     _ctx.rule_results( *_out_param );
                     typedef std::function<error(plugin_context&,types_t...)> fcn_t;
                     fcn_t& fcn = boost::any_cast< fcn_t& >( operations_[ _operation_name ] );
@@ -170,6 +170,42 @@ namespace irods
     /// \since 4.2.9
     auto get_hostname_cache_eviction_age() noexcept -> int;
 
+    /// Returns the hierarchy resolution cache eviction age from server_config.json.
+    ///
+    /// \return An integer representing seconds.
+    /// \retval 0                If an error occurred or the age was less than zero (i.e. the cache is disabled).
+    /// \retval Configured-Value Otherwise.
+    ///
+    /// \since 4.3.0
+    auto get_hierarchy_resolution_cache_eviction_age() noexcept -> int;
+
+    /// Returns the catalog permission cache eviction age from server_config.json.
+    ///
+    /// \return An integer representing seconds.
+    /// \retval 0                If an error occurred or the age was less than zero (i.e. the cache is disabled).
+    /// \retval Configured-Value Otherwise.
+    ///
+    /// \since 4.3.0
+    auto get_catalog_permission_cache_eviction_age() noexcept -> int;
+
+    /// Returns the amount of shared memory that should be allocated for the resource tree snapshot.
+    ///
+    /// \return An integer representing the size in bytes.
+    /// \retval 10000000         If an error occurred or the size was less than or equal to zero.
+    /// \retval Configured-Value Otherwise.
+    ///
+    /// \since 4.3.0
+    auto get_resource_tree_snapshot_shared_memory_size() noexcept -> int;
+
+    /// Returns the resource tree snapshot eviction age from server_config.json.
+    ///
+    /// \return An integer representing seconds.
+    /// \retval 300              If an error occurred or the age was less than zero.
+    /// \retval Configured-Value Otherwise.
+    ///
+    /// \since 4.3.0
+    auto get_resource_tree_snapshot_eviction_age() noexcept -> int;
+
     /// Parses hosts_config.json into a JSON object if available and stores it in the server
     /// property map with key \p irods::HOSTS_CONFIG_JSON_OBJECT_KW.
     ///
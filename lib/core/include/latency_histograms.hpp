@@ -0,0 +1,189 @@
+#ifndef IRODS_LATENCY_HISTOGRAMS_HPP
+#define IRODS_LATENCY_HISTOGRAMS_HPP
+
+/// \file
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/// Server-wide latency histograms of API requests and plugin operations.
+///
+/// \parblock
+/// The histograms live in shared memory created by the server on startup and inherited
+/// by every agent, so they aggregate the latencies observed by all agents for the lifetime
+/// of the server. Each histogram is keyed by an API number or an operation name.
+///
+/// Latencies are counted in log-linear buckets in the manner of HDR histograms. Every power
+/// of two between 1 microsecond and roughly 18 minutes is split into four buckets, which
+/// bounds the relative error of a reported latency to 25%. Shorter latencies share the
+/// first bucket and longer latencies share the last bucket.
+///
+/// Recording a latency takes a few relaxed atomic increments. When the histograms have not
+/// been initialized (e.g. in client processes), recording does nothing.
+/// \endparblock
+///
+/// \since 4.3.0
+namespace irods::experimental::latency_histograms
+{
+    /// The kinds of work which are timed.
+    ///
+    /// \since 4.3.0
+    enum class category
+    {
+        api,
+        plugin_operation,
+        database_operation
+    }; // enum class category
+
+    /// A copy of a single histogram.
+    ///
+    /// \since 4.3.0
+    struct histogram
+    {
+        /// A bucket holding the latencies below \p upper_bound and at or above the upper
+        /// bound of the previous bucket. The upper bound of the last bucket is
+        /// std::chrono::nanoseconds::max().
+        struct bucket
+        {
+            std::chrono::nanoseconds upper_bound;
+            std::uint64_t count;
+        }; // struct bucket
+
+        // The kind of work which was timed.
+        category kind;
+
+        // The API number. Zero unless \p kind is category::api.
+        int api_number;
+
+        // The API operation name or the plugin operation name.
+        std::string name;
+
+        std::uint64_t count;
+        std::chrono::nanoseconds sum;
+
+        // The non-empty buckets, in increasing order of their upper bound.
+        std::vector<bucket> buckets;
+    }; // struct histogram
+
+    /// Creates the histograms.
+    ///
+    /// This function should only be called on startup of the server.
+    ///
+    /// \param[in] _shm_name   The name of the shared memory to create.
+    /// \param[in] _max_series The maximum number of histograms. Latencies of API numbers and
+    ///                        operations seen after this number is reached are not recorded.
+    ///
+    /// \since 4.3.0
+    auto init(const std::string_view _shm_name = "irods_latency_histograms",
+              std::size_t _max_series = 1024) -> void;
+
+    /// Cleans up any resources created via init().
+    ///
+    /// This function must be called from the same process that called init().
+    ///
+    /// \since 4.3.0
+    auto deinit() noexcept -> void;
+
+    /// Returns whether the histograms are available to this process.
+    ///
+    /// \since 4.3.0
+    auto enabled() noexcept -> bool;
+
+    /// Records the latency of an API request.
+    ///
+    /// \param[in] _api_number The API number of the request.
+    /// \param[in] _api_name   The operation name of the API. Only used the first time the API
+    ///                        number is seen.
+    /// \param[in] _latency    The time spent handling the request.
+    ///
+    /// \since 4.3.0
+    auto record_api(int _api_number, const std::string& _api_name, std::chrono::nanoseconds _latency) noexcept -> void;
+
+    /// Records the latency of a plugin operation.
+    ///
+    /// Operations of database plugins (those named "database_*") are recorded under
+    /// category::database_operation.
+    ///
+    /// \param[in] _operation_name The name of the plugin operation.
+    /// \param[in] _latency        The time spent in the operation.
+    ///
+    /// \since 4.3.0
+    auto record_plugin_operation(const std::string& _operation_name, std::chrono::nanoseconds _latency) noexcept -> void;
+
+    /// Returns a copy of every histogram.
+    ///
+    /// \since 4.3.0
+    auto histograms() -> std::vector<histogram>;
+
+    /// Returns every histogram in the Prometheus text exposition format.
+    ///
+    /// \param[in] _host If not empty, added to every sample as the "host" label.
+    ///
+    /// \since 4.3.0
+    auto to_prometheus_text(const std::string_view _host = {}) -> std::string;
+
+    /// Records the time between its construction and its destruction.
+    ///
+    /// Reads no clock if the histograms are not enabled.
+    ///
+    /// \since 4.3.0
+    class scoped_timer
+    {
+    public:
+        /// Times an API request.
+        ///
+        /// The arguments must outlive the timer.
+        scoped_timer(int _api_number, const std::string& _api_name) noexcept
+            : api_number_{_api_number}
+            , name_{&_api_name}
+            , start_{now()}
+        {
+        }
+
+        /// Times a plugin operation.
+        ///
+        /// The argument must outlive the timer.
+        explicit scoped_timer(const std::string& _operation_name) noexcept
+            : api_number_{-1}
+            , name_{&_operation_name}
+            , start_{now()}
+        {
+        }
+
+        scoped_timer(const scoped_timer&) = delete;
+        auto operator=(const scoped_timer&) -> scoped_timer& = delete;
+
+        ~scoped_timer()
+        {
+            if (clock_type::time_point{} == start_) {
+                return;
+            }
+
+            const auto latency = clock_type::now() - start_;
+
+            if (api_number_ >= 0) {
+                record_api(api_number_, *name_, latency);
+            }
+            else {
+                record_plugin_operation(*name_, latency);
+            }
+        }
+
+    private:
+        using clock_type = std::chrono::steady_clock;
+
+        static auto now() noexcept -> clock_type::time_point
+        {
+            return enabled() ? clock_type::now() : clock_type::time_point{};
+        }
+
+        const int api_number_;
+        const std::string* name_;
+        const clock_type::time_point start_;
+    }; // class scoped_timer
+} // namespace irods::experimental::latency_histograms
+
+#endif // IRODS_LATENCY_HISTOGRAMS_HPP
@@ -129,6 +129,16 @@ int unpack_struct(const void *inPackStr,
                   irodsProt_t irodsProt,
                   const char* peer_version);
 
+/// Same as unpack_struct, but never reads past the first \p inPackLen bytes of
+/// \p inPackStr. Required for BINARY_PROT input, whose strings carry their own length.
+int unpack_struct_with_length(const void *inPackStr,
+                              int inPackLen,
+                              void **outStruct,
+                              const char *packInstName,
+                              const packInstruct_t *myPackTable,
+                              irodsProt_t irodsProt,
+                              const char* peer_version);
+
 #ifdef __cplusplus
 } // extern "C"
 #endif
@@ -140,6 +140,19 @@ typedef struct {
     char* acl_string;
     int kv_pass;
     char* kv_pass_string;
+
+    // =-=-=-=-=-=-=-
+    // concurrent recursive transfers
+    int concurrent;
+    int concurrentValue;
+    int threadBudget;
+    int threadBudgetValue;
+    int bandwidthLimit;
+    int bandwidthLimitValue; // MB per second
+
+    // =-=-=-=-=-=-=-
+    // manifest based irsync
+    int manifest;
 } rodsArguments_t;
 
 #ifdef __cplusplus
@@ -128,7 +128,8 @@
 /* protocol */
 typedef enum iRODSProtocol {
     NATIVE_PROT,
-    XML_PROT
+    XML_PROT,
+    BINARY_PROT     /* little-endian, length-prefixed strings, binary message headers */
 } irodsProt_t;
 
 /* myRead/myWrite type */
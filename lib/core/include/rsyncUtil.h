@@ -44,6 +44,10 @@ rsyncDirToCollUtil( rcComm_t *conn, rodsPath_t *srcPath,
                     rodsPath_t *targPath, rodsEnv *myRodsEnv, rodsArguments_t *myRodsArgs,
                     dataObjInp_t *dataObjOprInp );
 int
+rsyncDirToCollBulkUtil( rcComm_t *conn, rodsPath_t *srcPath,
+                        rodsPath_t *targPath, rodsEnv *myRodsEnv, rodsArguments_t *myRodsArgs,
+                        dataObjInp_t *dataObjOprInp );
+int
 rsyncCollToCollUtil( rcComm_t *conn, rodsPath_t *srcPath,
                      rodsPath_t *targPath, rodsEnv *myRodsEnv, rodsArguments_t *myRodsArgs,
                      dataObjCopyInp_t *dataObjCopyInp );
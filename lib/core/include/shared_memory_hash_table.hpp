@@ -0,0 +1,414 @@
+#ifndef IRODS_SHARED_MEMORY_HASH_TABLE_HPP
+#define IRODS_SHARED_MEMORY_HASH_TABLE_HPP
+
+/// \file
+
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/interprocess/sync/interprocess_mutex.hpp>
+#include <boost/interprocess/sync/scoped_lock.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace irods::experimental::interprocess
+{
+    /// A fixed-capacity hash table of string keys to trivially copyable values which lives in
+    /// shared memory and is shared by a process and its children.
+    ///
+    /// \parblock
+    /// The table is split into shards. Each shard is an open-addressing table with linear probing
+    /// and its own process-shared mutex, which is only taken by writers. Readers never lock.
+    /// Each slot carries a sequence number which writers make odd while they modify the slot.
+    /// Readers copy the slot and retry if the sequence number was odd or changed during the copy.
+    ///
+    /// Entries are stored in place, so the table never allocates after construction. When every
+    /// slot a key may occupy is in use, the entry closest to expiration is replaced.
+    /// \endparblock
+    ///
+    /// \tparam Value The mapped type. Must be trivially copyable.
+    ///
+    /// \since 4.3.0
+    template <typename Value>
+    class shared_memory_hash_table
+    {
+    public:
+        static_assert(std::is_trivially_copyable_v<Value>);
+        static_assert(std::atomic<std::uint32_t>::is_always_lock_free);
+
+        /// The maximum length of a key. Longer keys are never stored.
+        static constexpr std::size_t max_key_size = 255;
+
+        /// Creates the table in a new shared memory object, replacing any existing object
+        /// with the same name.
+        ///
+        /// \param[in] _shm_name The name of the shared memory object.
+        /// \param[in] _shm_size The size of the shared memory object in bytes.
+        ///
+        /// \throws std::runtime_error If \p _shm_size cannot hold a single entry.
+        shared_memory_hash_table(const std::string_view _shm_name, std::size_t _shm_size)
+            : shm_name_{_shm_name}
+            , shm_{}
+            , region_{}
+            , header_{}
+            , slots_{}
+        {
+            namespace bi = boost::interprocess;
+
+            const auto slot_count = (_shm_size > slots_offset()) ? (_shm_size - slots_offset()) / sizeof(slot) : 0;
+
+            if (0 == slot_count) {
+                throw std::runtime_error{"shared memory hash table: size is too small"};
+            }
+
+            bi::shared_memory_object::remove(shm_name_.data());
+
+            shm_ = bi::shared_memory_object{bi::create_only, shm_name_.data(), bi::read_write};
+            shm_.truncate(_shm_size);
+            region_ = bi::mapped_region{shm_, bi::read_write};
+
+            auto* base = static_cast<char*>(region_.get_address());
+            header_ = new (base) table_header{};
+            header_->shard_count = std::min(slot_count, max_shard_count);
+            header_->shard_capacity = slot_count / header_->shard_count;
+
+            slots_ = reinterpret_cast<slot*>(base + slots_offset());
+
+            for (std::size_t i = 0; i < capacity(); ++i) {
+                new (&slots_[i]) slot{};
+            }
+        }
+
+        shared_memory_hash_table(const shared_memory_hash_table&) = delete;
+        auto operator=(const shared_memory_hash_table&) -> shared_memory_hash_table& = delete;
+
+        /// Removes the shared memory object. The mapping stays valid until the table is destroyed.
+        auto remove() noexcept -> void
+        {
+            header_->~table_header();
+            boost::interprocess::shared_memory_object::remove(shm_name_.data());
+        }
+
+        /// Inserts a new entry or replaces the entry for \p _key.
+        ///
+        /// \return A boolean value.
+        /// \retval true  If a new entry was inserted.
+        /// \retval false If an existing entry was updated or \p _key is too long to be stored.
+        auto insert_or_assign(const std::string_view _key, std::int64_t _expiration, const Value& _value) -> bool
+        {
+            if (_key.size() > max_key_size) {
+                return false;
+            }
+
+            const auto hash = hash_key(_key);
+            auto& shard = header_->shards[shard_index(hash)];
+
+            boost::interprocess::scoped_lock lk{shard.mutex};
+
+            slot* free_slot{};
+            slot* victim{};
+
+            for_each_probe(hash, [&](slot& _slot) {
+                if (slot_state::occupied == _slot.state) {
+                    if (_slot.hash == hash && _key == _slot.key) {
+                        victim = &_slot;
+                        return false;
+                    }
+
+                    if (!victim || _slot.expiration < victim->expiration) {
+                        victim = &_slot;
+                    }
+
+                    return true;
+                }
+
+                if (!free_slot) {
+                    free_slot = &_slot;
+                }
+
+                // Keys are never stored past an empty slot.
+                return slot_state::tombstone == _slot.state;
+            });
+
+            const bool updated = victim && slot_state::occupied == victim->state &&
+                                 victim->hash == hash && _key == victim->key;
+
+            auto* target = (!updated && free_slot) ? free_slot : victim;
+
+            if (target == free_slot) {
+                shard.size.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            write(*target, [&] {
+                target->state = slot_state::occupied;
+                target->hash = hash;
+                target->expiration = _expiration;
+                std::memset(target->key, 0, sizeof(target->key));
+                std::memcpy(target->key, _key.data(), _key.size());
+                target->value = _value;
+            });
+
+            return !updated;
+        }
+
+        /// Returns the value for \p _key if it exists and has not expired.
+        auto lookup(const std::string_view _key, std::int64_t _now) const -> std::optional<Value>
+        {
+            if (_key.size() > max_key_size) {
+                return std::nullopt;
+            }
+
+            const auto hash = hash_key(_key);
+            std::optional<Value> value;
+
+            for_each_probe(hash, [&](const slot& _slot) {
+                slot_state state;
+                std::uint64_t h;
+
+                read(_slot, [&] {
+                    state = _slot.state;
+                    h = _slot.hash;
+                });
+
+                if (slot_state::empty == state) {
+                    return false;
+                }
+
+                if (slot_state::occupied != state || h != hash) {
+                    return true;
+                }
+
+                char key[max_key_size + 1];
+                std::int64_t expiration;
+                Value v;
+
+                read(_slot, [&] {
+                    state = _slot.state;
+                    h = _slot.hash;
+                    expiration = _slot.expiration;
+                    std::memcpy(key, _slot.key, sizeof(key));
+                    std::memcpy(static_cast<void*>(&v), &_slot.value, sizeof(Value));
+                });
+
+                if (slot_state::occupied != state || h != hash || _key != key) {
+                    return true;
+                }
+
+                if (_now < expiration) {
+                    value = v;
+                }
+
+                return false;
+            });
+
+            return value;
+        }
+
+        /// Removes the entry for \p _key.
+        auto erase(const std::string_view _key) -> void
+        {
+            if (_key.size() > max_key_size) {
+                return;
+            }
+
+            const auto hash = hash_key(_key);
+            auto& shard = header_->shards[shard_index(hash)];
+
+            boost::interprocess::scoped_lock lk{shard.mutex};
+
+            for_each_probe(hash, [&](slot& _slot) {
+                if (slot_state::empty == _slot.state) {
+                    return false;
+                }
+
+                if (slot_state::occupied == _slot.state && _slot.hash == hash && _key == _slot.key) {
+                    write(_slot, [&_slot] { _slot.state = slot_state::tombstone; });
+                    shard.size.fetch_sub(1, std::memory_order_relaxed);
+                    return false;
+                }
+
+                return true;
+            });
+        }
+
+        /// Removes every entry which expired at or before \p _now.
+        auto erase_expired_entries(std::int64_t _now) -> void
+        {
+            erase_if([_now](const slot& _slot) { return _now >= _slot.expiration; });
+        }
+
+        /// Removes every entry.
+        auto clear() -> void
+        {
+            erase_if([](const slot&) { return true; });
+        }
+
+        /// Returns the number of entries, including expired entries which have not been erased.
+        auto size() const noexcept -> std::size_t
+        {
+            std::size_t n = 0;
+
+            for (std::size_t i = 0; i < header_->shard_count; ++i) {
+                n += header_->shards[i].size.load(std::memory_order_relaxed);
+            }
+
+            return n;
+        }
+
+        /// Returns the number of bytes held by unused slots.
+        auto available_memory() const noexcept -> std::size_t
+        {
+            return (capacity() - size()) * sizeof(slot);
+        }
+
+    private:
+        static constexpr std::size_t max_shard_count = 16;
+
+        // Keys are looked up within this many slots of their home slot.
+        static constexpr std::size_t max_probe_length = 32;
+
+        enum class slot_state : std::uint32_t
+        {
+            empty,
+            occupied,
+            tombstone
+        }; // enum class slot_state
+
+        struct slot
+        {
+            std::atomic<std::uint32_t> sequence{};
+            slot_state state{};
+            std::uint64_t hash{};
+            std::int64_t expiration{};
+            char key[max_key_size + 1]{};
+            Value value{};
+        }; // struct slot
+
+        struct shard_header
+        {
+            boost::interprocess::interprocess_mutex mutex;
+            std::atomic<std::size_t> size{};
+        }; // struct shard_header
+
+        struct table_header
+        {
+            std::size_t shard_count{};
+            std::size_t shard_capacity{};
+            shard_header shards[max_shard_count];
+        }; // struct table_header
+
+        static constexpr auto slots_offset() noexcept -> std::size_t
+        {
+            return (sizeof(table_header) + alignof(slot) - 1) / alignof(slot) * alignof(slot);
+        }
+
+        // FNV-1a. The hash must not depend on the process.
+        static auto hash_key(const std::string_view _key) noexcept -> std::uint64_t
+        {
+            std::uint64_t h = 14695981039346656037ULL;
+
+            for (unsigned char c : _key) {
+                h ^= c;
+                h *= 1099511628211ULL;
+            }
+
+            return h;
+        }
+
+        auto capacity() const noexcept -> std::size_t
+        {
+            return header_->shard_count * header_->shard_capacity;
+        }
+
+        auto shard_index(std::uint64_t _hash) const noexcept -> std::size_t
+        {
+            return _hash % header_->shard_count;
+        }
+
+        // Invokes _func on the slots a key with the hash may occupy, in probe order, until
+        // _func returns false.
+        template <typename Function>
+        auto for_each_probe(std::uint64_t _hash, Function _func) const -> void
+        {
+            const auto cap = header_->shard_capacity;
+            auto* shard_slots = slots_ + shard_index(_hash) * cap;
+            const auto home = (_hash / header_->shard_count) % cap;
+
+            for (std::size_t i = 0, n = std::min(cap, max_probe_length); i < n; ++i) {
+                if (!_func(shard_slots[(home + i) % cap])) {
+                    return;
+                }
+            }
+        }
+
+        // Removes the entries for which _pred returns true.
+        template <typename Predicate>
+        auto erase_if(Predicate _pred) -> void
+        {
+            for (std::size_t i = 0; i < header_->shard_count; ++i) {
+                auto& shard = header_->shards[i];
+
+                boost::interprocess::scoped_lock lk{shard.mutex};
+
+                auto* shard_slots = slots_ + i * header_->shard_capacity;
+
+                for (std::size_t j = 0; j < header_->shard_capacity; ++j) {
+                    if (auto& s = shard_slots[j]; slot_state::occupied == s.state && _pred(s)) {
+                        write(s, [&s] { s.state = slot_state::tombstone; });
+                        shard.size.fetch_sub(1, std::memory_order_relaxed);
+                    }
+                }
+            }
+        }
+
+        // Copies from the slot with _copy until the copy is consistent.
+        template <typename Function>
+        static auto read(const slot& _slot, Function _copy) -> void
+        {
+            for (;;) {
+                const auto begin = _slot.sequence.load(std::memory_order_acquire);
+
+                if (begin & 1) {
+                    continue;
+                }
+
+                _copy();
+
+                std::atomic_thread_fence(std::memory_order_acquire);
+
+                if (_slot.sequence.load(std::memory_order_relaxed) == begin) {
+                    return;
+                }
+            }
+        }
+
+        // Modifies the slot with _modify. The caller must hold the shard's mutex.
+        template <typename Function>
+        static auto write(slot& _slot, Function _modify) -> void
+        {
+            const auto seq = _slot.sequence.load(std::memory_order_relaxed);
+            _slot.sequence.store(seq + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+
+            _modify();
+
+            _slot.sequence.store(seq + 2, std::memory_order_release);
+        }
+
+        const std::string shm_name_;
+        boost::interprocess::shared_memory_object shm_;
+        boost::interprocess::mapped_region region_;
+        table_header* header_;
+        slot* slots_;
+    }; // class shared_memory_hash_table
+} // namespace irods::experimental::interprocess
+
+#endif // IRODS_SHARED_MEMORY_HASH_TABLE_HPP
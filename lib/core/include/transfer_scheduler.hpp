@@ -0,0 +1,152 @@
+#ifndef IRODS_TRANSFER_SCHEDULER_HPP
+#define IRODS_TRANSFER_SCHEDULER_HPP
+
+#include "rcConnect.h"
+#include "rodsDef.h"
+#include "getRodsEnv.h"
+#include "parseCommandLine.h"
+#include "connection_pool.hpp"
+#include "thread_pool.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace irods
+{
+    // Runs data object transfers concurrently over a pool of connections.
+    //
+    // A single-threaded directory/collection walker feeds the scheduler through
+    // schedule(). Each worker owns one pooled connection for its lifetime and
+    // runs one transfer at a time. Large transfers may additionally borrow portal
+    // threads from a thread budget that is shared by all workers, and an optional
+    // bandwidth limit is applied across every transfer.
+    //
+    // Restart state is recorded in the order transfers were scheduled. The restart
+    // file only ever names a path for which that transfer, and every transfer
+    // scheduled before it, completed successfully.
+    class transfer_scheduler
+    {
+    public:
+        struct options
+        {
+            // Number of pooled connections (and therefore concurrent transfers).
+            int connections = 4;
+
+            // Total number of transfer threads (worker + portal) allowed at any
+            // moment. Zero means "connections + portal_threads".
+            int thread_budget = 0;
+
+            // Portal threads requested for large transfers. Zero lets the server
+            // decide, NO_THREADING disables portal parallelism.
+            int portal_threads = AUTO_THREADING;
+
+            // Transfers larger than this many bytes are considered large.
+            rodsLong_t large_file_threshold = 32 * 1024 * 1024;
+
+            // Aggregate bandwidth limit in bytes per second. Zero means unlimited.
+            rodsLong_t bandwidth_limit = 0;
+
+            // Invoked once for every pooled connection before its first transfer
+            // (e.g. to attach a session ticket).
+            std::function<void(rcComm_t&)> on_connect;
+        };
+
+        // Performs a single transfer. _num_threads is the number of portal
+        // threads granted to the transfer and should be copied into
+        // dataObjInp_t::numThreads.
+        using transfer_function = std::function<int(rcComm_t& _conn, int _num_threads)>;
+
+        // _progress_conn is the connection whose operProgress is reported through
+        // gGuiProgressCB. _restart may be null.
+        transfer_scheduler(const options& _opts,
+                           rcComm_t& _progress_conn,
+                           rodsRestart_t* _restart);
+
+        transfer_scheduler(const transfer_scheduler&) = delete;
+        transfer_scheduler& operator=(const transfer_scheduler&) = delete;
+
+        ~transfer_scheduler();
+
+        // Queues a transfer. Blocks while the work queue is full. Returns the
+        // first error encountered by the workers if the scheduler has stopped
+        // accepting work, otherwise zero.
+        int schedule(const std::string& _restart_path, rodsLong_t _size, transfer_function _func);
+
+        // Runs _check with the restart state locked and returns its result. The
+        // workers update the restart state as transfers complete, so the walker
+        // must only read or update it through here (e.g. chkStateForResume).
+        int check_restart_state(const std::function<int()>& _check);
+
+        // Waits for all queued transfers to finish and stops the workers.
+        // Returns the last error encountered, or zero.
+        int wait();
+
+    private:
+        struct work_item
+        {
+            std::uint64_t sequence;
+            std::string restart_path;
+            rodsLong_t size;
+            transfer_function func;
+        };
+
+        void run_worker();
+
+        // Drops all queued work and makes schedule() fail from now on.
+        void stop_accepting_work();
+
+        int acquire_threads(rodsLong_t _size);
+        void release_threads(int _count);
+
+        void throttle(rodsLong_t _size);
+
+        void complete(const work_item& _item, int _status);
+
+        const options opts_;
+        const int thread_budget_;
+        const std::size_t max_queue_size_;
+
+        rcComm_t& progress_conn_;
+        rodsRestart_t* restart_;
+
+        std::shared_ptr<connection_pool> conn_pool_;
+
+        std::mutex queue_mutex_;
+        std::condition_variable queue_not_empty_;
+        std::condition_variable queue_not_full_;
+        std::deque<work_item> queue_;
+        std::uint64_t next_sequence_;
+        bool done_;
+
+        std::mutex threads_mutex_;
+        std::condition_variable threads_available_;
+        int threads_in_use_;
+
+        std::mutex bandwidth_mutex_;
+        std::chrono::steady_clock::time_point next_send_time_;
+
+        // Protects the restart state, the progress counters and the status.
+        std::mutex completion_mutex_;
+        std::uint64_t next_to_record_;
+        std::map<std::uint64_t, std::string> completed_out_of_order_;
+        bool restart_blocked_;
+        int status_;
+
+        thread_pool workers_;
+        bool joined_;
+    }; // class transfer_scheduler
+
+    // Builds scheduler options from the icommand arguments (--concurrent,
+    // --thread-budget, --bwlimit and -N) and the client environment.
+    auto make_transfer_scheduler_options(const rodsArguments_t& _args, const rodsEnv& _env)
+        -> transfer_scheduler::options;
+} // namespace irods
+
+#endif // IRODS_TRANSFER_SCHEDULER_HPP
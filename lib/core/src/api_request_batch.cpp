@@ -0,0 +1,193 @@
+#include "api_request_batch.hpp"
+
+#include "api_plugin_number.h"
+#include "irods_at_scope_exit.hpp"
+#include "irods_client_api_table.hpp"
+#include "irods_exception.hpp"
+#include "packStruct.h"
+#include "procApiRequest.h"
+#include "rcConnect.h"
+#include "rcGlobalExtern.h"
+#include "rcMisc.h"
+#include "rodsErrorTable.h"
+
+#include "fmt/format.h"
+
+#include <arpa/inet.h>
+
+#include <cstdint>
+#include <string>
+
+namespace
+{
+    // Must match the flags understood by the batch_api_requests API plugin.
+    constexpr std::uint32_t stop_on_error_flag = 0x1;
+
+    auto append_uint32(std::string& _buffer, std::uint32_t _value) -> void
+    {
+        const auto value = htonl(_value);
+        _buffer.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    } // append_uint32
+
+    auto append_bytes(std::string& _buffer, const bytesBuf_t* _bbuf) -> void
+    {
+        if (_bbuf && _bbuf->buf && _bbuf->len > 0) {
+            _buffer.append(static_cast<const char*>(_bbuf->buf), _bbuf->len);
+        }
+    } // append_bytes
+
+    auto length_of(const bytesBuf_t* _bbuf) noexcept -> std::uint32_t
+    {
+        return (_bbuf && _bbuf->buf && _bbuf->len > 0) ? _bbuf->len : 0;
+    } // length_of
+
+    // procApiReply replaces the connection's error stack with the error stack of each reply.
+    // This moves the messages of the latest reply into _errors so that none are lost.
+    auto collect_errors(rcComm_t& _comm, rError_t*& _errors) -> void
+    {
+        if (!_comm.rError) {
+            return;
+        }
+
+        if (!_errors) {
+            _errors = _comm.rError;
+        }
+        else {
+            replErrorStack(_comm.rError, _errors);
+            freeRError(_comm.rError);
+        }
+
+        _comm.rError = nullptr;
+    } // collect_errors
+} // anonymous namespace
+
+namespace irods::experimental
+{
+    auto api_request_batch::add(int _api_number,
+                                const void* _input,
+                                const bytesBuf_t* _input_bs,
+                                void** _output,
+                                bytesBuf_t* _output_bs) -> api_request_batch&
+    {
+        requests_.push_back({_api_number, _input, _input_bs, _output, _output_bs});
+        return *this;
+    } // add
+
+    auto api_request_batch::size() const noexcept -> std::size_t
+    {
+        return requests_.size();
+    } // size
+
+    auto api_request_batch::empty() const noexcept -> bool
+    {
+        return requests_.empty();
+    } // empty
+
+    auto api_request_batch::clear() noexcept -> void
+    {
+        requests_.clear();
+    } // clear
+
+    auto api_request_batch::execute(RcComm& _comm, const options& _options) -> std::vector<int>
+    {
+        if (requests_.empty()) {
+            return {};
+        }
+
+        const int batch_api_index = apiTableLookup(BATCH_API_REQUESTS_APN);
+
+        if (batch_api_index < 0) {
+            THROW(batch_api_index, "The batch_api_requests API plugin is not available.");
+        }
+
+        auto& api_table = irods::get_client_api_table();
+
+        std::vector<int> api_indices;
+        api_indices.reserve(requests_.size());
+
+        std::string batch;
+        append_uint32(batch, _options.stop_on_error ? stop_on_error_flag : 0);
+        append_uint32(batch, static_cast<std::uint32_t>(requests_.size()));
+
+        for (auto&& r : requests_) {
+            const int api_index = apiTableLookup(r.api_number);
+
+            if (api_index < 0) {
+                THROW(api_index, fmt::format("Unknown API number [{}].", r.api_number));
+            }
+
+            const auto& api = api_table[api_index];
+
+            // A reply which cannot be stored would not be read, which would leave the
+            // connection out of sync with the server.
+            if ((api->outPackInstruct && !r.output) || (api->outBsFlag > 0 && !r.output_bs)) {
+                THROW(USER_API_INPUT_ERR, fmt::format("Missing output parameter for API number [{}].", r.api_number));
+            }
+
+            bytesBuf_t* packed_input{};
+            irods::at_scope_exit free_packed_input{[&packed_input] { freeBBuf(packed_input); }};
+
+            if (api->inPackInstruct) {
+                if (!r.input) {
+                    THROW(USER_API_INPUT_ERR, fmt::format("Missing input for API number [{}].", r.api_number));
+                }
+
+                const auto ec = pack_struct(r.input, &packed_input, api->inPackInstruct, RodsPackTable,
+                                            0, _comm.irodsProt, _comm.svrVersion->relVersion);
+
+                if (ec < 0) {
+                    THROW(ec, fmt::format("Failed to pack input for API number [{}].", r.api_number));
+                }
+            }
+
+            const auto* input_bs = (api->inBsFlag > 0) ? r.input_bs : nullptr;
+
+            append_uint32(batch, static_cast<std::uint32_t>(r.api_number));
+            append_uint32(batch, length_of(packed_input));
+            append_uint32(batch, length_of(input_bs));
+            append_bytes(batch, packed_input);
+            append_bytes(batch, input_bs);
+
+            api_indices.push_back(api_index);
+        }
+
+        freeRError(_comm.rError);
+        _comm.rError = nullptr;
+
+        bytesBuf_t input{static_cast<int>(batch.size()), batch.data()};
+
+        if (const auto ec = sendApiRequest(&_comm, batch_api_index, &input, nullptr); ec < 0) {
+            THROW(ec, "Failed to send batch request.");
+        }
+
+        _comm.apiInx = batch_api_index;
+
+        // The server accepts or rejects the batch as a whole before replying to any request.
+        if (const auto ec = readAndProcApiReply(&_comm, batch_api_index, nullptr, nullptr); ec < 0) {
+            THROW(ec, "Batch request was rejected.");
+        }
+
+        rError_t* errors{};
+
+        std::vector<int> statuses;
+        statuses.reserve(requests_.size());
+
+        for (std::size_t i = 0; i < requests_.size(); ++i) {
+            const auto& r = requests_[i];
+
+            _comm.apiInx = api_indices[i];
+            statuses.push_back(readAndProcApiReply(&_comm, api_indices[i], r.output, r.output_bs));
+
+            collect_errors(_comm, errors);
+        }
+
+        _comm.rError = errors;
+
+        return statuses;
+    } // execute
+
+    auto api_request_batch::execute(RcComm& _comm) -> std::vector<int>
+    {
+        return execute(_comm, options{});
+    } // execute
+} // namespace irods::experimental
@@ -3,6 +3,8 @@
 #include "irods_query.hpp"
 #include "thread_pool.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <stdexcept>
 #include <thread>
 
@@ -87,14 +89,32 @@ namespace irods
                                      const std::string& _username,
                                      const std::string& _zone,
                                      const int _refresh_time)
+        : connection_pool{connection_pool_options{_size, _size}, _host, _port, _username, _zone, _refresh_time}
+    {
+    }
+
+    connection_pool::connection_pool(const connection_pool_options& _options,
+                                     const std::string& _host,
+                                     const int _port,
+                                     const std::string& _username,
+                                     const std::string& _zone,
+                                     const int _refresh_time)
         : host_{_host}
         , port_{_port}
         , username_{_username}
         , zone_{_zone}
         , refresh_time_(_refresh_time)
-        , conn_ctxs_(_size)
+        , options_{_options}
+        , conn_ctxs_(std::max(0, _options.max_size))
+        , mutex_{}
+        , available_{}
+        , stop_requested_{}
+        , stop_{}
+        , maintenance_thread_{}
     {
-        if (_size < 1) {
+        const auto size = options_.min_size;
+
+        if (size < 1 || options_.max_size < size) {
             throw std::runtime_error{"invalid connection pool size"};
         }
 
@@ -105,38 +125,51 @@ namespace irods
                           [] { throw std::runtime_error{"connect error"}; },
                           [] { throw std::runtime_error{"client login error"}; });
 
-        // If the size of the pool is one, then return immediately.
-        if (_size == 1) {
-            return;
-        }
-
         // Initialize the rest of the connection pool asynchronously.
+        if (size > 1) {
+            irods::thread_pool thread_pool{std::min<int>(size, std::thread::hardware_concurrency())};
+
+            std::atomic<bool> connect_error{};
+            std::atomic<bool> login_error{};
+
+            for (int i = 1; i < size; ++i) {
+                irods::thread_pool::post(thread_pool, [this, i, &connect_error, &login_error] {
+                    if (connect_error.load() || login_error.load()) {
+                        return;
+                    }
+
+                    create_connection(i,
+                                      [&connect_error] { connect_error.store(true); },
+                                      [&login_error] { login_error.store(true); });
+                });
+            }
 
-        irods::thread_pool thread_pool{std::min<int>(_size, std::thread::hardware_concurrency())};
-
-        std::atomic<bool> connect_error{};
-        std::atomic<bool> login_error{};
+            thread_pool.join();
 
-        for (int i = 1; i < _size; ++i) {
-            irods::thread_pool::post(thread_pool, [this, i, &connect_error, &login_error] {
-                if (connect_error.load() || login_error.load()) {
-                    return;
-                }
+            if (connect_error.load()) {
+                throw std::runtime_error{"connect error"};
+            }
 
-                create_connection(i,
-                                  [&connect_error] { connect_error.store(true); },
-                                  [&login_error] { login_error.store(true); });
-            });
+            if (login_error.load()) {
+                throw std::runtime_error{"client login error"};
+            }
         }
 
-        thread_pool.join();
-
-        if (connect_error.load()) {
-            throw std::runtime_error{"connect error"};
+        if (options_.health_check_interval.count() > 0 || options_.idle_timeout.count() > 0) {
+            maintenance_thread_ = std::thread{[this] { run_maintenance(); }};
         }
+    }
 
-        if (login_error.load()) {
-            throw std::runtime_error{"client login error"};
+    connection_pool::~connection_pool()
+    {
+        if (maintenance_thread_.joinable()) {
+            {
+                std::lock_guard<std::mutex> lock{mutex_};
+                stop_ = true;
+            }
+
+            stop_requested_.notify_all();
+            maintenance_thread_.join();
         }
     }
 
@@ -146,6 +179,7 @@ namespace irods
     {
         auto& ctx = conn_ctxs_[_index];
         ctx.creation_time = std::time(nullptr);
+        ctx.last_used = clock_type::now();
         ctx.conn.reset(rcConnect(host_.c_str(),
                                  port_,
                                  username_.c_str(),
@@ -163,6 +197,11 @@ namespace irods
         }
     }
 
+    bool connection_pool::is_expired(int _index) const noexcept
+    {
+        return std::time(nullptr) - conn_ctxs_[_index].creation_time > refresh_time_;
+    }
+
     bool connection_pool::verify_connection(int _index)
     {
         auto& ctx = conn_ctxs_[_index];
@@ -173,7 +212,7 @@ namespace irods
 
         try {
             query<rcComm_t>{ctx.conn.get(), "select ZONE_NAME where ZONE_TYPE = 'local'"};
-            if (std::time(nullptr) - ctx.creation_time > refresh_time_) {
+            if (is_expired(_index)) {
                 return false;
             }
         }
@@ -189,12 +228,14 @@ namespace irods
         auto& ctx = conn_ctxs_[_index];
         ctx.error = {};
 
-        if (ctx.refresh) {
-            ctx.refresh = false;
-            ctx.conn.release();
-        }
+        // When the background thread checks idle connections, only the age of the
+        // connection needs to be checked here. Otherwise, the connection is checked
+        // with a round trip to the server.
+        const auto healthy = (options_.health_check_interval.count() > 0)
+            ? (ctx.conn && !is_expired(_index))
+            : verify_connection(_index);
 
-        if (!verify_connection(_index)) {
+        if (!healthy) {
             create_connection(_index,
                               [] { throw std::runtime_error{"connect error"}; },
                               [] { throw std::runtime_error{"client login error"}; });
@@ -203,31 +244,176 @@ namespace irods
         return ctx.conn.get();
     }
 
-    connection_pool::connection_proxy connection_pool::get_connection()
+    int connection_pool::acquire_context() noexcept
     {
-        for (int i = 0;; i = ++i % conn_ctxs_.size()) {
-            std::unique_lock<std::mutex> lock{conn_ctxs_[i].mutex, std::defer_lock};
+        const int size = conn_ctxs_.size();
 
-            if (lock.try_lock()) {
-                if (!conn_ctxs_[i].in_use.load()) {
-                    conn_ctxs_[i].in_use.store(true);
-                    return {*this, *refresh_connection(i), i};
-                }
+        // Prefer existing connections over growing the pool.
+        for (int i = 0; i < size; ++i) {
+            if (auto& ctx = conn_ctxs_[i]; !ctx.in_use && ctx.conn) {
+                ctx.in_use = true;
+                return i;
+            }
+        }
+
+        for (int i = 0; i < size; ++i) {
+            if (auto& ctx = conn_ctxs_[i]; !ctx.in_use) {
+                ctx.in_use = true;
+                return i;
+            }
+        }
+
+        return connection_proxy::uninitialized_index;
+    }
+
+    connection_pool::connection_proxy connection_pool::make_proxy(int _index)
+    {
+        try {
+            return {*this, *refresh_connection(_index), _index};
+        }
+        catch (...) {
+            {
+                std::lock_guard<std::mutex> lock{mutex_};
+                conn_ctxs_[_index].conn.reset();
+                conn_ctxs_[_index].in_use = false;
             }
+
+            available_.notify_one();
+
+            throw;
         }
     }
 
+    connection_pool::connection_proxy connection_pool::get_connection()
+    {
+        std::unique_lock<std::mutex> lock{mutex_};
+
+        int index = connection_proxy::uninitialized_index;
+        available_.wait(lock, [this, &index] {
+            return (index = acquire_context()) != connection_proxy::uninitialized_index;
+        });
+
+        lock.unlock();
+
+        return make_proxy(index);
+    }
+
+    connection_pool::connection_proxy connection_pool::try_get_connection(std::chrono::milliseconds _timeout)
+    {
+        std::unique_lock<std::mutex> lock{mutex_};
+
+        int index = connection_proxy::uninitialized_index;
+        const auto acquired = available_.wait_for(lock, _timeout, [this, &index] {
+            return (index = acquire_context()) != connection_proxy::uninitialized_index;
+        });
+
+        if (!acquired) {
+            return {};
+        }
+
+        lock.unlock();
+
+        return make_proxy(index);
+    }
+
     void connection_pool::return_connection(int _index)
     {
-        conn_ctxs_[_index].in_use.store(false);
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            conn_ctxs_[_index].in_use = false;
+            conn_ctxs_[_index].last_used = clock_type::now();
+        }
+
+        available_.notify_one();
     }
 
     void connection_pool::release_connection(int _index)
     {
-        conn_ctxs_[_index].refresh = true;
+        std::lock_guard<std::mutex> lock{mutex_};
         conn_ctxs_[_index].conn.release();
     }
 
+    void connection_pool::run_maintenance()
+    {
+        // Wake up often enough to honor both the health check interval and the idle timeout.
+        auto interval = options_.health_check_interval;
+
+        if (interval.count() == 0 || (options_.idle_timeout.count() > 0 && options_.idle_timeout < interval)) {
+            interval = options_.idle_timeout;
+        }
+
+        std::unique_lock<std::mutex> lock{mutex_};
+
+        while (!stop_requested_.wait_for(lock, interval, [this] { return stop_; })) {
+            lock.unlock();
+            maintain_idle_connections();
+            lock.lock();
+        }
+    }
+
+    void connection_pool::maintain_idle_connections()
+    {
+        std::vector<int> checked;
+        std::vector<connection_pointer> closed;
+
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+
+            const auto now = clock_type::now();
+            auto open = std::count_if(std::begin(conn_ctxs_), std::end(conn_ctxs_), [](const auto& _ctx) {
+                return static_cast<bool>(_ctx.conn);
+            });
+
+            for (int i = 0; i < static_cast<int>(conn_ctxs_.size()); ++i) {
+                auto& ctx = conn_ctxs_[i];
+
+                if (ctx.in_use || !ctx.conn) {
+                    continue;
+                }
+
+                if (options_.idle_timeout.count() > 0 &&
+                    now - ctx.last_used >= options_.idle_timeout &&
+                    open > options_.min_size)
+                {
+                    closed.push_back(std::move(ctx.conn));
+                    --open;
+                }
+                else if (options_.health_check_interval.count() > 0) {
+                    // Claim the connection so that it is not handed out while it is checked.
+                    ctx.in_use = true;
+                    checked.push_back(i);
+                }
+            }
+        }
+
+        // Disconnect outside of the lock.
+        closed.clear();
+
+        for (auto i : checked) {
+            if (!verify_connection(i)) {
+                auto& ctx = conn_ctxs_[i];
+                ctx.conn.reset();
+                ctx.error = {};
+
+                // On failure, the context is left empty and the connection is created
+                // again when it is needed.
+                create_connection(i, [] {}, [&ctx] { ctx.conn.reset(); });
+            }
+        }
+
+        if (!checked.empty()) {
+            {
+                std::lock_guard<std::mutex> lock{mutex_};
+
+                for (auto i : checked) {
+                    conn_ctxs_[i].in_use = false;
+                }
+            }
+
+            available_.notify_all();
+        }
+    }
+
     std::shared_ptr<connection_pool> make_connection_pool(int size)
     {
         rodsEnv env{};
@@ -240,5 +426,18 @@ namespace irods
             env.rodsZone,
             env.irodsConnectionPoolRefreshTime);
     }
+
+    std::shared_ptr<connection_pool> make_connection_pool(const connection_pool_options& _options)
+    {
+        rodsEnv env{};
+        _getRodsEnv(env);
+        return std::make_shared<irods::connection_pool>(
+            _options,
+            env.rodsHost,
+            env.rodsPort,
+            env.rodsUserName,
+            env.rodsZone,
+            env.irodsConnectionPoolRefreshTime);
+    }
 } // namespace irods
 
@@ -1,153 +1,135 @@
 #include "dns_cache.hpp"
 
-#include <boost/interprocess/managed_shared_memory.hpp>
-#include <boost/interprocess/shared_memory_object.hpp>
-#include <boost/interprocess/containers/map.hpp>
-#include <boost/interprocess/containers/string.hpp>
-#include <boost/interprocess/containers/list.hpp>
-#include <boost/interprocess/allocators/allocator.hpp>
-#include <boost/interprocess/sync/named_sharable_mutex.hpp>
-#include <boost/interprocess/sync/scoped_lock.hpp>
-#include <boost/interprocess/sync/sharable_lock.hpp>
+#include "shared_memory_hash_table.hpp"
 
 #include <cstring>
+#include <cstdlib>
 #include <utility>
 #include <algorithm>
 
 #include <sys/types.h>
 #include <unistd.h>
+#include <netinet/in.h>
 
 namespace
 {
-    namespace bi = boost::interprocess;
+    namespace ipc = irods::experimental::interprocess;
 
     using std::chrono::duration_cast;
     using std::chrono::seconds;
 
-    struct address_info;
-
-    // clang-format off
-    using segment_manager_type         = bi::managed_shared_memory::segment_manager;
-    using void_allocator_type          = bi::allocator<void, segment_manager_type>;
-    using char_allocator_type          = bi::allocator<char, segment_manager_type>;
-    using address_info_allocator_type  = bi::allocator<address_info, segment_manager_type>;
-    using key_type                     = bi::basic_string<char, std::char_traits<char>, char_allocator_type>;
-    using mapped_type                  = bi::list<address_info, address_info_allocator_type>;
-    using value_type                   = std::pair<const key_type, mapped_type>;
-    using value_allocator_type         = bi::allocator<value_type, segment_manager_type>;
-    using map_type                     = bi::map<key_type, mapped_type, std::less<key_type>, value_allocator_type>;
-    using clock_type                   = std::chrono::system_clock;
-    // clang-format on
+    using clock_type = std::chrono::system_clock;
+
+    // The shared memory type of addrinfo. Entries are stored in place, so the number of
+    // addresses and the size of each address are bounded.
+    struct address_info
+    {
+        // getaddrinfo() returns one node per socket type for every address of the host.
+        static constexpr int max_addresses = 16;
+
+        // Large enough for IPv4 and IPv6 addresses.
+        static constexpr std::size_t max_address_size = sizeof(sockaddr_in6);
+
+        struct address
+        {
+            int flags;
+            int family;
+            int socktype;
+            int protocol;
+            socklen_t addrlen;
+            char addr[max_address_size];
+            bool has_addr;
+        }; // struct address
+
+        int count;
+        int canonname_index; // The index of the node holding canonname, or -1.
+        char canonname[256]; // FQDN are 253 characters long.
+        address addresses[max_addresses];
+    }; // struct address_info
+
+    using table_type = ipc::shared_memory_hash_table<address_info>;
 
     //
     // Global Variables
     //
 
-    // The following variables define the names of shared memory objects and other properties.
-    std::string g_segment_name;
-    std::size_t g_segment_size;
-    std::string g_mutex_name;
-
-    // On initialization, holds the PID of the process that initialized the hostname cache.
+    // On initialization, holds the PID of the process that initialized the DNS cache.
     // This ensures that only the process that initialized the system can deinitialize it.
     pid_t g_owner_pid;
 
-    // The following are pointers to the shared memory objects and allocator.
-    // Allocating on the heap allows us to know when the hostname cache is constructed/destructed.
-    std::unique_ptr<bi::managed_shared_memory> g_segment;
-    std::unique_ptr<void_allocator_type> g_allocator;
-    std::unique_ptr<bi::named_sharable_mutex> g_mutex;
-    map_type* g_map;
+    // Allocating on the heap allows us to know when the DNS cache is constructed/destructed.
+    // Child processes inherit the mapping of the shared memory.
+    std::unique_ptr<table_type> g_table;
 
-    // The shared memory type of addrinfo.
-    struct address_info
+    // Returns false if the addrinfo cannot be stored in place.
+    auto make_address_info(const addrinfo& _info, address_info& _out) -> bool
     {
-        address_info(const addrinfo& _info, seconds _expires_after)
-            : flags{_info.ai_flags}
-            , family{_info.ai_family}
-            , socktype{_info.ai_socktype}
-            , protocol{_info.ai_protocol}
-            , addrlen{_info.ai_addrlen}
-            , addr{}
-            , canonname{}
-            , expiration{}
-            , expires_after{_expires_after.count()}
-        {
-            if (_info.ai_addr) {
-                addr = static_cast<sockaddr*>(g_segment->allocate(sizeof(sockaddr)));
-                std::memcpy(addr.get(), _info.ai_addr, sizeof(sockaddr));
-            }
-
-            if (_info.ai_canonname) {
-                const auto size = std::strlen(_info.ai_canonname);
-                canonname = static_cast<char*>(g_segment->allocate(sizeof(char) * size + 1));
-                std::strncpy(canonname.get(), _info.ai_canonname, size);
-                canonname[size] = 0;
-            }
+        std::memset(&_out, 0, sizeof(address_info));
+        _out.canonname_index = -1;
 
-            const auto tp = clock_type::now() + _expires_after;
-            expiration = duration_cast<seconds>(tp.time_since_epoch()).count();
-        }
-
-        address_info(const address_info&) = default;
-        auto operator=(const address_info&) -> address_info& = default;
-
-        address_info(address_info&&) = default;
-        auto operator=(address_info&&) -> address_info& = default;
-
-        ~address_info()
-        {
-            if (!g_segment) {
-                return;
+        for (const auto* p = &_info; p; p = p->ai_next) {
+            if (_out.count == address_info::max_addresses) {
+                // Keep the first addresses. Clients connect to the first one that works.
+                break;
             }
 
-            try {
-                // clang-format off
-                if (addr)      { g_segment->deallocate(addr.get()); }
-                if (canonname) { g_segment->deallocate(canonname.get()); }
-                // clang-format on
+            if (p->ai_addr && p->ai_addrlen > address_info::max_address_size) {
+                return false;
             }
-            catch (...) {}
-        }
 
-        auto to_addrinfo() const -> addrinfo*
-        {
-            auto* p = static_cast<addrinfo*>(std::malloc(sizeof(addrinfo)));
-            std::memset(p, 0, sizeof(addrinfo));
+            auto& a = _out.addresses[_out.count];
 
             // clang-format off
-            p->ai_flags     = flags;
-            p->ai_family    = family;
-            p->ai_socktype  = socktype;
-            p->ai_protocol  = protocol;
-            p->ai_addrlen   = addrlen;
+            a.flags     = p->ai_flags;
+            a.family    = p->ai_family;
+            a.socktype  = p->ai_socktype;
+            a.protocol  = p->ai_protocol;
+            a.addrlen   = p->ai_addrlen;
+            a.has_addr  = (p->ai_addr != nullptr);
             // clang-format on
 
-            if (addr) {
-                p->ai_addr = static_cast<sockaddr*>(std::malloc(sizeof(sockaddr)));
-                std::memcpy(p->ai_addr, addr.get(), sizeof(sockaddr));
+            if (p->ai_addr) {
+                std::memcpy(a.addr, p->ai_addr, p->ai_addrlen);
             }
 
-            if (canonname) {
-                const auto size = std::strlen(canonname.get());
-                p->ai_canonname = static_cast<char*>(std::malloc(sizeof(char) * size + 1));
-                std::strncpy(p->ai_canonname, canonname.get(), size);
-                p->ai_canonname[size] = 0;
+            if (p->ai_canonname && _out.canonname_index < 0) {
+                if (std::strlen(p->ai_canonname) >= sizeof(_out.canonname)) {
+                    return false;
+                }
+
+                std::strcpy(_out.canonname, p->ai_canonname);
+                _out.canonname_index = _out.count;
             }
 
-            return p;
+            ++_out.count;
         }
 
-        int flags;
-        int family;
-        int socktype;
-        int protocol;
-        socklen_t addrlen;
-        bi::offset_ptr<sockaddr> addr;
-        bi::offset_ptr<char> canonname;
-        std::int64_t expiration;
-        std::int64_t expires_after;
-    }; // struct address_info
+        return true;
+    }
+
+    auto to_addrinfo(const address_info::address& _a) -> addrinfo*
+    {
+        auto* p = static_cast<addrinfo*>(std::malloc(sizeof(addrinfo)));
+        std::memset(p, 0, sizeof(addrinfo));
+
+        // clang-format off
+        p->ai_flags     = _a.flags;
+        p->ai_family    = _a.family;
+        p->ai_socktype  = _a.socktype;
+        p->ai_protocol  = _a.protocol;
+        p->ai_addrlen   = _a.addrlen;
+        // clang-format on
+
+        if (_a.has_addr) {
+            // Callers may treat the address as a sockaddr regardless of its length.
+            const auto size = std::max<std::size_t>(_a.addrlen, sizeof(sockaddr));
+            p->ai_addr = static_cast<sockaddr*>(std::malloc(size));
+            std::memset(p->ai_addr, 0, size);
+            std::memcpy(p->ai_addr, _a.addr, _a.addrlen);
+        }
+
+        return p;
+    }
 
     auto free_address_info(addrinfo* _p) -> void
     {
@@ -176,18 +158,8 @@ namespace irods::experimental::net::dns_cache
             return;
         }
 
-        g_segment_name = _shm_name.data();
-        g_segment_size = _shm_size;
-        g_mutex_name = g_segment_name + "_mutex";
-
-        bi::named_sharable_mutex::remove(g_mutex_name.data());
-        bi::shared_memory_object::remove(g_segment_name.data());
-
+        g_table = std::make_unique<table_type>(_shm_name, _shm_size);
         g_owner_pid = getpid();
-        g_segment = std::make_unique<bi::managed_shared_memory>(bi::create_only, g_segment_name.data(), g_segment_size);
-        g_allocator = std::make_unique<void_allocator_type>(g_segment->get_segment_manager());
-        g_mutex = std::make_unique<bi::named_sharable_mutex>(bi::create_only, g_mutex_name.data());
-        g_map = g_segment->construct<map_type>(bi::anonymous_instance)(std::less<key_type>{}, *g_allocator);
     } // init
 
     auto deinit() noexcept -> void
@@ -199,19 +171,10 @@ namespace irods::experimental::net::dns_cache
         try {
             g_owner_pid = 0;
 
-            if (g_segment && g_map) {
-                g_segment->destroy_ptr(g_map);
-                g_map = nullptr;
+            if (g_table) {
+                g_table->remove();
+                g_table.reset();
             }
-
-            // clang-format off
-            if (g_mutex)     { g_mutex.reset(); }
-            if (g_allocator) { g_allocator.reset(); }
-            if (g_segment)   { g_segment.reset(); }
-            // clang-format on
-
-            bi::named_sharable_mutex::remove(g_mutex_name.data());
-            bi::shared_memory_object::remove(g_segment_name.data());
         }
         catch (...) {}
     } // deinit
@@ -220,90 +183,74 @@ namespace irods::experimental::net::dns_cache
                           const addrinfo& _info,
                           seconds _expires_after) -> bool
     {
-        void_allocator_type alloc{g_segment->get_segment_manager()};
-
-        bi::scoped_lock lk{*g_mutex};
-
-        auto [iter, inserted] = g_map->insert_or_assign(key_type{_key.data(), *g_allocator}, mapped_type{alloc});
+        address_info value;
 
-        for (const auto* p = &_info; p; p = p->ai_next) {
-            iter->second.emplace_back(*p, _expires_after);
+        if (!make_address_info(_info, value)) {
+            // The entry cannot be cached. Lookups will miss.
+            return false;
         }
 
-        return inserted;
+        const auto tp = clock_type::now() + _expires_after;
+        const auto expiration = duration_cast<seconds>(tp.time_since_epoch()).count();
+
+        return g_table->insert_or_assign(_key, expiration, value);
     } // insert_or_assign
 
     auto lookup(const std::string_view _key) -> std::unique_ptr<addrinfo, addrinfo_deleter_type>
     {
-        bi::sharable_lock lk{*g_mutex};
-
-        if (auto iter = g_map->find(key_type{_key.data(), *g_allocator}); iter != g_map->end()) {
-            if (auto& list = iter->second; current_timestamp_in_seconds() < list.front().expiration) {
-                addrinfo* first{};
-                addrinfo* prev{};
-                addrinfo* current{};
+        // Not bumping the expiration timestamp here means the entry will eventually expire
+        // and cause a cache miss which is totally fine.
+        const auto value = g_table->lookup(_key, current_timestamp_in_seconds());
 
-                for (auto& node : list) {
-                    current = node.to_addrinfo();
+        if (!value || 0 == value->count) {
+            return {nullptr, nullptr};
+        }
 
-                    if (!prev) {
-                        first = current;
-                    }
-                    else {
-                        prev->ai_next = current;
-                    }
+        addrinfo* first{};
+        addrinfo* prev{};
 
-                    prev = current;
-                }
+        for (int i = 0; i < value->count; ++i) {
+            auto* current = to_addrinfo(value->addresses[i]);
 
-                // Not bumping the expiration timestamp here means the entry will eventually expire
-                // and cause a cache miss which is totally fine.
+            if (i == value->canonname_index) {
+                current->ai_canonname = strdup(value->canonname);
+            }
 
-                return {first, free_address_info};
+            if (!prev) {
+                first = current;
             }
+            else {
+                prev->ai_next = current;
+            }
+
+            prev = current;
         }
 
-        return {nullptr, nullptr};
+        return {first, free_address_info};
     } // lookup
 
     auto erase(const std::string_view _key) -> void
     {
-        bi::scoped_lock lk{*g_mutex};
-        g_map->erase(key_type{_key.data(), *g_allocator});
+        g_table->erase(_key);
     } // erase
 
     auto erase_expired_entries() -> void
     {
-        bi::scoped_lock lk{*g_mutex};
-
-        const auto now = current_timestamp_in_seconds();
-
-        for (auto iter = g_map->begin(), end = g_map->end(); iter != end;) {
-            if (now >= iter->second.front().expiration) {
-                iter = g_map->erase(iter);
-            }
-            else {
-                ++iter;
-            }
-        }
+        g_table->erase_expired_entries(current_timestamp_in_seconds());
     } // erase_expired_entries
 
     auto clear() -> void
     {
-        bi::scoped_lock lk{*g_mutex};
-        g_map->clear();
+        g_table->clear();
     } // clear
 
     auto size() -> std::size_t
     {
-        bi::sharable_lock lk{*g_mutex};
-        return g_map->size();
+        return g_table->size();
     } // size
 
     auto available_memory() -> std::size_t
     {
-        bi::sharable_lock lk{*g_mutex};
-        return g_segment->get_free_memory();
+        return g_table->available_memory();
     } // available_memory
 } // namespace irods::experimental::net::dns_cache
-
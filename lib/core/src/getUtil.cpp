@@ -12,6 +12,17 @@
 #include "rcPortalOpr.h"
 #include "sockComm.h"
 #include "rcGlobalExtern.h"
+#include "transfer_scheduler.hpp"
+
+#include <memory>
+#include <optional>
+#include <string>
+
+namespace {
+    int getCollUtilImpl( rcComm_t **myConn, char *srcColl, char *targDir,
+                         rodsEnv *myRodsEnv, rodsArguments_t *rodsArgs, dataObjInp_t *dataObjOprInp,
+                         rodsRestart_t *rodsRestart, irods::transfer_scheduler *scheduler );
+} // anonymous namespace
 
 int
 setSessionTicket( rcComm_t *myConn, char *ticket ) {
@@ -130,9 +141,38 @@ getUtil( rcComm_t **myConn, rodsEnv *myRodsEnv, rodsArguments_t *myRodsArgs,
         else if ( targPath->objType ==  LOCAL_DIR_T ) {
             setStateForRestart( &rodsRestart, targPath, myRodsArgs );
             addKeyVal( &dataObjOprInp.condInput, TRANSLATED_PATH_KW, "" );
-            status = getCollUtil( myConn, rodsPathInp->srcPath[i].outPath,
-                                  targPath->outPath, myRodsEnv, myRodsArgs, &dataObjOprInp,
-                                  &rodsRestart );
+            if ( myRodsArgs->concurrent == True ) {
+                std::optional<irods::transfer_scheduler> scheduler;
+                try {
+                    auto opts = irods::make_transfer_scheduler_options( *myRodsArgs, *myRodsEnv );
+                    if ( myRodsArgs->ticket == True ) {
+                        opts.on_connect = [myRodsArgs]( rcComm_t& _conn ) {
+                            setSessionTicket( &_conn, myRodsArgs->ticketString );
+                        };
+                    }
+                    scheduler.emplace( opts, *conn, &rodsRestart );
+                }
+                catch ( const std::exception& e ) {
+                    rodsLog( LOG_ERROR, "getUtil: could not start concurrent transfers: %s", e.what() );
+                    return SYS_SOCK_CONNECT_ERR;
+                }
+
+                status = getCollUtilImpl( myConn, rodsPathInp->srcPath[i].outPath,
+                                          targPath->outPath, myRodsEnv, myRodsArgs, &dataObjOprInp,
+                                          &rodsRestart, &*scheduler );
+
+                // Always drain the scheduler so that the restart file reflects
+                // every transfer that did complete.
+                const int wait_status = scheduler->wait();
+                if ( status >= 0 && wait_status < 0 ) {
+                    status = wait_status;
+                }
+            }
+            else {
+                status = getCollUtil( myConn, rodsPathInp->srcPath[i].outPath,
+                                      targPath->outPath, myRodsEnv, myRodsArgs, &dataObjOprInp,
+                                      &rodsRestart );
+            }
         }
         else {
             /* should not be here */
@@ -413,6 +453,17 @@ int
 getCollUtil( rcComm_t **myConn, char *srcColl, char *targDir,
              rodsEnv *myRodsEnv, rodsArguments_t *rodsArgs, dataObjInp_t *dataObjOprInp,
              rodsRestart_t *rodsRestart ) {
+    return getCollUtilImpl( myConn, srcColl, targDir, myRodsEnv, rodsArgs,
+                            dataObjOprInp, rodsRestart, NULL );
+}
+
+namespace {
+// When scheduler is non-null, data objects are queued on the scheduler instead
+// of being transferred on myConn. Local directories are still created by the
+// walker before any of their members are transferred.
+int getCollUtilImpl( rcComm_t **myConn, char *srcColl, char *targDir,
+                     rodsEnv *myRodsEnv, rodsArguments_t *rodsArgs, dataObjInp_t *dataObjOprInp,
+                     rodsRestart_t *rodsRestart, irods::transfer_scheduler *scheduler ) {
     int status = 0;
     int savedStatus = 0;
     char srcChildPath[MAX_NAME_LEN], targChildPath[MAX_NAME_LEN];
@@ -470,8 +521,11 @@ getCollUtil( rcComm_t **myConn, char *srcColl, char *targDir,
             snprintf( srcChildPath, MAX_NAME_LEN, "%s/%s",
                       collEnt.collName, collEnt.dataName );
 
-            int status = chkStateForResume( conn, rodsRestart, targChildPath,
-                                        rodsArgs, LOCAL_FILE_T, &dataObjOprInp->condInput, 1 );
+            const auto check_state = [&] {
+                return chkStateForResume( conn, rodsRestart, targChildPath,
+                                          rodsArgs, LOCAL_FILE_T, &dataObjOprInp->condInput, 1 );
+            };
+            int status = scheduler ? scheduler->check_restart_state( check_state ) : check_state();
 
             if ( status < 0 ) {
                 /* restart failed */
@@ -481,6 +535,33 @@ getCollUtil( rcComm_t **myConn, char *srcColl, char *targDir,
                 continue;
             }
 
+            if ( scheduler ) {
+                std::shared_ptr<dataObjInp_t> inp{new dataObjInp_t{}, []( dataObjInp_t* _p ) {
+                    clearDataObjInp( _p );
+                    delete _p;
+                }};
+                replDataObjInp( dataObjOprInp, inp.get() );
+
+                status = scheduler->schedule( targChildPath, mySize,
+                    [inp, src = std::string{srcChildPath}, targ = std::string{targChildPath},
+                     mySize, dataMode = collEnt.dataMode, rodsArgs]
+                    ( rcComm_t& _conn, int _num_threads ) mutable {
+                        inp->numThreads = _num_threads;
+                        return getDataObjUtil( &_conn, src.data(), targ.data(), mySize,
+                                               dataMode, rodsArgs, inp.get() );
+                    } );
+
+                if ( status < 0 ) {
+                    savedStatus = status;
+                    if ( rodsRestart->fd > 0 ) {
+                        break;
+                    }
+                }
+
+                // The scheduler maintains the restart file in walk order.
+                continue;
+            }
+
             status = getDataObjUtil( conn, srcChildPath, targChildPath, mySize,
                                      collEnt.dataMode, rodsArgs, dataObjOprInp );
             if ( status < 0 ) {
@@ -523,8 +604,9 @@ getCollUtil( rcComm_t **myConn, char *srcColl, char *targDir,
             else {
                 childDataObjInp.specColl = NULL;
             }
-            int status = getCollUtil( myConn, collEnt.collName, targChildPath,
-                                  myRodsEnv, rodsArgs, &childDataObjInp, rodsRestart );
+            int status = getCollUtilImpl( myConn, collEnt.collName, targChildPath,
+                                          myRodsEnv, rodsArgs, &childDataObjInp, rodsRestart,
+                                          scheduler );
             if ( status < 0 && status != CAT_NO_ROWS_FOUND ) {
                 rodsLogError( LOG_ERROR, status,
                               "getCollUtil: getCollUtil failed for %s. status = %d",
@@ -549,4 +631,4 @@ getCollUtil( rcComm_t **myConn, char *srcColl, char *targDir,
         return status;
     }
 }
-
+} // anonymous namespace
@@ -10,6 +10,9 @@ namespace irods
     const std::string CFG_PAM_PASSWORD_MIN_TIME_KW( "password_min_time" );
     const std::string CFG_PAM_PASSWORD_MAX_TIME_KW( "password_max_time" );
 
+    const std::string CFG_DB_HOST_KW( "db_host" );
+    const std::string CFG_DB_PORT_KW( "db_port" );
+    const std::string CFG_DB_NAME_KW( "db_name" );
     const std::string CFG_DB_USERNAME_KW( "db_username" );
     const std::string CFG_DB_PASSWORD_KW( "db_password" );
     const std::string CFG_DB_SSLMODE_KW( "db_sslmode" );
@@ -61,6 +64,11 @@ namespace irods
     const std::string CFG_MAX_TEMP_PASSWORD_LIFETIME( "maximum_temporary_password_lifetime_in_seconds" );
     const std::string CFG_MAX_NUMBER_OF_CONCURRENT_RE_PROCS( "maximum_number_of_concurrent_rule_engine_server_processes" );
     const std::string DEFAULT_LOG_ROTATION_IN_DAYS("default_log_rotation_in_days");
+    const std::string CFG_CATALOG_OBJECT_ID_BLOCK_SIZE_KW("catalog_object_id_block_size");
+    const std::string CFG_QUOTA_ACCOUNTING_MODE_KW("quota_accounting_mode");
+    const std::string CFG_MAX_READ_AHEAD_BUFFER_SIZE_KW("maximum_read_ahead_buffer_size_in_megabytes");
+    const std::string CFG_NUMBER_OF_CONCURRENT_BULK_REMOVAL_THREADS_KW("number_of_concurrent_bulk_removal_threads");
+    const std::string CFG_NUMBER_OF_CONCURRENT_CHECKSUM_OPERATIONS_PER_RESOURCE_KW("number_of_concurrent_checksum_operations_per_resource");
 
     const std::string CFG_RE_CACHE_SALT_KW("reCacheSalt");
     const std::string CFG_RE_SERVER_SLEEP_TIME( "rule_engine_server_sleep_time_in_seconds");
@@ -68,6 +76,9 @@ namespace irods
 
     const std::string CFG_DNS_CACHE_KW("dns_cache");
     const std::string CFG_HOSTNAME_CACHE_KW("hostname_cache");
+    const std::string CFG_HIERARCHY_RESOLUTION_CACHE_KW("hierarchy_resolution_cache");
+    const std::string CFG_CATALOG_PERMISSION_CACHE_KW("catalog_permission_cache");
+    const std::string CFG_RESOURCE_TREE_SNAPSHOT_KW("resource_tree_snapshot");
 
     const std::string CFG_SHARED_MEMORY_SIZE_IN_BYTES_KW("shared_memory_size_in_bytes");
     const std::string CFG_EVICTION_AGE_IN_SECONDS_KW("eviction_age_in_seconds");
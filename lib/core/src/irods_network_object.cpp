@@ -10,7 +10,8 @@ namespace irods {
 // =-=-=-=-=-=-=-
 // public - ctor
     network_object::network_object() :
-        socket_handle_( 0 ) {
+        socket_handle_( 0 ),
+        protocol_( NATIVE_PROT ) {
 
     } // ctor
 
@@ -18,7 +19,8 @@ namespace irods {
 // public - ctor
     network_object::network_object(
         const rcComm_t& _comm ) :
-        socket_handle_( _comm.sock ) {
+        socket_handle_( _comm.sock ),
+        protocol_( _comm.irodsProt ) {
 
     } // ctor
 
@@ -26,7 +28,8 @@ namespace irods {
 // public - ctor
     network_object::network_object(
         const rsComm_t& _comm ) :
-        socket_handle_( _comm.sock ) {
+        socket_handle_( _comm.sock ),
+        protocol_( _comm.irodsProt ) {
 
     } // ctor
 
@@ -36,6 +39,7 @@ namespace irods {
         const network_object& _rhs ) :
         first_class_object( _rhs ) {
         socket_handle_ = _rhs.socket_handle_;
+        protocol_      = _rhs.protocol_;
 
     } // cctor
 
@@ -49,6 +53,7 @@ namespace irods {
     network_object& network_object::operator=(
         const network_object& _rhs ) {
         socket_handle_ = _rhs.socket_handle_;
+        protocol_      = _rhs.protocol_;
         return *this;
 
     } // operator=
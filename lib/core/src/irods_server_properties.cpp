@@ -158,6 +158,98 @@ namespace irods
         return 3600;
     } // get_hostname_cache_eviction_age
 
+    int get_hierarchy_resolution_cache_eviction_age() noexcept
+    {
+        try {
+            using map_type = std::unordered_map<std::string, boost::any>;
+            const auto wrapped = get_advanced_setting<map_type&>(CFG_HIERARCHY_RESOLUTION_CACHE_KW).at(CFG_EVICTION_AGE_IN_SECONDS_KW);
+            const auto seconds =  boost::any_cast<int>(wrapped);
+
+            if (seconds >= 0) {
+                return seconds;
+            }
+
+            rodsLog(LOG_ERROR, "Invalid eviction age for hierarchy resolution cache [seconds=%d].", seconds);
+        }
+        catch (...) {
+            rodsLog(LOG_DEBUG, "Could not read server configuration property [%s.%s.%s].",
+                    CFG_ADVANCED_SETTINGS_KW.data(), CFG_HIERARCHY_RESOLUTION_CACHE_KW.data(), CFG_EVICTION_AGE_IN_SECONDS_KW.data());
+        }
+
+        rodsLog(LOG_DEBUG, "Returning default eviction age for hierarchy resolution cache [default=0].");
+
+        return 0;
+    } // get_hierarchy_resolution_cache_eviction_age
+
+    auto get_catalog_permission_cache_eviction_age() noexcept -> int
+    {
+        try {
+            using map_type = std::unordered_map<std::string, boost::any>;
+            const auto wrapped = get_advanced_setting<map_type&>(CFG_CATALOG_PERMISSION_CACHE_KW).at(CFG_EVICTION_AGE_IN_SECONDS_KW);
+            const auto seconds =  boost::any_cast<int>(wrapped);
+
+            if (seconds >= 0) {
+                return seconds;
+            }
+
+            rodsLog(LOG_ERROR, "Invalid eviction age for catalog permission cache [seconds=%d].", seconds);
+        }
+        catch (...) {
+            rodsLog(LOG_DEBUG, "Could not read server configuration property [%s.%s.%s].",
+                    CFG_ADVANCED_SETTINGS_KW.data(), CFG_CATALOG_PERMISSION_CACHE_KW.data(), CFG_EVICTION_AGE_IN_SECONDS_KW.data());
+        }
+
+        rodsLog(LOG_DEBUG, "Returning default eviction age for catalog permission cache [default=0].");
+
+        return 0;
+    } // get_catalog_permission_cache_eviction_age
+
+    auto get_resource_tree_snapshot_shared_memory_size() noexcept -> int
+    {
+        try {
+            using map_type = std::unordered_map<std::string, boost::any>;
+            const auto wrapped = get_advanced_setting<map_type&>(CFG_RESOURCE_TREE_SNAPSHOT_KW).at(CFG_SHARED_MEMORY_SIZE_IN_BYTES_KW);
+            const auto bytes = boost::any_cast<int>(wrapped);
+
+            if (bytes > 0) {
+                return bytes;
+            }
+
+            rodsLog(LOG_ERROR, "Invalid shared memory size for resource tree snapshot [size=%d].", bytes);
+        }
+        catch (...) {
+            rodsLog(LOG_DEBUG, "Could not read server configuration property [%s.%s.%s].",
+                    CFG_ADVANCED_SETTINGS_KW.data(), CFG_RESOURCE_TREE_SNAPSHOT_KW.data(), CFG_SHARED_MEMORY_SIZE_IN_BYTES_KW.data());
+        }
+
+        rodsLog(LOG_DEBUG, "Returning default shared memory size for resource tree snapshot [default=10000000].");
+
+        return 10'000'000;
+    } // get_resource_tree_snapshot_shared_memory_size
+
+    auto get_resource_tree_snapshot_eviction_age() noexcept -> int
+    {
+        try {
+            using map_type = std::unordered_map<std::string, boost::any>;
+            const auto wrapped = get_advanced_setting<map_type&>(CFG_RESOURCE_TREE_SNAPSHOT_KW).at(CFG_EVICTION_AGE_IN_SECONDS_KW);
+            const auto seconds =  boost::any_cast<int>(wrapped);
+
+            if (seconds >= 0) {
+                return seconds;
+            }
+
+            rodsLog(LOG_ERROR, "Invalid eviction age for resource tree snapshot [seconds=%d].", seconds);
+        }
+        catch (...) {
+            rodsLog(LOG_DEBUG, "Could not read server configuration property [%s.%s.%s].",
+                    CFG_ADVANCED_SETTINGS_KW.data(), CFG_RESOURCE_TREE_SNAPSHOT_KW.data(), CFG_EVICTION_AGE_IN_SECONDS_KW.data());
+        }
+
+        rodsLog(LOG_DEBUG, "Returning default eviction age for resource tree snapshot [default=300].");
+
+        return 300;
+    } // get_resource_tree_snapshot_eviction_age
+
     void parse_and_store_hosts_configuration_file_as_json() noexcept
     {
         try {
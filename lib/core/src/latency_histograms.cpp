@@ -0,0 +1,407 @@
+#include "latency_histograms.hpp"
+
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/interprocess/sync/interprocess_mutex.hpp>
+#include <boost/interprocess/sync/scoped_lock.hpp>
+
+#include "fmt/format.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <unordered_map>
+
+#include <sys/types.h>
+#include <unistd.h>
+
+namespace
+{
+    namespace bi = boost::interprocess;
+    namespace lh = irods::experimental::latency_histograms;
+
+    using std::chrono::nanoseconds;
+
+    // Latencies below 2^min_exponent nanoseconds (~1 microsecond) share the first bucket.
+    // Latencies at or above 2^max_exponent nanoseconds (~18 minutes) share the last bucket.
+    // Every power of two in between is split into 2^sub_bucket_bits buckets.
+    constexpr int min_exponent = 10;
+    constexpr int max_exponent = 40;
+    constexpr int sub_bucket_bits = 2;
+    constexpr int sub_bucket_count = 1 << sub_bucket_bits;
+    constexpr std::size_t bucket_count = 2 + (max_exponent - min_exponent) * sub_bucket_count;
+
+    // Longer names are truncated.
+    constexpr std::size_t max_name_size = 63;
+
+    struct series
+    {
+        lh::category kind;
+        int api_number;
+        char name[max_name_size + 1];
+        std::atomic<std::uint64_t> count;
+        std::atomic<std::uint64_t> sum;
+        std::atomic<std::uint64_t> buckets[bucket_count];
+    }; // struct series
+
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free);
+
+    // Series are only ever appended. Writers append while holding the mutex and publish the
+    // new series by incrementing size. Readers never lock.
+    struct table_header
+    {
+        bi::interprocess_mutex mutex;
+        std::atomic<std::uint32_t> size;
+        std::uint32_t capacity;
+    }; // struct table_header
+
+    // Series are looked up under the mutex only the first time a thread records a latency for
+    // an API number or operation name. The series is then cached by the thread. The generation
+    // invalidates the cache when the histograms are recreated.
+    struct series_cache
+    {
+        std::uint64_t generation = 0;
+        std::unordered_map<int, series*> apis;
+        std::unordered_map<std::string, series*> operations;
+    }; // struct series_cache
+
+    //
+    // Global Variables
+    //
+
+    // On initialization, holds the PID of the process that initialized the histograms.
+    // This ensures that only the process that initialized the system can deinitialize it.
+    pid_t g_owner_pid;
+
+    std::string g_shm_name;
+
+    // Child processes inherit the mapping of the shared memory.
+    std::unique_ptr<bi::mapped_region> g_region;
+
+    table_header* g_header{};
+    series* g_series{};
+
+    std::uint64_t g_generation = 0;
+
+    thread_local series_cache t_cache;
+
+    auto series_offset() noexcept -> std::size_t
+    {
+        return (sizeof(table_header) + alignof(series) - 1) / alignof(series) * alignof(series);
+    }
+
+    auto bucket_index(std::uint64_t _ns) noexcept -> std::size_t
+    {
+        if (_ns < (std::uint64_t{1} << min_exponent)) {
+            return 0;
+        }
+
+        const int exponent = 63 - __builtin_clzll(_ns);
+
+        if (exponent >= max_exponent) {
+            return bucket_count - 1;
+        }
+
+        const auto sub_bucket = (_ns >> (exponent - sub_bucket_bits)) & (sub_bucket_count - 1);
+
+        return 1 + (exponent - min_exponent) * sub_bucket_count + sub_bucket;
+    }
+
+    auto bucket_upper_bound(std::size_t _index) noexcept -> nanoseconds
+    {
+        if (0 == _index) {
+            return nanoseconds{std::int64_t{1} << min_exponent};
+        }
+
+        if (bucket_count - 1 == _index) {
+            return nanoseconds::max();
+        }
+
+        const auto exponent = min_exponent + static_cast<int>((_index - 1) / sub_bucket_count);
+        const auto sub_bucket = static_cast<std::int64_t>((_index - 1) % sub_bucket_count);
+
+        return nanoseconds{(sub_bucket_count + sub_bucket + 1) << (exponent - sub_bucket_bits)};
+    }
+
+    auto category_of(const std::string& _operation_name) noexcept -> lh::category
+    {
+        return (_operation_name.rfind("database_", 0) == 0) ? lh::category::database_operation
+                                                            : lh::category::plugin_operation;
+    }
+
+    // Returns nullptr if the histograms are full.
+    auto find_or_insert_series(lh::category _kind, int _api_number, const std::string& _name) -> series*
+    {
+        const auto matches = [&](const series& _s) {
+            if (_s.kind != _kind) {
+                return false;
+            }
+
+            return (lh::category::api == _kind)
+                ? _s.api_number == _api_number
+                : std::strncmp(_s.name, _name.c_str(), max_name_size) == 0;
+        };
+
+        bi::scoped_lock lk{g_header->mutex};
+
+        const auto size = g_header->size.load(std::memory_order_relaxed);
+
+        for (std::uint32_t i = 0; i < size; ++i) {
+            if (matches(g_series[i])) {
+                return &g_series[i];
+            }
+        }
+
+        if (size == g_header->capacity) {
+            return nullptr;
+        }
+
+        auto* s = new (&g_series[size]) series{};
+        s->kind = _kind;
+        s->api_number = (lh::category::api == _kind) ? _api_number : 0;
+        std::strncpy(s->name, _name.c_str(), max_name_size);
+
+        g_header->size.store(size + 1, std::memory_order_release);
+
+        return s;
+    }
+
+    auto cache() -> series_cache&
+    {
+        if (t_cache.generation != g_generation) {
+            t_cache.apis.clear();
+            t_cache.operations.clear();
+            t_cache.generation = g_generation;
+        }
+
+        return t_cache;
+    }
+
+    auto record(series& _series, nanoseconds _latency) noexcept -> void
+    {
+        const auto ns = static_cast<std::uint64_t>(std::max(_latency.count(), std::int64_t{0}));
+
+        _series.count.fetch_add(1, std::memory_order_relaxed);
+        _series.sum.fetch_add(ns, std::memory_order_relaxed);
+        _series.buckets[bucket_index(ns)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    auto escape_label_value(const std::string_view _value) -> std::string
+    {
+        std::string escaped;
+        escaped.reserve(_value.size());
+
+        for (auto c : _value) {
+            switch (c) {
+                case '\\': escaped += "\\\\"; break;
+                case '"':  escaped += "\\\""; break;
+                case '\n': escaped += "\\n";  break;
+                default:   escaped += c;      break;
+            }
+        }
+
+        return escaped;
+    }
+
+    auto to_seconds(nanoseconds _ns) -> double
+    {
+        return std::chrono::duration<double>{_ns}.count();
+    }
+} // anonymous namespace
+
+namespace irods::experimental::latency_histograms
+{
+    auto init(const std::string_view _shm_name, std::size_t _max_series) -> void
+    {
+        if (getpid() == g_owner_pid) {
+            return;
+        }
+
+        if (0 == _max_series) {
+            throw std::runtime_error{"latency histograms: maximum number of series must be greater than zero"};
+        }
+
+        const auto shm_size = series_offset() + _max_series * sizeof(series);
+
+        g_shm_name = _shm_name;
+        bi::shared_memory_object::remove(g_shm_name.c_str());
+
+        bi::shared_memory_object shm{bi::create_only, g_shm_name.c_str(), bi::read_write};
+        shm.truncate(shm_size);
+        g_region = std::make_unique<bi::mapped_region>(shm, bi::read_write);
+
+        auto* base = static_cast<char*>(g_region->get_address());
+        g_header = new (base) table_header{};
+        g_header->capacity = static_cast<std::uint32_t>(_max_series);
+        g_series = reinterpret_cast<series*>(base + series_offset());
+
+        ++g_generation;
+        g_owner_pid = getpid();
+    } // init
+
+    auto deinit() noexcept -> void
+    {
+        if (getpid() != g_owner_pid) {
+            return;
+        }
+
+        try {
+            g_owner_pid = 0;
+            ++g_generation;
+
+            g_header->~table_header();
+            g_header = nullptr;
+            g_series = nullptr;
+            g_region.reset();
+
+            bi::shared_memory_object::remove(g_shm_name.c_str());
+        }
+        catch (...) {}
+    } // deinit
+
+    auto enabled() noexcept -> bool
+    {
+        return g_header != nullptr;
+    } // enabled
+
+    auto record_api(int _api_number, const std::string& _api_name, nanoseconds _latency) noexcept -> void
+    {
+        if (!enabled()) {
+            return;
+        }
+
+        try {
+            auto& apis = cache().apis;
+            auto iter = apis.find(_api_number);
+
+            if (std::end(apis) == iter) {
+                iter = apis.emplace(_api_number, find_or_insert_series(category::api, _api_number, _api_name)).first;
+            }
+
+            if (iter->second) {
+                record(*iter->second, _latency);
+            }
+        }
+        catch (...) {}
+    } // record_api
+
+    auto record_plugin_operation(const std::string& _operation_name, nanoseconds _latency) noexcept -> void
+    {
+        if (!enabled()) {
+            return;
+        }
+
+        try {
+            auto& operations = cache().operations;
+            auto iter = operations.find(_operation_name);
+
+            if (std::end(operations) == iter) {
+                auto* s = find_or_insert_series(category_of(_operation_name), 0, _operation_name);
+                iter = operations.emplace(_operation_name, s).first;
+            }
+
+            if (iter->second) {
+                record(*iter->second, _latency);
+            }
+        }
+        catch (...) {}
+    } // record_plugin_operation
+
+    auto histograms() -> std::vector<histogram>
+    {
+        if (!enabled()) {
+            return {};
+        }
+
+        const auto size = g_header->size.load(std::memory_order_acquire);
+
+        std::vector<histogram> result;
+        result.reserve(size);
+
+        for (std::uint32_t i = 0; i < size; ++i) {
+            const auto& s = g_series[i];
+
+            histogram h{};
+            h.kind = s.kind;
+            h.api_number = s.api_number;
+            h.name = s.name;
+            h.sum = nanoseconds{static_cast<std::int64_t>(s.sum.load(std::memory_order_relaxed))};
+
+            // The count is derived from the buckets so that the copy is self-consistent even
+            // while other processes are recording.
+            for (std::size_t b = 0; b < bucket_count; ++b) {
+                if (const auto n = s.buckets[b].load(std::memory_order_relaxed); n > 0) {
+                    h.buckets.push_back({bucket_upper_bound(b), n});
+                    h.count += n;
+                }
+            }
+
+            result.push_back(std::move(h));
+        }
+
+        return result;
+    } // histograms
+
+    auto to_prometheus_text(const std::string_view _host) -> std::string
+    {
+        struct family
+        {
+            category kind;
+            const char* name;
+            const char* help;
+        };
+
+        // clang-format off
+        constexpr family families[] = {
+            {category::api,                "irods_api_latency_seconds",                "Time spent handling API requests."},
+            {category::plugin_operation,   "irods_plugin_operation_latency_seconds",   "Time spent in plugin operations."},
+            {category::database_operation, "irods_database_operation_latency_seconds", "Time spent in database plugin operations."}
+        };
+        // clang-format on
+
+        const auto all = histograms();
+        const auto host_label = _host.empty() ? std::string{} : fmt::format("host=\"{}\",", escape_label_value(_host));
+
+        std::string text;
+
+        for (auto&& f : families) {
+            bool header_written = false;
+
+            for (auto&& h : all) {
+                if (h.kind != f.kind) {
+                    continue;
+                }
+
+                if (!header_written) {
+                    text += fmt::format("# HELP {} {}\n# TYPE {} histogram\n", f.name, f.help, f.name);
+                    header_written = true;
+                }
+
+                const auto labels = (category::api == h.kind)
+                    ? fmt::format("{}api_number=\"{}\",api_name=\"{}\"", host_label, h.api_number, escape_label_value(h.name))
+                    : fmt::format("{}operation=\"{}\"", host_label, escape_label_value(h.name));
+
+                // Empty buckets are omitted. Prometheus buckets are cumulative.
+                std::uint64_t cumulative_count = 0;
+
+                for (auto&& b : h.buckets) {
+                    if (nanoseconds::max() == b.upper_bound) {
+                        continue;
+                    }
+
+                    cumulative_count += b.count;
+                    text += fmt::format("{}_bucket{{{},le=\"{}\"}} {}\n", f.name, labels, to_seconds(b.upper_bound), cumulative_count);
+                }
+
+                text += fmt::format("{}_bucket{{{},le=\"+Inf\"}} {}\n", f.name, labels, h.count);
+                text += fmt::format("{}_sum{{{}}} {}\n", f.name, labels, to_seconds(h.sum));
+                text += fmt::format("{}_count{{{}}} {}\n", f.name, labels, h.count);
+            }
+        }
+
+        return text;
+    } // to_prometheus_text
+} // namespace irods::experimental::latency_histograms
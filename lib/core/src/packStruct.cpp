@@ -7,8 +7,13 @@
 #include "rcMisc.h"
 #include "version.hpp"
 #include "irods_pack_table.hpp"
+#include "irods_at_scope_exit.hpp"
 
+#include <boost/endian/conversion.hpp>
+
+#include <cstdint>
 #include <iostream>
+#include <limits>
 #include <sstream>
 #include <string>
 #include <optional>
@@ -45,6 +50,8 @@ namespace
                    const std::optional<irods::version>& peer_version);
   
     int packNatString(const void *&inPtr, packedOutput_t &packedOutput, int maxStrLen);
+
+    int packBinString(const void *&inPtr, packedOutput_t &packedOutput, int maxStrLen);
   
     int packXmlString(const void*& inPtr,
                       packedOutput_t& packedOutput,
@@ -125,6 +132,11 @@ namespace
                         packedOutput_t& packedOutput,
                         int maxStrLen,
                         char*& outStr);
+
+    int unpackBinString(const void*& inPtr,
+                        packedOutput_t& packedOutput,
+                        int maxStrLen,
+                        char*& outStr);
   
     int unpackXmlString(const void*& inPtr,
                         packedOutput_t& unpackedOutput,
@@ -147,7 +159,7 @@ namespace
   
     int unpackXmlIntToOutPtr(const void *&inPtr, void *&outPtr, int numElement, const char *name);
   
-    int unpackNatIntToOutPtr(const void *&inPtr, void *&outPtr, int numElement);
+    int unpackNatIntToOutPtr(const void *&inPtr, void *&outPtr, int numElement, irodsProt_t irodsProt);
   
     int unpackInt16(const void *&inPtr,
                     packedOutput_t &unpackedOutput,
@@ -161,7 +173,7 @@ namespace
                             const char *name,
                             irodsProt_t irodsProt);
   
-    int unpackNatInt16ToOutPtr(const void *&inPtr, void *&outPtr, int numElement);
+    int unpackNatInt16ToOutPtr(const void *&inPtr, void *&outPtr, int numElement, irodsProt_t irodsProt);
   
     int unpackXmlInt16ToOutPtr(const void *&inPtr, void *&outPtr, int numElement, const char *name);
   
@@ -179,7 +191,7 @@ namespace
                              const char *name,
                              irodsProt_t irodsProt);
   
-    int unpackNatDoubleToOutPtr(const void *&inPtr, void *&outPtr, int numElement);
+    int unpackNatDoubleToOutPtr(const void *&inPtr, void *&outPtr, int numElement, irodsProt_t irodsProt);
   
     int unpackChildStruct(const void *&inPtr,
                           packedOutput_t &unpackedOutput,
@@ -200,6 +212,8 @@ namespace
     void* addPointerToPackedOut(packedOutput_t &packedOutput, int len, void *pointer);
   
     int unpackNatStringToOutPtr(const void *&inPtr, void *&outPtr, int maxStrLen);
+
+    int unpackBinStringToOutPtr(const void *&inPtr, void *&outPtr, int maxStrLen);
   
     int unpackXmlStringToOutPtr(const void*& inPtr,
                                 void*& outPtr,
@@ -211,11 +225,11 @@ namespace
   
     int resolveStrInItem(packItem_t &myPackedItem);
   
-    int packNullString(packedOutput_t &packedOutput);
+    int packNullString(packedOutput_t &packedOutput, irodsProt_t irodsProt);
   
     int getNumStrAndStrLen(const packItem_t &myPackedItem, int &numStr, int &maxStrLen);
   
-    int getAllocLenForStr(const packItem_t &myPackedItem, const void *inPtr, int numStr, int maxStrLen);
+    int getAllocLenForStr(const packItem_t &myPackedItem, const void *inPtr, int numStr, int maxStrLen, irodsProt_t irodsProt);
   
     int packXmlTag(const char *name, packedOutput_t &packedOutput, int endFlag);
   
@@ -229,6 +243,49 @@ namespace
                           const char *name,
                           irodsProt_t irodsProt);
 
+    // BINARY_PROT prefixes every string with its length as a little-endian
+    // 32-bit integer. The packed input is not aligned, so it is read with memcpy.
+    auto read_binary_string_length(const void* _inPtr) -> std::uint32_t
+    {
+        std::uint32_t len;
+        std::memcpy(&len, _inPtr, sizeof(len));
+        return boost::endian::little_to_native(len);
+    }
+
+    // The end of the BINARY_PROT input being unpacked by this thread. Lengths read from
+    // the input are checked against it before anything is copied or allocated.
+    thread_local const char* binary_input_end = nullptr;
+
+    // Returns whether the _len bytes at _inPtr are within the input being unpacked.
+    auto binary_input_contains(const void* _inPtr, std::size_t _len) -> bool
+    {
+        const auto* p = static_cast<const char*>(_inPtr);
+
+        if (!binary_input_end || !p || p > binary_input_end) {
+            return false;
+        }
+
+        return _len <= static_cast<std::size_t>(binary_input_end - p);
+    }
+
+    // Returns the length of the BINARY_PROT string at _inPtr, or a negative error code
+    // if its length or its bytes extend past the end of the input.
+    auto checked_binary_string_length(const void* _inPtr) -> int
+    {
+        if (!binary_input_contains(_inPtr, sizeof(std::uint32_t))) {
+            return USER_PACKSTRUCT_INPUT_ERR;
+        }
+
+        const auto len = read_binary_string_length(_inPtr);
+        const auto* str = static_cast<const char*>(_inPtr) + sizeof(std::uint32_t);
+
+        if (len > static_cast<std::uint32_t>(std::numeric_limits<int>::max() - 1) || !binary_input_contains(str, len)) {
+            return USER_PACKSTRUCT_INPUT_ERR;
+        }
+
+        return static_cast<int>(len);
+    }
+
     auto to_version(const std::string& _version) -> std::optional<irods::version>
     {
         if (!_version.empty()) {
@@ -1059,8 +1116,8 @@ namespace
 
         /* if it is a NULL pointer, just pack a NULL_PTR_PACK_STR string */
         if ( myPackedItem.pointer == NULL ) {
-            if ( irodsProt == NATIVE_PROT ) {
-                packNullString( packedOutput );
+            if ( irodsProt != XML_PROT ) {
+                packNullString( packedOutput, irodsProt );
             }
             return 0;
         }
@@ -1398,6 +1455,10 @@ namespace
             return packXmlString(inPtr, packedOutput, maxStrLen, name, peer_version);
         }
 
+        if (irodsProt == BINARY_PROT) {
+            return packBinString(inPtr, packedOutput, maxStrLen);
+        }
+
         return packNatString(inPtr, packedOutput, maxStrLen);
     }
 
@@ -1440,6 +1501,38 @@ namespace
         return 0;
     }
 
+    int
+    packBinString( const void *&inPtr, packedOutput_t &packedOutput, int maxStrLen ) {
+        const int myStrlen = inPtr ? strlen( ( const char* )inPtr ) : 0;
+
+        if ( maxStrLen >= 0 && myStrlen >= maxStrLen ) {
+            return USER_PACKSTRUCT_INPUT_ERR;
+        }
+
+        void *outPtr;
+        int status = extendPackedOutput( packedOutput, sizeof( std::uint32_t ) + myStrlen, outPtr );
+        if ( SYS_MALLOC_ERR == status ) {
+            return status;
+        }
+
+        const auto len = boost::endian::native_to_little( static_cast<std::uint32_t>( myStrlen ) );
+        memcpy( outPtr, &len, sizeof( len ) );
+        if ( myStrlen > 0 ) {
+            memcpy( static_cast<char*>(outPtr) + sizeof( len ), inPtr, myStrlen );
+        }
+
+        if ( maxStrLen > 0 ) {
+            inPtr = ( const char * )inPtr + maxStrLen;
+        }
+        else {
+            inPtr = ( const char * )inPtr + myStrlen + 1;
+        }
+
+        packedOutput.bBuf.len += sizeof( len ) + myStrlen;
+
+        return 0;
+    }
+
     int packXmlString(const void*& inPtr,
                       packedOutput_t& packedOutput,
                       int maxStrLen,
@@ -1602,7 +1695,12 @@ namespace
     }
 
     int
-    packNullString( packedOutput_t &packedOutput ) {
+    packNullString( packedOutput_t &packedOutput, irodsProt_t irodsProt ) {
+
+        if ( irodsProt == BINARY_PROT ) {
+            const void* nullStr = NULL_PTR_PACK_STR;
+            return packBinString( nullStr, packedOutput, -1 );
+        }
 
         int myStrlen = strlen( NULL_PTR_PACK_STR );
         void *outPtr;
@@ -1655,7 +1753,7 @@ namespace
                 intValue = *inIntPtr;
                 int* tmpIntPtr = origIntPtr;
                 for ( int i = 0; i < numElement; i++ ) {
-                    *tmpIntPtr = htonl( *inIntPtr );
+                    *tmpIntPtr = irodsProt == BINARY_PROT ? boost::endian::native_to_little( *inIntPtr ) : htonl( *inIntPtr );
                     tmpIntPtr ++;
                     inIntPtr ++;
                 }
@@ -1721,7 +1819,7 @@ namespace
             }
             else {
                 for ( i = 0; i < numElement; i++ ) {
-                    *tmpIntPtr = htons( *inIntPtr );
+                    *tmpIntPtr = irodsProt == BINARY_PROT ? boost::endian::native_to_little( *inIntPtr ) : htons( *inIntPtr );
                     tmpIntPtr ++;
                     inIntPtr ++;
                 }
@@ -1780,7 +1878,12 @@ namespace
             }
             else {
                 for ( i = 0; i < numElement; i++ ) {
-                    myHtonll( *inDoublePtr, tmpDoublePtr );
+                    if ( irodsProt == BINARY_PROT ) {
+                        *tmpDoublePtr = boost::endian::native_to_little( *inDoublePtr );
+                    }
+                    else {
+                        myHtonll( *inDoublePtr, tmpDoublePtr );
+                    }
                     tmpDoublePtr ++;
                     inDoublePtr ++;
                 }
@@ -2014,6 +2117,9 @@ namespace
             /* just fill it with 0 */
             memset( outPtr, 0, len );
         }
+        else if ( irodsProt == BINARY_PROT && !binary_input_contains( inPtr, len ) ) {
+            return USER_PACKSTRUCT_INPUT_ERR;
+        }
         else {
             unpackCharToOutPtr( inPtr, outPtr, len, name, typeInx, irodsProt );
         }
@@ -2030,6 +2136,9 @@ namespace
         if ( irodsProt == XML_PROT ) {
             status = unpackXmlCharToOutPtr( inPtr, outPtr, len, name, typeInx );
         }
+        else if ( irodsProt == BINARY_PROT && !binary_input_contains( inPtr, len ) ) {
+            status = USER_PACKSTRUCT_INPUT_ERR;
+        }
         else {
             status = unpackNatCharToOutPtr( inPtr, outPtr, len );
         }
@@ -2096,9 +2205,51 @@ namespace
             return unpackXmlString( inPtr, unpackedOutput, maxStrLen, name, outStr, peer_version);
         }
 
+        if (irodsProt == BINARY_PROT) {
+            return unpackBinString( inPtr, unpackedOutput, maxStrLen, outStr);
+        }
+
         return unpackNatString( inPtr, unpackedOutput, maxStrLen, outStr);
     }
 
+    int unpackBinString(const void*& inPtr,
+                        packedOutput_t& unpackedOutput,
+                        int maxStrLen,
+                        char*& outStr)
+    {
+        if ( !inPtr ) {
+            rodsLog( LOG_ERROR, "unpackBinString: NULL inPtr" );
+            return SYS_PACK_INSTRUCT_FORMAT_ERR;
+        }
+
+        const int myStrlen = checked_binary_string_length( inPtr );
+        const char* strPtr = static_cast<const char*>(inPtr) + sizeof( std::uint32_t );
+
+        if ( myStrlen < 0 || ( maxStrLen >= 0 && myStrlen >= maxStrLen ) ) {
+            return USER_PACKSTRUCT_INPUT_ERR;
+        }
+
+        const int extLen = maxStrLen >= 0 ? maxStrLen : myStrlen + 1;
+
+        void *outPtr;
+        int status = extendPackedOutput( unpackedOutput, extLen, outPtr );
+        if ( SYS_MALLOC_ERR == status ) {
+            return status;
+        }
+
+        memcpy( outPtr, strPtr, myStrlen );
+        static_cast<char*>(outPtr)[myStrlen] = '\0';
+
+        if ( myStrlen > 0 ) {
+            outStr = static_cast<char*>(outPtr);
+        }
+
+        inPtr = strPtr + myStrlen;
+        unpackedOutput.bBuf.len += extLen;
+
+        return 0;
+    }
+
     int unpackNatString(const void*& inPtr,
                         packedOutput_t& unpackedOutput,
                         int maxStrLen,
@@ -2205,7 +2356,11 @@ namespace
         if (irodsProt == XML_PROT) {
             return unpackXmlStringToOutPtr(inPtr, outPtr, maxStrLen, name, peer_version);
         }
-        
+
+        if (irodsProt == BINARY_PROT) {
+            return unpackBinStringToOutPtr(inPtr, outPtr, maxStrLen);
+        }
+
         return unpackNatStringToOutPtr(inPtr, outPtr, maxStrLen);
     }
 
@@ -2236,6 +2391,17 @@ namespace
                 myPtr = myPtr + tagLen + skipLen;
             }
         }
+        else if ( irodsProt == BINARY_PROT ) {
+            const std::uint32_t myStrlen = strlen( NULL_PTR_PACK_STR );
+            const char* strPtr = myPtr + sizeof( std::uint32_t );
+            if ( binary_input_contains( inPtr, sizeof( std::uint32_t ) + myStrlen ) &&
+                    read_binary_string_length( inPtr ) == myStrlen &&
+                    strncmp( strPtr, NULL_PTR_PACK_STR, myStrlen ) == 0 ) {
+                addPointerToPackedOut( unpackedOutput, 0, NULL );
+                inPtr = strPtr + myStrlen;
+                return 0;
+            }
+        }
         else if ( strcmp( ( const char* )inPtr, NULL_PTR_PACK_STR ) == 0 ) {
             int myStrlen = strlen( NULL_PTR_PACK_STR );
             addPointerToPackedOut( unpackedOutput, 0, NULL );
@@ -2281,6 +2447,10 @@ namespace
             return 0;
         }
 
+        if ( irodsProt == BINARY_PROT && !binary_input_contains( inPtr, sizeof( int ) * numElement ) ) {
+            return USER_PACKSTRUCT_INPUT_ERR;
+        }
+
         void *outPtr;
         extendPackedOutput( unpackedOutput, sizeof( int ) * ( numElement + 1 ), outPtr );
 
@@ -2306,13 +2476,13 @@ namespace
             status = unpackXmlIntToOutPtr( inPtr, outPtr, numElement, name );
         }
         else {
-            status = unpackNatIntToOutPtr( inPtr, outPtr, numElement );
+            status = unpackNatIntToOutPtr( inPtr, outPtr, numElement, irodsProt );
         }
         return status;
     }
 
     int
-    unpackNatIntToOutPtr( const void *&inPtr, void *&outPtr, int numElement ) {
+    unpackNatIntToOutPtr( const void *&inPtr, void *&outPtr, int numElement, irodsProt_t irodsProt ) {
         int *tmpIntPtr, *origIntPtr;
         int i;
         int intValue = 0;
@@ -2334,7 +2504,7 @@ namespace
                 int tmpInt;
 
                 memcpy( &tmpInt, inIntPtr, sizeof( int ) );
-                *tmpIntPtr = htonl( tmpInt );
+                *tmpIntPtr = irodsProt == BINARY_PROT ? boost::endian::little_to_native( tmpInt ) : htonl( tmpInt );
                 if ( i == 0 ) {
                     /* save this and return later */
                     intValue = *tmpIntPtr;
@@ -2418,6 +2588,10 @@ namespace
             return 0;
         }
 
+        if ( irodsProt == BINARY_PROT && !binary_input_contains( inPtr, sizeof( short ) * numElement ) ) {
+            return USER_PACKSTRUCT_INPUT_ERR;
+        }
+
         extendPackedOutput( unpackedOutput, sizeof( short ) * ( numElement + 1 ), outPtr );
 
         intValue = unpackInt16ToOutPtr( inPtr, outPtr, numElement, name, irodsProt );
@@ -2445,13 +2619,13 @@ namespace
             status = unpackXmlInt16ToOutPtr( inPtr, outPtr, numElement, name );
         }
         else {
-            status = unpackNatInt16ToOutPtr( inPtr, outPtr, numElement );
+            status = unpackNatInt16ToOutPtr( inPtr, outPtr, numElement, irodsProt );
         }
 
         return status;
     }
 
-    int unpackNatInt16ToOutPtr( const void *&inPtr, void *&outPtr, int numElement )
+    int unpackNatInt16ToOutPtr( const void *&inPtr, void *&outPtr, int numElement, irodsProt_t irodsProt )
     {
         short *tmpIntPtr, *origIntPtr;
         int i;
@@ -2474,7 +2648,7 @@ namespace
                 short tmpInt;
 
                 memcpy( &tmpInt, inIntPtr, sizeof( short ) );
-                *tmpIntPtr = htons( tmpInt );
+                *tmpIntPtr = irodsProt == BINARY_PROT ? boost::endian::little_to_native( tmpInt ) : htons( tmpInt );
                 if ( i == 0 ) {
                     /* save this and return later */
                     intValue = *tmpIntPtr;
@@ -2554,6 +2728,10 @@ namespace
             return 0;
         }
 
+        if ( irodsProt == BINARY_PROT && !binary_input_contains( inPtr, sizeof( rodsLong_t ) * numElement ) ) {
+            return USER_PACKSTRUCT_INPUT_ERR;
+        }
+
         extendPackedOutput( unpackedOutput, sizeof( rodsLong_t ) * ( numElement + 1 ),
                             outPtr );
 
@@ -2575,13 +2753,13 @@ namespace
                                               name );
         }
         else {
-            status = unpackNatDoubleToOutPtr( inPtr, outPtr, numElement );
+            status = unpackNatDoubleToOutPtr( inPtr, outPtr, numElement, irodsProt );
         }
         return status;
     }
 
     int
-    unpackNatDoubleToOutPtr( const void *&inPtr, void *&outPtr, int numElement ) {
+    unpackNatDoubleToOutPtr( const void *&inPtr, void *&outPtr, int numElement, irodsProt_t irodsProt ) {
         rodsLong_t *tmpDoublePtr, *origDoublePtr;
         int i;
 
@@ -2604,7 +2782,12 @@ namespace
 
                 memcpy( &tmpDouble, inDoublePtr, sizeof( rodsLong_t ) );
 
-                myNtohll( tmpDouble, tmpDoublePtr );
+                if ( irodsProt == BINARY_PROT ) {
+                    *tmpDoublePtr = boost::endian::little_to_native( tmpDouble );
+                }
+                else {
+                    myNtohll( tmpDouble, tmpDoublePtr );
+                }
                 tmpDoublePtr ++;
                 inDoublePtr = ( const char * ) inDoublePtr + sizeof( rodsLong_t );
             }
@@ -2805,6 +2988,19 @@ namespace
         int elementSz = packTypeTable[typeInx].size;
         int myTypeNum = packTypeTable[typeInx].number;
 
+        /* BINARY_PROT items must be within the input before anything is allocated
+         * for them. strings are checked as they are read, but each one carries at
+         * least its length. structs are checked as they are read. */
+        if ( irodsProt == BINARY_PROT && myTypeNum != PACK_STRUCT_TYPE ) {
+            const bool isStr = myTypeNum == PACK_STR_TYPE || myTypeNum == PACK_PI_STR_TYPE;
+            const long long itemCnt = myDim > 0 ? numPointer : 1;
+            const long long itemLen = isStr ? sizeof( std::uint32_t ) : static_cast<long long>( numElement ) * elementSz;
+            if ( itemCnt < 0 || itemLen < 0 ||
+                    !binary_input_contains( inPtr, static_cast<std::size_t>( itemCnt * itemLen ) ) ) {
+                return USER_PACKSTRUCT_INPUT_ERR;
+            }
+        }
+
         /* alloc pointer to an array of pointers if myDim > 0 */
         if ( myDim > 0 ) {
             if ( numPointer > 0 ) {
@@ -2881,7 +3077,7 @@ namespace
             if ( myDim == 0 ) {
                 char *myOutStr;
 
-                myLen = getAllocLenForStr( myPackedItem, inPtr, numStr, maxStrLen );
+                myLen = getAllocLenForStr( myPackedItem, inPtr, numStr, maxStrLen, irodsProt );
                 if ( myLen < 0 ) {
                     return myLen;
                 }
@@ -2902,7 +3098,7 @@ namespace
             else {
                 for ( j = 0; j < numPointer; j++ ) {
                     myLen = getAllocLenForStr( myPackedItem, inPtr, numStr,
-                                               maxStrLen );
+                                               maxStrLen, irodsProt );
                     if ( myLen < 0 ) {
                         return myLen;
                     }
@@ -3065,6 +3261,36 @@ namespace
         return 0;
     }
 
+    int unpackBinStringToOutPtr( const void *&inPtr, void *&outPtr, int maxStrLen )
+    {
+        if ( inPtr == NULL ) {
+            rodsLog( LOG_ERROR, "unpackBinStringToOutPtr: NULL inPtr" );
+            return SYS_PACK_INSTRUCT_FORMAT_ERR;
+        }
+
+        const int myStrlen = checked_binary_string_length( inPtr );
+        const char* strPtr = static_cast<const char*>(inPtr) + sizeof( std::uint32_t );
+
+        /* maxStrLen = -1 means null terminated */
+        if ( myStrlen < 0 || ( maxStrLen >= 0 && myStrlen >= maxStrLen ) ) {
+            return USER_PACKSTRUCT_INPUT_ERR;
+        }
+
+        memcpy( outPtr, strPtr, myStrlen );
+        static_cast<char*>(outPtr)[myStrlen] = '\0';
+
+        inPtr = strPtr + myStrlen;
+
+        if ( maxStrLen >= 0 ) {
+            outPtr = static_cast<char*>(outPtr) + maxStrLen;
+        }
+        else {
+            outPtr = static_cast<char*>(outPtr) + ( myStrlen + 1 );
+        }
+
+        return 0;
+    }
+
     int unpackXmlStringToOutPtr(const void *&inPtr,
                                 void *&outPtr,
                                 int maxStrLen,
@@ -3138,18 +3364,37 @@ namespace
     //
     // A -1 maxStrLen means NULL terminated
     //
-    int getAllocLenForStr( const packItem_t &myPackedItem, const void *inPtr, int numStr, int maxStrLen )
+    int getAllocLenForStr( const packItem_t &myPackedItem, const void *inPtr, int numStr, int maxStrLen, irodsProt_t irodsProt )
     {
         int myLen;
 
         if ( numStr <= 1 ) {
-            myLen = maxStrLen > 0 ? maxStrLen : strlen( (const char* ) inPtr ) + 1;
+            if ( maxStrLen > 0 ) {
+                myLen = maxStrLen;
+            }
+            else if ( irodsProt == BINARY_PROT ) {
+                myLen = checked_binary_string_length( inPtr );
+                if ( myLen < 0 ) {
+                    return myLen;
+                }
+                myLen += 1;
+            }
+            else {
+                myLen = strlen( (const char* ) inPtr ) + 1;
+            }
         }
         else {
             if ( maxStrLen < 0 ) {
                 rodsLog( LOG_ERROR, "getAllocLenForStr: maxStrLen < 0 with numStr > 1 for %s", myPackedItem.name );
                 return SYS_PACK_INSTRUCT_FORMAT_ERR;
             }
+            if ( irodsProt == BINARY_PROT ) {
+                /* every string carries at least its length */
+                if ( static_cast<long long>( numStr ) * maxStrLen > std::numeric_limits<int>::max() ||
+                        !binary_input_contains( inPtr, static_cast<std::size_t>( numStr ) * sizeof( std::uint32_t ) ) ) {
+                    return USER_PACKSTRUCT_INPUT_ERR;
+                }
+            }
             myLen = numStr * maxStrLen;
         }
         return myLen;
@@ -3413,6 +3658,12 @@ int unpackStruct(const void *inPackedStr,
         return USER_PACKSTRUCT_INPUT_ERR;
     }
 
+    // BINARY_PROT strings carry their own length, so the end of the input must be known.
+    if ( irodsProt == BINARY_PROT && !binary_input_end ) {
+        rodsLog( LOG_ERROR, "unpackStruct: BINARY_PROT input requires unpack_struct_with_length" );
+        return USER_PACKSTRUCT_INPUT_ERR;
+    }
+
     /* Initialize the unpackedOutput */
     packedOutput_t unpackedOutput = initPackedOutput(PACKED_OUT_ALLOC_SZ);
 
@@ -3496,6 +3747,12 @@ int unpack_struct(const void *inPackedStr,
         return USER_PACKSTRUCT_INPUT_ERR;
     }
 
+    // BINARY_PROT strings carry their own length, so the end of the input must be known.
+    if (irodsProt == BINARY_PROT && !binary_input_end) {
+        rodsLog(LOG_ERROR, "unpack_struct: BINARY_PROT input requires unpack_struct_with_length.");
+        return USER_PACKSTRUCT_INPUT_ERR;
+    }
+
     std::optional<irods::version> peer_vers;
     if (peer_version) {
         peer_vers = to_version(peer_version);
@@ -3520,3 +3777,22 @@ int unpack_struct(const void *inPackedStr,
     return 0;
 }
 
+int unpack_struct_with_length(const void *inPackedStr,
+                              int inPackedLen,
+                              void **outStruct,
+                              const char *packInstName,
+                              const packInstruct_t *myPackTable,
+                              irodsProt_t irodsProt,
+                              const char* peer_version)
+{
+    if (!inPackedStr || inPackedLen < 0) {
+        rodsLog(LOG_ERROR, "unpack_struct_with_length: Input error. Null input or negative length.");
+        return USER_PACKSTRUCT_INPUT_ERR;
+    }
+
+    const char* previous_end = binary_input_end;
+    binary_input_end = static_cast<const char*>(inPackedStr) + inPackedLen;
+    irods::at_scope_exit restore_end{[previous_end] { binary_input_end = previous_end; }};
+
+    return unpack_struct(inPackedStr, outStruct, packInstName, myPackTable, irodsProt, peer_version);
+}
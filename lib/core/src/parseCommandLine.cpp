@@ -291,6 +291,50 @@ parseCmdLineOpt( int argc, char **argv, const char *optString, int includeLong,
                 }
             }
 
+            if ( strcmp( "--concurrent", argv[i] ) == 0 ) {
+                rodsArgs->concurrent = True;
+                argv[i] = "-Z";
+                if ( i + 2 <= argc ) {
+                    if ( *argv[i + 1] == '-' ) {
+                        rodsLog( LOG_ERROR,
+                                 "--concurrent option needs a number of connections" );
+                        return USER_INPUT_OPTION_ERR;
+                    }
+                    rodsArgs->concurrentValue = atoi( argv[i + 1] );
+                    argv[i + 1] = "-Z";
+                }
+            }
+            if ( strcmp( "--thread-budget", argv[i] ) == 0 ) {
+                rodsArgs->threadBudget = True;
+                argv[i] = "-Z";
+                if ( i + 2 <= argc ) {
+                    if ( *argv[i + 1] == '-' ) {
+                        rodsLog( LOG_ERROR,
+                                 "--thread-budget option needs a number of threads" );
+                        return USER_INPUT_OPTION_ERR;
+                    }
+                    rodsArgs->threadBudgetValue = atoi( argv[i + 1] );
+                    argv[i + 1] = "-Z";
+                }
+            }
+            if ( strcmp( "--bwlimit", argv[i] ) == 0 ) {
+                rodsArgs->bandwidthLimit = True;
+                argv[i] = "-Z";
+                if ( i + 2 <= argc ) {
+                    if ( *argv[i + 1] == '-' ) {
+                        rodsLog( LOG_ERROR,
+                                 "--bwlimit option needs a rate in MB per second" );
+                        return USER_INPUT_OPTION_ERR;
+                    }
+                    rodsArgs->bandwidthLimitValue = atoi( argv[i + 1] );
+                    argv[i + 1] = "-Z";
+                }
+            }
+            if ( strcmp( "--manifest", argv[i] ) == 0 ) {
+                rodsArgs->manifest = True;
+                argv[i] = "-Z";
+            }
+
             if ( strcmp( "--exclude-from", argv[i] ) == 0 ) {
                 rodsArgs->excludeFile = True;
                 argv[i] = "-Z";
@@ -311,10 +311,10 @@ int procApiReply(rcComm_t *conn,
     int retVal;
 
     if ( errorBBuf->len > 0 ) {
-        status = unpack_struct(errorBBuf->buf,
-                               (void**) (static_cast<void*>(&conn->rError)),
-                               "RError_PI", RodsPackTable, conn->irodsProt,
-                               conn->svrVersion->relVersion);
+        status = unpack_struct_with_length(errorBBuf->buf, errorBBuf->len,
+                                           (void**) (static_cast<void*>(&conn->rError)),
+                                           "RError_PI", RodsPackTable, conn->irodsProt,
+                                           conn->svrVersion->relVersion);
         if ( status < 0 ) {
             rodsLogError( LOG_ERROR, status,
                           "readAndProcApiReply:unpack_struct error. status = %d",
@@ -353,9 +353,9 @@ int procApiReply(rcComm_t *conn,
     /* handle outStruct */
     if ( outStructBBuf->len > 0 ) {
         if ( outStruct != NULL ) {
-            status = unpack_struct(outStructBBuf->buf, (void**) outStruct,
-                                   (char*) RcApiTable[apiInx]->outPackInstruct, RodsPackTable,
-                                   conn->irodsProt, conn->svrVersion->relVersion);
+            status = unpack_struct_with_length(outStructBBuf->buf, outStructBBuf->len, (void**) outStruct,
+                                               (char*) RcApiTable[apiInx]->outPackInstruct, RodsPackTable,
+                                               conn->irodsProt, conn->svrVersion->relVersion);
             if ( status < 0 ) {
                 rodsLogError( LOG_ERROR, status,
                               "readAndProcApiReply:unpack_struct error. status = %d",
@@ -18,12 +18,22 @@
 #include "irods_exception.hpp"
 #include "irods_random.hpp"
 #include "irods_log.hpp"
+#include "transfer_scheduler.hpp"
 
 #include "sockComm.h"
 #include <boost/filesystem/operations.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/filesystem/convenience.hpp>
 
+#include <memory>
+#include <optional>
+
+namespace {
+    int putDirUtilImpl( rcComm_t **myConn, char *srcDir, char *targColl,
+                        rodsEnv *myRodsEnv, rodsArguments_t *rodsArgs, dataObjInp_t *dataObjOprInp,
+                        bulkOprInp_t *bulkOprInp, rodsRestart_t *rodsRestart,
+                        bulkOprInfo_t *bulkOprInfo, irods::transfer_scheduler *scheduler );
+} // anonymous namespace
 
 /* checkStateForResume - check the state for resume operation
  * return 0 - skip
@@ -293,6 +303,36 @@ putUtil( rcComm_t **myConn, rodsEnv *myRodsEnv,
                                          myRodsEnv, myRodsArgs, &dataObjOprInp, &bulkOprInp,
                                          &rodsRestart );
             }
+            else if ( myRodsArgs->concurrent == True ) {
+                std::optional<irods::transfer_scheduler> scheduler;
+                try {
+                    auto opts = irods::make_transfer_scheduler_options( *myRodsArgs, *myRodsEnv );
+                    if ( myRodsArgs->ticket == True ) {
+                        opts.on_connect = [myRodsArgs]( rcComm_t& _conn ) {
+                            setSessionTicket( &_conn, myRodsArgs->ticketString );
+                        };
+                    }
+                    scheduler.emplace( opts, *conn, &rodsRestart );
+                }
+                catch ( const std::exception& e ) {
+                    rodsLog( LOG_ERROR, "putUtil: could not start concurrent transfers: %s", e.what() );
+                    return SYS_SOCK_CONNECT_ERR;
+                }
+
+                status = putDirUtilImpl( myConn, rodsPathInp->srcPath[i].outPath,
+                                         targPath->outPath, myRodsEnv, myRodsArgs, &dataObjOprInp,
+                                         &bulkOprInp, &rodsRestart, NULL, &*scheduler );
+
+                // Always drain the scheduler, even if the walk failed, so that the
+                // restart file reflects every transfer that did complete.
+                const int wait_status = scheduler->wait();
+                if ( status == USER_INPUT_PATH_ERR || status == SYS_INVALID_INPUT_PARAM ) {
+                    return status;
+                }
+                if ( status >= 0 && wait_status < 0 ) {
+                    status = wait_status;
+                }
+            }
             else {
                 status = putDirUtil( myConn, rodsPathInp->srcPath[i].outPath,
                                      targPath->outPath, myRodsEnv, myRodsArgs, &dataObjOprInp,
@@ -709,6 +749,19 @@ putDirUtil( rcComm_t **myConn, char *srcDir, char *targColl,
             rodsEnv *myRodsEnv, rodsArguments_t *rodsArgs, dataObjInp_t *dataObjOprInp,
             bulkOprInp_t *bulkOprInp, rodsRestart_t *rodsRestart,
             bulkOprInfo_t *bulkOprInfo )
+{
+    return putDirUtilImpl( myConn, srcDir, targColl, myRodsEnv, rodsArgs, dataObjOprInp,
+                           bulkOprInp, rodsRestart, bulkOprInfo, NULL );
+}
+
+namespace {
+// When scheduler is non-null, files are queued on the scheduler instead of being
+// transferred on myConn. Collections are still created by the walker so that
+// they exist before any of their members are transferred.
+int putDirUtilImpl( rcComm_t **myConn, char *srcDir, char *targColl,
+                    rodsEnv *myRodsEnv, rodsArguments_t *rodsArgs, dataObjInp_t *dataObjOprInp,
+                    bulkOprInp_t *bulkOprInp, rodsRestart_t *rodsRestart,
+                    bulkOprInfo_t *bulkOprInfo, irods::transfer_scheduler *scheduler )
 {
     namespace fs = boost::filesystem;
 
@@ -846,8 +899,11 @@ putDirUtil( rcComm_t **myConn, char *srcDir, char *targColl,
                 }
             }
 
-            status = chkStateForResume( conn, rodsRestart, targChildPath,
-                                            rodsArgs, childObjType, &dataObjOprInp->condInput, 1 );
+            const auto check_state = [&] {
+                return chkStateForResume( conn, rodsRestart, targChildPath,
+                                          rodsArgs, childObjType, &dataObjOprInp->condInput, 1 );
+            };
+            status = scheduler ? scheduler->check_restart_state( check_state ) : check_state();
 
             if ( status < 0 ) {
                 /* restart failed */
@@ -869,6 +925,32 @@ putDirUtil( rcComm_t **myConn, char *srcDir, char *targColl,
                                             dataSize,  dataObjOprInp->createMode, rodsArgs,
                                             bulkOprInp, bulkOprInfo );
                 }
+                else if ( scheduler ) {
+                    // The walker keeps mutating dataObjOprInp, so every queued
+                    // transfer gets its own copy.
+                    std::shared_ptr<dataObjInp_t> inp{new dataObjInp_t{}, []( dataObjInp_t* _p ) {
+                        clearDataObjInp( _p );
+                        delete _p;
+                    }};
+                    replDataObjInp( dataObjOprInp, inp.get() );
+
+                    status = scheduler->schedule( targChildPath, dataSize,
+                        [inp, src = std::string{srcChildPath}, targ = std::string{targChildPath}, dataSize, rodsArgs]
+                        ( rcComm_t& _conn, int _num_threads ) mutable {
+                            inp->numThreads = _num_threads;
+                            try {
+                                return putFileUtil( &_conn, src.data(), targ.data(), dataSize, rodsArgs, inp.get() );
+                            } catch ( const fs::filesystem_error& e ) {
+                                rodsLog( LOG_ERROR, e.what() );
+                                return e.code().value();
+                            }
+                        } );
+
+                    // The scheduler maintains the restart file in walk order.
+                    if ( status >= 0 ) {
+                        continue;
+                    }
+                }
                 else {
                     /* normal put */
                     try {
@@ -906,9 +988,9 @@ putDirUtil( rcComm_t **myConn, char *srcDir, char *targColl,
                         return status;
                     }
                 }
-                status = putDirUtil( myConn, srcChildPath, targChildPath,
-                                    myRodsEnv, rodsArgs, dataObjOprInp, bulkOprInp,
-                                    rodsRestart, bulkOprInfo );
+                status = putDirUtilImpl( myConn, srcChildPath, targChildPath,
+                                         myRodsEnv, rodsArgs, dataObjOprInp, bulkOprInp,
+                                         rodsRestart, bulkOprInfo, scheduler );
 
             }
 
@@ -923,6 +1005,7 @@ putDirUtil( rcComm_t **myConn, char *srcDir, char *targColl,
     }
     return savedStatus;
 }
+} // anonymous namespace
 
 int
 bulkPutDirUtil( rcComm_t **myConn, char *srcDir, char *targColl,
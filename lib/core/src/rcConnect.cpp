@@ -78,7 +78,7 @@ rcComm_t* _rcConnect(
     if ( ( tmpStr = getenv( IRODS_PROT ) ) != NULL ) {
         conn->irodsProt = ( irodsProt_t )atoi( tmpStr );
 
-        if (conn->irodsProt != NATIVE_PROT && conn->irodsProt != XML_PROT) {
+        if (conn->irodsProt != NATIVE_PROT && conn->irodsProt != XML_PROT && conn->irodsProt != BINARY_PROT) {
             rodsLog(LOG_ERROR, "Invalid protocol value.");
             return nullptr;
         }
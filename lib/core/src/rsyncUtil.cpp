@@ -21,8 +21,46 @@
 #include "irods_hasher_factory.hpp"
 #include "irods_path_recursion.hpp"
 #include "irods_exception.hpp"
+#include "sync_manifest_diff.h"
+#include "transfer_scheduler.hpp"
+
+#include "json.hpp"
+
+#include <algorithm>
+#include <ctime>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
 
 static int CurrentTime = 0;
+
+namespace
+{
+    // The number of manifest entries sent to the server in a single request.
+    // Directories are never split across requests, so a request may be larger.
+    constexpr std::size_t manifest_batch_size = 10000;
+
+    struct manifest_file
+    {
+        std::string local_path;
+        std::string relative_path;
+        rodsLong_t size;
+        int mode;
+    };
+
+    struct manifest_batch
+    {
+        std::vector<std::string> collections;
+        std::vector<manifest_file> files;
+        nlohmann::json entries = nlohmann::json::array();
+    };
+
+    int flushManifestBatch( rcComm_t *conn, char *targColl, rodsArguments_t *rodsArgs,
+                            dataObjInp_t *dataObjOprInp, manifest_batch& batch,
+                            irods::transfer_scheduler& scheduler );
+} // anonymous namespace
+
 int
 ageExceeded( int ageLimit, int myTime, char *objPath,
              rodsLong_t fileSize );
@@ -138,8 +176,14 @@ rsyncUtil( rcComm_t *conn, rodsEnv *myRodsEnv, rodsArguments_t *myRodsArgs,
         }
         else if ( srcType == LOCAL_DIR_T && targType == COLL_OBJ_T )
         {
-            status = rsyncDirToCollUtil( conn, srcPath, targPath,
-                                 myRodsEnv, myRodsArgs, &dataObjOprInp );
+            if ( myRodsArgs->manifest == True ) {
+                status = rsyncDirToCollBulkUtil( conn, srcPath, targPath,
+                                                 myRodsEnv, myRodsArgs, &dataObjOprInp );
+            }
+            else {
+                status = rsyncDirToCollUtil( conn, srcPath, targPath,
+                                     myRodsEnv, myRodsArgs, &dataObjOprInp );
+            }
         }
         else if ( srcType == COLL_OBJ_T && targType == COLL_OBJ_T ) {
             addKeyVal( &dataObjCopyInp.srcDataObjInp.condInput,
@@ -1229,3 +1273,287 @@ ageExceeded( int ageLimit, int myTime, char *objPath,
     }
 }
 
+
+int
+rsyncDirToCollBulkUtil( rcComm_t *conn, rodsPath_t *srcPath,
+                        rodsPath_t *targPath, rodsEnv *myRodsEnv, rodsArguments_t *rodsArgs,
+                        dataObjInp_t *dataObjOprInp ) {
+    namespace fs = boost::filesystem;
+
+    if ( srcPath == NULL || targPath == NULL ) {
+        rodsLog( LOG_ERROR,
+                 "rsyncDirToCollBulkUtil: NULL srcPath or targPath input" );
+        return USER__NULL_INPUT_ERR;
+    }
+
+    if ( rodsArgs->recursive != True ) {
+        rodsLog( LOG_ERROR,
+                 "rsyncDirToCollBulkUtil: -r option must be used for putting %s directory",
+                 srcPath->outPath );
+        return USER_INPUT_OPTION_ERR;
+    }
+
+    const fs::path srcDirPath( srcPath->outPath );
+    if ( !exists( srcDirPath ) || !is_directory( srcDirPath ) ) {
+        rodsLog( LOG_ERROR,
+                 "rsyncDirToCollBulkUtil: opendir local dir error for %s, errno = %d\n",
+                 srcPath->outPath, errno );
+        return USER_INPUT_PATH_ERR;
+    }
+
+    std::optional<irods::transfer_scheduler> scheduler;
+    try {
+        scheduler.emplace( irods::make_transfer_scheduler_options( *rodsArgs, *myRodsEnv ), *conn, nullptr );
+    }
+    catch ( const std::exception& e ) {
+        rodsLog( LOG_ERROR, "rsyncDirToCollBulkUtil: could not start concurrent transfers: %s", e.what() );
+        return SYS_SOCK_CONNECT_ERR;
+    }
+
+    // Each request covers whole directories. The relative path of the
+    // top-level directory is empty.
+    std::vector<std::pair<fs::path, std::string>> dirs{{srcDirPath, ""}};
+    manifest_batch batch;
+    int savedStatus = 0;
+
+    while ( !dirs.empty() ) {
+        const auto [dir, relativeDir] = dirs.back();
+        dirs.pop_back();
+
+        try {
+            if ( !irods::is_path_valid_for_recursion( rodsArgs, dir.c_str() ) ) {
+                continue;
+            }
+        }
+        catch ( const irods::exception& _e ) {
+            rodsLog( LOG_ERROR, _e.client_display_what() );
+            savedStatus = USER_INPUT_PATH_ERR;
+            continue;
+        }
+
+        if ( rodsArgs->verbose == True ) {
+            fprintf( stdout, "C- %s%s%s:\n", targPath->outPath, relativeDir.empty() ? "" : "/", relativeDir.c_str() );
+        }
+
+        batch.collections.push_back( relativeDir );
+
+        for ( fs::directory_iterator itr( dir ), end_itr; itr != end_itr; ++itr ) {
+            fs::path p = itr->path();
+            const std::string relativePath = relativeDir.empty()
+                                             ? p.filename().string()
+                                             : relativeDir + "/" + p.filename().string();
+
+            try {
+                if ( !irods::is_path_valid_for_recursion( rodsArgs, p.c_str() ) ) {
+                    continue;
+                }
+            }
+            catch ( const irods::exception& _e ) {
+                rodsLog( LOG_ERROR, _e.client_display_what() );
+                savedStatus = USER_INPUT_PATH_ERR;
+                continue;
+            }
+
+            if ( is_symlink( p ) ) {
+                const fs::path cp = read_symlink( p );
+                // Issue 3663 - If the path is FQDN, do not add srcDir on path
+                p = cp.is_relative() ? dir / cp : cp;
+            }
+
+            if ( is_directory( p ) ) {
+                dirs.emplace_back( p, relativePath );
+                continue;
+            }
+
+            if ( !is_regular_file( p ) ) {
+                continue;
+            }
+
+            const rodsLong_t size = file_size( p );
+            const std::time_t mtime = last_write_time( p );
+
+            if ( rodsArgs->age == True &&
+                    ageExceeded( rodsArgs->agevalue, static_cast<int>( mtime ), const_cast<char*>( p.c_str() ), size ) ) {
+                continue;
+            }
+
+            nlohmann::json entry{
+                {"path", relativePath},
+                {"size", size},
+                {"mtime", mtime}
+            };
+
+            if ( rodsArgs->sizeFlag != True ) {
+                char chksumStr[NAME_LEN]{};
+                const int status = chksumLocFile( p.c_str(), chksumStr, myRodsEnv->rodsDefaultHashScheme );
+                if ( status < 0 ) {
+                    rodsLogError( LOG_ERROR, status,
+                                  "rsyncDirToCollBulkUtil: chksumLocFile error for %s", p.c_str() );
+                    savedStatus = status;
+                    continue;
+                }
+                entry["checksum"] = chksumStr;
+            }
+
+            batch.entries.push_back( std::move( entry ) );
+            batch.files.push_back( {p.string(), relativePath, size, getPathStMode( p.c_str() )} );
+        }
+
+        if ( batch.files.size() >= manifest_batch_size ) {
+            const int status = flushManifestBatch( conn, targPath->outPath, rodsArgs, dataObjOprInp, batch, *scheduler );
+            if ( status < 0 ) {
+                // Leave the remaining directories unvisited.
+                savedStatus = status;
+                break;
+            }
+        }
+    }
+
+    if ( dirs.empty() ) {
+        if ( const int status = flushManifestBatch( conn, targPath->outPath, rodsArgs, dataObjOprInp, batch, *scheduler );
+                status < 0 ) {
+            savedStatus = status;
+        }
+    }
+
+    if ( const int status = scheduler->wait(); status < 0 && savedStatus >= 0 ) {
+        savedStatus = status;
+    }
+
+    return savedStatus;
+}
+
+namespace
+{
+// Sends the batch to the server and schedules a transfer for every entry that
+// differs from the catalog. The transfer itself goes through rsyncFileToDataUtil
+// so that the usual rsync semantics (verification, -l, -v) still apply; the
+// catalog state returned by the server stands in for a per-file getRodsObjType.
+int flushManifestBatch( rcComm_t *conn, char *targColl, rodsArguments_t *rodsArgs,
+                        dataObjInp_t *dataObjOprInp, manifest_batch& batch,
+                        irods::transfer_scheduler& scheduler ) {
+    using json = nlohmann::json;
+
+    if ( batch.collections.empty() ) {
+        return 0;
+    }
+
+    const json input{
+        {"collection", targColl},
+        {"comparison", rodsArgs->sizeFlag == True ? "size" : "checksum"},
+        {"collections", batch.collections},
+        {"entries", batch.entries}
+    };
+
+    std::vector<manifest_file> files;
+    files.swap( batch.files );
+    batch = manifest_batch{};
+
+    char* json_output{};
+    int status = rc_sync_manifest_diff( conn, input.dump().c_str(), &json_output );
+    if ( status < 0 ) {
+        rodsLogError( LOG_ERROR, status, "flushManifestBatch: rc_sync_manifest_diff failed for %s", targColl );
+        return status;
+    }
+
+    json output;
+    try {
+        output = json::parse( json_output );
+        std::free( json_output );
+    }
+    catch ( const json::exception& e ) {
+        std::free( json_output );
+        rodsLog( LOG_ERROR, "flushManifestBatch: could not parse server response: %s", e.what() );
+        return SYS_INTERNAL_ERR;
+    }
+
+    // Parents sort before their children.
+    auto missing = output.at( "missing_collections" ).get<std::vector<std::string>>();
+    std::sort( std::begin( missing ), std::end( missing ) );
+
+    for ( auto&& c : missing ) {
+        if ( c.empty() || rodsArgs->longOption == True ) {
+            continue;
+        }
+
+        std::string coll = std::string{targColl} + "/" + c;
+        status = mkCollR( conn, targColl, coll.data() );
+        if ( status < 0 ) {
+            rodsLogError( LOG_ERROR, status, "flushManifestBatch: mkColl error for %s", coll.c_str() );
+            return status;
+        }
+    }
+
+    // The files were appended in the same order as the entries and the server
+    // preserves that order, so a single forward scan pairs them up.
+    auto file = std::begin( files );
+    int savedStatus = 0;
+
+    for ( auto&& e : output.at( "entries" ) ) {
+        const auto& path = e.at( "path" ).get_ref<const std::string&>();
+        const auto& reason = e.at( "reason" ).get_ref<const std::string&>();
+
+        file = std::find_if( file, std::end( files ), [&path]( const manifest_file& _f ) {
+            return _f.relative_path == path;
+        } );
+
+        if ( file == std::end( files ) ) {
+            rodsLog( LOG_ERROR, "flushManifestBatch: unexpected entry [%s] in server response", path.c_str() );
+            return SYS_INTERNAL_ERR;
+        }
+
+        auto srcPath = std::make_shared<rodsPath_t>();
+        auto targPath = std::make_shared<rodsPath_t>();
+
+        srcPath->objType = LOCAL_FILE_T;
+        srcPath->objState = EXIST_ST;
+        srcPath->size = file->size;
+        rstrcpy( srcPath->outPath, file->local_path.c_str(), MAX_NAME_LEN );
+
+        targPath->objType = DATA_OBJ_T;
+        snprintf( targPath->outPath, MAX_NAME_LEN, "%s/%s", targColl, path.c_str() );
+
+        // "unresolved" entries are looked up the usual way on the pooled connection.
+        const bool lookup = ( reason == "unresolved" );
+
+        if ( reason == "missing" || reason == "stale" ) {
+            targPath->objState = NOT_EXIST_ST;
+        }
+        else if ( !lookup ) {
+            targPath->objState = EXIST_ST;
+            targPath->size = e.at( "data_size" ).get<rodsLong_t>();
+            rstrcpy( targPath->chksum, e.at( "checksum" ).get_ref<const std::string&>().c_str(), NAME_LEN );
+        }
+
+        std::shared_ptr<dataObjInp_t> inp{new dataObjInp_t{}, []( dataObjInp_t* _p ) {
+            clearDataObjInp( _p );
+            delete _p;
+        }};
+        replDataObjInp( dataObjOprInp, inp.get() );
+        inp->createMode = file->mode;
+
+        status = scheduler.schedule( targPath->outPath, file->size,
+            [inp, srcPath, targPath, rodsArgs, lookup]( rcComm_t& _conn, int _num_threads ) {
+                inp->numThreads = _num_threads;
+                if ( lookup ) {
+                    getRodsObjType( &_conn, targPath.get() );
+                }
+                const int status = rsyncFileToDataUtil( &_conn, srcPath.get(), targPath.get(), rodsArgs, inp.get() );
+                if ( targPath->rodsObjStat != NULL ) {
+                    freeRodsObjStat( targPath->rodsObjStat );
+                    targPath->rodsObjStat = NULL;
+                }
+                return status;
+            } );
+
+        if ( status < 0 ) {
+            savedStatus = status;
+            break;
+        }
+
+        ++file;
+    }
+
+    return savedStatus;
+}
+} // anonymous namespace
@@ -181,7 +181,7 @@ irods::error readMsgHeader(
 
     // =-=-=-=-=-=-=-
     // make the call to the "read" interface
-    char tmp_buf[ MAX_NAME_LEN ];
+    char tmp_buf[ MAX_NAME_LEN ]{};
     irods::first_class_object_ptr ptr = boost::dynamic_pointer_cast< irods::first_class_object >( _ptr );
     irods::network_ptr            net = boost::dynamic_pointer_cast< irods::network >( p_ptr );
     ret_err = net->call< void*, struct timeval* >(
@@ -198,14 +198,20 @@ irods::error readMsgHeader(
     }
 
     // =-=-=-=-=-=-=-
-    // unpack the header message, always use XML_PROT for the header
+    // unpack the header message. headers are XML unless the connection
+    // negotiated BINARY_PROT in its startup pack. an XML header always starts
+    // with its opening tag, a binary header starts with the length of the
+    // message type. binary headers are never accepted before negotiation.
+    const irodsProt_t header_protocol =
+        BINARY_PROT == _ptr->protocol() && '<' != tmp_buf[ 0 ] ? BINARY_PROT : XML_PROT;
     msgHeader_t* out_header = 0;
-    int status = unpack_struct(
+    int status = unpack_struct_with_length(
                      static_cast<void*>( tmp_buf ),
+                     sizeof( tmp_buf ),
                      ( void ** )( static_cast< void * >( &out_header ) ),
                      "MsgHeader_PI",
                      RodsPackTable,
-                     XML_PROT, nullptr);
+                     header_protocol, nullptr);
     if ( status < 0 ) {
         return ERROR( status, "unpackStruct error" );
     }
@@ -0,0 +1,325 @@
+#include "transfer_scheduler.hpp"
+
+#include "rodsErrorTable.h"
+#include "rodsLog.h"
+#include "rcMisc.h"
+#include "rcGlobalExtern.h"
+
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+
+namespace
+{
+    // The number of portal threads requested for a large transfer when the
+    // client did not ask for a specific number. Matches the server's default
+    // for "default_number_of_transfer_threads".
+    constexpr int default_portal_threads = 4;
+
+    // The number of queued transfers allowed per connection before the walker
+    // is made to wait. Keeps memory bounded when walking very large trees.
+    constexpr std::size_t queue_depth_per_connection = 16;
+} // anonymous namespace
+
+namespace irods
+{
+    transfer_scheduler::transfer_scheduler(const options& _opts,
+                                           rcComm_t& _progress_conn,
+                                           rodsRestart_t* _restart)
+        : opts_{_opts}
+        , thread_budget_{std::max(_opts.connections,
+                                  _opts.thread_budget > 0
+                                      ? _opts.thread_budget
+                                      : _opts.connections + std::max(_opts.portal_threads, default_portal_threads))}
+        , max_queue_size_{queue_depth_per_connection * std::max(_opts.connections, 1)}
+        , progress_conn_{_progress_conn}
+        , restart_{_restart}
+        , conn_pool_{}
+        , queue_mutex_{}
+        , queue_not_empty_{}
+        , queue_not_full_{}
+        , queue_{}
+        , next_sequence_{}
+        , done_{}
+        , threads_mutex_{}
+        , threads_available_{}
+        , threads_in_use_{}
+        , bandwidth_mutex_{}
+        , next_send_time_{std::chrono::steady_clock::now()}
+        , completion_mutex_{}
+        , next_to_record_{}
+        , completed_out_of_order_{}
+        , restart_blocked_{}
+        , status_{}
+        , workers_{std::max(_opts.connections, 1)}
+        , joined_{}
+    {
+        if (opts_.connections < 1) {
+            throw std::invalid_argument{"transfer_scheduler: number of connections must be greater than zero"};
+        }
+
+        // Throws if any of the connections cannot be established.
+        conn_pool_ = make_connection_pool(opts_.connections);
+
+        for (int i = 0; i < opts_.connections; ++i) {
+            thread_pool::post(workers_, [this] { run_worker(); });
+        }
+    }
+
+    transfer_scheduler::~transfer_scheduler()
+    {
+        wait();
+    }
+
+    int transfer_scheduler::schedule(const std::string& _restart_path, rodsLong_t _size, transfer_function _func)
+    {
+        {
+            std::unique_lock<std::mutex> lk{queue_mutex_};
+
+            queue_not_full_.wait(lk, [this] { return done_ || queue_.size() < max_queue_size_; });
+
+            if (!done_) {
+                queue_.push_back({next_sequence_++, _restart_path, _size, std::move(_func)});
+                queue_not_empty_.notify_one();
+                return 0;
+            }
+        }
+
+        std::lock_guard<std::mutex> lk{completion_mutex_};
+        return status_ < 0 ? status_ : SYS_INVALID_INPUT_PARAM;
+    }
+
+    int transfer_scheduler::check_restart_state(const std::function<int()>& _check)
+    {
+        std::lock_guard<std::mutex> lk{completion_mutex_};
+        return _check();
+    }
+
+    int transfer_scheduler::wait()
+    {
+        {
+            std::lock_guard<std::mutex> lk{queue_mutex_};
+            done_ = true;
+        }
+
+        queue_not_empty_.notify_all();
+        queue_not_full_.notify_all();
+
+        if (!joined_) {
+            workers_.join();
+            joined_ = true;
+        }
+
+        std::lock_guard<std::mutex> lk{completion_mutex_};
+        return status_;
+    }
+
+    void transfer_scheduler::run_worker()
+    {
+        connection_pool::connection_proxy conn;
+
+        try {
+            conn = conn_pool_->get_connection();
+
+            if (opts_.on_connect) {
+                opts_.on_connect(conn);
+            }
+        }
+        catch (const std::exception& e) {
+            rodsLog(LOG_ERROR, "transfer_scheduler: could not prepare pooled connection: %s", e.what());
+
+            {
+                std::lock_guard<std::mutex> lk{completion_mutex_};
+                status_ = SYS_SOCK_CONNECT_ERR;
+            }
+
+            stop_accepting_work();
+
+            return;
+        }
+
+        while (true) {
+            work_item item;
+
+            {
+                std::unique_lock<std::mutex> lk{queue_mutex_};
+
+                queue_not_empty_.wait(lk, [this] { return done_ || !queue_.empty(); });
+
+                if (queue_.empty()) {
+                    return;
+                }
+
+                item = std::move(queue_.front());
+                queue_.pop_front();
+            }
+
+            queue_not_full_.notify_one();
+
+            const bool large = item.size > opts_.large_file_threshold;
+            const int granted = acquire_threads(item.size);
+            const int num_threads = (large && NO_THREADING != opts_.portal_threads) ? granted : opts_.portal_threads;
+
+            throttle(item.size);
+
+            int status = 0;
+
+            try {
+                status = item.func(conn, num_threads);
+            }
+            catch (const std::exception& e) {
+                rodsLog(LOG_ERROR, "transfer_scheduler: transfer of [%s] failed: %s", item.restart_path.c_str(), e.what());
+                status = SYS_INTERNAL_ERR;
+            }
+
+            release_threads(granted);
+            complete(item, status);
+        }
+    }
+
+    void transfer_scheduler::stop_accepting_work()
+    {
+        {
+            std::lock_guard<std::mutex> lk{queue_mutex_};
+            done_ = true;
+            queue_.clear();
+        }
+
+        queue_not_full_.notify_all();
+        queue_not_empty_.notify_all();
+    }
+
+    int transfer_scheduler::acquire_threads(rodsLong_t _size)
+    {
+        int wanted = 1;
+
+        if (_size > opts_.large_file_threshold && NO_THREADING != opts_.portal_threads) {
+            wanted = opts_.portal_threads > 0 ? opts_.portal_threads : default_portal_threads;
+        }
+
+        std::unique_lock<std::mutex> lk{threads_mutex_};
+
+        // Only wait for a single thread. Large transfers take whatever else is
+        // available so that they never starve behind a stream of small files.
+        threads_available_.wait(lk, [this] { return threads_in_use_ < thread_budget_; });
+
+        const int granted = std::min(wanted, thread_budget_ - threads_in_use_);
+        threads_in_use_ += granted;
+
+        return granted;
+    }
+
+    void transfer_scheduler::release_threads(int _count)
+    {
+        {
+            std::lock_guard<std::mutex> lk{threads_mutex_};
+            threads_in_use_ -= _count;
+        }
+
+        threads_available_.notify_all();
+    }
+
+    void transfer_scheduler::throttle(rodsLong_t _size)
+    {
+        if (opts_.bandwidth_limit <= 0 || _size <= 0) {
+            return;
+        }
+
+        using clock_type = std::chrono::steady_clock;
+
+        const auto cost = std::chrono::duration_cast<clock_type::duration>(
+            std::chrono::duration<double>{static_cast<double>(_size) / opts_.bandwidth_limit});
+
+        clock_type::time_point start_time;
+
+        {
+            std::lock_guard<std::mutex> lk{bandwidth_mutex_};
+            start_time = std::max(clock_type::now(), next_send_time_);
+            next_send_time_ = start_time + cost;
+        }
+
+        std::this_thread::sleep_until(start_time);
+    }
+
+    void transfer_scheduler::complete(const work_item& _item, int _status)
+    {
+        const bool restart_enabled = restart_ && restart_->fd > 0;
+
+        std::lock_guard<std::mutex> lk{completion_mutex_};
+
+        if (_status < 0 && CAT_NO_ROWS_FOUND != _status) {
+            rodsLogError(LOG_ERROR, _status, "transfer_scheduler: transfer of [%s] failed.", _item.restart_path.c_str());
+            status_ = _status;
+
+            // Mirror the serial behavior: with a restart file, stop at the first
+            // failure so that a restart resumes from a well-defined position.
+            if (restart_enabled) {
+                restart_blocked_ = true;
+                stop_accepting_work();
+            }
+
+            return;
+        }
+
+        if (gGuiProgressCB) {
+            rstrcpy(progress_conn_.operProgress.curFileName, _item.restart_path.c_str(), MAX_NAME_LEN);
+            progress_conn_.operProgress.totalNumFilesDone++;
+            progress_conn_.operProgress.totalFileSizeDone += _item.size;
+            gGuiProgressCB(&progress_conn_.operProgress);
+        }
+
+        if (!restart_enabled || restart_blocked_) {
+            return;
+        }
+
+        // Only advance the restart position over a contiguous run of completed
+        // transfers so that a restart never skips a file that was not done.
+        completed_out_of_order_.emplace(_item.sequence, _item.restart_path);
+
+        std::string last_done;
+
+        for (auto it = completed_out_of_order_.begin();
+             it != std::end(completed_out_of_order_) && it->first == next_to_record_;
+             it = completed_out_of_order_.erase(it), ++next_to_record_)
+        {
+            ++restart_->curCnt;
+            last_done = it->second;
+        }
+
+        if (!last_done.empty()) {
+            if (const auto ec = writeRestartFile(restart_, last_done.data()); ec < 0) {
+                rodsLogError(LOG_ERROR, ec, "transfer_scheduler: writeRestartFile failed for [%s].", last_done.c_str());
+                status_ = ec;
+            }
+        }
+    }
+
+    auto make_transfer_scheduler_options(const rodsArguments_t& _args, const rodsEnv& _env)
+        -> transfer_scheduler::options
+    {
+        transfer_scheduler::options opts;
+
+        if (_args.concurrentValue > 0) {
+            opts.connections = _args.concurrentValue;
+        }
+
+        if (True == _args.threadBudget && _args.threadBudgetValue > 0) {
+            opts.thread_budget = _args.threadBudgetValue;
+        }
+
+        if (True == _args.number) {
+            opts.portal_threads = 0 == _args.numberValue ? NO_THREADING : _args.numberValue;
+        }
+
+        if (True == _args.bandwidthLimit && _args.bandwidthLimitValue > 0) {
+            opts.bandwidth_limit = static_cast<rodsLong_t>(_args.bandwidthLimitValue) * 1024 * 1024;
+        }
+
+        if (_env.irodsMaxSizeForSingleBuffer > 0) {
+            opts.large_file_threshold = static_cast<rodsLong_t>(_env.irodsMaxSizeForSingleBuffer) * 1024 * 1024;
+        }
+
+        return opts;
+    }
+} // namespace irods
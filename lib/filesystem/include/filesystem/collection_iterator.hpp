@@ -18,7 +18,12 @@ namespace irods::experimental::filesystem::NAMESPACE_IMPL
     enum class collection_options
     {
         none,
-        skip_permission_denied
+        skip_permission_denied,
+
+        // Requests the next page of entries in the background while the current page is
+        // iterated. The connection must not be used for anything else until the iterator
+        // reaches the end or is destroyed. Only used by the client-side collection_iterator.
+        prefetch
     };
 
     class collection_iterator
@@ -77,6 +82,11 @@ namespace irods::experimental::filesystem::NAMESPACE_IMPL
             int handle{};
 #else
             collHandle_t handle{};
+
+            // The state of the listing when the server supports rc_list_collection.
+            // Null if the iterator falls back to rclReadCollection.
+            struct listing_state;
+            std::shared_ptr<listing_state> listing;
 #endif // IRODS_FILESYSTEM_ENABLE_SERVER_SIDE_API
             value_type entry{};
         };
@@ -7,16 +7,151 @@
     #include "rsOpenCollection.hpp"
     #include "rsReadCollection.hpp"
     #include "rsCloseCollection.hpp"
+#else
+    #include "list_collection.h"
+    #include "rodsErrorTable.h"
+
+    #include "json.hpp"
+
+    #include <cstdio>
+    #include <future>
+    #include <optional>
+    #include <tuple>
 #endif // IRODS_FILESYSTEM_ENABLE_SERVER_SIDE_API
 
 #include "irods_at_scope_exit.hpp"
 
+#include <cstdlib>
 #include <functional>
 #include <string>
 #include <cassert>
 
 namespace irods::experimental::filesystem::NAMESPACE_IMPL
 {
+#ifndef IRODS_FILESYSTEM_ENABLE_SERVER_SIDE_API
+    namespace
+    {
+        // The properties requested for every entry. These are the properties of a
+        // collection_entry, in the order they follow the type and name of each entry.
+        const auto listing_columns = nlohmann::json::array({"id", "size", "ctime", "mtime", "owner", "data_type", "mode", "checksum"});
+
+        // Servers never reply to an API number they do not know, so the listing API is only used with
+        // servers released with it.
+        auto server_supports_list_collection(const rxComm& _comm) -> bool
+        {
+            if (!_comm.svrVersion) {
+                return false;
+            }
+
+            int major{};
+            int minor{};
+            int patch{};
+
+            if (std::sscanf(_comm.svrVersion->relVersion, "rods%d.%d.%d", &major, &minor, &patch) != 3) {
+                return false;
+            }
+
+            return std::make_tuple(major, minor, patch) >= std::make_tuple(4, 3, 0);
+        }
+
+        auto list_collection(rxComm& _comm, const nlohmann::json& _input, int& _ec) -> nlohmann::json
+        {
+            char* output{};
+            irods::at_scope_exit free_output{[&output] { std::free(output); }};
+
+            if (_ec = rc_list_collection(&_comm, _input.dump().c_str(), &output); _ec < 0) {
+                return {};
+            }
+
+            return nlohmann::json::parse(output);
+        }
+
+        auto read_page(rxComm& _comm, int _handle) -> nlohmann::json
+        {
+            int ec = 0;
+            auto page = list_collection(_comm, {{"handle", _handle}}, ec);
+
+            if (ec < 0) {
+                throw filesystem_error{"could not read collection entries", detail::make_error_code(ec)};
+            }
+
+            return page;
+        }
+
+        // Properties which do not apply to an entry are null.
+        auto to_integer(const nlohmann::json& _value) -> std::int64_t
+        {
+            return _value.is_null() ? 0 : _value.get<std::int64_t>();
+        }
+
+        auto to_string(const nlohmann::json& _value) -> std::string
+        {
+            return _value.is_null() ? std::string{} : _value.get<std::string>();
+        }
+    } // anonymous namespace
+
+    struct collection_iterator::context::listing_state
+    {
+        nlohmann::json entries;
+        std::size_t index{};
+        std::optional<int> handle;
+        std::future<nlohmann::json> next_page;
+        bool prefetch{};
+
+        auto set_page(rxComm& _comm, nlohmann::json&& _page) -> void
+        {
+            entries = std::move(_page.at("entries"));
+            index = 0;
+            handle.reset();
+
+            if (_page.contains("handle")) {
+                handle = _page.at("handle").get<int>();
+
+                // The request is sent now so that the page is ready by the time the
+                // entries of this page have been consumed.
+                if (prefetch) {
+                    next_page = std::async(std::launch::async, read_page, std::ref(_comm), *handle);
+                }
+            }
+        }
+
+        // Returns the next entry, or nullptr once the listing is exhausted.
+        auto next_entry(rxComm& _comm) -> const nlohmann::json*
+        {
+            while (index == entries.size()) {
+                if (!handle) {
+                    return nullptr;
+                }
+
+                set_page(_comm, next_page.valid() ? next_page.get() : read_page(_comm, *handle));
+            }
+
+            return &entries[index++];
+        }
+
+        auto close(rxComm& _comm) -> void
+        {
+            if (next_page.valid()) {
+                try {
+                    // The server closes the listing once its last page is returned.
+                    if (!next_page.get().contains("handle")) {
+                        handle.reset();
+                    }
+                }
+                catch (...) {
+                    // The listing is being abandoned, so read errors are of no interest.
+                }
+            }
+
+            if (handle) {
+                int ec = 0;
+                list_collection(_comm, {{"handle", *handle}, {"close", true}}, ec);
+                handle.reset();
+            }
+        }
+    };
+#endif // IRODS_FILESYSTEM_ENABLE_SERVER_SIDE_API
+
     collection_iterator::collection_iterator(rxComm& _comm,
                                              const path& _p,
                                              collection_options _opts)
@@ -40,11 +175,29 @@ namespace irods::experimental::filesystem::NAMESPACE_IMPL
             throw filesystem_error{"could not open collection for reading", detail::make_error_code(ctx_->handle)};
         }
 #else
-        const auto no_flags = 0;
+        int ec = SYS_UNMATCHED_API_NUM;
+        nlohmann::json page;
 
-        if (const auto ec = rclOpenCollection(&_comm, const_cast<char*>(_p.c_str()), no_flags, &ctx_->handle); ec < 0) {
+        if (server_supports_list_collection(_comm)) {
+            page = list_collection(_comm, {{"collection", _p.string()}, {"columns", listing_columns}}, ec);
+        }
+
+        // Servers without the API and collections the API does not list are read one entry at a time.
+        if (ec == SYS_UNMATCHED_API_NUM || ec == SYS_NOT_SUPPORTED) {
+            const auto no_flags = 0;
+
+            if (ec = rclOpenCollection(&_comm, const_cast<char*>(_p.c_str()), no_flags, &ctx_->handle); ec < 0) {
+                throw filesystem_error{"could not open collection for reading", detail::make_error_code(ec)};
+            }
+        }
+        else if (ec < 0) {
             throw filesystem_error{"could not open collection for reading", detail::make_error_code(ec)};
         }
+        else {
+            ctx_->listing = std::make_shared<context::listing_state>();
+            ctx_->listing->prefetch = (collection_options::prefetch == _opts);
+            ctx_->listing->set_page(_comm, std::move(page));
+        }
 #endif // IRODS_FILESYSTEM_ENABLE_SERVER_SIDE_API
 
         // Point to the first entry.
@@ -58,6 +211,35 @@ namespace irods::experimental::filesystem::NAMESPACE_IMPL
 
     auto collection_iterator::operator++() -> collection_iterator&
     {
+#ifndef IRODS_FILESYSTEM_ENABLE_SERVER_SIDE_API
+        if (ctx_->listing) {
+            const auto* le = ctx_->listing->next_entry(*ctx_->comm);
+
+            if (!le) {
+                close();
+                ctx_ = nullptr;
+                return *this;
+            }
+
+            // The elements follow "type" and "name" in the order of listing_columns.
+            const auto& values = *le;
+            auto& entry = ctx_->entry;
+
+            entry.status_.type(values[0] == "d" ? object_type::data_object : object_type::collection);
+            entry.path_ = ctx_->path / values[1].get_ref<const std::string&>();
+            entry.data_id_ = values[2].is_null() ? std::string{} : std::to_string(values[2].get<std::int64_t>());
+            entry.data_size_ = static_cast<std::uintmax_t>(to_integer(values[3]));
+            entry.ctime_ = object_time_type{std::chrono::seconds{to_integer(values[4])}};
+            entry.mtime_ = object_time_type{std::chrono::seconds{to_integer(values[5])}};
+            entry.owner_ = to_string(values[6]);
+            entry.data_type_ = to_string(values[7]);
+            entry.data_mode_ = static_cast<unsigned>(to_integer(values[8]));
+            entry.checksum_ = to_string(values[9]);
+
+            return *this;
+        }
+#endif // IRODS_FILESYSTEM_ENABLE_SERVER_SIDE_API
+
         collEnt_t* e{};
 
 #ifdef IRODS_FILESYSTEM_ENABLE_SERVER_SIDE_API
@@ -122,7 +304,12 @@ namespace irods::experimental::filesystem::NAMESPACE_IMPL
 #ifdef IRODS_FILESYSTEM_ENABLE_SERVER_SIDE_API
             rsCloseCollection(ctx_->comm, &ctx_->handle);
 #else
-            rclCloseCollection(&ctx_->handle);
+            if (ctx_->listing) {
+                ctx_->listing->close(*ctx_->comm);
+            }
+            else {
+                rclCloseCollection(&ctx_->handle);
+            }
 #endif // IRODS_FILESYSTEM_ENABLE_SERVER_SIDE_API
         }
     }
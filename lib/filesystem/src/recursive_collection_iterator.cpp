@@ -9,7 +9,11 @@ namespace irods::experimental::filesystem::NAMESPACE_IMPL
                                                                  collection_options _opts)
         : ctx_{}
     {
-        if (collection_iterator iter{_comm, _p, _opts}; collection_iterator{} != iter) {
+        // Entering a sub-collection uses the connection while the listing of its parent is
+        // still open, so the entries of a collection are never prefetched here.
+        const auto opts = (collection_options::prefetch == _opts) ? collection_options::none : _opts;
+
+        if (collection_iterator iter{_comm, _p, opts}; collection_iterator{} != iter) {
             ctx_.reset(new context{});
             ctx_->stack.push(std::move(iter));
         }
@@ -7,4 +7,9 @@ API_PLUGIN_NUMBER(REPLICA_CLOSE_APN,                            20004)
 API_PLUGIN_NUMBER(ATOMIC_APPLY_ACL_OPERATIONS_APN,              20005)
 API_PLUGIN_NUMBER(DATA_OBJECT_FINALIZE_APN,                     20006)
 API_PLUGIN_NUMBER(TOUCH_APN,                                    20007)
+API_PLUGIN_NUMBER(SYNC_MANIFEST_DIFF_APN,                       20008)
+API_PLUGIN_NUMBER(BULK_DATA_OBJECT_REGISTER_APN,                20009)
+API_PLUGIN_NUMBER(BATCH_API_REQUESTS_APN,                       20010)
+API_PLUGIN_NUMBER(LIST_COLLECTION_APN,                          20011)
+API_PLUGIN_NUMBER(COLLECTION_CHECKSUM_APN,                      20012)
 API_PLUGIN_NUMBER(ADAPTER_APN,                                  120000)
@@ -21,6 +21,7 @@
 
 #include "catalog.hpp"
 #include "catalog_utilities.hpp"
+#include "catalog_permission_cache.hpp"
 #include "rodsConnect.h"
 #include "objDesc.hpp"
 #include "irods_stacktrace.hpp"
@@ -491,6 +492,8 @@ namespace
 
                 _trans.commit();
 
+                irods::catalog_permission_cache::erase_collection(logical_path);
+
                 *_output = to_bytes_buffer("{}");
 
                 return 0;
@@ -42,12 +42,20 @@
 #include "fmt/format.h"
 #include "nanodbc/nanodbc.h"
 
+#include <algorithm>
+#include <cstdint>
 #include <cstdlib>
+#include <iterator>
+#include <map>
+#include <optional>
+#include <set>
 #include <string>
 #include <string_view>
 #include <tuple>
 #include <chrono>
 #include <system_error>
+#include <utility>
+#include <vector>
 
 namespace
 {
@@ -58,8 +66,21 @@ namespace
     using log       = irods::experimental::log;
     using json      = nlohmann::json;
     using operation = std::function<int(rsComm_t*, bytesBuf_t*, bytesBuf_t**)>;
+    using avu_type  = std::tuple<std::string, std::string, std::string>; // attribute, value, units
     // clang-format on
 
+    // The maximum number of rows, AVUs or ids referenced by a single statement. Keeps the
+    // number of bind variables and the length of the "in" lists within the limits of every
+    // supported database.
+    constexpr std::size_t max_rows_per_statement = 100;
+
+    struct metadata_operation
+    {
+        avu_type avu;
+        bool add;
+        int index;
+    }; // struct metadata_operation
+
     //
     // Function Prototypes
     //
@@ -74,23 +95,45 @@ namespace
 
     auto make_error_object(const json& _op, int _op_index, const std::string& _error_msg) -> json;
 
-    auto get_object_id(rsComm_t& _comm, const std::string& _entity_name, const ic::entity_type _entity_type) -> int;
+    auto current_timestamp() -> std::string;
 
-    auto get_meta_id(nanodbc::connection& _db_conn, const fs::metadata& _metadata) -> int;
+    auto make_bind_list(std::size_t _count) -> std::string;
 
-    auto is_metadata_attached_to_object(nanodbc::connection& _db_conn, int _object_id, int _meta_id) -> bool;
+    auto make_multi_row_insert(std::string_view _db_instance_name,
+                               std::string_view _table_and_columns,
+                               const std::vector<std::string>& _rows) -> std::string;
 
-    auto insert_metadata(nanodbc::connection& _db_conn, std::string_view _db_instance_name, const fs::metadata& _metadata) -> int;
+    auto get_object_ids(nanodbc::connection& _db_conn,
+                        const std::vector<std::string>& _entity_names,
+                        const ic::entity_type _entity_type) -> std::vector<std::int64_t>;
 
-    auto attach_metadata_to_object(nanodbc::connection& _db_conn, int _object_id, int _meta_id) -> void;
+    auto find_entity_user_cannot_modify(rsComm_t& _comm,
+                                        nanodbc::connection& _db_conn,
+                                        const std::vector<std::int64_t>& _object_ids,
+                                        const ic::entity_type _entity_type) -> std::optional<std::size_t>;
 
-    auto detach_metadata_from_object(nanodbc::connection& _db_conn, int _object_id, int _meta_id) -> void;
+    auto get_meta_ids(nanodbc::connection& _db_conn, const std::vector<avu_type>& _avus) -> std::map<avu_type, std::int64_t>;
 
-    auto execute_metadata_operation(nanodbc::connection& _db_conn,
+    auto insert_metadata(nanodbc::connection& _db_conn,
+                         std::string_view _db_instance_name,
+                         const std::vector<avu_type>& _avus) -> std::map<avu_type, std::int64_t>;
+
+    auto attach_metadata_to_objects(nanodbc::connection& _db_conn,
                                     std::string_view _db_instance_name,
-                                    int _object_id,
-                                    const json& _operation,
-                                    int _op_index) -> std::tuple<int, bytesBuf_t*>;
+                                    const std::vector<std::int64_t>& _object_ids,
+                                    const std::vector<std::int64_t>& _meta_ids) -> void;
+
+    auto detach_metadata_from_objects(nanodbc::connection& _db_conn,
+                                      const std::vector<std::int64_t>& _object_ids,
+                                      const std::vector<std::int64_t>& _meta_ids) -> void;
+
+    auto parse_metadata_operation(const json& _op, int _op_index, metadata_operation& _result) -> std::tuple<int, bytesBuf_t*>;
+
+    auto execute_metadata_operations(nanodbc::connection& _db_conn,
+                                     std::string_view _db_instance_name,
+                                     const std::vector<std::int64_t>& _object_ids,
+                                     const json& _operations,
+                                     const std::vector<metadata_operation>& _metadata_ops) -> std::tuple<int, bytesBuf_t*>;
 
     auto rs_atomic_apply_metadata_operations(rsComm_t*, bytesBuf_t*, bytesBuf_t**) -> int;
 
@@ -151,192 +194,376 @@ namespace
         };
     }
 
-    auto get_object_id(rsComm_t& _comm, const std::string& _entity_name, const ic::entity_type _entity_type) -> int
+    auto current_timestamp() -> std::string
     {
-        std::string gql;
-        switch (_entity_type) {
-            case ic::entity_type::collection:
-                gql = fmt::format("select COLL_ID where COLL_NAME = '{}'", _entity_name);
-                break;
-
-            case ic::entity_type::data_object:
-            {
-                fs::path p = _entity_name;
-                gql = fmt::format("select DATA_ID where COLL_NAME = '{}' and DATA_NAME = '{}'",
-                                  p.parent_path().c_str(),
-                                  p.object_name().c_str());
-                break;
+        using std::chrono::system_clock;
+        using std::chrono::duration_cast;
+        using std::chrono::seconds;
+
+        return fmt::format("{:011}", duration_cast<seconds>(system_clock::now().time_since_epoch()).count());
+    }
+
+    auto make_bind_list(std::size_t _count) -> std::string
+    {
+        std::string list;
+        list.reserve(_count * 3);
+
+        for (std::size_t i = 0; i < _count; ++i) {
+            list += (i == 0) ? "?" : ", ?";
+        }
+
+        return list;
+    }
+
+    auto make_multi_row_insert(std::string_view _db_instance_name,
+                               std::string_view _table_and_columns,
+                               const std::vector<std::string>& _rows) -> std::string
+    {
+        // Oracle does not support multiple rows in a VALUES clause.
+        if (_db_instance_name == "oracle") {
+            std::string sql = "insert all";
+
+            for (auto&& row : _rows) {
+                sql += fmt::format(" into {} values ({})", _table_and_columns, row);
             }
 
-            case ic::entity_type::user:
-                gql = fmt::format("select USER_ID where USER_NAME = '{}'", _entity_name);
-                break;
+            return sql + " select * from DUAL";
+        }
 
-            case ic::entity_type::resource:
-                gql = fmt::format("select RESC_ID where RESC_NAME = '{}'", _entity_name);
-                break;
+        return fmt::format("insert into {} values ({})", _table_and_columns, fmt::join(_rows, "), ("));
+    }
+
+    auto get_object_ids(nanodbc::connection& _db_conn,
+                        const std::vector<std::string>& _entity_names,
+                        const ic::entity_type _entity_type) -> std::vector<std::int64_t>
+    {
+        // Data objects are looked up by parent collection and object name. All other entities
+        // are looked up by name alone and use an empty parent.
+        std::map<std::string, std::vector<std::string>> names_by_parent;
+        std::vector<std::pair<std::string, std::string>> keys;
+        keys.reserve(_entity_names.size());
+
+        for (auto&& entity_name : _entity_names) {
+            if (ic::entity_type::data_object == _entity_type) {
+                const fs::path p = entity_name;
+                keys.emplace_back(p.parent_path().string(), p.object_name().string());
+            }
+            else {
+                keys.emplace_back("", entity_name);
+            }
 
-            default:
-                throw std::runtime_error{fmt::format("Invalid entity type specified [entity_type={}]", _entity_type)};
+            names_by_parent[keys.back().first].push_back(keys.back().second);
         }
 
-        for (auto&& row : irods::query{&_comm, gql}) {
-            return std::stoi(row[0]);
+        std::map<std::pair<std::string, std::string>, std::int64_t> ids;
+
+        for (auto&& [parent, names] : names_by_parent) {
+            for (std::size_t offset = 0; offset < names.size(); offset += max_rows_per_statement) {
+                const auto count = std::min(max_rows_per_statement, names.size() - offset);
+
+                std::string sql;
+                switch (_entity_type) {
+                    case ic::entity_type::collection:
+                        sql = fmt::format("select coll_name, coll_id from R_COLL_MAIN where coll_name in ({})", make_bind_list(count));
+                        break;
+
+                    case ic::entity_type::data_object:
+                        sql = fmt::format("select d.data_name, d.data_id from R_DATA_MAIN d"
+                                          " inner join R_COLL_MAIN c on d.coll_id = c.coll_id "
+                                          "where"
+                                          " c.coll_name = ? and"
+                                          " d.data_name in ({})", make_bind_list(count));
+                        break;
+
+                    case ic::entity_type::user:
+                        sql = fmt::format("select user_name, user_id from R_USER_MAIN where user_name in ({})", make_bind_list(count));
+                        break;
+
+                    case ic::entity_type::resource:
+                        sql = fmt::format("select resc_name, resc_id from R_RESC_MAIN where resc_name in ({})", make_bind_list(count));
+                        break;
+
+                    default:
+                        throw std::runtime_error{fmt::format("Invalid entity type specified [entity_type={}]", _entity_type)};
+                }
+
+                nanodbc::statement stmt{_db_conn};
+                prepare(stmt, sql);
+
+                short index = 0;
+
+                if (ic::entity_type::data_object == _entity_type) {
+                    stmt.bind(index++, parent.c_str());
+                }
+
+                for (std::size_t i = 0; i < count; ++i) {
+                    stmt.bind(index++, names[offset + i].c_str());
+                }
+
+                for (auto row = execute(stmt); row.next();) {
+                    ids.try_emplace({parent, row.get<std::string>(0)}, row.get<std::int64_t>(1));
+                }
+            }
+        }
+
+        std::vector<std::int64_t> object_ids;
+        object_ids.reserve(keys.size());
+
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            const auto iter = ids.find(keys[i]);
+
+            if (iter == std::end(ids)) {
+                throw std::runtime_error{fmt::format("Entity does not exist [entity_name={}]", _entity_names[i])};
+            }
+
+            object_ids.push_back(iter->second);
         }
 
-        throw std::runtime_error{fmt::format("Entity does not exist [entity_name={}]", _entity_name)};
+        return object_ids;
     }
 
-    auto get_meta_id(nanodbc::connection& _db_conn, const fs::metadata& _metadata) -> int
+    auto find_entity_user_cannot_modify(rsComm_t& _comm,
+                                        nanodbc::connection& _db_conn,
+                                        const std::vector<std::int64_t>& _object_ids,
+                                        const ic::entity_type _entity_type) -> std::optional<std::size_t>
     {
-        nanodbc::statement stmt{_db_conn};
+        if (ic::entity_type::user == _entity_type || ic::entity_type::resource == _entity_type) {
+            if (irods::is_privileged_client(_comm)) {
+                return std::nullopt;
+            }
+
+            return 0;
+        }
+
+        std::set<std::int64_t> modifiable;
+
+        const int access_level = static_cast<int>(ic::access_type::modify_object);
 
-        prepare(stmt, "select meta_id from R_META_MAIN "
-                      "where"
-                      " meta_attr_name = ? and"
-                      " meta_attr_value = ? and"
-                      " meta_attr_unit = ?");
+        for (std::size_t offset = 0; offset < _object_ids.size(); offset += max_rows_per_statement) {
+            const auto last = std::next(std::begin(_object_ids), std::min(offset + max_rows_per_statement, _object_ids.size()));
 
-        stmt.bind(0, _metadata.attribute.c_str());
-        stmt.bind(1, _metadata.value.c_str());
-        stmt.bind(2, _metadata.units.c_str());
+            nanodbc::statement stmt{_db_conn};
+
+            prepare(stmt, fmt::format("select a.object_id from R_OBJT_ACCESS a "
+                                      "where"
+                                      " a.user_id = (select user_id from R_USER_MAIN where user_name = ?) and"
+                                      " a.access_type_id >= ? and"
+                                      " a.object_id in ({})",
+                                      fmt::join(std::next(std::begin(_object_ids), offset), last, ", ")));
+
+            stmt.bind(0, _comm.clientUser.userName);
+            stmt.bind(1, &access_level);
+
+            for (auto row = execute(stmt); row.next();) {
+                modifiable.insert(row.get<std::int64_t>(0));
+            }
+        }
 
-        if (auto row = execute(stmt); row.next()) {
-            return row.get<int>(0);
+        for (std::size_t i = 0; i < _object_ids.size(); ++i) {
+            if (modifiable.count(_object_ids[i]) == 0) {
+                return i;
+            }
         }
 
-        return -1;
+        return std::nullopt;
     }
 
-    auto is_metadata_attached_to_object(nanodbc::connection& _db_conn, int _object_id, int _meta_id) -> bool
+    auto get_meta_ids(nanodbc::connection& _db_conn, const std::vector<avu_type>& _avus) -> std::map<avu_type, std::int64_t>
     {
-        nanodbc::statement stmt{_db_conn};
+        std::map<avu_type, std::int64_t> meta_ids;
+
+        for (std::size_t offset = 0; offset < _avus.size(); offset += max_rows_per_statement) {
+            const auto count = std::min(max_rows_per_statement, _avus.size() - offset);
+
+            std::vector<std::string_view> conditions(count, "(meta_attr_name = ? and meta_attr_value = ? and meta_attr_unit = ?)");
+
+            nanodbc::statement stmt{_db_conn};
+
+            prepare(stmt, fmt::format("select meta_id, meta_attr_name, meta_attr_value, meta_attr_unit from R_META_MAIN where {}",
+                                      fmt::join(conditions, " or ")));
 
-        prepare(stmt, "select count(*) from R_OBJT_METAMAP where object_id = ? and meta_id = ?");
+            for (std::size_t i = 0; i < count; ++i) {
+                const auto& [attribute, value, units] = _avus[offset + i];
+                const auto index = static_cast<short>(i * 3);
 
-        stmt.bind(0, &_object_id);
-        stmt.bind(1, &_meta_id);
+                stmt.bind(index, attribute.c_str());
+                stmt.bind(index + 1, value.c_str());
+                stmt.bind(index + 2, units.c_str());
+            }
 
-        if (auto row = execute(stmt); row.next()) {
-            return row.get<int>(0) > 0;
+            for (auto row = execute(stmt); row.next();) {
+                meta_ids.try_emplace({row.get<std::string>(1), row.get<std::string>(2), row.get<std::string>(3, std::string{})},
+                                     row.get<std::int64_t>(0));
+            }
         }
 
-        return false;
+        return meta_ids;
     }
 
-    auto insert_metadata(nanodbc::connection& _db_conn, std::string_view _db_instance_name, const fs::metadata& _metadata) -> int
+    auto insert_metadata(nanodbc::connection& _db_conn,
+                         std::string_view _db_instance_name,
+                         const std::vector<avu_type>& _avus) -> std::map<avu_type, std::int64_t>
     {
-        nanodbc::statement stmt{_db_conn};
+        std::string_view next_id;
 
         if (_db_instance_name == "oracle") {
-            prepare(stmt, "insert into R_META_MAIN (meta_id, meta_attr_name, meta_attr_value, meta_attr_unit, create_ts, modify_ts) "
-                          "values (select R_OBJECTID.nextval from DUAL, ?, ?, ?, ?, ?)");
+            next_id = "R_OBJECTID.nextval";
         }
         else if (_db_instance_name == "mysql") {
-            prepare(stmt, "insert into R_META_MAIN (meta_id, meta_attr_name, meta_attr_value, meta_attr_unit, create_ts, modify_ts) "
-                          "values (R_OBJECTID_nextval(), ?, ?, ?, ?, ?)");
+            next_id = "R_OBJECTID_nextval()";
         }
         else if (_db_instance_name == "postgres") {
-            prepare(stmt, "insert into R_META_MAIN (meta_id, meta_attr_name, meta_attr_value, meta_attr_unit, create_ts, modify_ts) "
-                          "values (nextval('R_OBJECTID'), ?, ?, ?, ?, ?)");
+            next_id = "nextval('R_OBJECTID')";
         }
         else {
             throw std::runtime_error{"Invalid database plugin configuration"};
         }
 
-        using std::chrono::system_clock;
-        using std::chrono::duration_cast;
-        using std::chrono::seconds;
+        // Oracle evaluates a sequence once per statement, so every row of a multi-row insert
+        // would receive the same id. Oracle inserts one row at a time.
+        const std::size_t rows_per_statement = (_db_instance_name == "oracle") ? 1 : max_rows_per_statement;
 
-        const auto timestamp = fmt::format("{:011}", duration_cast<seconds>(system_clock::now().time_since_epoch()).count());
+        const auto timestamp = current_timestamp();
 
-        stmt.bind(0, _metadata.attribute.c_str());
-        stmt.bind(1, _metadata.value.c_str());
-        stmt.bind(2, _metadata.units.c_str());
-        stmt.bind(3, timestamp.c_str());
-        stmt.bind(4, timestamp.c_str());
+        for (std::size_t offset = 0; offset < _avus.size(); offset += rows_per_statement) {
+            const auto count = std::min(rows_per_statement, _avus.size() - offset);
 
-        execute(stmt);
+            std::vector<std::string> rows(count, fmt::format("{}, ?, ?, ?, ?, ?", next_id));
 
-        return get_meta_id(_db_conn, _metadata);
+            nanodbc::statement stmt{_db_conn};
+
+            prepare(stmt, make_multi_row_insert(_db_instance_name,
+                                                "R_META_MAIN (meta_id, meta_attr_name, meta_attr_value, meta_attr_unit, create_ts, modify_ts)",
+                                                rows));
+
+            for (std::size_t i = 0; i < count; ++i) {
+                const auto& [attribute, value, units] = _avus[offset + i];
+                const auto index = static_cast<short>(i * 5);
+
+                stmt.bind(index, attribute.c_str());
+                stmt.bind(index + 1, value.c_str());
+                stmt.bind(index + 2, units.c_str());
+                stmt.bind(index + 3, timestamp.c_str());
+                stmt.bind(index + 4, timestamp.c_str());
+            }
+
+            execute(stmt);
+        }
+
+        return get_meta_ids(_db_conn, _avus);
     }
 
-    auto attach_metadata_to_object(nanodbc::connection& _db_conn, int _object_id, int _meta_id) -> void
+    auto attach_metadata_to_objects(nanodbc::connection& _db_conn,
+                                    std::string_view _db_instance_name,
+                                    const std::vector<std::int64_t>& _object_ids,
+                                    const std::vector<std::int64_t>& _meta_ids) -> void
     {
-        nanodbc::statement stmt{_db_conn};
+        const auto timestamp = current_timestamp();
 
-        prepare(stmt, "insert into R_OBJT_METAMAP (object_id, meta_id, create_ts, modify_ts) "
-                      "values (?, ?, ?, ?)");
+        for (std::size_t m = 0; m < _meta_ids.size(); m += max_rows_per_statement) {
+            const auto first_meta_id = std::next(std::begin(_meta_ids), m);
+            const auto last_meta_id = std::next(std::begin(_meta_ids), std::min(m + max_rows_per_statement, _meta_ids.size()));
 
-        using std::chrono::system_clock;
-        using std::chrono::duration_cast;
-        using std::chrono::seconds;
+            for (std::size_t o = 0; o < _object_ids.size(); o += max_rows_per_statement) {
+                const auto first_object_id = std::next(std::begin(_object_ids), o);
+                const auto last_object_id = std::next(std::begin(_object_ids), std::min(o + max_rows_per_statement, _object_ids.size()));
 
-        const auto timestamp = fmt::format("{:011}", duration_cast<seconds>(system_clock::now().time_since_epoch()).count());
+                // Find the links that already exist so that only the missing ones are inserted.
+                std::set<std::pair<std::int64_t, std::int64_t>> existing_links;
 
-        stmt.bind(0, &_object_id);
-        stmt.bind(1, &_meta_id);
-        stmt.bind(2, timestamp.c_str());
-        stmt.bind(3, timestamp.c_str());
+                {
+                    const auto query = fmt::format("select object_id, meta_id from R_OBJT_METAMAP "
+                                                   "where"
+                                                   " object_id in ({}) and"
+                                                   " meta_id in ({})",
+                                                   fmt::join(first_object_id, last_object_id, ", "),
+                                                   fmt::join(first_meta_id, last_meta_id, ", "));
 
-        execute(stmt);
-    }
+                    for (auto row = execute(_db_conn, query); row.next();) {
+                        existing_links.emplace(row.get<std::int64_t>(0), row.get<std::int64_t>(1));
+                    }
+                }
 
-    auto detach_metadata_from_object(nanodbc::connection& _db_conn, int _object_id, int _meta_id) -> void
-    {
-        nanodbc::statement stmt{_db_conn};
+                std::vector<std::string> rows;
+
+                for (auto object_id = first_object_id; object_id != last_object_id; ++object_id) {
+                    for (auto meta_id = first_meta_id; meta_id != last_meta_id; ++meta_id) {
+                        if (existing_links.count({*object_id, *meta_id}) == 0) {
+                            rows.push_back(fmt::format("{}, {}, ?, ?", *object_id, *meta_id));
+                        }
+                    }
+                }
+
+                for (std::size_t offset = 0; offset < rows.size(); offset += max_rows_per_statement) {
+                    const auto count = std::min(max_rows_per_statement, rows.size() - offset);
+                    const std::vector<std::string> chunk(std::next(std::begin(rows), offset),
+                                                         std::next(std::begin(rows), offset + count));
+
+                    nanodbc::statement stmt{_db_conn};
 
-        prepare(stmt, "delete from R_OBJT_METAMAP where object_id = ? and meta_id = ?");
+                    prepare(stmt, make_multi_row_insert(_db_instance_name,
+                                                        "R_OBJT_METAMAP (object_id, meta_id, create_ts, modify_ts)",
+                                                        chunk));
 
-        stmt.bind(0, &_object_id);
-        stmt.bind(1, &_meta_id);
+                    for (std::size_t i = 0; i < count; ++i) {
+                        const auto index = static_cast<short>(i * 2);
 
-        execute(stmt);
+                        stmt.bind(index, timestamp.c_str());
+                        stmt.bind(index + 1, timestamp.c_str());
+                    }
+
+                    execute(stmt);
+                }
+            }
+        }
     }
 
-    auto execute_metadata_operation(nanodbc::connection& _db_conn,
-                                    std::string_view _db_instance_name,
-                                    int _object_id,
-                                    const json& _op,
-                                    int _op_index) -> std::tuple<int, bytesBuf_t*>
+    auto detach_metadata_from_objects(nanodbc::connection& _db_conn,
+                                      const std::vector<std::int64_t>& _object_ids,
+                                      const std::vector<std::int64_t>& _meta_ids) -> void
+    {
+        for (std::size_t m = 0; m < _meta_ids.size(); m += max_rows_per_statement) {
+            const auto first_meta_id = std::next(std::begin(_meta_ids), m);
+            const auto last_meta_id = std::next(std::begin(_meta_ids), std::min(m + max_rows_per_statement, _meta_ids.size()));
+
+            for (std::size_t o = 0; o < _object_ids.size(); o += max_rows_per_statement) {
+                const auto first_object_id = std::next(std::begin(_object_ids), o);
+                const auto last_object_id = std::next(std::begin(_object_ids), std::min(o + max_rows_per_statement, _object_ids.size()));
+
+                just_execute(_db_conn, fmt::format("delete from R_OBJT_METAMAP "
+                                                   "where"
+                                                   " object_id in ({}) and"
+                                                   " meta_id in ({})",
+                                                   fmt::join(first_object_id, last_object_id, ", "),
+                                                   fmt::join(first_meta_id, last_meta_id, ", ")));
+            }
+        }
+    }
+
+    auto parse_metadata_operation(const json& _op, int _op_index, metadata_operation& _result) -> std::tuple<int, bytesBuf_t*>
     {
         try {
-            fs::metadata md;
+            auto& [attribute, value, units] = _result.avu;
 
-            md.attribute = _op.at("attribute").get<std::string>();
-            md.value = _op.at("value").get<std::string>();
+            attribute = _op.at("attribute").get<std::string>();
+            value = _op.at("value").get<std::string>();
 
-            if (md.attribute.empty() || md.value.empty()) {
-                const auto msg = fmt::format("Empty metadata attribute name or value [attribute={}, value={}]", md.attribute, md.value);
+            if (attribute.empty() || value.empty()) {
+                const auto msg = fmt::format("Empty metadata attribute name or value [attribute={}, value={}]", attribute, value);
                 rodsLog(LOG_ERROR, msg.data());
                 return {SYS_INVALID_INPUT_PARAM, to_bytes_buffer(make_error_object(_op, _op_index, msg).dump())};
             }
 
             // "units" are optional.
             if (_op.count("units")) {
-                md.units = _op.at("units").get<std::string>();
+                units = _op.at("units").get<std::string>();
             }
 
             if (const auto op_code = _op.at("operation").get<std::string>(); op_code == "add") {
-                if (auto meta_id = get_meta_id(_db_conn, md); meta_id > -1) {
-                    if (!is_metadata_attached_to_object(_db_conn, _object_id, meta_id)) {
-                        attach_metadata_to_object(_db_conn, _object_id, meta_id);
-                    }
-                }
-                else if (meta_id = insert_metadata(_db_conn, _db_instance_name, md); meta_id > -1) {
-                    attach_metadata_to_object(_db_conn, _object_id, meta_id);
-                }
-                else {
-                    const auto msg = fmt::format("Failed to insert metadata [attribute={}, value={}, units={}]",
-                                                 md.attribute, md.value, md.units);
-                    rodsLog(LOG_ERROR, msg.data());
-                    return {SYS_INTERNAL_ERR, to_bytes_buffer(make_error_object(_op, _op_index, msg).dump())};
-                }
+                _result.add = true;
             }
             else if (op_code == "remove") {
-                if (const auto meta_id = get_meta_id(_db_conn, md); meta_id > -1) {
-                    detach_metadata_from_object(_db_conn, _object_id, meta_id);
-                }
+                _result.add = false;
             }
             else {
                 // clang-format off
@@ -347,11 +574,9 @@ namespace
                 return {INVALID_OPERATION, to_bytes_buffer(make_error_object(_op, _op_index, "Invalid metadata operation.").dump())};
             }
 
-            return {0, to_bytes_buffer("{}")};
-        }
-        catch (const fs::filesystem_error& e) {
-            log::api::error({{"log_message", e.what()}, {"metadata_operation", _op.dump()}});
-            return {e.code().value(), to_bytes_buffer(make_error_object(_op, _op_index, e.what()).dump())};
+            _result.index = _op_index;
+
+            return {0, nullptr};
         }
         catch (const json::out_of_range& e) {
             log::api::error({{"log_message", e.what()}, {"metadata_operation", _op.dump()}});
@@ -361,10 +586,72 @@ namespace
             log::api::error({{"log_message", e.what()}, {"metadata_operation", _op.dump()}});
             return {JSON_VALIDATION_ERROR, to_bytes_buffer(make_error_object(_op, _op_index, e.what()).dump())};
         }
-        catch (const std::system_error& e) {
-            log::api::error({{"log_message", e.what()}, {"metadata_operation", _op.dump()}});
-            return {e.code().value(), to_bytes_buffer(make_error_object(_op, _op_index, e.what()).dump())};
+    }
+
+    auto execute_metadata_operations(nanodbc::connection& _db_conn,
+                                     std::string_view _db_instance_name,
+                                     const std::vector<std::int64_t>& _object_ids,
+                                     const json& _operations,
+                                     const std::vector<metadata_operation>& _metadata_ops) -> std::tuple<int, bytesBuf_t*>
+    {
+        // An "add" guarantees that an AVU is attached to the objects and a "remove" guarantees
+        // that it is not, no matter what happened before. Applying only the last operation on
+        // each AVU therefore produces the same result as executing the operations in order.
+        std::map<avu_type, const metadata_operation*> last_ops;
+
+        for (auto&& op : _metadata_ops) {
+            last_ops.insert_or_assign(op.avu, &op);
+        }
+
+        std::vector<avu_type> avus;
+        avus.reserve(last_ops.size());
+
+        for (auto&& [avu, op] : last_ops) {
+            avus.push_back(avu);
+        }
+
+        // Resolve the ids of every AVU referenced by the operations and insert the AVUs
+        // which are added but do not exist yet.
+        auto meta_ids = get_meta_ids(_db_conn, avus);
+
+        std::vector<avu_type> missing_avus;
+
+        for (auto&& [avu, op] : last_ops) {
+            if (op->add && meta_ids.count(avu) == 0) {
+                missing_avus.push_back(avu);
+            }
+        }
+
+        if (!missing_avus.empty()) {
+            meta_ids.merge(insert_metadata(_db_conn, _db_instance_name, missing_avus));
+        }
+
+        std::vector<std::int64_t> meta_ids_to_attach;
+        std::vector<std::int64_t> meta_ids_to_detach;
+
+        for (auto&& [avu, op] : last_ops) {
+            const auto iter = meta_ids.find(avu);
+
+            if (iter != std::end(meta_ids)) {
+                (op->add ? meta_ids_to_attach : meta_ids_to_detach).push_back(iter->second);
+            }
+            else if (op->add) {
+                const auto& [attribute, value, units] = avu;
+                const auto msg = fmt::format("Failed to insert metadata [attribute={}, value={}, units={}]", attribute, value, units);
+                rodsLog(LOG_ERROR, msg.data());
+                return {SYS_INTERNAL_ERR, to_bytes_buffer(make_error_object(_operations[op->index], op->index, msg).dump())};
+            }
         }
+
+        // The same entity may be listed more than once.
+        std::vector<std::int64_t> object_ids = _object_ids;
+        std::sort(std::begin(object_ids), std::end(object_ids));
+        object_ids.erase(std::unique(std::begin(object_ids), std::end(object_ids)), std::end(object_ids));
+
+        detach_metadata_from_objects(_db_conn, object_ids, meta_ids_to_detach);
+        attach_metadata_to_objects(_db_conn, _db_instance_name, object_ids, meta_ids_to_attach);
+
+        return {0, to_bytes_buffer("{}")};
     }
 
     auto rs_atomic_apply_metadata_operations(rsComm_t* _comm, bytesBuf_t* _input, bytesBuf_t** _output) -> int
@@ -415,20 +702,51 @@ namespace
             return INPUT_ARG_NOT_WELL_FORMED_ERR;
         }
 
-        std::string entity_name;
+        std::vector<std::string> entity_names;
         ic::entity_type entity_type;
-        int object_id = -1;
 
         try {
-            entity_name = input.at("entity_name").get<std::string>();
+            if (input.count("entity_names")) {
+                if (input.count("entity_name")) {
+                    throw std::invalid_argument{"entity_name and entity_names cannot be used together"};
+                }
+
+                entity_names = input.at("entity_names").get<std::vector<std::string>>();
+
+                if (entity_names.empty()) {
+                    throw std::invalid_argument{"entity_names must contain at least one entity"};
+                }
+            }
+            else {
+                entity_names.push_back(input.at("entity_name").get<std::string>());
+            }
+
             entity_type = ic::entity_type_map.at(input.at("entity_type").get<std::string>());
-            object_id = get_object_id(*_comm, entity_name, entity_type);
         }
         catch (const std::exception& e) {
             *_output = to_bytes_buffer(make_error_object(json{}, 0, e.what()).dump());
             return SYS_INVALID_INPUT_PARAM;
         }
 
+        // Every operation is validated before the catalog is touched.
+        std::vector<metadata_operation> metadata_ops;
+
+        try {
+            const auto& operations = input.at("operations");
+            metadata_ops.resize(operations.size());
+
+            for (json::size_type i = 0; i < operations.size(); ++i) {
+                if (const auto [ec, bbuf] = parse_metadata_operation(operations[i], i, metadata_ops[i]); ec != 0) {
+                    *_output = bbuf;
+                    return ec;
+                }
+            }
+        }
+        catch (const json::exception& e) {
+            *_output = to_bytes_buffer(make_error_object(json{}, 0, e.what()).dump());
+            return JSON_VALIDATION_ERROR;
+        }
+
         std::string db_instance_name;
         nanodbc::connection db_conn;
 
@@ -440,38 +758,45 @@ namespace
             return SYS_CONFIG_FILE_ERR;
         }
 
-        if (!ic::user_has_permission_to_modify_entity(*_comm, db_conn, object_id, entity_type)) {
-            log::api::error("User not allowed to modify metadata [entity_name={}, entity_type={}, object_id={}]",
-                            entity_name, input.at("entity_type").get<std::string>(), object_id);
-            *_output = to_bytes_buffer(make_error_object(json{}, 0, "User not allowed to modify metadata").dump());
-            return CAT_NO_ACCESS_PERMISSION;
+        std::vector<std::int64_t> object_ids;
+
+        try {
+            object_ids = get_object_ids(db_conn, entity_names, entity_type);
+
+            if (const auto i = find_entity_user_cannot_modify(*_comm, db_conn, object_ids, entity_type); i) {
+                log::api::error("User not allowed to modify metadata [entity_name={}, entity_type={}, object_id={}]",
+                                entity_names[*i], input.at("entity_type").get<std::string>(), object_ids[*i]);
+                *_output = to_bytes_buffer(make_error_object(json{}, 0, "User not allowed to modify metadata").dump());
+                return CAT_NO_ACCESS_PERMISSION;
+            }
+        }
+        catch (const std::exception& e) {
+            *_output = to_bytes_buffer(make_error_object(json{}, 0, e.what()).dump());
+            return SYS_INVALID_INPUT_PARAM;
         }
 
         return ic::execute_transaction(db_conn, [&](auto& _trans) -> int
         {
             try {
-                const auto& operations = input.at("operations");
-
-                for (json::size_type i = 0; i < operations.size(); ++i) {
-                    const auto [ec, bbuf] = execute_metadata_operation(_trans.connection(),
-                                                                       db_instance_name,
-                                                                       object_id,
-                                                                       operations[i],
-                                                                       i);
-
-                    if (ec != 0) {
-                        *_output = bbuf;
-                        return ec;
-                    }
+                const auto [ec, bbuf] = execute_metadata_operations(_trans.connection(),
+                                                                    db_instance_name,
+                                                                    object_ids,
+                                                                    input.at("operations"),
+                                                                    metadata_ops);
+
+                if (ec != 0) {
+                    *_output = bbuf;
+                    return ec;
                 }
 
                 _trans.commit();
 
-                *_output = to_bytes_buffer("{}");
+                *_output = bbuf;
 
                 return 0;
             }
-            catch (const json::type_error& e) {
+            catch (const std::exception& e) {
+                log::api::error({{"log_message", e.what()}});
                 *_output = to_bytes_buffer(make_error_object(json{}, 0, e.what()).dump());
                 return SYS_INTERNAL_ERR;
             }
@@ -0,0 +1,320 @@
+#include "api_plugin_number.h"
+#include "apiNumber.h"
+#include "rodsDef.h"
+#include "rcConnect.h"
+#include "rodsPackInstruct.h"
+#include "apiHandler.hpp"
+#include "client_api_whitelist.hpp"
+
+#include <functional>
+
+#ifdef RODS_SERVER
+
+//
+// Server-side Implementation
+//
+
+#include "irods_api_number_validator.hpp"
+#include "irods_exception.hpp"
+#include "irods_logger.hpp"
+#include "irods_network_factory.hpp"
+#include "rcMisc.h"
+#include "rodsErrorTable.h"
+#include "rsApiHandler.hpp"
+#include "sockCommNetworkInterface.hpp"
+
+#include "fmt/format.h"
+
+#include <arpa/inet.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+/*
+ The expected input format:
+ ~~~~~~~~~~~~~~~~~~~~~~~~~~
+ Every integer is an unsigned 32-bit integer in network byte order.
+
+     flags           // Bit 0: stop on the first failed request.
+     request_count
+     request_count times:
+         api_number
+         input_length
+         byte_stream_length
+         input           // The input struct, packed for the connection's protocol.
+         byte_stream
+
+ The replies:
+ ~~~~~~~~~~~~
+ The agent replies to the batch itself first. If the batch is accepted, one API reply per
+ request follows, in request order, exactly as if each request had been sent on its own.
+ Requests following a failed request are answered with SYS_BATCH_REQUEST_SKIPPED when the
+ stop-on-error flag is set. APIs which exchange more than one reply with the client are
+ answered with SYS_NOT_SUPPORTED and are not executed.
+*/
+
+namespace
+{
+    // clang-format off
+    using log       = irods::experimental::log;
+    using operation = std::function<int(rsComm_t*, bytesBuf_t*)>;
+    // clang-format on
+
+    constexpr std::uint32_t stop_on_error_flag = 0x1;
+
+    // APIs which send the client more than one message, or change the connection, after the
+    // request is read. Their extra messages would be taken as the replies of the requests
+    // which follow in the batch.
+    // clang-format off
+    constexpr std::array multi_message_api_numbers{
+        DATA_OBJ_PUT_AN,    // Parallel transfers reply with the portal and wait for the client.
+        DATA_OBJ_GET_AN,    // Same as DATA_OBJ_PUT_AN.
+        EXEC_MY_RULE_AN,    // Client-side microservices are requested with SYS_SVR_TO_CLI_MSI_REQUEST.
+        COLL_REPL_AN,       // Progress is reported with SYS_SVR_TO_CLI_COLL_STAT.
+        RM_COLL_AN,         // Same as COLL_REPL_AN.
+        SSL_START_AN,       // The TLS handshake follows the reply.
+        SSL_END_AN          // The TLS shutdown follows the reply.
+    };
+    // clang-format on
+
+    struct api_request
+    {
+        int api_number;
+        std::string input;
+        std::string byte_stream;
+    }; // struct api_request
+
+    //
+    // Function Prototypes
+    //
+
+    auto call_batch_api_requests(irods::api_entry*, rsComm_t*, bytesBuf_t*) -> int;
+
+    auto rs_batch_api_requests(rsComm_t*, bytesBuf_t*) -> int;
+
+    //
+    // Function Implementations
+    //
+
+    class input_reader
+    {
+    public:
+        explicit input_reader(const bytesBuf_t& _bbuf)
+            : data_{static_cast<const char*>(_bbuf.buf)}
+            , size_{static_cast<std::size_t>(_bbuf.len)}
+            , pos_{}
+        {
+        }
+
+        auto read_uint32() -> std::uint32_t
+        {
+            std::uint32_t value;
+            std::memcpy(&value, read_bytes(sizeof(value)), sizeof(value));
+            return ntohl(value);
+        }
+
+        auto read_string(std::size_t _length) -> std::string
+        {
+            return {read_bytes(_length), _length};
+        }
+
+        auto at_end() const noexcept -> bool
+        {
+            return pos_ == size_;
+        }
+
+    private:
+        auto read_bytes(std::size_t _length) -> const char*
+        {
+            if (_length > size_ - pos_) {
+                THROW(INPUT_ARG_NOT_WELL_FORMED_ERR, "Batch request is truncated.");
+            }
+
+            const auto* p = data_ + pos_;
+            pos_ += _length;
+
+            return p;
+        }
+
+        const char* data_;
+        std::size_t size_;
+        std::size_t pos_;
+    }; // class input_reader
+
+    auto parse_requests(const bytesBuf_t* _input, bool& _stop_on_error) -> std::vector<api_request>
+    {
+        if (!_input || !_input->buf || _input->len <= 0) {
+            THROW(SYS_INVALID_INPUT_PARAM, "Batch request is empty.");
+        }
+
+        input_reader reader{*_input};
+
+        _stop_on_error = reader.read_uint32() & stop_on_error_flag;
+
+        const auto count = reader.read_uint32();
+
+        std::vector<api_request> requests;
+
+        for (std::uint32_t i = 0; i < count; ++i) {
+            api_request r;
+            r.api_number = static_cast<int>(reader.read_uint32());
+
+            const auto input_length = reader.read_uint32();
+            const auto byte_stream_length = reader.read_uint32();
+
+            r.input = reader.read_string(input_length);
+            r.byte_stream = reader.read_string(byte_stream_length);
+
+            requests.push_back(std::move(r));
+        }
+
+        if (!reader.at_end()) {
+            THROW(INPUT_ARG_NOT_WELL_FORMED_ERR, "Batch request has trailing bytes.");
+        }
+
+        return requests;
+    } // parse_requests
+
+    // Answers a request which was not executed. Used for requests which never reach
+    // rsApiHandler so that the client always receives exactly one reply per request.
+    auto send_error_reply(rsComm_t& _comm, int _ec) -> void
+    {
+        irods::network_object_ptr net_obj;
+
+        if (const auto ret = irods::network_factory(&_comm, net_obj); !ret.ok()) {
+            irods::log(PASS(ret));
+            return;
+        }
+
+        if (const auto ret = sendRodsMsg(net_obj, RODS_API_REPLY_T, nullptr, nullptr, nullptr, _ec, _comm.irodsProt); !ret.ok()) {
+            irods::log(PASS(ret));
+        }
+    } // send_error_reply
+
+    auto execute_request(rsComm_t& _comm, api_request& _request) -> int
+    {
+        if (BATCH_API_REQUESTS_APN == _request.api_number) {
+            log::api::error("Batch requests cannot be nested.");
+            send_error_reply(_comm, SYS_INVALID_INPUT_PARAM);
+            return SYS_INVALID_INPUT_PARAM;
+        }
+
+        const auto multi_message = std::find(std::begin(multi_message_api_numbers),
+                                             std::end(multi_message_api_numbers),
+                                             _request.api_number);
+
+        if (multi_message != std::end(multi_message_api_numbers)) {
+            log::api::error(fmt::format("Batched API exchanges more than one reply [api_number={}].", _request.api_number));
+            send_error_reply(_comm, SYS_NOT_SUPPORTED);
+            return SYS_NOT_SUPPORTED;
+        }
+
+        // rsApiHandler does not reply to unsupported API numbers.
+        if (const auto [supported, ec] = irods::is_api_number_supported(_request.api_number); !supported) {
+            log::api::error(fmt::format("Batched API number is not supported [api_number={}].", _request.api_number));
+            send_error_reply(_comm, ec);
+            return ec;
+        }
+
+        // std::string keeps the buffers null-terminated, which unpacking XML relies on.
+        // rsApiHandler does not take ownership of either buffer.
+        bytesBuf_t input{static_cast<int>(_request.input.size()), _request.input.data()};
+        bytesBuf_t byte_stream{static_cast<int>(_request.byte_stream.size()), _request.byte_stream.data()};
+
+        return rsApiHandler(&_comm, _request.api_number, &input, &byte_stream);
+    } // execute_request
+
+    auto rs_batch_api_requests(rsComm_t* _comm, bytesBuf_t* _input) -> int
+    {
+        bool stop_on_error = false;
+        std::vector<api_request> requests;
+
+        try {
+            requests = parse_requests(_input, stop_on_error);
+        }
+        catch (const irods::exception& e) {
+            log::api::error(e.what());
+            addRErrorMsg(&_comm->rError, e.code(), e.client_display_what());
+            return e.code();
+        }
+
+        // Accept the batch. From here on, the client expects one reply per request.
+        if (const auto ec = sendApiReply(_comm, _comm->apiInx, 0, nullptr, nullptr); ec < 0) {
+            log::api::error(fmt::format("Failed to accept batch request [error_code={}].", ec));
+            return SYS_NO_HANDLER_REPLY_MSG;
+        }
+
+        bool failed = false;
+
+        for (auto&& r : requests) {
+            if (failed && stop_on_error) {
+                send_error_reply(*_comm, SYS_BATCH_REQUEST_SKIPPED);
+                continue;
+            }
+
+            if (const auto ec = execute_request(*_comm, r); ec < 0 && ec != SYS_NO_HANDLER_REPLY_MSG) {
+                failed = true;
+            }
+        }
+
+        return SYS_NO_HANDLER_REPLY_MSG;
+    } // rs_batch_api_requests
+
+    auto call_batch_api_requests(irods::api_entry* _api, rsComm_t* _comm, bytesBuf_t* _input) -> int
+    {
+        return _api->call_handler<bytesBuf_t*>(_comm, _input);
+    } // call_batch_api_requests
+
+    const operation op = rs_batch_api_requests;
+    #define CALL_BATCH_API_REQUESTS call_batch_api_requests
+} // anonymous namespace
+
+#else // RODS_SERVER
+
+//
+// Client-side Implementation
+//
+
+namespace
+{
+    using operation = std::function<int(rsComm_t*, bytesBuf_t*)>;
+    const operation op{};
+    #define CALL_BATCH_API_REQUESTS nullptr
+} // anonymous namespace
+
+#endif // RODS_SERVER
+
+// The plugin factory function must always be defined.
+extern "C"
+auto plugin_factory(const std::string& _instance_name,
+                    const std::string& _context) -> irods::api_entry*
+{
+#ifdef RODS_SERVER
+    irods::client_api_whitelist::instance().add(BATCH_API_REQUESTS_APN);
+#endif // RODS_SERVER
+
+    // Each batched request is checked against its own API's authorization requirements.
+    // clang-format off
+    irods::apidef_t def{BATCH_API_REQUESTS_APN,     // API number
+                        RODS_API_VERSION,           // API version
+                        NO_USER_AUTH,               // Client auth
+                        NO_USER_AUTH,               // Proxy auth
+                        "BinBytesBuf_PI", 0,        // In PI / bs flag
+                        nullptr, 0,                 // Out PI / bs flag
+                        op,                         // Operation
+                        "api_batch_api_requests",   // Operation name
+                        nullptr,                    // Clear function
+                        (funcPtr) CALL_BATCH_API_REQUESTS};
+    // clang-format on
+
+    auto* api = new irods::api_entry{def};
+
+    api->in_pack_key = "BinBytesBuf_PI";
+    api->in_pack_value = BytesBuf_PI;
+
+    return api;
+}
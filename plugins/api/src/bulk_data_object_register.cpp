@@ -0,0 +1,357 @@
+#include "api_plugin_number.h"
+#include "rodsDef.h"
+#include "rcConnect.h"
+#include "rodsPackInstruct.h"
+#include "apiHandler.hpp"
+#include "client_api_whitelist.hpp"
+
+#include <functional>
+
+#ifdef RODS_SERVER
+
+//
+// Server-side Implementation
+//
+
+#include "bulk_data_object_register.h"
+
+#include "catalog_utilities.hpp"
+#include "fileDriver.hpp"
+#include "icatHighLevelRoutines.hpp"
+#include "irods_exception.hpp"
+#include "irods_file_object.hpp"
+#include "irods_logger.hpp"
+#include "irods_resource_manager.hpp"
+#include "irods_rs_comm_query.hpp"
+#include "irods_server_api_call.hpp"
+#include "rcMisc.h"
+#include "rodsErrorTable.h"
+
+#include "fmt/format.h"
+#include "json.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+extern irods::resource_manager resc_mgr;
+
+/*
+ The expected JSON format:
+ ~~~~~~~~~~~~~~~~~~~~~~~~~
+ {
+     "data_objects": [
+         {
+             // Must be an absolute path. The parent collection must exist.
+             "logical_path": string,
+
+             // Must resolve to a leaf resource.
+             "resource_hierarchy": string,
+
+             "physical_path": string,
+             "data_size": integer,
+
+             // Defaults to "generic".
+             "data_type": string,
+
+             // Optional.
+             "data_mode": string,
+             "checksum": string
+         }
+     ]
+ }
+
+ The JSON output:
+ ~~~~~~~~~~~~~~~~
+ {
+     // In the same order as the input.
+     "data_objects": [
+         {
+             "logical_path": string,
+             "data_id": integer
+         }
+     ]
+ }
+*/
+
+namespace
+{
+    // clang-format off
+    namespace ic = irods::experimental::catalog;
+
+    using json      = nlohmann::json;
+    using log       = irods::experimental::log;
+    using operation = std::function<int(rsComm_t*, bytesBuf_t*, bytesBuf_t**)>;
+
+    // JSON Properties
+    constexpr std::string_view prop_data_objects      = "data_objects";
+    constexpr std::string_view prop_logical_path      = "logical_path";
+    constexpr std::string_view prop_resource_hierarchy = "resource_hierarchy";
+    constexpr std::string_view prop_physical_path     = "physical_path";
+    constexpr std::string_view prop_data_size         = "data_size";
+    constexpr std::string_view prop_data_type         = "data_type";
+    constexpr std::string_view prop_data_mode         = "data_mode";
+    constexpr std::string_view prop_checksum          = "checksum";
+    constexpr std::string_view prop_data_id           = "data_id";
+    // clang-format on
+
+    //
+    // Function Prototypes
+    //
+
+    auto call_bulk_data_object_register(irods::api_entry*, rsComm_t*, bytesBuf_t*, bytesBuf_t**) -> int;
+
+    auto rs_bulk_data_object_register(rsComm_t*, bytesBuf_t*, bytesBuf_t**) -> int;
+
+    //
+    // Function Implementations
+    //
+
+    auto to_bytes_buffer(std::string_view _s) -> bytesBuf_t*
+    {
+        constexpr auto allocate = [](const auto bytes) noexcept
+        {
+            return std::memset(std::malloc(bytes), 0, bytes);
+        };
+
+        const auto buf_size = _s.length() + 1;
+
+        auto* buf = static_cast<char*>(allocate(sizeof(char) * buf_size));
+        std::strncpy(buf, _s.data(), _s.length());
+
+        auto* bbp = static_cast<bytesBuf_t*>(allocate(sizeof(bytesBuf_t)));
+        bbp->len = buf_size;
+        bbp->buf = buf;
+
+        return bbp;
+    } // to_bytes_buffer
+
+    auto parse_json(const bytesBuf_t* _bbuf) -> json
+    {
+        if (!_bbuf) {
+            THROW(SYS_NULL_INPUT, "Could not parse string (null pointer) into JSON.");
+        }
+
+        try {
+            const std::string_view json_string(static_cast<const char*>(_bbuf->buf), _bbuf->len);
+            return json::parse(json_string);
+        }
+        catch (const json::exception&) {
+            THROW(INPUT_ARG_NOT_WELL_FORMED_ERR, "Could not parse string into JSON.");
+        }
+    } // parse_json
+
+    auto throw_if_input_is_invalid(const json& _input) -> void
+    {
+        if (!_input.contains(prop_data_objects) || !_input.at(prop_data_objects.data()).is_array()) {
+            THROW(INPUT_ARG_NOT_WELL_FORMED_ERR, fmt::format("[{}] must be an array.", prop_data_objects));
+        }
+
+        for (auto&& e : _input.at(prop_data_objects.data())) {
+            if (!e.is_object()) {
+                THROW(INPUT_ARG_NOT_WELL_FORMED_ERR, fmt::format("Each entry of [{}] must be an object.", prop_data_objects));
+            }
+
+            for (auto&& prop : {prop_logical_path, prop_resource_hierarchy, prop_physical_path}) {
+                if (!e.contains(prop) || !e.at(prop.data()).is_string() || e.at(prop.data()).get_ref<const std::string&>().empty()) {
+                    THROW(INPUT_ARG_NOT_WELL_FORMED_ERR, fmt::format("Each entry requires a non-empty string for [{}].", prop));
+                }
+            }
+
+            if (!e.contains(prop_data_size) || !e.at(prop_data_size.data()).is_number_integer()) {
+                THROW(INPUT_ARG_NOT_WELL_FORMED_ERR, fmt::format("Each entry requires an integer for [{}].", prop_data_size));
+            }
+
+            if (e.at(prop_logical_path.data()).get_ref<const std::string&>()[0] != '/') {
+                THROW(INPUT_ARG_NOT_WELL_FORMED_ERR, fmt::format("[{}] must be an absolute path.", prop_logical_path));
+            }
+        }
+    } // throw_if_input_is_invalid
+
+    auto copy_string(char* _dst, std::size_t _dst_size, const json& _entry, std::string_view _prop, std::string_view _default = {}) -> void
+    {
+        const auto value = _entry.contains(_prop)
+            ? _entry.at(_prop.data()).get<std::string>()
+            : std::string{_default};
+
+        if (value.size() >= _dst_size) {
+            THROW(USER_STRLEN_TOOLONG, fmt::format("[{}] is too long [value={}].", _prop, value));
+        }
+
+        std::snprintf(_dst, _dst_size, "%s", value.c_str());
+    } // copy_string
+
+    auto to_data_object_info(const json& _entry) -> dataObjInfo_t
+    {
+        dataObjInfo_t info{};
+
+        copy_string(info.objPath, sizeof(info.objPath), _entry, prop_logical_path);
+        copy_string(info.rescHier, sizeof(info.rescHier), _entry, prop_resource_hierarchy);
+        copy_string(info.filePath, sizeof(info.filePath), _entry, prop_physical_path);
+        copy_string(info.dataType, sizeof(info.dataType), _entry, prop_data_type, "generic");
+        copy_string(info.dataMode, sizeof(info.dataMode), _entry, prop_data_mode);
+        copy_string(info.chksum, sizeof(info.chksum), _entry, prop_checksum);
+
+        info.dataSize = _entry.at(prop_data_size.data()).get<rodsLong_t>();
+        info.rescId = resc_mgr.hier_to_leaf_id(info.rescHier);
+        info.replNum = 0;
+        info.replStatus = GOOD_REPLICA;
+        info.flags = NO_COMMIT_FLAG;
+
+        return info;
+    } // to_data_object_info
+
+    auto rs_bulk_data_object_register(rsComm_t* _comm, bytesBuf_t* _input, bytesBuf_t** _output) -> int
+    {
+        if (!_output) {
+            return SYS_INVALID_INPUT_PARAM;
+        }
+
+        *_output = nullptr;
+
+        try {
+            // Registering arbitrary physical paths would expose any file the server
+            // can read, so this API is limited to administrators.
+            if (!irods::is_privileged_client(*_comm)) {
+                THROW(CAT_INSUFFICIENT_PRIVILEGE_LEVEL, "Bulk registration requires rodsadmin level privileges.");
+            }
+
+            // The data objects are registered in a single catalog transaction.
+            if (!ic::connected_to_catalog_provider(*_comm)) {
+                log::api::trace("Redirecting request to catalog service provider ...");
+
+                auto host_info = ic::redirect_to_catalog_provider(*_comm);
+
+                const std::string json_input(static_cast<const char*>(_input->buf), _input->len);
+                char* json_output = nullptr;
+
+                const auto ec = rc_bulk_data_object_register(host_info.conn, json_input.c_str(), &json_output);
+
+                if (json_output) {
+                    *_output = to_bytes_buffer(json_output);
+                    std::free(json_output);
+                }
+
+                return ec;
+            }
+
+            ic::throw_if_catalog_provider_service_role_is_invalid();
+
+            const auto input = parse_json(_input);
+
+            throw_if_input_is_invalid(input);
+
+            std::vector<dataObjInfo_t> data_objects;
+            data_objects.reserve(input.at(prop_data_objects.data()).size());
+
+            for (auto&& e : input.at(prop_data_objects.data())) {
+                data_objects.push_back(to_data_object_info(e));
+            }
+
+            if (const auto ec = chlRegDataObjBulk(_comm, data_objects); ec < 0) {
+                chlRollback(_comm);
+                THROW(ec, "Failed to register data objects.");
+            }
+
+            for (auto&& info : data_objects) {
+                irods::file_object_ptr file_obj{new irods::file_object{_comm, &info}};
+
+                if (const auto ret = fileRegistered(_comm, file_obj); !ret.ok()) {
+                    chlRollback(_comm);
+                    THROW(ret.code(), fmt::format("Failed to signal resource that the data object was registered [path={}].",
+                                                  info.objPath));
+                }
+            }
+
+            if (const auto ec = chlCommit(_comm); ec < 0) {
+                THROW(ec, "Failed to commit the registration of the data objects.");
+            }
+
+            json registered = json::array();
+
+            for (auto&& info : data_objects) {
+                registered.push_back({
+                    {prop_logical_path.data(), info.objPath},
+                    {prop_data_id.data(), info.dataId}
+                });
+            }
+
+            *_output = to_bytes_buffer(json{{prop_data_objects.data(), registered}}.dump());
+
+            return 0;
+        }
+        catch (const irods::exception& e) {
+            log::api::error(e.what());
+            addRErrorMsg(&_comm->rError, e.code(), e.client_display_what());
+            return e.code();
+        }
+        catch (const json::exception& e) {
+            log::api::error(e.what());
+            addRErrorMsg(&_comm->rError, INPUT_ARG_NOT_WELL_FORMED_ERR, e.what());
+            return INPUT_ARG_NOT_WELL_FORMED_ERR;
+        }
+        catch (const std::exception& e) {
+            log::api::error(e.what());
+            addRErrorMsg(&_comm->rError, SYS_UNKNOWN_ERROR, "Cannot process request due to an unexpected error.");
+            return SYS_UNKNOWN_ERROR;
+        }
+    } // rs_bulk_data_object_register
+
+    auto call_bulk_data_object_register(irods::api_entry* _api, rsComm_t* _comm, bytesBuf_t* _input, bytesBuf_t** _output) -> int
+    {
+        return _api->call_handler<bytesBuf_t*, bytesBuf_t**>(_comm, _input, _output);
+    } // call_bulk_data_object_register
+
+    const operation op = rs_bulk_data_object_register;
+    #define CALL_BULK_DATA_OBJECT_REGISTER call_bulk_data_object_register
+} // anonymous namespace
+
+#else // RODS_SERVER
+
+//
+// Client-side Implementation
+//
+
+namespace
+{
+    using operation = std::function<int(rsComm_t*, bytesBuf_t*, bytesBuf_t**)>;
+    const operation op{};
+    #define CALL_BULK_DATA_OBJECT_REGISTER nullptr
+} // anonymous namespace
+
+#endif // RODS_SERVER
+
+// The plugin factory function must always be defined.
+extern "C"
+auto plugin_factory(const std::string& _instance_name,
+                    const std::string& _context) -> irods::api_entry*
+{
+#ifdef RODS_SERVER
+    irods::client_api_whitelist::instance().add(BULK_DATA_OBJECT_REGISTER_APN);
+#endif // RODS_SERVER
+
+    // clang-format off
+    irods::apidef_t def{BULK_DATA_OBJECT_REGISTER_APN,     // API number
+                        RODS_API_VERSION,                  // API version
+                        REMOTE_USER_AUTH,                  // Client auth
+                        REMOTE_USER_AUTH,                  // Proxy auth
+                        "BinBytesBuf_PI", 0,               // In PI / bs flag
+                        "BinBytesBuf_PI", 0,               // Out PI / bs flag
+                        op,                                // Operation
+                        "api_bulk_data_object_register",   // Operation name
+                        nullptr,                           // Clear function
+                        (funcPtr) CALL_BULK_DATA_OBJECT_REGISTER};
+    // clang-format on
+
+    auto* api = new irods::api_entry{def};
+
+    api->in_pack_key = "BinBytesBuf_PI";
+    api->in_pack_value = BytesBuf_PI;
+
+    api->out_pack_key = "BinBytesBuf_PI";
+    api->out_pack_value = BytesBuf_PI;
+
+    return api;
+}
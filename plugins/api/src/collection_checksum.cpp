@@ -0,0 +1,455 @@
+#include "api_plugin_number.h"
+#include "rodsDef.h"
+#include "rcConnect.h"
+#include "rodsPackInstruct.h"
+#include "apiHandler.hpp"
+#include "client_api_whitelist.hpp"
+
+#include <functional>
+
+#ifdef RODS_SERVER
+
+//
+// Server-side Implementation
+//
+
+#include "collection_checksum.h"
+
+#include "collection_checksum.hpp"
+#include "catalog_utilities.hpp"
+#include "rodsConnect.h"
+#include "rodsErrorTable.h"
+#include "objStat.h"
+#include "rcMisc.h"
+#include "rsObjStat.hpp"
+#include "irods_at_scope_exit.hpp"
+#include "irods_exception.hpp"
+#include "irods_server_api_call.hpp"
+#include "irods_re_serialization.hpp"
+#include "irods_logger.hpp"
+
+#define IRODS_FILESYSTEM_ENABLE_SERVER_SIDE_API
+#include "filesystem.hpp"
+
+#include "fmt/format.h"
+#include "json.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/*
+ The expected JSON format (start):
+ ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ {
+     // Must be an absolute path to a collection in the local zone.
+     "collection": string,
+
+     // Only compares checksums. Defaults to false.
+     "verify_only": boolean,
+
+     // Computes and registers missing checksums. Defaults to false.
+     "compute_missing": boolean,
+
+     // Includes stale replicas. Defaults to false.
+     "all_replicas": boolean,
+
+     // Skips permission checks. Requires a privileged user. Defaults to false.
+     "admin_mode": boolean,
+
+     // Defaults to 1000. Cannot exceed 10000.
+     "batch_size": integer
+ }
+
+ The expected JSON format (continue):
+ ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ {
+     "handle": integer,
+
+     // Cancels the job without processing a batch. Defaults to false.
+     "close": boolean
+ }
+
+ The JSON output:
+ ~~~~~~~~~~~~~~~~
+ {
+     // The replicas of the batch which did not verify.
+     "results": [
+         {
+             "logical_path": string,
+             "replica_number": integer,
+             "resource_hierarchy": string,
+
+             // One of "mismatch", "missing", "computed" or "error".
+             "status": string,
+
+             "catalog_checksum": string,
+             "computed_checksum": string,
+             "error_code": integer
+         }
+     ],
+
+     // The totals of the job so far.
+     "progress": {
+         "replicas": integer,
+         "verified": integer,
+         "computed": integer,
+         "missing": integer,
+         "mismatched": integer,
+         "failed": integer,
+         "skipped": integer
+     },
+
+     // Only present if more replicas may remain.
+     "handle": integer
+ }
+*/
+
+namespace
+{
+    // clang-format off
+    namespace fs = irods::experimental::filesystem;
+    namespace ic = irods::experimental::catalog;
+    namespace cc = irods::collection_checksum;
+
+    using json      = nlohmann::json;
+    using log       = irods::experimental::log;
+    using operation = std::function<int(rsComm_t*, bytesBuf_t*, bytesBuf_t**)>;
+
+    // JSON Properties
+    constexpr std::string_view prop_collection      = "collection";
+    constexpr std::string_view prop_verify_only     = "verify_only";
+    constexpr std::string_view prop_compute_missing = "compute_missing";
+    constexpr std::string_view prop_all_replicas    = "all_replicas";
+    constexpr std::string_view prop_admin_mode      = "admin_mode";
+    constexpr std::string_view prop_batch_size      = "batch_size";
+    constexpr std::string_view prop_handle          = "handle";
+    constexpr std::string_view prop_close           = "close";
+    constexpr std::string_view prop_results         = "results";
+    constexpr std::string_view prop_progress        = "progress";
+    // clang-format on
+
+    constexpr std::int64_t default_batch_size = 1000;
+    constexpr std::int64_t max_batch_size = 10000;
+
+    // The maximum number of jobs an agent keeps open at once. Every job may hold connections
+    // to the servers of the resources it has visited.
+    constexpr std::size_t max_open_jobs = 4;
+
+    struct job_state
+    {
+        std::unique_ptr<cc::job> job;
+        std::size_t batch_size;
+    };
+
+    // The open jobs of this agent, keyed by handle.
+    std::map<int, job_state> jobs;
+    int next_handle = 1;
+
+    //
+    // Function Prototypes
+    //
+
+    auto call_collection_checksum(irods::api_entry*, rsComm_t*, bytesBuf_t*, bytesBuf_t**) -> int;
+
+    auto rs_collection_checksum(rsComm_t*, bytesBuf_t*, bytesBuf_t**) -> int;
+
+    //
+    // Function Implementations
+    //
+
+    auto to_bytes_buffer(std::string_view _s) -> bytesBuf_t*
+    {
+        constexpr auto allocate = [](const auto bytes) noexcept
+        {
+            return std::memset(std::malloc(bytes), 0, bytes);
+        };
+
+        const auto buf_size = _s.length() + 1;
+
+        auto* buf = static_cast<char*>(allocate(sizeof(char) * buf_size));
+        std::strncpy(buf, _s.data(), _s.length());
+
+        auto* bbp = static_cast<bytesBuf_t*>(allocate(sizeof(bytesBuf_t)));
+        bbp->len = buf_size;
+        bbp->buf = buf;
+
+        return bbp;
+    } // to_bytes_buffer
+
+    auto parse_json(const bytesBuf_t* _bbuf) -> json
+    {
+        if (!_bbuf) {
+            THROW(SYS_NULL_INPUT, "Could not parse string (null pointer) into JSON.");
+        }
+
+        try {
+            const std::string_view json_string(static_cast<const char*>(_bbuf->buf), _bbuf->len);
+            return json::parse(json_string);
+        }
+        catch (const json::exception&) {
+            THROW(INPUT_ARG_NOT_WELL_FORMED_ERR, "Could not parse string into JSON.");
+        }
+    } // parse_json
+
+    auto to_json(const cc::replica_result& _result) -> json
+    {
+        return {
+            {"logical_path", _result.logical_path},
+            {"replica_number", _result.replica_number},
+            {"resource_hierarchy", _result.resource_hierarchy},
+            {"status", _result.status},
+            {"catalog_checksum", _result.catalog_checksum},
+            {"computed_checksum", _result.computed_checksum},
+            {"error_code", _result.error_code}
+        };
+    } // to_json
+
+    auto to_json(const cc::progress& _progress) -> json
+    {
+        return {
+            {"replicas", _progress.replicas},
+            {"verified", _progress.verified},
+            {"computed", _progress.computed},
+            {"missing", _progress.missing},
+            {"mismatched", _progress.mismatched},
+            {"failed", _progress.failed},
+            {"skipped", _progress.skipped}
+        };
+    } // to_json
+
+    auto throw_if_collection_cannot_be_checked(RsComm& _comm, const std::string& _collection) -> void
+    {
+        // GenQuery has no way to escape a single quote inside a string literal.
+        if (_collection.empty() || _collection[0] != '/' || _collection.find('\'') != std::string::npos) {
+            THROW(SYS_INVALID_INPUT_PARAM, fmt::format("[{}] must be an absolute path without single quotes.", prop_collection));
+        }
+
+        // The job reads and updates the catalog of the local zone directly.
+        if (const auto zone = fs::zone_name(fs::path{_collection}); !zone || *zone != getLocalZoneName()) {
+            THROW(SYS_NOT_SUPPORTED, fmt::format("[{}] is not in the local zone.", _collection));
+        }
+
+        dataObjInp_t input{};
+        std::strncpy(input.objPath, _collection.c_str(), MAX_NAME_LEN - 1);
+
+        rodsObjStat_t* stat{};
+        irods::at_scope_exit free_stat{[&stat] { freeRodsObjStat(stat); }};
+
+        if (const auto ec = rsObjStat(&_comm, &input, &stat); ec < 0) {
+            THROW(ec, fmt::format("Could not stat collection [{}].", _collection));
+        }
+
+        if (stat->objType != COLL_OBJ_T) {
+            THROW(CAT_NAME_EXISTS_AS_DATAOBJ, fmt::format("[{}] is not a collection.", _collection));
+        }
+
+        // The replicas of special collections are not in the catalog.
+        if (stat->specColl) {
+            THROW(SYS_NOT_SUPPORTED, fmt::format("[{}] is a special collection.", _collection));
+        }
+    } // throw_if_collection_cannot_be_checked
+
+    auto open_job(RsComm& _comm, const json& _input) -> int
+    {
+        if (!_input.contains(prop_collection) || !_input.at(prop_collection.data()).is_string()) {
+            THROW(INPUT_ARG_NOT_WELL_FORMED_ERR, fmt::format("[{}] must be a string.", prop_collection));
+        }
+
+        const auto batch_size = _input.value(prop_batch_size.data(), default_batch_size);
+
+        if (batch_size <= 0 || batch_size > max_batch_size) {
+            THROW(SYS_INVALID_INPUT_PARAM, fmt::format("[{}] must be between 1 and {}.", prop_batch_size, max_batch_size));
+        }
+
+        cc::options opts;
+        opts.verify_only = _input.value(prop_verify_only.data(), false);
+        opts.compute_missing = _input.value(prop_compute_missing.data(), false);
+        opts.all_replicas = _input.value(prop_all_replicas.data(), false);
+        opts.admin_mode = _input.value(prop_admin_mode.data(), false);
+
+        if (opts.admin_mode && _comm.clientUser.authInfo.authFlag < LOCAL_PRIV_USER_AUTH) {
+            THROW(CAT_INSUFFICIENT_PRIVILEGE_LEVEL, "Admin mode requires a privileged user.");
+        }
+
+        std::string collection = _input.at(prop_collection.data()).get<std::string>();
+
+        if (collection.size() > 1 && collection.back() == '/') {
+            collection.pop_back();
+        }
+
+        throw_if_collection_cannot_be_checked(_comm, collection);
+
+        if (jobs.size() >= max_open_jobs) {
+            THROW(SYS_OUT_OF_FILE_DESC, "Too many open collection checksum jobs.");
+        }
+
+        const auto handle = next_handle++;
+        jobs.emplace(handle, job_state{std::make_unique<cc::job>(_comm, collection, opts), static_cast<std::size_t>(batch_size)});
+
+        return handle;
+    } // open_job
+
+    auto rs_collection_checksum(rsComm_t* _comm, bytesBuf_t* _input, bytesBuf_t** _output) -> int
+    {
+        if (!_input || !_output) {
+            return SYS_INVALID_INPUT_PARAM;
+        }
+
+        *_output = nullptr;
+
+        int handle = 0;
+
+        try {
+            // The job reads and updates the catalog directly, so it must run on the catalog
+            // provider. Continuations are sent over the same connection, which keeps the agent
+            // holding the job alive.
+            if (!ic::connected_to_catalog_provider(*_comm)) {
+                log::api::trace("Redirecting request to catalog service provider ...");
+
+                auto host_info = ic::redirect_to_catalog_provider(*_comm);
+
+                const std::string json_input(static_cast<const char*>(_input->buf), _input->len);
+                char* json_output = nullptr;
+
+                const auto ec = rc_collection_checksum(host_info.conn, json_input.c_str(), &json_output);
+
+                if (json_output) {
+                    *_output = to_bytes_buffer(json_output);
+                    std::free(json_output);
+                }
+
+                return ec;
+            }
+
+            const auto input = parse_json(_input);
+
+            if (input.contains(prop_handle)) {
+                if (const auto h = input.at(prop_handle.data()).get<int>(); jobs.count(h) == 0) {
+                    THROW(SYS_INVALID_INPUT_PARAM, "Invalid collection checksum job handle.");
+                }
+                else {
+                    handle = h;
+                }
+
+                if (input.value(prop_close.data(), false)) {
+                    const json output{
+                        {prop_results.data(), json::array()},
+                        {prop_progress.data(), to_json(jobs.at(handle).job->totals())}
+                    };
+
+                    jobs.erase(handle);
+
+                    *_output = to_bytes_buffer(output.dump());
+
+                    return 0;
+                }
+            }
+            else {
+                handle = open_job(*_comm, input);
+            }
+
+            auto& [job, batch_size] = jobs.at(handle);
+
+            std::vector<cc::replica_result> results;
+            const auto more = job->run(batch_size, results);
+
+            json output{
+                {prop_results.data(), json::array()},
+                {prop_progress.data(), to_json(job->totals())}
+            };
+
+            for (auto&& r : results) {
+                output[prop_results.data()].push_back(to_json(r));
+            }
+
+            if (more) {
+                output[prop_handle.data()] = handle;
+            }
+            else {
+                jobs.erase(handle);
+            }
+
+            *_output = to_bytes_buffer(output.dump());
+
+            return 0;
+        }
+        catch (const irods::exception& e) {
+            log::api::error(e.what());
+            addRErrorMsg(&_comm->rError, e.code(), e.client_display_what());
+            jobs.erase(handle);
+            return e.code();
+        }
+        catch (const json::exception& e) {
+            log::api::error(e.what());
+            addRErrorMsg(&_comm->rError, INPUT_ARG_NOT_WELL_FORMED_ERR, e.what());
+            return INPUT_ARG_NOT_WELL_FORMED_ERR;
+        }
+        catch (const std::exception& e) {
+            log::api::error(e.what());
+            addRErrorMsg(&_comm->rError, SYS_UNKNOWN_ERROR, "Cannot process request due to an unexpected error.");
+            jobs.erase(handle);
+            return SYS_UNKNOWN_ERROR;
+        }
+    } // rs_collection_checksum
+
+    auto call_collection_checksum(irods::api_entry* _api, rsComm_t* _comm, bytesBuf_t* _input, bytesBuf_t** _output) -> int
+    {
+        return _api->call_handler<bytesBuf_t*, bytesBuf_t**>(_comm, _input, _output);
+    } // call_collection_checksum
+
+    const operation op = rs_collection_checksum;
+    #define CALL_COLLECTION_CHECKSUM call_collection_checksum
+} // anonymous namespace
+
+#else // RODS_SERVER
+
+//
+// Client-side Implementation
+//
+
+namespace
+{
+    using operation = std::function<int(rsComm_t*, bytesBuf_t*, bytesBuf_t**)>;
+    const operation op{};
+    #define CALL_COLLECTION_CHECKSUM nullptr
+} // anonymous namespace
+
+#endif // RODS_SERVER
+
+// The plugin factory function must always be defined.
+extern "C"
+auto plugin_factory(const std::string& _instance_name,
+                    const std::string& _context) -> irods::api_entry*
+{
+#ifdef RODS_SERVER
+    irods::client_api_whitelist::instance().add(COLLECTION_CHECKSUM_APN);
+#endif // RODS_SERVER
+
+    // clang-format off
+    irods::apidef_t def{COLLECTION_CHECKSUM_APN,        // API number
+                        RODS_API_VERSION,               // API version
+                        REMOTE_USER_AUTH,               // Client auth
+                        REMOTE_USER_AUTH,               // Proxy auth
+                        "BinBytesBuf_PI", 0,            // In PI / bs flag
+                        "BinBytesBuf_PI", 0,            // Out PI / bs flag
+                        op,                             // Operation
+                        "api_collection_checksum",      // Operation name
+                        nullptr,                        // Clear function
+                        (funcPtr) CALL_COLLECTION_CHECKSUM};
+    // clang-format on
+
+    auto* api = new irods::api_entry{def};
+
+    api->in_pack_key = "BinBytesBuf_PI";
+    api->in_pack_value = BytesBuf_PI;
+
+    api->out_pack_key = "BinBytesBuf_PI";
+    api->out_pack_value = BytesBuf_PI;
+
+    return api;
+}
@@ -21,58 +21,32 @@
 
 #include "data_object_finalize.h"
 
-#include "catalog.hpp"
 #include "catalog_utilities.hpp"
+#include "data_object_finalize_writer.hpp"
 #include "irods_exception.hpp"
-#include "irods_get_full_path_for_config_file.hpp"
-#include "irods_get_l1desc.hpp"
 #include "irods_logger.hpp"
-#include "irods_re_serialization.hpp"
-#include "irods_resource_manager.hpp"
-#include "irods_rs_comm_query.hpp"
 #include "irods_server_api_call.hpp"
-#include "irods_stacktrace.hpp"
-#include "miscServerFunct.hpp"
-#include "objDesc.hpp"
 #include "rodsConnect.h"
-#include "icatHighLevelRoutines.hpp"
-
-#define IRODS_FILESYSTEM_ENABLE_SERVER_SIDE_API
-#include "filesystem.hpp"
-
-#define IRODS_REPLICA_ENABLE_SERVER_SIDE_API
-#include "data_object_proxy.hpp"
 
 #include "json.hpp"
 #include "fmt/format.h"
-#include "nanodbc/nanodbc.h"
 
 #include <cstdlib>
+#include <cstring>
 #include <string>
 #include <string_view>
-#include <tuple>
-#include <chrono>
-#include <system_error>
-
-extern irods::resource_manager resc_mgr;
 
 namespace
 {
     // clang-format off
-    namespace fs          = irods::experimental::filesystem;
-    namespace ic          = irods::experimental::catalog;
-    namespace replica     = irods::experimental::replica;
-    namespace data_object = irods::experimental::data_object;
+    namespace ic  = irods::experimental::catalog;
+    namespace dof = irods::experimental::catalog::data_object_finalize;
 
     using log       = irods::experimental::log;
     using json      = nlohmann::json;
     using operation = std::function<int(RsComm*, BytesBuf*, BytesBuf**)>;
     // clang-format on
 
-    const auto& cmap = ic::data_objects::column_mapping_operators;
-
-    constexpr inline auto database_updated = true;
-
     auto make_error_object(const std::string_view _error_msg = "", const bool _database_updated = false) -> json
     {
         return json{{"error_message", _error_msg},
@@ -107,233 +81,13 @@ namespace
         return _api->call_handler<BytesBuf*, BytesBuf**>(_comm, _input, _output);
     } // call_data_object_finalize
 
-    auto column_is_mutable(const std::string_view _c)
-    {
-        using immutable_columns_list_t = std::vector<const std::string_view>;
-        static const immutable_columns_list_t immutable_columns =
-        {
-            "data_id",
-            "coll_id",
-            "data_name"
-        };
-
-        const auto itr = std::find(
-            std::cbegin(immutable_columns),
-            std::cend(immutable_columns),
-            _c);
-
-        return std::cend(immutable_columns) == itr;
-    } // column_is_mutable
-
-    auto validate_values(json& _obj) -> void
-    {
-        // clang-format off
-        using clock_type    = fs::object_time_type::clock;
-        using duration_type = fs::object_time_type::duration;
-        // clang-format on
-
-        if (std::string_view{SET_TIME_TO_NOW_KW} == _obj.at("modify_ts")) {
-            const auto now = std::chrono::time_point_cast<duration_type>(clock_type::now());
-
-            _obj["modify_ts"] = fmt::format("{:011}", now.time_since_epoch().count());
-        }
-    } // validate_values
-
-    auto set_replica_state(
-        nanodbc::connection& _db_conn,
-        const json& _before,
-        const json& _after) -> void
-    {
-        std::string sql{"update R_DATA_MAIN set"};
-
-        for (auto&& c : cmap) {
-            if (!column_is_mutable(c.first)) {
-                continue;
-            }
-
-            sql += fmt::format(" {} = ?,", c.first);
-        }
-        sql.pop_back();
-
-        sql += " where data_id = ? and resc_id = ?";
-
-        log::database::debug("statement:[{}]", sql);
-
-        nanodbc::statement statement{_db_conn};
-        prepare(statement, sql);
-
-        log::database::debug("before:{}", _before.dump());
-        log::database::debug("after:{}", _after.dump());
-
-        // Reserve the size ahead of time to prevent pointer invalidation.
-        // Need to store the bind values in a variable which will outlive
-        // the bind operation scope.
-        std::vector<ic::bind_type> bind_values;
-        bind_values.reserve(cmap.size());
-
-        // Bind values to the statement.
-        std::size_t index = 0;
-        for (auto&& c : cmap) {
-            const auto& key = c.first;
-
-            if (!column_is_mutable(key)) {
-                continue;
-            }
-
-            const auto& bind_fcn = c.second;
-            ic::bind_parameters bp{statement, index, _after, key, bind_values};
-
-            bind_fcn(bp);
-
-            index++;
-        }
-
-        const auto data_id = std::stoul(_before.at("data_id").get<std::string>());
-        log::database::trace("binding data_id:[{}] at [{}]", data_id, index);
-        statement.bind(index++, &data_id);
-
-        const auto resc_id = std::stoul(_before.at("resc_id").get<std::string>());
-        log::database::trace("binding resc_id:[{}] at [{}]", resc_id, index);
-        statement.bind(index, &resc_id);
-
-        execute(statement);
-    } // set_replica_state
-
-    auto set_data_object_state(
-        nanodbc::connection& _db_conn,
-        nanodbc::transaction& _trans,
-        json& _replicas) -> void
-    {
-        try {
-            for (auto& r : _replicas) {
-                auto& after = r.at("after");
-                validate_values(after);
-
-                set_replica_state(_db_conn, r.at("before"), after);
-            }
-
-            irods::log(LOG_DEBUG10, "committing transaction");
-            _trans.commit();
-        }
-        catch (const json::exception& e) {
-            THROW(SYS_LIBRARY_ERROR, fmt::format(
-                "[{}:{}] - json exception occurred [{}]",
-                __FUNCTION__, __LINE__, e.what()));
-        }
-        catch (const nanodbc::database_error& e) {
-            THROW(SYS_LIBRARY_ERROR, fmt::format(
-                "[{}:{}] - database error occurred [{}]",
-                __FUNCTION__, __LINE__, e.what()));
-        }
-        catch (const std::exception& e) {
-            THROW(SYS_INTERNAL_ERR, fmt::format(
-                "[{}:{}] - exception occurred [{}]",
-                __FUNCTION__, __LINE__, e.what()));
-        }
-        catch (...) {
-            THROW(SYS_UNKNOWN_ERROR, fmt::format(
-                "[{}:{}] - unkonwn error occurred",
-                __FUNCTION__, __LINE__));
-        }
-    } // set_data_object_state
-
-    auto set_file_object_keywords(const json& _src, irods::file_object_ptr _obj) -> void
-    {
-        irods::log(LOG_DEBUG9, fmt::format("[{}:{}] - src:[{}]", __FUNCTION__, __LINE__, _src.dump()));
-
-        const auto src = irods::experimental::make_key_value_proxy(*irods::to_key_value_pair(_src));
-
-        // Template argument deduction is ambiguous here because cond_input() is overloaded
-        auto out = irods::experimental::make_key_value_proxy<KeyValPair>(_obj->cond_input());
-
-        // TODO: just make a make_key_value_proxy which accepts a std::map/json structure...
-        if (src.contains(ADMIN_KW)) {
-            out[ADMIN_KW] = src.at(ADMIN_KW);
-        }
-        if (src.contains(IN_PDMO_KW)) {
-            _obj->in_pdmo(src.at(IN_PDMO_KW).value().data());
-            out[IN_PDMO_KW] = src.at(IN_PDMO_KW);
-        }
-        if (src.contains(OPEN_TYPE_KW)) {
-            out[OPEN_TYPE_KW] = src.at(OPEN_TYPE_KW);
-        }
-        if (src.contains(SYNC_OBJ_KW)) {
-            out[SYNC_OBJ_KW] = src.at(SYNC_OBJ_KW);
-        }
-        if (src.contains(REPL_STATUS_KW)) {
-            out[REPL_STATUS_KW] = src.at(REPL_STATUS_KW);
-        }
-        if (src.contains(IN_REPL_KW)) {
-            out[IN_REPL_KW] = src.at(IN_REPL_KW);
-        }
-    } // set_file_object_keywords
-
-    auto invoke_file_modified(RsComm& _comm, json& _replicas) -> int
-    {
-        try {
-            for (auto&& replica : _replicas) {
-                irods::log(LOG_DEBUG9, fmt::format("[{}:{}] - replica:[{}]", __FUNCTION__, __LINE__, replica.dump()));
-
-                if (replica.contains(FILE_MODIFIED_KW)) {
-                    const auto data_id = std::stoll(replica.at("before").at("data_id").get<std::string>());
-                    auto obj = irods::file_object_factory(_comm, data_id);
-
-                    const auto leaf_resource_id = std::stoll(replica.at("after").at("resc_id").get<std::string>());
-                    obj->resc_hier(resc_mgr.leaf_id_to_hier(leaf_resource_id));
-
-                    set_file_object_keywords(replica.at(FILE_MODIFIED_KW), obj);
-
-                    const auto obj_cond_input = irods::experimental::make_key_value_proxy(obj->cond_input());
-                    if (obj_cond_input.contains(IN_REPL_KW) ||
-                        (obj_cond_input.contains(OPEN_TYPE_KW) &&
-                         obj_cond_input.at(OPEN_TYPE_KW).value() == std::to_string(OPEN_FOR_READ_TYPE))) {
-                        return 0;
-                    }
-
-                    if (const auto ret = fileModified(&_comm, obj); !ret.ok()) {
-                        irods::log(LOG_ERROR, fmt::format(
-                            "[{}] - failed to signal the resource that [{}] on [{}] was modified",
-                            __FUNCTION__, obj->logical_path(), obj->resc_hier()));
-
-                        return ret.code();
-                    }
-
-                    irods::log(LOG_DEBUG, fmt::format(
-                        "[{}:{}] - fileModified complete,obj:[{}],hier:[{}]",
-                        __FUNCTION__, __LINE__, obj->logical_path(), obj->resc_hier()));
-
-                    // TODO: consider more than one?
-                    return 0;
-                }
-            }
-
-            irods::log(LOG_DEBUG, fmt::format(
-                "[{}:{}] - no fileModified",
-                __FUNCTION__, __LINE__));
-
-            return 0;
-        }
-        catch (const irods::exception& e) {
-            irods::log(e);
-            return e.code();
-        }
-        catch (const std::exception& e) {
-            irods::log(LOG_ERROR, fmt::format("[{}] - [{}]", __FUNCTION__, e.what()));
-            return SYS_INTERNAL_ERR;
-        }
-        catch (...) {
-            irods::log(LOG_ERROR, fmt::format("[{}:{}] - unknown error occurred", __FUNCTION__, __LINE__));
-            return SYS_UNKNOWN_ERROR;
-        }
-    } // invoke_file_modified
-
     auto rs_data_object_finalize(
         RsComm* _comm,
         BytesBuf* _input,
         BytesBuf** _output) -> int
     {
-        // Connect to the catalog provider before proceeding as this API
-        // deals almost exclusively in database transactions.
+        // Forward the request to the catalog provider before parsing it. The provider
+        // does all of the work.
         try {
             if (!ic::connected_to_catalog_provider(*_comm)) {
                 log::api::trace("Redirecting request to catalog service provider ...");
@@ -348,8 +102,6 @@ namespace
 
                 return ec;
             }
-
-            ic::throw_if_catalog_provider_service_role_is_invalid();
         }
         catch (const irods::exception& e) {
             const std::string_view msg = e.client_display_what();
@@ -379,167 +131,23 @@ namespace
             return INPUT_ARG_NOT_WELL_FORMED_ERR;
         }
 
-        // The following section separates out the relevant pieces from the input.
-        // These include whether or not the operation should be run in privileged
-        // mode, the list of replicas for the data object being finalized, and
-        // whether or not file_modified should be triggered.
-        json replicas;
-        bool trigger_file_modified;
-        bool admin_operation = false;
-        try {
-            if (input.contains("irods_admin") && input.at("irods_admin").get<bool>()) {
-                if (!irods::is_privileged_client(*_comm)) {
-                    const auto msg = "user is not authorized to use the admin keyword";
-
-                    *_output = to_bytes_buffer(make_error_object(msg).dump());
-
-                    irods::log(LOG_WARNING, fmt::format("[{}:{}] - [{}]", __FUNCTION__, __LINE__, msg));
-
-                    return CAT_INSUFFICIENT_PRIVILEGE_LEVEL;
-                }
-
-                admin_operation = true;
-            }
-
-            replicas = input.at("replicas");
-
-            trigger_file_modified = input.contains("trigger_file_modified") && input.at("trigger_file_modified").get<bool>();
-        }
-        catch (const json::type_error& e) {
-            *_output = to_bytes_buffer(make_error_object(e.what()).dump());
-
-            return SYS_INVALID_INPUT_PARAM;
-        }
-        catch (const std::exception& e) {
-            *_output = to_bytes_buffer(make_error_object(e.what()).dump());
-
-            return SYS_INVALID_INPUT_PARAM;
-        }
-
-        // Establish connection with the database for use with nanodbc.
-        // A connection with the database is already established via the
-        // RsComm, but this allows us to atomically update the database
-        // without the complicated machinery of the existing database plugin.
-        nanodbc::connection db_conn;
+        // Convert the input into the typed replica states. The conversion checks for
+        // the columns and numbers required by the catalog update.
+        dof::input typed_input;
         try {
-            std::tie(std::ignore, db_conn) = ic::new_database_connection();
-        }
-        catch (const std::exception& e) {
-            const auto msg = e.what();
-
-            irods::log(LOG_ERROR, fmt::format("[{}:{}] - [{}]", __FUNCTION__, __LINE__, msg));
-
-            *_output = to_bytes_buffer(make_error_object(msg).dump());
-
-            return SYS_CONFIG_FILE_ERR;
-        }
-
-        try {
-            // This section perform permissions checks and update ticket information
-            // only if not running in privileged mode. This matches the behavior of
-            // the mod_data_obj_meta database operation.
-            const auto data_id = std::stoll(replicas.front().at("before").at("data_id").get<std::string>());
-
-            const auto bytes_written = input.contains("bytes_written") ? std::stoll(input.at("bytes_written").get<std::string>()) : 0;
-
-            if (!admin_operation) {
-                // If the caller indicates that bytes have been written (equivalent
-                // to updating the size), the information for any existing session
-                // ticket should be updated to reflect the new write byte count.
-                if (bytes_written) {
-                    if (const auto ec = chl_update_ticket_write_byte_count(*_comm, data_id, bytes_written); ec != 0) {
-                        const auto msg = fmt::format("failed to update write_bytes_count on ticket [data_id=[{}]]", data_id);
-
-                        irods::log(LOG_NOTICE, fmt::format("[{}:{}] - [{}]", __FUNCTION__, __LINE__, msg));
-
-                        *_output = to_bytes_buffer(make_error_object(msg).dump());
-
-                        return ec;
-                    }
-                }
-
-                // Make sure the user has permission to modify this data object
-                // before proceeding. This database operation also updates ticket
-                // information and checks to make sure the limit for write byte
-                // count has not been exceeded.
-                if (const auto ec = chl_check_permission_to_modify_data_object(*_comm, data_id); ec != 0) {
-                    const auto msg = fmt::format("user not allowed to modify data object [data id=[{}]]", data_id);
-
-                    irods::log(LOG_NOTICE, fmt::format("[{}:{}] - [{}]", __FUNCTION__, __LINE__, msg));
-
-                    *_output = to_bytes_buffer(make_error_object(msg).dump());
-
-                    return ec;
-                }
-            }
-        }
-        catch (const json::exception& e) {
-            const auto msg = fmt::format("json exception occurred [{}]", e.what());
-
-            irods::log(LOG_ERROR, fmt::format("[{}:{}] - [{}]", __FUNCTION__, __LINE__, msg));
-
-            *_output = to_bytes_buffer(make_error_object(msg).dump());
-
-            return SYS_LIBRARY_ERROR;
-        }
-
-        // Actually update the catalog with the information passed in. This is done
-        // transactionally so that the update occurs atomically.
-        try {
-            const auto ec = ic::execute_transaction(db_conn, [&](auto& _trans) -> int
-            {
-                set_data_object_state(db_conn, _trans, replicas);
-                return 0;
-            });
-
-            if (ec < 0) {
-                *_output = to_bytes_buffer(make_error_object("failed to update catalog").dump());
-                return ec;
-            }
-
-            if (!trigger_file_modified) {
-                // If the update was successful and file modified is not supposed to be
-                // triggered, then we can return with success here.
-                *_output = to_bytes_buffer(make_error_object("", database_updated).dump());
-                return ec;
-            }
+            typed_input = dof::to_input(input);
         }
         catch (const irods::exception& e) {
-            const auto msg = e.client_display_what();
-            irods::log(LOG_ERROR, fmt::format("[{}:{}] - [{}]", __FUNCTION__, __LINE__, msg));
-
-            *_output = to_bytes_buffer(make_error_object(msg).dump());
+            *_output = to_bytes_buffer(make_error_object(e.client_display_what()).dump());
 
             return e.code();
         }
 
-        // file_modified is handled separately so that the caller can differentiate
-        // between errors which occurred before and after the failure of the database
-        // transaction. In this case, the database transaction was successful, but some
-        // operation as a result of file_modified has failed.
-        try {
-            const auto ec = invoke_file_modified(*_comm, replicas);
-
-            if (ec < 0) {
-                const auto msg = "error occurred during file_modified operation";
+        const auto [output, ec] = dof::finalize(*_comm, typed_input);
 
-                *_output = to_bytes_buffer(make_error_object(msg, database_updated).dump());
+        *_output = to_bytes_buffer(output.dump());
 
-                return ec;
-            }
-
-            *_output = to_bytes_buffer(make_error_object("", database_updated).dump());
-            return ec;
-        }
-        catch (const irods::exception& e) {
-            irods::log(LOG_ERROR, fmt::format("[{}:{}] - [{}]", __FUNCTION__, __LINE__, e.client_display_what()));
-
-            const auto err = make_error_object(e.client_display_what(), database_updated);
-
-            *_output = to_bytes_buffer(err.dump());
-
-            return e.code();
-        }
+        return ec;
     } // rs_data_object_finalize
 
     const operation op = rs_data_object_finalize;
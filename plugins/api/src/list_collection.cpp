@@ -0,0 +1,828 @@
+#include "api_plugin_number.h"
+#include "rodsDef.h"
+#include "rcConnect.h"
+#include "rodsPackInstruct.h"
+#include "apiHandler.hpp"
+#include "client_api_whitelist.hpp"
+
+#include <functional>
+
+#ifdef RODS_SERVER
+
+//
+// Server-side Implementation
+//
+
+#include "list_collection.h"
+
+#include "rodsErrorTable.h"
+#include "rodsGenQuery.h"
+#include "objStat.h"
+#include "rcMisc.h"
+#include "rsGenQuery.hpp"
+#include "rsObjStat.hpp"
+#include "irods_at_scope_exit.hpp"
+#include "irods_exception.hpp"
+#include "irods_server_api_call.hpp"
+#include "irods_re_serialization.hpp"
+#include "irods_logger.hpp"
+
+#define IRODS_FILESYSTEM_ENABLE_SERVER_SIDE_API
+#include "filesystem.hpp"
+
+#include "fmt/format.h"
+#include "json.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/*
+ The expected JSON format (open):
+ ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ {
+     // Must be an absolute path.
+     "collection": string,
+
+     // Any of "id", "size", "ctime", "mtime", "owner", "data_type", "mode",
+     // "replicas" and "checksum". Defaults to an empty array.
+     "columns": [string],
+
+     // One of "name", "size" or "mtime". Defaults to "name".
+     "sort": string,
+
+     // Defaults to false.
+     "descending": boolean,
+
+     // Defaults to 1000. Cannot exceed 10000.
+     "page_size": integer
+ }
+
+ The expected JSON format (continue):
+ ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ {
+     "handle": integer,
+
+     // Closes the listing without returning a page. Defaults to false.
+     "close": boolean
+ }
+
+ The JSON output:
+ ~~~~~~~~~~~~~~~~
+ {
+     // "type", "name" and then the requested columns.
+     "columns": [string],
+
+     // One array per data object or collection, holding the values of "columns".
+     "entries": [
+         [string, string, ...]
+     ],
+
+     // Only present if more entries may remain.
+     "handle": integer
+ }
+*/
+
+namespace
+{
+    // clang-format off
+    namespace fs = irods::experimental::filesystem;
+
+    using json      = nlohmann::json;
+    using log       = irods::experimental::log;
+    using operation = std::function<int(rsComm_t*, bytesBuf_t*, bytesBuf_t**)>;
+
+    // JSON Properties
+    constexpr std::string_view prop_collection = "collection";
+    constexpr std::string_view prop_columns    = "columns";
+    constexpr std::string_view prop_sort       = "sort";
+    constexpr std::string_view prop_descending = "descending";
+    constexpr std::string_view prop_page_size  = "page_size";
+    constexpr std::string_view prop_handle     = "handle";
+    constexpr std::string_view prop_close      = "close";
+    constexpr std::string_view prop_entries    = "entries";
+    // clang-format on
+
+    constexpr std::int64_t default_page_size = 1000;
+    constexpr std::int64_t max_page_size = 10000;
+
+    // The maximum number of listings an agent keeps open at once.
+    constexpr std::size_t max_open_listings = 16;
+
+    enum class sort_key
+    {
+        name,
+        size,
+        mtime
+    };
+
+    struct column_info
+    {
+        std::string_view name;
+        int data_object_column; // Zero if not a column of the data object query.
+        int collection_column;  // Zero if the property does not apply to collections.
+        bool numeric;
+    };
+
+    // clang-format off
+    constexpr column_info known_columns[] = {
+        {"id",        COL_D_DATA_ID,       COL_COLL_ID,          true},
+        {"size",      COL_DATA_SIZE,       0,                    true},
+        {"ctime",     COL_D_CREATE_TIME,   COL_COLL_CREATE_TIME, true},
+        {"mtime",     COL_D_MODIFY_TIME,   COL_COLL_MODIFY_TIME, true},
+        {"owner",     COL_D_OWNER_NAME,    COL_COLL_OWNER_NAME,  false},
+        {"data_type", COL_DATA_TYPE_NAME,  0,                    false},
+        {"mode",      COL_DATA_MODE,       0,                    true},
+        {"replicas",  0,                   0,                    true},
+        {"checksum",  COL_D_DATA_CHECKSUM, 0,                    false}
+    };
+    // clang-format on
+
+    using row_type = std::vector<std::string>;
+
+    // Streams the rows of a GenQuery, fetching MAX_SQL_ROWS rows at a time.
+    class query_cursor
+    {
+    public:
+        query_cursor() = default;
+
+        query_cursor(const query_cursor&) = delete;
+        auto operator=(const query_cursor&) -> query_cursor& = delete;
+
+        ~query_cursor()
+        {
+            clearGenQueryInp(&input_);
+        }
+
+        // Returns the index of the column in the rows, adding it to the select list if necessary.
+        // Ordered columns are sorted on in the order they are added.
+        auto select(int _column, int _options = 1) -> int
+        {
+            for (int i = 0; i < input_.selectInp.len; ++i) {
+                if (input_.selectInp.inx[i] == _column) {
+                    return i;
+                }
+            }
+
+            addInxIval(&input_.selectInp, _column, _options);
+
+            return input_.selectInp.len - 1;
+        }
+
+        auto where(int _column, const std::string& _condition) -> void
+        {
+            addInxVal(&input_.sqlCondInp, _column, _condition.c_str());
+        }
+
+        auto zone_hint(const std::string& _zone) -> void
+        {
+            addKeyVal(&input_.condInput, ZONE_KW, _zone.c_str());
+        }
+
+        // Returns the next row, or nullptr once all rows have been read.
+        auto next(RsComm& _comm) -> const row_type*
+        {
+            while (row_ == rows_.size()) {
+                if (exhausted_) {
+                    return nullptr;
+                }
+
+                fetch(_comm);
+            }
+
+            return &rows_[row_++];
+        }
+
+        // Releases the query held by the catalog, if any.
+        auto close(RsComm& _comm) -> void
+        {
+            exhausted_ = true;
+
+            if (input_.continueInx > 0) {
+                input_.maxRows = 0;
+
+                genQueryOut_t* output{};
+                rsGenQuery(&_comm, &input_, &output);
+                freeGenQueryOut(&output);
+
+                input_.continueInx = 0;
+            }
+        }
+
+    private:
+        auto fetch(RsComm& _comm) -> void
+        {
+            rows_.clear();
+            row_ = 0;
+
+            input_.maxRows = MAX_SQL_ROWS;
+
+            genQueryOut_t* output{};
+            irods::at_scope_exit free_output{[&output] { freeGenQueryOut(&output); }};
+
+            if (const auto ec = rsGenQuery(&_comm, &input_, &output); ec < 0) {
+                exhausted_ = true;
+                input_.continueInx = 0;
+
+                if (ec == CAT_NO_ROWS_FOUND) {
+                    return;
+                }
+
+                THROW(ec, "Could not query the contents of the collection.");
+            }
+
+            input_.continueInx = output->continueInx;
+            exhausted_ = (output->continueInx == 0);
+
+            rows_.reserve(output->rowCnt);
+
+            for (int r = 0; r < output->rowCnt; ++r) {
+                auto& row = rows_.emplace_back();
+                row.reserve(output->attriCnt);
+
+                for (int a = 0; a < output->attriCnt; ++a) {
+                    const auto& result = output->sqlResult[a];
+                    row.emplace_back(result.value + static_cast<std::size_t>(r) * result.len);
+                }
+            }
+        }
+
+        genQueryInp_t input_{};
+        std::vector<row_type> rows_;
+        std::size_t row_ = 0;
+        bool exhausted_ = false;
+    }; // class query_cursor
+
+    // An open listing. Data objects are read first, then the sub-collections.
+    class listing
+    {
+    public:
+        listing(const std::string& _collection,
+                const std::vector<const column_info*>& _columns,
+                sort_key _sort,
+                bool _descending,
+                std::size_t _page_size)
+            : columns_{_columns}
+            , sort_{_sort}
+            , descending_{_descending}
+            , page_size_{_page_size}
+        {
+            const auto order = _descending ? ORDER_BY_DESC : ORDER_BY;
+            const auto zone = fs::zone_name(fs::path{_collection});
+
+            // The replicas of a data object are adjacent in the results, so they can be folded
+            // into one entry as they are read.
+            name_ = objects_.select(COL_DATA_NAME, order);
+            objects_.select(COL_DATA_REPL_NUM, ORDER_BY);
+            repl_status_ = objects_.select(COL_D_REPL_STATUS);
+            modify_time_ = objects_.select(COL_D_MODIFY_TIME);
+            size_ = objects_.select(COL_DATA_SIZE);
+
+            for (auto* c : columns_) {
+                object_columns_.push_back(c->data_object_column > 0 ? objects_.select(c->data_object_column) : -1);
+            }
+
+            objects_.where(COL_COLL_NAME, fmt::format("= '{}'", _collection));
+
+            // Collections are sorted by the catalog. "size" does not apply to collections,
+            // so they are listed by name.
+            if (_sort == sort_key::mtime) {
+                collections_.select(COL_COLL_MODIFY_TIME, order);
+                collection_name_ = collections_.select(COL_COLL_NAME, ORDER_BY);
+            }
+            else {
+                collection_name_ = collections_.select(COL_COLL_NAME, order);
+            }
+
+            for (auto* c : columns_) {
+                collection_columns_.push_back(c->collection_column > 0 ? collections_.select(c->collection_column) : -1);
+            }
+
+            collections_.where(COL_COLL_PARENT_NAME, fmt::format("= '{}'", _collection));
+            collections_.where(COL_COLL_NAME, "<> '/'");
+
+            if (zone) {
+                objects_.zone_hint(*zone);
+                collections_.zone_hint(*zone);
+            }
+        }
+
+        // Appends the next page to _entries. Returns false once the listing is exhausted.
+        auto next_page(RsComm& _comm, json& _entries) -> bool
+        {
+            while (_entries.size() < page_size_ && phase_ != phase::done) {
+                switch (phase_) {
+                    case phase::data_objects:
+                        if (sort_ != sort_key::name) {
+                            sort_data_objects(_comm);
+                            phase_ = phase::sorted_data_objects;
+                        }
+                        else if (auto e = next_data_object(_comm); e) {
+                            _entries.push_back(to_json(*e));
+                        }
+                        else {
+                            phase_ = phase::collections;
+                        }
+                        break;
+
+                    case phase::sorted_data_objects:
+                        if (sorted_index_ < sorted_.size()) {
+                            _entries.push_back(std::move(sorted_[sorted_index_++]));
+                        }
+                        else {
+                            sorted_.clear();
+                            sorted_.shrink_to_fit();
+                            phase_ = phase::collections;
+                        }
+                        break;
+
+                    case phase::collections:
+                        if (const auto* row = collections_.next(_comm); row) {
+                            _entries.push_back(to_collection_entry(*row));
+                        }
+                        else {
+                            phase_ = phase::done;
+                        }
+                        break;
+
+                    case phase::done:
+                        break;
+                }
+            }
+
+            return phase_ != phase::done;
+        }
+
+        auto close(RsComm& _comm) -> void
+        {
+            objects_.close(_comm);
+            collections_.close(_comm);
+            phase_ = phase::done;
+        }
+
+    private:
+        enum class phase
+        {
+            data_objects,
+            sorted_data_objects,
+            collections,
+            done
+        };
+
+        struct data_object
+        {
+            // The row of the most recently modified good replica.
+            row_type row;
+            bool good = false;
+            std::int64_t mtime = 0;
+            std::int64_t replicas = 0;
+        };
+
+        auto to_int(const std::string& _value) const -> std::int64_t
+        {
+            return _value.empty() ? 0 : std::stoll(_value);
+        }
+
+        auto to_value(const column_info& _column, const std::string& _value) const -> json
+        {
+            if (!_column.numeric) {
+                return _value;
+            }
+
+            if (_value.empty()) {
+                return nullptr;
+            }
+
+            return std::stoll(_value);
+        }
+
+        // Reads the replicas of the next data object.
+        auto next_data_object(RsComm& _comm) -> std::optional<data_object>
+        {
+            data_object object;
+
+            if (pending_) {
+                object.row = std::move(*pending_);
+                pending_.reset();
+            }
+            else if (const auto* row = objects_.next(_comm); row) {
+                object.row = *row;
+            }
+            else {
+                return std::nullopt;
+            }
+
+            object.good = (object.row[repl_status_] == "1");
+            object.mtime = to_int(object.row[modify_time_]);
+            object.replicas = 1;
+
+            while (const auto* row = objects_.next(_comm)) {
+                if ((*row)[name_] != object.row[name_]) {
+                    pending_ = *row;
+                    break;
+                }
+
+                ++object.replicas;
+
+                const bool good = ((*row)[repl_status_] == "1");
+                const auto mtime = to_int((*row)[modify_time_]);
+
+                if ((good && !object.good) || (good == object.good && mtime > object.mtime)) {
+                    object.row = *row;
+                    object.good = good;
+                    object.mtime = mtime;
+                }
+            }
+
+            return object;
+        }
+
+        // The catalog cannot order data objects by a property of one of their replicas, so the
+        // entries are read and sorted here. Only the compact entries are kept in memory.
+        auto sort_data_objects(RsComm& _comm) -> void
+        {
+            std::vector<std::pair<std::int64_t, std::size_t>> keys;
+
+            while (auto e = next_data_object(_comm)) {
+                const auto key = (sort_ == sort_key::size) ? to_int(e->row[size_]) : e->mtime;
+                keys.emplace_back(key, sorted_.size());
+                sorted_.push_back(to_json(*e));
+            }
+
+            // Ties keep the order of the names.
+            std::stable_sort(std::begin(keys), std::end(keys), [this](const auto& _lhs, const auto& _rhs) {
+                return descending_ ? _lhs.first > _rhs.first : _lhs.first < _rhs.first;
+            });
+
+            std::vector<json> entries;
+            entries.reserve(sorted_.size());
+
+            for (auto&& [key, index] : keys) {
+                entries.push_back(std::move(sorted_[index]));
+            }
+
+            sorted_ = std::move(entries);
+            sorted_index_ = 0;
+        }
+
+        auto to_json(const data_object& _object) const -> json
+        {
+            auto entry = json::array({"d", _object.row[name_]});
+
+            for (std::size_t i = 0; i < columns_.size(); ++i) {
+                if (columns_[i]->name == "replicas") {
+                    entry.push_back(_object.replicas);
+                }
+                else {
+                    entry.push_back(to_value(*columns_[i], _object.row[object_columns_[i]]));
+                }
+            }
+
+            return entry;
+        }
+
+        auto to_collection_entry(const row_type& _row) const -> json
+        {
+            const auto& path = _row[collection_name_];
+            auto entry = json::array({"c", path.substr(path.rfind('/') + 1)});
+
+            for (std::size_t i = 0; i < columns_.size(); ++i) {
+                if (collection_columns_[i] < 0) {
+                    entry.push_back(nullptr);
+                }
+                else {
+                    entry.push_back(to_value(*columns_[i], _row[collection_columns_[i]]));
+                }
+            }
+
+            return entry;
+        }
+
+        std::vector<const column_info*> columns_;
+        sort_key sort_;
+        bool descending_;
+        std::size_t page_size_;
+
+        query_cursor objects_;
+        int name_ = 0;
+        int repl_status_ = 0;
+        int modify_time_ = 0;
+        int size_ = 0;
+        std::vector<int> object_columns_;
+        std::optional<row_type> pending_;
+
+        std::vector<json> sorted_;
+        std::size_t sorted_index_ = 0;
+
+        query_cursor collections_;
+        int collection_name_ = 0;
+        std::vector<int> collection_columns_;
+
+        phase phase_ = phase::data_objects;
+    }; // class listing
+
+    // The open listings of this agent, keyed by handle.
+    std::map<int, std::unique_ptr<listing>> listings;
+    int next_handle = 1;
+
+    //
+    // Function Prototypes
+    //
+
+    auto call_list_collection(irods::api_entry*, rsComm_t*, bytesBuf_t*, bytesBuf_t**) -> int;
+
+    auto rs_list_collection(rsComm_t*, bytesBuf_t*, bytesBuf_t**) -> int;
+
+    //
+    // Function Implementations
+    //
+
+    auto to_bytes_buffer(std::string_view _s) -> bytesBuf_t*
+    {
+        constexpr auto allocate = [](const auto bytes) noexcept
+        {
+            return std::memset(std::malloc(bytes), 0, bytes);
+        };
+
+        const auto buf_size = _s.length() + 1;
+
+        auto* buf = static_cast<char*>(allocate(sizeof(char) * buf_size));
+        std::strncpy(buf, _s.data(), _s.length());
+
+        auto* bbp = static_cast<bytesBuf_t*>(allocate(sizeof(bytesBuf_t)));
+        bbp->len = buf_size;
+        bbp->buf = buf;
+
+        return bbp;
+    } // to_bytes_buffer
+
+    auto parse_json(const bytesBuf_t* _bbuf) -> json
+    {
+        if (!_bbuf) {
+            THROW(SYS_NULL_INPUT, "Could not parse string (null pointer) into JSON.");
+        }
+
+        try {
+            const std::string_view json_string(static_cast<const char*>(_bbuf->buf), _bbuf->len);
+            return json::parse(json_string);
+        }
+        catch (const json::exception&) {
+            THROW(INPUT_ARG_NOT_WELL_FORMED_ERR, "Could not parse string into JSON.");
+        }
+    } // parse_json
+
+    auto to_columns(const json& _input) -> std::vector<const column_info*>
+    {
+        std::vector<const column_info*> columns;
+
+        if (!_input.contains(prop_columns)) {
+            return columns;
+        }
+
+        if (!_input.at(prop_columns.data()).is_array()) {
+            THROW(INPUT_ARG_NOT_WELL_FORMED_ERR, fmt::format("[{}] must be an array.", prop_columns));
+        }
+
+        for (auto&& c : _input.at(prop_columns.data())) {
+            const auto iter = std::find_if(std::begin(known_columns), std::end(known_columns), [&c](const auto& _column) {
+                return c.is_string() && c.get_ref<const std::string&>() == _column.name;
+            });
+
+            if (iter == std::end(known_columns)) {
+                THROW(INPUT_ARG_NOT_WELL_FORMED_ERR, fmt::format("Invalid value in [{}]: {}", prop_columns, c.dump()));
+            }
+
+            columns.push_back(&*iter);
+        }
+
+        return columns;
+    } // to_columns
+
+    auto to_sort_key(const json& _input) -> sort_key
+    {
+        if (!_input.contains(prop_sort)) {
+            return sort_key::name;
+        }
+
+        const auto& s = _input.at(prop_sort.data());
+
+        if (s == "name") {
+            return sort_key::name;
+        }
+
+        if (s == "size") {
+            return sort_key::size;
+        }
+
+        if (s == "mtime") {
+            return sort_key::mtime;
+        }
+
+        THROW(INPUT_ARG_NOT_WELL_FORMED_ERR, fmt::format("Invalid value for [{}].", prop_sort));
+    } // to_sort_key
+
+    auto throw_if_collection_cannot_be_listed(RsComm& _comm, const std::string& _collection) -> void
+    {
+        if (_collection.empty() || _collection[0] != '/') {
+            THROW(SYS_INVALID_INPUT_PARAM, fmt::format("[{}] must be an absolute path.", prop_collection));
+        }
+
+        // GenQuery has no way to escape a single quote inside a string literal. The caller lists
+        // these collections through rcOpenCollection instead.
+        if (_collection.find('\'') != std::string::npos) {
+            THROW(SYS_NOT_SUPPORTED, fmt::format("[{}] contains a single quote.", _collection));
+        }
+
+        dataObjInp_t input{};
+        std::strncpy(input.objPath, _collection.c_str(), MAX_NAME_LEN - 1);
+
+        rodsObjStat_t* stat{};
+        irods::at_scope_exit free_stat{[&stat] { freeRodsObjStat(stat); }};
+
+        if (const auto ec = rsObjStat(&_comm, &input, &stat); ec < 0) {
+            THROW(ec, fmt::format("Could not stat collection [{}].", _collection));
+        }
+
+        // Matches the error returned by rcOpenCollection.
+        if (stat->objType != COLL_OBJ_T) {
+            THROW(CAT_NAME_EXISTS_AS_DATAOBJ, fmt::format("[{}] is not a collection.", _collection));
+        }
+
+        // The contents of special collections are not in the catalog.
+        if (stat->specColl) {
+            THROW(SYS_NOT_SUPPORTED, fmt::format("[{}] is a special collection.", _collection));
+        }
+    } // throw_if_collection_cannot_be_listed
+
+    auto open_listing(RsComm& _comm, const json& _input) -> int
+    {
+        if (!_input.contains(prop_collection) || !_input.at(prop_collection.data()).is_string()) {
+            THROW(INPUT_ARG_NOT_WELL_FORMED_ERR, fmt::format("[{}] must be a string.", prop_collection));
+        }
+
+        const auto page_size = _input.value(prop_page_size.data(), default_page_size);
+
+        if (page_size <= 0 || page_size > max_page_size) {
+            THROW(SYS_INVALID_INPUT_PARAM, fmt::format("[{}] must be between 1 and {}.", prop_page_size, max_page_size));
+        }
+
+        auto columns = to_columns(_input);
+        const auto sort = to_sort_key(_input);
+        const auto descending = _input.value(prop_descending.data(), false);
+
+        std::string collection = _input.at(prop_collection.data()).get<std::string>();
+
+        if (collection.size() > 1 && collection.back() == '/') {
+            collection.pop_back();
+        }
+
+        throw_if_collection_cannot_be_listed(_comm, collection);
+
+        if (listings.size() >= max_open_listings) {
+            THROW(SYS_OUT_OF_FILE_DESC, "Too many open collection listings.");
+        }
+
+        const auto handle = next_handle++;
+        listings.emplace(handle, std::make_unique<listing>(collection, columns, sort, descending, page_size));
+
+        return handle;
+    } // open_listing
+
+    auto rs_list_collection(rsComm_t* _comm, bytesBuf_t* _input, bytesBuf_t** _output) -> int
+    {
+        if (!_output) {
+            return SYS_INVALID_INPUT_PARAM;
+        }
+
+        *_output = nullptr;
+
+        int handle = 0;
+
+        try {
+            const auto input = parse_json(_input);
+
+            json output{{prop_entries.data(), json::array()}};
+
+            if (input.contains(prop_handle)) {
+                if (const auto h = input.at(prop_handle.data()).get<int>(); listings.count(h) == 0) {
+                    THROW(SYS_INVALID_INPUT_PARAM, "Invalid collection listing handle.");
+                }
+                else {
+                    handle = h;
+                }
+
+                if (input.value(prop_close.data(), false)) {
+                    listings.at(handle)->close(*_comm);
+                    listings.erase(handle);
+
+                    *_output = to_bytes_buffer(output.dump());
+
+                    return 0;
+                }
+            }
+            else {
+                handle = open_listing(*_comm, input);
+                output[prop_columns.data()] = json::array({"type", "name"});
+
+                for (auto&& c : to_columns(input)) {
+                    output[prop_columns.data()].push_back(c->name);
+                }
+            }
+
+            if (listings.at(handle)->next_page(*_comm, output[prop_entries.data()])) {
+                output[prop_handle.data()] = handle;
+            }
+            else {
+                listings.erase(handle);
+            }
+
+            *_output = to_bytes_buffer(output.dump());
+
+            return 0;
+        }
+        catch (const irods::exception& e) {
+            log::api::error(e.what());
+            addRErrorMsg(&_comm->rError, e.code(), e.client_display_what());
+
+            if (const auto iter = listings.find(handle); iter != std::end(listings)) {
+                iter->second->close(*_comm);
+                listings.erase(iter);
+            }
+
+            return e.code();
+        }
+        catch (const json::exception& e) {
+            log::api::error(e.what());
+            addRErrorMsg(&_comm->rError, INPUT_ARG_NOT_WELL_FORMED_ERR, e.what());
+            return INPUT_ARG_NOT_WELL_FORMED_ERR;
+        }
+        catch (const std::exception& e) {
+            log::api::error(e.what());
+            addRErrorMsg(&_comm->rError, SYS_UNKNOWN_ERROR, "Cannot process request due to an unexpected error.");
+            return SYS_UNKNOWN_ERROR;
+        }
+    } // rs_list_collection
+
+    auto call_list_collection(irods::api_entry* _api, rsComm_t* _comm, bytesBuf_t* _input, bytesBuf_t** _output) -> int
+    {
+        return _api->call_handler<bytesBuf_t*, bytesBuf_t**>(_comm, _input, _output);
+    } // call_list_collection
+
+    const operation op = rs_list_collection;
+    #define CALL_LIST_COLLECTION call_list_collection
+} // anonymous namespace
+
+#else // RODS_SERVER
+
+//
+// Client-side Implementation
+//
+
+namespace
+{
+    using operation = std::function<int(rsComm_t*, bytesBuf_t*, bytesBuf_t**)>;
+    const operation op{};
+    #define CALL_LIST_COLLECTION nullptr
+} // anonymous namespace
+
+#endif // RODS_SERVER
+
+// The plugin factory function must always be defined.
+extern "C"
+auto plugin_factory(const std::string& _instance_name,
+                    const std::string& _context) -> irods::api_entry*
+{
+#ifdef RODS_SERVER
+    irods::client_api_whitelist::instance().add(LIST_COLLECTION_APN);
+#endif // RODS_SERVER
+
+    // clang-format off
+    irods::apidef_t def{LIST_COLLECTION_APN,            // API number
+                        RODS_API_VERSION,               // API version
+                        REMOTE_USER_AUTH,               // Client auth
+                        REMOTE_USER_AUTH,               // Proxy auth
+                        "BinBytesBuf_PI", 0,            // In PI / bs flag
+                        "BinBytesBuf_PI", 0,            // Out PI / bs flag
+                        op,                             // Operation
+                        "api_list_collection",          // Operation name
+                        nullptr,                        // Clear function
+                        (funcPtr) CALL_LIST_COLLECTION};
+    // clang-format on
+
+    auto* api = new irods::api_entry{def};
+
+    api->in_pack_key = "BinBytesBuf_PI";
+    api->in_pack_value = BytesBuf_PI;
+
+    api->out_pack_key = "BinBytesBuf_PI";
+    api->out_pack_value = BytesBuf_PI;
+
+    return api;
+}
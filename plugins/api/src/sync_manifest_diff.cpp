@@ -0,0 +1,492 @@
+#include "api_plugin_number.h"
+#include "rodsDef.h"
+#include "rcConnect.h"
+#include "rodsPackInstruct.h"
+#include "apiHandler.hpp"
+#include "client_api_whitelist.hpp"
+
+#include <functional>
+
+#ifdef RODS_SERVER
+
+//
+// Server-side Implementation
+//
+
+#include "sync_manifest_diff.h"
+
+#include "rodsErrorTable.h"
+#include "irods_exception.hpp"
+#include "irods_server_api_call.hpp"
+#include "irods_re_serialization.hpp"
+#include "irods_hasher_factory.hpp"
+#include "irods_logger.hpp"
+
+#define IRODS_FILESYSTEM_ENABLE_SERVER_SIDE_API
+#include "filesystem.hpp"
+
+#define IRODS_QUERY_ENABLE_SERVER_SIDE_API
+#include "query_builder.hpp"
+
+#include "fmt/format.h"
+#include "json.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+/*
+ The expected JSON format:
+ ~~~~~~~~~~~~~~~~~~~~~~~~~
+ {
+     // Must be an absolute path.
+     // Cannot be empty.
+     "collection": string,
+
+     // One of "size", "size_and_mtime" or "checksum".
+     // Defaults to "checksum".
+     "comparison": string,
+
+     // The sub-collections (relative to "collection") covered by this manifest.
+     // The empty string names "collection" itself.
+     "collections": [string],
+
+     // The local files. Paths are relative to "collection".
+     "entries": [
+         {
+             "path": string,
+             "size": integer,
+
+             // Seconds since epoch. Only used by the "size_and_mtime" comparison.
+             "mtime": integer,
+
+             // Only used by the "checksum" comparison. When absent, the
+             // entry is compared by size only.
+             "checksum": string
+         }
+     ]
+ }
+
+ The JSON output:
+ ~~~~~~~~~~~~~~~~
+ {
+     // Sub-collections that are not registered in the catalog.
+     "missing_collections": [string],
+
+     // Only the entries that differ from the catalog.
+     "entries": [
+         {
+             "path": string,
+
+             // One of:
+             //   "missing"         - no data object exists at the path.
+             //   "stale"           - the data object has no good replica.
+             //   "size"            - the sizes differ.
+             //   "mtime"           - the local file is newer than the data object.
+             //   "checksum"        - the checksums differ.
+             //   "no_checksum"     - the data object has no checksum.
+             //   "checksum_scheme" - the checksums use different schemes.
+             //   "unresolved"      - the path cannot be expressed in a catalog query.
+             "reason": string,
+
+             "data_size": integer,
+             "checksum": string
+         }
+     ]
+ }
+*/
+
+namespace
+{
+    // clang-format off
+    namespace ix = irods::experimental;
+    namespace fs = irods::experimental::filesystem;
+
+    using json      = nlohmann::json;
+    using log       = irods::experimental::log;
+    using operation = std::function<int(rsComm_t*, bytesBuf_t*, bytesBuf_t**)>;
+
+    // JSON Properties
+    constexpr std::string_view prop_collection          = "collection";
+    constexpr std::string_view prop_comparison          = "comparison";
+    constexpr std::string_view prop_collections         = "collections";
+    constexpr std::string_view prop_entries             = "entries";
+    constexpr std::string_view prop_path                = "path";
+    constexpr std::string_view prop_size                = "size";
+    constexpr std::string_view prop_mtime               = "mtime";
+    constexpr std::string_view prop_checksum            = "checksum";
+    constexpr std::string_view prop_missing_collections = "missing_collections";
+    constexpr std::string_view prop_reason              = "reason";
+    constexpr std::string_view prop_data_size           = "data_size";
+    // clang-format on
+
+    // The maximum number of bytes of collection names placed in a single IN clause.
+    // Keeps the generated SQL well below MAX_SQL_SIZE_GENERAL_QUERY.
+    constexpr std::size_t max_in_clause_size = 8000;
+
+    struct catalog_entry
+    {
+        rodsLong_t data_size = -1;
+        rodsLong_t modify_time = 0;
+        std::string checksum;
+        bool has_good_replica = false;
+    };
+
+    //
+    // Function Prototypes
+    //
+
+    auto call_sync_manifest_diff(irods::api_entry*, rsComm_t*, bytesBuf_t*, bytesBuf_t**) -> int;
+
+    auto rs_sync_manifest_diff(rsComm_t*, bytesBuf_t*, bytesBuf_t**) -> int;
+
+    //
+    // Function Implementations
+    //
+
+    auto to_bytes_buffer(std::string_view _s) -> bytesBuf_t*
+    {
+        constexpr auto allocate = [](const auto bytes) noexcept
+        {
+            return std::memset(std::malloc(bytes), 0, bytes);
+        };
+
+        const auto buf_size = _s.length() + 1;
+
+        auto* buf = static_cast<char*>(allocate(sizeof(char) * buf_size));
+        std::strncpy(buf, _s.data(), _s.length());
+
+        auto* bbp = static_cast<bytesBuf_t*>(allocate(sizeof(bytesBuf_t)));
+        bbp->len = buf_size;
+        bbp->buf = buf;
+
+        return bbp;
+    } // to_bytes_buffer
+
+    auto parse_json(const bytesBuf_t* _bbuf) -> json
+    {
+        if (!_bbuf) {
+            THROW(SYS_NULL_INPUT, "Could not parse string (null pointer) into JSON.");
+        }
+
+        try {
+            const std::string_view json_string(static_cast<const char*>(_bbuf->buf), _bbuf->len);
+            return json::parse(json_string);
+        }
+        catch (const json::exception&) {
+            THROW(INPUT_ARG_NOT_WELL_FORMED_ERR, "Could not parse string into JSON.");
+        }
+    } // parse_json
+
+    auto throw_if_input_is_invalid(const json& _input) -> void
+    {
+        if (!_input.contains(prop_collection) || !_input.at(prop_collection.data()).is_string()) {
+            THROW(INPUT_ARG_NOT_WELL_FORMED_ERR, fmt::format("[{}] must be a string.", prop_collection));
+        }
+
+        if (const auto& c = _input.at(prop_collection.data()).get_ref<const std::string&>(); c.empty() || c[0] != '/') {
+            THROW(INPUT_ARG_NOT_WELL_FORMED_ERR, fmt::format("[{}] must be an absolute path.", prop_collection));
+        }
+
+        if (_input.contains(prop_comparison)) {
+            const auto& c = _input.at(prop_comparison.data());
+
+            if (!c.is_string() || (c != "size" && c != "size_and_mtime" && c != "checksum")) {
+                THROW(INPUT_ARG_NOT_WELL_FORMED_ERR, fmt::format("Invalid value for [{}].", prop_comparison));
+            }
+        }
+
+        for (auto&& prop : {prop_collections, prop_entries}) {
+            if (!_input.contains(prop) || !_input.at(prop.data()).is_array()) {
+                THROW(INPUT_ARG_NOT_WELL_FORMED_ERR, fmt::format("[{}] must be an array.", prop));
+            }
+        }
+
+        for (auto&& e : _input.at(prop_entries.data())) {
+            if (!e.is_object() || !e.contains(prop_path) || !e.contains(prop_size)) {
+                THROW(INPUT_ARG_NOT_WELL_FORMED_ERR, fmt::format("Each entry requires [{}] and [{}].", prop_path, prop_size));
+            }
+        }
+    } // throw_if_input_is_invalid
+
+    auto to_logical_path(const std::string& _root, const std::string& _relative_path) -> std::string
+    {
+        return _relative_path.empty() ? _root : _root + '/' + _relative_path;
+    } // to_logical_path
+
+    // GenQuery has no way to escape a single quote inside a string literal.
+    auto is_queryable(const std::string& _path) -> bool
+    {
+        return _path.find('\'') == std::string::npos;
+    } // is_queryable
+
+    // Groups the collections into IN clauses that stay within max_in_clause_size.
+    auto make_in_clauses(const std::vector<std::string>& _collections) -> std::vector<std::string>
+    {
+        std::vector<std::string> clauses;
+        std::string clause;
+
+        for (auto&& c : _collections) {
+            if (!clause.empty() && clause.size() + c.size() > max_in_clause_size) {
+                clauses.push_back(fmt::format("COLL_NAME in ({})", clause));
+                clause.clear();
+            }
+
+            clause += clause.empty() ? fmt::format("'{}'", c) : fmt::format(", '{}'", c);
+        }
+
+        if (!clause.empty()) {
+            clauses.push_back(fmt::format("COLL_NAME in ({})", clause));
+        }
+
+        return clauses;
+    } // make_in_clauses
+
+    auto get_scheme(const std::string& _checksum) -> std::string
+    {
+        std::string scheme;
+
+        if (const auto err = irods::get_hash_scheme_from_checksum(_checksum, scheme); !err.ok()) {
+            return {};
+        }
+
+        return scheme;
+    } // get_scheme
+
+    // Returns the reason the manifest entry differs from the catalog, or an empty string.
+    auto compare(const json& _entry, const catalog_entry& _catalog_entry, std::string_view _comparison) -> std::string
+    {
+        if (!_catalog_entry.has_good_replica) {
+            return "stale";
+        }
+
+        if (_entry.at(prop_size.data()).get<rodsLong_t>() != _catalog_entry.data_size) {
+            return "size";
+        }
+
+        if (_comparison == "size_and_mtime") {
+            // irsync does not preserve mtimes, so a data object is considered current if
+            // it was modified after the local file.
+            if (_entry.contains(prop_mtime) && _entry.at(prop_mtime.data()).get<rodsLong_t>() > _catalog_entry.modify_time) {
+                return "mtime";
+            }
+        }
+        else if (_comparison == "checksum" && _entry.contains(prop_checksum)) {
+            const auto& checksum = _entry.at(prop_checksum.data()).get_ref<const std::string&>();
+
+            if (_catalog_entry.checksum.empty()) {
+                return "no_checksum";
+            }
+
+            if (get_scheme(checksum) != get_scheme(_catalog_entry.checksum)) {
+                return "checksum_scheme";
+            }
+
+            if (checksum != _catalog_entry.checksum) {
+                return "checksum";
+            }
+        }
+
+        return {};
+    } // compare
+
+    auto rs_sync_manifest_diff(rsComm_t* _comm, bytesBuf_t* _input, bytesBuf_t** _output) -> int
+    {
+        if (!_output) {
+            return SYS_INVALID_INPUT_PARAM;
+        }
+
+        *_output = nullptr;
+
+        try {
+            const auto input = parse_json(_input);
+
+            throw_if_input_is_invalid(input);
+
+            const auto root = input.at(prop_collection.data()).get<std::string>();
+            const auto comparison = input.value(prop_comparison.data(), std::string{"checksum"});
+
+            // Map the absolute collection names back onto the relative names used by the client.
+            std::unordered_map<std::string, std::string> relative_names;
+            std::vector<std::string> queryable_collections;
+            std::vector<std::string> unqueryable_collections;
+
+            for (auto&& c : input.at(prop_collections.data())) {
+                const auto& relative_name = c.get_ref<const std::string&>();
+                auto logical_path = to_logical_path(root, relative_name);
+
+                if (is_queryable(logical_path)) {
+                    queryable_collections.push_back(logical_path);
+                }
+                else {
+                    unqueryable_collections.push_back(relative_name);
+                }
+
+                relative_names.emplace(std::move(logical_path), relative_name);
+            }
+
+            ix::query_builder qb;
+
+            if (const auto zone = fs::zone_name(root); zone) {
+                qb.zone_hint(*zone);
+            }
+
+            std::unordered_set<std::string> existing_collections;
+            std::unordered_map<std::string, catalog_entry> catalog_entries;
+
+            for (auto&& in_clause : make_in_clauses(queryable_collections)) {
+                for (auto&& row : qb.build<rsComm_t>(*_comm, fmt::format("select COLL_NAME where {}", in_clause))) {
+                    existing_collections.insert(row[0]);
+                }
+
+                const auto gql = fmt::format("select COLL_NAME, DATA_NAME, DATA_SIZE, DATA_MODIFY_TIME, DATA_CHECKSUM, DATA_REPL_STATUS "
+                                             "where {}",
+                                             in_clause);
+
+                // Reduce the replicas of each data object to the most recently modified good replica.
+                for (auto&& row : qb.build<rsComm_t>(*_comm, gql)) {
+                    const auto& relative_coll = relative_names.at(row[0]);
+                    const auto relative_path = relative_coll.empty() ? row[1] : relative_coll + '/' + row[1];
+
+                    auto& ce = catalog_entries[relative_path];
+
+                    const bool good = (row[5] == "1");
+                    const auto mtime = std::stoll(row[3]);
+
+                    if ((good && !ce.has_good_replica) || (good == ce.has_good_replica && mtime > ce.modify_time)) {
+                        ce.data_size = std::stoll(row[2]);
+                        ce.modify_time = mtime;
+                        ce.checksum = row[4];
+                        ce.has_good_replica = good;
+                    }
+                }
+            }
+
+            json missing_collections = json::array();
+
+            for (auto&& c : queryable_collections) {
+                if (existing_collections.count(c) == 0) {
+                    missing_collections.push_back(relative_names.at(c));
+                }
+            }
+
+            const std::unordered_set<std::string> unresolved(std::begin(unqueryable_collections),
+                                                             std::end(unqueryable_collections));
+
+            json differences = json::array();
+
+            for (auto&& e : input.at(prop_entries.data())) {
+                const auto& path = e.at(prop_path.data()).get_ref<const std::string&>();
+                const auto slash = path.rfind('/');
+                const auto parent = (slash == std::string::npos) ? std::string{} : path.substr(0, slash);
+
+                std::string reason;
+                catalog_entry ce;
+
+                if (unresolved.count(parent) > 0 || !is_queryable(path)) {
+                    reason = "unresolved";
+                }
+                else if (const auto iter = catalog_entries.find(path); iter == std::end(catalog_entries)) {
+                    reason = "missing";
+                }
+                else {
+                    ce = iter->second;
+                    reason = compare(e, ce, comparison);
+                }
+
+                if (!reason.empty()) {
+                    differences.push_back({
+                        {prop_path.data(), path},
+                        {prop_reason.data(), reason},
+                        {prop_data_size.data(), ce.data_size},
+                        {prop_checksum.data(), ce.checksum}
+                    });
+                }
+            }
+
+            const json output{
+                {prop_missing_collections.data(), missing_collections},
+                {prop_entries.data(), differences}
+            };
+
+            *_output = to_bytes_buffer(output.dump());
+
+            return 0;
+        }
+        catch (const irods::exception& e) {
+            log::api::error(e.what());
+            addRErrorMsg(&_comm->rError, e.code(), e.client_display_what());
+            return e.code();
+        }
+        catch (const json::exception& e) {
+            log::api::error(e.what());
+            addRErrorMsg(&_comm->rError, INPUT_ARG_NOT_WELL_FORMED_ERR, e.what());
+            return INPUT_ARG_NOT_WELL_FORMED_ERR;
+        }
+        catch (const std::exception& e) {
+            log::api::error(e.what());
+            addRErrorMsg(&_comm->rError, SYS_UNKNOWN_ERROR, "Cannot process request due to an unexpected error.");
+            return SYS_UNKNOWN_ERROR;
+        }
+    } // rs_sync_manifest_diff
+
+    auto call_sync_manifest_diff(irods::api_entry* _api, rsComm_t* _comm, bytesBuf_t* _input, bytesBuf_t** _output) -> int
+    {
+        return _api->call_handler<bytesBuf_t*, bytesBuf_t**>(_comm, _input, _output);
+    } // call_sync_manifest_diff
+
+    const operation op = rs_sync_manifest_diff;
+    #define CALL_SYNC_MANIFEST_DIFF call_sync_manifest_diff
+} // anonymous namespace
+
+#else // RODS_SERVER
+
+//
+// Client-side Implementation
+//
+
+namespace
+{
+    using operation = std::function<int(rsComm_t*, bytesBuf_t*, bytesBuf_t**)>;
+    const operation op{};
+    #define CALL_SYNC_MANIFEST_DIFF nullptr
+} // anonymous namespace
+
+#endif // RODS_SERVER
+
+// The plugin factory function must always be defined.
+extern "C"
+auto plugin_factory(const std::string& _instance_name,
+                    const std::string& _context) -> irods::api_entry*
+{
+#ifdef RODS_SERVER
+    irods::client_api_whitelist::instance().add(SYNC_MANIFEST_DIFF_APN);
+#endif // RODS_SERVER
+
+    // clang-format off
+    irods::apidef_t def{SYNC_MANIFEST_DIFF_APN,         // API number
+                        RODS_API_VERSION,               // API version
+                        NO_USER_AUTH,                   // Client auth
+                        NO_USER_AUTH,                   // Proxy auth
+                        "BinBytesBuf_PI", 0,            // In PI / bs flag
+                        "BinBytesBuf_PI", 0,            // Out PI / bs flag
+                        op,                             // Operation
+                        "api_sync_manifest_diff",       // Operation name
+                        nullptr,                        // Clear function
+                        (funcPtr) CALL_SYNC_MANIFEST_DIFF};
+    // clang-format on
+
+    auto* api = new irods::api_entry{def};
+
+    api->in_pack_key = "BinBytesBuf_PI";
+    api->in_pack_value = BytesBuf_PI;
+
+    api->out_pack_key = "BinBytesBuf_PI";
+    api->out_pack_value = BytesBuf_PI;
+
+    return api;
+}
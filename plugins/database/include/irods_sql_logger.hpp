@@ -1,6 +1,7 @@
 #ifndef _IRODS_SQL_LOGGER_HPP_
 #define _IRODS_SQL_LOGGER_HPP_
 
+#include <cstdint>
 #include <string>
 
 namespace irods {
@@ -12,6 +13,13 @@ namespace irods {
 
             void log( void );
 
+            // Records that _queries statements were answered from the catalog permission
+            // cache instead of the database.
+            static void log_avoided( const std::string& _function_name, bool _logSQL, unsigned int _queries );
+
+            // Returns the number of statements avoided by this agent so far.
+            static std::uint64_t avoided_count( void );
+
         private:
             unsigned int count_;
             std::string name_;
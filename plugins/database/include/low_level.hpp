@@ -1,7 +1,12 @@
 /*** Copyright (c), The Regents of the University of California            ***
  *** For more information please refer to files in the COPYRIGHT directory ***/
 /*
-  header file for the low level, uses either Oracle or Odbc
+  header file for the low level, uses either Oracle or Odbc, or libpq
+  when the Postgres plugin is built with IRODS_CATALOG_LIBPQ.
  */
 
+#ifdef IRODS_CATALOG_LIBPQ
+#include "low_level_libpq.hpp"
+#else
 #include "low_level_odbc.hpp"
+#endif
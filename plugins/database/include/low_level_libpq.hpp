@@ -0,0 +1,36 @@
+/*
+  header file for the libpq version of the icat low level routines,
+  which talks to Postgres directly, without an ODBC driver manager.
+ */
+
+#ifndef CLL_LIBPQ_HPP
+#define CLL_LIBPQ_HPP
+
+#include "rods.h"
+#include "mid_level.hpp"
+
+#include <vector>
+#include <string>
+
+#define MAX_BIND_VARS 32000
+
+extern int cllBindVarCount;
+extern const char *cllBindVars[MAX_BIND_VARS];
+
+int cllOpenEnv( icatSessionStruct *icss );
+int cllCloseEnv( icatSessionStruct *icss );
+int cllConnect( icatSessionStruct *icss );
+int cllDisconnect( icatSessionStruct *icss );
+int cllExecSqlNoResult( icatSessionStruct *icss, const char *sql );
+int cllExecSqlWithResult( icatSessionStruct *icss, int *stmtNum, const char *sql );
+int cllExecSqlWithResultBV( icatSessionStruct *icss, int *stmtNum, const char *sql,
+                            std::vector<std::string> &bindVars );
+int cllGetRow( icatSessionStruct *icss, int statementNumber );
+int cllFreeStatement( icatSessionStruct *icss, int& statementNumber );
+int cllNextValueString( const char *itemName, char *outString, int maxSize );
+int cllCurrentValueString( const char *itemName, char *outString, int maxSize );
+int cllGetRowCount( icatSessionStruct *icss, int statementNumber );
+int cllCheckPending( const char *sql, int option, int dbType );
+int cllGetLastErrorMessage( char *msg, int maxChars );
+
+#endif	/* CLL_LIBPQ_HPP */
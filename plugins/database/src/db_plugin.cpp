@@ -33,6 +33,8 @@
 #include "modAccessControl.h"
 #include "checksum.hpp"
 #include "key_value_proxy.hpp"
+#include "quota_usage.hpp"
+#include "catalog_permission_cache.hpp"
 
 // =-=-=-=-=-=-=-
 // irods includes
@@ -43,7 +45,10 @@
 
 // =-=-=-=-=-=-=-
 // stl includes
+#include <algorithm>
 #include <cstring>
+#include <map>
+#include <set>
 #include <sstream>
 #include <string>
 #include <string_view>
@@ -55,6 +60,9 @@
 #include "irods_lexical_cast.hpp"
 
 using leaf_bundle_t = irods::resource_manager::leaf_bundle_t;
+
+namespace quota_usage = irods::experimental::catalog::quota_usage;
+namespace catalog_permission_cache = irods::catalog_permission_cache;
 extern irods::resource_manager resc_mgr;
 
 extern int get64RandomBytes( char *buf );
@@ -1433,6 +1441,97 @@ int _modInheritance( int inheritFlag, int recursiveFlag, const char *collIdStr,
     return status;
 }
 
+/*
+  Incremental quota accounting (see quota_usage.hpp).
+
+  getQuotaUsage collects the bytes held by each (user, resource) pair for
+  the replicas matching a condition on R_DATA_MAIN D.  Operations read the
+  usage of the data object before and after changing it and pass both to
+  applyQuotaUsageChange, which adds the difference to R_QUOTA_USAGE and to
+  the over_quota values of the quotas covering each pair.
+*/
+static int getQuotaUsage( const char *whereClause,
+                          std::vector<std::string> bindVars,
+                          quota_usage::usage_map& usage ) {
+    int statementNum = UNINITIALIZED_STATEMENT_NUMBER;
+    char tSQL[MAX_SQL_SIZE];
+
+    snprintf( tSQL, MAX_SQL_SIZE,
+              "select D.resc_id, U.user_id, D.data_size from R_DATA_MAIN D, R_USER_MAIN U where U.user_name = D.data_owner_name and U.zone_name = D.data_owner_zone and %s",
+              whereClause );
+
+    if ( logSQL != 0 ) {
+        rodsLog( LOG_SQL, "getQuotaUsage SQL 1" );
+    }
+    int status = cmlGetFirstRowFromSqlBV( tSQL, bindVars, &statementNum, &icss );
+    while ( status == 0 ) {
+        const auto rescId = atoll( icss.stmtPtr[statementNum]->resultValue[0] );
+        const auto userId = atoll( icss.stmtPtr[statementNum]->resultValue[1] );
+        usage[{userId, rescId}] += atoll( icss.stmtPtr[statementNum]->resultValue[2] );
+
+        status = cmlGetNextRowFromStatement( statementNum, &icss );
+    }
+
+    /* the statement has been freed once the rows are exhausted */
+    return status == CAT_NO_ROWS_FOUND ? 0 : status;
+}
+
+static int getQuotaUsageOfDataObj( rodsLong_t dataId,
+                                   quota_usage::usage_map& usage ) {
+    return getQuotaUsage( "D.data_id = ?", {std::to_string( dataId )}, usage );
+}
+
+static int applyQuotaUsageChange( const quota_usage::usage_map& before,
+                                  const quota_usage::usage_map& after ) {
+    char myTime[50];
+    getNowStr( myTime );
+
+#if ORA_ICAT
+    static const std::string usageSQL = quota_usage::usage_delta_statement( "oracle" );
+#elif MY_ICAT
+    static const std::string usageSQL = quota_usage::usage_delta_statement( "mysql" );
+#else
+    static const std::string usageSQL = quota_usage::usage_delta_statement( "postgres" );
+#endif
+    static const std::string overSQL = quota_usage::over_quota_delta_statement();
+
+    for ( auto&& [key, delta] : quota_usage::difference( before, after ) ) {
+        const auto deltaStr = std::to_string( delta );
+        const auto userIdStr = std::to_string( key.first );
+        const auto rescIdStr = std::to_string( key.second );
+
+        cllBindVars[cllBindVarCount++] = deltaStr.c_str();
+        cllBindVars[cllBindVarCount++] = rescIdStr.c_str();
+        cllBindVars[cllBindVarCount++] = userIdStr.c_str();
+        cllBindVars[cllBindVarCount++] = myTime;
+        if ( logSQL != 0 ) {
+            rodsLog( LOG_SQL, "applyQuotaUsageChange SQL 1" );
+        }
+        int status = cmlExecuteNoAnswerSql( usageSQL.c_str(), &icss );
+        if ( status != 0 ) {
+            return status;
+        }
+
+        cllBindVars[cllBindVarCount++] = deltaStr.c_str();
+        cllBindVars[cllBindVarCount++] = myTime;
+        cllBindVars[cllBindVarCount++] = rescIdStr.c_str();
+        cllBindVars[cllBindVarCount++] = userIdStr.c_str();
+        cllBindVars[cllBindVarCount++] = userIdStr.c_str();
+        if ( logSQL != 0 ) {
+            rodsLog( LOG_SQL, "applyQuotaUsageChange SQL 2" );
+        }
+        status = cmlExecuteNoAnswerSql( overSQL.c_str(), &icss );
+        if ( status == CAT_SUCCESS_BUT_WITH_NO_INFO ) {
+            status = 0;    /* no quota covers this pair */
+        }
+        if ( status != 0 ) {
+            return status;
+        }
+    }
+
+    return 0;
+}
+
 /*
   Set the over_quota values (if any) using the limits and
   and the current usage; handling the various types: per-user per-resource,
@@ -2427,6 +2526,20 @@ irods::error db_mod_data_obj_meta_op(
         return PASS( ret );
     }
 
+    /* Quota usage only depends on the size, owner and resource of the replicas */
+    const bool trackQuotaUsage = quota_usage::incremental() &&
+                                 ( doingDataSize || update_resc_id ||
+                                   getValByKey( _reg_param, DATA_OWNER_KW ) ||
+                                   getValByKey( _reg_param, DATA_OWNER_ZONE_KW ) );
+    quota_usage::usage_map usageBefore;
+    if ( trackQuotaUsage ) {
+        status = getQuotaUsageOfDataObj( _data_obj_info->dataId, usageBefore );
+        if ( status != 0 ) {
+            _rollback( "chlModDataObjMeta" );
+            return ERROR( status, "getQuotaUsageOfDataObj failure" );
+        }
+    }
+
     if (!getValByKey(_reg_param, ALL_REPL_STATUS_KW)) {
         if ( logSQL != 0 ) {
             rodsLog( LOG_SQL, "chlModDataObjMeta SQL 4" );
@@ -2545,6 +2658,21 @@ irods::error db_mod_data_obj_meta_op(
                    "cmlModifySingleTable failure" );
     }
 
+    if ( trackQuotaUsage ) {
+        quota_usage::usage_map usageAfter;
+        status = getQuotaUsageOfDataObj( _data_obj_info->dataId, usageAfter );
+        if ( status == 0 ) {
+            status = applyQuotaUsageChange( usageBefore, usageAfter );
+        }
+        if ( status != 0 ) {
+            rodsLog( LOG_NOTICE,
+                     "chlModDataObjMeta quota usage update failure %d",
+                     status );
+            _rollback( "chlModDataObjMeta" );
+            return ERROR( status, "quota usage update failure" );
+        }
+    }
+
     if ( !( _data_obj_info->flags & NO_COMMIT_FLAG ) ) {
         status =  cmlExecuteNoAnswerSql( "commit", &icss );
         if ( status != 0 ) {
@@ -2789,6 +2917,20 @@ irods::error db_reg_data_obj_op(
         }
     }
 
+    if ( quota_usage::incremental() ) {
+        quota_usage::usage_map usageAfter;
+        status = getQuotaUsageOfDataObj( seqNum, usageAfter );
+        if ( status == 0 ) {
+            status = applyQuotaUsageChange( {}, usageAfter );
+        }
+        if ( status != 0 ) {
+            rodsLog( LOG_NOTICE,
+                     "chlRegDataObj quota usage update failure %d", status );
+            _rollback( "chlRegDataObj" );
+            return ERROR( status, "quota usage update failure" );
+        }
+    }
+
     if ( !( _data_obj_info->flags & NO_COMMIT_FLAG ) ) {
         status =  cmlExecuteNoAnswerSql( "commit", &icss );
         if ( status != 0 ) {
@@ -2803,6 +2945,343 @@ irods::error db_reg_data_obj_op(
 
 } // db_reg_data_obj_op
 
+// =-=-=-=-=-=-=-
+// register a batch of new data objects
+//
+// The parent collection (existence, permission and inherit flag) and the data
+// type are checked once per distinct value rather than once per data object,
+// and the rows of R_DATA_MAIN and R_OBJT_ACCESS are inserted with one multi-row
+// statement per chunk. The operation never commits; the caller commits or rolls
+// back the whole batch.
+irods::error db_reg_data_obj_bulk_op(
+    irods::plugin_context&      _ctx,
+    std::vector<dataObjInfo_t>* _data_obj_infos ) {
+    // =-=-=-=-=-=-=-
+    // check the context
+    irods::error ret = _ctx.valid();
+    if ( !ret.ok() ) {
+        return PASS( ret );
+    }
+
+    // =-=-=-=-=-=-=-
+    // check the params
+    if ( !_data_obj_infos ) {
+        return ERROR(
+                   CAT_INVALID_ARGUMENT,
+                   "null parameter" );
+    }
+
+    if ( logSQL != 0 ) {
+        rodsLog( LOG_SQL, "chlRegDataObjBulk" );
+    }
+    if ( !icss.status ) {
+        return ERROR( CATALOG_NOT_CONNECTED, "catalog not connected" );
+    }
+
+    auto& objects = *_data_obj_infos;
+    if ( objects.empty() ) {
+        return SUCCESS();
+    }
+
+    // Each row of R_DATA_MAIN takes 20 bind variables, so a chunk stays well
+    // below MAX_BIND_VARS.
+    constexpr std::size_t rows_per_statement = 250;
+
+    struct collection_info {
+        std::string id;
+        int inherit_flag;
+    };
+
+    // The string form of the columns which are not stored in the dataObjInfo_t.
+    struct row_info {
+        std::string data_id;
+        std::string coll_id;
+        std::string data_name;
+        std::string repl_num;
+        std::string data_size;
+        std::string resc_id;
+        std::string repl_status;
+        bool inherit;
+    };
+
+    const auto make_placeholders = []( std::size_t _count, std::string_view _placeholder ) {
+        std::string placeholders;
+        for ( std::size_t i = 0; i < _count; ++i ) {
+            if ( i > 0 ) {
+                placeholders += ", ";
+            }
+            placeholders += _placeholder;
+        }
+        return placeholders;
+    };
+
+    std::map<std::string, collection_info> collections;
+    std::set<std::string> data_types;
+    std::vector<row_info> rows;
+    rows.reserve( objects.size() );
+
+    char myTime[50];
+    getNowStr( myTime );
+
+    for ( auto& obj : objects ) {
+        char logicalFileName[MAX_NAME_LEN];
+        char logicalDirName[MAX_NAME_LEN];
+        splitPathByKey( obj.objPath, logicalDirName, MAX_NAME_LEN, logicalFileName, MAX_NAME_LEN, '/' );
+
+        auto coll_iter = collections.find( logicalDirName );
+        if ( coll_iter == collections.end() ) {
+            /* Check that collection exists and user has write permission.
+               At the same time, also get the inherit flag */
+            int inheritFlag = 0;
+            const rodsLong_t iVal = cmlCheckDirAndGetInheritFlag( logicalDirName,
+                                    _ctx.comm()->clientUser.userName,
+                                    _ctx.comm()->clientUser.rodsZone,
+                                    ACCESS_MODIFY_OBJECT,
+                                    &inheritFlag,
+                                    mySessionTicket,
+                                    mySessionClientAddr,
+                                    &icss );
+            if ( iVal < 0 ) {
+                if ( iVal == CAT_UNKNOWN_COLLECTION ) {
+                    std::stringstream errMsg;
+                    errMsg << "collection '" << logicalDirName << "' is unknown";
+                    addRErrorMsg( &_ctx.comm()->rError, 0, errMsg.str().c_str() );
+                }
+                else if ( iVal == CAT_NO_ACCESS_PERMISSION ) {
+                    std::stringstream errMsg;
+                    errMsg << "no permission to update collection '" << logicalDirName << "'";
+                    addRErrorMsg( &_ctx.comm()->rError, 0, errMsg.str().c_str() );
+                }
+                return ERROR( iVal, "" );
+            }
+
+            coll_iter = collections.emplace( logicalDirName, collection_info{std::to_string( iVal ), inheritFlag} ).first;
+        }
+
+        if ( data_types.count( obj.dataType ) == 0 ) {
+            if ( cmlCheckNameToken( "data_type", obj.dataType, &icss ) != 0 ) {
+                return ERROR( CAT_INVALID_DATA_TYPE, "invalid data type" );
+            }
+            data_types.insert( obj.dataType );
+        }
+
+        const rodsLong_t seqNum = cmlGetNextSeqVal( &icss );
+        if ( seqNum < 0 ) {
+            rodsLog( LOG_NOTICE, "chlRegDataObjBulk cmlGetNextSeqVal failure %lld", seqNum );
+            _rollback( "chlRegDataObjBulk" );
+            return ERROR( seqNum, "chlRegDataObjBulk cmlGetNextSeqVal failure" );
+        }
+
+        /* store as output parameters */
+        obj.dataId = seqNum;
+        obj.collId = std::strtoll( coll_iter->second.id.c_str(), nullptr, 10 );
+
+        if ( 0 == strcmp( obj.dataModify, "" ) ) {
+            strcpy( obj.dataModify, myTime );
+        }
+        if ( 0 == strcmp( obj.dataCreate, "" ) ) {
+            strcpy( obj.dataCreate, myTime );
+        }
+        strcpy( obj.dataExpiry, "00000000000" );
+
+        std::snprintf( obj.dataOwnerName, sizeof( obj.dataOwnerName ), "%s", _ctx.comm()->clientUser.userName );
+        std::snprintf( obj.dataOwnerZone, sizeof( obj.dataOwnerZone ), "%s", _ctx.comm()->clientUser.rodsZone );
+
+        rows.push_back( {std::to_string( seqNum ),
+                         coll_iter->second.id,
+                         logicalFileName,
+                         std::to_string( obj.replNum ),
+                         std::to_string( obj.dataSize ),
+                         std::to_string( obj.rescId ),
+                         std::to_string( obj.replStatus ),
+                         coll_iter->second.inherit_flag != 0} );
+    }
+
+    const bool trackQuotaUsage = quota_usage::incremental();
+    quota_usage::usage_map usageAfter;
+
+    for ( std::size_t first = 0; first < objects.size(); first += rows_per_statement ) {
+        const std::size_t last = std::min( objects.size(), first + rows_per_statement );
+        const std::size_t count = last - first;
+
+        /* Make sure no collection already exists by any of these names */
+        if ( logSQL != 0 ) {
+            rodsLog( LOG_SQL, "chlRegDataObjBulk SQL 1" );
+        }
+        {
+            std::vector<std::string> bindVars;
+            bindVars.reserve( count );
+            for ( std::size_t i = first; i < last; ++i ) {
+                bindVars.push_back( objects[i].objPath );
+            }
+
+            const auto sql = "select count(*) from R_COLL_MAIN where coll_name in (" + make_placeholders( count, "?" ) + ")";
+
+            rodsLong_t collections_found{};
+            const int status = cmlGetIntegerValueFromSql( sql.c_str(), &collections_found, bindVars, &icss );
+            if ( status != 0 ) {
+                _rollback( "chlRegDataObjBulk" );
+                return ERROR( status, "chlRegDataObjBulk failed to check for collections" );
+            }
+            if ( collections_found > 0 ) {
+                _rollback( "chlRegDataObjBulk" );
+                return ERROR( CAT_NAME_EXISTS_AS_COLLECTION, "collection exists" );
+            }
+        }
+
+        const std::string columns = "(data_id, coll_id, data_name, data_repl_num, data_version, data_type_name, data_size, resc_id, data_path, data_owner_name, data_owner_zone, data_is_dirty, data_checksum, data_mode, create_ts, modify_ts, data_expiry_ts, resc_name, resc_hier, resc_group_name)";
+        const std::string values = "(?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)";
+
+#ifdef ORA_ICAT
+        /* Oracle has no multi-row VALUES clause */
+        std::string sql = "insert all";
+        for ( std::size_t i = 0; i < count; ++i ) {
+            sql += " into R_DATA_MAIN " + columns + " values " + values;
+        }
+        sql += " select * from DUAL";
+#else
+        const std::string sql = "insert into R_DATA_MAIN " + columns + " values " + make_placeholders( count, values );
+#endif
+
+        cllBindVarCount = 0;
+        for ( std::size_t i = first; i < last; ++i ) {
+            const auto& obj = objects[i];
+            const auto& row = rows[i];
+
+            cllBindVars[cllBindVarCount++] = row.data_id.c_str();
+            cllBindVars[cllBindVarCount++] = row.coll_id.c_str();
+            cllBindVars[cllBindVarCount++] = row.data_name.c_str();
+            cllBindVars[cllBindVarCount++] = row.repl_num.c_str();
+            cllBindVars[cllBindVarCount++] = obj.version;
+            cllBindVars[cllBindVarCount++] = obj.dataType;
+            cllBindVars[cllBindVarCount++] = row.data_size.c_str();
+            cllBindVars[cllBindVarCount++] = row.resc_id.c_str();
+            cllBindVars[cllBindVarCount++] = obj.filePath;
+            cllBindVars[cllBindVarCount++] = obj.dataOwnerName;
+            cllBindVars[cllBindVarCount++] = obj.dataOwnerZone;
+            cllBindVars[cllBindVarCount++] = row.repl_status.c_str();
+            cllBindVars[cllBindVarCount++] = obj.chksum;
+            cllBindVars[cllBindVarCount++] = obj.dataMode;
+            cllBindVars[cllBindVarCount++] = obj.dataCreate;
+            cllBindVars[cllBindVarCount++] = obj.dataModify;
+            cllBindVars[cllBindVarCount++] = obj.dataExpiry;
+            cllBindVars[cllBindVarCount++] = "EMPTY_RESC_NAME";
+            cllBindVars[cllBindVarCount++] = "EMPTY_RESC_HIER";
+            cllBindVars[cllBindVarCount++] = "EMPTY_RESC_GROUP_NAME";
+        }
+
+        if ( logSQL != 0 ) {
+            rodsLog( LOG_SQL, "chlRegDataObjBulk SQL 2" );
+        }
+        int status = cmlExecuteNoAnswerSql( sql.c_str(), &icss );
+        if ( status != 0 ) {
+            rodsLog( LOG_NOTICE,
+                     "chlRegDataObjBulk cmlExecuteNoAnswerSql failure %d", status );
+            _rollback( "chlRegDataObjBulk" );
+            return ERROR( status, "chlRegDataObjBulk cmlExecuteNoAnswerSql failure" );
+        }
+
+        /* The data objects in collections without the inherit flag are owned
+           by the client. The others receive the access rows of their parent
+           collection, one statement per collection. */
+        std::map<std::string, std::vector<const char*>> ids_by_collection;
+        std::vector<const char*> owned_ids;
+
+        for ( std::size_t i = first; i < last; ++i ) {
+            if ( rows[i].inherit ) {
+                ids_by_collection[rows[i].coll_id].push_back( rows[i].data_id.c_str() );
+            }
+            else {
+                owned_ids.push_back( rows[i].data_id.c_str() );
+            }
+        }
+
+        if ( !owned_ids.empty() ) {
+            cllBindVars[0] = _ctx.comm()->clientUser.userName;
+            cllBindVars[1] = _ctx.comm()->clientUser.rodsZone;
+            cllBindVars[2] = ACCESS_OWN;
+            cllBindVars[3] = myTime;
+            cllBindVars[4] = myTime;
+            cllBindVarCount = 5;
+            for ( auto* id : owned_ids ) {
+                cllBindVars[cllBindVarCount++] = id;
+            }
+
+            const auto access_sql = "insert into R_OBJT_ACCESS (object_id, user_id, access_type_id, create_ts, modify_ts) "
+                                    "(select data_id, (select user_id from R_USER_MAIN where user_name=? and zone_name=?), "
+                                    "(select token_id from R_TOKN_MAIN where token_namespace = 'access_type' and token_name = ?), ?, ? "
+                                    "from R_DATA_MAIN where data_id in (" + make_placeholders( owned_ids.size(), "?" ) + "))";
+
+            if ( logSQL != 0 ) {
+                rodsLog( LOG_SQL, "chlRegDataObjBulk SQL 3" );
+            }
+            status = cmlExecuteNoAnswerSql( access_sql.c_str(), &icss );
+            if ( status != 0 ) {
+                rodsLog( LOG_NOTICE,
+                         "chlRegDataObjBulk cmlExecuteNoAnswerSql insert access failure %d",
+                         status );
+                _rollback( "chlRegDataObjBulk" );
+                return ERROR( status, "cmlExecuteNoAnswerSql insert access failure" );
+            }
+        }
+
+        for ( auto&& [coll_id, ids] : ids_by_collection ) {
+            cllBindVars[0] = myTime;
+            cllBindVars[1] = myTime;
+            cllBindVars[2] = coll_id.c_str();
+            cllBindVarCount = 3;
+            for ( auto* id : ids ) {
+                cllBindVars[cllBindVarCount++] = id;
+            }
+
+            const auto access_sql = "insert into R_OBJT_ACCESS (object_id, user_id, access_type_id, create_ts, modify_ts) "
+                                    "(select d.data_id, a.user_id, a.access_type_id, ?, ? "
+                                    "from R_OBJT_ACCESS a, R_DATA_MAIN d where a.object_id = ? and d.data_id in (" +
+                                    make_placeholders( ids.size(), "?" ) + "))";
+
+            if ( logSQL != 0 ) {
+                rodsLog( LOG_SQL, "chlRegDataObjBulk SQL 4" );
+            }
+            status = cmlExecuteNoAnswerSql( access_sql.c_str(), &icss );
+            if ( status != 0 && status != CAT_SUCCESS_BUT_WITH_NO_INFO ) {
+                rodsLog( LOG_NOTICE,
+                         "chlRegDataObjBulk cmlExecuteNoAnswerSql insert access failure %d",
+                         status );
+                _rollback( "chlRegDataObjBulk" );
+                return ERROR( status, "cmlExecuteNoAnswerSql insert access failure" );
+            }
+        }
+
+        if ( trackQuotaUsage ) {
+            std::vector<std::string> ids;
+            for ( std::size_t i = first; i < last; ++i ) {
+                ids.push_back( rows[i].data_id );
+            }
+
+            const auto where = "D.data_id in (" + make_placeholders( count, "?" ) + ")";
+            status = getQuotaUsage( where.c_str(), ids, usageAfter );
+            if ( status != 0 ) {
+                _rollback( "chlRegDataObjBulk" );
+                return ERROR( status, "getQuotaUsage failure" );
+            }
+        }
+    }
+
+    /* The data objects are new, so all of their usage is added */
+    if ( trackQuotaUsage ) {
+        const int status = applyQuotaUsageChange( {}, usageAfter );
+        if ( status != 0 ) {
+            rodsLog( LOG_NOTICE,
+                     "chlRegDataObjBulk quota usage update failure %d", status );
+            _rollback( "chlRegDataObjBulk" );
+            return ERROR( status, "quota usage update failure" );
+        }
+    }
+
+    return SUCCESS();
+
+} // db_reg_data_obj_bulk_op
+
 
 // =-=-=-=-=-=-=-
 // register a data object into the catalog
@@ -2948,6 +3427,16 @@ irods::error db_reg_replica_op(
         }
     }
 
+    const bool trackQuotaUsage = quota_usage::incremental();
+    quota_usage::usage_map usageBefore;
+    if ( trackQuotaUsage ) {
+        status = getQuotaUsageOfDataObj( _src_data_obj_info->dataId, usageBefore );
+        if ( status != 0 ) {
+            _rollback( "chlRegReplica" );
+            return ERROR( status, "getQuotaUsageOfDataObj failed" );
+        }
+    }
+
     /* Get the next replica number */
     snprintf( objIdString, MAX_NAME_LEN, "%lld", _src_data_obj_info->dataId );
     if ( logSQL != 0 ) {
@@ -3064,6 +3553,19 @@ irods::error db_reg_replica_op(
         return ERROR( status, "cmlFreeStatement failure" );
     }
 
+    if ( trackQuotaUsage ) {
+        quota_usage::usage_map usageAfter;
+        status = getQuotaUsageOfDataObj( _src_data_obj_info->dataId, usageAfter );
+        if ( status == 0 ) {
+            status = applyQuotaUsageChange( usageBefore, usageAfter );
+        }
+        if ( status != 0 ) {
+            rodsLog( LOG_NOTICE, "chlRegReplica quota usage update failure %d", status );
+            _rollback( "chlRegReplica" );
+            return ERROR( status, "quota usage update failure" );
+        }
+    }
+
     status =  cmlExecuteNoAnswerSql( "commit", &icss );
     if ( status != 0 ) {
         rodsLog( LOG_NOTICE,
@@ -3240,6 +3742,23 @@ irods::error db_unreg_replica_op(
         resc_hier = std::string( _data_obj_info->rescHier );
     }
 
+    /* The replicas are selected by logical path, as in the delete below */
+    const bool trackQuotaUsage = quota_usage::incremental();
+    quota_usage::usage_map usageBefore;
+    if ( trackQuotaUsage ) {
+        const char* where = "D.coll_id = (select coll_id from R_COLL_MAIN where coll_name = ?) and D.data_name = ?";
+        std::vector<std::string> bindVars{logicalDirName, logicalFileName};
+        if ( _data_obj_info->replNum >= 0 ) {
+            where = "D.coll_id = (select coll_id from R_COLL_MAIN where coll_name = ?) and D.data_name = ? and D.data_repl_num = ?";
+            bindVars.push_back( std::to_string( _data_obj_info->replNum ) );
+        }
+        status = getQuotaUsage( where, bindVars, usageBefore );
+        if ( status != 0 ) {
+            _rollback( "chlUnregDataObj" );
+            return ERROR( status, "getQuotaUsage failed" );
+        }
+    }
+
     cllBindVars[0] = logicalDirName;
     cllBindVars[1] = logicalFileName;
     if ( _data_obj_info->replNum >= 0 ) {
@@ -3274,6 +3793,15 @@ irods::error db_unreg_replica_op(
         return ERROR( status, "cmlExecuteNoAnswerSql failed" );
     }
 
+    if ( trackQuotaUsage ) {
+        status = applyQuotaUsageChange( usageBefore, {} );
+        if ( status != 0 ) {
+            rodsLog( LOG_NOTICE, "chlUnregDataObj quota usage update failure %lld", status );
+            _rollback( "chlUnregDataObj" );
+            return ERROR( status, "quota usage update failure" );
+        }
+    }
+
     std::string zone;
     ret = getLocalZone( _ctx.prop_map(), &icss, zone );
     if ( !ret.ok() ) {
@@ -3308,6 +3836,224 @@ irods::error db_unreg_replica_op(
 
 } // db_unreg_replica_op
 
+// =-=-=-=-=-=-=-
+// unregister a batch of replicas
+//
+// Permission, quota accounting and the removal of the access and metadata
+// rows of data objects left without replicas are handled with one statement
+// per chunk rather than once per replica. All of the replicas are
+// unregistered or none are; the operation commits on success.
+irods::error db_unreg_data_obj_bulk_op(
+    irods::plugin_context&      _ctx,
+    std::vector<dataObjInfo_t>* _data_obj_infos,
+    keyValPair_t*               _cond_input ) {
+    // =-=-=-=-=-=-=-
+    // check the context
+    irods::error ret = _ctx.valid();
+    if ( !ret.ok() ) {
+        return PASS( ret );
+    }
+
+    // =-=-=-=-=-=-=-
+    // check the params
+    if ( !_data_obj_infos ) {
+        return ERROR(
+                   CAT_INVALID_ARGUMENT,
+                   "null parameter" );
+    }
+
+    if ( logSQL != 0 ) {
+        rodsLog( LOG_SQL, "chlUnregDataObjBulk" );
+    }
+    if ( !icss.status ) {
+        return ERROR( CATALOG_NOT_CONNECTED, "catalog not connected" );
+    }
+
+    const auto& replicas = *_data_obj_infos;
+    if ( replicas.empty() ) {
+        return SUCCESS();
+    }
+
+    // The replicas are matched on (data_id, data_repl_num), two bind variables
+    // each. A chunk keeps the quota query within MAX_SQL_SIZE.
+    constexpr std::size_t rows_per_statement = 250;
+
+    const auto make_placeholders = []( std::size_t _count, std::string_view _placeholder ) {
+        std::string placeholders;
+        for ( std::size_t i = 0; i < _count; ++i ) {
+            if ( i > 0 ) {
+                placeholders += ", ";
+            }
+            placeholders += _placeholder;
+        }
+        return placeholders;
+    };
+
+    const bool adminMode = _cond_input &&
+                           ( getValByKey( _cond_input, ADMIN_KW ) ||
+                             getValByKey( _cond_input, ADMIN_RMTRASH_KW ) );
+    const bool trashMode = _cond_input && getValByKey( _cond_input, ADMIN_RMTRASH_KW );
+
+    if ( adminMode ) {
+        if ( _ctx.comm()->clientUser.authInfo.authFlag != LOCAL_PRIV_USER_AUTH ) {
+            return ERROR( CAT_INSUFFICIENT_PRIVILEGE_LEVEL, "insufficient privilege" );
+        }
+    }
+
+    std::string trashPath;
+    if ( trashMode ) {
+        std::string zone;
+        ret = getLocalZone( _ctx.prop_map(), &icss, zone );
+        if ( !ret.ok() ) {
+            return PASS( ret );
+        }
+        trashPath = "/" + zone + "/trash";
+    }
+
+    struct row_info {
+        std::string data_id;
+        std::string repl_num;
+    };
+
+    std::vector<row_info> rows;
+    rows.reserve( replicas.size() );
+
+    for ( auto&& replica : replicas ) {
+        if ( replica.dataId <= 0 || replica.replNum < 0 ) {
+            addRErrorMsg( &_ctx.comm()->rError, 0, "dataId and replNum required" );
+            return ERROR( CAT_INVALID_ARGUMENT, "dataId and replNum required" );
+        }
+
+        if ( trashMode && std::strncmp( trashPath.c_str(), replica.objPath, trashPath.size() ) != 0 ) {
+            addRErrorMsg( &_ctx.comm()->rError, 0, "TRASH_KW but not zone/trash path" );
+            return ERROR( CAT_INVALID_ARGUMENT, "TRASH_KW but not zone/trash path" );
+        }
+
+        rows.push_back( {std::to_string( replica.dataId ), std::to_string( replica.replNum )} );
+    }
+
+    const bool trackQuotaUsage = quota_usage::incremental();
+    quota_usage::usage_map usageBefore;
+
+    for ( std::size_t first = 0; first < rows.size(); first += rows_per_statement ) {
+        const std::size_t last = std::min( rows.size(), first + rows_per_statement );
+        const std::size_t count = last - first;
+
+        std::set<std::string> ids;
+        std::vector<std::string> pairBindVars;
+        pairBindVars.reserve( 2 * count );
+        for ( std::size_t i = first; i < last; ++i ) {
+            ids.insert( rows[i].data_id );
+            pairBindVars.push_back( rows[i].data_id );
+            pairBindVars.push_back( rows[i].repl_num );
+        }
+
+        /* Check that the user may delete every data object of the chunk */
+        if ( !adminMode ) {
+            std::vector<std::string> bindVars( ids.begin(), ids.end() );
+            bindVars.push_back( _ctx.comm()->clientUser.userName );
+            bindVars.push_back( _ctx.comm()->clientUser.rodsZone );
+            bindVars.push_back( ACCESS_DELETE_OBJECT );
+
+            const auto sql = "select count(distinct DM.data_id) from R_DATA_MAIN DM, R_OBJT_ACCESS OA, R_USER_GROUP UG, R_USER_MAIN UM, R_TOKN_MAIN TM "
+                             "where DM.data_id in (" + make_placeholders( ids.size(), "?" ) + ") and UM.user_name=? and UM.zone_name=? "
+                             "and UM.user_type_name!='rodsgroup' and UM.user_id = UG.user_id and OA.object_id = DM.data_id "
+                             "and UG.group_user_id = OA.user_id and OA.access_type_id >= TM.token_id "
+                             "and TM.token_namespace ='access_type' and TM.token_name = ?";
+
+            if ( logSQL != 0 ) {
+                rodsLog( LOG_SQL, "chlUnregDataObjBulk SQL 1" );
+            }
+            rodsLong_t permitted{};
+            const int status = cmlGetIntegerValueFromSql( sql.c_str(), &permitted, bindVars, &icss );
+            if ( status != 0 ) {
+                _rollback( "chlUnregDataObjBulk" );
+                return ERROR( status, "chlUnregDataObjBulk failed to check permissions" );
+            }
+            if ( permitted != static_cast<rodsLong_t>( ids.size() ) ) {
+                _rollback( "chlUnregDataObjBulk" );
+                return ERROR( CAT_NO_ACCESS_PERMISSION, "no permission to delete one or more data objects" );
+            }
+        }
+
+        const auto pairs = make_placeholders( count, "(?, ?)" );
+
+        if ( trackQuotaUsage ) {
+            const auto where = "(D.data_id, D.data_repl_num) in (" + pairs + ")";
+            const int status = getQuotaUsage( where.c_str(), pairBindVars, usageBefore );
+            if ( status != 0 ) {
+                _rollback( "chlUnregDataObjBulk" );
+                return ERROR( status, "getQuotaUsage failed" );
+            }
+        }
+
+        cllBindVarCount = 0;
+        for ( auto&& v : pairBindVars ) {
+            cllBindVars[cllBindVarCount++] = v.c_str();
+        }
+
+        if ( logSQL != 0 ) {
+            rodsLog( LOG_SQL, "chlUnregDataObjBulk SQL 2" );
+        }
+        const auto sql = "delete from R_DATA_MAIN where (data_id, data_repl_num) in (" + pairs + ")";
+        int status = cmlExecuteNoAnswerSql( sql.c_str(), &icss );
+        if ( status != 0 ) {
+            if ( status == CAT_SUCCESS_BUT_WITH_NO_INFO ) {
+                status = CAT_UNKNOWN_FILE;  /* More accurate, in this case */
+            }
+            _rollback( "chlUnregDataObjBulk" );
+            return ERROR( status, "chlUnregDataObjBulk cmlExecuteNoAnswerSql failure" );
+        }
+
+        /* delete the access and metadata rows of the data objects which are
+           left without any replica */
+        const auto id_placeholders = make_placeholders( ids.size(), "?" );
+
+        const std::string orphanedSQL[] = {
+            "delete from R_OBJT_ACCESS where object_id in (" + id_placeholders + ") "
+            "and not exists (select data_id from R_DATA_MAIN where data_id = R_OBJT_ACCESS.object_id)",
+            "delete from R_OBJT_METAMAP where object_id in (" + id_placeholders + ") "
+            "and not exists (select data_id from R_DATA_MAIN where data_id = R_OBJT_METAMAP.object_id)"
+        };
+
+        for ( std::size_t i = 0; i < std::size( orphanedSQL ); ++i ) {
+            cllBindVarCount = 0;
+            for ( auto&& id : ids ) {
+                cllBindVars[cllBindVarCount++] = id.c_str();
+            }
+
+            if ( logSQL != 0 ) {
+                rodsLog( LOG_SQL, "chlUnregDataObjBulk SQL %d", static_cast<int>( 3 + i ) );
+            }
+            status = cmlExecuteNoAnswerSql( orphanedSQL[i].c_str(), &icss );
+            if ( status != 0 && status != CAT_SUCCESS_BUT_WITH_NO_INFO ) {
+                _rollback( "chlUnregDataObjBulk" );
+                return ERROR( status, "chlUnregDataObjBulk cmlExecuteNoAnswerSql failure" );
+            }
+        }
+    }
+
+    if ( trackQuotaUsage ) {
+        const int status = applyQuotaUsageChange( usageBefore, {} );
+        if ( status != 0 ) {
+            rodsLog( LOG_NOTICE, "chlUnregDataObjBulk quota usage update failure %d", status );
+            _rollback( "chlUnregDataObjBulk" );
+            return ERROR( status, "quota usage update failure" );
+        }
+    }
+
+    const int status = cmlExecuteNoAnswerSql( "commit", &icss );
+    if ( status != 0 ) {
+        rodsLog( LOG_NOTICE,
+                 "chlUnregDataObjBulk cmlExecuteNoAnswerSql commit failure %d",
+                 status );
+        return ERROR( status, "cmlExecuteNoAnswerSql commit failure" );
+    }
+
+    return SUCCESS();
+
+} // db_unreg_data_obj_bulk_op
+
 // =-=-=-=-=-=-=-
 //
 irods::error db_reg_rule_exec_op(
@@ -4349,6 +5095,9 @@ irods::error db_del_user_re_op(
                    "null parameter" );
     }
 
+    // Memberships and permissions of the user are removed with it.
+    catalog_permission_cache::clear();
+
     // =-=-=-=-=-=-=-
     // get a postgres object from the context
     /*irods::postgres_object_ptr pg;
@@ -5395,6 +6144,8 @@ irods::error db_rename_coll_op(
                    "null parameter" );
     }
 
+    catalog_permission_cache::erase_collection( _old_coll );
+
     // =-=-=-=-=-=-=-
     // get a postgres object from the context
     /*irods::postgres_object_ptr pg;
@@ -5462,6 +6213,8 @@ irods::error db_mod_zone_coll_acl_op(
                    "null parameter" );
     }
 
+    catalog_permission_cache::erase_collection( _path_name );
+
     // =-=-=-=-=-=-=-
     // get a postgres object from the context
     /*irods::postgres_object_ptr pg;
@@ -5519,6 +6272,8 @@ irods::error db_rename_local_zone_op(
                    "null parameter" );
     }
 
+    catalog_permission_cache::clear();
+
     // =-=-=-=-=-=-=-
     // get a postgres object from the context
     /*irods::postgres_object_ptr pg;
@@ -6110,6 +6865,8 @@ irods::error db_del_coll_by_admin_op(
                    "null parameter" );
     }
 
+    catalog_permission_cache::erase_collection( _coll_info->collName );
+
     // =-=-=-=-=-=-=-
     // get a postgres object from the context
     /*irods::postgres_object_ptr pg;
@@ -6260,6 +7017,8 @@ irods::error db_del_coll_op(
                    "null parameter" );
     }
 
+    catalog_permission_cache::erase_collection( _coll_info->collName );
+
     // =-=-=-=-=-=-=-
     // get a postgres object from the context
     /*irods::postgres_object_ptr pg;
@@ -7363,6 +8122,8 @@ irods::error db_mod_user_op(
                    "null parameter" );
     }
 
+    catalog_permission_cache::clear();
+
     // =-=-=-=-=-=-=-
     // get a postgres object from the context
     /*irods::postgres_object_ptr pg;
@@ -7707,6 +8468,8 @@ irods::error db_mod_group_op(
                    "null parameter" );
     }
 
+    catalog_permission_cache::clear();
+
     // =-=-=-=-=-=-=-
     // get a postgres object from the context
     /*irods::postgres_object_ptr pg;
@@ -10142,6 +10905,9 @@ irods::error db_mod_access_control_op(
         return PASS( ret );
     }
 
+    // Recursive changes also affect every collection under the path.
+    catalog_permission_cache::erase_collection( _path_name );
+
     if ( logSQL != 0 ) {
         rodsLog( LOG_SQL, "chlModAccessControl" );
     }
@@ -10690,6 +11456,9 @@ irods::error db_rename_object_op(
         return PASS( ret );
     }
 
+    // The object may be a collection, whose path is only known further down.
+    catalog_permission_cache::clear_collections();
+
     // =-=-=-=-=-=-=-
     // get a postgres object from the context
     /*irods::postgres_object_ptr pg;
@@ -10914,27 +11683,11 @@ irods::error db_rename_object_op(
         if ( isRootDir ) {
             snprintf( slashNewName, MAX_NAME_LEN, "%s", _new_name );
         }
+        /* The names and the parent names are set by the same statement so
+           that the descendants are only searched for once. */
         cllBindVars[cllBindVarCount++] = pLenStr;
         cllBindVars[cllBindVarCount++] = slashNewName;
         cllBindVars[cllBindVarCount++] = cLenStr;
-        cllBindVars[cllBindVarCount++] = collNameSlashLen;
-        cllBindVars[cllBindVarCount++] = collNameSlash;
-        cllBindVars[cllBindVarCount++] = collName;
-        if ( logSQL != 0 ) {
-            rodsLog( LOG_SQL, "chlRenameObject SQL 9" );
-        }
-        status =  cmlExecuteNoAnswerSql(
-                      "update R_COLL_MAIN set coll_name = substr(coll_name,1,?) || ? || substr(coll_name, ?) where substr(parent_coll_name,1,?) = ? or parent_coll_name  = ?",
-                      &icss );
-        if ( status != 0 && status != CAT_SUCCESS_BUT_WITH_NO_INFO ) {
-            rodsLog( LOG_NOTICE,
-                     "chlRenameObject cmlExecuteNoAnswerSql update failure %d",
-                     status );
-            _rollback( "chlRenameObject" );
-            return ERROR( status, "cmlExecuteNoAnswerSql update failure" );
-        }
-
-        /* like above, but for the parent_coll_name's */
         cllBindVars[cllBindVarCount++] = pLenStr;
         cllBindVars[cllBindVarCount++] = slashNewName;
         cllBindVars[cllBindVarCount++] = cLenStr;
@@ -10942,10 +11695,10 @@ irods::error db_rename_object_op(
         cllBindVars[cllBindVarCount++] = collNameSlash;
         cllBindVars[cllBindVarCount++] = collName;
         if ( logSQL != 0 ) {
-            rodsLog( LOG_SQL, "chlRenameObject SQL 10" );
+            rodsLog( LOG_SQL, "chlRenameObject SQL 9" );
         }
         status =  cmlExecuteNoAnswerSql(
-                      "update R_COLL_MAIN set parent_coll_name = substr(parent_coll_name,1,?) || ? || substr(parent_coll_name, ?) where substr(parent_coll_name,1,?) = ? or parent_coll_name  = ?",
+                      "update R_COLL_MAIN set coll_name = substr(coll_name,1,?) || ? || substr(coll_name, ?), parent_coll_name = substr(parent_coll_name,1,?) || ? || substr(parent_coll_name, ?) where substr(parent_coll_name,1,?) = ? or parent_coll_name  = ?",
                       &icss );
         if ( status != 0 && status != CAT_SUCCESS_BUT_WITH_NO_INFO ) {
             rodsLog( LOG_NOTICE,
@@ -11032,6 +11785,9 @@ irods::error db_move_object_op(
         return PASS( ret );
     }
 
+    // The object may be a collection, whose path is only known further down.
+    catalog_permission_cache::clear_collections();
+
     // =-=-=-=-=-=-=-
     // get a postgres object from the context
     /*irods::postgres_object_ptr pg;
@@ -11409,6 +12165,126 @@ irods::error db_move_object_op(
 
 } // db_move_object_op
 
+irods::error db_move_coll_data_paths_op(
+    irods::plugin_context& _ctx,
+    rodsLong_t             _resc_id,
+    const char*            _coll_name,
+    const char*            _vault_path,
+    const char*            _old_dir,
+    const char*            _new_dir ) {
+    // check the context
+    irods::error ret = _ctx.valid();
+    if ( !ret.ok() ) {
+        return PASS( ret );
+    }
+
+    if ( !_coll_name || !_vault_path || !_old_dir || !_new_dir ||
+            strlen( _coll_name ) == 0 || strlen( _vault_path ) == 0 ||
+            strlen( _old_dir ) == 0 || strlen( _new_dir ) == 0 ) {
+        return ERROR( CAT_INVALID_ARGUMENT, "null or empty parameter" );
+    }
+
+    if ( logSQL != 0 ) {
+        rodsLog( LOG_SQL, "chlMoveCollDataPaths" );
+    }
+
+    const std::string resc_id = std::to_string( _resc_id );
+    const std::string coll_name_slash = std::string{_coll_name} + '/';
+    const std::string coll_name_slash_len = std::to_string( coll_name_slash.size() );
+    const std::string coll_name_tail_pos = std::to_string( strlen( _coll_name ) + 1 );
+    const std::string vault_path_slash = std::string{_vault_path} + '/';
+    const std::string vault_path_slash_len = std::to_string( vault_path_slash.size() );
+    const std::string old_dir_slash = std::string{_old_dir} + '/';
+    const std::string old_dir_slash_len = std::to_string( old_dir_slash.size() );
+    const std::string old_dir_tail_pos = std::to_string( strlen( _old_dir ) + 1 );
+
+    /* Every replica on the resource under the collection which is stored in
+       the vault must be stored at the old directory followed by its path
+       relative to the collection. Otherwise moving the directory would not
+       move the replica. Replicas outside of the vault are left alone. */
+    if ( logSQL != 0 ) {
+        rodsLog( LOG_SQL, "chlMoveCollDataPaths SQL 1" );
+    }
+    rodsLong_t count = 0;
+    {
+        std::vector<std::string> bindVars;
+        bindVars.push_back( resc_id );
+        bindVars.push_back( _coll_name );
+        bindVars.push_back( coll_name_slash_len );
+        bindVars.push_back( coll_name_slash );
+        bindVars.push_back( vault_path_slash_len );
+        bindVars.push_back( vault_path_slash );
+        bindVars.push_back( _old_dir );
+        bindVars.push_back( coll_name_tail_pos );
+        int status = cmlGetIntegerValueFromSql(
+                         "select count(*) from R_DATA_MAIN DM, R_COLL_MAIN CM where DM.coll_id = CM.coll_id and DM.resc_id = ? and (CM.coll_name = ? or substr(CM.coll_name,1,?) = ?) and substr(DM.data_path,1,?) = ? and DM.data_path != ? || substr(CM.coll_name, ?) || '/' || DM.data_name",
+                         &count, bindVars, &icss );
+        if ( status != 0 ) {
+            return ERROR( status, "failed to check the physical paths of the replicas in the collection" );
+        }
+    }
+    if ( count > 0 ) {
+        return ERROR( SYS_INVALID_FILE_PATH,
+                      boost::format( "[%lld] replicas in [%s] are not stored under [%s]" ) %
+                      count % _coll_name % _old_dir );
+    }
+
+    /* No replica outside of the collection may be stored under the old
+       directory, as moving the directory would break it. */
+    if ( logSQL != 0 ) {
+        rodsLog( LOG_SQL, "chlMoveCollDataPaths SQL 2" );
+    }
+    {
+        std::vector<std::string> bindVars;
+        bindVars.push_back( resc_id );
+        bindVars.push_back( old_dir_slash_len );
+        bindVars.push_back( old_dir_slash );
+        bindVars.push_back( _coll_name );
+        bindVars.push_back( coll_name_slash_len );
+        bindVars.push_back( coll_name_slash );
+        int status = cmlGetIntegerValueFromSql(
+                         "select count(*) from R_DATA_MAIN where resc_id = ? and substr(data_path,1,?) = ? and coll_id not in (select coll_id from R_COLL_MAIN where coll_name = ? or substr(coll_name,1,?) = ?)",
+                         &count, bindVars, &icss );
+        if ( status != 0 ) {
+            return ERROR( status, "failed to check the physical paths of the replicas outside of the collection" );
+        }
+    }
+    if ( count > 0 ) {
+        return ERROR( SYS_PHY_PATH_INUSE,
+                      boost::format( "[%lld] replicas outside of [%s] are stored under [%s]" ) %
+                      count % _coll_name % _old_dir );
+    }
+
+    cllBindVars[cllBindVarCount++] = _new_dir;
+    cllBindVars[cllBindVarCount++] = old_dir_tail_pos.c_str();
+    cllBindVars[cllBindVarCount++] = resc_id.c_str();
+    cllBindVars[cllBindVarCount++] = old_dir_slash_len.c_str();
+    cllBindVars[cllBindVarCount++] = old_dir_slash.c_str();
+    cllBindVars[cllBindVarCount++] = _coll_name;
+    cllBindVars[cllBindVarCount++] = coll_name_slash_len.c_str();
+    cllBindVars[cllBindVarCount++] = coll_name_slash.c_str();
+    if ( logSQL != 0 ) {
+        rodsLog( LOG_SQL, "chlMoveCollDataPaths SQL 3" );
+    }
+    int status = cmlExecuteNoAnswerSql(
+                     "update R_DATA_MAIN set data_path = ? || substr(data_path, ?) where resc_id = ? and substr(data_path,1,?) = ? and coll_id in (select coll_id from R_COLL_MAIN where coll_name = ? or substr(coll_name,1,?) = ?)",
+                     &icss );
+    if ( status == CAT_SUCCESS_BUT_WITH_NO_INFO ) {
+        status = 0;
+    }
+    if ( status != 0 ) {
+        /* The caller's transaction holds the rename of the collection,
+           so it is left to the caller to roll back. */
+        rodsLog( LOG_NOTICE,
+                 "chlMoveCollDataPaths cmlExecuteNoAnswerSql update failure %d",
+                 status );
+        return ERROR( status, "cmlExecuteNoAnswerSql update failure" );
+    }
+
+    return SUCCESS();
+
+} // db_move_coll_data_paths_op
+
 irods::error db_reg_token_op(
     irods::plugin_context& _ctx,
     const char*            _name_space,
@@ -11937,6 +12813,68 @@ irods::error db_purge_server_load_digest_op(
 
 } // db_purge_server_load_digest_op
 
+/*
+  Recompute R_QUOTA_USAGE from R_DATA_MAIN one resource at a time, for the
+  incremental quota accounting mode.
+*/
+static int reconcileQuotaUsage( const char *myTime ) {
+    int statementNum = UNINITIALIZED_STATEMENT_NUMBER;
+    std::vector<std::string> rescIds;
+
+    if ( logSQL != 0 ) {
+        rodsLog( LOG_SQL, "reconcileQuotaUsage SQL 1" );
+    }
+    int status = cmlGetFirstRowFromSql( "select resc_id from R_RESC_MAIN", &statementNum, 0, &icss );
+    while ( status == 0 ) {
+        rescIds.emplace_back( icss.stmtPtr[statementNum]->resultValue[0] );
+        status = cmlGetNextRowFromStatement( statementNum, &icss );
+    }
+    if ( status != CAT_NO_ROWS_FOUND ) {
+        return status;
+    }
+
+    /* Usage of resources which no longer exist */
+    if ( logSQL != 0 ) {
+        rodsLog( LOG_SQL, "reconcileQuotaUsage SQL 2" );
+    }
+    status = cmlExecuteNoAnswerSql(
+                 "delete from R_QUOTA_USAGE where resc_id not in (select resc_id from R_RESC_MAIN)", &icss );
+    if ( status != 0 && status != CAT_SUCCESS_BUT_WITH_NO_INFO ) {
+        return status;
+    }
+
+    for ( auto&& rescId : rescIds ) {
+        cllBindVars[cllBindVarCount++] = rescId.c_str();
+        if ( logSQL != 0 ) {
+            rodsLog( LOG_SQL, "reconcileQuotaUsage SQL 3" );
+        }
+        status = cmlExecuteNoAnswerSql(
+                     "delete from R_QUOTA_USAGE where resc_id = ?", &icss );
+        if ( status != 0 && status != CAT_SUCCESS_BUT_WITH_NO_INFO ) {
+            return status;
+        }
+
+        cllBindVars[cllBindVarCount++] = myTime;
+        cllBindVars[cllBindVarCount++] = rescId.c_str();
+        if ( logSQL != 0 ) {
+            rodsLog( LOG_SQL, "reconcileQuotaUsage SQL 4" );
+        }
+        status = cmlExecuteNoAnswerSql(
+                     "insert into R_QUOTA_USAGE (quota_usage, resc_id, user_id, modify_ts) (select sum(R_DATA_MAIN.data_size), R_DATA_MAIN.resc_id, R_USER_MAIN.user_id, ? from R_DATA_MAIN, R_USER_MAIN where R_USER_MAIN.user_name = R_DATA_MAIN.data_owner_name and R_USER_MAIN.zone_name = R_DATA_MAIN.data_owner_zone and R_DATA_MAIN.resc_id = ? group by R_DATA_MAIN.resc_id, R_USER_MAIN.user_id)",
+                     &icss );
+        if ( status != 0 && status != CAT_SUCCESS_BUT_WITH_NO_INFO ) {
+            return status;
+        }
+
+        status = cmlExecuteNoAnswerSql( "commit", &icss );
+        if ( status != 0 ) {
+            return status;
+        }
+    }
+
+    return 0;
+}
+
 irods::error db_calc_usage_and_quota_op(
     irods::plugin_context& _ctx ) {
     // =-=-=-=-=-=-=-
@@ -11972,32 +12910,45 @@ irods::error db_calc_usage_and_quota_op(
 
     getNowStr( myTime );
 
-    /* Delete the old rows from R_QUOTA_USAGE */
-    if ( logSQL != 0 ) {
-        rodsLog( LOG_SQL, "chlCalcUsageAndQuota SQL 1" );
-    }
-    cllBindVars[cllBindVarCount++] = myTime;
-    status =  cmlExecuteNoAnswerSql(
-                  "delete from R_QUOTA_USAGE where modify_ts < ?", &icss );
-    if ( status != 0 && status != CAT_SUCCESS_BUT_WITH_NO_INFO ) {
-        _rollback( "chlCalcUsageAndQuota" );
-        return ERROR( status, "delete failed" );
+    if ( quota_usage::incremental() ) {
+        /* The usage is kept current by the catalog operations, so this
+           only corrects drift.  Each resource is recomputed and committed
+           on its own, so the deltas applied by other agents only wait on
+           the resource being recomputed. */
+        status = reconcileQuotaUsage( myTime );
+        if ( status != 0 ) {
+            _rollback( "chlCalcUsageAndQuota" );
+            return ERROR( status, "reconcileQuotaUsage failed" );
+        }
     }
+    else {
+        /* Delete the old rows from R_QUOTA_USAGE */
+        if ( logSQL != 0 ) {
+            rodsLog( LOG_SQL, "chlCalcUsageAndQuota SQL 1" );
+        }
+        cllBindVars[cllBindVarCount++] = myTime;
+        status =  cmlExecuteNoAnswerSql(
+                      "delete from R_QUOTA_USAGE where modify_ts < ?", &icss );
+        if ( status != 0 && status != CAT_SUCCESS_BUT_WITH_NO_INFO ) {
+            _rollback( "chlCalcUsageAndQuota" );
+            return ERROR( status, "delete failed" );
+        }
 
-    /* Add a row to R_QUOTA_USAGE for each user's usage on each resource */
-    if ( logSQL != 0 ) {
-        rodsLog( LOG_SQL, "chlCalcUsageAndQuota SQL 2" );
-    }
-    cllBindVars[cllBindVarCount++] = myTime;
-    status =  cmlExecuteNoAnswerSql(
-                  "insert into R_QUOTA_USAGE (quota_usage, resc_id, user_id, modify_ts) (select sum(R_DATA_MAIN.data_size), R_RESC_MAIN.resc_id, R_USER_MAIN.user_id, ? from R_DATA_MAIN, R_USER_MAIN, R_RESC_MAIN where R_USER_MAIN.user_name = R_DATA_MAIN.data_owner_name and R_USER_MAIN.zone_name = R_DATA_MAIN.data_owner_zone and R_RESC_MAIN.resc_id = R_DATA_MAIN.resc_id group by R_RESC_MAIN.resc_id, user_id)",
-                  &icss );
-    if ( status == CAT_SUCCESS_BUT_WITH_NO_INFO ) {
-        status = 0;    /* no files, OK */
-    }
-    if ( status != 0 ) {
-        _rollback( "chlCalcUsageAndQuota" );
-        return ERROR( status, "insert failed" );
+        /* Add a row to R_QUOTA_USAGE for each user's usage on each resource */
+        if ( logSQL != 0 ) {
+            rodsLog( LOG_SQL, "chlCalcUsageAndQuota SQL 2" );
+        }
+        cllBindVars[cllBindVarCount++] = myTime;
+        status =  cmlExecuteNoAnswerSql(
+                      "insert into R_QUOTA_USAGE (quota_usage, resc_id, user_id, modify_ts) (select sum(R_DATA_MAIN.data_size), R_RESC_MAIN.resc_id, R_USER_MAIN.user_id, ? from R_DATA_MAIN, R_USER_MAIN, R_RESC_MAIN where R_USER_MAIN.user_name = R_DATA_MAIN.data_owner_name and R_USER_MAIN.zone_name = R_DATA_MAIN.data_owner_zone and R_RESC_MAIN.resc_id = R_DATA_MAIN.resc_id group by R_RESC_MAIN.resc_id, user_id)",
+                      &icss );
+        if ( status == CAT_SUCCESS_BUT_WITH_NO_INFO ) {
+            status = 0;    /* no files, OK */
+        }
+        if ( status != 0 ) {
+            _rollback( "chlCalcUsageAndQuota" );
+            return ERROR( status, "insert failed" );
+        }
     }
 
     /* Set the over_quota flags where appropriate */
@@ -14848,6 +15799,10 @@ irods::database* plugin_factory(
         DATABASE_OP_REG_DATA_OBJ,
         function<error(plugin_context&,dataObjInfo_t*)>(
             db_reg_data_obj_op ) );
+    pg->add_operation<std::vector<dataObjInfo_t>*>(
+        DATABASE_OP_REG_DATA_OBJ_BULK,
+        function<error(plugin_context&,std::vector<dataObjInfo_t>*)>(
+            db_reg_data_obj_bulk_op ) );
     pg->add_operation<dataObjInfo_t*,dataObjInfo_t*,keyValPair_t*>(
         DATABASE_OP_REG_REPLICA,
         function<error(plugin_context&,dataObjInfo_t*,dataObjInfo_t*,keyValPair_t*)>(
@@ -14856,6 +15811,10 @@ irods::database* plugin_factory(
         DATABASE_OP_UNREG_REPLICA,
         function<error(plugin_context&,dataObjInfo_t*,keyValPair_t*)>(
             db_unreg_replica_op ) );
+    pg->add_operation<std::vector<dataObjInfo_t>*,keyValPair_t*>(
+        DATABASE_OP_UNREG_DATA_OBJ_BULK,
+        function<error(plugin_context&,std::vector<dataObjInfo_t>*,keyValPair_t*)>(
+            db_unreg_data_obj_bulk_op ) );
     pg->add_operation<ruleExecSubmitInp_t*>(
         DATABASE_OP_REG_RULE_EXEC,
         function<error(plugin_context&,ruleExecSubmitInp_t*)>(
@@ -15024,6 +15983,10 @@ irods::database* plugin_factory(
         DATABASE_OP_MOVE_OBJECT,
         function<error(plugin_context&,rodsLong_t,rodsLong_t)>(
             db_move_object_op ) );
+    pg->add_operation<rodsLong_t,const char*,const char*,const char*,const char*>(
+        DATABASE_OP_MOVE_COLL_DATA_PATHS,
+        function<error(plugin_context&,rodsLong_t,const char*,const char*,const char*,const char*)>(
+            db_move_coll_data_paths_op ) );
     pg->add_operation<const char*,const char*,const char*,const char*,const char*,const char*>(
         DATABASE_OP_REG_TOKEN,
         function<error(plugin_context&,const char*,const char*,const char*,const char*,const char*,const char*)>(
@@ -69,4 +69,5 @@ drop index idx_tokn_main3;
 drop index idx_tokn_main4;
 drop index idx_specific_query1;
 drop index idx_specific_query2;
+drop index idx_quota_usage1;
 drop index idx_obj_filesystem_meta1;
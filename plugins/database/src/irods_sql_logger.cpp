@@ -8,6 +8,10 @@
 
 namespace irods {
 
+    namespace {
+        std::uint64_t avoided_count_ = 0;
+    }
+
     sql_logger::sql_logger(
         const std::string& _function_name,
         bool _logSQL ) {
@@ -35,4 +39,20 @@ namespace irods {
         }
     }
 
+    void sql_logger::log_avoided(
+        const std::string& _function_name,
+        bool _logSQL,
+        unsigned int _queries ) {
+        avoided_count_ += _queries;
+        if ( _logSQL ) {
+            std::stringstream ss;
+            ss << _function_name << " SQL avoided " << _queries << " (cached, " << avoided_count_ << " total)";
+            irods::log( LOG_SQL, ss.str() );
+        }
+    }
+
+    std::uint64_t sql_logger::avoided_count( void ) {
+        return avoided_count_;
+    }
+
 }; // namespace irods
@@ -0,0 +1,887 @@
+/*
+
+   These are the Catalog Low Level (cll) routines for talking to postgresql
+   through libpq, without an ODBC driver manager in between.  They provide
+   the same routines as low_level_odbc.cpp and are used instead of them
+   when the postgres plugin is built with IRODS_CATALOG_LIBPQ.
+
+   Compared to the ODBC routines:
+   - statements with bind variables are prepared once per connection and
+     afterwards executed by name.
+   - once a prepared statement has been described, its results are
+     requested in binary format if every column has a type decoded here.
+   - the whole result of a query is fetched at once, so cllGetRow only
+     moves over rows already in memory.  This is what psqlodbc does by
+     default as well, but without converting each column through SQLFetch.
+   - the 'begin' which opens a transaction, the preparation of a new
+     statement, its description and its first execution are sent as one
+     pipeline, i.e. in a single round trip to the database.
+
+   Callable functions:
+   cllOpenEnv
+   cllCloseEnv
+   cllConnect
+   cllDisconnect
+   cllGetRowCount
+   cllExecSqlNoResult
+   cllExecSqlWithResult
+   cllExecSqlWithResultBV
+   cllGetRow
+   cllFreeStatement
+   cllNextValueString
+   cllCurrentValueString
+
+   Internal functions are those that do not begin with cll.
+   The external functions used are those that begin with PQ.
+
+*/
+
+#include "low_level_libpq.hpp"
+
+#include "irods_configuration_keywords.hpp"
+#include "irods_exception.hpp"
+#include "irods_log.hpp"
+#include "irods_server_properties.hpp"
+
+#include <libpq-fe.h>
+
+#include <boost/any.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+int cllBindVarCount = 0;
+const char *cllBindVars[MAX_BIND_VARS];
+int cllBindVarCountPrev = 0; /* cllBindVarCount earlier in processing */
+
+static int didBegin = 0;
+static int noResultRowCount = 0;
+static char lastErrorMessage[LONG_NAME_LEN];
+
+namespace
+{
+    // Type oids of the columns which are decoded from the binary result format
+    // (see the catalog header pg_type.h of the Postgres sources).
+    constexpr Oid BOOLOID    = 16;
+    constexpr Oid NAMEOID    = 19;
+    constexpr Oid INT8OID    = 20;
+    constexpr Oid INT2OID    = 21;
+    constexpr Oid INT4OID    = 23;
+    constexpr Oid TEXTOID    = 25;
+    constexpr Oid OIDOID     = 26;
+    constexpr Oid BPCHAROID  = 1042;
+    constexpr Oid VARCHAROID = 1043;
+    constexpr Oid NUMERICOID = 1700;
+
+    constexpr int text_format = 0;
+    constexpr int binary_format = 1;
+
+    // Statements are only prepared while there is room for them. Statements beyond the
+    // limit are still executed, just unnamed, so no statement ever has to be deallocated.
+    constexpr std::size_t max_prepared_statements = 500;
+
+    struct prepared_statement
+    {
+        std::string name;
+        int result_format;
+    }; // struct prepared_statement
+
+    // Held by icss->environPtr.
+    struct libpq_session
+    {
+        std::unordered_map<std::string, prepared_statement> prepared;
+        std::uint64_t statement_counter = 0;
+    }; // struct libpq_session
+
+    // Held by icss->stmtPtr[i]->stmtPtr.
+    struct libpq_statement
+    {
+        PGresult* result = nullptr;
+        int result_format = text_format;
+        int next_row = 0;
+        std::vector<std::string> column_names;
+        std::vector<std::string> values; // The current row of a binary result.
+    }; // struct libpq_statement
+
+    auto is_decodable( Oid _type ) noexcept -> bool
+    {
+        switch ( _type ) {
+            case BOOLOID:
+            case NAMEOID:
+            case INT8OID:
+            case INT2OID:
+            case INT4OID:
+            case TEXTOID:
+            case OIDOID:
+            case BPCHAROID:
+            case VARCHAROID:
+            case NUMERICOID:
+                return true;
+            default:
+                return false;
+        }
+    } // is_decodable
+
+    // Binary values are in network byte order.
+    auto read_integer( const char* _p, int _bytes ) noexcept -> std::int64_t
+    {
+        std::uint64_t v = 0;
+        for ( int i = 0; i < _bytes; ++i ) {
+            v = ( v << 8 ) | static_cast<unsigned char>( _p[i] );
+        }
+
+        // Sign extend values narrower than 64 bits.
+        const int shift = 64 - 8 * _bytes;
+        return static_cast<std::int64_t>( v << shift ) >> shift;
+    } // read_integer
+
+    // Produces the same text as the numeric output function of the server.
+    auto numeric_to_string( const char* _p, int _length ) -> std::string
+    {
+        if ( _length < 8 ) {
+            return {};
+        }
+
+        const int ndigits = read_integer( _p, 2 );
+        const int weight = read_integer( _p + 2, 2 );
+        const auto sign = static_cast<std::uint16_t>( read_integer( _p + 4, 2 ) );
+        const int dscale = read_integer( _p + 6, 2 );
+
+        switch ( sign ) {
+            case 0xC000: return "NaN";
+            case 0xD000: return "Infinity";
+            case 0xF000: return "-Infinity";
+        }
+
+        // Base 10000 digits, the first one being multiplied by 10000^weight.
+        const auto digit = [&]( int _i ) -> int {
+            return ( _i >= 0 && _i < ndigits && 8 + 2 * _i + 1 < _length ) ? read_integer( _p + 8 + 2 * _i, 2 ) : 0;
+        };
+
+        std::string out;
+        if ( 0x4000 == sign ) {
+            out += '-';
+        }
+
+        if ( weight < 0 ) {
+            out += '0';
+        }
+        else {
+            char buf[8];
+            for ( int i = 0; i <= weight; ++i ) {
+                snprintf( buf, sizeof( buf ), 0 == i ? "%d" : "%04d", digit( i ) );
+                out += buf;
+            }
+        }
+
+        if ( dscale > 0 ) {
+            std::string fraction;
+            char buf[8];
+            for ( int i = weight + 1; static_cast<int>( fraction.size() ) < dscale; ++i ) {
+                snprintf( buf, sizeof( buf ), "%04d", digit( i ) );
+                fraction += buf;
+            }
+            fraction.resize( dscale );
+            out += '.';
+            out += fraction;
+        }
+
+        return out;
+    } // numeric_to_string
+
+    auto decode_binary_value( Oid _type, const char* _p, int _length ) -> std::string
+    {
+        switch ( _type ) {
+            case BOOLOID:    return ( _length > 0 && _p[0] ) ? "t" : "f";
+            case INT2OID:    return std::to_string( read_integer( _p, 2 ) );
+            case INT4OID:    return std::to_string( read_integer( _p, 4 ) );
+            case INT8OID:    return std::to_string( read_integer( _p, 8 ) );
+            case OIDOID:     return std::to_string( static_cast<std::uint32_t>( read_integer( _p, 4 ) ) );
+            case NUMERICOID: return numeric_to_string( _p, _length );
+            default:         return std::string( _p, _length );
+        }
+    } // decode_binary_value
+
+    // Replaces the '?' markers used throughout the catalog code with the positional
+    // parameters ($1, $2, ...) understood by the server. Quoted text is left alone.
+    auto to_positional_parameters( std::string_view _sql ) -> std::string
+    {
+        std::string out;
+        out.reserve( _sql.size() + 16 );
+
+        int count = 0;
+        char quote = '\0';
+
+        for ( const char c : _sql ) {
+            if ( quote ) {
+                if ( c == quote ) {
+                    quote = '\0';
+                }
+                out += c;
+            }
+            else if ( '\'' == c || '"' == c ) {
+                quote = c;
+                out += c;
+            }
+            else if ( '?' == c ) {
+                out += '$';
+                out += std::to_string( ++count );
+            }
+            else {
+                out += c;
+            }
+        }
+
+        return out;
+    } // to_positional_parameters
+
+    auto is_transaction_control( const char* _sql ) noexcept -> bool
+    {
+        return strncmp( _sql, "begin", 5 ) == 0 ||
+               strncmp( _sql, "commit", 6 ) == 0 ||
+               strncmp( _sql, "rollback", 8 ) == 0;
+    } // is_transaction_control
+
+    auto is_success( const PGresult* _result ) noexcept -> bool
+    {
+        const auto status = PQresultStatus( _result );
+        return PGRES_COMMAND_OK == status || PGRES_TUPLES_OK == status;
+    } // is_success
+
+    /*
+      Log the error of a failed statement and map it to an iRODS error code.
+    */
+    auto logPqError( int level, PGconn* conn, const PGresult* result ) -> int
+    {
+        const char* sqlstate = result ? PQresultErrorField( result, PG_DIAG_SQLSTATE ) : nullptr;
+        const char* message = result ? PQresultErrorMessage( result ) : PQerrorMessage( conn );
+
+        snprintf( lastErrorMessage, sizeof( lastErrorMessage ), "%s", message ? message : "" );
+
+        rodsLog( level, "SQLSTATE: %s", sqlstate ? sqlstate : "" );
+        rodsLog( level, "SQL Error message: %s", lastErrorMessage );
+
+        if ( sqlstate && strcmp( sqlstate, "23505" ) == 0 ) {
+            return CATALOG_ALREADY_HAS_ITEM_BY_THAT_NAME;
+        }
+        return -2;
+    } // logPqError
+
+    struct execution
+    {
+        PGresult* begin = nullptr;     // The result of the 'begin', if one was sent.
+        PGresult* statement = nullptr; // The result of the statement itself.
+    }; // struct execution
+
+    /*
+      Execute a statement, preparing it first if it has bind variables and has not
+      been seen on this connection yet.  If _sendBegin is set, a 'begin' is sent
+      ahead of the statement.  Everything is sent in one pipeline when libpq
+      supports pipeline mode (libpq 14 and later).
+      The caller owns the results.
+    */
+    auto execute( icatSessionStruct* icss,
+                  const char* sql,
+                  const std::vector<const char*>& params,
+                  bool sendBegin ) -> execution
+    {
+        auto* conn = static_cast<PGconn*>( icss->connectPtr );
+        auto* session = static_cast<libpq_session*>( icss->environPtr );
+
+        const int nParams = static_cast<int>( params.size() );
+        const char* const* values = params.empty() ? nullptr : params.data();
+
+        const prepared_statement* cached = nullptr;
+        std::string newName;
+
+        if ( nParams > 0 ) {
+            if ( const auto iter = session->prepared.find( sql ); iter != std::end( session->prepared ) ) {
+                cached = &iter->second;
+            }
+            else if ( session->prepared.size() < max_prepared_statements ) {
+                newName = "irods_" + std::to_string( ++session->statement_counter );
+            }
+        }
+
+        execution out;
+
+        // A single round trip either way, so there is nothing to pipeline.
+        if ( !sendBegin && newName.empty() ) {
+            if ( cached ) {
+                out.statement = PQexecPrepared( conn, cached->name.c_str(), nParams, values,
+                                                nullptr, nullptr, cached->result_format );
+            }
+            else {
+                out.statement = PQexecParams( conn, to_positional_parameters( sql ).c_str(), nParams,
+                                              nullptr, values, nullptr, nullptr, text_format );
+            }
+            return out;
+        }
+
+        PGresult* prepareResult = nullptr;
+        PGresult* describeResult = nullptr;
+
+#ifdef LIBPQ_HAS_PIPELINING
+        if ( !PQenterPipelineMode( conn ) ) {
+            return out;
+        }
+
+        enum class step { begin, prepare, describe, statement };
+        std::vector<step> steps;
+
+        bool sent = true;
+        if ( sendBegin ) {
+            sent = sent && PQsendQueryParams( conn, "begin", 0, nullptr, nullptr, nullptr, nullptr, text_format );
+            steps.push_back( step::begin );
+        }
+        if ( !newName.empty() ) {
+            sent = sent && PQsendPrepare( conn, newName.c_str(), to_positional_parameters( sql ).c_str(), 0, nullptr );
+            sent = sent && PQsendDescribePrepared( conn, newName.c_str() );
+            sent = sent && PQsendQueryPrepared( conn, newName.c_str(), nParams, values, nullptr, nullptr, text_format );
+            steps.insert( std::end( steps ), {step::prepare, step::describe, step::statement} );
+        }
+        else if ( cached ) {
+            sent = sent && PQsendQueryPrepared( conn, cached->name.c_str(), nParams, values,
+                                                nullptr, nullptr, cached->result_format );
+            steps.push_back( step::statement );
+        }
+        else {
+            sent = sent && PQsendQueryParams( conn, to_positional_parameters( sql ).c_str(), nParams,
+                                              nullptr, values, nullptr, nullptr, text_format );
+            steps.push_back( step::statement );
+        }
+        sent = sent && PQpipelineSync( conn );
+
+        /* Each step produces one result followed by a null, and the sync
+           produces a final result of its own. */
+        for ( std::size_t i = 0; sent && i < steps.size(); ++i ) {
+            PGresult* result = PQgetResult( conn );
+            if ( !result ) {
+                break;
+            }
+            while ( PGresult* extra = PQgetResult( conn ) ) {
+                PQclear( extra );
+            }
+
+            switch ( steps[i] ) {
+                case step::begin:     out.begin = result; break;
+                case step::prepare:   prepareResult = result; break;
+                case step::describe:  describeResult = result; break;
+                case step::statement: out.statement = result; break;
+            }
+        }
+
+        for ( PGresult* result = PQgetResult( conn ); result; result = PQgetResult( conn ) ) {
+            const bool synced = PQresultStatus( result ) == PGRES_PIPELINE_SYNC;
+            PQclear( result );
+            if ( synced ) {
+                break;
+            }
+        }
+        PQexitPipelineMode( conn );
+
+#else
+        /* libpq before 14 has no pipeline mode, so each step takes a round
+           trip of its own.  As in a pipeline, a failed step ends the execution. */
+        if ( sendBegin ) {
+            out.begin = PQexec( conn, "begin" );
+            if ( !is_success( out.begin ) ) {
+                return out;
+            }
+        }
+        if ( !newName.empty() ) {
+            prepareResult = PQprepare( conn, newName.c_str(), to_positional_parameters( sql ).c_str(), 0, nullptr );
+            if ( is_success( prepareResult ) ) {
+                describeResult = PQdescribePrepared( conn, newName.c_str() );
+                out.statement = PQexecPrepared( conn, newName.c_str(), nParams, values, nullptr, nullptr, text_format );
+            }
+        }
+        else if ( cached ) {
+            out.statement = PQexecPrepared( conn, cached->name.c_str(), nParams, values,
+                                            nullptr, nullptr, cached->result_format );
+        }
+        else {
+            out.statement = PQexecParams( conn, to_positional_parameters( sql ).c_str(), nParams,
+                                          nullptr, values, nullptr, nullptr, text_format );
+        }
+#endif
+
+        if ( prepareResult && is_success( prepareResult ) ) {
+            int resultFormat = text_format;
+            if ( describeResult && is_success( describeResult ) && PQnfields( describeResult ) > 0 ) {
+                resultFormat = binary_format;
+                for ( int i = 0; i < PQnfields( describeResult ); ++i ) {
+                    if ( !is_decodable( PQftype( describeResult, i ) ) ) {
+                        resultFormat = text_format;
+                        break;
+                    }
+                }
+            }
+            session->prepared.emplace( sql, prepared_statement{newName, resultFormat} );
+        }
+        else if ( prepareResult ) {
+            /* report the failure to prepare instead of the aborted execution */
+            PQclear( out.statement );
+            out.statement = prepareResult;
+            prepareResult = nullptr;
+        }
+
+        PQclear( prepareResult );
+        PQclear( describeResult );
+
+        return out;
+    } // execute
+
+    auto gatherBindVariables() -> std::vector<const char*>
+    {
+        std::vector<const char*> params( cllBindVars, cllBindVars + cllBindVarCount );
+        cllBindVarCountPrev = cllBindVarCount; /* save in case we need to log error */
+        cllBindVarCount = 0; /* reset for next call */
+
+        for ( std::size_t i = 0; i < params.size(); ++i ) {
+            char tmpStr[LONG_NAME_LEN];
+            snprintf( tmpStr, sizeof( tmpStr ), "bindVar[%ju]=%s", static_cast<uintmax_t>( i + 1 ), params[i] );
+            rodsLogSql( tmpStr );
+        }
+
+        return params;
+    } // gatherBindVariables
+
+    void logTheBindVariables( int level, const std::vector<const char*>& params ) {
+        for ( std::size_t i = 0; i < params.size(); i++ ) {
+            rodsLog( level, "bindVar[%ju]=%s", static_cast<uintmax_t>( i + 1 ), params[i] ? params[i] : "" );
+        }
+    }
+
+    /*
+       Execute a SQL command that returns a result table and attach the
+       result to a new statement.
+    */
+    auto execSqlWithResult( icatSessionStruct* icss,
+                            int* stmtNum,
+                            const char* sql,
+                            const std::vector<const char*>& params,
+                            const char* caller ) -> int
+    {
+        rodsLog( LOG_DEBUG10, "%s", sql );
+
+        // Issue 3862:  Set stmtNum to -1 and in cllFreeStatement if the stmtNum is negative do nothing
+        *stmtNum = UNINITIALIZED_STATEMENT_NUMBER;
+
+        int statementNumber = UNINITIALIZED_STATEMENT_NUMBER;
+        for ( int i = 0; i < MAX_NUM_OF_CONCURRENT_STMTS && statementNumber < 0; i++ ) {
+            if ( icss->stmtPtr[i] == 0 ) {
+                statementNumber = i;
+            }
+        }
+        if ( statementNumber < 0 ) {
+            rodsLog( LOG_ERROR, "%s: too many concurrent statements", caller );
+            return CAT_STATEMENT_TABLE_FULL;
+        }
+
+        rodsLogSql( sql );
+        const auto result = execute( icss, sql, params, false );
+
+        if ( !result.statement || !is_success( result.statement ) ) {
+            rodsLogSqlResult( "SQL_ERROR" );
+            logTheBindVariables( LOG_NOTICE, params );
+            rodsLog( LOG_NOTICE, "%s: execution error, sql:%s", caller, sql );
+            logPqError( LOG_NOTICE, static_cast<PGconn*>( icss->connectPtr ), result.statement );
+            PQclear( result.statement );
+            return -1;
+        }
+        rodsLogSqlResult( "SUCCESS" );
+
+        auto* pgStatement = new libpq_statement;
+        pgStatement->result = result.statement;
+        pgStatement->result_format = PQbinaryTuples( result.statement ) ? binary_format : text_format;
+
+        auto* myStatement = static_cast<icatStmtStrct*>( malloc( sizeof( icatStmtStrct ) ) );
+        memset( myStatement, 0, sizeof( icatStmtStrct ) );
+        myStatement->stmtPtr = pgStatement;
+
+        const int numColumns = PQnfields( result.statement );
+        myStatement->numOfCols = numColumns;
+        pgStatement->column_names.reserve( numColumns );
+        pgStatement->values.resize( numColumns );
+        for ( int i = 0; i < numColumns; i++ ) {
+            pgStatement->column_names.emplace_back( PQfname( result.statement, i ) );
+            myStatement->resultColName[i] = pgStatement->column_names.back().data();
+            myStatement->resultValue[i] = pgStatement->values[i].data();
+        }
+
+        icss->stmtPtr[statementNumber] = myStatement;
+        *stmtNum = statementNumber;
+
+        return 0;
+    } // execSqlWithResult
+} // anonymous namespace
+
+int
+cllGetLastErrorMessage( char *msg, int maxChars ) {
+    strncpy( msg, lastErrorMessage, maxChars );
+    return 0;
+}
+
+/*
+   Allocate the per-session state used by the SQL routines.
+*/
+int
+cllOpenEnv( icatSessionStruct *icss ) {
+    icss->environPtr = new libpq_session;
+    return 0;
+}
+
+/*
+   Deallocate the per-session state.
+*/
+int
+cllCloseEnv( icatSessionStruct *icss ) {
+    delete static_cast<libpq_session*>( icss->environPtr );
+    icss->environPtr = NULL;
+    return 0;
+}
+
+/*
+  Connect to the DBMS.  The host, port and database name come from the
+  database plugin configuration in server_config.json.  Anything not
+  configured there is left to the libpq defaults (i.e. the PG* environment
+  variables).
+*/
+int
+cllConnect( icatSessionStruct *icss ) {
+    std::vector<std::pair<std::string, std::string>> settings;
+
+    try {
+        using map_type = std::unordered_map<std::string, boost::any>;
+        const auto config = irods::get_server_property<const map_type>(
+            std::vector<std::string>{irods::CFG_PLUGIN_CONFIGURATION_KW, irods::PLUGIN_TYPE_DATABASE, icss->database_plugin_type} );
+
+        const std::pair<const std::string&, const char*> string_settings[] = {
+            {irods::CFG_DB_HOST_KW, "host"},
+            {irods::CFG_DB_NAME_KW, "dbname"},
+            {irods::CFG_DB_SSLMODE_KW, "sslmode"},
+            {irods::CFG_DB_SSLROOTCERT_KW, "sslrootcert"},
+            {irods::CFG_DB_SSLCERT_KW, "sslcert"},
+            {irods::CFG_DB_SSLKEY_KW, "sslkey"}
+        };
+
+        for ( auto&& [keyword, name] : string_settings ) {
+            if ( const auto iter = config.find( keyword ); iter != std::end( config ) ) {
+                settings.emplace_back( name, boost::any_cast<const std::string&>( iter->second ) );
+            }
+        }
+
+        if ( const auto iter = config.find( irods::CFG_DB_PORT_KW ); iter != std::end( config ) ) {
+            settings.emplace_back( "port", std::to_string( boost::any_cast<int>( iter->second ) ) );
+        }
+    }
+    catch ( const irods::exception& e ) {
+        rodsLog( LOG_DEBUG, "cllConnect: database plugin configuration not available, using libpq defaults" );
+    }
+    catch ( const boost::bad_any_cast& e ) {
+        rodsLog( LOG_ERROR, "cllConnect: invalid database plugin configuration: %s", e.what() );
+        return -1;
+    }
+
+    settings.emplace_back( "user", icss->databaseUsername );
+    settings.emplace_back( "password", icss->databasePassword );
+    settings.emplace_back( "application_name", "irods" );
+
+    std::vector<const char*> keywords;
+    std::vector<const char*> values;
+    for ( auto&& [k, v] : settings ) {
+        keywords.push_back( k.c_str() );
+        values.push_back( v.c_str() );
+    }
+    keywords.push_back( nullptr );
+    values.push_back( nullptr );
+
+    PGconn* conn = PQconnectdbParams( keywords.data(), values.data(), 0 );
+    if ( !conn || PQstatus( conn ) != CONNECTION_OK ) {
+        rodsLog( LOG_ERROR, "cllConnect: PQconnectdbParams failed:user=%s,pass=XXXXX", icss->databaseUsername );
+        rodsLog( LOG_ERROR, "cllConnect: %s", conn ? PQerrorMessage( conn ) : "out of memory" );
+        PQfinish( conn );
+        return -1;
+    }
+
+    icss->connectPtr = conn;
+
+    return 0;
+}
+
+/*
+  This function is used to check that there are no DB-modifying SQLs pending
+  before a disconnect.  If there are, it logs a warning.
+
+  If option is 0, record some of the sql, or clear it (if commit or rollback).
+  If option is 1, issue warning the there are some pending (and include
+  some of the sql).
+*/
+#define maxPendingToRecord 5
+#define pendingRecordSize 30
+#define pBufferSize (maxPendingToRecord*pendingRecordSize)
+int
+cllCheckPending( const char *sql, int option, int dbType ) {
+    static int pendingCount = 0;
+    static int pendingIx = 0;
+    static char pBuffer[pBufferSize + 2];
+
+    if ( option == 0 ) {
+        if ( strncmp( sql, "commit", 6 ) == 0 ||
+                strncmp( sql, "rollback", 8 ) == 0 ) {
+            pendingIx = 0;
+            pendingCount = 0;
+            memset( pBuffer, 0, pBufferSize );
+            return 0;
+        }
+        if ( pendingIx < maxPendingToRecord ) {
+            strncpy( ( char * )&pBuffer[pendingIx * pendingRecordSize], sql,
+                     pendingRecordSize - 1 );
+            pendingIx++;
+        }
+        pendingCount++;
+        return 0;
+    }
+
+    if ( pendingCount > 0 ) {
+        /* but ignore a single pending "begin" which can be normal */
+        if ( pendingIx == 1 ) {
+            if ( strncmp( ( char * )&pBuffer[0], "begin", 5 ) == 0 ) {
+                return 0;
+            }
+        }
+
+        rodsLog( LOG_NOTICE, "Warning, pending SQL at cllDisconnect, count: %d",
+                 pendingCount );
+        int max = maxPendingToRecord;
+        if ( pendingIx < max ) {
+            max = pendingIx;
+        }
+        for ( int i = 0; i < max; i++ ) {
+            rodsLog( LOG_NOTICE, "Warning, pending SQL: %s ...",
+                     ( char * )&pBuffer[i * pendingRecordSize] );
+        }
+    }
+
+    return 0;
+}
+
+/*
+  Disconnect from the DBMS.
+*/
+int
+cllDisconnect( icatSessionStruct *icss ) {
+
+    cllCheckPending( "", 1, icss->databaseType );
+
+    PQfinish( static_cast<PGconn*>( icss->connectPtr ) );
+    icss->connectPtr = NULL;
+
+    /* prepared statements do not outlive the connection */
+    if ( auto* session = static_cast<libpq_session*>( icss->environPtr ) ) {
+        session->prepared.clear();
+    }
+
+    return 0;
+}
+
+/*
+  Execute a SQL command which has no resulting table.  Examples include
+  insert, delete, update, or ddl.
+  Insert a 'begin' statement, if necessary.  The 'begin' is sent in the
+  same round trip as the statement.
+*/
+int
+cllExecSqlNoResult( icatSessionStruct *icss, const char *sql ) {
+    rodsLog( LOG_DEBUG10, "%s", sql );
+
+    bool sendBegin = false;
+    if ( strncmp( sql, "commit", 6 ) == 0 ||
+            strncmp( sql, "rollback", 8 ) == 0 ) {
+        didBegin = 0;
+    }
+    else {
+        sendBegin = ( didBegin == 0 );
+    }
+
+    const auto params = gatherBindVariables();
+
+    rodsLogSql( sql );
+    const auto result = execute( icss, sql, params, sendBegin );
+    auto* conn = static_cast<PGconn*>( icss->connectPtr );
+
+    int status = 0;
+    if ( result.begin && !is_success( result.begin ) ) {
+        rodsLogSqlResult( "SQL_ERROR" );
+        rodsLog( LOG_NOTICE, "cllExecSqlNoResult: begin error" );
+        status = logPqError( LOG_NOTICE, conn, result.begin );
+    }
+    else if ( !result.statement || !is_success( result.statement ) ) {
+        if ( result.begin ) {
+            cllCheckPending( "begin", 0, icss->databaseType );
+            didBegin = 1;
+        }
+        rodsLogSqlResult( "SQL_ERROR" );
+        logTheBindVariables( LOG_NOTICE, params );
+        rodsLog( LOG_NOTICE, "cllExecSqlNoResult: execution error, sql:%s", sql );
+        status = logPqError( LOG_NOTICE, conn, result.statement );
+        noResultRowCount = 0;
+    }
+    else {
+        rodsLogSqlResult( "SUCCESS" );
+        if ( result.begin ) {
+            cllCheckPending( "begin", 0, icss->databaseType );
+        }
+        if ( sendBegin ) {
+            didBegin = 1;
+        }
+        cllCheckPending( sql, 0, icss->databaseType );
+
+        noResultRowCount = atoi( PQcmdTuples( result.statement ) );
+        if ( !is_transaction_control( sql ) && noResultRowCount == 0 ) {
+            status = CAT_SUCCESS_BUT_WITH_NO_INFO;
+        }
+    }
+
+    PQclear( result.begin );
+    PQclear( result.statement );
+
+    return status;
+}
+
+/*
+   Execute a SQL command that returns a result table.
+   This version uses the global array of bind variables.
+*/
+int
+cllExecSqlWithResult( icatSessionStruct *icss, int *stmtNum, const char *sql ) {
+    return execSqlWithResult( icss, stmtNum, sql, gatherBindVariables(), "cllExecSqlWithResult" );
+}
+
+/*
+   Execute a SQL command that returns a result table; and allow optional
+   bind variables.  As with the ODBC routines, empty bind variables are
+   not bound, i.e. they are sent as NULL.
+*/
+int
+cllExecSqlWithResultBV(
+    icatSessionStruct *icss,
+    int *stmtNum,
+    const char *sql,
+    std::vector< std::string > &bindVars ) {
+
+    std::vector<const char*> params;
+    params.reserve( bindVars.size() );
+    for ( std::size_t i = 0; i < bindVars.size(); i++ ) {
+        params.push_back( bindVars[i].empty() ? nullptr : bindVars[i].c_str() );
+        if ( !bindVars[i].empty() ) {
+            char tmpStr[LONG_NAME_LEN];
+            snprintf( tmpStr, sizeof( tmpStr ), "bindVar%ju=%s", static_cast<uintmax_t>( i + 1 ), bindVars[i].c_str() );
+            rodsLogSql( tmpStr );
+        }
+    }
+
+    return execSqlWithResult( icss, stmtNum, sql, params, "cllExecSqlWithResultBV" );
+}
+
+/*
+  Return a row from a previous cllExecSqlWithResult call.
+  The rows were all fetched with the result, so this only moves to the
+  next one (decoding it, for binary results).
+*/
+int
+cllGetRow( icatSessionStruct *icss, int statementNumber ) {
+    icatStmtStrct *myStatement = icss->stmtPtr[statementNumber];
+    auto* pgStatement = static_cast<libpq_statement*>( myStatement->stmtPtr );
+
+    const int row = pgStatement->next_row;
+    if ( row >= PQntuples( pgStatement->result ) ) {
+        myStatement->numOfCols = 0;
+        return 0;
+    }
+    ++pgStatement->next_row;
+
+    for ( int i = 0; i < myStatement->numOfCols; i++ ) {
+        if ( pgStatement->result_format == text_format ) {
+            /* the result owns the value, no copy needed */
+            myStatement->resultValue[i] = PQgetvalue( pgStatement->result, row, i );
+            continue;
+        }
+
+        auto& value = pgStatement->values[i];
+        if ( PQgetisnull( pgStatement->result, row, i ) ) {
+            value.clear();
+        }
+        else {
+            value = decode_binary_value( PQftype( pgStatement->result, i ),
+                                         PQgetvalue( pgStatement->result, row, i ),
+                                         PQgetlength( pgStatement->result, row, i ) );
+        }
+        myStatement->resultValue[i] = value.data();
+    }
+
+    return 0;
+}
+
+/*
+   Return the string needed to get the next value in a sequence item.
+*/
+int
+cllNextValueString( const char *itemName, char *outString, int maxSize ) {
+    snprintf( outString, maxSize, "nextval('%s')", itemName );
+    return 0;
+}
+
+int
+cllGetRowCount( icatSessionStruct *icss, int statementNumber ) {
+
+    if ( statementNumber < 0 ) {
+        return noResultRowCount;
+    }
+
+    icatStmtStrct * myStatement = icss->stmtPtr[statementNumber];
+    return PQntuples( static_cast<libpq_statement*>( myStatement->stmtPtr )->result );
+}
+
+int
+cllCurrentValueString( const char *itemName, char *outString, int maxSize ) {
+    snprintf( outString, maxSize, "currval('%s')", itemName );
+    return 0;
+}
+
+/*
+   Free a statement (from a previous cllExecSqlWithResult call) and its
+   result.
+*/
+int
+cllFreeStatement( icatSessionStruct *icss, int& statementNumber ) {
+
+    // Issue 3862 - Statement number is set to negative until it is
+    // created.  When the statement is freed it is again set to negative.
+    if ( statementNumber < 0 ) {
+        return 0;
+    }
+
+    icatStmtStrct * myStatement = icss->stmtPtr[statementNumber];
+    if ( myStatement == NULL ) { /* already freed */
+        statementNumber = UNINITIALIZED_STATEMENT_NUMBER;
+        return 0;
+    }
+
+    auto* pgStatement = static_cast<libpq_statement*>( myStatement->stmtPtr );
+    PQclear( pgStatement->result );
+    delete pgStatement;
+
+    free( myStatement );
+    icss->stmtPtr[statementNumber] = NULL; /* indicate that the statement is free */
+    statementNumber = UNINITIALIZED_STATEMENT_NUMBER;
+
+    return 0;
+}
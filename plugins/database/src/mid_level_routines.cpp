@@ -19,9 +19,17 @@
 #include "irods_stacktrace.hpp"
 #include "irods_log.hpp"
 #include "irods_virtual_path.hpp"
+#include "irods_server_properties.hpp"
+#include "irods_configuration_keywords.hpp"
+#include "irods_exception.hpp"
+#include "irods_sql_logger.hpp"
+#include "catalog_permission_cache.hpp"
 
 #include "rcMisc.h"
 
+#include <algorithm>
+#include <functional>
+#include <set>
 #include <vector>
 #include <string>
 
@@ -646,6 +654,86 @@ int cmlModifySingleTable( const char *tableName,
 }
 
 #define STR_LEN 100
+
+/*
+  Object IDs reserved from R_ObjectID by this agent that have not been
+  handed out yet, in reverse order so the next one is at the back.
+  Every value came from the sequence, so no other agent can receive it.
+  IDs still reserved when the agent exits are simply never used.
+*/
+static std::vector<rodsLong_t> reservedObjectIds;
+
+static int
+getObjectIdBlockSize() {
+#ifdef MY_ICAT
+    /* R_ObjectId_nextval() is a stored function that inserts a row per
+       call, so MySQL cannot reserve more than one ID per round trip. */
+    return 1;
+#else
+    try {
+        return std::max( 1, irods::get_advanced_setting<const int>( irods::CFG_CATALOG_OBJECT_ID_BLOCK_SIZE_KW ) );
+    }
+    catch ( const irods::exception& ) {
+        return 1;
+    }
+#endif
+}
+
+/*
+  Reserve blockSize values of R_ObjectID with a single query.
+  Returns the number of IDs reserved or an iRODS error code.
+*/
+static int
+cmlReserveObjectIds( int blockSize, icatSessionStruct *icss ) {
+    char nextStr[STR_LEN];
+    char sql[STR_LEN * 2];
+    int stmtNum = UNINITIALIZED_STATEMENT_NUMBER;
+
+    if ( logSQL_CML != 0 ) {
+        rodsLog( LOG_SQL, "cmlReserveObjectIds SQL 1 " );
+    }
+
+    nextStr[0] = '\0';
+    cllNextValueString( "R_ObjectID", nextStr, STR_LEN );
+
+#ifdef ORA_ICAT
+    snprintf( sql, sizeof( sql ), "select %s from DUAL connect by level <= %d", nextStr, blockSize );
+#else
+    snprintf( sql, sizeof( sql ), "select %s from generate_series(1, %d)", nextStr, blockSize );
+#endif
+
+    std::vector<std::string> emptyBindVars;
+    int status = cllExecSqlWithResultBV( icss, &stmtNum, sql, emptyBindVars );
+    if ( status != 0 ) {
+        cllFreeStatement( icss, stmtNum );
+        if ( status <= CAT_ENV_ERR ) {
+            return status;    /* already an iRODS error code */
+        }
+        return CAT_SQL_ERR;
+    }
+
+    std::vector<rodsLong_t> ids;
+    ids.reserve( blockSize );
+
+    while ( 0 == cllGetRow( icss, stmtNum ) && icss->stmtPtr[stmtNum]->numOfCols > 0 ) {
+        ids.push_back( strtoll( icss->stmtPtr[stmtNum]->resultValue[0], NULL, 0 ) );
+    }
+
+    cllFreeStatement( icss, stmtNum );
+
+    if ( ids.empty() ) {
+        return CAT_NO_ROWS_FOUND;
+    }
+
+    /* Hand out the lowest ID first. */
+    std::sort( ids.begin(), ids.end(), std::greater<rodsLong_t>() );
+    reservedObjectIds.insert( reservedObjectIds.end(), ids.begin(), ids.end() );
+
+    rodsLog( LOG_DEBUG, "cmlReserveObjectIds reserved %zu object IDs", ids.size() );
+
+    return ids.size();
+}
+
 rodsLong_t
 cmlGetNextSeqVal( icatSessionStruct *icss ) {
     char nextStr[STR_LEN];
@@ -653,6 +741,23 @@ cmlGetNextSeqVal( icatSessionStruct *icss ) {
     int status;
     rodsLong_t iVal{};
 
+    const int blockSize = getObjectIdBlockSize();
+
+    if ( blockSize > 1 ) {
+        if ( reservedObjectIds.empty() ) {
+            status = cmlReserveObjectIds( blockSize, icss );
+            if ( status < 0 ) {
+                rodsLog( LOG_NOTICE,
+                         "cmlGetNextSeqVal cmlReserveObjectIds failure %d", status );
+                return status;
+            }
+        }
+
+        iVal = reservedObjectIds.back();
+        reservedObjectIds.pop_back();
+        return iVal;
+    }
+
     if ( logSQL_CML != 0 ) {
         rodsLog( LOG_SQL, "cmlGetNextSeqVal SQL 1 " );
     }
@@ -844,6 +949,13 @@ cmlCheckDir( const char *dirName, const char *userName, const char *userZone, co
     int status;
     rodsLong_t iVal{};
 
+    namespace cache = irods::catalog_permission_cache;
+
+    if ( const auto entry = cache::lookup_collection( dirName, userName, userZone, accessLevel ) ) {
+        irods::sql_logger::log_avoided( "cmlCheckDir", logSQL_CML != 0, 1 );
+        return entry->collection_id;
+    }
+
     if ( logSQL_CML != 0 ) {
         rodsLog( LOG_SQL, "cmlCheckDir SQL 1 " );
     }
@@ -875,6 +987,8 @@ cmlCheckDir( const char *dirName, const char *userName, const char *userZone, co
         return CAT_NO_ACCESS_PERMISSION;
     }
 
+    cache::insert_collection( dirName, userName, userZone, accessLevel, {iVal, std::nullopt} );
+
     return iVal;
 
 }
@@ -905,7 +1019,21 @@ cmlCheckDirAndGetInheritFlag( const char *dirName, const char *userName, const c
 
     *inheritFlag = 0;
 
-    if ( ticketStr != NULL && *ticketStr != '\0' ) {
+    namespace cache = irods::catalog_permission_cache;
+
+    // Ticket based access is never cached.
+    const bool use_ticket = ticketStr != NULL && *ticketStr != '\0';
+
+    if ( !use_ticket ) {
+        const auto entry = cache::lookup_collection( dirName, userName, userZone, accessLevel );
+        if ( entry && entry->inheritance ) {
+            irods::sql_logger::log_avoided( "cmlCheckDirAndGetInheritFlag", logSQL_CML != 0, 1 );
+            *inheritFlag = *entry->inheritance ? 1 : 0;
+            return entry->collection_id;
+        }
+    }
+
+    if ( use_ticket ) {
         if ( logSQL_CML != 0 ) {
             rodsLog( LOG_SQL, "cmlCheckDirAndGetInheritFlag SQL 1 " );
         }
@@ -960,7 +1088,7 @@ cmlCheckDirAndGetInheritFlag( const char *dirName, const char *userName, const c
     /*
      Also check the other aspects ticket at this point.
      */
-    if ( ticketStr != NULL && *ticketStr != '\0' ) {
+    if ( use_ticket ) {
         status = checkObjIdByTicket( cValStr1, accessLevel, ticketStr,
                                      ticketHost, userName, userZone,
                                      icss );
@@ -968,6 +1096,9 @@ cmlCheckDirAndGetInheritFlag( const char *dirName, const char *userName, const c
             return status;
         }
     }
+    else {
+        cache::insert_collection( dirName, userName, userZone, accessLevel, {iVal, 1 == *inheritFlag} );
+    }
 
     return iVal;
 
@@ -1143,6 +1274,13 @@ int cmlCheckUserInGroup( const char *userName, const char *userZone,
     char sVal[MAX_NAME_LEN];
     rodsLong_t iVal;
 
+    namespace cache = irods::catalog_permission_cache;
+
+    if ( const auto groups = cache::lookup_groups( userName, userZone ) ) {
+        irods::sql_logger::log_avoided( "cmlCheckUserInGroup", logSQL_CML != 0, 2 );
+        return groups->count( groupName ) > 0 ? 0 : CAT_NO_ROWS_FOUND;
+    }
+
     if ( logSQL_CML != 0 ) {
         rodsLog( LOG_SQL, "cmlCheckUserInGroup SQL 1 " );
     }
@@ -1160,6 +1298,34 @@ int cmlCheckUserInGroup( const char *userName, const char *userZone,
         return status;
     }
 
+    if ( cache::enabled() ) {
+        /* Fetch every group of the user at once so that later checks
+           against other groups are answered from the cache. */
+        if ( logSQL_CML != 0 ) {
+            rodsLog( LOG_SQL, "cmlCheckUserInGroup SQL 3 " );
+        }
+
+        bindVars.clear();
+        bindVars.push_back( sVal );
+        int stmtNum = UNINITIALIZED_STATEMENT_NUMBER;
+        std::set<std::string> groups;
+        status = cmlGetFirstRowFromSqlBV(
+                     "select UM.user_name from R_USER_GROUP UG, R_USER_MAIN UM where UG.user_id=? and UM.user_id = UG.group_user_id and UM.user_type_name='rodsgroup'",
+                     bindVars, &stmtNum, icss );
+        while ( status == 0 ) {
+            groups.insert( icss->stmtPtr[stmtNum]->resultValue[0] );
+            status = cmlGetNextRowFromStatement( stmtNum, icss );
+        }
+        /* the statement has been freed once the rows are exhausted */
+        if ( status != CAT_NO_ROWS_FOUND ) {
+            return status;
+        }
+
+        const bool is_member = groups.count( groupName ) > 0;
+        cache::insert_groups( userName, userZone, std::move( groups ) );
+        return is_member ? 0 : CAT_NO_ROWS_FOUND;
+    }
+
     if ( logSQL_CML != 0 ) {
         rodsLog( LOG_SQL, "cmlCheckUserInGroup SQL 2 " );
     }
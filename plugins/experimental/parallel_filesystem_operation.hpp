@@ -7,9 +7,12 @@
 #include "filesystem.hpp"
 #include "thread_pool.hpp"
 #include "connection_pool.hpp"
+#include "partitioned_collection_enumerator.hpp"
 
 #include "fmt/format.h"
 
+#include <optional>
+
 namespace irods::experimental::api {
 
     namespace fs   = irods::experimental::filesystem;
@@ -21,16 +24,13 @@ namespace irods::experimental::api {
             virtual ~parallel_filesystem_operation() {}
 
         protected:
-            using entry_type    = fscl::recursive_collection_iterator::value_type;
-            using dispatch_type = dispatch_processor<fscl::recursive_collection_iterator>;
-
             const int DEFAULT_NUMBER_OF_THREADS = 4;
 
             virtual void collection_precondition(rcComm_t&, const json&) {};
             virtual void process_object(rcComm_t&, const fs::path&, const json&) = 0;
             virtual void collection_postcondition(rcComm_t&, const json&) {}
 
-            auto get_thread_count()
+            auto get_plugin_setting(const std::string& key) -> std::optional<json>
             {
                 std::string path{};
                 if (auto e = irods::get_full_path_for_config_file("server_config.json", path); e.ok()) {
@@ -42,15 +42,33 @@ namespace irods::experimental::api {
 
                     if(psc.contains("api") && psc.at("api").contains(instance_name_)) {
                         auto in = psc.at("api").at(instance_name_);
-                        if(in.contains("thread_count")) {
-                            return in.at("thread_count").get<int>();
+                        if(in.contains(key)) {
+                            return in.at(key);
                         }
                     }
                 }
 
+                return std::nullopt;
+            }
+
+            auto get_thread_count()
+            {
+                if(auto v = get_plugin_setting("thread_count")) {
+                    return v->get<int>();
+                }
+
                 return DEFAULT_NUMBER_OF_THREADS;
             }
 
+            auto get_partition_size() -> uint64_t
+            {
+                if(auto v = get_plugin_setting("partition_size")) {
+                    return v->get<uint64_t>();
+                }
+
+                return partitioned_collection_enumerator::DEFAULT_PARTITION_SIZE;
+            }
+
             auto ends_with(const std::string &str, const std::string &suffix)
             {
                 return str.size() >= suffix.size() &&
@@ -58,24 +76,6 @@ namespace irods::experimental::api {
                                    suffix.size(), suffix) == 0;
             } // ends_with
 
-            auto get_object_count(rcComm_t& comm, const fs::path& path)
-            {
-                auto p_str = path.string();
-
-                if(ends_with(path, std::string{fs::path::preferred_separator})) {
-                    p_str.erase(p_str.size()-1);
-                }
-
-                auto q_str = fmt::format("SELECT COUNT(DATA_ID) WHERE COLL_NAME like '{}/%' ||= '{}'", p_str, p_str);
-
-                auto query = query_builder{}.build<rcComm_t>(comm, q_str);
-
-                auto count = std::strtoull(query.front()[0].c_str(), nullptr, 10);
-
-                return count;
-
-            } // get_object_count
-
             void process_collection(locking_json& bb, const json& req)
             {
                 try {
@@ -91,28 +91,38 @@ namespace irods::experimental::api {
 
                     auto lp = tmp.at("logical_path").get<std::string>();
 
+                    auto ps = tmp.contains("partition_size")
+                              ? tmp.at("partition_size").get<uint64_t>()
+                              : get_partition_size();
+
                     auto conn = cp->get_connection();
 
-                    progress_handler p_hdlr{conn, get_object_count(conn, lp), bb, tp, ef};
+                    // the total is unknown until the whole tree has been enumerated, the
+                    // progress grows with the object counts of each collection visited
+                    progress_handler p_hdlr{conn, 0, bb, tp, ef, true};
 
                     cancellation_handler c_hdlr{p_hdlr, bb, tp, ef};
 
                     collection_precondition(conn, tmp);
 
-                    auto job = [this, cp, &p_hdlr, &tmp] (const entry_type entry) {
-                                   if(entry.is_data_object()) {
-                                       auto conn = cp->get_connection();
-                                       process_object(conn, entry.path(), tmp);
-                                       p_hdlr++;
-                                   }
-                               };
+                    partitioned_collection_enumerator pce{
+                        lp, ps, ef,
+                        [this, &p_hdlr, &tmp](rcComm_t& comm, const fs::path& p) {
+                            process_object(comm, p, tmp);
+                            p_hdlr++;
+                        },
+                        [&p_hdlr](uint64_t n) { p_hdlr.add_to_estimate(n); }};
+
+                    pce.execute(tp, cp, tc);
+                    pce.wait();
 
-                    auto itr = fscl::recursive_collection_iterator(conn, lp);
-                    auto dp = dispatch_type(ef, itr, job);
-                    auto f = dp.execute(tp);
+                    // releases the progress and cancellation threads
+                    p_hdlr.finalize();
 
                     tp.join();
 
+                    auto f = pce.result();
+
                     bb.update(to_blackboard(f));
 
                     if(!ef) {
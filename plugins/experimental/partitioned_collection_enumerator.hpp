@@ -0,0 +1,326 @@
+#ifndef PARTITIONED_COLLECTION_ENUMERATOR_HPP
+#define PARTITIONED_COLLECTION_ENUMERATOR_HPP
+
+#include "experimental_plugin_framework.hpp"
+#include "filesystem.hpp"
+#include "thread_pool.hpp"
+#include "connection_pool.hpp"
+#include "query_builder.hpp"
+#include "irods_exception.hpp"
+#include "rodsErrorTable.h"
+
+#include "fmt/format.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace irods::experimental::api {
+
+    namespace fs = irods::experimental::filesystem;
+
+    // Enumerates the data objects of a collection tree on several connections at once.
+    //
+    // The tree is split into work items which are pulled from a shared queue by every
+    // worker. A collection item queues the child collections and counts the data objects
+    // directly inside the collection. Collections holding more than partition_size data
+    // objects are split further into DATA_ID ranges, so a single very large collection
+    // is spread across the workers as well.
+    //
+    // No query touches more than one collection, so the cost of enumeration does not
+    // depend on a LIKE over the whole tree. The per-collection counts are reported as
+    // they are discovered and can be used to estimate progress.
+    class partitioned_collection_enumerator
+    {
+        public:
+            using object_handler_type   = std::function<void(rcComm_t&, const fs::path&)>;
+            using estimate_handler_type = std::function<void(std::uint64_t)>;
+
+            static constexpr std::uint64_t DEFAULT_PARTITION_SIZE = 10'000;
+
+            partitioned_collection_enumerator(
+                const fs::path&        root
+              , std::uint64_t          partition_size
+              , flag_type&             stop_flag
+              , object_handler_type    object_handler
+              , estimate_handler_type  estimate_handler)
+                : partition_size_{partition_size > 0 ? partition_size : DEFAULT_PARTITION_SIZE}
+                , stop_flag_{stop_flag}
+                , object_handler_{std::move(object_handler)}
+                , estimate_handler_{std::move(estimate_handler)}
+                , queue_{}
+                , active_{}
+                , errors_{}
+                , mutex_{}
+                , cv_{}
+            {
+                queue_.push_back({root.string(), false, 0, 0});
+            }
+
+            partitioned_collection_enumerator(const partitioned_collection_enumerator&) = delete;
+            partitioned_collection_enumerator& operator=(const partitioned_collection_enumerator&) = delete;
+
+            // Posts one worker per connection to the thread pool. Every worker holds its
+            // connection until the tree is exhausted.
+            void execute(thread_pool& tp, std::shared_ptr<connection_pool> cp, int workers)
+            {
+                workers_ = workers;
+
+                for(int i = 0; i < workers; ++i) {
+                    thread_pool::post(tp, [this, cp] {
+                        try {
+                            auto conn = cp->get_connection();
+                            run_worker(conn);
+                        }
+                        catch(const irods::exception& e) {
+                            add_error(e.code(), e.client_display_what());
+                        }
+                        catch(const std::exception& e) {
+                            add_error(SYS_INTERNAL_ERR, e.what());
+                        }
+                        catch(...) {
+                            add_error(SYS_UNKNOWN_ERROR, "unknown error in partitioned enumeration");
+                        }
+
+                        {
+                            std::scoped_lock lk{mutex_};
+                            ++finished_;
+                        }
+
+                        cv_.notify_all();
+                    });
+                }
+
+            } // execute
+
+            // Blocks until every worker has returned or the operation is cancelled.
+            // Workers which were never started by a stopped thread pool are not waited on.
+            void wait()
+            {
+                std::unique_lock lk{mutex_};
+                while(finished_ < workers_ && !stop_flag_) {
+                    cv_.wait_for(lk, std::chrono::milliseconds{500});
+                }
+
+            } // wait
+
+            // Returns the failures reported by the object handler and the queries. Must
+            // only be called once the thread pool has been joined.
+            auto result() -> future
+            {
+                future f{stop_flag_};
+
+                for(auto&& e : errors_) {
+                    auto p = std::make_shared<future::promise_type>();
+                    p->set_value(e);
+                    f.push_back(p);
+                }
+
+                return f;
+
+            } // result
+
+        private:
+            struct work_item
+            {
+                std::string   collection;
+                bool          is_range;
+                std::uint64_t first_id;
+                std::uint64_t last_id;
+            };
+
+            void run_worker(rcComm_t& conn)
+            {
+                while(!stop_flag_) {
+                    work_item item{};
+
+                    {
+                        std::unique_lock lk{mutex_};
+
+                        // The tree is exhausted once the queue is empty and no other
+                        // worker can add to it anymore.
+                        while(queue_.empty() && active_ > 0 && !stop_flag_) {
+                            cv_.wait_for(lk, std::chrono::milliseconds{500});
+                        }
+
+                        if(queue_.empty() || stop_flag_) {
+                            break;
+                        }
+
+                        item = std::move(queue_.front());
+                        queue_.pop_front();
+                        ++active_;
+                    }
+
+                    try {
+                        if(item.is_range) {
+                            process_range(conn, item);
+                        }
+                        else {
+                            process_collection(conn, item.collection);
+                        }
+                    }
+                    catch(const irods::exception& e) {
+                        add_error(e.code(), fmt::format("failed to enumerate [{}]: {}",
+                                                        item.collection, e.client_display_what()));
+                    }
+                    catch(const std::exception& e) {
+                        add_error(SYS_INTERNAL_ERR, fmt::format("failed to enumerate [{}]: {}",
+                                                                item.collection, e.what()));
+                    }
+
+                    // Decremented on every path, otherwise the remaining workers would
+                    // wait on a collection which is never finished.
+
+                    {
+                        std::scoped_lock lk{mutex_};
+                        --active_;
+                    }
+
+                    cv_.notify_all();
+
+                } // while
+
+            } // run_worker
+
+            void add_error(int code, const std::string& msg)
+            {
+                std::scoped_lock lk{mutex_};
+                errors_.emplace_back(code, msg);
+            } // add_error
+
+            void push(std::deque<work_item>&& items)
+            {
+                if(items.empty()) {
+                    return;
+                }
+
+                {
+                    std::scoped_lock lk{mutex_};
+                    for(auto&& i : items) {
+                        queue_.push_back(std::move(i));
+                    }
+                }
+
+                cv_.notify_all();
+
+            } // push
+
+            void process_collection(rcComm_t& conn, const std::string& coll)
+            {
+                std::deque<work_item> items;
+
+                // Child collections become new work items for any worker.
+                auto children = query_builder{}.build<rcComm_t>(
+                                    conn, fmt::format("SELECT COLL_NAME WHERE COLL_PARENT_NAME = '{}'", coll));
+                for(auto&& row : children) {
+                    if(row[0] != coll) {
+                        items.push_back({row[0], false, 0, 0});
+                    }
+                }
+
+                push(std::move(items));
+
+                auto stats = query_builder{}.build<rcComm_t>(
+                                 conn,
+                                 fmt::format("SELECT COUNT(DATA_ID), MIN(DATA_ID), MAX(DATA_ID) WHERE COLL_NAME = '{}'", coll));
+                if(0 == stats.size()) {
+                    return;
+                }
+
+                const auto row   = stats.front();
+                const auto count = std::strtoull(row[0].c_str(), nullptr, 10);
+
+                if(0 == count) {
+                    return;
+                }
+
+                estimate_handler_(count);
+
+                if(count <= partition_size_) {
+                    process_objects(conn, fmt::format("SELECT DATA_NAME WHERE COLL_NAME = '{}'", coll), coll);
+                    return;
+                }
+
+                // Split the collection into DATA_ID ranges. IDs are not dense, so the
+                // ranges only approximate partition_size objects each.
+                const auto min_id     = std::strtoull(row[1].c_str(), nullptr, 10);
+                const auto max_id     = std::strtoull(row[2].c_str(), nullptr, 10);
+                const auto partitions = (count + partition_size_ - 1) / partition_size_;
+                const auto width      = std::max<std::uint64_t>(1, (max_id - min_id + 1) / partitions);
+
+                for(auto first = min_id; first <= max_id; first += width) {
+                    const auto last = (max_id - first < width) ? max_id : first + width - 1;
+                    items.push_back({coll, true, first, last});
+
+                    if(last == max_id) {
+                        break;
+                    }
+                }
+
+                push(std::move(items));
+
+            } // process_collection
+
+            void process_range(rcComm_t& conn, const work_item& item)
+            {
+                process_objects(conn,
+                                fmt::format("SELECT DATA_NAME WHERE COLL_NAME = '{}' AND DATA_ID >= '{}' AND DATA_ID <= '{}'",
+                                            item.collection, item.first_id, item.last_id),
+                                item.collection);
+
+            } // process_range
+
+            void process_objects(rcComm_t& conn, const std::string& q_str, const std::string& coll)
+            {
+                const fs::path parent{coll};
+
+                for(auto&& row : query_builder{}.build<rcComm_t>(conn, q_str)) {
+                    if(stop_flag_) {
+                        return;
+                    }
+
+                    const auto path = parent / row[0];
+
+                    // A failure is reported for the object alone, the rest of the
+                    // partition is still processed.
+                    try {
+                        object_handler_(conn, path);
+                    }
+                    catch(const irods::exception& e) {
+                        add_error(e.code(), e.client_display_what());
+                    }
+                    catch(const std::exception& e) {
+                        add_error(SYS_INTERNAL_ERR, fmt::format("{}: {}", path.c_str(), e.what()));
+                    }
+                }
+
+            } // process_objects
+
+            const std::uint64_t          partition_size_;
+            flag_type&                   stop_flag_;
+            const object_handler_type    object_handler_;
+            const estimate_handler_type  estimate_handler_;
+
+            std::deque<work_item>        queue_;
+            int                          active_;
+            int                          workers_{};
+            int                          finished_{};
+            future::errors_type          errors_;
+            std::mutex                   mutex_;
+            std::condition_variable      cv_;
+
+    }; // class partitioned_collection_enumerator
+
+} // namespace irods::experimental::api
+
+#endif // PARTITIONED_COLLECTION_ENUMERATOR_HPP
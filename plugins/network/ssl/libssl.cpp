@@ -4,6 +4,8 @@
 #include "msParam.h"
 #include "rcConnect.h"
 #include "sockComm.h"
+#include "packStruct.h"
+#include "rcGlobalExtern.h"
 
 // =-=-=-=-=-=-=-
 #include "irods_network_plugin.hpp"
@@ -18,6 +20,8 @@
 #include <sstream>
 #include <string>
 #include <iostream>
+#include <memory>
+#include <vector>
 
 // =-=-=-=-=-=-=-
 // ssl includes
@@ -35,6 +39,15 @@
     dh_->g = g_;
 #endif
 
+// =-=-=-=-=-=-=-
+// with read ahead, received data may be buffered by openssl
+// before it is decrypted, which SSL_pending does not report
+#if OPENSSL_VERSION_NUMBER >= 0x10100000
+#define SSL_HAS_PENDING(ssl_) SSL_has_pending(ssl_)
+#else
+#define SSL_HAS_PENDING(ssl_) (SSL_pending(ssl_) > 0)
+#endif
+
 // =-=-=-=-=-=-=-
 //
 #define SSL_CIPHER_LIST "ALL:!ADH:!LOW:!EXP:!MD5:@STRENGTH"
@@ -43,6 +56,11 @@
 // key for ssl shared secret property
 const std::string SHARED_KEY( "ssl_network_plugin_shared_key" );
 
+// =-=-=-=-=-=-=-
+// stream buffers up to this size are copied into the coalesced send
+// buffer, larger ones are written on their own to avoid the copy
+const int MAX_COALESCED_STREAM_SIZE = 1024 * 1024;
+
 // =-=-=-=-=-=-=-
 //
 static void ssl_log_error(
@@ -214,6 +232,13 @@ static SSL_CTX* ssl_init_context(
 
     SSL_CTX_set_options( ctx, SSL_OP_ALL | SSL_OP_NO_SSLv2 | SSL_OP_NO_SSLv3 | SSL_OP_NO_TLSv1 | SSL_OP_SINGLE_DH_USE );
 
+#if OPENSSL_VERSION_NUMBER >= 0x10100000
+    /* read as much as the socket holds into the read buffer of the connection,
+       which is kept for the life of the connection, so that the header and body
+       of a message are usually received with a single read */
+    SSL_CTX_set_read_ahead( ctx, 1 );
+#endif
+
     /* load our keys and certificates if provided */
     if ( certfile ) {
         if ( SSL_CTX_use_certificate_chain_file( ctx, certfile ) != 1 ) {
@@ -413,7 +438,7 @@ irods::error ssl_socket_read(
 
             // =-=-=-=-=-=-=-
             // do a time out managed select of the socket fd
-            if ( SSL_pending( _ssl ) == 0 && NULL != _time_value ) {
+            if ( !SSL_HAS_PENDING( _ssl ) && NULL != _time_value ) {
                 int status = select( _socket + 1, &set, NULL, NULL, &timeout );
                 if ( status == 0 ) {
                     // =-=-=-=-=-=-=-
@@ -1049,57 +1074,65 @@ irods::error ssl_send_rods_msg(
             }
 
             // =-=-=-=-=-=-=-
-            // send the header
-            irods::network_object_ptr net_obj = boost::dynamic_pointer_cast< irods::network_object >( _ctx.fco() );
-            ret = writeMsgHeader( net_obj, &msg_header );
-            if ( ( result = ASSERT_PASS( ret, "Write message header failed." ) ).ok() ) {
+            // pack the header, the header is XML unless the message itself
+            // uses BINARY_PROT
+            const irodsProt_t header_protocol = BINARY_PROT == _protocol ? BINARY_PROT : XML_PROT;
+            bytesBuf_t* header_buf = nullptr;
+            int status = pack_struct( &msg_header, &header_buf, "MsgHeader_PI", RodsPackTable, 0, header_protocol, nullptr );
+            if ( ( result = ASSERT_ERROR( status >= 0 && header_buf, status, "Pack message header failed." ) ).ok() ) {
+                std::unique_ptr<bytesBuf_t, decltype( &freeBBuf )> header_guard{ header_buf, freeBBuf };
+
+                if ( XML_PROT == header_protocol &&
+                        getRodsLogLevel() >= LOG_DEBUG8 ) {
+                    printf( "sending header: len = %d\n%.*s\n", header_buf->len, header_buf->len, ( const char * ) header_buf->buf );
+                }
 
                 // =-=-=-=-=-=-=-
-                // send the message buffer
-                int bytes_written = 0;
-                if ( NULL != _msg_buf &&
-                        msg_header.msgLen > 0 ) {
-                    if ( XML_PROT == _protocol &&
-                            getRodsLogLevel() >= LOG_DEBUG8 ) {
-                        printf( "sending msg: \n%s\n", ( const char* ) _msg_buf->buf );
-                    }
-                    ret = ssl_socket_write( _msg_buf->buf, _msg_buf->len, bytes_written, ssl_obj->ssl() );
-                    result = ASSERT_PASS( ret, "Failed writing SSL message to socket." );
-                } // if msgLen > 0
+                // coalesce the header length, header, message, error and
+                // small stream buffers so that the message is sent with a
+                // single SSL_write and, typically, a single TLS record
+                const bool coalesce_stream = msg_header.bsLen <= MAX_COALESCED_STREAM_SIZE;
 
-                if ( result.ok() ) {
+                int header_length = htonl( header_buf->len );
 
-                    // =-=-=-=-=-=-=-
-                    // send the error buffer
-                    if ( NULL != _error_buf &&
-                            msg_header.errorLen > 0 ) {
+                std::vector<char> send_buf;
+                send_buf.reserve( sizeof( header_length ) + header_buf->len + msg_header.msgLen +
+                                  msg_header.errorLen + ( coalesce_stream ? msg_header.bsLen : 0 ) );
+
+                const auto append = [&send_buf]( const void* _buf, int _len ) {
+                    const char* p = static_cast<const char*>( _buf );
+                    send_buf.insert( send_buf.end(), p, p + _len );
+                };
+
+                append( &header_length, sizeof( header_length ) );
+                append( header_buf->buf, header_buf->len );
+
+                // =-=-=-=-=-=-=-
+                // the order of the buffers on the wire is message, error, stream
+                for ( const bytesBuf_t* b : { _msg_buf, _error_buf, coalesce_stream ? _stream_bbuf : nullptr } ) {
+                    if ( NULL != b && b->len > 0 ) {
                         if ( XML_PROT == _protocol &&
                                 getRodsLogLevel() >= LOG_DEBUG8 ) {
-                            printf( "sending msg: \n%s\n", ( const char* ) _error_buf->buf );
-
+                            printf( "sending msg: \n%.*s\n", b->len, ( const char* ) b->buf );
                         }
 
-                        ret = ssl_socket_write( _error_buf->buf, _error_buf->len, bytes_written, ssl_obj->ssl() );
-                        result = ASSERT_PASS( ret, "Failed writing SSL message to socket." );
-                    } // if errorLen > 0
-
-                    if ( result.ok() ) {
+                        append( b->buf, b->len );
+                    }
+                }
 
-                        // =-=-=-=-=-=-=-
-                        // send the stream buffer
-                        if ( NULL != _stream_bbuf &&
-                                msg_header.bsLen > 0 ) {
-                            if ( XML_PROT == _protocol &&
-                                    getRodsLogLevel() >= LOG_DEBUG8 ) {
-                                printf( "sending msg: \n%s\n", ( const char* ) _stream_bbuf->buf );
-                            }
+                int bytes_written = 0;
+                ret = ssl_socket_write( send_buf.data(), send_buf.size(), bytes_written, ssl_obj->ssl() );
+                result = ASSERT_PASS( ret, "Failed writing SSL message to socket." );
 
-                            ret = ssl_socket_write( _stream_bbuf->buf, _stream_bbuf->len, bytes_written, ssl_obj->ssl() );
-                            result = ASSERT_PASS( ret, "Failed writing SSL message to socket." );
+                // =-=-=-=-=-=-=-
+                // send a large stream buffer on its own
+                if ( result.ok() && !coalesce_stream &&
+                        NULL != _stream_bbuf &&
+                        msg_header.bsLen > 0 ) {
+                    ret = ssl_socket_write( _stream_bbuf->buf, _stream_bbuf->len, bytes_written, ssl_obj->ssl() );
+                    result = ASSERT_PASS( ret, "Failed writing SSL message to socket." );
 
-                        } // if bsLen > 0
-                    }
-                }
+                } // if bsLen > 0
             }
         }
     }
@@ -4,6 +4,8 @@
 #include "msParam.h"
 #include "rcConnect.h"
 #include "sockComm.h"
+#include "packStruct.h"
+#include "rcGlobalExtern.h"
 
 // =-=-=-=-=-=-=-
 #include "irods_network_plugin.hpp"
@@ -17,6 +19,11 @@
 #include <sstream>
 #include <string>
 #include <iostream>
+#include <algorithm>
+#include <memory>
+
+#include <sys/uio.h>
+#include <climits>
 
 // =-=-=-=-=-=-=-
 // local function to read a buffer from a socket
@@ -134,6 +141,143 @@ irods::error tcp_socket_write(
 
 } // tcp_socket_write
 
+// =-=-=-=-=-=-=-
+// local function to write a set of buffers to a socket with as few
+// system calls as possible.  the iovec array is consumed by the call.
+irods::error tcp_socket_writev(
+    int           _socket,
+    struct iovec* _iov,
+    int           _iov_count,
+    ssize_t&      _bytes_written ) {
+    // =-=-=-=-=-=-=-
+    // reset bytes written
+    _bytes_written = 0;
+
+    ssize_t len_to_write = 0;
+    for ( int i = 0; i < _iov_count; ++i ) {
+        len_to_write += _iov[ i ].iov_len;
+    }
+
+    const ssize_t length = len_to_write;
+
+    // =-=-=-=-=-=-=-
+    // loop while there is data to write, a short write leaves
+    // the remainder in the first unfinished iovec
+    while ( len_to_write > 0 ) {
+        ssize_t num_bytes = writev( _socket, _iov, std::min( _iov_count, IOV_MAX ) );
+        // =-=-=-=-=-=-=-
+        // error trapping the write
+        if ( num_bytes <= 0 ) {
+            // =-=-=-=-=-=-=-
+            // gracefully handle an interrupt
+            if ( errno == EINTR ) {
+                errno = 0;
+                continue;
+            }
+
+            return ERROR( SYS_SOCK_WRITE_ERR - errno,
+                          boost::format( "error writing to socket after [%d] of [%d] bytes" ) % _bytes_written % length );
+        }
+
+        len_to_write   -= num_bytes;
+        _bytes_written += num_bytes;
+
+        // =-=-=-=-=-=-=-
+        // skip the buffers which were written completely
+        while ( _iov_count > 0 && num_bytes >= static_cast<ssize_t>( _iov->iov_len ) ) {
+            num_bytes -= _iov->iov_len;
+            ++_iov;
+            --_iov_count;
+        }
+
+        if ( _iov_count > 0 ) {
+            _iov->iov_base  = static_cast<char*>( _iov->iov_base ) + num_bytes;
+            _iov->iov_len  -= num_bytes;
+        }
+    }
+
+    return SUCCESS();
+
+} // tcp_socket_writev
+
+// =-=-=-=-=-=-=-
+// local function to read a set of buffers from a socket, filling each
+// buffer in order.  the iovec array is consumed by the call.
+irods::error tcp_socket_readv(
+    int             _socket,
+    struct iovec*   _iov,
+    int             _iov_count,
+    ssize_t&        _bytes_read,
+    struct timeval* _time_value ) {
+    // =-=-=-=-=-=-=-
+    // Initialize the file descriptor set
+    fd_set set;
+    FD_ZERO( &set );
+    FD_SET( _socket, &set );
+
+    // =-=-=-=-=-=-=-
+    // local copy of time value?
+    struct timeval timeout;
+    if ( _time_value != NULL ) {
+        timeout = ( *_time_value );
+    }
+
+    // =-=-=-=-=-=-=-
+    // reset bytes read
+    _bytes_read = 0;
+
+    ssize_t len_to_read = 0;
+    for ( int i = 0; i < _iov_count; ++i ) {
+        len_to_read += _iov[ i ].iov_len;
+    }
+
+    while ( len_to_read > 0 ) {
+        if ( nullptr != _time_value ) {
+            const int status = select( _socket + 1, &set, NULL, NULL, &timeout );
+            if ( status == 0 ) { // the select has timed out
+                return ERROR( SYS_SOCK_READ_TIMEDOUT, boost::format("socket timeout with [%d] bytes read") % _bytes_read);
+            } else if ( status < 0 ) {
+                if ( errno == EINTR ) {
+                    continue;
+                } else {
+                    return ERROR( SYS_SOCK_READ_ERR - errno, boost::format("error on select after [%d] bytes read") % _bytes_read);
+                }
+            } // else
+        } // if tv
+
+        ssize_t num_bytes = readv( _socket, _iov, std::min( _iov_count, IOV_MAX ) );
+        if ( num_bytes < 0 ) {
+            if ( EINTR == errno ) {
+                errno = 0;
+                continue;
+            }
+
+            return ERROR(SYS_SOCK_READ_ERR - errno, boost::format("error reading from socket after [%d] bytes read") % _bytes_read);
+        } else if ( num_bytes == 0 ) {
+            break;
+        }
+
+        len_to_read -= num_bytes;
+        _bytes_read += num_bytes;
+
+        // =-=-=-=-=-=-=-
+        // skip the buffers which were filled completely
+        while ( _iov_count > 0 && num_bytes >= static_cast<ssize_t>( _iov->iov_len ) ) {
+            num_bytes -= _iov->iov_len;
+            ++_iov;
+            --_iov_count;
+        }
+
+        if ( _iov_count > 0 ) {
+            _iov->iov_base  = static_cast<char*>( _iov->iov_base ) + num_bytes;
+            _iov->iov_len  -= num_bytes;
+        }
+    } // while
+
+    return SUCCESS();
+
+} // tcp_socket_readv
+
 // =-=-=-=-=-=-=-
 //
 irods::error tcp_start(
@@ -347,120 +491,66 @@ irods::error tcp_send_rods_msg(
     }
 
     // =-=-=-=-=-=-=-
-    // send the header
-    ret = writeMsgHeader(
-              tcp,
-              &msg_header );
-    if ( !ret.ok() ) {
-        return PASSMSG( "writeMsgHeader failed", ret );
+    // pack the header, the header is XML unless the message itself
+    // uses BINARY_PROT
+    const irodsProt_t header_protocol = BINARY_PROT == _protocol ? BINARY_PROT : XML_PROT;
+    bytesBuf_t* header_buf = nullptr;
+    int status = pack_struct( &msg_header, &header_buf, "MsgHeader_PI", RodsPackTable, 0, header_protocol, nullptr );
+    if ( status < 0 || !header_buf ) {
+        return ERROR( status, "packstruct error" );
     }
 
-    // =-=-=-=-=-=-=-
-    // send the message buffer
-    int bytes_written = 0;
-    if ( _msg_buf && _msg_buf->len > 0 ) {
-        if ( XML_PROT == _protocol &&
-                getRodsLogLevel() >= LOG_DEBUG8 ) {
-            printf( "sending msg: \n%.*s\n", _msg_buf->len, ( const char* ) _msg_buf->buf );
-        }
-        ret = tcp_socket_write(
-                  socket_handle,
-                  _msg_buf->buf,
-                  _msg_buf->len,
-                  bytes_written );
-        if ( !ret.ok() ) {
-            return PASS( ret );
-        }
+    std::unique_ptr<bytesBuf_t, decltype( &freeBBuf )> header_guard{ header_buf, freeBBuf };
 
-    } // if msgLen > 0
+    if ( XML_PROT == header_protocol &&
+            getRodsLogLevel() >= LOG_DEBUG8 ) {
+        printf( "sending header: len = %d\n%.*s\n",
+                header_buf->len,
+                header_buf->len,
+                ( const char * ) header_buf->buf );
+    }
 
     // =-=-=-=-=-=-=-
-    // send the error buffer
-    if ( _error_buf && _error_buf->len > 0 ) {
-        if ( XML_PROT == _protocol &&
-                getRodsLogLevel() >= LOG_DEBUG8 ) {
-            printf( "sending msg: \n%.*s\n", _error_buf->len, ( const char* ) _error_buf->buf );
-
-        }
+    // the header length, header, message, error and stream buffers
+    // are sent with a single writev so that small api calls fit in
+    // one system call and, typically, one packet
+    int header_length = htonl( header_buf->len );
 
-        ret = tcp_socket_write(
-                  socket_handle,
-                  _error_buf->buf,
-                  _error_buf->len,
-                  bytes_written );
-        if ( !ret.ok() ) {
-            return PASS( ret );
-        }
+    struct iovec iov[ 5 ];
+    int iov_count = 0;
 
-    } // if errorLen > 0
+    iov[ iov_count ].iov_base  = &header_length;
+    iov[ iov_count++ ].iov_len = sizeof( header_length );
+    iov[ iov_count ].iov_base  = header_buf->buf;
+    iov[ iov_count++ ].iov_len = header_buf->len;
 
     // =-=-=-=-=-=-=-
-    // send the stream buffer
-    if ( _stream_bbuf && _stream_bbuf->len > 0 ) {
-        if ( XML_PROT == _protocol &&
-                getRodsLogLevel() >= LOG_DEBUG8 ) {
-            printf( "sending msg: \n%.*s\n", _stream_bbuf->len, ( const char* ) _stream_bbuf->buf );
-        }
+    // the order of the buffers on the wire is message, error, stream
+    for ( const bytesBuf_t* b : { _msg_buf, _error_buf, _stream_bbuf } ) {
+        if ( b && b->len > 0 ) {
+            if ( XML_PROT == _protocol &&
+                    getRodsLogLevel() >= LOG_DEBUG8 ) {
+                printf( "sending msg: \n%.*s\n", b->len, ( const char* ) b->buf );
+            }
 
-        ret = tcp_socket_write(
-                  socket_handle,
-                  _stream_bbuf->buf,
-                  _stream_bbuf->len,
-                  bytes_written );
-        if ( !ret.ok() ) {
-            return PASS( ret );
+            iov[ iov_count ].iov_base  = b->buf;
+            iov[ iov_count++ ].iov_len = b->len;
         }
-
-    } // if bsLen > 0
-
-    return SUCCESS();
-
-} // tcp_send_rods_msg
-
-// =-=-=-=-=-=-=-
-// helper fcn to read a bytes buf
-irods::error read_bytes_buf(
-    int             _socket_handle,
-    int             _length,
-    bytesBuf_t*     _buffer,
-    irodsProt_t     _protocol,
-    struct timeval* _time_val ) {
-    // =-=-=-=-=-=-=-
-    // trap input buffer ptr
-    if ( !_buffer || !_buffer->buf ) {
-        return ERROR( SYS_READ_MSG_BODY_INPUT_ERR,
-                      "null buffer ptr" );
-    }
-
-    int bytes_read = 0;
-
-    // read buffer
-    irods::error ret = tcp_socket_read(
-                           _socket_handle,
-                           _buffer->buf,
-                           _length,
-                           bytes_read,
-                           _time_val );
-    _buffer->len = bytes_read;
-
-    // log transaction if requested
-    if ( _protocol == XML_PROT ) {
-        rodsLog(LOG_DEBUG8, "received msg: \n%.*s\n", _buffer->len, ( char* )_buffer->buf );
-    }
-
-    if (!ret.ok()) {
-        free(_buffer->buf);
-        return PASS(ret);
     }
 
-    if (bytes_read != _length) {
-        free(_buffer->buf);
-        return ERROR(SYS_READ_MSG_BODY_LEN_ERR, boost::format("only read [%d] of [%d]") % bytes_read % _length);
+    ssize_t bytes_written = 0;
+    ret = tcp_socket_writev(
+              socket_handle,
+              iov,
+              iov_count,
+              bytes_written );
+    if ( !ret.ok() ) {
+        return PASS( ret );
     }
 
     return SUCCESS();
 
-} // read_bytes_buf
+} // tcp_send_rods_msg
 
 // =-=-=-=-=-=-=-
 // read a message body off of the socket
@@ -501,28 +591,25 @@ irods::error tcp_read_msg_body(
     }
 
     // =-=-=-=-=-=-=-
-    // reset error buf
+    // size the buffers, then read the whole body with a single readv
+    // instead of one read per buffer.  the buffers belong to the caller
+    // which releases them with free().
     // NOTE :: do not reset bs buf as it can be reused
     //         on the client side
-    if ( _error_buf ) {
-    }
+    struct iovec iov[ 3 ];
+    int iov_count = 0;
+    bytesBuf_t* targets[ 3 ] = {};
+    int lengths[ 3 ] = {};
 
     // =-=-=-=-=-=-=-
-    // read input buffer
+    // input buffer
     if ( 0 != _input_struct_buf ) {
         if ( _header->msgLen > 0 ) {
             _input_struct_buf->buf = malloc( _header->msgLen + 1 );
-
-            ret = read_bytes_buf(
-                      socket_handle,
-                      _header->msgLen,
-                      _input_struct_buf,
-                      _protocol,
-                      _time_val );
-            if ( !ret.ok() ) {
-                return PASS( ret );
-            }
-
+            targets[ iov_count ] = _input_struct_buf;
+            lengths[ iov_count ] = _header->msgLen;
+            iov[ iov_count ].iov_base  = _input_struct_buf->buf;
+            iov[ iov_count++ ].iov_len = _header->msgLen;
         }
         else {
             // =-=-=-=-=-=-=-
@@ -535,19 +622,14 @@ irods::error tcp_read_msg_body(
     } // input buffer
 
     // =-=-=-=-=-=-=-
-    // read error buffer
+    // error buffer
     if ( 0 != _error_buf ) {
         if ( _header->errorLen > 0 ) {
             _error_buf->buf = malloc( _header->errorLen + 1 );
-            ret = read_bytes_buf(
-                      socket_handle,
-                      _header->errorLen,
-                      _error_buf,
-                      _protocol,
-                      _time_val );
-            if ( !ret.ok() ) {
-                return PASS( ret );
-            }
+            targets[ iov_count ] = _error_buf;
+            lengths[ iov_count ] = _header->errorLen;
+            iov[ iov_count ].iov_base  = _error_buf->buf;
+            iov[ iov_count++ ].iov_len = _header->errorLen;
         }
         else {
             _error_buf->len = 0;
@@ -557,7 +639,7 @@ irods::error tcp_read_msg_body(
     } // error buffer
 
     // =-=-=-=-=-=-=-
-    // read bs buffer
+    // bs buffer
     if ( 0 != _bs_buf ) {
         if ( _header->bsLen > 0 ) {
             // do not repave bs buf as it can be
@@ -572,15 +654,10 @@ irods::error tcp_read_msg_body(
 
             }
 
-            ret = read_bytes_buf(
-                      socket_handle,
-                      _header->bsLen,
-                      _bs_buf,
-                      _protocol,
-                      _time_val );
-            if ( !ret.ok() ) {
-                return PASS( ret );
-            }
+            targets[ iov_count ] = _bs_buf;
+            lengths[ iov_count ] = _header->bsLen;
+            iov[ iov_count ].iov_base  = _bs_buf->buf;
+            iov[ iov_count++ ].iov_len = _header->bsLen;
         }
         else {
             _bs_buf->len = 0;
@@ -589,6 +666,53 @@ irods::error tcp_read_msg_body(
 
     } // bs buffer
 
+    if ( 0 == iov_count ) {
+        return SUCCESS();
+    }
+
+    ssize_t expected = 0;
+    for ( int i = 0; i < iov_count; ++i ) {
+        expected += lengths[ i ];
+    }
+
+    ssize_t bytes_read = 0;
+    ret = tcp_socket_readv(
+              socket_handle,
+              iov,
+              iov_count,
+              bytes_read,
+              _time_val );
+
+    // =-=-=-=-=-=-=-
+    // distribute the bytes read over the buffers
+    ssize_t remaining = bytes_read;
+    for ( int i = 0; i < iov_count; ++i ) {
+        targets[ i ]->len = static_cast<int>( std::min<ssize_t>( remaining, lengths[ i ] ) );
+        remaining -= targets[ i ]->len;
+
+        // log transaction if requested
+        if ( _protocol == XML_PROT ) {
+            rodsLog(LOG_DEBUG8, "received msg: \n%.*s\n", targets[ i ]->len, ( char* )targets[ i ]->buf );
+        }
+    }
+
+    if ( !ret.ok() || bytes_read != expected ) {
+        // =-=-=-=-=-=-=-
+        // release what was allocated for the caller, matching the
+        // behavior of a failed read of a single buffer
+        for ( int i = 0; i < iov_count; ++i ) {
+            free( targets[ i ]->buf );
+            targets[ i ]->buf = nullptr;
+            targets[ i ]->len = 0;
+        }
+
+        if ( !ret.ok() ) {
+            return PASS( ret );
+        }
+
+        return ERROR(SYS_READ_MSG_BODY_LEN_ERR, boost::format("only read [%d] of [%d]") % bytes_read % expected);
+    }
+
     return SUCCESS();
 
 } // tcp_read_msg_body
@@ -5,6 +5,17 @@ import logging
 import re
 import time
 
+def index_exists(irods_config, cursor, index_name):
+    if irods_config.catalog_database_type == 'oracle':
+        sql = "select count(*) from user_indexes where index_name = ?;"
+        index_name = index_name.upper()
+    elif irods_config.catalog_database_type == 'mysql':
+        sql = "select count(*) from information_schema.statistics where table_schema = database() and index_name = ?;"
+    else:
+        sql = "select count(*) from pg_indexes where indexname = ?;"
+    rows = database_connect.execute_sql_statement(cursor, sql, index_name).fetchall()
+    return int(rows[0][0]) > 0
+
 def run_update(irods_config, cursor):
     l = logging.getLogger(__name__)
     new_schema_version = database_connect.get_schema_version_in_database(cursor) + 1
@@ -101,6 +112,15 @@ def run_update(irods_config, cursor):
             # TEXT has no upper limit on the number of bytes it can hold.
             database_connect.execute_sql_statement(cursor, "alter table R_RULE_EXEC add column exe_context text;")
 
+    elif new_schema_version == 9:
+        # Incremental quota accounting adds to the (user, resource) rows of R_QUOTA_USAGE in
+        # place, which requires at most one row per pair. The table only holds derived values
+        # and is rebuilt by the next usage calculation (e.g. iadmin cu).
+        # Catalogs created by this version already have the index.
+        if not index_exists(irods_config, cursor, 'idx_quota_usage1'):
+            database_connect.execute_sql_statement(cursor, "delete from R_QUOTA_USAGE;")
+            database_connect.execute_sql_statement(cursor, "create unique index idx_quota_usage1 on R_QUOTA_USAGE (user_id, resc_id);")
+
     else:
         raise IrodsError('Upgrade to schema version %d is unsupported.' % (new_schema_version))
 
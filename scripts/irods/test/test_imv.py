@@ -54,3 +54,39 @@ class Test_Imv(session.make_sessions_mixin([('otherrods', 'rods')], []), unittes
         self.assertTrue('-814000 CAT_UNKNOWN_COLLECTION' in stderr)
         self.assertTrue(ec != 0)
 
+
+    @unittest.skipIf(test.settings.RUN_IN_TOPOLOGY, "Skip for Topology Testing")
+    def test_imv_moves_vault_directory_of_renamed_collection(self):
+        local_dir = os.path.join(self.admin.local_session_dir, 'vault_dir_rename')
+        lib.create_directory_of_small_files(os.path.join(local_dir, 'subcoll'), 50)
+        lib.make_file(os.path.join(local_dir, 'top'), 10, 'arbitrary')
+
+        src = os.path.join(self.admin.session_collection, 'vault_dir_rename_src')
+        dst = os.path.join(self.admin.session_collection, 'vault_dir_rename_dst')
+        self.admin.assert_icommand(['iput', '-r', local_dir, src])
+
+        # A registered file must keep its physical path.
+        registered_file = os.path.join(self.admin.local_session_dir, 'registered')
+        lib.make_file(registered_file, 10, 'arbitrary')
+        self.admin.assert_icommand(['ireg', registered_file, os.path.join(src, 'registered')])
+
+        self.admin.assert_icommand(['imv', src, dst])
+
+        old_vault_dir = os.path.join(self.admin.get_vault_session_path(), 'vault_dir_rename_src')
+        new_vault_dir = os.path.join(self.admin.get_vault_session_path(), 'vault_dir_rename_dst')
+        self.assertFalse(os.path.exists(os.path.join(old_vault_dir, 'top')))
+        self.assertEqual(len(os.listdir(os.path.join(new_vault_dir, 'subcoll'))), 50)
+
+        _, out, _ = self.admin.run_icommand(['iquest', '%s/%s %s', "select COLL_NAME, DATA_NAME, DATA_PATH where COLL_NAME like '{0}%'".format(dst)])
+        rows = [line.split(' ', 1) for line in out.splitlines() if line]
+        self.assertEqual(len(rows), 52)
+
+        for logical_path, physical_path in rows:
+            if logical_path.endswith('/registered'):
+                self.assertEqual(physical_path, registered_file)
+            else:
+                self.assertEqual(physical_path, os.path.join(new_vault_dir, os.path.relpath(logical_path, dst)))
+                self.assertTrue(os.path.exists(physical_path))
+
+        self.admin.assert_icommand(['irm', '-r', dst])
+        self.assertTrue(os.path.exists(registered_file))
@@ -2,6 +2,7 @@ from __future__ import print_function
 import os
 import sys
 import tempfile
+import threading
 
 if sys.version_info < (2, 7):
     import unittest2 as unittest
@@ -469,6 +470,73 @@ class Test_Iput(session.make_sessions_mixin(rodsadmins, rodsusers), unittest.Tes
         self.assertEqual(len(err), 0)
         self.assertEqual(len(checksum.strip()), 0)
 
+    def test_small_put_of_new_data_object_registers_good_replica_with_checksum(self):
+        data_object = 'small_put_new_data_object'
+        local_file = os.path.join(self.admin.local_session_dir, 'small_put.txt')
+        local_file_copy = local_file + '.copy'
+        lib.make_file(local_file, 4096, 'arbitrary')
+
+        self.admin.assert_icommand(['iput', '-K', local_file, data_object])
+
+        gql = "select DATA_REPL_STATUS, DATA_SIZE, DATA_CHECKSUM where COLL_NAME = '{0}' and DATA_NAME = '{1}'"
+        out, err, ec = self.admin.run_icommand(['iquest', '%s %s %s', gql.format(self.admin.session_collection, data_object)])
+        self.assertEqual(ec, 0)
+        self.assertEqual(len(err), 0)
+
+        repl_status, size, checksum = out.split()
+        self.assertEqual(repl_status, '1')
+        self.assertEqual(size, '4096')
+        self.assertEqual(checksum, 'sha2:' + lib.file_digest(local_file, 'sha256', encoding='base64'))
+
+        # The checksum calculated from the buffer matches the one calculated from storage.
+        self.admin.assert_icommand(['ichksum', '-K', data_object], 'STDOUT_SINGLELINE', checksum)
+
+        self.admin.assert_icommand(['iget', data_object, local_file_copy])
+        self.assertEqual(lib.file_digest(local_file, 'sha256'), lib.file_digest(local_file_copy, 'sha256'))
+
+        # A second put of the same data object is an overwrite and goes through the regular path.
+        self.admin.assert_icommand(['iput', local_file, data_object], 'STDERR_SINGLELINE', 'OVERWRITE_WITHOUT_FORCE_FLAG')
+        self.admin.assert_icommand(['iput', '-f', '-K', local_file, data_object])
+
+    def test_small_put_without_permission_does_not_write_to_storage(self):
+        data_object = 'small_put_without_permission'
+        local_file = os.path.join(self.user.local_session_dir, 'small_put.txt')
+        lib.make_file(local_file, 1024, 'arbitrary')
+
+        logical_path = os.path.join(self.admin.session_collection, data_object)
+        physical_path = os.path.join(self.admin.get_vault_session_path(), data_object)
+
+        self.user.assert_icommand(['iput', local_file, logical_path], 'STDERR_SINGLELINE', 'CAT_NO_ACCESS_PERMISSION')
+        self.admin.assert_icommand(['ils', logical_path], 'STDERR_SINGLELINE', 'does not exist')
+        self.assertFalse(os.path.exists(physical_path))
+
+    def test_concurrent_small_puts_leave_one_registered_file(self):
+        data_object = 'concurrent_small_puts'
+        logical_path = os.path.join(self.admin.session_collection, data_object)
+        physical_path = os.path.join(self.admin.get_vault_session_path(), data_object)
+
+        local_files = []
+        for i in range(4):
+            local_file = os.path.join(self.admin.local_session_dir, 'concurrent_small_put_{}.txt'.format(i))
+            lib.make_file(local_file, 1024 * (i + 1), 'arbitrary')
+            local_files.append(local_file)
+
+        threads = [threading.Thread(target=self.admin.run_icommand, args=(['iput', f, logical_path],)) for f in local_files]
+        for t in threads:
+            t.start()
+        for t in threads:
+            t.join()
+
+        # Exactly one put wins and its replica points at the file it wrote.
+        out, _, _ = self.admin.run_icommand(['iquest', '%s %s',
+            "select DATA_SIZE, DATA_PATH where COLL_NAME = '{}' and DATA_NAME = '{}'".format(self.admin.session_collection, data_object)])
+        rows = out.strip().splitlines()
+        self.assertEqual(1, len(rows))
+
+        size, registered_path = rows[0].split(' ', 1)
+        self.assertEqual(physical_path, registered_path)
+        self.assertEqual(int(size), os.path.getsize(registered_path))
+
 class test_iput_with_checksums(session.make_sessions_mixin(rodsadmins, rodsusers), unittest.TestCase):
 
     def setUp(self):
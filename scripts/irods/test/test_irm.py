@@ -1,4 +1,6 @@
 from __future__ import print_function
+import contextlib
+import json
 import os
 import sys
 
@@ -10,6 +12,30 @@ else:
 from . import session
 from .. import test
 from .. import lib
+from .. import paths
+from ..controller import IrodsController
+
+@contextlib.contextmanager
+def bulk_removal_enabled(threads=4):
+    server_config_filename = paths.server_config_path()
+
+    with open(server_config_filename) as f:
+        svr_cfg = json.load(f)
+    svr_cfg['advanced_settings']['number_of_concurrent_bulk_removal_threads'] = threads
+    new_server_config = json.dumps(svr_cfg, sort_keys=True, indent=4, separators=(',', ': '))
+
+    irodsctl = IrodsController()
+
+    try:
+        with lib.file_backed_up(server_config_filename):
+            with open(server_config_filename, 'w') as f:
+                f.write(new_server_config)
+
+            # Bounce server to apply setting
+            irodsctl.restart(test_mode=True)
+            yield
+    finally:
+        irodsctl.restart(test_mode=True)
 
 class Test_Irm(session.make_sessions_mixin([('otherrods', 'rods')], [('alice', 'apass')]), unittest.TestCase):
 
@@ -84,3 +110,64 @@ class Test_Irm(session.make_sessions_mixin([('otherrods', 'rods')], [('alice', '
         # non-existent data object.
         self.user.assert_icommand(['irm', '-f', data_object])
 
+
+    @unittest.skipIf(test.settings.RUN_IN_TOPOLOGY, "Skip for Topology Testing")
+    def test_irm_rf_removes_data_objects_spanning_several_pages(self):
+        # More data objects than fit on one page of the bulk removal (MAX_SQL_ROWS).
+        local_dir = os.path.join(self.user.local_session_dir, 'bulk_removal')
+        lib.create_directory_of_small_files(local_dir, 600)
+
+        collection = os.path.join(self.user.session_collection, 'bulk_removal')
+        self.user.assert_icommand(['iput', '-r', local_dir, collection])
+
+        vault_dir = os.path.join(self.user.get_vault_session_path(), 'bulk_removal')
+        self.assertEqual(len(os.listdir(vault_dir)), 600)
+
+        with bulk_removal_enabled():
+            self.user.assert_icommand(['irm', '-rf', collection])
+
+        self.user.assert_icommand(['ils', collection], 'STDERR', 'does not exist')
+        self.user.assert_icommand(['iquest', '%s', "select count(DATA_ID) where COLL_NAME = '{0}'".format(collection)],
+                                  'STDOUT_SINGLELINE', '0')
+        self.assertEqual(len(os.listdir(vault_dir)) if os.path.exists(vault_dir) else 0, 0)
+
+    @unittest.skipIf(test.settings.RUN_IN_TOPOLOGY, "Skip for Topology Testing")
+    def test_irm_rf_unregisters_data_objects_outside_of_the_vault(self):
+        collection = os.path.join(self.admin.session_collection, 'bulk_removal_with_registered_file')
+        self.admin.assert_icommand(['imkdir', collection])
+
+        for i in range(20):
+            filepath = os.path.join(self.admin.local_session_dir, 'put_{0}'.format(i))
+            lib.make_file(filepath, 10, 'arbitrary')
+            self.admin.assert_icommand(['iput', filepath, os.path.join(collection, 'put_{0}'.format(i))])
+
+        # A registered file must be left on disk.
+        registered_file = os.path.join(self.admin.local_session_dir, 'registered')
+        lib.make_file(registered_file, 10, 'arbitrary')
+        self.admin.assert_icommand(['ireg', registered_file, os.path.join(collection, 'registered')])
+
+        with bulk_removal_enabled():
+            self.admin.assert_icommand(['irm', '-rf', collection])
+
+        self.admin.assert_icommand(['ils', collection], 'STDERR', 'does not exist')
+        self.assertTrue(os.path.exists(registered_file))
+
+    @unittest.skipIf(test.settings.RUN_IN_TOPOLOGY, "Skip for Topology Testing")
+    def test_irm_rf_with_quote_in_collection_name_leaves_other_collections_alone(self):
+        sibling = os.path.join(self.user.session_collection, 'bulk_removal_sibling')
+        collection = os.path.join(self.user.session_collection, "bulk_removal' || '_sibling")
+
+        for c in [sibling, collection]:
+            self.user.assert_icommand(['imkdir', c])
+
+            for i in range(5):
+                filepath = os.path.join(self.user.local_session_dir, 'put_{0}'.format(i))
+                lib.make_file(filepath, 10, 'arbitrary')
+                self.user.assert_icommand(['iput', filepath, os.path.join(c, 'put_{0}'.format(i))])
+
+        with bulk_removal_enabled():
+            self.user.assert_icommand(['irm', '-rf', collection])
+
+        self.user.assert_icommand(['ils', collection], 'STDERR', 'does not exist')
+        self.user.assert_icommand(['iquest', '%s', "select count(DATA_ID) where COLL_NAME = '{0}'".format(sibling)],
+                                  'STDOUT_SINGLELINE', '5')
@@ -1,4 +1,5 @@
 import inspect
+import json
 import os
 import re
 import sys
@@ -14,6 +15,7 @@ from .. import lib
 from .. import paths
 from ..core_file import temporary_core_file
 from ..configuration import IrodsConfig
+from ..controller import IrodsController
 from .rule_texts_for_tests import rule_texts
 
 
@@ -87,3 +89,44 @@ class Test_Quotas(resource_suite.ResourceBase, unittest.TestCase):
         # Attempt to set user quota passing in the name of a group; should fail
         self.admin.assert_icommand(['iadmin', 'suq', 'test_group_3507', 'demoResc', '10000000'], 'STDERR_SINGLELINE', 'CAT_INVALID_USER')
 
+    def test_incremental_quota_accounting_tracks_usage_without_recalculation(self):
+        def over_quota():
+            out, _, _ = self.admin.run_icommand(['iquota', '-u', self.admin.username])
+            return int(re.search(r'Over:\s+(-?[\d,]+)', out).group(1).replace(',', ''))
+
+        filename = 'test_incremental_quota_accounting_tracks_usage_without_recalculation'
+        lib.make_file(filename, 1024, contents='arbitrary')
+
+        server_config_filename = paths.server_config_path()
+        with open(server_config_filename) as f:
+            svr_cfg = json.load(f)
+        svr_cfg['advanced_settings']['quota_accounting_mode'] = 'incremental'
+        new_server_config = json.dumps(svr_cfg, sort_keys=True, indent=4, separators=(',', ': '))
+
+        try:
+            with lib.file_backed_up(server_config_filename):
+                with open(server_config_filename, 'w') as f:
+                    f.write(new_server_config)
+
+                IrodsController().restart(test_mode=True)
+
+                self.admin.assert_icommand(['iadmin', 'suq', self.admin.username, 'demoResc', '10000000'])
+                self.admin.assert_icommand(['iadmin', 'cu'])
+                baseline = over_quota()
+
+                # Registering and removing the data object updates the usage
+                # immediately, without "iadmin cu".
+                self.admin.assert_icommand(['iput', '-R', 'demoResc', filename])
+                self.assertEqual(baseline + 1024, over_quota())
+
+                self.admin.assert_icommand(['irm', '-f', filename])
+                self.assertEqual(baseline, over_quota())
+
+                # The reconciliation agrees with the incremental values.
+                self.admin.assert_icommand(['iadmin', 'cu'])
+                self.assertEqual(baseline, over_quota())
+
+        finally:
+            self.admin.assert_icommand(['iadmin', 'suq', self.admin.username, 'demoResc', '0'])
+            os.remove(filename)
+            IrodsController().restart(test_mode=True)
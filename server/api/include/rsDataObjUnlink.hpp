@@ -8,5 +8,6 @@
 int rsDataObjUnlink( rsComm_t *rsComm, dataObjInp_t *dataObjUnlinkInp );
 int dataObjUnlinkS( rsComm_t *rsComm, dataObjInp_t *dataObjUnlinkInp, dataObjInfo_t *dataObjInfo );
 int l3Unlink( rsComm_t *rsComm, dataObjInfo_t *dataObjInfo );
+int chkPreProcDeleteRule( rsComm_t *rsComm, dataObjInp_t& dataObjUnlinkInp, dataObjInfo_t *dataObjInfoHead );
 
 #endif
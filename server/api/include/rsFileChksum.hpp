@@ -5,6 +5,8 @@
 
 #include "fileChksum.h"
 
+#include <string_view>
+
 struct RsComm;
 struct rodsServerHost;
 
@@ -33,5 +35,20 @@ int file_checksum(RsComm* _comm,
                   rodsLong_t _data_size,
                   char* _calculated_checksum);
 
+/// Calculates the checksum of \p _data exactly like file_checksum calculates the checksum of
+/// a replica in storage. Used when the bytes of a replica are already in memory.
+///
+/// \param[in]  _original_checksum   The checksum provided by the client. Selects the hash
+///                                  scheme. May be null.
+/// \param[in]  _data                The bytes to checksum.
+/// \param[out] _calculated_checksum A buffer of at least NAME_LEN bytes.
+///
+/// \return An integer.
+/// \retval 0        On success.
+/// \retval non-zero On failure.
+///
+/// \since 4.3.0
+int buffer_checksum(const char* _original_checksum, std::string_view _data, char* _calculated_checksum);
+
 #endif // RS_FILE_CHKSUM_HPP
 
@@ -7,11 +7,16 @@
 #include "rsRegDataObj.hpp"
 #include "rsModDataObjMeta.hpp"
 #include "replica_proxy.hpp"
+#include "fileDriver.hpp"
 
 #include "irods_stacktrace.hpp"
 #include "irods_file_object.hpp"
 #include "irods_configuration_keywords.hpp"
 
+#include "fmt/format.h"
+
+#include <vector>
+
 int
 rsBulkDataObjReg( rsComm_t *rsComm, genQueryOut_t *bulkDataObjRegInp,
                   genQueryOut_t **bulkDataObjRegOut ) {
@@ -161,7 +166,11 @@ int _rsBulkDataObjReg(
             return UNMATCHED_KEY_OR_INDEX;
         }
 
-        std::vector<std::pair<ir::replica_proxy_t, irods::experimental::lifetime_manager<DataObjInfo>>> result_info;
+        std::vector<dataObjInfo_t> data_obj_infos( bulkDataObjRegInp->rowCnt );
+
+        // The rows to register are collected and registered with a single
+        // database operation once every row has been read.
+        std::vector<int> rows_to_register;
 
         ( *bulkDataObjRegOut )->rowCnt = bulkDataObjRegInp->rowCnt;
         for (int i = 0; i < bulkDataObjRegInp->rowCnt; i++ ) {
@@ -174,9 +183,8 @@ int _rsBulkDataObjReg(
             tmpDataMode = &dataMode->value[dataMode->len * i];
             tmpOprType = &oprType->value[oprType->len * i];
             tmpReplNum =  &replNum->value[replNum->len * i];
-            tmpObjId = &objId->value[objId->len * i];
 
-            dataObjInfo_t dataObjInfo{};
+            dataObjInfo_t& dataObjInfo = data_obj_infos[i];
             dataObjInfo.flags = NO_COMMIT_FLAG;
             rstrcpy( dataObjInfo.objPath, tmpObjPath, MAX_NAME_LEN );
             rstrcpy( dataObjInfo.dataType, tmpDataType, NAME_LEN );
@@ -204,23 +212,64 @@ int _rsBulkDataObjReg(
 
             dataObjInfo.replStatus = GOOD_REPLICA;
             if ( strcmp( tmpOprType, REGISTER_OPR ) == 0 ) {
-                status = svrRegDataObj( rsComm, &dataObjInfo );
-            }
-            else {
-                status = modDataObjSizeMeta( rsComm, &dataObjInfo, tmpDataSize );
+                rows_to_register.push_back( i );
+                continue;
             }
 
+            status = modDataObjSizeMeta( rsComm, &dataObjInfo, tmpDataSize );
             if ( status < 0 ) {
                 rodsLog( LOG_ERROR,
-                         "rsBulkDataObjReg: RegDataObj or ModDataObj failed for %s,stat=%d",
+                         "rsBulkDataObjReg: ModDataObj failed for %s,stat=%d",
                          tmpObjPath, status );
                 chlRollback( rsComm );
                 freeGenQueryOut( bulkDataObjRegOut );
                 *bulkDataObjRegOut = NULL;
                 return status;
             }
+        }
+
+        if ( !rows_to_register.empty() ) {
+            std::vector<dataObjInfo_t> new_data_objects;
+            new_data_objects.reserve( rows_to_register.size() );
+            for ( auto i : rows_to_register ) {
+                new_data_objects.push_back( data_obj_infos[i] );
+            }
+
+            status = chlRegDataObjBulk( rsComm, new_data_objects );
+            if ( status < 0 ) {
+                rodsLog( LOG_ERROR,
+                         "rsBulkDataObjReg: chlRegDataObjBulk failed for %zu data objects,stat=%d",
+                         new_data_objects.size(), status );
+                chlRollback( rsComm );
+                freeGenQueryOut( bulkDataObjRegOut );
+                *bulkDataObjRegOut = NULL;
+                return status;
+            }
+
+            for ( std::size_t j = 0; j < rows_to_register.size(); ++j ) {
+                auto& dataObjInfo = data_obj_infos[rows_to_register[j]];
+                dataObjInfo = new_data_objects[j];
+
+                irods::file_object_ptr file_obj( new irods::file_object( rsComm, &dataObjInfo ) );
+                if ( const auto ret = fileRegistered( rsComm, file_obj ); !ret.ok() ) {
+                    irods::log( PASSMSG( fmt::format( "Failed to signal resource that the data object \"{}\" was registered",
+                                                      dataObjInfo.objPath ), ret ) );
+                    chlRollback( rsComm );
+                    freeGenQueryOut( bulkDataObjRegOut );
+                    *bulkDataObjRegOut = NULL;
+                    return ret.code();
+                }
+            }
+        }
+
+        std::vector<std::pair<ir::replica_proxy_t, irods::experimental::lifetime_manager<DataObjInfo>>> result_info;
+        result_info.reserve( data_obj_infos.size() );
+
+        for ( int i = 0; i < bulkDataObjRegInp->rowCnt; i++ ) {
+            tmpObjId = &objId->value[objId->len * i];
+            snprintf( tmpObjId, objId->len, "%lld", data_obj_infos[i].dataId );
 
-            result_info.push_back(ir::duplicate_replica(dataObjInfo));
+            result_info.push_back(ir::duplicate_replica(data_obj_infos[i]));
         }
 
         if (const auto ec = chlCommit(rsComm); ec < 0) {
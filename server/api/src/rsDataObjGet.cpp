@@ -27,6 +27,8 @@
 #include "key_value_proxy.hpp"
 #include "replica_proxy.hpp"
 
+#include <algorithm>
+
 namespace
 {
     namespace ir = irods::experimental::replica;
@@ -277,9 +279,11 @@ int rsDataObjGet(
         if (const auto single_buffer_size = irods::get_advanced_setting<const int>(irods::CFG_MAX_SIZE_FOR_SINGLE_BUFFER) * 1024 * 1024;
             replica_size <= single_buffer_size && UNKNOWN_FILE_SZ != replica_size)
         {
-            dataObjOutBBuf->buf = std::malloc(single_buffer_size);
-            std::memset(dataObjOutBBuf, 0, sizeof(single_buffer_size));
-            dataObjOutBBuf->len = single_buffer_size;
+            // Only allocate what the replica needs. Most single buffer transfers are far
+            // smaller than the maximum single buffer size.
+            const auto buffer_size = std::max<rodsLong_t>(replica_size, 1);
+            dataObjOutBBuf->buf = std::malloc(buffer_size);
+            dataObjOutBBuf->len = buffer_size;
 
             return single_buffer_get(*rsComm, fd, portalOprOut, dataObjOutBBuf);
         }
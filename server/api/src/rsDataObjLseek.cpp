@@ -10,6 +10,7 @@
 #include "rsSubStructFileLseek.hpp"
 #include "rsFileLseek.hpp"
 #include "irods_resource_backport.hpp"
+#include "read_ahead_buffer.hpp"
 
 #include <cstring>
 
@@ -45,6 +46,14 @@ int rsDataObjLseek(rsComm_t* rsComm,
         return SYS_FILE_DESC_OUT_OF_RANGE;
     }
 
+    // The position in storage is ahead of the client's position by the number of bytes
+    // read ahead but not returned yet. Relative seeks must account for them.
+    auto requested_offset = dataObjLseekInp->offset;
+
+    if (const auto unread = irods::read_ahead_buffer::discard(l1descInx); unread > 0 && SEEK_CUR == dataObjLseekInp->whence) {
+        requested_offset -= unread;
+    }
+
     auto* dataObjInfo = l1desc.dataObjInfo;
 
     // Extract the host location from the resource hierarchy.
@@ -74,8 +83,8 @@ int rsDataObjLseek(rsComm_t* rsComm,
     //
     // This code does not apply to objects that are related to special collections.
     const auto offset = (O_RDONLY == (l1desc.dataObjInp->openFlags & O_ACCMODE))
-        ? std::min(dataObjLseekInp->offset, dataObjInfo->dataSize)
-        : dataObjLseekInp->offset;
+        ? std::min(requested_offset, dataObjInfo->dataSize)
+        : requested_offset;
 
     *dataObjLseekOut = static_cast<fileLseekOut_t*>(malloc(sizeof(fileLseekOut_t)));
     std::memset(*dataObjLseekOut, 0, sizeof(fileLseekOut_t));
@@ -3,6 +3,7 @@
 #include "dataObjRepl.h"
 #include "dataObjUnlink.h"
 #include "dataPut.h"
+#include "fileDriver.hpp"
 #include "filePut.h"
 #include "getRemoteZoneResc.h"
 #include "icatHighLevelRoutines.hpp"
@@ -22,14 +23,17 @@
 #include "rsDataObjUnlink.hpp"
 #include "rsDataObjWrite.hpp"
 #include "rsDataPut.hpp"
+#include "rsFileChksum.hpp"
 #include "rsFilePut.hpp"
 #include "rsGlobalExtern.hpp"
+#include "rsL3FilePutSingleBuf.hpp"
 #include "rsRegDataObj.hpp"
 #include "rsSubStructFilePut.hpp"
 #include "rsUnregDataObj.hpp"
 #include "specColl.hpp"
 #include "subStructFilePut.h"
 #include "finalize_utilities.hpp"
+#include "catalog_utilities.hpp"
 #include "getRescQuota.h"
 #include "json_serialization.hpp"
 #include "modAVUMetadata.h"
@@ -40,6 +44,7 @@
 #include "rs_replica_close.hpp"
 #include "irods_at_scope_exit.hpp"
 #include "irods_exception.hpp"
+#include "irods_file_object.hpp"
 #include "irods_hierarchy_parser.hpp"
 #include "irods_logger.hpp"
 #include "irods_resource_backport.hpp"
@@ -244,6 +249,234 @@ namespace
         return 0;
     } // finalize_replica
 
+    auto replicate_and_apply_post_proc_for_write(RsComm& _comm, DataObjInp& _inp, BytesBuf& _bbuf) -> int
+    {
+        int status = 0;
+
+        if (getValByKey(&_inp.condInput, ALL_KW)) {
+            /* update the rest of copies */
+            transferStat_t *transStat{};
+            status = rsDataObjRepl(&_comm, &_inp, &transStat);
+            if (transStat) {
+                free(transStat);
+            }
+        }
+
+        if (status >= 0) {
+            status = applyRuleForPostProcForWrite(&_comm, &_bbuf, _inp.objPath);
+            if (status >= 0) {
+                status = 0;
+            }
+        }
+
+        return status;
+    } // replicate_and_apply_post_proc_for_write
+
+    // Returns whether the put can be served by small_data_object_put.
+    auto is_small_data_object_put(RsComm& _comm, DataObjInp& _inp, const irods::file_object& _file_obj) -> bool
+    {
+        // Overwrites must lock the data object and go through the regular open/close sequence.
+        if (!_file_obj.replicas().empty()) {
+            return false;
+        }
+
+        // Special collections have their own creation logic. Errors are reported by the
+        // regular path.
+        if (NO_SPEC_COLL != irods::get_special_collection_type_for_data_object(_comm, _inp)) {
+            return false;
+        }
+
+        // The replica is registered without a commit while the physical file is written, which
+        // requires the catalog connection of this agent.
+        try {
+            return irods::experimental::catalog::connected_to_catalog_provider(_comm);
+        }
+        catch (const irods::exception& e) {
+            irods::log(LOG_DEBUG, fmt::format("[{}:{}] - [{}]", __FUNCTION__, __LINE__, e.client_display_what()));
+            return false;
+        }
+    } // is_small_data_object_put
+
+    // Creates a brand new data object from the buffer sent by the client.
+    //
+    // The regular path registers an intermediate replica, opens, writes and closes the
+    // physical file, reads it back to calculate the checksum and finalizes the replica, which
+    // takes several catalog transactions. This path calculates the checksum from the buffer,
+    // registers the good replica without committing, writes the physical file with a single
+    // put and then commits. Concurrent creators of the same data object wait on the
+    // uncommitted registration, so only the one holding it ever writes to the physical path.
+    auto small_data_object_put(RsComm& _comm, DataObjInp& _inp, BytesBuf& _bbuf) -> int
+    {
+        _inp.openFlags = O_CREAT | O_WRONLY | O_TRUNC;
+
+        auto cond_input = irods::experimental::make_key_value_proxy(_inp.condInput);
+        cond_input[OPEN_TYPE_KW] = std::to_string(CREATE_TYPE);
+
+        // Ownership of the replica is transferred to the L1 descriptor.
+        auto [new_replica, lm] = ir::make_replica_proxy();
+        initDataObjInfoWithInp(new_replica.get(), &_inp);
+        new_replica.resource(irods::hierarchy_parser{new_replica.hierarchy().data()}.first_resc());
+        new_replica.replica_status(GOOD_REPLICA);
+        new_replica.size(_bbuf.len);
+
+        const int fd = irods::populate_L1desc_with_inp(_inp, *lm.release(), _bbuf.len);
+        const irods::at_scope_exit free_fd{[fd] { freeL1desc(fd); }};
+
+        auto& l1desc = L1desc[fd];
+        auto replica = ir::make_replica_proxy(*l1desc.dataObjInfo);
+
+        if (const int ec = getFilePathName(&_comm, replica.get(), l1desc.dataObjInp); ec < 0) {
+            irods::log(LOG_ERROR, fmt::format(
+                "[{}:{}] - failed to get file path name "
+                "[error_code=[{}], path=[{}], hierarchy=[{}]]",
+                __FUNCTION__, __LINE__, ec, replica.logical_path(), replica.hierarchy()));
+
+            return ec;
+        }
+
+        int status = 0;
+
+        if (REG_CHKSUM == l1desc.chksumFlag || VERIFY_CHKSUM == l1desc.chksumFlag) {
+            char checksum[NAME_LEN]{};
+            const char* original_checksum = std::strlen(l1desc.chksum) > 0 ? l1desc.chksum : nullptr;
+
+            if (const int ec = buffer_checksum(original_checksum, {static_cast<const char*>(_bbuf.buf), static_cast<std::size_t>(_bbuf.len)}, checksum); ec < 0) {
+                return ec;
+            }
+
+            replica.checksum(checksum);
+
+            // Same outcome as the regular path: a stale replica holding the calculated checksum.
+            if (VERIFY_CHKSUM == l1desc.chksumFlag && replica.checksum() != l1desc.chksum) {
+                irods::log(LOG_ERROR, fmt::format("[{}:{}] Mismatch checksum for {}.inp={}, compute {}",
+                           __FUNCTION__, __LINE__, replica.logical_path(), l1desc.chksum, replica.checksum()));
+
+                replica.replica_status(STALE_REPLICA);
+                status = USER_CHKSUM_MISMATCH;
+            }
+        }
+
+        // The registration stays uncommitted until the physical file is in place. Nothing has
+        // been written yet if it fails.
+        replica.get()->flags |= NO_COMMIT_FLAG;
+
+        if (const int ec = chlRegDataObj(&_comm, replica.get()); ec < 0) {
+            irods::log(LOG_ERROR, fmt::format(
+                "[{}:{}] - failed to register replica "
+                "[error_code=[{}], path=[{}], hierarchy=[{}]]",
+                __FUNCTION__, __LINE__, ec, replica.logical_path(), replica.hierarchy()));
+
+            chlRollback(&_comm);
+
+            return ec;
+        }
+
+        const std::string registered_physical_path{replica.physical_path()};
+
+        // Creates, writes and closes the physical file with one call to the resource server.
+        if (const int bytes_written = l3FilePutSingleBuf(&_comm, fd, &_bbuf); bytes_written != _bbuf.len) {
+            const int ec = bytes_written < 0 ? bytes_written : SYS_COPY_LEN_ERR;
+
+            irods::log(LOG_ERROR, fmt::format(
+                "[{}:{}] - failed to write replica "
+                "[error_code=[{}], path=[{}], hierarchy=[{}]]",
+                __FUNCTION__, __LINE__, ec, replica.logical_path(), replica.hierarchy()));
+
+            // A short write created the file at the path this agent holds the registration for.
+            if (bytes_written >= 0 && replica.physical_path() == registered_physical_path) {
+                l3Unlink(&_comm, replica.get());
+            }
+
+            chlRollback(&_comm);
+
+            return ec;
+        }
+
+        // The resource or the resolution of an existing file may have moved the replica to
+        // another physical path.
+        if (replica.physical_path() != registered_physical_path) {
+            keyValPair_t reg_param{};
+            const irods::at_scope_exit clear_reg_param{[&reg_param] { clearKeyVal(&reg_param); }};
+            addKeyVal(&reg_param, FILE_PATH_KW, replica.physical_path().data());
+
+            if (const int ec = chlModDataObjMeta(&_comm, replica.get(), &reg_param); ec < 0) {
+                irods::log(LOG_ERROR, fmt::format(
+                    "[{}:{}] - failed to update physical path of replica, leaving orphan file "
+                    "[error_code=[{}], path=[{}], physical path=[{}]]",
+                    __FUNCTION__, __LINE__, ec, replica.logical_path(), replica.physical_path()));
+
+                chlRollback(&_comm);
+
+                return ec;
+            }
+        }
+
+        if (const int ec = chlCommit(&_comm); ec < 0) {
+            irods::log(LOG_ERROR, fmt::format(
+                "[{}:{}] - failed to commit registration of replica, leaving orphan file "
+                "[error_code=[{}], path=[{}], physical path=[{}]]",
+                __FUNCTION__, __LINE__, ec, replica.logical_path(), replica.physical_path()));
+
+            chlRollback(&_comm);
+
+            return ec;
+        }
+
+        replica.get()->flags &= ~NO_COMMIT_FLAG;
+
+        // Same notification as a registration through svrRegDataObj.
+        {
+            irods::file_object_ptr file_obj{new irods::file_object{&_comm, replica.get()}};
+
+            if (const auto ret = fileRegistered(&_comm, file_obj); !ret.ok()) {
+                irods::log(PASSMSG(fmt::format("[{}:{}] - failed to signal resource that the data object was registered "
+                                               "[path=[{}], hierarchy=[{}]]",
+                                               __FUNCTION__, __LINE__, replica.logical_path(), replica.hierarchy()), ret));
+                return ret.code();
+            }
+        }
+
+        // Let the resource hierarchy react to the new replica (e.g. replication resources).
+        {
+            irods::file_object_ptr file_obj{new irods::file_object{&_comm, replica.get()}};
+
+            auto file_modified_input = irods::experimental::make_key_value_proxy(file_obj->cond_input());
+            file_modified_input[OPEN_TYPE_KW] = std::to_string(CREATE_TYPE);
+            file_modified_input[CHKSUM_KW] = replica.checksum();
+
+            if (const auto ret = fileModified(&_comm, file_obj); !ret.ok()) {
+                irods::log(PASSMSG(fmt::format("[{}:{}] - failed to signal resource that the data object was modified "
+                                               "[path=[{}], hierarchy=[{}]]",
+                                               __FUNCTION__, __LINE__, replica.logical_path(), replica.hierarchy()), ret));
+                return ret.code();
+            }
+        }
+
+        if (status < 0) {
+            return status;
+        }
+
+        try {
+            irods::apply_metadata_from_cond_input(_comm, *l1desc.dataObjInp);
+            irods::apply_acl_from_cond_input(_comm, *l1desc.dataObjInp);
+        }
+        catch (const irods::exception& e) {
+            irods::log(LOG_ERROR, fmt::format("[{}:{}] - [{}]", __FUNCTION__, __LINE__, e.client_display_what()));
+            return e.code();
+        }
+
+        /* update quota overrun */
+        updatequotaOverrun(replica.hierarchy().data(), replica.size(), ALL_QUOTA);
+
+        if (l1desc.purgeCacheFlag) {
+            irods::purge_cache(_comm, *replica.get());
+        }
+
+        apply_static_peps(_comm, l1desc, status);
+
+        return replicate_and_apply_post_proc_for_write(_comm, _inp, _bbuf);
+    } // small_data_object_put
+
     int single_buffer_put(RsComm& _comm, DataObjInp& _inp, BytesBuf& _bbuf)
     {
         _inp.openFlags = O_CREAT | O_RDWR | O_TRUNC;
@@ -382,23 +615,7 @@ namespace
             apply_static_peps(_comm, l1desc_cache, status);
         }
 
-        if (getValByKey(&_inp.condInput, ALL_KW)) {
-            /* update the rest of copies */
-            transferStat_t *transStat{};
-            status = rsDataObjRepl(&_comm, &_inp, &transStat);
-            if (transStat) {
-                free(transStat);
-            }
-        }
-
-        if (status >= 0) {
-            status = applyRuleForPostProcForWrite(&_comm, &_bbuf, _inp.objPath);
-            if (status >= 0) {
-                status = 0;
-            }
-        }
-
-        return status;
+        return replicate_and_apply_post_proc_for_write(_comm, _inp, _bbuf);
     } // single_buffer_put
 
     int parallel_transfer_put(RsComm *rsComm, DataObjInp *dataObjInp, portalOprOut **portalOprOut)
@@ -571,6 +788,8 @@ namespace
             return status;
         }
 
+        bool small_put = false;
+
         try {
             dataObjInfo_t* dataObjInfoHead{};
             irods::file_object_ptr file_obj(new irods::file_object());
@@ -600,6 +819,8 @@ namespace
                 !cond_input.contains(FORCE_FLAG_KW)) {
                 return OVERWRITE_WITHOUT_FORCE_FLAG;
             }
+
+            small_put = cond_input.contains(DATA_INCLUDED_KW) && is_small_data_object_put(*rsComm, *dataObjInp, *file_obj);
         }
         catch (const irods::exception& e) {
             irods::log(LOG_ERROR, fmt::format("[{}:{}] - [{}]", __FUNCTION__, __LINE__, e.client_display_what()));
@@ -614,6 +835,10 @@ namespace
         dataObjInp->openFlags = O_RDWR;
 
         try {
+            if (small_put) {
+                return small_data_object_put(*rsComm, *dataObjInp, *dataObjInpBBuf);
+            }
+
             if (getValByKey(&dataObjInp->condInput, DATA_INCLUDED_KW)) {
                 return single_buffer_put(*rsComm, *dataObjInp, *dataObjInpBBuf);
             }
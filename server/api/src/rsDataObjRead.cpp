@@ -13,8 +13,70 @@
 #include "irods_resource_backport.hpp"
 #include "irods_hierarchy_parser.hpp"
 #include "rsDataObjLseek.hpp"
+#include "read_ahead_buffer.hpp"
 
 #include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+    // Copies bytes read ahead for the descriptor into the client's buffer.
+    // Returns the number of bytes copied.
+    auto read_from_read_ahead_buffer(int _l1desc_index, int _length, bytesBuf_t& _bbuf) -> int
+    {
+        if (!irods::read_ahead_buffer::enabled() || _length <= 0) {
+            return 0;
+        }
+
+        if (!_bbuf.buf) {
+            _bbuf.buf = std::malloc(_length);
+        }
+
+        const auto bytes_read = irods::read_ahead_buffer::read(_l1desc_index, _bbuf.buf, _length);
+
+        if (bytes_read > 0) {
+            _bbuf.len = bytes_read;
+        }
+
+        return bytes_read;
+    } // read_from_read_ahead_buffer
+
+    // Reads from storage. If the descriptor is being read sequentially, a larger window is
+    // read into the read-ahead buffer and the client is served from it.
+    auto read_with_read_ahead(rsComm_t& _comm,
+                              int _l1desc_index,
+                              rodsLong_t _offset,
+                              rodsLong_t _data_size,
+                              int _length,
+                              bytesBuf_t& _bbuf) -> int
+    {
+        const auto window = std::min<rodsLong_t>(irods::read_ahead_buffer::window_size(_l1desc_index, _offset, _length),
+                                                 _data_size - _offset);
+
+        if (window <= _length) {
+            return l3Read(&_comm, _l1desc_index, _length, &_bbuf);
+        }
+
+        std::vector<char> data(window);
+
+        bytesBuf_t bbuf{};
+        bbuf.buf = data.data();
+        bbuf.len = static_cast<int>(window);
+
+        const auto bytes_read = l3Read(&_comm, _l1desc_index, static_cast<int>(window), &bbuf);
+
+        if (bytes_read <= 0) {
+            _bbuf.len = 0;
+            return bytes_read;
+        }
+
+        data.resize(bytes_read);
+        irods::read_ahead_buffer::fill(_l1desc_index, _offset, std::move(data));
+
+        return read_from_read_ahead_buffer(_l1desc_index, _length, _bbuf);
+    } // read_with_read_ahead
+} // anonymous namespace
 
 int
 applyRuleForPostProcForRead( rsComm_t *rsComm, bytesBuf_t *dataObjReadOutBBuf, char *objPath ) {
@@ -96,31 +158,62 @@ rsDataObjRead(rsComm_t* rsComm,
     // For all other modes, let the read operation do what it normally does.
     //
     // This code does not apply to objects that are related to special collections.
-    if (!dataObjInfo->specColl && O_RDONLY == (l1desc.dataObjInp->openFlags & O_ACCMODE)) {
-        OpenedDataObjInp input{};
-        input.l1descInx = l1descInx;
-        input.whence = SEEK_CUR;
+    //
+    // Sequential reads of replicas opened in read-only mode are also served from the
+    // descriptor's read-ahead buffer. Bytes are only read ahead up to the data size.
+    const bool read_only = !dataObjInfo->specColl && O_RDONLY == (l1desc.dataObjInp->openFlags & O_ACCMODE);
 
-        FileLseekOut* output{};
+    int bytes_read{};
 
-        if (const auto ec = rsDataObjLseek(rsComm, &input, &output); ec < 0) {
-            rodsLog(LOG_ERROR, "%s: Could not retrieve the current file read position.", __func__, ec);
-            return ec;
-        }
+    if (read_only) {
+        bytes_read = read_from_read_ahead_buffer(l1descInx, dataObjReadInp->len, *dataObjReadOutBBuf);
 
-        // If the file read position is greater than or equal to the data size,
-        // then return immediately.
-        if (output->offset >= dataObjInfo->dataSize) {
-            return 0;
-        }
+        // Fewer bytes may be buffered than were requested. The rest of the request is read from
+        // storage, where the replica is positioned right after the buffered bytes.
+        if (bytes_read < dataObjReadInp->len) {
+            // Ask storage directly. rsDataObjLseek would discard the read-ahead state.
+            const auto offset = _l3Lseek(rsComm, l1desc.l3descInx, 0, SEEK_CUR);
+
+            if (offset < 0) {
+                rodsLog(LOG_ERROR, "%s: Could not retrieve the current file read position [error_code=%lld].", __func__, offset);
+                return offset;
+            }
+
+            // If the file read position is greater than or equal to the data size,
+            // then return what was buffered.
+            if (offset >= dataObjInfo->dataSize) {
+                return bytes_read;
+            }
+
+            // At this point, we know the file read position is less than the replica's
+            // recorded data size. We now have to adjust the requested number of bytes to
+            // read so that the client does not read past the recorded data size.
+            const int length = std::min<rodsLong_t>(dataObjReadInp->len - bytes_read, dataObjInfo->dataSize - offset);
 
-        // At this point, we know the file read position is less than the replica's
-        // recorded data size. We now have to adjust the requested number of bytes to
-        // read so that the client does not read past the recorded data size.
-        dataObjReadInp->len = std::min<int>(dataObjReadInp->len, dataObjInfo->dataSize - output->offset);
+            if (0 == bytes_read) {
+                dataObjReadInp->len = length;
+                bytes_read = read_with_read_ahead(*rsComm, l1descInx, offset, dataObjInfo->dataSize, length, *dataObjReadOutBBuf);
+            }
+            else {
+                // The buffer holds at least the requested number of bytes.
+                bytesBuf_t rest{};
+                rest.buf = static_cast<char*>(dataObjReadOutBBuf->buf) + bytes_read;
+                rest.len = length;
+
+                // The buffered bytes are returned even if reading the rest fails. The error is
+                // reported by the next read.
+                if (const auto ec = read_with_read_ahead(*rsComm, l1descInx, offset, dataObjInfo->dataSize, length, rest); ec > 0) {
+                    bytes_read += ec;
+                }
+
+                dataObjReadOutBBuf->len = bytes_read;
+            }
+        }
+    }
+    else {
+        bytes_read = l3Read(rsComm, l1descInx, dataObjReadInp->len, dataObjReadOutBBuf);
     }
 
-    const auto bytes_read = l3Read(rsComm, l1descInx, dataObjReadInp->len, dataObjReadOutBBuf);
     const auto i = applyRuleForPostProcForRead(rsComm, dataObjReadOutBBuf, dataObjInfo->objPath);
     if (i < 0) {
         return i;
@@ -33,6 +33,7 @@
 #include "irods_hierarchy_parser.hpp"
 #include "irods_resource_redirect.hpp"
 #include "irods_configuration_keywords.hpp"
+#include "hierarchy_resolution_cache.hpp"
 #include "irods_re_structs.hpp"
 #include "irods_logger.hpp"
 #include "key_value_proxy.hpp"
@@ -262,7 +263,7 @@ namespace
                 freeAllDataObjInfo( dataObjInfoHead );
             }
             else {
-                status = syncCollPhyPath( rsComm, destDataObjInp->objPath );
+                status = syncRenamedCollPhyPath( rsComm, srcDataObjInp->objPath, destDataObjInp->objPath );
             }
 
             if ( status >= 0 ) {
@@ -434,6 +435,9 @@ int rsDataObjRename(rsComm_t *rsComm, dataObjCopyInp_t *dataObjRenameInp)
 {
     const auto ec = rsDataObjRename_impl(rsComm, dataObjRenameInp);
 
+    // Renaming a collection changes the logical path of every data object under it.
+    irods::hierarchy_resolution_cache::clear();
+
     // Update the mtime of the parent collections.
     if (ec == 0) {
         const auto src_parent_path = fs::path{dataObjRenameInp->srcDataObjInp.objPath}.parent_path();
@@ -106,6 +106,7 @@ namespace
 
         return totalRowCount;
     } // getNumSubfilesInBunfileObj
+} // anonymous namespace
 
 int chkPreProcDeleteRule(
     rsComm_t* rsComm,
@@ -151,6 +152,8 @@ int chkPreProcDeleteRule(
     return status;
 }
 
+namespace
+{
 int rsMvDataObjToTrash(
     rsComm_t *rsComm,
     dataObjInp_t& dataObjInp,
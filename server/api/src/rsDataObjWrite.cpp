@@ -12,6 +12,7 @@
 #include "rcGlobalExtern.h"
 #include "subStructFileRead.h"  /* XXXXX can be taken out when structFile api done */
 #include "rsDataObjWrite.hpp"
+#include "rsDataObjLseek.hpp"
 #include "rsSubStructFileWrite.hpp"
 #include "rsFileWrite.hpp"
 
@@ -20,6 +21,7 @@
 #include "irods_hierarchy_parser.hpp"
 #include "irods_file_object.hpp"
 #include "irods_resource_redirect.hpp"
+#include "read_ahead_buffer.hpp"
 
 
 int
@@ -127,6 +129,14 @@ int rsDataObjWrite(
             return ret.code();
         }
 
+        // Bytes read ahead may be stale after the write.
+        if ( const auto unread = irods::read_ahead_buffer::discard( l1descInx ); unread > 0 ) {
+            const auto ec = _l3Lseek( rsComm, L1desc[l1descInx].l3descInx, -unread, SEEK_CUR );
+            if ( ec < 0 ) {
+                return ec;
+            }
+        }
+
         dataObjWriteInp->len = dataObjWriteInpBBuf->len;
         bytesWritten = l3Write(
                            rsComm,
@@ -260,58 +260,72 @@ int fileChksum(rsComm_t* rsComm,
     return 0;
 } // fileChksum
 
-int file_checksum(RsComm* _comm,
-                  const char* _logical_path,
-                  const char* _filename,
-                  const char* _resource_hierarchy,
-                  const char* _original_checksum,
-                  rodsLong_t _data_size,
-                  char* _calculated_checksum)
+namespace
 {
-    // Capture server hashing settings.
-    std::string hash_scheme = irods::MD5_NAME;
-    try {
-        hash_scheme = irods::get_server_property<const std::string&>(irods::CFG_DEFAULT_HASH_SCHEME_KW);
-    }
-    catch (const irods::exception&) {}
+    // Initializes _hasher with the scheme used for checksums calculated by this server. The
+    // scheme of _original_checksum wins over the configured default, subject to the hash policy.
+    auto init_hasher(const char* _original_checksum, irods::Hasher& _hasher) -> int
+    {
+        // Capture server hashing settings.
+        std::string hash_scheme = irods::MD5_NAME;
+        try {
+            hash_scheme = irods::get_server_property<const std::string&>(irods::CFG_DEFAULT_HASH_SCHEME_KW);
+        }
+        catch (const irods::exception&) {}
 
-    // Make sure the read parameter is lowercased.
-    std::transform(hash_scheme.begin(), hash_scheme.end(), hash_scheme.begin(), ::tolower);
+        // Make sure the read parameter is lowercased.
+        std::transform(hash_scheme.begin(), hash_scheme.end(), hash_scheme.begin(), ::tolower);
 
-    std::string_view hash_policy;
-    try {
-        hash_policy = irods::get_server_property<const std::string&>(irods::CFG_MATCH_HASH_POLICY_KW);
-    }
-    catch (const irods::exception&) {}
+        std::string_view hash_policy;
+        try {
+            hash_policy = irods::get_server_property<const std::string&>(irods::CFG_MATCH_HASH_POLICY_KW);
+        }
+        catch (const irods::exception&) {}
 
-    // Extract scheme from checksum string.
-    std::string chkstr_scheme;
-    if (_original_checksum) {
-        irods::get_hash_scheme_from_checksum(_original_checksum, chkstr_scheme);
-    }
+        // Extract scheme from checksum string.
+        std::string chkstr_scheme;
+        if (_original_checksum) {
+            irods::get_hash_scheme_from_checksum(_original_checksum, chkstr_scheme);
+        }
 
-    // Check the hash scheme against the policy if necessary.
-    std::string_view final_scheme = hash_scheme;
-    if (!chkstr_scheme.empty()) {
-        if (!hash_policy.empty()) {
-            if (irods::STRICT_HASH_POLICY == hash_policy) {
-                if (hash_scheme != chkstr_scheme) {
-                    return USER_HASH_TYPE_MISMATCH;
+        // Check the hash scheme against the policy if necessary.
+        std::string_view final_scheme = hash_scheme;
+        if (!chkstr_scheme.empty()) {
+            if (!hash_policy.empty()) {
+                if (irods::STRICT_HASH_POLICY == hash_policy) {
+                    if (hash_scheme != chkstr_scheme) {
+                        return USER_HASH_TYPE_MISMATCH;
+                    }
                 }
             }
+
+            final_scheme = chkstr_scheme;
         }
 
-        final_scheme = chkstr_scheme;
-    }
+        rodsLog(LOG_DEBUG, "file_checksum :: final_scheme [%s]  chkstr_scheme [%s]  hash_policy [%s]",
+                final_scheme.data(), chkstr_scheme.c_str(), hash_policy.data());
+
+        // Create a hasher object and init given a scheme if it is unsupported then default to md5.
+        if (const auto error = irods::getHasher(final_scheme.data(), _hasher); !error.ok()) {
+            irods::log(PASS(error));
+            irods::getHasher(irods::MD5_NAME, _hasher);
+        }
 
-    rodsLog(LOG_DEBUG, "file_checksum :: final_scheme [%s]  chkstr_scheme [%s]  hash_policy [%s]",
-            final_scheme.data(), chkstr_scheme.c_str(), hash_policy.data());
+        return 0;
+    } // init_hasher
+} // anonymous namespace
 
-    // Create a hasher object and init given a scheme if it is unsupported then default to md5.
+int file_checksum(RsComm* _comm,
+                  const char* _logical_path,
+                  const char* _filename,
+                  const char* _resource_hierarchy,
+                  const char* _original_checksum,
+                  rodsLong_t _data_size,
+                  char* _calculated_checksum)
+{
     irods::Hasher hasher;
-    if (const auto error = irods::getHasher(final_scheme.data(), hasher); !error.ok()) {
-        irods::log(PASS(error));
-        irods::getHasher(irods::MD5_NAME, hasher);
+    if (const auto ec = init_hasher(_original_checksum, hasher); ec < 0) {
+        return ec;
     }
 
     irods::hierarchy_parser hp{_resource_hierarchy};
@@ -371,3 +385,19 @@ int file_checksum(RsComm* _comm,
     return 0;
 } // file_checksum
 
+int buffer_checksum(const char* _original_checksum, std::string_view _data, char* _calculated_checksum)
+{
+    irods::Hasher hasher;
+    if (const auto ec = init_hasher(_original_checksum, hasher); ec < 0) {
+        return ec;
+    }
+
+    hasher.update(std::string{_data});
+
+    std::string digest;
+    hasher.digest(digest);
+    strncpy(_calculated_checksum, digest.c_str(), NAME_LEN);
+
+    return 0;
+} // buffer_checksum
+
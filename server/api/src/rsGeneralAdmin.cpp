@@ -31,6 +31,7 @@
 #include "irods_at_scope_exit.hpp"
 #include "irods_hierarchy_parser.hpp"
 #include "irods_logger.hpp"
+#include "resource_tree_snapshot.hpp"
 
 using logger = irods::experimental::log;
 
@@ -40,6 +41,26 @@ using logger = irods::experimental::log;
 
 extern irods::resource_manager resc_mgr;
 
+namespace
+{
+    // Returns true if the request changes the rows of the resource table.
+    auto modifies_resource_table(const generalAdminInp_t& _input) -> bool
+    {
+        const std::string_view operation = _input.arg0 ? _input.arg0 : "";
+        const std::string_view target = _input.arg1 ? _input.arg1 : "";
+
+        if ("add" == operation || "rm" == operation) {
+            return "resource" == target || "childtoresc" == target || "childfromresc" == target;
+        }
+
+        if ("modify" == operation) {
+            return "resource" == target || "localzonename" == target;
+        }
+
+        return false;
+    } // modifies_resource_table
+} // anonymous namespace
+
 int _check_rebalance_timestamp_avu_on_resource(
     rsComm_t* _rsComm,
     const std::string& _resource_name) {
@@ -228,6 +249,10 @@ rsGeneralAdmin( rsComm_t *rsComm, generalAdminInp_t *generalAdminInp ) {
         rodsLog( LOG_NOTICE,
                  "rsGeneralAdmin: rcGeneralAdmin error %d", status );
     }
+    else if ( modifies_resource_table( *generalAdminInp ) ) {
+        // Agents started from now on must not load the previous resource table.
+        irods::experimental::resource_tree_snapshot::invalidate();
+    }
     return status;
 }
 
@@ -15,6 +15,7 @@
 #include "irods_configuration_keywords.hpp"
 #include "key_value_proxy.hpp"
 #include "replica_state_table.hpp"
+#include "hierarchy_resolution_cache.hpp"
 
 #include "boost/format.hpp"
 
@@ -70,6 +71,9 @@ rsModDataObjMeta( rsComm_t *rsComm, modDataObjMeta_t *modDataObjMetaInp ) {
         rmKeyVal(modDataObjMetaInp->regParam, IN_REPL_KW);
     }
 
+    // Previously resolved hierarchies may no longer reflect the catalog.
+    irods::hierarchy_resolution_cache::erase( dataObjInfo->objPath );
+
     if ( status >= 0 ) {
         const auto open_type = getValByKey(modDataObjMetaInp->regParam, OPEN_TYPE_KW);
         const auto in_repl = getValByKey(modDataObjMetaInp->regParam, IN_REPL_KW);
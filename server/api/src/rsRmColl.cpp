@@ -32,11 +32,16 @@
 #include "irods_configuration_keywords.hpp"
 #include "scoped_privileged_client.hpp"
 #include "irods_logger.hpp"
+#include "bulk_data_object_removal.hpp"
 
 #define IRODS_FILESYSTEM_ENABLE_SERVER_SIDE_API
 #include "filesystem.hpp"
 
 #include <chrono>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <string_view>
 
 namespace ix = irods::experimental;
 
@@ -121,6 +126,48 @@ namespace
 
         return status;
     }
+
+    // Bulk removal only physically removes data objects. Age limits, removal of empty
+    // bundles, unregistration and special collections are left to rsDataObjUnlink. Home
+    // collections are skipped because they must be rejected before anything is removed.
+    bool can_remove_data_objects_in_bulk( collInp_t* rmCollInp, dataObjInfo_t* dataObjInfo )
+    {
+        return rmCollInp->oprType != UNREG_OPR &&
+               getValByKey( &rmCollInp->condInput, AGE_KW ) == NULL &&
+               getValByKey( &rmCollInp->condInput, EMPTY_BUNDLE_ONLY_KW ) == NULL &&
+               !isHomeColl( rmCollInp->collName ) &&
+               ( dataObjInfo == NULL || dataObjInfo->specColl == NULL ) &&
+               irods::bulk_data_object_removal::thread_count() > 0;
+    }
+
+    int send_removal_progress( rsComm_t* rsComm,
+                               collOprStat_t** collOprStat,
+                               std::int64_t removedCnt,
+                               std::string_view lastObjPath )
+    {
+        if ( collOprStat == NULL ) {
+            return 0;
+        }
+
+        ( *collOprStat )->filesCnt += removedCnt;
+        if ( ( *collOprStat )->filesCnt < FILE_CNT_PER_STAT_OUT ) {
+            return 0;
+        }
+
+        rstrcpy( ( *collOprStat )->lastObjPath, std::string{lastObjPath}.c_str(), MAX_NAME_LEN );
+        const int status = svrSendCollOprStat( rsComm, *collOprStat );
+        if ( status < 0 ) {
+            rodsLogError( LOG_ERROR, status,
+                          "_rsPhyRmColl: svrSendCollOprStat failed for %s. status = %d",
+                          ( *collOprStat )->lastObjPath, status );
+            *collOprStat = NULL;
+            return status;
+        }
+        *collOprStat = ( collOprStat_t* )malloc( sizeof( collOprStat_t ) );
+        memset( *collOprStat, 0, sizeof( collOprStat_t ) );
+
+        return 0;
+    }
 } // anonymous namespace
 
 int rsRmColl(rsComm_t* rsComm,
@@ -354,8 +401,23 @@ _rsPhyRmColl( rsComm_t *rsComm, collInp_t *rmCollInp,
         addKeyVal( &dataObjInp.condInput, EMPTY_BUNDLE_ONLY_KW, "" );
     }
     // =-=-=-=-=-=-=-
+    // remove what can be removed in bulk. the loop below removes the rest.
+    std::map<std::string, int> refused;
+    bool progressFailed = false;
+    if ( can_remove_data_objects_in_bulk( rmCollInp, dataObjInfo ) ) {
+        const auto progress = [rsComm, collOprStat]( std::int64_t removedCnt, std::string_view lastObjPath ) {
+            return send_removal_progress( rsComm, collOprStat, removedCnt, lastObjPath );
+        };
+        status = irods::bulk_data_object_removal::remove_data_objects(
+                     *rsComm, rmCollInp->collName, dataObjInp, progress, refused );
+        if ( status < 0 ) {
+            savedStatus = status;
+            progressFailed = true;
+        }
+    }
+
     collEnt_t *collEnt = NULL;
-    while ( ( status = rsReadCollection( rsComm, &handleInx, &collEnt ) ) >= 0 ) {
+    while ( !progressFailed && ( status = rsReadCollection( rsComm, &handleInx, &collEnt ) ) >= 0 ) {
         if ( entCnt == 0 ) {
             entCnt ++;
             /* cannot rm non-empty home collection */
@@ -368,7 +430,10 @@ _rsPhyRmColl( rsComm_t *rsComm, collInp_t *rmCollInp,
             snprintf( dataObjInp.objPath, MAX_NAME_LEN, "%s/%s",
                       collEnt->collName, collEnt->dataName );
 
-            status = rsDataObjUnlink( rsComm, &dataObjInp );
+            /* the policy refused the bulk removal. don't apply it twice */
+            const auto refusedIter = refused.find( dataObjInp.objPath );
+            status = ( refusedIter != refused.end() ) ? refusedIter->second
+                                                      : rsDataObjUnlink( rsComm, &dataObjInp );
             if ( status < 0 ) {
                 rodsLog( LOG_ERROR,
                          "_rsPhyRmColl:rsDataObjUnlink failed for %s. stat = %d",
@@ -689,34 +754,38 @@ rsMvCollToTrash( rsComm_t *rsComm, collInp_t *rmCollInp ) {
             return UNMATCHED_KEY_OR_INDEX;
         }
 
-        snprintf( dataObjInfo.objPath, MAX_NAME_LEN, "%s/%s",
-                  subColl->value, dataObj->value );
-        rstrcpy( dataObjInfo.rescName, rescName->value, NAME_LEN );
+        for ( int i = 0; i < genQueryOut->rowCnt; i++ ) {
+            snprintf( dataObjInfo.objPath, MAX_NAME_LEN, "%s/%s",
+                      &subColl->value[subColl->len * i], &dataObj->value[dataObj->len * i] );
+            rstrcpy( dataObjInfo.rescName, &rescName->value[rescName->len * i], NAME_LEN );
 
-        initReiWithDataObjInp( &rei, rsComm, NULL );
-        rei.doi = &dataObjInfo;
+            initReiWithDataObjInp( &rei, rsComm, NULL );
+            rei.doi = &dataObjInfo;
 
-        // make resource properties available as rule session variables
-        irods::get_resc_properties_as_kvp(rei.doi->rescHier, rei.condInputData);
+            // make resource properties available as rule session variables
+            irods::get_resc_properties_as_kvp(rei.doi->rescHier, rei.condInputData);
 
-        status = applyRule( "acDataDeletePolicy", NULL, &rei, NO_SAVE_REI );
+            status = applyRule( "acDataDeletePolicy", NULL, &rei, NO_SAVE_REI );
 
-        clearKeyVal(rei.condInputData);
-        free(rei.condInputData);
+            clearKeyVal(rei.condInputData);
+            free(rei.condInputData);
 
-        if ( status < 0 && status != NO_MORE_RULES_ERR &&
-                status != SYS_DELETE_DISALLOWED ) {
-            rodsLog( LOG_NOTICE,
-                     "rsMvCollToTrash: acDataDeletePolicy error for %s. status = %d",
-                     dataObjInfo.objPath, status );
-            return status;
-        }
+            if ( status < 0 && status != NO_MORE_RULES_ERR &&
+                    status != SYS_DELETE_DISALLOWED ) {
+                rodsLog( LOG_NOTICE,
+                         "rsMvCollToTrash: acDataDeletePolicy error for %s. status = %d",
+                         dataObjInfo.objPath, status );
+                freeGenQueryOut( &genQueryOut );
+                return status;
+            }
 
-        if ( rei.status == SYS_DELETE_DISALLOWED ) {
-            rodsLog( LOG_NOTICE,
-                     "rsMvCollToTrash:disallowed for %s via DataDeletePolicy,status=%d",
-                     dataObjInfo.objPath, rei.status );
-            return rei.status;
+            if ( rei.status == SYS_DELETE_DISALLOWED ) {
+                rodsLog( LOG_NOTICE,
+                         "rsMvCollToTrash:disallowed for %s via DataDeletePolicy,status=%d",
+                         dataObjInfo.objPath, rei.status );
+                freeGenQueryOut( &genQueryOut );
+                return rei.status;
+            }
         }
 
         continueInx = genQueryOut->continueInx;
@@ -724,8 +793,11 @@ rsMvCollToTrash( rsComm_t *rsComm, collInp_t *rmCollInp ) {
         freeGenQueryOut( &genQueryOut );
 
         if ( continueInx > 0 ) {
-            /* More to come */
+            /* More to come. The permission is only checked by the first
+               query, which returns a single row, so the rest of the data
+               objects are read a full page at a time. */
             genQueryInp.continueInx = continueInx;
+            genQueryInp.maxRows = MAX_SQL_ROWS;
             status =  rsGenQuery( rsComm, &genQueryInp, &genQueryOut );
         }
         else {
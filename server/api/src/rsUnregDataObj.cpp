@@ -12,6 +12,7 @@
 #include "irods_file_object.hpp"
 #include "irods_stacktrace.hpp"
 #include "irods_configuration_keywords.hpp"
+#include "hierarchy_resolution_cache.hpp"
 
 int
 rsUnregDataObj( rsComm_t *rsComm, unregDataObj_t *unregDataObjInp ) {
@@ -51,6 +52,8 @@ rsUnregDataObj( rsComm_t *rsComm, unregDataObj_t *unregDataObjInp ) {
         status = rcUnregDataObj( rodsServerHost->conn, unregDataObjInp );
     }
 
+    irods::hierarchy_resolution_cache::erase( dataObjInfo->objPath );
+
     return status;
 }
 
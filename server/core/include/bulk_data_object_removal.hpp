@@ -0,0 +1,84 @@
+#ifndef IRODS_BULK_DATA_OBJECT_REMOVAL_HPP
+#define IRODS_BULK_DATA_OBJECT_REMOVAL_HPP
+
+#include "rcConnect.h"
+#include "dataObjInpOut.h"
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <string_view>
+
+/// \file
+
+/// \brief Removal of the data objects of a collection in pages.
+///
+/// \parblock
+/// The recursive removal of a collection used to unlink its data objects one at a time through
+/// rsDataObjUnlink, paying for a catalog query, a hierarchy resolution, a physical unlink, a catalog
+/// delete and a commit per data object.
+///
+/// This module removes the data objects directly under a collection in pages of up to MAX_SQL_ROWS
+/// replicas. The replicas of a page are read with one query, which only returns the data objects the
+/// client may delete. Their physical unlinks run concurrently on a thread pool, spread over the leaf
+/// resources of the page. Each thread unlinks through its own connection to the local server, so that
+/// resource policy never runs on more than one thread of an agent. Replicas on remote servers are
+/// unlinked by the calling thread. The replicas which were unlinked are then unregistered with one
+/// catalog operation and one commit.
+///
+/// acDataDeletePolicy and acPostProcForDelete are still applied to every data object, because policy may
+/// depend on the logical path.
+///
+/// \warning The catalog operation of a page is database_unreg_data_obj_bulk. Its policy
+/// (pep_database_unreg_data_obj_bulk_pre and _post) fires once per page. pep_database_unreg_data_obj_pre
+/// and _post do not fire for the data objects removed in bulk. Bulk removal is therefore disabled by
+/// default. Deployments which implement policy in those PEPs should keep it disabled.
+///
+/// Data objects this module does not handle are left in place for rsDataObjUnlink. These are data
+/// objects with a replica which is locked or intermediate, bundles, replicas on resources which are down,
+/// of the bundle class or outside of their vault, and data objects with a replica which failed to unlink.
+///
+/// Enabled by setting advanced_settings.number_of_concurrent_bulk_removal_threads in server_config.json
+/// to a value greater than zero. Only used on the catalog provider. The default is zero.
+/// \endparblock
+///
+/// \since 4.3.0
+namespace irods::bulk_data_object_removal
+{
+    /// \brief Called after every page with the number of data objects removed from the page and the
+    /// logical path of the last one. A negative return value stops the removal.
+    ///
+    /// \since 4.3.0
+    using progress_handler = std::function<int(std::int64_t, std::string_view)>;
+
+    /// \brief Returns the number of threads which unlink replicas concurrently, or zero if bulk removal
+    /// is disabled for this server.
+    ///
+    /// \since 4.3.0
+    auto thread_count() -> int;
+
+    /// \brief Removes the data objects directly under a collection which can be removed in bulk.
+    ///
+    /// \param[in]  _comm       The server communication object.
+    /// \param[in]  _collection The logical path of the collection.
+    /// \param[in]  _input      The input used for rsDataObjUnlink. Its condInput holds the keywords of the
+    ///                         removal (e.g. FORCE_FLAG_KW, ADMIN_KW, ADMIN_RMTRASH_KW). Its objPath is ignored.
+    /// \param[in]  _progress   The function called after every page.
+    /// \param[out] _refused    Receives the logical paths of the data objects whose removal was refused by
+    ///                         acDataDeletePolicy, mapped to the error code. These data objects must not be
+    ///                         passed to rsDataObjUnlink, which would apply the policy a second time.
+    ///
+    /// \return An integer.
+    /// \retval 0        On success, or if the remaining data objects must be removed one at a time.
+    /// \retval Negative The error returned by \p _progress.
+    ///
+    /// \since 4.3.0
+    auto remove_data_objects(RsComm& _comm,
+                             std::string_view _collection,
+                             const DataObjInp& _input,
+                             const progress_handler& _progress,
+                             std::map<std::string, int>& _refused) -> int;
+} // namespace irods::bulk_data_object_removal
+
+#endif // IRODS_BULK_DATA_OBJECT_REMOVAL_HPP
@@ -0,0 +1,143 @@
+#ifndef IRODS_CATALOG_PERMISSION_CACHE_HPP
+#define IRODS_CATALOG_PERMISSION_CACHE_HPP
+
+#include "rodsType.h"
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <set>
+#include <string>
+#include <string_view>
+
+/// \file
+
+/// \brief A per-agent cache of the permission checks made by the catalog plugin.
+///
+/// \parblock
+/// Every data object operation resolves the parent collection and checks the client's
+/// access to it (cmlCheckDir, cmlCheckDirAndGetInheritFlag), and ticket restrictions check
+/// the client's group memberships (cmlCheckUserInGroup). Agents serving many operations in
+/// the same collections repeat the same queries over and over. This cache remembers:
+/// - the collection id and inheritance flag of a collection, keyed by the collection, the
+///   user and the access level that was granted.
+/// - the set of groups a user is a member of.
+///
+/// Only successful checks are cached. Entries expire after the eviction age configured in
+/// server_config.json (advanced_settings.catalog_permission_cache.eviction_age_in_seconds).
+/// An eviction age of zero disables the cache.
+///
+/// Entries are invalidated when the agent:
+/// - renames, moves or removes a collection (the collection and everything under it).
+/// - modifies an access control list or the inheritance flag of a collection.
+/// - modifies a user or a group, or the membership of a group (every entry).
+///
+/// Changes made by other agents are only observed once the entries expire.
+/// \endparblock
+///
+/// \since 4.3.0
+namespace irods::catalog_permission_cache
+{
+    /// \brief Cache counters for the lifetime of the agent.
+    ///
+    /// \since 4.3.0
+    struct statistics
+    {
+        std::uint64_t hits;
+        std::uint64_t misses;
+        std::uint64_t invalidations;
+    }; // struct statistics
+
+    /// \brief The result of a successful collection permission check.
+    ///
+    /// \since 4.3.0
+    struct collection_permission
+    {
+        rodsLong_t collection_id;
+
+        /// Not set if the check that produced the entry did not fetch the flag.
+        std::optional<bool> inheritance;
+    }; // struct collection_permission
+
+    /// \brief Reads the eviction age from the server configuration and clears the cache.
+    ///
+    /// \since 4.3.0
+    auto init() -> void;
+
+    /// \brief Sets the eviction age and clears the cache.
+    ///
+    /// \param[in] _eviction_age The age after which entries expire. Zero disables the cache.
+    ///
+    /// \since 4.3.0
+    auto init(std::chrono::seconds _eviction_age) -> void;
+
+    /// \brief Clears the cache.
+    ///
+    /// \since 4.3.0
+    auto deinit() -> void;
+
+    /// \brief Returns whether the cache is enabled for this agent.
+    ///
+    /// \since 4.3.0
+    auto enabled() noexcept -> bool;
+
+    /// \brief Returns the cached permission check for the collection, if one exists.
+    ///
+    /// \param[in] _collection   The logical path of the collection.
+    /// \param[in] _user_name    The name of the user.
+    /// \param[in] _zone_name    The zone of the user.
+    /// \param[in] _access_level The access level that was checked (e.g. "modify object").
+    ///
+    /// \since 4.3.0
+    auto lookup_collection(std::string_view _collection,
+                           std::string_view _user_name,
+                           std::string_view _zone_name,
+                           std::string_view _access_level) -> std::optional<collection_permission>;
+
+    /// \brief Caches a successful permission check for the collection.
+    ///
+    /// An existing entry which holds the inheritance flag is not replaced by one which
+    /// does not.
+    ///
+    /// \since 4.3.0
+    auto insert_collection(std::string_view _collection,
+                           std::string_view _user_name,
+                           std::string_view _zone_name,
+                           std::string_view _access_level,
+                           const collection_permission& _permission) -> void;
+
+    /// \brief Returns the cached group memberships of the user, if they exist.
+    ///
+    /// \since 4.3.0
+    auto lookup_groups(std::string_view _user_name, std::string_view _zone_name)
+        -> std::optional<std::set<std::string>>;
+
+    /// \brief Caches the group memberships of the user.
+    ///
+    /// \since 4.3.0
+    auto insert_groups(std::string_view _user_name,
+                       std::string_view _zone_name,
+                       std::set<std::string> _groups) -> void;
+
+    /// \brief Removes every entry for the collection and the collections under it.
+    ///
+    /// \since 4.3.0
+    auto erase_collection(std::string_view _collection) -> void;
+
+    /// \brief Removes every collection entry.
+    ///
+    /// \since 4.3.0
+    auto clear_collections() -> void;
+
+    /// \brief Removes every entry.
+    ///
+    /// \since 4.3.0
+    auto clear() -> void;
+
+    /// \brief Returns the cache counters.
+    ///
+    /// \since 4.3.0
+    auto get_statistics() -> statistics;
+} // namespace irods::catalog_permission_cache
+
+#endif // IRODS_CATALOG_PERMISSION_CACHE_HPP
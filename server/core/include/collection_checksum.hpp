@@ -0,0 +1,137 @@
+#ifndef IRODS_COLLECTION_CHECKSUM_HPP
+#define IRODS_COLLECTION_CHECKSUM_HPP
+
+#include "rcConnect.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/// \file
+
+/// \brief Verification and computation of the checksums of every replica under a collection.
+///
+/// \parblock
+/// ichksum -r and the consistency checks of ifsck verify one data object at a time, each through a
+/// separate rcDataObjChksum.
+///
+/// A job reads the replicas of a collection and all of its sub-collections from the catalog and
+/// processes them in batches. The checksums of a batch are calculated concurrently, spread over the
+/// leaf resources of the replicas. Each leaf resource runs at most
+/// advanced_settings.number_of_concurrent_checksum_operations_per_resource checksums at once.
+/// The checksums are calculated by the servers hosting the replicas, including this one, over
+/// connections owned by the job. Resource plugins run policy, which must not run on several threads
+/// of one agent, so each concurrent checksum has a connection of its own. The checksums computed for
+/// replicas without one are registered with one transaction per batch.
+///
+/// Only used on the catalog provider.
+/// \endparblock
+///
+/// \since 4.3.0
+namespace irods::collection_checksum
+{
+    /// \brief Controls which replicas are checked and whether the catalog is updated.
+    ///
+    /// \since 4.3.0
+    struct options
+    {
+        // Only compares checksums. Nothing is written to the catalog.
+        bool verify_only = false;
+
+        // Computes and registers the checksum of replicas without one. Ignored if verify_only is set.
+        bool compute_missing = false;
+
+        // Includes stale replicas. Otherwise only good replicas are checked.
+        bool all_replicas = false;
+
+        // Skips permission checks. Requires a privileged client.
+        bool admin_mode = false;
+    }; // struct options
+
+    /// \brief Describes a replica whose checksum did not verify.
+    ///
+    /// \since 4.3.0
+    struct replica_result
+    {
+        std::string logical_path;
+        int replica_number = 0;
+        std::string resource_hierarchy;
+
+        // One of "mismatch", "missing", "computed" or "error".
+        std::string status;
+
+        std::string catalog_checksum;
+        std::string computed_checksum;
+        int error_code = 0;
+    }; // struct replica_result
+
+    /// \brief The number of replicas processed by a job so far.
+    ///
+    /// \since 4.3.0
+    struct progress
+    {
+        std::int64_t replicas = 0;
+        std::int64_t verified = 0;
+        std::int64_t computed = 0;
+        std::int64_t missing = 0;
+        std::int64_t mismatched = 0;
+        std::int64_t failed = 0;
+
+        // Replicas which are locked or intermediate.
+        std::int64_t skipped = 0;
+    }; // struct progress
+
+    /// \brief Returns the maximum number of checksums a job runs at once on a single leaf resource.
+    ///
+    /// Defaults to 2 if the setting is missing or invalid.
+    ///
+    /// \since 4.3.0
+    auto concurrency_per_resource() -> int;
+
+    /// \brief A checksum job over a collection.
+    ///
+    /// The job reads the catalog and writes to it through the server communication object it was
+    /// created with. It must not be used by more than one thread at a time.
+    ///
+    /// \since 4.3.0
+    class job
+    {
+    public:
+        /// \param[in] _comm       The server communication object.
+        /// \param[in] _collection The logical path of the collection. Must not contain single quotes.
+        /// \param[in] _options    The options of the job.
+        ///
+        /// \since 4.3.0
+        job(RsComm& _comm, std::string_view _collection, const options& _options);
+
+        job(const job&) = delete;
+        auto operator=(const job&) -> job& = delete;
+
+        ~job();
+
+        /// \brief Processes the next batch of replicas.
+        ///
+        /// \param[in]  _batch_size The maximum number of replicas read from the catalog.
+        /// \param[out] _results    Receives the replicas of the batch which did not verify.
+        ///
+        /// \return A boolean indicating whether replicas may remain.
+        ///
+        /// \throws irods::exception If the catalog cannot be read.
+        ///
+        /// \since 4.3.0
+        auto run(std::size_t _batch_size, std::vector<replica_result>& _results) -> bool;
+
+        /// \brief Returns the number of replicas processed so far.
+        ///
+        /// \since 4.3.0
+        auto totals() const noexcept -> const progress&;
+
+    private:
+        struct impl;
+        std::unique_ptr<impl> impl_;
+    }; // class job
+} // namespace irods::collection_checksum
+
+#endif // IRODS_COLLECTION_CHECKSUM_HPP
@@ -0,0 +1,148 @@
+#ifndef IRODS_DATA_OBJECT_FINALIZE_WRITER_HPP
+#define IRODS_DATA_OBJECT_FINALIZE_WRITER_HPP
+
+/// \file
+
+#include "json.hpp"
+#include "nanodbc/nanodbc.h"
+
+#include <cstdint>
+#include <string>
+#include <tuple>
+#include <vector>
+
+struct RsComm;
+
+/// Typed catalog writer behind the data_object_finalize API.
+///
+/// \parblock
+/// data_object_finalize receives the "before" and "after" states of every replica of a data
+/// object as JSON and writes the "after" states to the catalog atomically. This module holds the
+/// same states in the types of the R_DATA_MAIN columns. All replicas of a data object are written
+/// by one prepared statement over a fixed set of columns, executed once with an array of values
+/// per parameter.
+///
+/// Server code which already holds the replica states (e.g. the replica state table) calls
+/// finalize() directly instead of serializing the states for the API. The API plugin parses its
+/// JSON input into the same structures.
+/// \endparblock
+///
+/// \since 4.3.0
+namespace irods::experimental::catalog::data_object_finalize
+{
+    /// The columns of R_DATA_MAIN describing one replica.
+    ///
+    /// \since 4.3.0
+    struct replica_row
+    {
+        std::int64_t data_id = 0;
+        std::int64_t coll_id = 0;
+        std::string data_name;
+        int data_repl_num = 0;
+        std::string data_version;
+        std::string data_type_name;
+        std::int64_t data_size = 0;
+        std::string data_path;
+        std::string data_owner_name;
+        std::string data_owner_zone;
+        int data_is_dirty = 0;
+        std::string data_status;
+        std::string data_checksum;
+        std::string data_expiry_ts;
+        std::int64_t data_map_id = 0;
+        std::string data_mode;
+        std::string r_comment;
+        std::string create_ts;
+        std::string modify_ts;
+        std::int64_t resc_id = 0;
+    }; // struct replica_row
+
+    /// The states of one replica.
+    ///
+    /// The replica is identified by the data id and resource id of the "before" state. data_id,
+    /// coll_id and data_name of the "after" state are never written.
+    ///
+    /// \since 4.3.0
+    struct replica_update
+    {
+        replica_row before;
+        replica_row after;
+
+        // Key-value pairs for the fileModified resource operation. Null unless the
+        // replica triggers it.
+        nlohmann::json file_modified;
+    }; // struct replica_update
+
+    /// The input of finalize().
+    ///
+    /// \since 4.3.0
+    struct input
+    {
+        // Every replica of the data object.
+        std::vector<replica_update> replicas;
+
+        // Skips the permission and ticket checks. Requires a privileged client.
+        bool privileged = false;
+
+        // The number of bytes written, charged to the ticket of the session, if any.
+        std::int64_t bytes_written = 0;
+
+        // Invokes fileModified for the first replica holding key-value pairs for it.
+        bool trigger_file_modified = false;
+    }; // struct input
+
+    /// Converts the JSON representation of a replica used by data_object_finalize.
+    ///
+    /// \throws irods::exception If a mutable column is missing or a number cannot be parsed.
+    ///
+    /// \since 4.3.0
+    auto to_replica_row(const nlohmann::json& _columns) -> replica_row;
+
+    /// Returns the JSON representation of a replica used by data_object_finalize.
+    ///
+    /// \since 4.3.0
+    auto to_json(const replica_row& _row) -> nlohmann::json;
+
+    /// Converts the JSON input of data_object_finalize.
+    ///
+    /// \throws irods::exception If the input is not well formed.
+    ///
+    /// \since 4.3.0
+    auto to_input(const nlohmann::json& _input) -> input;
+
+    /// Returns the JSON input of data_object_finalize.
+    ///
+    /// \since 4.3.0
+    auto to_json(const input& _input) -> nlohmann::json;
+
+    /// Writes the "after" state of every replica and adjusts the quota usage.
+    ///
+    /// A "modify_ts" set to SET_TIME_TO_NOW_KW is replaced with the current time. Does not commit.
+    ///
+    /// \param[in]     _db_conn  The connection holding the transaction.
+    /// \param[in]     _db_type  The type of the database.
+    /// \param[in,out] _replicas The replicas of the data object.
+    ///
+    /// \throws irods::exception
+    /// \throws nanodbc::database_error
+    ///
+    /// \since 4.3.0
+    auto write_replicas(nanodbc::connection& _db_conn,
+                        const std::string& _db_type,
+                        std::vector<replica_update>& _replicas) -> void;
+
+    /// Sets the state of every replica of a data object in the catalog, atomically.
+    ///
+    /// Behaves as the data_object_finalize API: checks permissions, writes the replicas in one
+    /// transaction and invokes fileModified. Redirects to the catalog provider if necessary.
+    ///
+    /// \param[in]     _comm  The server communication object.
+    /// \param[in,out] _input The replicas of the data object.
+    ///
+    /// \return A tuple of the output of data_object_finalize and an error code.
+    ///
+    /// \since 4.3.0
+    auto finalize(RsComm& _comm, input& _input) -> std::tuple<nlohmann::json, int>;
+} // namespace irods::experimental::catalog::data_object_finalize
+
+#endif // IRODS_DATA_OBJECT_FINALIZE_WRITER_HPP
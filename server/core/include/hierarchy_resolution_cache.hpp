@@ -0,0 +1,131 @@
+#ifndef IRODS_HIERARCHY_RESOLUTION_CACHE_HPP
+#define IRODS_HIERARCHY_RESOLUTION_CACHE_HPP
+
+#include "irods_file_object.hpp"
+#include "objInfo.h"
+#include "rodsType.h"
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+
+/// \file
+
+struct RsComm;
+struct DataObjInp;
+
+/// \brief A per-agent cache of resolved resource hierarchies for read operations.
+///
+/// \parblock
+/// Resolving a hierarchy requires fetching every replica of the data object from the
+/// catalog and collecting a vote from each root resource. Clients that open the same
+/// data objects repeatedly pay that cost every time. This cache remembers the result of
+/// irods::resolve_resource_hierarchy for read-only opens of a data object, keyed by the
+/// logical path, the operation, the client and the full keyword set of the request.
+///
+/// Entries expire after the eviction age configured in server_config.json
+/// (advanced_settings.hierarchy_resolution_cache.eviction_age_in_seconds). An eviction
+/// age of zero disables the cache.
+///
+/// Entries are invalidated when:
+/// - the data object is opened for writing, created or unlinked by the agent.
+/// - the data object enters or leaves the replica state table.
+/// - the catalog information of the data object is modified by the agent.
+///
+/// Entries are never created for data objects that are in the replica state table.
+/// \endparblock
+///
+/// \since 4.3.0
+namespace irods::hierarchy_resolution_cache
+{
+    /// \brief Cache counters for the lifetime of the agent.
+    ///
+    /// \since 4.3.0
+    struct statistics
+    {
+        std::uint64_t hits;
+        std::uint64_t misses;
+        std::uint64_t invalidations;
+    }; // struct statistics
+
+    /// \brief Reads the eviction age from the server configuration and clears the cache.
+    ///
+    /// \since 4.3.0
+    auto init() -> void;
+
+    /// \brief Clears the cache.
+    ///
+    /// \since 4.3.0
+    auto deinit() -> void;
+
+    /// \brief Returns whether the cache is enabled for this agent.
+    ///
+    /// \since 4.3.0
+    auto enabled() noexcept -> bool;
+
+    /// \brief Returns whether a resolution for the operation and input may be cached.
+    ///
+    /// Only read-only opens of data objects are cacheable.
+    ///
+    /// \since 4.3.0
+    auto is_cacheable(std::string_view _operation, const DataObjInp& _input) -> bool;
+
+    /// \brief Returns a copy of the cached resolution for the request, if one exists.
+    ///
+    /// \param[in]  _comm          The agent connection.
+    /// \param[in]  _operation     The operation being resolved.
+    /// \param[in]  _input         The request.
+    /// \param[out] _data_obj_info If not null, receives a copy of the cached replica list.
+    ///                            The caller owns the list.
+    ///
+    /// \return The file object and the resolved hierarchy.
+    ///
+    /// \since 4.3.0
+    auto lookup(RsComm& _comm,
+                std::string_view _operation,
+                const DataObjInp& _input,
+                DataObjInfo** _data_obj_info)
+        -> std::optional<std::tuple<irods::file_object_ptr, std::string>>;
+
+    /// \brief Caches the resolution for the request.
+    ///
+    /// \param[in] _comm          The agent connection.
+    /// \param[in] _operation     The operation that was resolved.
+    /// \param[in] _input         The request.
+    /// \param[in] _file_obj      The file object produced by the resolution.
+    /// \param[in] _hierarchy     The resolved hierarchy.
+    /// \param[in] _data_obj_info The replica list produced by the resolution. May be null.
+    ///                           The cache stores its own copy.
+    ///
+    /// \since 4.3.0
+    auto insert(RsComm& _comm,
+                std::string_view _operation,
+                const DataObjInp& _input,
+                const irods::file_object_ptr& _file_obj,
+                const std::string& _hierarchy,
+                const DataObjInfo* _data_obj_info) -> void;
+
+    /// \brief Removes every entry for the logical path.
+    ///
+    /// \since 4.3.0
+    auto erase(std::string_view _logical_path) -> void;
+
+    /// \brief Removes every entry for the data object.
+    ///
+    /// \since 4.3.0
+    auto erase(rodsLong_t _data_id) -> void;
+
+    /// \brief Removes every entry.
+    ///
+    /// \since 4.3.0
+    auto clear() -> void;
+
+    /// \brief Returns the cache counters.
+    ///
+    /// \since 4.3.0
+    auto get_statistics() -> statistics;
+} // namespace irods::hierarchy_resolution_cache
+
+#endif // IRODS_HIERARCHY_RESOLUTION_CACHE_HPP
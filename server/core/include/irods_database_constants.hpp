@@ -18,8 +18,10 @@ namespace irods {
     const std::string DATABASE_OP_UPDATE_RESC_OBJ_COUNT( "database_update_resc_obj_count" );
     const std::string DATABASE_OP_MOD_DATA_OBJ_META( "database_mod_data_obj_meta" );
     const std::string DATABASE_OP_REG_DATA_OBJ( "database_reg_data_obj" );
+    const std::string DATABASE_OP_REG_DATA_OBJ_BULK( "database_reg_data_obj_bulk" );
     const std::string DATABASE_OP_REG_REPLICA( "database_reg_replica" );
     const std::string DATABASE_OP_UNREG_REPLICA( "database_unreg_replica" );
+    const std::string DATABASE_OP_UNREG_DATA_OBJ_BULK( "database_unreg_data_obj_bulk" );
     const std::string DATABASE_OP_REG_RULE_EXEC( "database_reg_rule_exec" );
     const std::string DATABASE_OP_MOD_RULE_EXEC( "database_mod_rule_exec" );
     const std::string DATABASE_OP_DEL_RULE_EXEC( "database_del_rule_exec" );
@@ -62,6 +64,7 @@ namespace irods {
 
     const std::string DATABASE_OP_RENAME_OBJECT( "database_rename_object" );
     const std::string DATABASE_OP_MOVE_OBJECT( "database_move_object" );
+    const std::string DATABASE_OP_MOVE_COLL_DATA_PATHS( "database_move_coll_data_paths" );
 
     const std::string DATABASE_OP_REG_TOKEN( "database_reg_token" );
     const std::string DATABASE_OP_DEL_TOKEN( "database_del_token" );
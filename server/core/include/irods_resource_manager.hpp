@@ -5,8 +5,12 @@
 #include "rods.h"
 #include "irods_resource_plugin.hpp"
 #include "irods_first_class_object.hpp"
+#include "resource_tree_snapshot.hpp"
 
 #include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace irods
 {
@@ -51,7 +55,8 @@ namespace irods
                                        std::string& );    // match vault path
 
             // =-=-=-=-=-=-=-
-            /// @brief  populate resource table from icat database
+            /// @brief  populate resource table from the resource tree snapshot
+            ///         or the icat database. plugins are loaded on first use.
             error init_from_catalog( rsComm_t* );
 
             // =-=-=-=-=-=-=-
@@ -185,6 +190,8 @@ namespace irods
                 // simple flag to state a resource matching the prop and value is found
                 bool found = false;
 
+                instantiate_all_resources();
+
                 // =-=-=-=-=-=-=-
                 // quick check on the resource table
                 if ( resource_name_map_.empty() ) {
@@ -243,10 +250,12 @@ namespace irods
             } // resolve_from_property
 
             typedef lookup_table< resource_ptr >::iterator iterator;
-            iterator begin() { return resource_name_map_.begin(); }
+            iterator begin() { instantiate_all_resources(); return resource_name_map_.begin(); }
             iterator end()   { return resource_name_map_.end();   }
 
         private:
+            using resource_record = irods::experimental::resource_tree_snapshot::resource_record;
+
             // =-=-=-=-=-=-=-
             /// @brief load a resource plugin from a dynamic shared object
             error load_resource_plugin(
@@ -256,22 +265,47 @@ namespace irods
                 const std::string);
 
             // =-=-=-=-=-=-=-
-            /// @brief take results from genQuery, extract values and create resources
-            error process_init_results( genQueryOut_t* );
+            /// @brief query the icat database for the rows of the resource table
+            error query_resource_records( rsComm_t*, std::vector< resource_record >& );
+
+            // =-=-=-=-=-=-=-
+            /// @brief take results from genQuery and extract the values of each row
+            error process_init_results( genQueryOut_t*, std::vector< resource_record >& );
+
+            // =-=-=-=-=-=-=-
+            /// @brief group the records by resource tree and defer their instantiation
+            void add_pending_resources( const std::vector< resource_record >& );
+
+            // =-=-=-=-=-=-=-
+            /// @brief load the plugin for a record and add the resource to the tables
+            error instantiate_resource( const resource_record& );
 
             // =-=-=-=-=-=-=-
-            /// @brief Initialize the child map from the resources lookup table
-            error init_child_map( void );
+            /// @brief instantiate, wire up and start every resource of a pending tree
+            error instantiate_tree( const std::string& ); // root resource name
+
+            // =-=-=-=-=-=-=-
+            /// @brief instantiate the tree holding the resource if it is pending
+            void instantiate_tree_for_resource( const std::string& );
+            void instantiate_tree_for_resource( rodsLong_t );
+
+            // =-=-=-=-=-=-=-
+            /// @brief instantiate every pending tree
+            void instantiate_all_resources( void );
+
+            // =-=-=-=-=-=-=-
+            /// @brief Initialize the child map for the given resources
+            error init_child_map( const std::vector< std::string >& );
 
             // =-=-=-=-=-=-=-
             /// @brief top level function to gather the post disconnect maintenance
-            //         operations from the resources, in breadth first order
-            error gather_operations( void );
+            //         operations from the given resources, in breadth first order
+            error gather_operations( const std::vector< std::string >& );
 
             // =-=-=-=-=-=-=-
-            /// @brief top level function to call the start operation on the resource
-            //         plugins
-            error start_resource_plugins( void );
+            /// @brief top level function to call the start operation on the given
+            //         resource plugins
+            error start_resource_plugins( const std::vector< std::string >& );
 
             // =-=-=-=-=-=-=-
             /// @brief lower level recursive call to gather the post disconnect
@@ -294,6 +328,13 @@ namespace irods
             lookup_table< resource_ptr, long, std::hash<long> > resource_id_map_;
             std::vector< std::vector< pdmo_type > > maintenance_operations_;
 
+            // =-=-=-=-=-=-=-
+            // Resources which have not been instantiated yet, grouped by the name of
+            // the root resource of their tree
+            std::unordered_map< std::string, std::vector< resource_record > > pending_trees_;
+            std::unordered_map< std::string, std::string >                    pending_root_by_name_;
+            std::unordered_map< rodsLong_t, std::string >                     pending_root_by_id_;
+
     }; // class resource_manager
 } // namespace irods
 
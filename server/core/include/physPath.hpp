@@ -83,6 +83,13 @@ int syncDataObjPhyPathS(RsComm *rsComm,
 
 int syncCollPhyPath(RsComm *rsComm, char *collection);
 
+// Like syncCollPhyPath, for a collection which was renamed from srcColl to
+// destColl. On the unixfilesystem resources using the graft path scheme, the
+// vault directory of the collection is renamed once and the physical paths of
+// its replicas are updated with one catalog statement, instead of renaming and
+// updating every replica. The catalog changes are not committed.
+int syncRenamedCollPhyPath(RsComm *rsComm, const char *srcColl, char *destColl);
+
 int isInVault(DataObjInfo *dataObjInfo);
 
 int initStructFileOprInp(RsComm *rsComm,
@@ -0,0 +1,68 @@
+#ifndef IRODS_QUOTA_USAGE_HPP
+#define IRODS_QUOTA_USAGE_HPP
+
+/// \file
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <string_view>
+#include <utility>
+
+/// Incremental maintenance of the quota usage table (R_QUOTA_USAGE).
+///
+/// \parblock
+/// By default, R_QUOTA_USAGE is only refreshed by chlCalcUsageAndQuota, which rebuilds
+/// the whole table from R_DATA_MAIN. When "quota_accounting_mode" is set to "incremental"
+/// in the advanced settings of server_config.json, every catalog operation which changes
+/// the size, owner or resource of a replica applies the difference to the matching
+/// (user, resource) row of R_QUOTA_USAGE and to the over-quota value of every quota which
+/// covers that row. chlCalcUsageAndQuota then only reconciles drift, one resource at a time.
+/// \endparblock
+///
+/// \since 4.3.0
+namespace irods::experimental::catalog::quota_usage
+{
+    /// Bytes held by each (user id, resource id) pair.
+    ///
+    /// \since 4.3.0
+    using usage_map = std::map<std::pair<std::int64_t, std::int64_t>, std::int64_t>;
+
+    /// Returns whether the server is configured for incremental quota accounting.
+    ///
+    /// \since 4.3.0
+    auto incremental() -> bool;
+
+    /// Returns the change in usage between two states of the catalog.
+    ///
+    /// Pairs whose usage did not change are omitted.
+    ///
+    /// \param[in] _before The usage before the catalog was modified.
+    /// \param[in] _after  The usage after the catalog was modified.
+    ///
+    /// \since 4.3.0
+    auto difference(const usage_map& _before, const usage_map& _after) -> usage_map;
+
+    /// Returns the statement which adds a delta to a row of R_QUOTA_USAGE, creating the
+    /// row if it does not exist.
+    ///
+    /// The statement takes four bind variables: the delta, the resource id, the user id and
+    /// the modification timestamp.
+    ///
+    /// \param[in] _db_type The name of the database plugin instance (e.g. "postgres").
+    ///
+    /// \since 4.3.0
+    auto usage_delta_statement(std::string_view _db_type) -> std::string;
+
+    /// Returns the statement which adds a delta to the over-quota value of every quota
+    /// covering a user's usage on a resource.
+    ///
+    /// These are the per-resource and total quotas of the user and of every group the user
+    /// is a member of. The statement takes five bind variables: the delta, the modification
+    /// timestamp, the resource id, the user id and the user id again.
+    ///
+    /// \since 4.3.0
+    auto over_quota_delta_statement() -> std::string;
+} // namespace irods::experimental::catalog::quota_usage
+
+#endif // IRODS_QUOTA_USAGE_HPP
@@ -0,0 +1,98 @@
+#ifndef IRODS_READ_AHEAD_BUFFER_HPP
+#define IRODS_READ_AHEAD_BUFFER_HPP
+
+#include "rodsType.h"
+
+#include <cstdint>
+#include <vector>
+
+/// \file
+
+/// \brief Per-agent read-ahead buffers for sequential reads of replicas.
+///
+/// \parblock
+/// rsDataObjRead maps every client read onto a read through the resource plugin stack.
+/// Clients that read sequentially with small buffers (e.g. FUSE, dstream) therefore pay for
+/// one storage round trip per request. When an L1 descriptor opened in read-only mode is read
+/// sequentially, rsDataObjRead reads a larger window from storage into the descriptor's buffer
+/// and serves the following requests from memory. The window starts at four times the size of
+/// the request and doubles on every refill, up to the maximum configured in server_config.json
+/// (advanced_settings.maximum_read_ahead_buffer_size_in_megabytes). A maximum of zero disables
+/// read-ahead.
+///
+/// A read is sequential if no seek or write was performed on the descriptor since the previous
+/// read. The buffer is discarded when the descriptor is seeked, written or freed.
+/// \endparblock
+///
+/// \since 4.3.0
+namespace irods::read_ahead_buffer
+{
+    /// \brief Read-ahead counters for the lifetime of the agent.
+    ///
+    /// \since 4.3.0
+    struct statistics
+    {
+        std::uint64_t hits;
+        std::uint64_t misses;
+        std::uint64_t fills;
+        std::uint64_t discards;
+    }; // struct statistics
+
+    /// \brief Reads the maximum buffer size from the server configuration and drops all buffers.
+    ///
+    /// \since 4.3.0
+    auto init() -> void;
+
+    /// \brief Drops all buffers.
+    ///
+    /// \since 4.3.0
+    auto deinit() -> void;
+
+    /// \brief Returns whether read-ahead is enabled for this agent.
+    ///
+    /// \since 4.3.0
+    auto enabled() noexcept -> bool;
+
+    /// \brief Copies buffered bytes for the descriptor into \p _buffer.
+    ///
+    /// \param[in]  _l1desc_index The L1 descriptor index.
+    /// \param[out] _buffer       The buffer which receives the bytes.
+    /// \param[in]  _length       The number of bytes requested.
+    ///
+    /// \return The number of bytes copied, which is zero if nothing is buffered.
+    ///
+    /// \since 4.3.0
+    auto read(int _l1desc_index, void* _buffer, int _length) -> int;
+
+    /// \brief Records a read which could not be served from memory and returns the number of
+    /// bytes which should be read from storage.
+    ///
+    /// \param[in] _l1desc_index The L1 descriptor index.
+    /// \param[in] _offset       The current position of the replica in storage.
+    /// \param[in] _length       The number of bytes requested.
+    ///
+    /// \return The read-ahead window, or \p _length if the read should not be buffered.
+    ///
+    /// \since 4.3.0
+    auto window_size(int _l1desc_index, rodsLong_t _offset, int _length) -> int;
+
+    /// \brief Stores bytes read from storage starting at \p _offset.
+    ///
+    /// \since 4.3.0
+    auto fill(int _l1desc_index, rodsLong_t _offset, std::vector<char>&& _data) -> void;
+
+    /// \brief Drops the buffer of the descriptor and resets sequential access detection.
+    ///
+    /// \return The number of buffered bytes which were not read yet. The position of the replica
+    /// in storage is ahead of the client's position by this amount.
+    ///
+    /// \since 4.3.0
+    auto discard(int _l1desc_index) -> rodsLong_t;
+
+    /// \brief Returns the read-ahead counters.
+    ///
+    /// \since 4.3.0
+    auto get_statistics() -> statistics;
+} // namespace irods::read_ahead_buffer
+
+#endif // IRODS_READ_AHEAD_BUFFER_HPP
@@ -27,6 +27,11 @@ struct RsComm;
 /// object was opened. The "after" state represents changes to the
 /// replica since being opened.
 ///
+/// Each entry is held as a list of typed replica records, so looking up and
+/// updating a replica does not involve parsing or searching JSON. The JSON
+/// form below is only produced when an entry is returned by one of the
+/// accessors or published to the catalog.
+///
 /// The JSON structure has the following form:
 /// \code{.js}
 /// {
@@ -457,6 +462,8 @@ namespace irods::replica_state_table
     /// \endcode
     /// \endparblock
     ///
+    /// \throws irods::exception If a key does not name a column of R_DATA_MAIN
+    ///
     /// \since 4.2.9
     auto update(
         const key_type& _key,
@@ -477,6 +484,8 @@ namespace irods::replica_state_table
     /// \endcode
     /// \endparblock
     ///
+    /// \throws irods::exception If a key does not name a column of R_DATA_MAIN
+    ///
     /// \since 4.2.9
     auto update(const key_type& _key,
                 const int _replica_number,
@@ -647,10 +656,13 @@ namespace irods::replica_state_table
 
         /// \brief Prepares the specified data object as input to data_object_finalize and updates the catalog
         ///
+        /// \p The replica states are passed to the typed catalog writer of data_object_finalize without
+        /// being serialized (see data_object_finalize_writer.hpp).
+        ///
         /// \param[in,out] _comm iRODS server comm struct
         /// \param[in] _ctx Context for publishing an RST entry (see #context for details)
         ///
-        /// \returns tuple with output string and error code returned by rs_data_object_finalize
+        /// \returns tuple with output and error code of data_object_finalize
         ///
         /// \throws irods::exception
         ///
@@ -0,0 +1,114 @@
+#ifndef IRODS_RESOURCE_TREE_SNAPSHOT_HPP
+#define IRODS_RESOURCE_TREE_SNAPSHOT_HPP
+
+/// \file
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/// A server-wide copy of the resource table (R_RESC_MAIN) held in shared memory.
+///
+/// \parblock
+/// Every agent needs the full resource table to initialize its resource manager. Without
+/// the snapshot, each agent queries the catalog for it. With the snapshot, only the first
+/// agent following a change to the resource table (or the expiration of the snapshot) pays
+/// for the query. Every other agent copies the rows out of shared memory.
+///
+/// The snapshot is invalidated by the admin APIs which modify resources on this server.
+/// Modifications made through other servers in the zone are picked up once the snapshot
+/// expires.
+/// \endparblock
+///
+/// \since 4.3.0
+namespace irods::experimental::resource_tree_snapshot
+{
+    /// The catalog information for a single resource.
+    ///
+    /// All members hold the string form of the corresponding R_RESC_MAIN column.
+    ///
+    /// \since 4.3.0
+    struct resource_record
+    {
+        std::string id;
+        std::string name;
+        std::string zone;
+        std::string type;
+        std::string class_name;
+        std::string location;
+        std::string vault_path;
+        std::string free_space;
+        std::string info;
+        std::string comments;
+        std::string create_time;
+        std::string modify_time;
+        std::string status;
+        std::string children;
+        std::string context;
+        std::string parent;
+        std::string parent_context;
+    }; // struct resource_record
+
+    /// Initializes the resource tree snapshot.
+    ///
+    /// This function should only be called on startup of the server.
+    ///
+    /// \param[in] _shm_name The name of the shared memory to create.
+    /// \param[in] _shm_size The size of the shared memory to allocate in bytes.
+    ///
+    /// \since 4.3.0
+    auto init(const std::string_view _shm_name = "irods_resource_tree_snapshot",
+              std::size_t _shm_size = 10'000'000) -> void;
+
+    /// Cleans up any resources created via init().
+    ///
+    /// This function must be called from the same process that called init().
+    ///
+    /// \since 4.3.0
+    auto deinit() noexcept -> void;
+
+    /// Returns the current generation of the snapshot.
+    ///
+    /// The generation is incremented every time the snapshot is invalidated. Callers that
+    /// build a new snapshot must capture the generation before querying the catalog and
+    /// pass it to store().
+    ///
+    /// \since 4.3.0
+    auto generation() -> std::uint64_t;
+
+    /// Replaces the contents of the snapshot.
+    ///
+    /// \param[in] _records       The rows of the resource table.
+    /// \param[in] _generation    The value returned by generation() before \p _records were
+    ///                           fetched from the catalog.
+    /// \param[in] _expires_after The number of seconds from the time of insertion before
+    ///                           the snapshot becomes invalid.
+    ///
+    /// \return A boolean value.
+    /// \retval true  If the snapshot was replaced.
+    /// \retval false If the snapshot was invalidated after \p _generation was captured, the
+    ///               snapshot does not fit in shared memory or init() was never called.
+    ///
+    /// \since 4.3.0
+    auto store(const std::vector<resource_record>& _records,
+               std::uint64_t _generation,
+               std::chrono::seconds _expires_after) -> bool;
+
+    /// Returns a copy of the rows held by the snapshot.
+    ///
+    /// \return An optional vector of resource records.
+    /// \retval std::nullopt If the snapshot is empty, expired or init() was never called.
+    ///
+    /// \since 4.3.0
+    auto load() -> std::optional<std::vector<resource_record>>;
+
+    /// Empties the snapshot and increments its generation.
+    ///
+    /// \since 4.3.0
+    auto invalidate() -> void;
+} // namespace irods::experimental::resource_tree_snapshot
+
+#endif // IRODS_RESOURCE_TREE_SNAPSHOT_HPP
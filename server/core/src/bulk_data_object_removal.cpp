@@ -0,0 +1,733 @@
+#include "bulk_data_object_removal.hpp"
+
+#include "fileDriver.hpp"
+#include "fileUnlink.h"
+#include "genQuery.h"
+#include "icatHighLevelRoutines.hpp"
+#include "irods_at_scope_exit.hpp"
+#include "irods_configuration_keywords.hpp"
+#include "irods_exception.hpp"
+#include "irods_file_object.hpp"
+#include "irods_hierarchy_parser.hpp"
+#include "irods_re_structs.hpp"
+#include "irods_resource_backport.hpp"
+#include "irods_resource_manager.hpp"
+#include "irods_server_properties.hpp"
+#include "hierarchy_resolution_cache.hpp"
+#include "miscServerFunct.hpp"
+#include "objInfo.h"
+#include "rcMisc.h"
+#include "rodsErrorTable.h"
+#include "rodsClient.h"
+#include "rodsConnect.h"
+#include "rodsLog.h"
+#include "rodsPath.h"
+#include "rsDataObjUnlink.hpp"
+#include "rsFileUnlink.hpp"
+#include "rsGenQuery.hpp"
+#include "rsGlobalExtern.hpp"
+#include "scoped_privileged_client.hpp"
+#include "thread_pool.hpp"
+
+#define IRODS_FILESYSTEM_ENABLE_SERVER_SIDE_API
+#include "filesystem.hpp"
+
+#include "fmt/format.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+    namespace fs = irods::experimental::filesystem;
+
+    // What is known about the leaf resource of a replica. The resource is resolved once per removal on
+    // the calling thread. This also instantiates its tree, which the thread pool must not do.
+    struct leaf_resource
+    {
+        bool eligible;
+        bool local;
+        std::string name;
+        std::string hierarchy;
+        std::string location;
+        rodsServerHost_t* host;
+
+        // Empty if the vault path of the replicas is not checked.
+        std::string vault_path;
+    }; // struct leaf_resource
+
+    struct page_entry
+    {
+        std::string logical_path;
+        std::vector<dataObjInfo_t> replicas;
+
+        // True if the data object has more replicas than fit on a page.
+        bool incomplete;
+
+        // The status of the physical unlink of each replica.
+        std::vector<int> statuses;
+    }; // struct page_entry
+
+    // Identifies one replica of a page.
+    struct replica_ref
+    {
+        std::size_t object;
+        std::size_t replica;
+    }; // struct replica_ref
+
+    auto resolve_leaf_resource(rodsLong_t _resc_id) -> leaf_resource
+    {
+        leaf_resource leaf{};
+
+        if (const auto err = resc_mgr.leaf_id_to_hier(_resc_id, leaf.hierarchy); !err.ok()) {
+            return leaf;
+        }
+
+        irods::resource_ptr resc;
+        if (const auto err = resc_mgr.resolve(_resc_id, resc); !err.ok()) {
+            return leaf;
+        }
+
+        std::string resc_class;
+        if (const auto err = irods::get_resource_property<std::string>(_resc_id, irods::RESOURCE_CLASS, resc_class);
+            !err.ok() || irods::RESOURCE_CLASS_BUNDLE == resc_class)
+        {
+            return leaf;
+        }
+
+        if (const auto err = irods::is_hier_live(leaf.hierarchy); !err.ok()) {
+            return leaf;
+        }
+
+        if (const auto err = irods::get_loc_for_hier_string(leaf.hierarchy, leaf.location); !err.ok()) {
+            return leaf;
+        }
+
+        int remote_flag{};
+        rodsServerHost_t* host{};
+        if (const auto err = irods::get_host_for_hier_string(leaf.hierarchy, remote_flag, host); !err.ok()) {
+            return leaf;
+        }
+
+        if (LOCAL_HOST != remote_flag && REMOTE_HOST != remote_flag) {
+            return leaf;
+        }
+
+        bool skip_vault_path_check = false;
+        if (const auto err = irods::get_resource_property<bool>(_resc_id,
+                                                                irods::RESOURCE_SKIP_VAULT_PATH_CHECK_ON_UNLINK,
+                                                                skip_vault_path_check);
+            !err.ok())
+        {
+            skip_vault_path_check = false;
+        }
+
+        if (!skip_vault_path_check) {
+            if (const auto err = irods::get_vault_path_for_hier_string(leaf.hierarchy, leaf.vault_path); !err.ok()) {
+                return leaf;
+            }
+        }
+
+        irods::hierarchy_parser parser;
+        parser.set_string(leaf.hierarchy);
+        parser.last_resc(leaf.name);
+
+        leaf.local = (LOCAL_HOST == remote_flag);
+        leaf.host = host;
+        leaf.eligible = true;
+
+        return leaf;
+    } // resolve_leaf_resource
+
+    // Reads the replicas of the next page, i.e. the replicas of the data objects under _collection
+    // whose data id is greater than _last_data_id, in order of data id.
+    //
+    // A data object is only returned if all of its replicas are part of the page. If the page is full,
+    // _more is set to true.
+    // Returns the id of the collection, or an error. The name is quoted in the condition, so names
+    // containing a quote are left for rsDataObjUnlink instead of being escaped.
+    auto resolve_collection_id(RsComm& _comm, std::string_view _collection, rodsLong_t& _coll_id) -> int
+    {
+        if (_collection.find('\'') != std::string_view::npos) {
+            return SYS_INVALID_INPUT_PARAM;
+        }
+
+        genQueryInp_t input{};
+        genQueryOut_t* output{};
+
+        irods::at_scope_exit free_query{[&input, &output] {
+            freeGenQueryOut(&output);
+            clearGenQueryInp(&input);
+        }};
+
+        addInxIval(&input.selectInp, COL_COLL_ID, 1);
+        addInxIval(&input.selectInp, COL_COLL_NAME, 1);
+
+        const auto coll_condition = fmt::format("= '{}'", _collection);
+        addInxVal(&input.sqlCondInp, COL_COLL_NAME, coll_condition.c_str());
+
+        addKeyVal(&input.condInput, ZONE_KW, std::string{_collection}.c_str());
+
+        input.maxRows = 1;
+
+        if (const auto ec = rsGenQuery(&_comm, &input, &output); ec < 0) {
+            return ec;
+        }
+
+        auto* coll_id = getSqlResultByInx(output, COL_COLL_ID);
+        auto* coll_name = getSqlResultByInx(output, COL_COLL_NAME);
+
+        if (!coll_id || !coll_name || output->rowCnt < 1) {
+            return UNMATCHED_KEY_OR_INDEX;
+        }
+
+        if (_collection != std::string_view{coll_name->value}) {
+            return CAT_NO_ROWS_FOUND;
+        }
+
+        _coll_id = std::strtoll(coll_id->value, nullptr, 10);
+
+        return 0;
+    } // resolve_collection_id
+
+    auto read_page(RsComm& _comm,
+                   std::string_view _collection,
+                   rodsLong_t _coll_id,
+                   bool _admin_mode,
+                   rodsLong_t _last_data_id,
+                   std::vector<page_entry>& _objects,
+                   bool& _more) -> int
+    {
+        _objects.clear();
+        _more = false;
+
+        genQueryInp_t input{};
+        genQueryOut_t* output{};
+
+        irods::at_scope_exit free_query{[&_comm, &input, &output] {
+            // Close the statement on the catalog if rows are left.
+            if (output && output->continueInx > 0) {
+                input.continueInx = output->continueInx;
+                input.maxRows = 0;
+                freeGenQueryOut(&output);
+                rsGenQuery(&_comm, &input, &output);
+            }
+
+            freeGenQueryOut(&output);
+            clearGenQueryInp(&input);
+        }};
+
+        addInxIval(&input.selectInp, COL_D_DATA_ID, ORDER_BY);
+        addInxIval(&input.selectInp, COL_DATA_NAME, 1);
+        addInxIval(&input.selectInp, COL_D_COLL_ID, 1);
+        addInxIval(&input.selectInp, COL_DATA_REPL_NUM, 1);
+        addInxIval(&input.selectInp, COL_DATA_VERSION, 1);
+        addInxIval(&input.selectInp, COL_DATA_TYPE_NAME, 1);
+        addInxIval(&input.selectInp, COL_DATA_SIZE, 1);
+        addInxIval(&input.selectInp, COL_D_RESC_ID, 1);
+        addInxIval(&input.selectInp, COL_D_DATA_PATH, 1);
+        addInxIval(&input.selectInp, COL_D_OWNER_NAME, 1);
+        addInxIval(&input.selectInp, COL_D_OWNER_ZONE, 1);
+        addInxIval(&input.selectInp, COL_D_REPL_STATUS, 1);
+        addInxIval(&input.selectInp, COL_D_DATA_CHECKSUM, 1);
+        addInxIval(&input.selectInp, COL_D_CREATE_TIME, 1);
+        addInxIval(&input.selectInp, COL_D_MODIFY_TIME, 1);
+        addInxIval(&input.selectInp, COL_DATA_MODE, 1);
+
+        const auto coll_condition = fmt::format("= '{}'", _coll_id);
+        addInxVal(&input.sqlCondInp, COL_D_COLL_ID, coll_condition.c_str());
+
+        const auto data_id_condition = fmt::format("> '{}'", _last_data_id);
+        addInxVal(&input.sqlCondInp, COL_D_DATA_ID, data_id_condition.c_str());
+
+        addKeyVal(&input.condInput, ZONE_KW, std::string{_collection}.c_str());
+
+        if (!_admin_mode) {
+            addKeyVal(&input.condInput, USER_NAME_CLIENT_KW, _comm.clientUser.userName);
+            addKeyVal(&input.condInput, RODS_ZONE_CLIENT_KW, _comm.clientUser.rodsZone);
+            addKeyVal(&input.condInput, ACCESS_PERMISSION_KW, ACCESS_DELETE_OBJECT);
+        }
+
+        input.maxRows = MAX_SQL_ROWS;
+
+        if (const auto ec = rsGenQuery(&_comm, &input, &output); ec < 0) {
+            return (CAT_NO_ROWS_FOUND == ec) ? 0 : ec;
+        }
+
+        _more = (output->continueInx > 0);
+
+        const auto column = [&output](int _index) {
+            return getSqlResultByInx(output, _index);
+        };
+
+        auto* data_id = column(COL_D_DATA_ID);
+        auto* data_name = column(COL_DATA_NAME);
+        auto* coll_id = column(COL_D_COLL_ID);
+        auto* repl_num = column(COL_DATA_REPL_NUM);
+        auto* version = column(COL_DATA_VERSION);
+        auto* data_type = column(COL_DATA_TYPE_NAME);
+        auto* data_size = column(COL_DATA_SIZE);
+        auto* resc_id = column(COL_D_RESC_ID);
+        auto* file_path = column(COL_D_DATA_PATH);
+        auto* owner_name = column(COL_D_OWNER_NAME);
+        auto* owner_zone = column(COL_D_OWNER_ZONE);
+        auto* repl_status = column(COL_D_REPL_STATUS);
+        auto* checksum = column(COL_D_DATA_CHECKSUM);
+        auto* create_time = column(COL_D_CREATE_TIME);
+        auto* modify_time = column(COL_D_MODIFY_TIME);
+        auto* data_mode = column(COL_DATA_MODE);
+
+        if (!data_id || !data_name || !coll_id || !repl_num || !version || !data_type || !data_size || !resc_id ||
+            !file_path || !owner_name || !owner_zone || !repl_status || !checksum || !create_time || !modify_time ||
+            !data_mode)
+        {
+            return UNMATCHED_KEY_OR_INDEX;
+        }
+
+        const auto value = [](const sqlResult_t* _result, int _row) {
+            return &_result->value[_result->len * _row];
+        };
+
+        for (int row = 0; row < output->rowCnt; ++row) {
+            // Only data objects directly in the collection are removed.
+            if (std::strtoll(value(coll_id, row), nullptr, 10) != _coll_id) {
+                continue;
+            }
+
+            const auto id = std::strtoll(value(data_id, row), nullptr, 10);
+
+            if (_objects.empty() || _objects.back().replicas.front().dataId != id) {
+                page_entry object{};
+                object.logical_path = fmt::format("{}/{}", _collection, value(data_name, row));
+                _objects.push_back(std::move(object));
+            }
+
+            auto& object = _objects.back();
+            auto& replica = object.replicas.emplace_back();
+
+            rstrcpy(replica.objPath, object.logical_path.c_str(), MAX_NAME_LEN);
+            replica.dataId = id;
+            replica.collId = _coll_id;
+            replica.replNum = std::atoi(value(repl_num, row));
+            rstrcpy(replica.version, value(version, row), NAME_LEN);
+            rstrcpy(replica.dataType, value(data_type, row), NAME_LEN);
+            replica.dataSize = std::strtoll(value(data_size, row), nullptr, 10);
+            replica.rescId = std::strtoll(value(resc_id, row), nullptr, 10);
+            rstrcpy(replica.filePath, value(file_path, row), MAX_NAME_LEN);
+            rstrcpy(replica.dataOwnerName, value(owner_name, row), NAME_LEN);
+            rstrcpy(replica.dataOwnerZone, value(owner_zone, row), NAME_LEN);
+            replica.replStatus = std::atoi(value(repl_status, row));
+            rstrcpy(replica.chksum, value(checksum, row), NAME_LEN);
+            rstrcpy(replica.dataCreate, value(create_time, row), TIME_LEN);
+            rstrcpy(replica.dataModify, value(modify_time, row), TIME_LEN);
+            rstrcpy(replica.dataMode, value(data_mode, row), SHORT_STR_LEN);
+        }
+
+        // The replicas of the last data object may continue on the next page. It is read again then.
+        // A data object with more replicas than fit on a page is left for rsDataObjUnlink.
+        if (_more && !_objects.empty()) {
+            if (_objects.size() == 1) {
+                _objects.front().incomplete = true;
+            }
+            else {
+                _objects.pop_back();
+            }
+        }
+
+        return 0;
+    } // read_page
+
+    // Opens a connection to this server for one thread of the pool. Resource plugins run policy, which
+    // must not be invoked from several threads of one agent, so each thread has an agent of its own.
+    auto connect_to_local_host(RsComm& _comm, const leaf_resource& _leaf, int& _ec) -> rcComm_t*
+    {
+        rErrMsg_t error{};
+
+        auto* conn = _rcConnect(_leaf.host->hostName->name,
+                                static_cast<zoneInfo_t*>(_leaf.host->zoneInfo)->portNum,
+                                _comm.myEnv.rodsUserName,
+                                _comm.myEnv.rodsZone,
+                                _comm.clientUser.userName,
+                                _comm.clientUser.rodsZone,
+                                &error,
+                                _comm.connectCnt,
+                                NO_RECONN);
+
+        if (!conn) {
+            _ec = (error.status < 0) ? error.status : SYS_SVR_TO_SVR_CONNECT_FAILED - errno;
+            return nullptr;
+        }
+
+        if (_ec = clientLogin(conn); _ec < 0) {
+            rodsLog(LOG_NOTICE, "%s: clientLogin to %s failed", __FUNCTION__, _leaf.host->hostName->name);
+            rcDisconnect(conn);
+            return nullptr;
+        }
+
+        return conn;
+    } // connect_to_local_host
+
+    // Unlinks a replica through _conn if it is set, or else through the agent of _comm. _comm is only
+    // used on the calling thread.
+    auto unlink_replica(RsComm& _comm, rcComm_t* _conn, const dataObjInfo_t& _replica, const leaf_resource& _leaf) -> int
+    {
+        fileUnlinkInp_t input{};
+        rstrcpy(input.fileName, _replica.filePath, MAX_NAME_LEN);
+        rstrcpy(input.rescHier, _replica.rescHier, MAX_NAME_LEN);
+        rstrcpy(input.addr.hostAddr, _leaf.location.c_str(), NAME_LEN);
+        rstrcpy(input.objPath, _replica.objPath, MAX_NAME_LEN);
+
+        int ec{};
+
+        if (_conn) {
+            ec = rcFileUnlink(_conn, &input);
+        }
+        else {
+            ec = _leaf.local ? _rsFileUnlink(&_comm, &input) : rsFileUnlink(&_comm, &input);
+        }
+
+        // As in dataObjUnlinkS, the replica is unregistered if the file is missing or inaccessible.
+        if (ec < 0) {
+            if (const auto error_number = getErrno(ec); ENOENT == error_number || EACCES == error_number) {
+                return 0;
+            }
+        }
+
+        return ec;
+    } // unlink_replica
+
+    // Applies the privilege checks of chlUnregDataObjBulk before anything is unlinked. The permission of
+    // the client on each data object is checked by read_page, which only returns the data objects the
+    // client may delete, as getDataObjInfo does for rsDataObjUnlink.
+    auto check_privileges(RsComm& _comm, std::string_view _collection, const keyValPair_t& _cond_input) -> int
+    {
+        auto* cond_input = const_cast<keyValPair_t*>(&_cond_input);
+
+        if (getValByKey(cond_input, ADMIN_KW) || getValByKey(cond_input, ADMIN_RMTRASH_KW)) {
+            if (LOCAL_PRIV_USER_AUTH != _comm.clientUser.authInfo.authFlag) {
+                return CAT_INSUFFICIENT_PRIVILEGE_LEVEL;
+            }
+        }
+
+        if (getValByKey(cond_input, ADMIN_RMTRASH_KW) || getValByKey(cond_input, RMTRASH_KW)) {
+            std::string collection{_collection};
+            if (isTrashPath(collection.data()) == False) {
+                return SYS_INVALID_FILE_PATH;
+            }
+        }
+
+        return 0;
+    } // check_privileges
+
+    auto apply_post_delete_policy(RsComm& _comm, DataObjInp& _input, page_entry& _object) -> void
+    {
+        ruleExecInfo_t rei{};
+        initReiWithDataObjInp(&rei, &_comm, &_input);
+        rei.doi = _object.replicas.data();
+        rei.status = 0;
+
+        // make resource properties available as rule session variables
+        irods::get_resc_properties_as_kvp(rei.doi->rescHier, rei.condInputData);
+
+        rei.status = applyRule("acPostProcForDelete", nullptr, &rei, NO_SAVE_REI);
+        if (rei.status < 0) {
+            rodsLog(LOG_NOTICE, "%s: acPostProcForDelete error for %s. status = %d",
+                    __FUNCTION__, _input.objPath, rei.status);
+        }
+
+        clearKeyVal(rei.condInputData);
+        free(rei.condInputData);
+    } // apply_post_delete_policy
+
+    auto update_collection_mtime(RsComm& _comm, std::string_view _collection) -> void
+    {
+        using std::chrono::system_clock;
+        using std::chrono::time_point_cast;
+
+        try {
+            const auto mtime = time_point_cast<fs::object_time_type::duration>(system_clock::now());
+
+            irods::experimental::scoped_privileged_client spc{_comm};
+            fs::server::last_write_time(_comm, std::string{_collection}, mtime);
+        }
+        catch (const fs::filesystem_error& e) {
+            rodsLog(LOG_ERROR, "%s: %s", __FUNCTION__, e.what());
+        }
+    } // update_collection_mtime
+} // anonymous namespace
+
+namespace irods::bulk_data_object_removal
+{
+    auto thread_count() -> int
+    {
+        std::string svc_role;
+        if (const auto err = get_catalog_service_role(svc_role); !err.ok() || irods::CFG_SERVICE_ROLE_PROVIDER != svc_role) {
+            return 0;
+        }
+
+        try {
+            const auto threads = irods::get_advanced_setting<const int>(irods::CFG_NUMBER_OF_CONCURRENT_BULK_REMOVAL_THREADS_KW);
+
+            if (threads < 0) {
+                rodsLog(LOG_ERROR, "Invalid number of bulk removal threads [%d].", threads);
+                return 0;
+            }
+
+            return threads;
+        }
+        catch (const irods::exception&) {
+            rodsLog(LOG_DEBUG, "Could not read server configuration property [%s.%s]. Bulk removal is disabled.",
+                    irods::CFG_ADVANCED_SETTINGS_KW.data(), irods::CFG_NUMBER_OF_CONCURRENT_BULK_REMOVAL_THREADS_KW.data());
+        }
+
+        return 0;
+    } // thread_count
+
+    auto remove_data_objects(RsComm& _comm,
+                             std::string_view _collection,
+                             const DataObjInp& _input,
+                             const progress_handler& _progress,
+                             std::map<std::string, int>& _refused) -> int
+    {
+        const auto threads = thread_count();
+
+        if (threads <= 0) {
+            return 0;
+        }
+
+        // The keywords are shared with every data object. Only the logical path changes.
+        DataObjInp input = _input;
+        auto* cond_input = &input.condInput;
+
+        // Data objects which cannot be removed in bulk are left for rsDataObjUnlink, which reports the error.
+        if (check_privileges(_comm, _collection, *cond_input) < 0) {
+            return 0;
+        }
+
+        const bool admin_mode = getValByKey(cond_input, ADMIN_KW) || getValByKey(cond_input, ADMIN_RMTRASH_KW);
+
+        rodsLong_t coll_id = 0;
+
+        if (const auto ec = resolve_collection_id(_comm, _collection, coll_id); ec < 0) {
+            rodsLog(LOG_DEBUG, "%s: bulk removal skipped for [%s]. status = %d",
+                    __FUNCTION__, std::string{_collection}.c_str(), ec);
+            return 0;
+        }
+
+        // One connection to this server per thread of the pool. Opened with the first local replica.
+        std::vector<rcComm_t*> connections;
+        bool connected = false;
+
+        irods::at_scope_exit disconnect{[&connections] {
+            for (auto* conn : connections) {
+                rcDisconnect(conn);
+            }
+        }};
+
+        std::map<rodsLong_t, leaf_resource> leaves;
+        std::vector<page_entry> objects;
+        rodsLong_t last_data_id = 0;
+        std::int64_t total_removed = 0;
+        bool more = true;
+
+        while (more) {
+            if (const auto ec = read_page(_comm, _collection, coll_id, admin_mode, last_data_id, objects, more); ec < 0) {
+                rodsLog(LOG_ERROR, "%s: failed to read data objects of [%s]. status = %d",
+                        __FUNCTION__, std::string{_collection}.c_str(), ec);
+                break;
+            }
+
+            if (objects.empty()) {
+                break;
+            }
+
+            last_data_id = objects.back().replicas.front().dataId;
+
+            // Decide which data objects are removed in bulk. The others are skipped and left in the catalog.
+            // Remote replicas are unlinked by the calling thread.
+            std::vector<replica_ref> local_replicas;
+            std::vector<replica_ref> serial_replicas;
+            std::vector<std::size_t> candidates;
+
+            for (std::size_t i = 0; i < objects.size(); ++i) {
+                auto& object = objects[i];
+
+                if (object.incomplete || object.replicas.front().dataType == std::string_view{BUNDLE_STR}) {
+                    continue;
+                }
+
+                const bool eligible = std::all_of(std::begin(object.replicas), std::end(object.replicas), [&](auto& _replica) {
+                    if (GOOD_REPLICA != _replica.replStatus && STALE_REPLICA != _replica.replStatus) {
+                        return false;
+                    }
+
+                    auto iter = leaves.find(_replica.rescId);
+                    if (std::end(leaves) == iter) {
+                        iter = leaves.emplace(_replica.rescId, resolve_leaf_resource(_replica.rescId)).first;
+                    }
+
+                    const auto& leaf = iter->second;
+                    if (!leaf.eligible) {
+                        return false;
+                    }
+
+                    // Replicas outside of the vault are not unlinked. rsDataObjUnlink only unregisters them.
+                    if (!leaf.vault_path.empty() && !has_prefix(_replica.filePath, leaf.vault_path.c_str())) {
+                        return false;
+                    }
+
+                    rstrcpy(_replica.rescHier, leaf.hierarchy.c_str(), MAX_NAME_LEN);
+                    rstrcpy(_replica.rescName, leaf.name.c_str(), NAME_LEN);
+
+                    return true;
+                });
+
+                if (!eligible) {
+                    continue;
+                }
+
+                for (std::size_t r = 0; r + 1 < object.replicas.size(); ++r) {
+                    object.replicas[r].next = &object.replicas[r + 1];
+                }
+
+                rstrcpy(input.objPath, object.logical_path.c_str(), MAX_NAME_LEN);
+                if (const auto ec = chkPreProcDeleteRule(&_comm, input, object.replicas.data()); ec < 0) {
+                    _refused[object.logical_path] = ec;
+                    continue;
+                }
+
+                object.statuses.assign(object.replicas.size(), 0);
+
+                for (std::size_t r = 0; r < object.replicas.size(); ++r) {
+                    const auto& leaf = leaves[object.replicas[r].rescId];
+                    (leaf.local ? local_replicas : serial_replicas).push_back({i, r});
+                }
+
+                candidates.push_back(i);
+            }
+
+            if (!local_replicas.empty() && !connected) {
+                connected = true;
+
+                const auto& [o, r] = local_replicas.front();
+                const auto& leaf = leaves.at(objects[o].replicas[r].rescId);
+
+                for (int t = 0; t < threads; ++t) {
+                    int ec{};
+                    auto* conn = connect_to_local_host(_comm, leaf, ec);
+
+                    if (!conn) {
+                        rodsLog(LOG_NOTICE, "%s: could not connect to the local server. status = %d", __FUNCTION__, ec);
+                        break;
+                    }
+
+                    connections.push_back(conn);
+                }
+            }
+
+            // Unlink the local replicas concurrently, each thread through its own connection. Each task
+            // unlinks a run of replicas of the same leaf resource so that every resource receives work
+            // from several threads. Without connections, the calling thread unlinks them.
+            std::stable_sort(std::begin(local_replicas), std::end(local_replicas), [&objects](auto& _lhs, auto& _rhs) {
+                return objects[_lhs.object].replicas[_lhs.replica].rescId < objects[_rhs.object].replicas[_rhs.replica].rescId;
+            });
+
+            if (connections.empty()) {
+                serial_replicas.insert(std::end(serial_replicas), std::begin(local_replicas), std::end(local_replicas));
+                local_replicas.clear();
+            }
+
+            const auto slots = std::max<std::size_t>(1, connections.size());
+            const auto chunk_size = std::max<std::size_t>(1, (local_replicas.size() + slots - 1) / slots);
+
+            {
+                irods::thread_pool pool{static_cast<int>(slots)};
+
+                for (std::size_t first = 0, s = 0; first < local_replicas.size(); first += chunk_size, ++s) {
+                    const auto last = std::min(local_replicas.size(), first + chunk_size);
+
+                    irods::thread_pool::post(pool, [&, conn = connections[s], first, last] {
+                        for (auto i = first; i < last; ++i) {
+                            auto& [o, r] = local_replicas[i];
+                            auto& replica = objects[o].replicas[r];
+                            objects[o].statuses[r] = unlink_replica(_comm, conn, replica, leaves.at(replica.rescId));
+                        }
+                    });
+                }
+
+                for (auto&& [o, r] : serial_replicas) {
+                    auto& replica = objects[o].replicas[r];
+                    objects[o].statuses[r] = unlink_replica(_comm, nullptr, replica, leaves.at(replica.rescId));
+                }
+
+                pool.join();
+            }
+
+            // Unregister the data objects whose replicas were all unlinked. The others are left for
+            // rsDataObjUnlink, which retries the unlink and reports the error.
+            std::vector<dataObjInfo_t> unregistered;
+            std::vector<std::size_t> removed;
+
+            for (auto i : candidates) {
+                auto& object = objects[i];
+
+                const auto failed = std::find_if(std::begin(object.statuses), std::end(object.statuses), [](int _ec) { return _ec < 0; });
+                if (std::end(object.statuses) != failed) {
+                    rodsLog(LOG_DEBUG, "%s: failed to unlink a replica of [%s]. status = %d",
+                            __FUNCTION__, object.logical_path.c_str(), *failed);
+                    continue;
+                }
+
+                for (auto&& replica : object.replicas) {
+                    unregistered.push_back(replica);
+                    unregistered.back().next = nullptr;
+                }
+
+                removed.push_back(i);
+            }
+
+            if (removed.empty()) {
+                continue;
+            }
+
+            if (const auto ec = chlUnregDataObjBulk(&_comm, unregistered, cond_input); ec < 0) {
+                rodsLog(LOG_ERROR, "%s: chlUnregDataObjBulk failed for [%s]. status = %d",
+                        __FUNCTION__, std::string{_collection}.c_str(), ec);
+                break;
+            }
+
+            for (auto i : removed) {
+                auto& object = objects[i];
+
+                for (auto&& replica : object.replicas) {
+                    irods::file_object_ptr file_obj(new irods::file_object(&_comm, &replica));
+                    if (const auto err = fileUnregistered(&_comm, file_obj); !err.ok()) {
+                        irods::log(PASSMSG(fmt::format("Failed to signal resource that the data object [{}] was unregistered",
+                                                       object.logical_path), err));
+                    }
+                }
+
+                irods::hierarchy_resolution_cache::erase(object.logical_path);
+
+                rstrcpy(input.objPath, object.logical_path.c_str(), MAX_NAME_LEN);
+                apply_post_delete_policy(_comm, input, object);
+            }
+
+            total_removed += removed.size();
+
+            if (const auto ec = _progress(removed.size(), objects[removed.back()].logical_path); ec < 0) {
+                update_collection_mtime(_comm, _collection);
+                return ec;
+            }
+        }
+
+        if (total_removed > 0) {
+            update_collection_mtime(_comm, _collection);
+        }
+
+        return 0;
+    } // remove_data_objects
+} // namespace irods::bulk_data_object_removal
@@ -0,0 +1,271 @@
+#include "catalog_permission_cache.hpp"
+
+#include "irods_server_properties.hpp"
+
+#include "fmt/format.h"
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <utility>
+
+namespace irods::catalog_permission_cache
+{
+    namespace
+    {
+        using clock_type = std::chrono::steady_clock;
+
+        struct collection_entry
+        {
+            std::string collection;
+            collection_permission permission;
+            clock_type::time_point expiration;
+        }; // struct collection_entry
+
+        struct groups_entry
+        {
+            std::set<std::string> groups;
+            clock_type::time_point expiration;
+        }; // struct groups_entry
+
+        // The maximum number of entries held by each table at any moment. The oldest
+        // entries are dropped first when a table is full.
+        constexpr std::size_t max_entries = 1000;
+
+        // Global Variables
+        clock_type::duration eviction_age{};
+        std::map<std::string, collection_entry> collections;
+        std::map<std::string, groups_entry> groups;
+        statistics stats{};
+
+        std::mutex cache_mutex;
+
+        auto make_user_key(std::string_view _user_name, std::string_view _zone_name) -> std::string
+        {
+            return fmt::format("{}#{}", _user_name, _zone_name);
+        } // make_user_key
+
+        auto make_collection_key(std::string_view _collection,
+                                 std::string_view _user_name,
+                                 std::string_view _zone_name,
+                                 std::string_view _access_level) -> std::string
+        {
+            return fmt::format("{}\n{}#{}\n{}", _collection, _user_name, _zone_name, _access_level);
+        } // make_collection_key
+
+        auto is_same_or_child(std::string_view _path, std::string_view _collection) noexcept -> bool
+        {
+            if (_collection.empty() || _path.size() < _collection.size() || _path.compare(0, _collection.size(), _collection) != 0) {
+                return false;
+            }
+
+            return _path.size() == _collection.size() ||
+                   '/' == _collection.back() ||
+                   '/' == _path[_collection.size()];
+        } // is_same_or_child
+
+        // Makes room for one more entry. The caller must hold cache_mutex.
+        template <typename Map>
+        auto make_room(Map& _table) -> void
+        {
+            if (_table.size() < max_entries) {
+                return;
+            }
+
+            const auto now = clock_type::now();
+
+            for (auto it = std::begin(_table); it != std::end(_table);) {
+                if (it->second.expiration <= now) {
+                    it = _table.erase(it);
+                    ++stats.invalidations;
+                }
+                else {
+                    ++it;
+                }
+            }
+
+            if (_table.size() >= max_entries) {
+                const auto oldest = std::min_element(std::begin(_table), std::end(_table), [](auto&& _lhs, auto&& _rhs) {
+                    return _lhs.second.expiration < _rhs.second.expiration;
+                });
+
+                _table.erase(oldest);
+                ++stats.invalidations;
+            }
+        } // make_room
+
+        // Returns the live entry for the key, if one exists. The caller must hold cache_mutex.
+        template <typename Map>
+        auto find(Map& _table, const std::string& _key) -> typename Map::mapped_type*
+        {
+            const auto iter = _table.find(_key);
+
+            if (iter == std::end(_table)) {
+                return nullptr;
+            }
+
+            if (iter->second.expiration <= clock_type::now()) {
+                _table.erase(iter);
+                ++stats.invalidations;
+                return nullptr;
+            }
+
+            return &iter->second;
+        } // find
+    } // anonymous namespace
+
+    auto init() -> void
+    {
+        init(std::chrono::seconds{irods::get_catalog_permission_cache_eviction_age()});
+    } // init
+
+    auto init(std::chrono::seconds _eviction_age) -> void
+    {
+        std::scoped_lock lock{cache_mutex};
+
+        eviction_age = _eviction_age;
+        collections.clear();
+        groups.clear();
+        stats = {};
+    } // init
+
+    auto deinit() -> void
+    {
+        std::scoped_lock lock{cache_mutex};
+
+        collections.clear();
+        groups.clear();
+    } // deinit
+
+    auto enabled() noexcept -> bool
+    {
+        return eviction_age > clock_type::duration::zero();
+    } // enabled
+
+    auto lookup_collection(std::string_view _collection,
+                           std::string_view _user_name,
+                           std::string_view _zone_name,
+                           std::string_view _access_level) -> std::optional<collection_permission>
+    {
+        if (!enabled()) {
+            return std::nullopt;
+        }
+
+        std::scoped_lock lock{cache_mutex};
+
+        if (const auto* e = find(collections, make_collection_key(_collection, _user_name, _zone_name, _access_level)); e) {
+            ++stats.hits;
+            return e->permission;
+        }
+
+        ++stats.misses;
+
+        return std::nullopt;
+    } // lookup_collection
+
+    auto insert_collection(std::string_view _collection,
+                           std::string_view _user_name,
+                           std::string_view _zone_name,
+                           std::string_view _access_level,
+                           const collection_permission& _permission) -> void
+    {
+        if (!enabled()) {
+            return;
+        }
+
+        std::scoped_lock lock{cache_mutex};
+
+        auto key = make_collection_key(_collection, _user_name, _zone_name, _access_level);
+
+        if (auto* e = find(collections, key); e) {
+            if (e->permission.inheritance && !_permission.inheritance) {
+                return;
+            }
+        }
+        else {
+            make_room(collections);
+        }
+
+        collections.insert_or_assign(std::move(key), collection_entry{std::string{_collection},
+                                                                      _permission,
+                                                                      clock_type::now() + eviction_age});
+    } // insert_collection
+
+    auto lookup_groups(std::string_view _user_name, std::string_view _zone_name)
+        -> std::optional<std::set<std::string>>
+    {
+        if (!enabled()) {
+            return std::nullopt;
+        }
+
+        std::scoped_lock lock{cache_mutex};
+
+        if (const auto* e = find(groups, make_user_key(_user_name, _zone_name)); e) {
+            ++stats.hits;
+            return e->groups;
+        }
+
+        ++stats.misses;
+
+        return std::nullopt;
+    } // lookup_groups
+
+    auto insert_groups(std::string_view _user_name,
+                       std::string_view _zone_name,
+                       std::set<std::string> _groups) -> void
+    {
+        if (!enabled()) {
+            return;
+        }
+
+        std::scoped_lock lock{cache_mutex};
+
+        auto key = make_user_key(_user_name, _zone_name);
+
+        if (!find(groups, key)) {
+            make_room(groups);
+        }
+
+        groups.insert_or_assign(std::move(key), groups_entry{std::move(_groups), clock_type::now() + eviction_age});
+    } // insert_groups
+
+    auto erase_collection(std::string_view _collection) -> void
+    {
+        std::scoped_lock lock{cache_mutex};
+
+        for (auto it = std::begin(collections); it != std::end(collections);) {
+            if (is_same_or_child(it->second.collection, _collection)) {
+                it = collections.erase(it);
+                ++stats.invalidations;
+            }
+            else {
+                ++it;
+            }
+        }
+    } // erase_collection
+
+    auto clear_collections() -> void
+    {
+        std::scoped_lock lock{cache_mutex};
+
+        stats.invalidations += collections.size();
+        collections.clear();
+    } // clear_collections
+
+    auto clear() -> void
+    {
+        std::scoped_lock lock{cache_mutex};
+
+        stats.invalidations += collections.size() + groups.size();
+        collections.clear();
+        groups.clear();
+    } // clear
+
+    auto get_statistics() -> statistics
+    {
+        std::scoped_lock lock{cache_mutex};
+
+        return stats;
+    } // get_statistics
+} // namespace irods::catalog_permission_cache
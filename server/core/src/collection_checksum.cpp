@@ -0,0 +1,602 @@
+#include "collection_checksum.hpp"
+
+#include "fileChksum.h"
+#include "genQuery.h"
+#include "icatHighLevelRoutines.hpp"
+#include "irods_at_scope_exit.hpp"
+#include "irods_configuration_keywords.hpp"
+#include "irods_exception.hpp"
+#include "irods_resource_backport.hpp"
+#include "irods_resource_manager.hpp"
+#include "irods_server_properties.hpp"
+#include "objInfo.h"
+#include "rcMisc.h"
+#include "rodsConnect.h"
+#include "rodsErrorTable.h"
+#include "rodsLog.h"
+#include "rsFileChksum.hpp"
+#include "rsGenQuery.hpp"
+#include "rsGlobalExtern.hpp"
+#include "thread_pool.hpp"
+
+#include "fmt/format.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+
+namespace
+{
+    // The maximum number of threads of a job, regardless of the number of leaf resources.
+    constexpr std::size_t max_threads = 32;
+
+    // Matches number_of_concurrent_checksum_operations_per_resource in the server_config.json template.
+    constexpr int default_concurrency_per_resource = 2;
+
+    // What is known about the leaf resource of a replica. The resource is resolved once per job on
+    // the calling thread. This also instantiates its tree, which the thread pool must not do.
+    struct leaf_resource
+    {
+        // Non-zero if checksums cannot be calculated on the resource.
+        int error_code;
+        bool local;
+        std::string hierarchy;
+        std::string location;
+        rodsServerHost_t* host;
+
+        // The connections of the job to the server hosting the resource, one per concurrent task. The
+        // agent of the job cannot be shared between threads, and svrToSvrConnect caches a single
+        // connection per server.
+        std::vector<rcComm_t*> connections;
+    }; // struct leaf_resource
+
+    struct replica
+    {
+        std::string logical_path;
+        rodsLong_t data_id;
+        int replica_number;
+        rodsLong_t resource_id;
+        std::string physical_path;
+        rodsLong_t data_size;
+        int status;
+        std::string catalog_checksum;
+
+        // Set by the thread pool.
+        std::string computed_checksum;
+        int error_code;
+    }; // struct replica
+
+    // A run of replicas of one leaf resource, processed by one thread.
+    struct task
+    {
+        const leaf_resource* leaf;
+        rcComm_t* conn;
+        std::vector<replica*> replicas;
+    }; // struct task
+
+    auto resolve_leaf_resource(rodsLong_t _resc_id) -> leaf_resource
+    {
+        leaf_resource leaf{};
+
+        if (const auto err = resc_mgr.leaf_id_to_hier(_resc_id, leaf.hierarchy); !err.ok()) {
+            leaf.error_code = err.code();
+            return leaf;
+        }
+
+        std::string resc_class;
+        if (const auto err = irods::get_resource_property<std::string>(_resc_id, irods::RESOURCE_CLASS, resc_class); !err.ok()) {
+            leaf.error_code = err.code();
+            return leaf;
+        }
+
+        if (irods::RESOURCE_CLASS_BUNDLE == resc_class) {
+            leaf.error_code = SYS_CANT_CHKSUM_BUNDLED_DATA;
+            return leaf;
+        }
+
+        if (const auto err = irods::is_hier_live(leaf.hierarchy); !err.ok()) {
+            leaf.error_code = err.code();
+            return leaf;
+        }
+
+        if (const auto err = irods::get_loc_for_hier_string(leaf.hierarchy, leaf.location); !err.ok()) {
+            leaf.error_code = err.code();
+            return leaf;
+        }
+
+        int remote_flag{};
+        if (const auto err = irods::get_host_for_hier_string(leaf.hierarchy, remote_flag, leaf.host); !err.ok()) {
+            leaf.error_code = err.code();
+            return leaf;
+        }
+
+        if (LOCAL_HOST != remote_flag && REMOTE_HOST != remote_flag) {
+            leaf.error_code = (remote_flag < 0) ? remote_flag : SYS_UNRECOGNIZED_REMOTE_FLAG;
+            return leaf;
+        }
+
+        leaf.local = (LOCAL_HOST == remote_flag);
+
+        return leaf;
+    } // resolve_leaf_resource
+
+    // Opens a connection to the server hosting a leaf resource, as svrToSvrConnect does. The server may
+    // be this one.
+    auto connect_to_host(RsComm& _comm, const leaf_resource& _leaf, int& _ec) -> rcComm_t*
+    {
+        rErrMsg_t error{};
+
+        auto* conn = _rcConnect(_leaf.host->hostName->name,
+                                static_cast<zoneInfo_t*>(_leaf.host->zoneInfo)->portNum,
+                                _comm.myEnv.rodsUserName,
+                                _comm.myEnv.rodsZone,
+                                _comm.clientUser.userName,
+                                _comm.clientUser.rodsZone,
+                                &error,
+                                _comm.connectCnt,
+                                NO_RECONN);
+
+        if (!conn) {
+            _ec = (error.status < 0) ? error.status : SYS_SVR_TO_SVR_CONNECT_FAILED - errno;
+            return nullptr;
+        }
+
+        if (_ec = clientLogin(conn); _ec < 0) {
+            rodsLog(LOG_NOTICE, "%s: clientLogin to %s failed", __FUNCTION__, _leaf.host->hostName->name);
+            rcDisconnect(conn);
+            return nullptr;
+        }
+
+        return conn;
+    } // connect_to_host
+
+    // Runs on the thread pool with a connection of its own. Without a connection, _comm is used, which
+    // is only allowed on the calling thread.
+    auto calculate_checksum(RsComm& _comm, const leaf_resource& _leaf, rcComm_t* _conn, replica& _replica) -> void
+    {
+        fileChksumInp_t input{};
+        rstrcpy(input.addr.hostAddr, _leaf.location.c_str(), NAME_LEN);
+        rstrcpy(input.fileName, _replica.physical_path.c_str(), MAX_NAME_LEN);
+        rstrcpy(input.rescHier, _leaf.hierarchy.c_str(), MAX_NAME_LEN);
+        rstrcpy(input.objPath, _replica.logical_path.c_str(), MAX_NAME_LEN);
+        input.dataSize = _replica.data_size;
+
+        // The checksum in the catalog selects the hash scheme, so that the two can be compared.
+        rstrcpy(input.orig_chksum, _replica.catalog_checksum.c_str(), NAME_LEN);
+
+        char* checksum{};
+        irods::at_scope_exit free_checksum{[&checksum] { std::free(checksum); }};
+
+        const auto ec = _conn ? rcFileChksum(_conn, &input, &checksum) : _rsFileChksum(&_comm, &input, &checksum);
+
+        if (ec < 0) {
+            _replica.error_code = ec;
+        }
+        else if (checksum) {
+            _replica.computed_checksum = checksum;
+        }
+    } // calculate_checksum
+} // anonymous namespace
+
+namespace irods::collection_checksum
+{
+    struct job::impl
+    {
+        impl(RsComm& _comm, std::string_view _collection, const options& _options)
+            : comm{_comm}
+            , collection{_collection}
+            , opts{_options}
+            , concurrency{concurrency_per_resource()}
+        {
+        }
+
+        ~impl()
+        {
+            for (auto&& [id, leaf] : leaves) {
+                for (auto* conn : leaf.connections) {
+                    rcDisconnect(conn);
+                }
+            }
+        }
+
+        auto leaf(rodsLong_t _resc_id) -> leaf_resource&
+        {
+            auto iter = leaves.find(_resc_id);
+
+            if (std::end(leaves) == iter) {
+                iter = leaves.emplace(_resc_id, resolve_leaf_resource(_resc_id)).first;
+            }
+
+            return iter->second;
+        } // leaf
+
+        auto is_in_collection(std::string_view _coll_name) const -> bool
+        {
+            // LIKE treats '_' and '%' as wildcards, so the rows are checked again.
+            if ("/" == collection || _coll_name == collection) {
+                return true;
+            }
+
+            return _coll_name.size() > collection.size() &&
+                   _coll_name.compare(0, collection.size(), collection) == 0 &&
+                   _coll_name[collection.size()] == '/';
+        } // is_in_collection
+
+        // Reads the replicas following the position of the job, in order of data id and replica number.
+        // Each page is read with a new query, because the catalog is written between pages.
+        auto read_page(std::size_t _limit, std::vector<replica>& _batch) -> void
+        {
+            genQueryInp_t input{};
+            genQueryOut_t* output{};
+
+            irods::at_scope_exit free_query{[this, &input, &output] {
+                // Close the statement on the catalog if rows are left.
+                if (output && output->continueInx > 0) {
+                    input.continueInx = output->continueInx;
+                    input.maxRows = 0;
+                    freeGenQueryOut(&output);
+                    rsGenQuery(&comm, &input, &output);
+                }
+
+                freeGenQueryOut(&output);
+                clearGenQueryInp(&input);
+            }};
+
+            addInxIval(&input.selectInp, COL_D_DATA_ID, ORDER_BY);
+            addInxIval(&input.selectInp, COL_DATA_REPL_NUM, ORDER_BY);
+            addInxIval(&input.selectInp, COL_COLL_NAME, 1);
+            addInxIval(&input.selectInp, COL_DATA_NAME, 1);
+            addInxIval(&input.selectInp, COL_D_RESC_ID, 1);
+            addInxIval(&input.selectInp, COL_D_DATA_PATH, 1);
+            addInxIval(&input.selectInp, COL_DATA_SIZE, 1);
+            addInxIval(&input.selectInp, COL_D_REPL_STATUS, 1);
+            addInxIval(&input.selectInp, COL_D_DATA_CHECKSUM, 1);
+
+            const auto coll_condition = ("/" == collection)
+                ? std::string{"like '/%'"}
+                : fmt::format("= '{0}' || like '{0}/%'", collection);
+            addInxVal(&input.sqlCondInp, COL_COLL_NAME, coll_condition.c_str());
+
+            const auto data_id_condition = fmt::format(">= '{}'", last_data_id);
+            addInxVal(&input.sqlCondInp, COL_D_DATA_ID, data_id_condition.c_str());
+
+            addKeyVal(&input.condInput, ZONE_KW, collection.c_str());
+
+            if (!opts.admin_mode) {
+                addKeyVal(&input.condInput, USER_NAME_CLIENT_KW, comm.clientUser.userName);
+                addKeyVal(&input.condInput, RODS_ZONE_CLIENT_KW, comm.clientUser.rodsZone);
+                addKeyVal(&input.condInput, ACCESS_PERMISSION_KW, ACCESS_READ_OBJECT);
+            }
+
+            input.maxRows = MAX_SQL_ROWS;
+
+            if (const auto ec = rsGenQuery(&comm, &input, &output); ec < 0) {
+                if (CAT_NO_ROWS_FOUND == ec) {
+                    exhausted = true;
+                    return;
+                }
+
+                THROW(ec, fmt::format("Could not read the replicas of [{}].", collection));
+            }
+
+            const auto value = [&output](int _column, int _row) -> const char* {
+                const auto* result = getSqlResultByInx(output, _column);
+                return &result->value[result->len * _row];
+            };
+
+            bool full = false;
+            int added = 0;
+
+            for (int row = 0; row < output->rowCnt; ++row) {
+                const auto data_id = std::strtoll(value(COL_D_DATA_ID, row), nullptr, 10);
+                const auto replica_number = std::atoi(value(COL_DATA_REPL_NUM, row));
+
+                // Rows of the last data object which were read by the previous page.
+                if (data_id == last_data_id && replica_number <= last_replica_number) {
+                    continue;
+                }
+
+                if (_batch.size() == _limit) {
+                    full = true;
+                    break;
+                }
+
+                last_data_id = data_id;
+                last_replica_number = replica_number;
+                ++added;
+
+                const std::string_view coll_name = value(COL_COLL_NAME, row);
+                if (!is_in_collection(coll_name)) {
+                    continue;
+                }
+
+                auto& r = _batch.emplace_back();
+                r.logical_path = fmt::format("{}/{}", coll_name, value(COL_DATA_NAME, row));
+                r.data_id = data_id;
+                r.replica_number = replica_number;
+                r.resource_id = std::strtoll(value(COL_D_RESC_ID, row), nullptr, 10);
+                r.physical_path = value(COL_D_DATA_PATH, row);
+                r.data_size = std::strtoll(value(COL_DATA_SIZE, row), nullptr, 10);
+                r.status = std::atoi(value(COL_D_REPL_STATUS, row));
+                r.catalog_checksum = value(COL_D_DATA_CHECKSUM, row);
+            }
+
+            const bool more = (output->continueInx > 0);
+
+            if (!more && !full) {
+                exhausted = true;
+            }
+            else if (more && !full && 0 == added) {
+                // Every row of a full page belongs to the data object read last. Its remaining
+                // replicas cannot be reached without reading the same page again.
+                rodsLog(LOG_WARNING, "%s: skipping the replicas of data id [%lld] beyond replica number [%d].",
+                        __FUNCTION__, last_data_id, last_replica_number);
+
+                ++last_data_id;
+                last_replica_number = -1;
+            }
+        } // read_page
+
+        auto calculate_checksums(const std::vector<replica*>& _replicas) -> void
+        {
+            std::map<rodsLong_t, std::vector<replica*>> replicas_by_leaf;
+
+            for (auto* r : _replicas) {
+                replicas_by_leaf[r->resource_id].push_back(r);
+            }
+
+            std::vector<task> tasks;
+            std::vector<replica*> local_replicas;
+
+            for (auto&& [resc_id, replicas] : replicas_by_leaf) {
+                auto& l = leaf(resc_id);
+                auto slots = std::min(static_cast<std::size_t>(concurrency), replicas.size());
+
+                // The connections are opened on the calling thread, because the server host table is not
+                // safe to use from the thread pool. They are kept for the following batches.
+                int ec = 0;
+
+                while (l.connections.size() < slots) {
+                    auto* conn = connect_to_host(comm, l, ec);
+
+                    if (!conn) {
+                        break;
+                    }
+
+                    l.connections.push_back(conn);
+                }
+
+                slots = std::min(slots, l.connections.size());
+
+                if (0 == slots) {
+                    // The replicas of a local resource are still checksummed by the agent of the job, on
+                    // the calling thread.
+                    if (l.local) {
+                        local_replicas.insert(std::end(local_replicas), std::begin(replicas), std::end(replicas));
+                        continue;
+                    }
+
+                    for (auto* r : replicas) {
+                        r->error_code = ec;
+                    }
+
+                    continue;
+                }
+
+                const auto first = tasks.size();
+
+                for (std::size_t s = 0; s < slots; ++s) {
+                    tasks.push_back({&l, l.connections[s], {}});
+                }
+
+                for (std::size_t i = 0; i < replicas.size(); ++i) {
+                    tasks[first + i % slots].replicas.push_back(replicas[i]);
+                }
+            }
+
+            if (tasks.empty() && local_replicas.empty()) {
+                return;
+            }
+
+            irods::thread_pool pool{static_cast<int>(std::clamp<std::size_t>(tasks.size(), 1, max_threads))};
+
+            for (auto&& t : tasks) {
+                irods::thread_pool::post(pool, [this, &t] {
+                    for (auto* r : t.replicas) {
+                        calculate_checksum(comm, *t.leaf, t.conn, *r);
+                    }
+                });
+            }
+
+            for (auto* r : local_replicas) {
+                calculate_checksum(comm, leaves.at(r->resource_id), nullptr, *r);
+            }
+
+            pool.join();
+        } // calculate_checksums
+
+        auto register_checksum(replica& _replica, int _flags) -> int
+        {
+            dataObjInfo_t info{};
+            rstrcpy(info.objPath, _replica.logical_path.c_str(), MAX_NAME_LEN);
+            rstrcpy(info.rescHier, leaf(_replica.resource_id).hierarchy.c_str(), MAX_NAME_LEN);
+            info.dataId = _replica.data_id;
+            info.replNum = _replica.replica_number;
+            info.flags = _flags;
+
+            keyValPair_t reg_param{};
+            irods::at_scope_exit clear_reg_param{[&reg_param] { clearKeyVal(&reg_param); }};
+
+            addKeyVal(&reg_param, CHKSUM_KW, _replica.computed_checksum.c_str());
+
+            if (opts.admin_mode) {
+                addKeyVal(&reg_param, ADMIN_KW, "");
+            }
+
+            return chlModDataObjMeta(&comm, &info, &reg_param);
+        } // register_checksum
+
+        // The checksums of a batch are registered in one transaction. A failure rolls the transaction
+        // back, in which case they are registered one replica at a time so that only the failed
+        // replicas are left without a checksum.
+        auto register_checksums(const std::vector<replica*>& _replicas) -> void
+        {
+            if (_replicas.empty()) {
+                return;
+            }
+
+            const bool registered = std::all_of(std::begin(_replicas), std::end(_replicas), [this](auto* _r) {
+                return register_checksum(*_r, NO_COMMIT_FLAG) >= 0;
+            });
+
+            if (registered && chlCommit(&comm) >= 0) {
+                return;
+            }
+
+            for (auto* r : _replicas) {
+                if (const auto ec = register_checksum(*r, 0); ec < 0) {
+                    r->error_code = ec;
+                }
+            }
+        } // register_checksums
+
+        auto make_result(const replica& _replica, std::string_view _status) -> replica_result
+        {
+            return {_replica.logical_path,
+                    _replica.replica_number,
+                    leaf(_replica.resource_id).hierarchy,
+                    std::string{_status},
+                    _replica.catalog_checksum,
+                    _replica.computed_checksum,
+                    _replica.error_code};
+        } // make_result
+
+        RsComm& comm;
+        std::string collection;
+        options opts;
+        int concurrency;
+
+        // The position of the job.
+        rodsLong_t last_data_id = 0;
+        int last_replica_number = -1;
+        bool exhausted = false;
+
+        std::map<rodsLong_t, leaf_resource> leaves;
+        progress totals;
+    }; // struct job::impl
+
+    auto concurrency_per_resource() -> int
+    {
+        try {
+            const auto n = irods::get_advanced_setting<const int>(irods::CFG_NUMBER_OF_CONCURRENT_CHECKSUM_OPERATIONS_PER_RESOURCE_KW);
+
+            if (n < 1) {
+                rodsLog(LOG_ERROR, "Invalid number of concurrent checksum operations per resource [%d]. Using %d.",
+                        n, default_concurrency_per_resource);
+                return default_concurrency_per_resource;
+            }
+
+            return n;
+        }
+        catch (const irods::exception&) {
+            rodsLog(LOG_DEBUG, "Could not read server configuration property [%s.%s]. Using %d.",
+                    irods::CFG_ADVANCED_SETTINGS_KW.data(),
+                    irods::CFG_NUMBER_OF_CONCURRENT_CHECKSUM_OPERATIONS_PER_RESOURCE_KW.data(),
+                    default_concurrency_per_resource);
+        }
+
+        return default_concurrency_per_resource;
+    } // concurrency_per_resource
+
+    job::job(RsComm& _comm, std::string_view _collection, const options& _options)
+        : impl_{std::make_unique<impl>(_comm, _collection, _options)}
+    {
+    }
+
+    job::~job() = default;
+
+    auto job::run(std::size_t _batch_size, std::vector<replica_result>& _results) -> bool
+    {
+        auto& totals = impl_->totals;
+        const auto& opts = impl_->opts;
+
+        std::vector<replica> batch;
+        batch.reserve(_batch_size);
+
+        while (batch.size() < _batch_size && !impl_->exhausted) {
+            impl_->read_page(_batch_size, batch);
+        }
+
+        std::vector<replica*> to_calculate;
+
+        for (auto&& r : batch) {
+            if (GOOD_REPLICA != r.status && (STALE_REPLICA != r.status || !opts.all_replicas)) {
+                if (STALE_REPLICA != r.status) {
+                    ++totals.skipped;
+                }
+
+                continue;
+            }
+
+            ++totals.replicas;
+
+            if (const auto ec = impl_->leaf(r.resource_id).error_code; ec < 0) {
+                r.error_code = ec;
+                ++totals.failed;
+                _results.push_back(impl_->make_result(r, "error"));
+                continue;
+            }
+
+            if (r.catalog_checksum.empty() && (opts.verify_only || !opts.compute_missing)) {
+                ++totals.missing;
+                _results.push_back(impl_->make_result(r, "missing"));
+                continue;
+            }
+
+            to_calculate.push_back(&r);
+        }
+
+        impl_->calculate_checksums(to_calculate);
+
+        std::vector<replica*> to_register;
+
+        for (auto* r : to_calculate) {
+            if (r->error_code < 0) {
+                ++totals.failed;
+                _results.push_back(impl_->make_result(*r, "error"));
+            }
+            else if (r->catalog_checksum.empty()) {
+                to_register.push_back(r);
+            }
+            else if (r->computed_checksum == r->catalog_checksum) {
+                ++totals.verified;
+            }
+            else {
+                ++totals.mismatched;
+                _results.push_back(impl_->make_result(*r, "mismatch"));
+            }
+        }
+
+        impl_->register_checksums(to_register);
+
+        for (auto* r : to_register) {
+            if (r->error_code < 0) {
+                ++totals.failed;
+                _results.push_back(impl_->make_result(*r, "error"));
+            }
+            else {
+                ++totals.computed;
+                _results.push_back(impl_->make_result(*r, "computed"));
+            }
+        }
+
+        return !impl_->exhausted;
+    } // run
+
+    auto job::totals() const noexcept -> const progress&
+    {
+        return impl_->totals;
+    } // totals
+} // namespace irods::collection_checksum
@@ -0,0 +1,605 @@
+#include "data_object_finalize_writer.hpp"
+
+#include "catalog.hpp"
+#include "catalog_utilities.hpp"
+#include "data_object_finalize.h"
+#include "fileDriver.hpp"
+#include "icatHighLevelRoutines.hpp"
+#include "irods_exception.hpp"
+#include "irods_file_object.hpp"
+#include "irods_logger.hpp"
+#include "irods_resource_manager.hpp"
+#include "irods_rs_comm_query.hpp"
+#include "json_deserialization.hpp"
+#include "key_value_proxy.hpp"
+#include "quota_usage.hpp"
+#include "rcConnect.h"
+#include "rodsErrorTable.h"
+#include "rodsKeyWdDef.h"
+
+#include "fmt/format.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <map>
+#include <string_view>
+
+extern irods::resource_manager resc_mgr;
+
+namespace
+{
+    // clang-format off
+    namespace ic          = irods::experimental::catalog;
+    namespace dof         = irods::experimental::catalog::data_object_finalize;
+    namespace quota_usage = irods::experimental::catalog::quota_usage;
+
+    using log  = irods::experimental::log;
+    using json = nlohmann::json;
+    // clang-format on
+
+    constexpr inline auto database_updated = true;
+
+    // Every column of R_DATA_MAIN except data_id, coll_id and data_name, followed by the
+    // data id and resource id identifying the replica.
+    constexpr const char* update_replicas_statement = "update R_DATA_MAIN set"
+                                                      " data_repl_num = ?,"
+                                                      " data_version = ?,"
+                                                      " data_type_name = ?,"
+                                                      " data_size = ?,"
+                                                      " data_path = ?,"
+                                                      " data_owner_name = ?,"
+                                                      " data_owner_zone = ?,"
+                                                      " data_is_dirty = ?,"
+                                                      " data_status = ?,"
+                                                      " data_checksum = ?,"
+                                                      " data_expiry_ts = ?,"
+                                                      " data_map_id = ?,"
+                                                      " data_mode = ?,"
+                                                      " r_comment = ?,"
+                                                      " create_ts = ?,"
+                                                      " modify_ts = ?,"
+                                                      " resc_id = ? "
+                                                      "where data_id = ? and resc_id = ?";
+
+    auto make_error_object(const std::string_view _error_msg = "", const bool _database_updated = false) -> json
+    {
+        return json{{"error_message", _error_msg},
+                    {"database_updated", _database_updated}};
+    } // make_error_object
+
+    auto current_time() -> std::string
+    {
+        const auto now = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch());
+        return fmt::format("{:011}", now.count());
+    } // current_time
+
+    auto bigint_at(const json& _columns, const char* _name) -> std::int64_t
+    {
+        return std::stoll(_columns.at(_name).get_ref<const std::string&>());
+    } // bigint_at
+
+    auto integer_at(const json& _columns, const char* _name) -> int
+    {
+        return std::stoi(_columns.at(_name).get_ref<const std::string&>());
+    } // integer_at
+
+    auto string_at(const json& _columns, const char* _name) -> std::string
+    {
+        return _columns.at(_name).get<std::string>();
+    } // string_at
+
+    // Binds one column of every replica as an array of strings. nanodbc copies the strings.
+    template <typename Projection>
+    auto bind_strings(nanodbc::statement& _statement,
+                      short _index,
+                      const std::vector<dof::replica_update>& _replicas,
+                      Projection _projection) -> void
+    {
+        std::vector<std::string> values;
+        values.reserve(_replicas.size());
+
+        for (auto&& r : _replicas) {
+            values.push_back(_projection(r));
+        }
+
+        _statement.bind_strings(_index, values);
+    } // bind_strings
+
+    // Binds one column of every replica as an array of numbers. The values must outlive the
+    // execution of the statement.
+    template <typename T, typename Projection>
+    auto bind_numbers(nanodbc::statement& _statement,
+                      short _index,
+                      const std::vector<dof::replica_update>& _replicas,
+                      std::vector<T>& _values,
+                      Projection _projection) -> void
+    {
+        _values.reserve(_replicas.size());
+
+        for (auto&& r : _replicas) {
+            _values.push_back(_projection(r));
+        }
+
+        _statement.bind(_index, _values.data(), _values.size());
+    } // bind_numbers
+
+    // Applies the difference in quota usage between the "before" and "after" states of
+    // the replicas. Mirrors the quota accounting of the mod_data_obj_meta database operation.
+    auto update_quota_usage(nanodbc::connection& _db_conn,
+                            const std::string& _db_type,
+                            const std::vector<dof::replica_update>& _replicas) -> void
+    {
+        std::map<std::tuple<std::string, std::string>, std::int64_t> user_ids;
+
+        const auto get_user_id = [&](const dof::replica_row& _r) -> std::int64_t
+        {
+            if (const auto iter = user_ids.find({_r.data_owner_name, _r.data_owner_zone}); iter != std::end(user_ids)) {
+                return iter->second;
+            }
+
+            nanodbc::statement statement{_db_conn};
+            prepare(statement, "select user_id from R_USER_MAIN where user_name = ? and zone_name = ?");
+            statement.bind(0, _r.data_owner_name.c_str());
+            statement.bind(1, _r.data_owner_zone.c_str());
+
+            auto row = execute(statement);
+            if (!row.next()) {
+                THROW(CAT_INVALID_USER, fmt::format("unknown data object owner [{}#{}]", _r.data_owner_name, _r.data_owner_zone));
+            }
+
+            return user_ids[{_r.data_owner_name, _r.data_owner_zone}] = row.get<std::int64_t>(0);
+        };
+
+        quota_usage::usage_map before;
+        quota_usage::usage_map after;
+
+        for (auto&& r : _replicas) {
+            before[{get_user_id(r.before), r.before.resc_id}] += r.before.data_size;
+            after[{get_user_id(r.after), r.after.resc_id}] += r.after.data_size;
+        }
+
+        const auto deltas = quota_usage::difference(before, after);
+        if (deltas.empty()) {
+            return;
+        }
+
+        const auto modify_ts = current_time();
+
+        for (auto&& [key, delta] : deltas) {
+            const auto& [user_id, resc_id] = key;
+
+            nanodbc::statement usage_statement{_db_conn};
+            prepare(usage_statement, quota_usage::usage_delta_statement(_db_type));
+            usage_statement.bind(0, &delta);
+            usage_statement.bind(1, &resc_id);
+            usage_statement.bind(2, &user_id);
+            usage_statement.bind(3, modify_ts.c_str());
+            execute(usage_statement);
+
+            nanodbc::statement over_statement{_db_conn};
+            prepare(over_statement, quota_usage::over_quota_delta_statement());
+            over_statement.bind(0, &delta);
+            over_statement.bind(1, modify_ts.c_str());
+            over_statement.bind(2, &resc_id);
+            over_statement.bind(3, &user_id);
+            over_statement.bind(4, &user_id);
+            execute(over_statement);
+        }
+    } // update_quota_usage
+
+    auto set_file_object_keywords(const json& _src, irods::file_object_ptr _obj) -> void
+    {
+        irods::log(LOG_DEBUG9, fmt::format("[{}:{}] - src:[{}]", __FUNCTION__, __LINE__, _src.dump()));
+
+        const auto src = irods::experimental::make_key_value_proxy(*irods::to_key_value_pair(_src));
+
+        // Template argument deduction is ambiguous here because cond_input() is overloaded
+        auto out = irods::experimental::make_key_value_proxy<KeyValPair>(_obj->cond_input());
+
+        if (src.contains(ADMIN_KW)) {
+            out[ADMIN_KW] = src.at(ADMIN_KW);
+        }
+        if (src.contains(IN_PDMO_KW)) {
+            _obj->in_pdmo(src.at(IN_PDMO_KW).value().data());
+            out[IN_PDMO_KW] = src.at(IN_PDMO_KW);
+        }
+        if (src.contains(OPEN_TYPE_KW)) {
+            out[OPEN_TYPE_KW] = src.at(OPEN_TYPE_KW);
+        }
+        if (src.contains(SYNC_OBJ_KW)) {
+            out[SYNC_OBJ_KW] = src.at(SYNC_OBJ_KW);
+        }
+        if (src.contains(REPL_STATUS_KW)) {
+            out[REPL_STATUS_KW] = src.at(REPL_STATUS_KW);
+        }
+        if (src.contains(IN_REPL_KW)) {
+            out[IN_REPL_KW] = src.at(IN_REPL_KW);
+        }
+    } // set_file_object_keywords
+
+    auto invoke_file_modified(RsComm& _comm, const std::vector<dof::replica_update>& _replicas) -> int
+    {
+        try {
+            for (auto&& replica : _replicas) {
+                if (replica.file_modified.is_null()) {
+                    continue;
+                }
+
+                auto obj = irods::file_object_factory(_comm, replica.before.data_id);
+
+                obj->resc_hier(resc_mgr.leaf_id_to_hier(replica.after.resc_id));
+
+                set_file_object_keywords(replica.file_modified, obj);
+
+                const auto obj_cond_input = irods::experimental::make_key_value_proxy(obj->cond_input());
+                if (obj_cond_input.contains(IN_REPL_KW) ||
+                    (obj_cond_input.contains(OPEN_TYPE_KW) &&
+                     obj_cond_input.at(OPEN_TYPE_KW).value() == std::to_string(OPEN_FOR_READ_TYPE))) {
+                    return 0;
+                }
+
+                if (const auto ret = fileModified(&_comm, obj); !ret.ok()) {
+                    irods::log(LOG_ERROR, fmt::format(
+                        "[{}] - failed to signal the resource that [{}] on [{}] was modified",
+                        __FUNCTION__, obj->logical_path(), obj->resc_hier()));
+
+                    return ret.code();
+                }
+
+                irods::log(LOG_DEBUG, fmt::format(
+                    "[{}:{}] - fileModified complete,obj:[{}],hier:[{}]",
+                    __FUNCTION__, __LINE__, obj->logical_path(), obj->resc_hier()));
+
+                // TODO: consider more than one?
+                return 0;
+            }
+
+            irods::log(LOG_DEBUG, fmt::format("[{}:{}] - no fileModified", __FUNCTION__, __LINE__));
+
+            return 0;
+        }
+        catch (const irods::exception& e) {
+            irods::log(e);
+            return e.code();
+        }
+        catch (const std::exception& e) {
+            irods::log(LOG_ERROR, fmt::format("[{}] - [{}]", __FUNCTION__, e.what()));
+            return SYS_INTERNAL_ERR;
+        }
+    } // invoke_file_modified
+
+    auto forward_to_catalog_provider(RsComm& _comm, const dof::input& _input) -> std::tuple<json, int>
+    {
+        log::api::trace("Redirecting request to catalog service provider ...");
+
+        auto host_info = ic::redirect_to_catalog_provider(_comm);
+
+        char* json_output{};
+
+        const auto ec = rc_data_object_finalize(host_info.conn, dof::to_json(_input).dump().c_str(), &json_output);
+
+        auto output = json_output ? json::parse(json_output) : make_error_object();
+        std::free(json_output);
+
+        return {std::move(output), ec};
+    } // forward_to_catalog_provider
+} // anonymous namespace
+
+namespace irods::experimental::catalog::data_object_finalize
+{
+    auto to_replica_row(const json& _columns) -> replica_row
+    {
+        try {
+            replica_row r;
+
+            r.data_id         = bigint_at(_columns, "data_id");
+            r.coll_id         = _columns.contains("coll_id") ? bigint_at(_columns, "coll_id") : 0;
+            r.data_name       = _columns.value("data_name", "");
+            r.data_repl_num   = integer_at(_columns, "data_repl_num");
+            r.data_version    = string_at(_columns, "data_version");
+            r.data_type_name  = string_at(_columns, "data_type_name");
+            r.data_size       = bigint_at(_columns, "data_size");
+            r.data_path       = string_at(_columns, "data_path");
+            r.data_owner_name = string_at(_columns, "data_owner_name");
+            r.data_owner_zone = string_at(_columns, "data_owner_zone");
+            r.data_is_dirty   = integer_at(_columns, "data_is_dirty");
+            r.data_status     = string_at(_columns, "data_status");
+            r.data_checksum   = string_at(_columns, "data_checksum");
+            r.data_expiry_ts  = string_at(_columns, "data_expiry_ts");
+            r.data_map_id     = bigint_at(_columns, "data_map_id");
+            r.data_mode       = string_at(_columns, "data_mode");
+            r.r_comment       = string_at(_columns, "r_comment");
+            r.create_ts       = string_at(_columns, "create_ts");
+            r.modify_ts       = string_at(_columns, "modify_ts");
+            r.resc_id         = bigint_at(_columns, "resc_id");
+
+            return r;
+        }
+        catch (const json::exception& e) {
+            THROW(SYS_INVALID_INPUT_PARAM, fmt::format("[{}:{}] - invalid replica [{}]", __FUNCTION__, __LINE__, e.what()));
+        }
+        catch (const std::logic_error& e) {
+            THROW(SYS_INVALID_INPUT_PARAM, fmt::format("[{}:{}] - invalid number in replica [{}]", __FUNCTION__, __LINE__, e.what()));
+        }
+    } // to_replica_row
+
+    auto to_json(const replica_row& _row) -> json
+    {
+        return json{
+            {"data_id",         std::to_string(_row.data_id)},
+            {"coll_id",         std::to_string(_row.coll_id)},
+            {"data_name",       _row.data_name},
+            {"data_repl_num",   std::to_string(_row.data_repl_num)},
+            {"data_version",    _row.data_version},
+            {"data_type_name",  _row.data_type_name},
+            {"data_size",       std::to_string(_row.data_size)},
+            {"data_path",       _row.data_path},
+            {"data_owner_name", _row.data_owner_name},
+            {"data_owner_zone", _row.data_owner_zone},
+            {"data_is_dirty",   std::to_string(_row.data_is_dirty)},
+            {"data_status",     _row.data_status},
+            {"data_checksum",   _row.data_checksum},
+            {"data_expiry_ts",  _row.data_expiry_ts},
+            {"data_map_id",     std::to_string(_row.data_map_id)},
+            {"data_mode",       _row.data_mode},
+            {"r_comment",       _row.r_comment},
+            {"create_ts",       _row.create_ts},
+            {"modify_ts",       _row.modify_ts},
+            {"resc_id",         std::to_string(_row.resc_id)}
+        };
+    } // to_json
+
+    auto to_input(const json& _input) -> input
+    {
+        try {
+            input in;
+
+            in.privileged = _input.contains("irods_admin") && _input.at("irods_admin").get<bool>();
+            in.bytes_written = _input.contains("bytes_written") ? std::stoll(_input.at("bytes_written").get<std::string>()) : 0;
+            in.trigger_file_modified = _input.contains("trigger_file_modified") && _input.at("trigger_file_modified").get<bool>();
+
+            const auto& replicas = _input.at("replicas");
+
+            if (!replicas.is_array() || replicas.empty()) {
+                THROW(SYS_INVALID_INPUT_PARAM, "replicas must be a non-empty array");
+            }
+
+            in.replicas.reserve(replicas.size());
+
+            for (auto&& r : replicas) {
+                auto& u = in.replicas.emplace_back();
+
+                u.before = to_replica_row(r.at("before"));
+                u.after = to_replica_row(r.at("after"));
+
+                if (r.contains(FILE_MODIFIED_KW)) {
+                    u.file_modified = r.at(FILE_MODIFIED_KW);
+                }
+            }
+
+            return in;
+        }
+        catch (const json::exception& e) {
+            THROW(SYS_INVALID_INPUT_PARAM, e.what());
+        }
+        catch (const std::logic_error& e) {
+            THROW(SYS_INVALID_INPUT_PARAM, e.what());
+        }
+    } // to_input
+
+    auto to_json(const input& _input) -> json
+    {
+        auto replicas = json::array();
+
+        for (auto&& r : _input.replicas) {
+            auto j = json{{"before", to_json(r.before)}, {"after", to_json(r.after)}};
+
+            if (!r.file_modified.is_null()) {
+                j[FILE_MODIFIED_KW] = r.file_modified;
+            }
+
+            replicas.push_back(std::move(j));
+        }
+
+        return json{
+            {"irods_admin", _input.privileged},
+            {"bytes_written", std::to_string(_input.bytes_written)},
+            {"replicas", std::move(replicas)},
+            {"trigger_file_modified", _input.trigger_file_modified}
+        };
+    } // to_json
+
+    auto write_replicas(nanodbc::connection& _db_conn,
+                        const std::string& _db_type,
+                        std::vector<replica_update>& _replicas) -> void
+    {
+        if (_replicas.empty()) {
+            return;
+        }
+
+        for (auto&& r : _replicas) {
+            if (SET_TIME_TO_NOW_KW == r.after.modify_ts) {
+                r.after.modify_ts = current_time();
+            }
+        }
+
+        log::database::debug("statement:[{}],replicas:[{}]", update_replicas_statement, _replicas.size());
+
+        nanodbc::statement statement{_db_conn};
+        prepare(statement, update_replicas_statement);
+
+        // nanodbc reads numeric parameters from these arrays when the statement executes.
+        std::vector<int> repl_nums;
+        std::vector<int> is_dirty;
+        std::vector<std::int64_t> sizes;
+        std::vector<std::int64_t> map_ids;
+        std::vector<std::int64_t> resc_ids;
+        std::vector<std::int64_t> where_data_ids;
+        std::vector<std::int64_t> where_resc_ids;
+
+        // clang-format off
+        bind_numbers(statement,  0, _replicas, repl_nums,      [](auto& _r) { return _r.after.data_repl_num; });
+        bind_strings(statement,  1, _replicas,                 [](auto& _r) { return _r.after.data_version; });
+        bind_strings(statement,  2, _replicas,                 [](auto& _r) { return _r.after.data_type_name; });
+        bind_numbers(statement,  3, _replicas, sizes,          [](auto& _r) { return _r.after.data_size; });
+        bind_strings(statement,  4, _replicas,                 [](auto& _r) { return _r.after.data_path; });
+        bind_strings(statement,  5, _replicas,                 [](auto& _r) { return _r.after.data_owner_name; });
+        bind_strings(statement,  6, _replicas,                 [](auto& _r) { return _r.after.data_owner_zone; });
+        bind_numbers(statement,  7, _replicas, is_dirty,       [](auto& _r) { return _r.after.data_is_dirty; });
+        bind_strings(statement,  8, _replicas,                 [](auto& _r) { return _r.after.data_status; });
+        bind_strings(statement,  9, _replicas,                 [](auto& _r) { return _r.after.data_checksum; });
+        bind_strings(statement, 10, _replicas,                 [](auto& _r) { return _r.after.data_expiry_ts; });
+        bind_numbers(statement, 11, _replicas, map_ids,        [](auto& _r) { return _r.after.data_map_id; });
+        bind_strings(statement, 12, _replicas,                 [](auto& _r) { return _r.after.data_mode; });
+        bind_strings(statement, 13, _replicas,                 [](auto& _r) { return _r.after.r_comment; });
+        bind_strings(statement, 14, _replicas,                 [](auto& _r) { return _r.after.create_ts; });
+        bind_strings(statement, 15, _replicas,                 [](auto& _r) { return _r.after.modify_ts; });
+        bind_numbers(statement, 16, _replicas, resc_ids,       [](auto& _r) { return _r.after.resc_id; });
+        bind_numbers(statement, 17, _replicas, where_data_ids, [](auto& _r) { return _r.before.data_id; });
+        bind_numbers(statement, 18, _replicas, where_resc_ids, [](auto& _r) { return _r.before.resc_id; });
+        // clang-format on
+
+        execute(statement, static_cast<long>(_replicas.size()));
+
+        if (quota_usage::incremental()) {
+            update_quota_usage(_db_conn, _db_type, _replicas);
+        }
+    } // write_replicas
+
+    auto finalize(RsComm& _comm, input& _input) -> std::tuple<json, int>
+    {
+        if (_input.replicas.empty()) {
+            return {make_error_object("no replicas provided"), SYS_INVALID_INPUT_PARAM};
+        }
+
+        // Connect to the catalog provider before proceeding as this operation
+        // deals almost exclusively in database transactions.
+        try {
+            if (!ic::connected_to_catalog_provider(_comm)) {
+                return forward_to_catalog_provider(_comm, _input);
+            }
+
+            ic::throw_if_catalog_provider_service_role_is_invalid();
+        }
+        catch (const irods::exception& e) {
+            const std::string_view msg = e.client_display_what();
+
+            irods::log(LOG_ERROR, fmt::format("[{}:{}] - [{}]", __FUNCTION__, __LINE__, msg));
+
+            return {make_error_object(msg), e.code()};
+        }
+
+        if (_input.privileged && !irods::is_privileged_client(_comm)) {
+            const auto msg = "user is not authorized to use the admin keyword";
+
+            irods::log(LOG_WARNING, fmt::format("[{}:{}] - [{}]", __FUNCTION__, __LINE__, msg));
+
+            return {make_error_object(msg), CAT_INSUFFICIENT_PRIVILEGE_LEVEL};
+        }
+
+        // Establish connection with the database for use with nanodbc.
+        // A connection with the database is already established via the
+        // RsComm, but this allows us to atomically update the database
+        // without the complicated machinery of the existing database plugin.
+        std::string db_type;
+        nanodbc::connection db_conn;
+        try {
+            std::tie(db_type, db_conn) = ic::new_database_connection();
+        }
+        catch (const std::exception& e) {
+            const auto msg = e.what();
+
+            irods::log(LOG_ERROR, fmt::format("[{}:{}] - [{}]", __FUNCTION__, __LINE__, msg));
+
+            return {make_error_object(msg), SYS_CONFIG_FILE_ERR};
+        }
+
+        // This section perform permissions checks and update ticket information
+        // only if not running in privileged mode. This matches the behavior of
+        // the mod_data_obj_meta database operation.
+        if (!_input.privileged) {
+            const auto data_id = _input.replicas.front().before.data_id;
+
+            // If the caller indicates that bytes have been written (equivalent
+            // to updating the size), the information for any existing session
+            // ticket should be updated to reflect the new write byte count.
+            if (_input.bytes_written) {
+                if (const auto ec = chl_update_ticket_write_byte_count(_comm, data_id, _input.bytes_written); ec != 0) {
+                    const auto msg = fmt::format("failed to update write_bytes_count on ticket [data_id=[{}]]", data_id);
+
+                    irods::log(LOG_NOTICE, fmt::format("[{}:{}] - [{}]", __FUNCTION__, __LINE__, msg));
+
+                    return {make_error_object(msg), ec};
+                }
+            }
+
+            // Make sure the user has permission to modify this data object
+            // before proceeding. This database operation also updates ticket
+            // information and checks to make sure the limit for write byte
+            // count has not been exceeded.
+            if (const auto ec = chl_check_permission_to_modify_data_object(_comm, data_id); ec != 0) {
+                const auto msg = fmt::format("user not allowed to modify data object [data id=[{}]]", data_id);
+
+                irods::log(LOG_NOTICE, fmt::format("[{}:{}] - [{}]", __FUNCTION__, __LINE__, msg));
+
+                return {make_error_object(msg), ec};
+            }
+        }
+
+        // Actually update the catalog with the information passed in. This is done
+        // transactionally so that the update occurs atomically.
+        try {
+            const auto ec = ic::execute_transaction(db_conn, [&](auto& _trans) -> int
+            {
+                try {
+                    write_replicas(db_conn, db_type, _input.replicas);
+
+                    irods::log(LOG_DEBUG10, "committing transaction");
+                    _trans.commit();
+
+                    return 0;
+                }
+                catch (const irods::exception&) {
+                    throw;
+                }
+                catch (const nanodbc::database_error& e) {
+                    THROW(SYS_LIBRARY_ERROR, fmt::format(
+                        "[{}:{}] - database error occurred [{}]",
+                        __FUNCTION__, __LINE__, e.what()));
+                }
+                catch (const std::exception& e) {
+                    THROW(SYS_INTERNAL_ERR, fmt::format(
+                        "[{}:{}] - exception occurred [{}]",
+                        __FUNCTION__, __LINE__, e.what()));
+                }
+            });
+
+            if (ec < 0) {
+                return {make_error_object("failed to update catalog"), ec};
+            }
+
+            if (!_input.trigger_file_modified) {
+                // If the update was successful and file modified is not supposed to be
+                // triggered, then we can return with success here.
+                return {make_error_object("", database_updated), ec};
+            }
+        }
+        catch (const irods::exception& e) {
+            const auto msg = e.client_display_what();
+
+            irods::log(LOG_ERROR, fmt::format("[{}:{}] - [{}]", __FUNCTION__, __LINE__, msg));
+
+            return {make_error_object(msg), e.code()};
+        }
+
+        // file_modified is handled separately so that the caller can differentiate
+        // between errors which occurred before and after the failure of the database
+        // transaction. In this case, the database transaction was successful, but some
+        // operation as a result of file_modified has failed.
+        if (const auto ec = invoke_file_modified(_comm, _input.replicas); ec < 0) {
+            return {make_error_object("error occurred during file_modified operation", database_updated), ec};
+        }
+
+        return {make_error_object("", database_updated), 0};
+    } // finalize
+} // namespace irods::experimental::catalog::data_object_finalize
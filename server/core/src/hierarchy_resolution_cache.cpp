@@ -0,0 +1,274 @@
+#include "hierarchy_resolution_cache.hpp"
+
+#include "irods_resource_redirect.hpp"
+#include "irods_server_properties.hpp"
+#include "rcConnect.h"
+#include "rcMisc.h"
+#include "replica_state_table.hpp"
+
+#include "fmt/format.h"
+
+#include <fcntl.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace irods::hierarchy_resolution_cache
+{
+    namespace
+    {
+        using clock_type = std::chrono::steady_clock;
+
+        // Deep copies a linked list of replicas.
+        auto duplicate(const DataObjInfo* _head) -> DataObjInfo*
+        {
+            DataObjInfo* copy_head{};
+            DataObjInfo* copy_tail{};
+
+            for (auto* p = _head; p; p = p->next) {
+                auto* copy = static_cast<DataObjInfo*>(std::malloc(sizeof(DataObjInfo)));
+                std::memcpy(copy, p, sizeof(DataObjInfo));
+
+                copy->next = nullptr;
+                copy->condInput = {};
+                replKeyVal(&p->condInput, &copy->condInput);
+
+                if (p->specColl) {
+                    copy->specColl = static_cast<specColl_t*>(std::malloc(sizeof(specColl_t)));
+                    std::memcpy(copy->specColl, p->specColl, sizeof(specColl_t));
+                }
+
+                if (copy_tail) {
+                    copy_tail->next = copy;
+                }
+                else {
+                    copy_head = copy;
+                }
+
+                copy_tail = copy;
+            }
+
+            return copy_head;
+        } // duplicate
+
+        struct entry
+        {
+            std::string logical_path;
+            rodsLong_t data_id;
+            irods::file_object_ptr file_obj;
+            std::string hierarchy;
+            std::unique_ptr<DataObjInfo, int(*)(DataObjInfo*)> data_obj_info{nullptr, freeAllDataObjInfo};
+            clock_type::time_point expiration;
+        }; // struct entry
+
+        // The maximum number of entries held at any moment. The oldest entries are
+        // dropped first when the cache is full.
+        constexpr std::size_t max_entries = 1000;
+
+        // Global Variables
+        clock_type::duration eviction_age{};
+        std::map<std::string, entry> cache;
+        statistics stats{};
+
+        std::mutex cache_mutex;
+
+        // The key covers everything that can influence the outcome of the vote: the
+        // object, the operation, the client (permissions) and every keyword.
+        auto make_key(const RsComm& _comm, std::string_view _operation, const DataObjInp& _input) -> std::string
+        {
+            std::vector<std::pair<std::string_view, std::string_view>> keywords;
+            keywords.reserve(_input.condInput.len);
+
+            for (int i = 0; i < _input.condInput.len; ++i) {
+                keywords.emplace_back(_input.condInput.keyWord[i],
+                                      _input.condInput.value[i] ? _input.condInput.value[i] : "");
+            }
+
+            std::sort(std::begin(keywords), std::end(keywords));
+
+            auto key = fmt::format("{}\n{}\n{}#{}\n{}#{}\n{}",
+                                   _input.objPath, _operation,
+                                   _comm.clientUser.userName, _comm.clientUser.rodsZone,
+                                   _comm.proxyUser.userName, _comm.proxyUser.rodsZone,
+                                   _input.oprType);
+
+            for (auto&& [k, v] : keywords) {
+                key += fmt::format("\n{}={}", k, v);
+            }
+
+            return key;
+        } // make_key
+
+        // The caller must hold cache_mutex.
+        auto erase_if(std::function<bool(const entry&)> _pred) -> void
+        {
+            for (auto it = std::begin(cache); it != std::end(cache);) {
+                if (_pred(it->second)) {
+                    it = cache.erase(it);
+                    ++stats.invalidations;
+                }
+                else {
+                    ++it;
+                }
+            }
+        } // erase_if
+
+        auto evict_expired_entries() -> void
+        {
+            const auto now = clock_type::now();
+            erase_if([now](const entry& _e) { return _e.expiration <= now; });
+        } // evict_expired_entries
+    } // anonymous namespace
+
+    auto init() -> void
+    {
+        std::scoped_lock lock{cache_mutex};
+
+        eviction_age = std::chrono::seconds{irods::get_hierarchy_resolution_cache_eviction_age()};
+        cache.clear();
+        stats = {};
+    } // init
+
+    auto deinit() -> void
+    {
+        std::scoped_lock lock{cache_mutex};
+
+        cache.clear();
+    } // deinit
+
+    auto enabled() noexcept -> bool
+    {
+        return eviction_age > clock_type::duration::zero();
+    } // enabled
+
+    auto is_cacheable(std::string_view _operation, const DataObjInp& _input) -> bool
+    {
+        return enabled() &&
+               irods::OPEN_OPERATION == _operation &&
+               (_input.openFlags & O_ACCMODE) == O_RDONLY &&
+               !(_input.openFlags & (O_CREAT | O_TRUNC));
+    } // is_cacheable
+
+    auto lookup(RsComm& _comm,
+                std::string_view _operation,
+                const DataObjInp& _input,
+                DataObjInfo** _data_obj_info)
+        -> std::optional<std::tuple<irods::file_object_ptr, std::string>>
+    {
+        std::scoped_lock lock{cache_mutex};
+
+        const auto iter = cache.find(make_key(_comm, _operation, _input));
+
+        if (iter == std::end(cache)) {
+            ++stats.misses;
+            return std::nullopt;
+        }
+
+        auto& e = iter->second;
+
+        // The data object may have been opened for writing since it was cached.
+        if (e.expiration <= clock_type::now() || irods::replica_state_table::contains(e.data_id)) {
+            cache.erase(iter);
+            ++stats.invalidations;
+            ++stats.misses;
+            return std::nullopt;
+        }
+
+        // The entry was cached by a caller that did not ask for the replica list.
+        if (_data_obj_info && !e.data_obj_info) {
+            ++stats.misses;
+            return std::nullopt;
+        }
+
+        // Callers are free to modify what they receive, so hand out copies.
+        if (_data_obj_info) {
+            *_data_obj_info = duplicate(e.data_obj_info.get());
+        }
+
+        irods::file_object_ptr file_obj{new irods::file_object{*e.file_obj}};
+        file_obj->comm(&_comm);
+
+        ++stats.hits;
+
+        return std::make_tuple(file_obj, e.hierarchy);
+    } // lookup
+
+    auto insert(RsComm& _comm,
+                std::string_view _operation,
+                const DataObjInp& _input,
+                const irods::file_object_ptr& _file_obj,
+                const std::string& _hierarchy,
+                const DataObjInfo* _data_obj_info) -> void
+    {
+        // Special collections do not produce a file object.
+        if (!_file_obj || _hierarchy.empty()) {
+            return;
+        }
+
+        if (irods::replica_state_table::contains(_file_obj->data_id())) {
+            return;
+        }
+
+        std::scoped_lock lock{cache_mutex};
+
+        if (cache.size() >= max_entries) {
+            evict_expired_entries();
+
+            if (cache.size() >= max_entries) {
+                const auto oldest = std::min_element(std::begin(cache), std::end(cache), [](auto&& _lhs, auto&& _rhs) {
+                    return _lhs.second.expiration < _rhs.second.expiration;
+                });
+
+                cache.erase(oldest);
+                ++stats.invalidations;
+            }
+        }
+
+        entry e;
+        e.logical_path = _input.objPath;
+        e.data_id = _file_obj->data_id();
+        e.file_obj.reset(new irods::file_object{*_file_obj});
+        e.hierarchy = _hierarchy;
+        e.data_obj_info.reset(duplicate(_data_obj_info));
+        e.expiration = clock_type::now() + eviction_age;
+
+        cache.insert_or_assign(make_key(_comm, _operation, _input), std::move(e));
+    } // insert
+
+    auto erase(std::string_view _logical_path) -> void
+    {
+        std::scoped_lock lock{cache_mutex};
+
+        erase_if([_logical_path](const entry& _e) { return _e.logical_path == _logical_path; });
+    } // erase
+
+    auto erase(rodsLong_t _data_id) -> void
+    {
+        std::scoped_lock lock{cache_mutex};
+
+        erase_if([_data_id](const entry& _e) { return _e.data_id == _data_id; });
+    } // erase
+
+    auto clear() -> void
+    {
+        std::scoped_lock lock{cache_mutex};
+
+        stats.invalidations += cache.size();
+        cache.clear();
+    } // clear
+
+    auto get_statistics() -> statistics
+    {
+        std::scoped_lock lock{cache_mutex};
+
+        return stats;
+    } // get_statistics
+} // namespace irods::hierarchy_resolution_cache
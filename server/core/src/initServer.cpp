@@ -34,6 +34,9 @@
 #include "irods_threads.hpp"
 #include "key_value_proxy.hpp"
 #include "replica_state_table.hpp"
+#include "hierarchy_resolution_cache.hpp"
+#include "catalog_permission_cache.hpp"
+#include "read_ahead_buffer.hpp"
 
 #define IRODS_REPLICA_ENABLE_SERVER_SIDE_API
 #include "replica_proxy.hpp"
@@ -577,6 +580,9 @@ initAgent( int processType, rsComm_t *rsComm ) {
     }
 
     irods::replica_state_table::init();
+    irods::hierarchy_resolution_cache::init();
+    irods::catalog_permission_cache::init();
+    irods::read_ahead_buffer::init();
     initL1desc();
     initSpecCollDesc();
     status = initFileDesc();
@@ -664,6 +670,37 @@ cleanup() {
 
         irods::replica_state_table::deinit();
 
+        if (irods::hierarchy_resolution_cache::enabled()) {
+            const auto stats = irods::hierarchy_resolution_cache::get_statistics();
+            rodsLog(LOG_DEBUG, "Hierarchy resolution cache statistics [hits=%llu, misses=%llu, invalidations=%llu].",
+                    static_cast<unsigned long long>(stats.hits),
+                    static_cast<unsigned long long>(stats.misses),
+                    static_cast<unsigned long long>(stats.invalidations));
+        }
+
+        irods::hierarchy_resolution_cache::deinit();
+
+        if (irods::catalog_permission_cache::enabled()) {
+            const auto stats = irods::catalog_permission_cache::get_statistics();
+            rodsLog(LOG_DEBUG, "Catalog permission cache statistics [hits=%llu, misses=%llu, invalidations=%llu].",
+                    static_cast<unsigned long long>(stats.hits),
+                    static_cast<unsigned long long>(stats.misses),
+                    static_cast<unsigned long long>(stats.invalidations));
+        }
+
+        irods::catalog_permission_cache::deinit();
+
+        if (irods::read_ahead_buffer::enabled()) {
+            const auto stats = irods::read_ahead_buffer::get_statistics();
+            rodsLog(LOG_DEBUG, "Read-ahead buffer statistics [hits=%llu, misses=%llu, fills=%llu, discards=%llu].",
+                    static_cast<unsigned long long>(stats.hits),
+                    static_cast<unsigned long long>(stats.misses),
+                    static_cast<unsigned long long>(stats.fills),
+                    static_cast<unsigned long long>(stats.discards));
+        }
+
+        irods::read_ahead_buffer::deinit();
+
         disconnectAllSvrToSvrConn();
     }
 
@@ -958,7 +995,7 @@ initRsCommWithStartupPack( rsComm_t *rsComm, startupPack_t *startupPack ) {
         }
         rsComm->irodsProt = ( irodsProt_t )atoi( tmpStr );
 
-        if (rsComm->irodsProt != NATIVE_PROT && rsComm->irodsProt != XML_PROT) {
+        if (rsComm->irodsProt != NATIVE_PROT && rsComm->irodsProt != XML_PROT && rsComm->irodsProt != BINARY_PROT) {
             rodsLog( LOG_NOTICE, "initRsCommWithStartupPack: Invalid protocol value.");
             return SYS_GETSTARTUP_PACK_ERR;
         }
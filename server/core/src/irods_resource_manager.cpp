@@ -20,10 +20,13 @@
 #include "miscServerFunct.hpp"
 #include "genQuery.h"
 
+#include "irods_server_properties.hpp"
+
 #include "fmt/format.h"
 
 // =-=-=-=-=-=-=-
 // stl includes
+#include <chrono>
 #include <iostream>
 #include <vector>
 #include <iterator>
@@ -72,6 +75,8 @@ namespace irods
             return ERROR( SYS_INVALID_INPUT_PARAM, "empty key" );
         }
 
+        instantiate_tree_for_resource( _key );
+
         if ( resource_name_map_.has_entry( _key ) ) {
             _value = resource_name_map_[ _key ];
             return SUCCESS();
@@ -92,6 +97,8 @@ namespace irods
     error resource_manager::resolve(
         rodsLong_t    _resc_id,
         resource_ptr& _value ) {
+        instantiate_tree_for_resource( _resc_id );
+
         if ( resource_id_map_.has_entry( _resc_id ) ) {
             _value = resource_id_map_[ _resc_id ];
             return SUCCESS();
@@ -157,6 +164,8 @@ namespace irods
             return ERROR(USER__NULL_INPUT_ERR, "empty server host");
         }
 
+        instantiate_all_resources();
+
         // =-=-=-=-=-=-=-
         // quick check on the resource table
         if ( resource_name_map_.empty() ) {
@@ -232,13 +241,53 @@ namespace irods
     } // validate_vault_path
 
 // =-=-=-=-=-=-=-
-// public - connect to the catalog and query for all the
-//          attached resources and instantiate them
+// public - load the resource table from the resource tree snapshot, or
+//          the catalog if the snapshot is not available. plugins are
+//          loaded when a resource of their tree is first used.
     error resource_manager::init_from_catalog( rsComm_t* _comm ) {
+        namespace snapshot = irods::experimental::resource_tree_snapshot;
+
         // =-=-=-=-=-=-=-
         // clear existing resource map and initialize
         resource_name_map_.clear();
+        resource_id_map_.clear();
+        pending_trees_.clear();
+        pending_root_by_name_.clear();
+        pending_root_by_id_.clear();
+
+        std::vector< resource_record > records;
+
+        if ( auto cached = snapshot::load(); cached ) {
+            records = std::move( *cached );
+        }
+        else {
+            // =-=-=-=-=-=-=-
+            // capture the generation first so that a snapshot built from
+            // results which raced with an admin change is never stored
+            const auto generation = snapshot::generation();
+
+            error ret = query_resource_records( _comm, records );
+            if ( !ret.ok() ) {
+                return PASS( ret );
+            }
+
+            const std::chrono::seconds expires_after{ get_resource_tree_snapshot_eviction_age() };
+            snapshot::store( records, generation, expires_after );
+        }
+
+        add_pending_resources( records );
+
+        // =-=-=-=-=-=-=-
+        // win!
+        return SUCCESS();
 
+    } // init_from_catalog
+
+// =-=-=-=-=-=-=-
+// private - query the catalog for all the attached resources
+    error resource_manager::query_resource_records(
+        rsComm_t*                       _comm,
+        std::vector< resource_record >& _records ) {
         // =-=-=-=-=-=-=-
         // set up data structures for a gen query
         genQueryInp_t  genQueryInp;
@@ -296,13 +345,13 @@ namespace irods
             } // if
 
             // =-=-=-=-=-=-=-
-            // given a series of rows, each being a resource, create a resource and add it to the table
-            proc_ret = process_init_results( genQueryOut );
+            // given a series of rows, each being a resource, extract the values of each row
+            proc_ret = process_init_results( genQueryOut, _records );
 
             // =-=-=-=-=-=-=-
             // if error is not valid, clear query and bail
             if ( !proc_ret.ok() ) {
-                irods::error log_err = PASSMSG( "init_from_catalog - process_init_results failed", proc_ret );
+                irods::error log_err = PASSMSG( "query_resource_records - process_init_results failed", proc_ret );
                 irods::log( log_err );
                 freeGenQueryOut( &genQueryOut );
                 break;
@@ -329,32 +378,9 @@ namespace irods
             return PASSMSG( "process_init_results failed.", proc_ret );
         }
 
-        // =-=-=-=-=-=-=-
-        // Update child resource maps
-        proc_ret = init_child_map();
-        if ( !proc_ret.ok() ) {
-            return PASSMSG( "init_child_map failed.", proc_ret );
-        }
-
-        // =-=-=-=-=-=-=-
-        // gather the post disconnect maintenance operations
-        error op_ret = gather_operations();
-        if ( !op_ret.ok() ) {
-            return PASSMSG( "gather_operations failed.", op_ret );
-        }
-
-        // =-=-=-=-=-=-=-
-        // call start for plugins
-        error start_err = start_resource_plugins();
-        if ( !start_err.ok() ) {
-            return PASSMSG( "start_resource_plugins failed.", start_err );
-        }
-
-        // =-=-=-=-=-=-=-
-        // win!
         return SUCCESS();
 
-    } // init_from_catalog
+    } // query_resource_records
 
 // =-=-=-=-=-=-=-
 /// @brief call shutdown on resources before destruction
@@ -377,6 +403,8 @@ namespace irods
 /// @brief create a list of resources who do not have parents ( roots )
     error resource_manager::get_root_resources(
         std::vector< std::string >& _list ) {
+        instantiate_all_resources();
+
         // =-=-=-=-=-=-=-
         // iterate over all resources in the table
         lookup_table< boost::shared_ptr< resource > >::iterator itr;
@@ -589,8 +617,10 @@ namespace irods
     }
 
 // =-=-=-=-=-=-=-
-// public - take results from genQuery, extract values and create resources
-    error resource_manager::process_init_results( genQueryOut_t* _result ) {
+// private - take results from genQuery and extract the values of each row
+    error resource_manager::process_init_results(
+        genQueryOut_t*                  _result,
+        std::vector< resource_record >& _records ) {
         // =-=-=-=-=-=-=-
         // extract results from query
         if ( !_result ) {
@@ -675,94 +705,230 @@ namespace irods
         }
 
         // =-=-=-=-=-=-=-
-        // iterate through the rows, initialize a resource for each entry
+        // iterate through the rows, extract a record for each entry
+        _records.reserve( _records.size() + _result->rowCnt );
+
         for ( int i = 0; i < _result->rowCnt; ++i ) {
-            // =-=-=-=-=-=-=-
-            // extract row values
-            std::string tmpRescId        = &rescId->value[ rescId->len * i ];
-            std::string tmpRescLoc       = &rescLoc->value[ rescLoc->len * i ];
-            std::string tmpRescName      = &rescName->value[ rescName->len * i ];
-            std::string tmpZoneName      = &zoneName->value[ zoneName->len * i ];
-            std::string tmpRescType      = &rescType->value[ rescType->len * i ];
-            std::string tmpRescInfo      = &rescInfo->value[ rescInfo->len * i ];
-            std::string tmpFreeSpace     = &freeSpace->value[ freeSpace->len * i ];
-            std::string tmpRescClass     = &rescClass->value[ rescClass->len * i ];
-            std::string tmpRescCreate    = &rescCreate->value[ rescCreate->len * i ];
-            std::string tmpRescModify    = &rescModify->value[ rescModify->len * i ];
-            std::string tmpRescStatus    = &rescStatus->value[ rescStatus->len * i ];
-            std::string tmpRescComments  = &rescComments->value[ rescComments->len * i ];
-            std::string tmpRescVaultPath = &rescVaultPath->value[ rescVaultPath->len * i ];
-            std::string tmpRescChildren  = &rescChildren->value[ rescChildren->len * i ];
-            std::string tmpRescContext   = &rescContext->value[ rescContext->len * i ];
-            std::string tmpRescParent    = &rescParent->value[ rescParent->len * i ];
-            std::string tmpRescParentCtx = &rescParentContext->value[ rescParent->len * i ];
+            resource_record& r = _records.emplace_back();
+
+            r.id             = &rescId->value[ rescId->len * i ];
+            r.location       = &rescLoc->value[ rescLoc->len * i ];
+            r.name           = &rescName->value[ rescName->len * i ];
+            r.zone           = &zoneName->value[ zoneName->len * i ];
+            r.type           = &rescType->value[ rescType->len * i ];
+            r.info           = &rescInfo->value[ rescInfo->len * i ];
+            r.free_space     = &freeSpace->value[ freeSpace->len * i ];
+            r.class_name     = &rescClass->value[ rescClass->len * i ];
+            r.create_time    = &rescCreate->value[ rescCreate->len * i ];
+            r.modify_time    = &rescModify->value[ rescModify->len * i ];
+            r.status         = &rescStatus->value[ rescStatus->len * i ];
+            r.comments       = &rescComments->value[ rescComments->len * i ];
+            r.vault_path     = &rescVaultPath->value[ rescVaultPath->len * i ];
+            r.children       = &rescChildren->value[ rescChildren->len * i ];
+            r.context        = &rescContext->value[ rescContext->len * i ];
+            r.parent         = &rescParent->value[ rescParent->len * i ];
+            r.parent_context = &rescParentContext->value[ rescParent->len * i ];
 
-            // =-=-=-=-=-=-=-
-            // create the resource and add properties for column values
-            resource_ptr resc;
-            error ret = load_resource_plugin( resc, tmpRescType, tmpRescName, tmpRescContext );
-            if ( !ret.ok() ) {
-                irods::log(PASS(ret));
-                continue;
-            }
+        } // for i
+
+        return SUCCESS();
+
+    } // process_init_results
+
+// =-=-=-=-=-=-=-
+// private - group the records by the root of their resource tree. the
+//           plugins for a tree are loaded when one of its resources is used.
+    void resource_manager::add_pending_resources(
+        const std::vector< resource_record >& _records ) {
+        std::unordered_map< std::string, const resource_record* > record_by_id;
+        for ( const auto& r : _records ) {
+            record_by_id[ r.id ] = &r;
+        }
 
+        for ( const auto& r : _records ) {
             // =-=-=-=-=-=-=-
-            // resolve the host name into a rods server host structure
-            if ( tmpRescLoc != irods::EMPTY_RESC_HOST ) {
-                rodsHostAddr_t addr;
-                rstrcpy( addr.hostAddr, const_cast<char*>( tmpRescLoc.c_str() ), LONG_NAME_LEN );
-                rstrcpy( addr.zoneName, const_cast<char*>( tmpZoneName.c_str() ), NAME_LEN );
-
-                rodsServerHost_t* tmpRodsServerHost = 0;
-                if ( resolveHost( &addr, &tmpRodsServerHost ) < 0 ) {
-                    rodsLog( LOG_NOTICE, "procAndQueRescResult: resolveHost error for %s",
-                             addr.hostAddr );
+            // walk up to the root, guarding against cycles. a resource whose
+            // parent does not exist is treated as a root, as in init_child_map
+            const resource_record* root = &r;
+            for ( std::size_t hops = 0; !root->parent.empty() && hops < _records.size(); ++hops ) {
+                const auto itr = record_by_id.find( root->parent );
+                if ( itr == record_by_id.end() ) {
+                    break;
                 }
 
-                resc->set_property< rodsServerHost_t* >( RESOURCE_HOST, tmpRodsServerHost );
-
-            }
-            else {
-                resc->set_property< rodsServerHost_t* >( RESOURCE_HOST, 0 );
+                root = itr->second;
             }
 
-            rodsLong_t resource_id = strtoll( tmpRescId.c_str(), 0, 0 );
-            resc->set_property<rodsLong_t>( RESOURCE_ID, resource_id );
-            resc->set_property<long>( RESOURCE_QUOTA, RESC_QUOTA_UNINIT );
-
-            resc->set_property<std::string>( RESOURCE_FREESPACE,      tmpFreeSpace );
-            resc->set_property<std::string>( RESOURCE_ZONE,           tmpZoneName );
-            resc->set_property<std::string>( RESOURCE_NAME,           tmpRescName );
-            resc->set_property<std::string>( RESOURCE_LOCATION,       tmpRescLoc );
-            resc->set_property<std::string>( RESOURCE_TYPE,           tmpRescType );
-            resc->set_property<std::string>( RESOURCE_CLASS,          tmpRescClass );
-            resc->set_property<std::string>( RESOURCE_PATH,           tmpRescVaultPath );
-            resc->set_property<std::string>( RESOURCE_INFO,           tmpRescInfo );
-            resc->set_property<std::string>( RESOURCE_COMMENTS,       tmpRescComments );
-            resc->set_property<std::string>( RESOURCE_CREATE_TS,      tmpRescCreate );
-            resc->set_property<std::string>( RESOURCE_MODIFY_TS,      tmpRescModify );
-            resc->set_property<std::string>( RESOURCE_CHILDREN,       tmpRescChildren );
-            resc->set_property<std::string>( RESOURCE_CONTEXT,        tmpRescContext );
-            resc->set_property<std::string>( RESOURCE_PARENT,         tmpRescParent );
-            resc->set_property<std::string>( RESOURCE_PARENT_CONTEXT, tmpRescParentCtx );
-
-            if ( tmpRescStatus == std::string( RESC_DOWN ) ) {
-                resc->set_property<int>( RESOURCE_STATUS, INT_RESC_STATUS_DOWN );
+            pending_trees_[ root->name ].push_back( r );
+            pending_root_by_name_[ r.name ] = root->name;
+            pending_root_by_id_[ strtoll( r.id.c_str(), 0, 0 ) ] = root->name;
+
+        } // for r
+
+    } // add_pending_resources
+
+// =-=-=-=-=-=-=-
+// private - load the plugin for a record and add the resource to the tables
+    error resource_manager::instantiate_resource( const resource_record& _record ) {
+        // =-=-=-=-=-=-=-
+        // create the resource and add properties for column values
+        resource_ptr resc;
+        error ret = load_resource_plugin( resc, _record.type, _record.name, _record.context );
+        if ( !ret.ok() ) {
+            return PASS( ret );
+        }
+
+        // =-=-=-=-=-=-=-
+        // resolve the host name into a rods server host structure
+        if ( _record.location != irods::EMPTY_RESC_HOST ) {
+            rodsHostAddr_t addr;
+            rstrcpy( addr.hostAddr, _record.location.c_str(), LONG_NAME_LEN );
+            rstrcpy( addr.zoneName, _record.zone.c_str(), NAME_LEN );
+
+            rodsServerHost_t* tmpRodsServerHost = 0;
+            if ( resolveHost( &addr, &tmpRodsServerHost ) < 0 ) {
+                rodsLog( LOG_NOTICE, "procAndQueRescResult: resolveHost error for %s",
+                         addr.hostAddr );
             }
-            else {
-                resc->set_property<int>( RESOURCE_STATUS, INT_RESC_STATUS_UP );
+
+            resc->set_property< rodsServerHost_t* >( RESOURCE_HOST, tmpRodsServerHost );
+
+        }
+        else {
+            resc->set_property< rodsServerHost_t* >( RESOURCE_HOST, 0 );
+        }
+
+        rodsLong_t resource_id = strtoll( _record.id.c_str(), 0, 0 );
+        resc->set_property<rodsLong_t>( RESOURCE_ID, resource_id );
+        resc->set_property<long>( RESOURCE_QUOTA, RESC_QUOTA_UNINIT );
+
+        resc->set_property<std::string>( RESOURCE_FREESPACE,      _record.free_space );
+        resc->set_property<std::string>( RESOURCE_ZONE,           _record.zone );
+        resc->set_property<std::string>( RESOURCE_NAME,           _record.name );
+        resc->set_property<std::string>( RESOURCE_LOCATION,       _record.location );
+        resc->set_property<std::string>( RESOURCE_TYPE,           _record.type );
+        resc->set_property<std::string>( RESOURCE_CLASS,          _record.class_name );
+        resc->set_property<std::string>( RESOURCE_PATH,           _record.vault_path );
+        resc->set_property<std::string>( RESOURCE_INFO,           _record.info );
+        resc->set_property<std::string>( RESOURCE_COMMENTS,       _record.comments );
+        resc->set_property<std::string>( RESOURCE_CREATE_TS,      _record.create_time );
+        resc->set_property<std::string>( RESOURCE_MODIFY_TS,      _record.modify_time );
+        resc->set_property<std::string>( RESOURCE_CHILDREN,       _record.children );
+        resc->set_property<std::string>( RESOURCE_CONTEXT,        _record.context );
+        resc->set_property<std::string>( RESOURCE_PARENT,         _record.parent );
+        resc->set_property<std::string>( RESOURCE_PARENT_CONTEXT, _record.parent_context );
+
+        if ( _record.status == std::string( RESC_DOWN ) ) {
+            resc->set_property<int>( RESOURCE_STATUS, INT_RESC_STATUS_DOWN );
+        }
+        else {
+            resc->set_property<int>( RESOURCE_STATUS, INT_RESC_STATUS_UP );
+        }
+
+        // =-=-=-=-=-=-=-
+        // add new resource to the map
+        resource_name_map_[ _record.name ] = resc;
+        resource_id_map_[ resource_id ] = resc;
+
+        return SUCCESS();
+
+    } // instantiate_resource
+
+// =-=-=-=-=-=-=-
+// private - instantiate every resource of a pending tree, wire children up
+//           to parents, gather the pdmos and start the plugins
+    error resource_manager::instantiate_tree( const std::string& _root ) {
+        auto node = pending_trees_.extract( _root );
+        if ( node.empty() ) {
+            return SUCCESS();
+        }
+
+        const std::vector< resource_record >& records = node.mapped();
+
+        std::vector< std::string > names;
+        names.reserve( records.size() );
+
+        for ( const auto& r : records ) {
+            pending_root_by_name_.erase( r.name );
+            pending_root_by_id_.erase( strtoll( r.id.c_str(), 0, 0 ) );
+
+            error ret = instantiate_resource( r );
+            if ( !ret.ok() ) {
+                irods::log( PASS( ret ) );
+                continue;
             }
 
-            // =-=-=-=-=-=-=-
-            // add new resource to the map
-            resource_name_map_[ tmpRescName ] = resc;
-            resource_id_map_[ resource_id ] = resc;
+            names.push_back( r.name );
 
-        } // for i
+        } // for r
+
+        // =-=-=-=-=-=-=-
+        // Update child resource maps
+        error ret = init_child_map( names );
+        if ( !ret.ok() ) {
+            return PASSMSG( "init_child_map failed.", ret );
+        }
+
+        // =-=-=-=-=-=-=-
+        // gather the post disconnect maintenance operations
+        ret = gather_operations( names );
+        if ( !ret.ok() ) {
+            return PASSMSG( "gather_operations failed.", ret );
+        }
+
+        // =-=-=-=-=-=-=-
+        // call start for plugins
+        ret = start_resource_plugins( names );
+        if ( !ret.ok() ) {
+            return PASSMSG( "start_resource_plugins failed.", ret );
+        }
 
         return SUCCESS();
 
-    } // process_init_results
+    } // instantiate_tree
+
+// =-=-=-=-=-=-=-
+// private - instantiate the tree holding a resource if it is still pending
+    void resource_manager::instantiate_tree_for_resource( const std::string& _resc_name ) {
+        const auto itr = pending_root_by_name_.find( _resc_name );
+        if ( itr == pending_root_by_name_.end() ) {
+            return;
+        }
+
+        const std::string root = itr->second;
+        error ret = instantiate_tree( root );
+        if ( !ret.ok() ) {
+            irods::log( PASS( ret ) );
+        }
+
+    } // instantiate_tree_for_resource
+
+    void resource_manager::instantiate_tree_for_resource( rodsLong_t _resc_id ) {
+        const auto itr = pending_root_by_id_.find( _resc_id );
+        if ( itr == pending_root_by_id_.end() ) {
+            return;
+        }
+
+        const std::string root = itr->second;
+        error ret = instantiate_tree( root );
+        if ( !ret.ok() ) {
+            irods::log( PASS( ret ) );
+        }
+
+    } // instantiate_tree_for_resource
+
+// =-=-=-=-=-=-=-
+// private - instantiate every pending tree
+    void resource_manager::instantiate_all_resources( void ) {
+        while ( !pending_trees_.empty() ) {
+            const std::string root = pending_trees_.begin()->first;
+            error ret = instantiate_tree( root );
+            if ( !ret.ok() ) {
+                irods::log( PASS( ret ) );
+            }
+        }
+
+    } // instantiate_all_resources
 
 // =-=-=-=-=-=-=-
 // public - given a type, load up a resource plugin
@@ -785,11 +951,10 @@ namespace irods
     } // init_from_type
 
 // =-=-=-=-=-=-=-
-// private - walk the resource map and wire children up to parents
-    error resource_manager::init_child_map( void ) {
-        for( auto itr : resource_name_map_ ) {
-            const std::string& child_name = itr.first;
-            resource_ptr       child_resc = itr.second;
+// private - walk the given resources and wire children up to parents
+    error resource_manager::init_child_map( const std::vector< std::string >& _resc_names ) {
+        for( const auto& child_name : _resc_names ) {
+            resource_ptr child_resc = resource_name_map_[child_name];
 
             std::string parent_id_str;
             error ret = child_resc->get_property<std::string>(
@@ -840,7 +1005,7 @@ namespace irods
                 parent_child_context.c_str(),
                 parent_id);
 
-        } // for itr
+        } // for child_name
 
         return SUCCESS();
 
@@ -849,6 +1014,8 @@ namespace irods
 // =-=-=-=-=-=-=-
 // public - print the list of local resources out to stderr
     void resource_manager::print_local_resources() {
+        instantiate_all_resources();
+
         lookup_table< boost::shared_ptr< resource > >::iterator itr;
         for ( itr = resource_name_map_.begin(); itr != resource_name_map_.end(); ++itr ) {
             std::string loc, path, name;
@@ -865,17 +1032,16 @@ namespace irods
 
 // =-=-=-=-=-=-=-
 // private - gather the post disconnect maintenance operations
-//           from the resource plugins
-    error resource_manager::gather_operations() {
+//           from the given resource plugins
+    error resource_manager::gather_operations( const std::vector< std::string >& _resc_names ) {
         // =-=-=-=-=-=-=-
         // vector of already processed resources
         std::vector< std::string > proc_vec;
 
         // =-=-=-=-=-=-=-
-        // iterate over all of the resources
-        lookup_table< boost::shared_ptr< resource > >::iterator resc_itr;
-        for ( resc_itr = resource_name_map_.begin(); resc_itr != resource_name_map_.end(); ++resc_itr ) {
-            resource_ptr& resc = resc_itr->second;
+        // iterate over all of the given resources
+        for ( const auto& resc_name : _resc_names ) {
+            resource_ptr resc = resource_name_map_[ resc_name ];
 
             // =-=-=-=-=-=-=-
             // skip if already processed
@@ -1014,22 +1180,17 @@ namespace irods
     } // gather_operations_recursive
 
 // =-=-=-=-=-=-=-
-// public - call the start op on the resource plugins
-    error resource_manager::start_resource_plugins( ) {
+// private - call the start op on the given resource plugins
+    error resource_manager::start_resource_plugins( const std::vector< std::string >& _resc_names ) {
         // =-=-=-=-=-=-=-
         // iterate through resource plugins
-        lookup_table< resource_ptr >::iterator itr;
-        for ( itr  = resource_name_map_.begin();
-                itr != resource_name_map_.end();
-                ++itr ) {
-            // =-=-=-=-=-=-=-
-            // if any resources need a pdmo, return true;
-            error ret = itr->second->start_operation( );
+        for ( const auto& resc_name : _resc_names ) {
+            error ret = resource_name_map_[ resc_name ]->start_operation( );
             if ( !ret.ok() ) {
                 irods::log( ret );
             }
 
-        } // for itr
+        } // for resc_name
 
         return SUCCESS();
 
@@ -1105,6 +1266,8 @@ namespace irods
      * throws irods::exception
      */
     std::vector<std::string> resource_manager::get_all_resc_hierarchies( void ) {
+        instantiate_all_resources();
+
         std::vector<std::string> hier_list;
         for ( const auto& entry : resource_name_map_ ) {
             const resource_ptr resc = entry.second;
@@ -1137,6 +1300,8 @@ namespace irods
         }
 
         const std::string leaf = irods::hierarchy_parser{_hierarchy.data()}.last_resc();
+        instantiate_tree_for_resource(leaf);
+
         if (!resource_name_map_.has_entry(leaf)) {
             THROW(SYS_RESC_DOES_NOT_EXIST, leaf);
         }
@@ -1164,6 +1329,8 @@ namespace irods
         std::string leaf;
         p.last_resc( leaf );
 
+        instantiate_tree_for_resource( leaf );
+
         if( !resource_name_map_.has_entry(leaf) ) {
             return ERROR(
                        SYS_RESC_DOES_NOT_EXIST,
@@ -1188,6 +1355,8 @@ namespace irods
 
     std::string resource_manager::leaf_id_to_hier(const rodsLong_t _leaf_resource_id)
     {
+        instantiate_tree_for_resource(_leaf_resource_id);
+
         if(!resource_id_map_.has_entry(_leaf_resource_id)) {
             THROW(SYS_RESC_DOES_NOT_EXIST, fmt::format("invalid resource id: {}", _leaf_resource_id));
         }
@@ -1220,6 +1389,8 @@ namespace irods
     error resource_manager::leaf_id_to_hier(
         const rodsLong_t& _id,
         std::string&      _hier ) {
+        instantiate_tree_for_resource( _id );
+
         if( !resource_id_map_.has_entry(_id) ) {
             std::stringstream msg;
             msg << "invalid resource id: " << _id;
@@ -1268,6 +1439,8 @@ namespace irods
             return SUCCESS();
         }
 
+        instantiate_tree_for_resource( _id );
+
         if( !resource_id_map_.has_entry(_id) ) {
             std::stringstream msg;
             msg << "invalid resource id: " << _id;
@@ -1306,6 +1479,8 @@ namespace irods
             return PASS(ret);
         }
 
+        instantiate_tree_for_resource( resc_id );
+
         if( !resource_id_map_.has_entry(resc_id) ) {
             std::stringstream msg;
             msg << "invalid resource id: " << _id_str;
@@ -1333,6 +1508,8 @@ namespace irods
             return {};
         }
 
+        instantiate_tree_for_resource(_id);
+
         if(!resource_id_map_.has_entry(_id)) {
             THROW(SYS_RESC_DOES_NOT_EXIST, fmt::format("invalid resource id: {}", _id));
         }
@@ -1361,6 +1538,8 @@ namespace irods
     error resource_manager::is_coordinating_resource(
         const std::string& _resc_name,
         bool&              _ret ) {
+        instantiate_tree_for_resource( _resc_name );
+
         if( !resource_name_map_.has_entry(_resc_name) ) {
             return ERROR(
                        SYS_RESC_DOES_NOT_EXIST,
@@ -1376,6 +1555,8 @@ namespace irods
 
     bool resource_manager::is_coordinating_resource(
         const std::string& _resc_name) {
+        instantiate_tree_for_resource(_resc_name);
+
         if(!resource_name_map_.has_entry(_resc_name)) {
             THROW(SYS_RESC_DOES_NOT_EXIST, _resc_name);
         }
@@ -12,6 +12,7 @@
 
 // =-=-=-=-=-=-=
 #include "irods_resource_redirect.hpp"
+#include "hierarchy_resolution_cache.hpp"
 #include "irods_hierarchy_parser.hpp"
 #include "irods_resource_backport.hpp"
 #include "voting.hpp"
@@ -297,12 +298,33 @@ namespace irods
         dataObjInp_t&        data_obj_inp,
         dataObjInfo_t**      data_obj_info)
     {
+        namespace hrc = irods::hierarchy_resolution_cache;
+
+        const bool cacheable = comm && hrc::is_cacheable(oper, data_obj_inp);
+
+        if (cacheable) {
+            if (auto result = hrc::lookup(*comm, oper, data_obj_inp, data_obj_info); result) {
+                return *result;
+            }
+        }
+        else if (hrc::enabled()) {
+            // Anything other than a read may change the replicas of the data object.
+            hrc::erase(data_obj_inp.objPath);
+        }
+
         // call factory for given dataObjInp, get a file_object
         file_object_ptr file_obj(new file_object());
         file_obj->logical_path(data_obj_inp.objPath);
         error fac_err = file_object_factory(comm, &data_obj_inp, file_obj, data_obj_info);
         auto fobj_tuple = std::make_tuple(file_obj, fac_err);
-        return resolve_resource_hierarchy(comm, oper, data_obj_inp, fobj_tuple);
+        auto result = resolve_resource_hierarchy(comm, oper, data_obj_inp, fobj_tuple);
+
+        if (cacheable) {
+            const auto& [resolved_obj, hier] = result;
+            hrc::insert(*comm, oper, data_obj_inp, resolved_obj, hier, data_obj_info ? *data_obj_info : nullptr);
+        }
+
+        return result;
     } // resolve_resource_hierarchy
 
     irods::resolve_hierarchy_result_type resolve_resource_hierarchy(
@@ -21,6 +21,7 @@
 #include "irods_server_state.hpp"
 #include "irods_exception.hpp"
 #include "irods_stacktrace.hpp"
+#include "latency_histograms.hpp"
 
 #include "boost/lexical_cast.hpp"
 
@@ -441,6 +442,29 @@ namespace irods {
         return SUCCESS();
     }
 
+    static error operation_metrics(
+        const std::string&, // _wait_option,
+        const size_t, //       _wait_seconds,
+        std::string& _output )
+    {
+        rodsEnv my_env;
+        _reloadRodsEnv( my_env );
+
+        using json = nlohmann::json;
+
+        // The latency histograms are shared by all agents of this server. The metrics
+        // are in the Prometheus text exposition format.
+        json obj{
+            {"hostname", my_env.rodsHost},
+            {"metrics", experimental::latency_histograms::to_prometheus_text(my_env.rodsHost)}
+        };
+
+        _output += obj.dump(4);
+        _output += ",";
+
+        return SUCCESS();
+    } // operation_metrics
+
     bool server_control_executor::compare_host_names(
         const std::string& _hn1,
         const std::string& _hn2 ) {
@@ -515,6 +539,7 @@ namespace irods {
         op_map_[ SERVER_CONTROL_RESUME ]   = operation_resume;
         op_map_[ SERVER_CONTROL_STATUS ]   = operation_status;
         op_map_[ SERVER_CONTROL_PING ]     = operation_ping;
+        op_map_[ SERVER_CONTROL_METRICS ]  = operation_metrics;
         if ( _prop == CFG_RULE_ENGINE_CONTROL_PLANE_PORT ) {
             op_map_[ SERVER_CONTROL_SHUTDOWN ] = rule_engine_operation_shutdown;
         }
@@ -30,6 +30,7 @@
 #include "get_hier_from_leaf_id.h"
 #include "key_value_proxy.hpp"
 #include "replica_proxy.hpp"
+#include "read_ahead_buffer.hpp"
 
 int
 initL1desc() {
@@ -44,6 +45,7 @@ allocL1desc() {
     for ( i = 3; i < NUM_L1_DESC; i++ ) {
         if ( L1desc[i].inuseFlag <= FD_FREE ) {
             L1desc[i].inuseFlag = FD_INUSE;
+            irods::read_ahead_buffer::discard( i );
             return i;
         };
     }
@@ -156,6 +158,8 @@ int freeL1desc(const int l1descInx) {
         return SYS_FILE_DESC_OUT_OF_RANGE;
     }
 
+    irods::read_ahead_buffer::discard(l1descInx);
+
     return freeL1desc_struct(L1desc[l1descInx]);
 } // freeL1desc
 
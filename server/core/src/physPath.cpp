@@ -4,6 +4,7 @@
 #include "dataObjOpr.hpp"
 #include "fileChksum.h"
 #include "genQuery.h"
+#include "icatHighLevelRoutines.hpp"
 #include "modDataObjMeta.h"
 #include "objMetaOpr.hpp"
 #include "phyBundleColl.h"
@@ -31,12 +32,18 @@
 #include "irods_log.hpp"
 #include "irods_random.hpp"
 #include "irods_resource_backport.hpp"
+#include "irods_resource_constants.hpp"
 #include "irods_server_properties.hpp"
 #include "irods_stacktrace.hpp"
 #include "replica_proxy.hpp"
 
 #include <fmt/format.h>
 
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <set>
+
 #include <unistd.h> // JMC - backport 4598
 #include <fcntl.h> // JMC - backport 4598
 
@@ -995,13 +1002,182 @@ syncDataObjPhyPathS( rsComm_t *rsComm, dataObjInp_t *dataObjInp,
     return 0;
 }
 
-/* syncCollPhyPath - sync the path of the phy path with the path of
+namespace
+{
+    // Returns the leaf resources holding replicas under a collection.
+    auto resources_in_collection(rsComm_t* _comm, char* _collection, std::set<rodsLong_t>& _resources) -> int
+    {
+        genQueryInp_t input{};
+        genQueryOut_t* output{};
+
+        irods::at_scope_exit free_query{[&input, &output] {
+            freeGenQueryOut(&output);
+            clearGenQueryInp(&input);
+        }};
+
+        char condition[MAX_NAME_LEN * 2];
+        genAllInCollQCond(_collection, condition);
+        addInxVal(&input.sqlCondInp, COL_COLL_NAME, condition);
+        addInxIval(&input.selectInp, COL_D_RESC_ID, 1);
+        input.maxRows = MAX_SQL_ROWS;
+
+        int status = rsGenQuery(_comm, &input, &output);
+
+        while (status >= 0) {
+            const sqlResult_t* resc_ids = getSqlResultByInx(output, COL_D_RESC_ID);
+            if (!resc_ids) {
+                return UNMATCHED_KEY_OR_INDEX;
+            }
+
+            for (int i = 0; i < output->rowCnt; ++i) {
+                _resources.insert(std::strtoll(&resc_ids->value[resc_ids->len * i], nullptr, 10));
+            }
+
+            if (output->continueInx <= 0) {
+                break;
+            }
+
+            input.continueInx = output->continueInx;
+            freeGenQueryOut(&output);
+            status = rsGenQuery(_comm, &input, &output);
+        }
+
+        return (CAT_NO_ROWS_FOUND == status) ? 0 : std::min(status, 0);
+    } // resources_in_collection
+
+    // Moves the vault directory of a renamed collection on a leaf resource and updates the
+    // physical paths of the replicas under the collection with a single catalog statement.
+    //
+    // Returns 1 if the replicas on the resource were moved, 0 if they must be moved one at a time
+    // and a negative error code if the catalog could not be restored after a failure.
+    auto move_vault_directory(rsComm_t* _comm,
+                              rodsLong_t _resc_id,
+                              const char* _src_coll,
+                              const char* _dest_coll) -> int
+    {
+        std::string resc_type;
+        if (const auto err = irods::get_resource_property<std::string>(_resc_id, irods::RESOURCE_TYPE, resc_type);
+            !err.ok() || irods::RESOURCE_TYPE_NATIVE != resc_type)
+        {
+            return 0;
+        }
+
+        int create_path = 0;
+        if (const auto err = irods::get_resource_property<int>(_resc_id, irods::RESOURCE_CREATE_PATH, create_path);
+            !err.ok() || NO_CREATE_PATH == create_path)
+        {
+            return 0;
+        }
+
+        if (!irods::is_resc_live(_resc_id).ok()) {
+            return 0;
+        }
+
+        std::string resc_hier;
+        if (!resc_mgr.leaf_id_to_hier(_resc_id, resc_hier).ok()) {
+            return 0;
+        }
+
+        std::string location;
+        if (!irods::get_loc_for_hier_string(resc_hier, location).ok()) {
+            return 0;
+        }
+
+        std::string vault_path;
+        if (getLeafRescPathName(resc_hier, vault_path) != 0) {
+            return 0;
+        }
+
+        // The vault path policy is evaluated once for the collection instead of once per replica.
+        dataObjInfo_t info{};
+        rstrcpy(info.objPath, _dest_coll, MAX_NAME_LEN);
+        rstrcpy(info.rescHier, resc_hier.c_str(), MAX_NAME_LEN);
+        info.rescId = _resc_id;
+
+        vaultPathPolicy_t policy{};
+        if (getVaultPathPolicy(_comm, &info, &policy) < 0 || GRAFT_PATH_S != policy.scheme) {
+            return 0;
+        }
+
+        char src_coll[MAX_NAME_LEN]{};
+        char dest_coll[MAX_NAME_LEN]{};
+        rstrcpy(src_coll, _src_coll, MAX_NAME_LEN);
+        rstrcpy(dest_coll, _dest_coll, MAX_NAME_LEN);
+
+        char old_dir[MAX_NAME_LEN]{};
+        char new_dir[MAX_NAME_LEN]{};
+
+        if (setPathForGraftPathScheme(src_coll, vault_path.c_str(), policy.addUserName,
+                                      _comm->clientUser.userName, policy.trimDirCnt, old_dir) < 0 ||
+            setPathForGraftPathScheme(dest_coll, vault_path.c_str(), policy.addUserName,
+                                      _comm->clientUser.userName, policy.trimDirCnt, new_dir) < 0)
+        {
+            return 0;
+        }
+
+        if (std::strcmp(old_dir, new_dir) == 0) {
+            return 1;
+        }
+
+        // Fails without changing the catalog unless the replicas in the vault are laid out exactly
+        // as the graft path scheme would lay them out under the old directory. Any other error
+        // leaves the transaction of the rename unusable, so the rename fails.
+        if (const int ec = chlMoveCollDataPaths(_comm, _resc_id, _dest_coll, vault_path.c_str(), old_dir, new_dir); ec < 0) {
+            if (SYS_INVALID_FILE_PATH != ec && SYS_PHY_PATH_INUSE != ec) {
+                rodsLog(LOG_ERROR, "%s: failed to move the physical paths of the replicas of [%s] on resource [%lld], status = %d",
+                        __FUNCTION__, _dest_coll, _resc_id, ec);
+                return ec;
+            }
+
+            rodsLog(LOG_DEBUG, "%s: replicas of [%s] on resource [%lld] are moved one at a time, status = %d",
+                    __FUNCTION__, _dest_coll, _resc_id, ec);
+            return 0;
+        }
+
+        fileRenameInp_t rename_inp{};
+        rstrcpy(rename_inp.objPath, _dest_coll, MAX_NAME_LEN);
+        rstrcpy(rename_inp.oldFileName, old_dir, MAX_NAME_LEN);
+        rstrcpy(rename_inp.newFileName, new_dir, MAX_NAME_LEN);
+        rstrcpy(rename_inp.rescHier, resc_hier.c_str(), MAX_NAME_LEN);
+        rstrcpy(rename_inp.addr.hostAddr, location.c_str(), NAME_LEN);
+
+        fileRenameOut_t* rename_out{};
+        const int status = rsFileRename(_comm, &rename_inp, &rename_out);
+        irods::at_scope_exit free_rename_out{[&rename_out] { std::free(rename_out); }};
+
+        if (status < 0) {
+            rodsLog(LOG_NOTICE, "%s: rsFileRename from %s to %s failed, status = %d",
+                    __FUNCTION__, old_dir, new_dir, status);
+
+            // Restore the physical paths in the catalog so that the replicas can be moved one at a time.
+            if (const int ec = chlMoveCollDataPaths(_comm, _resc_id, _dest_coll, vault_path.c_str(), new_dir, old_dir); ec < 0) {
+                rodsLog(LOG_ERROR, "%s: failed to restore the physical paths of the replicas of [%s], status = %d",
+                        __FUNCTION__, _dest_coll, ec);
+                return ec;
+            }
+
+            return 0;
+        }
+
+        // The resource may have chosen another path for the directory.
+        if (rename_out && std::strcmp(rename_out->file_name, new_dir) != 0) {
+            if (const int ec = chlMoveCollDataPaths(_comm, _resc_id, _dest_coll, vault_path.c_str(), new_dir, rename_out->file_name); ec < 0) {
+                return ec;
+            }
+        }
+
+        return 1;
+    } // move_vault_directory
+} // anonymous namespace
+
+/* _syncCollPhyPath - sync the path of the phy path with the path of
  * the data ovject in the new collection. This is unsed by rename to sync
- * the path of the phy path with the new path.
+ * the path of the phy path with the new path. Replicas on the resources
+ * in skipResources are left alone.
  */
 
-int
-syncCollPhyPath( rsComm_t *rsComm, char *collection ) {
+static int
+_syncCollPhyPath( rsComm_t *rsComm, char *collection, const std::set<rodsLong_t>& skipResources ) {
     int status, i;
     int savedStatus = 0;
     genQueryOut_t *genQueryOut = NULL;
@@ -1084,6 +1260,10 @@ syncCollPhyPath( rsComm_t *rsComm, char *collection ) {
             rstrcpy( dataObjInfo.rescName, tmpRescName, NAME_LEN );
 
             dataObjInfo.rescId = strtoll(tmpRescId, 0, 0);
+            if ( skipResources.count( dataObjInfo.rescId ) > 0 ) {
+                continue;
+            }
+
             std::string resc_hier;
             resc_mgr.leaf_id_to_hier(dataObjInfo.rescId, resc_hier);
 
@@ -1122,6 +1302,41 @@ syncCollPhyPath( rsComm_t *rsComm, char *collection ) {
     return savedStatus;
 }
 
+/* syncCollPhyPath - sync the path of the phy path with the path of
+ * the data ovject in the new collection. This is unsed by rename to sync
+ * the path of the phy path with the new path.
+ */
+
+int
+syncCollPhyPath( rsComm_t *rsComm, char *collection ) {
+    return _syncCollPhyPath( rsComm, collection, {} );
+}
+
+int
+syncRenamedCollPhyPath( rsComm_t *rsComm, const char *srcColl, char *destColl ) {
+    std::set<rodsLong_t> resources;
+    if ( resources_in_collection( rsComm, destColl, resources ) < 0 ) {
+        return syncCollPhyPath( rsComm, destColl );
+    }
+
+    std::set<rodsLong_t> moved;
+    for ( auto&& resc_id : resources ) {
+        const int status = move_vault_directory( rsComm, resc_id, srcColl, destColl );
+        if ( status < 0 ) {
+            return status;
+        }
+        if ( status > 0 ) {
+            moved.insert( resc_id );
+        }
+    }
+
+    if ( moved.size() == resources.size() ) {
+        return 0;
+    }
+
+    return _syncCollPhyPath( rsComm, destColl, moved );
+}
+
 int
 isInVault( dataObjInfo_t *dataObjInfo ) {
     int len;
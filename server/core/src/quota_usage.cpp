@@ -0,0 +1,75 @@
+#include "quota_usage.hpp"
+
+#include "irods_configuration_keywords.hpp"
+#include "irods_exception.hpp"
+#include "irods_server_properties.hpp"
+
+#include <iterator>
+
+namespace irods::experimental::catalog::quota_usage
+{
+    auto incremental() -> bool
+    {
+        try {
+            return irods::get_advanced_setting<const std::string>(irods::CFG_QUOTA_ACCOUNTING_MODE_KW) == "incremental";
+        }
+        catch (const irods::exception&) {
+            // The setting is optional. Quota usage is rebuilt in full by default.
+        }
+
+        return false;
+    } // incremental
+
+    auto difference(const usage_map& _before, const usage_map& _after) -> usage_map
+    {
+        usage_map deltas;
+
+        for (auto&& [key, bytes] : _before) {
+            deltas[key] -= bytes;
+        }
+
+        for (auto&& [key, bytes] : _after) {
+            deltas[key] += bytes;
+        }
+
+        for (auto it = std::begin(deltas); it != std::end(deltas);) {
+            if (0 == it->second) {
+                it = deltas.erase(it);
+            }
+            else {
+                ++it;
+            }
+        }
+
+        return deltas;
+    } // difference
+
+    auto usage_delta_statement(std::string_view _db_type) -> std::string
+    {
+        if ("oracle" == _db_type) {
+            return "merge into R_QUOTA_USAGE QU using (select ? quota_usage, ? resc_id, ? user_id, ? modify_ts from DUAL) D "
+                   "on (QU.user_id = D.user_id and QU.resc_id = D.resc_id) "
+                   "when matched then update set QU.quota_usage = QU.quota_usage + D.quota_usage, QU.modify_ts = D.modify_ts "
+                   "when not matched then insert (quota_usage, resc_id, user_id, modify_ts) values (D.quota_usage, D.resc_id, D.user_id, D.modify_ts)";
+        }
+
+        if ("mysql" == _db_type) {
+            return "insert into R_QUOTA_USAGE (quota_usage, resc_id, user_id, modify_ts) values (?, ?, ?, ?) "
+                   "on duplicate key update quota_usage = quota_usage + values(quota_usage), modify_ts = values(modify_ts)";
+        }
+
+        // Postgres and CockroachDB.
+        return "insert into R_QUOTA_USAGE (quota_usage, resc_id, user_id, modify_ts) values (?, ?, ?, ?) "
+               "on conflict (user_id, resc_id) do update set quota_usage = R_QUOTA_USAGE.quota_usage + excluded.quota_usage, modify_ts = excluded.modify_ts";
+    } // usage_delta_statement
+
+    auto over_quota_delta_statement() -> std::string
+    {
+        // quota_over is the usage minus the limit, so it moves by exactly the change in usage
+        // for every quota that includes the user and the resource. A resource id of zero
+        // denotes a total quota.
+        return "update R_QUOTA_MAIN set quota_over = quota_over + ?, modify_ts = ? "
+               "where (resc_id = ? or resc_id = 0) "
+               "and (user_id = ? or user_id in (select group_user_id from R_USER_GROUP where user_id = ?))";
+    } // over_quota_delta_statement
+} // namespace irods::experimental::catalog::quota_usage
@@ -0,0 +1,196 @@
+#include "read_ahead_buffer.hpp"
+
+#include "irods_configuration_keywords.hpp"
+#include "irods_exception.hpp"
+#include "irods_server_properties.hpp"
+#include "rodsLog.h"
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <mutex>
+
+namespace irods::read_ahead_buffer
+{
+    namespace
+    {
+        struct descriptor_state
+        {
+            // The bytes read ahead and the position of the first byte in the replica.
+            std::vector<char> data;
+            rodsLong_t offset;
+
+            // The number of bytes in data which were already returned to the client.
+            std::size_t consumed;
+
+            // The position following the most recent read. A read starting here is sequential.
+            rodsLong_t next_offset;
+
+            // The size of the most recent read-ahead.
+            int window;
+        }; // struct descriptor_state
+
+        // The largest window honored regardless of the configuration. This keeps the window
+        // representable by the read APIs, which take an int.
+        constexpr int max_window_size_in_megabytes = 1024;
+
+        // Global Variables
+        int max_window_size{};
+        std::map<int, descriptor_state> buffers;
+        statistics stats{};
+
+        std::mutex buffer_mutex;
+    } // anonymous namespace
+
+    auto init() -> void
+    {
+        std::scoped_lock lock{buffer_mutex};
+
+        max_window_size = 0;
+
+        try {
+            const auto mb = irods::get_advanced_setting<const int>(irods::CFG_MAX_READ_AHEAD_BUFFER_SIZE_KW);
+
+            if (mb < 0) {
+                rodsLog(LOG_ERROR, "Invalid read-ahead buffer size [megabytes=%d].", mb);
+            }
+            else {
+                max_window_size = std::min(mb, max_window_size_in_megabytes) * 1024 * 1024;
+            }
+        }
+        catch (const irods::exception&) {
+            rodsLog(LOG_DEBUG, "Could not read server configuration property [%s.%s]. Read-ahead is disabled.",
+                    irods::CFG_ADVANCED_SETTINGS_KW.data(), irods::CFG_MAX_READ_AHEAD_BUFFER_SIZE_KW.data());
+        }
+
+        buffers.clear();
+        stats = {};
+    } // init
+
+    auto deinit() -> void
+    {
+        std::scoped_lock lock{buffer_mutex};
+
+        buffers.clear();
+    } // deinit
+
+    auto enabled() noexcept -> bool
+    {
+        return max_window_size > 0;
+    } // enabled
+
+    auto read(int _l1desc_index, void* _buffer, int _length) -> int
+    {
+        if (!enabled() || _length <= 0) {
+            return 0;
+        }
+
+        std::scoped_lock lock{buffer_mutex};
+
+        const auto iter = buffers.find(_l1desc_index);
+
+        if (iter == std::end(buffers)) {
+            return 0;
+        }
+
+        auto& s = iter->second;
+        const auto available = s.data.size() - s.consumed;
+
+        if (0 == available) {
+            return 0;
+        }
+
+        const auto count = std::min<std::size_t>(available, _length);
+        std::memcpy(_buffer, s.data.data() + s.consumed, count);
+        s.consumed += count;
+        s.next_offset = s.offset + s.consumed;
+
+        if (s.consumed == s.data.size()) {
+            s.data.clear();
+            s.data.shrink_to_fit();
+            s.consumed = 0;
+        }
+
+        ++stats.hits;
+
+        return static_cast<int>(count);
+    } // read
+
+    auto window_size(int _l1desc_index, rodsLong_t _offset, int _length) -> int
+    {
+        if (!enabled() || _length <= 0) {
+            return _length;
+        }
+
+        std::scoped_lock lock{buffer_mutex};
+
+        ++stats.misses;
+
+        auto [iter, inserted] = buffers.try_emplace(_l1desc_index);
+        auto& s = iter->second;
+
+        if (inserted || s.next_offset != _offset) {
+            s = descriptor_state{};
+            s.next_offset = _offset + _length;
+            return _length;
+        }
+
+        // The read is sequential. Grow the window geometrically so that short sequential
+        // runs do not read much more than they need.
+        s.window = (s.window > 0)
+            ? std::min<rodsLong_t>(static_cast<rodsLong_t>(s.window) * 2, max_window_size)
+            : std::min<rodsLong_t>(static_cast<rodsLong_t>(_length) * 4, max_window_size);
+
+        if (s.window <= _length) {
+            s.next_offset = _offset + _length;
+            return _length;
+        }
+
+        return s.window;
+    } // window_size
+
+    auto fill(int _l1desc_index, rodsLong_t _offset, std::vector<char>&& _data) -> void
+    {
+        if (!enabled()) {
+            return;
+        }
+
+        std::scoped_lock lock{buffer_mutex};
+
+        auto& s = buffers[_l1desc_index];
+        s.data = std::move(_data);
+        s.offset = _offset;
+        s.consumed = 0;
+        s.next_offset = _offset;
+
+        ++stats.fills;
+    } // fill
+
+    auto discard(int _l1desc_index) -> rodsLong_t
+    {
+        std::scoped_lock lock{buffer_mutex};
+
+        const auto iter = buffers.find(_l1desc_index);
+
+        if (iter == std::end(buffers)) {
+            return 0;
+        }
+
+        const auto unread = static_cast<rodsLong_t>(iter->second.data.size() - iter->second.consumed);
+
+        if (unread > 0) {
+            ++stats.discards;
+        }
+
+        buffers.erase(iter);
+
+        return unread;
+    } // discard
+
+    auto get_statistics() -> statistics
+    {
+        std::scoped_lock lock{buffer_mutex};
+
+        return stats;
+    } // get_statistics
+} // namespace irods::read_ahead_buffer
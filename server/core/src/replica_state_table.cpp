@@ -2,15 +2,23 @@
 #include "irods_at_scope_exit.hpp"
 #include "irods_resource_manager.hpp"
 #include "replica_state_table.hpp"
-#include "rs_data_object_finalize.hpp"
+#include "hierarchy_resolution_cache.hpp"
+#include "data_object_finalize_writer.hpp"
 
 //#define IRODS_REPLICA_ENABLE_SERVER_SIDE_API
 //#include "data_object_proxy.hpp"
 
 #include "fmt/format.h"
 
-#include <map>
+#include <algorithm>
+#include <cstdint>
 #include <mutex>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
 
 extern irods::resource_manager resc_mgr;
 
@@ -19,198 +27,372 @@ namespace irods::replica_state_table
     namespace
     {
         // clang-format off
-        namespace id = irods::experimental::data_object;
-        namespace ir = irods::experimental::replica;
-        using json   = nlohmann::json;
+        namespace id  = irods::experimental::data_object;
+        namespace ir  = irods::experimental::replica;
+        namespace fs  = irods::experimental::filesystem;
+        namespace dof = irods::experimental::catalog::data_object_finalize;
+        using json    = nlohmann::json;
         // clang-format on
 
         // Global Constants
         static const std::string BEFORE_KW = "before";
         static const std::string AFTER_KW = "after";
-        static const std::string REPLICAS_KW = "replicas";
+
+        // The columns of R_DATA_MAIN describing a replica, in the types written to the catalog.
+        using replica_record = dof::replica_row;
+
+        using column_member = std::variant<std::string replica_record::*,
+                                           int replica_record::*,
+                                           std::int64_t replica_record::*>;
+
+        // Maps the column names used in the JSON views of the table to the members of a replica_record.
+        // clang-format off
+        const std::pair<std::string_view, column_member> columns[] = {
+            {"data_id",         &replica_record::data_id},
+            {"coll_id",         &replica_record::coll_id},
+            {"data_name",       &replica_record::data_name},
+            {"data_repl_num",   &replica_record::data_repl_num},
+            {"data_version",    &replica_record::data_version},
+            {"data_type_name",  &replica_record::data_type_name},
+            {"data_size",       &replica_record::data_size},
+            {"data_path",       &replica_record::data_path},
+            {"data_owner_name", &replica_record::data_owner_name},
+            {"data_owner_zone", &replica_record::data_owner_zone},
+            {"data_is_dirty",   &replica_record::data_is_dirty},
+            {"data_status",     &replica_record::data_status},
+            {"data_checksum",   &replica_record::data_checksum},
+            {"data_expiry_ts",  &replica_record::data_expiry_ts},
+            {"data_map_id",     &replica_record::data_map_id},
+            {"data_mode",       &replica_record::data_mode},
+            {"r_comment",       &replica_record::r_comment},
+            {"create_ts",       &replica_record::create_ts},
+            {"modify_ts",       &replica_record::modify_ts},
+            {"resc_id",         &replica_record::resc_id}
+        };
+        // clang-format on
+
+        struct replica_entry
+        {
+            // Taken from the "before" state, which never changes. Used to find the replica.
+            int replica_number;
+            rodsLong_t resource_id;
+
+            replica_record before;
+            replica_record after;
+
+            // Key-value pairs for the fileModified plugin operation. Null unless set by publish::to_catalog.
+            json file_modified;
+        }; // struct replica_entry
+
+        struct entry
+        {
+            std::string logical_path;
+            std::vector<replica_entry> replicas;
+        }; // struct entry
 
         // Global Variables
-        std::map<key_type, json> replica_state_json_map;
+        std::unordered_map<key_type, entry> replica_state_map;
 
         std::mutex rst_mutex;
 
         // Local functions
         // extracts the key information from the replica_proxy and returns
-        // the string-ified key for use with the JSON map.
+        // the key for use with the map.
         auto get_key(const ir::replica_proxy_t& _r) -> key_type
         {
             return _r.data_id();
         } // get_key
 
         // extracts the key information from the data_object_proxy and returns
-        // the string-ified key for use with the JSON map.
+        // the key for use with the map.
         auto get_key(const id::data_object_proxy_t& _o) -> key_type
         {
             return _o.data_id();
         } // get_key
 
-        auto index_of(const key_type& _key, const int _replica_number) -> int
+        auto column(const std::string_view _name) -> column_member
         {
-            std::scoped_lock rst_lock{rst_mutex};
+            for (const auto& [name, member] : columns) {
+                if (name == _name) {
+                    return member;
+                }
+            }
+
+            THROW(SYS_INVALID_INPUT_PARAM, fmt::format("[{}:{}] - unknown column [{}]", __FUNCTION__, __LINE__, _name));
+        } // column
+
+        // Returns the value of a column as the string exchanged with the catalog.
+        auto get_column(const replica_record& _record, const column_member& _member) -> std::string
+        {
+            return std::visit([&_record](auto _m) -> std::string {
+                if constexpr (std::is_same_v<decltype(_m), std::string replica_record::*>) {
+                    return _record.*_m;
+                }
+                else {
+                    return std::to_string(_record.*_m);
+                }
+            }, _member);
+        } // get_column
 
-            if (std::end(replica_state_json_map) != replica_state_json_map.find(_key)) {
-                int index = -1;
+        // Sets a column from its JSON value. Numeric columns accept JSON numbers and the strings
+        // produced by the JSON views of the table.
+        auto set_column(replica_record& _record, const std::string_view _name, const json& _value) -> void
+        {
+            std::visit([&_record, &_name, &_value](auto _m) {
+                using value_type = std::decay_t<decltype(_record.*_m)>;
 
-                for (const auto& e : replica_state_json_map.at(_key).at(REPLICAS_KW)) {
-                    ++index;
-                    if (_replica_number == std::stoi(e.at(BEFORE_KW).at("data_repl_num").get<std::string>())) {
-                        return index;
+                if constexpr (std::is_same_v<value_type, std::string>) {
+                    _record.*_m = _value.get<std::string>();
+                }
+                else if (_value.is_number_integer()) {
+                    _record.*_m = _value.get<value_type>();
+                }
+                else {
+                    try {
+                        const auto& s = _value.get_ref<const std::string&>();
+
+                        if constexpr (std::is_same_v<value_type, int>) {
+                            _record.*_m = std::stoi(s);
+                        }
+                        else {
+                            _record.*_m = std::stoll(s);
+                        }
+                    }
+                    catch (const std::logic_error&) {
+                        THROW(SYS_INVALID_INPUT_PARAM, fmt::format(
+                            "[{}:{}] - invalid value for column [{}]",
+                            __FUNCTION__, __LINE__, _name));
                     }
                 }
+            }, column(_name));
+        } // set_column
+
+        // Same contents as ir::to_json without going through a JSON document.
+        auto to_record(const ir::replica_proxy_t& _replica) -> replica_record
+        {
+            replica_record r;
+
+            r.data_id         = _replica.data_id();
+            r.coll_id         = _replica.collection_id();
+            r.data_name       = fs::path{_replica.logical_path().data()}.object_name().c_str();
+            r.data_repl_num   = _replica.replica_number();
+            r.data_version    = _replica.version();
+            r.data_type_name  = _replica.type();
+            r.data_size       = _replica.size();
+            r.data_path       = _replica.physical_path();
+            r.data_owner_name = _replica.owner_user_name();
+            r.data_owner_zone = _replica.owner_zone_name();
+            r.data_is_dirty   = _replica.replica_status();
+            r.data_status     = _replica.status();
+            r.data_checksum   = _replica.checksum();
+            r.data_expiry_ts  = _replica.get()->dataExpiry;
+            r.data_map_id     = _replica.get()->dataMapId;
+            r.data_mode       = _replica.mode();
+            r.r_comment       = _replica.comments();
+            r.create_ts       = _replica.ctime();
+            r.modify_ts       = _replica.mtime();
+            r.resc_id         = _replica.resource_id();
+
+            return r;
+        } // to_record
+
+        auto to_replica_entry(const ir::replica_proxy_t& _replica) -> replica_entry
+        {
+            auto record = to_record(_replica);
+            return replica_entry{_replica.replica_number(), _replica.resource_id(), record, std::move(record), {}};
+        } // to_replica_entry
+
+        auto to_json(const replica_entry& _replica) -> json
+        {
+            json j{
+                {BEFORE_KW, dof::to_json(_replica.before)},
+                {AFTER_KW, dof::to_json(_replica.after)}
+            };
+
+            if (!_replica.file_modified.is_null()) {
+                j[FILE_MODIFIED_KW] = _replica.file_modified;
             }
 
-            THROW(KEY_NOT_FOUND, fmt::format(
-                "[{}:{}] - replica number [{}] not found for [{}]",
-                __FUNCTION__, __LINE__, _replica_number, _key));
-        } // index_of
+            return j;
+        } // to_json
 
-        auto index_of(const key_type& _key, const rodsLong_t _leaf_resource_id) -> int
+        auto to_json(const entry& _entry) -> json
         {
-            std::scoped_lock rst_lock{rst_mutex};
+            json replicas = json::array();
 
-            if (std::end(replica_state_json_map) != replica_state_json_map.find(_key)) {
-                int index = -1;
+            for (const auto& r : _entry.replicas) {
+                replicas.push_back(to_json(r));
+            }
 
-                irods::log(LOG_DEBUG9, fmt::format("[{}:{}] - entry:[{}]", __FUNCTION__, __LINE__, replica_state_json_map.at(_key).dump()));
+            return replicas;
+        } // to_json
 
-                for (const auto& e : replica_state_json_map.at(_key).at(REPLICAS_KW)) {
-                    ++index;
-                    if (_leaf_resource_id == std::stol(e.at(BEFORE_KW).at("resc_id").get<std::string>())) {
-                        return index;
-                    }
-                }
+        auto to_replica_updates(const entry& _entry) -> std::vector<dof::replica_update>
+        {
+            std::vector<dof::replica_update> replicas;
+            replicas.reserve(_entry.replicas.size());
+
+            for (const auto& r : _entry.replicas) {
+                replicas.push_back({r.before, r.after, r.file_modified});
             }
 
-            THROW(KEY_NOT_FOUND, fmt::format(
-                "[{}:{}] - resource id [{}] not found for [{}]",
-                __FUNCTION__, __LINE__, _leaf_resource_id, _key));
-        } // index_of
+            return replicas;
+        } // to_replica_updates
 
-        auto index_of(const key_type& _key, const std::string_view _leaf_resource_name) -> int
+        auto to_json(const replica_entry& _replica, const state_type _state) -> json
         {
-            std::scoped_lock rst_lock{rst_mutex};
+            switch (_state) {
+                // clang-format off
+                case state_type::before:    return dof::to_json(_replica.before);   break;
+                case state_type::after:     return dof::to_json(_replica.after);    break;
+                case state_type::both:      return to_json(_replica);               break;
+                // clang-format on
+
+                default:
+                    THROW(SYS_INVALID_INPUT_PARAM, fmt::format(
+                        "[{}:{}] - invalid state_type",
+                        __FUNCTION__, __LINE__));
+            }
+        } // to_json
 
-            if (std::end(replica_state_json_map) != replica_state_json_map.find(_key)) {
-                int index = -1;
+        auto leaf_resource_id(const std::string_view _leaf_resource_name) -> rodsLong_t
+        {
+            return resc_mgr.hier_to_leaf_id(resc_mgr.get_hier_to_root_for_resc(_leaf_resource_name));
+        } // leaf_resource_id
 
-                const auto resc_id = resc_mgr.hier_to_leaf_id(resc_mgr.get_hier_to_root_for_resc(_leaf_resource_name));
+        // The following functions must be called while holding rst_mutex.
 
-                for (const auto& e : replica_state_json_map.at(_key).at(REPLICAS_KW)) {
-                    ++index;
-                    if (resc_id == std::stoi(e.at(BEFORE_KW).at("resc_id").get<std::string>())) {
-                        return index;
-                    }
-                }
+        auto find_entry(const key_type& _key) -> entry*
+        {
+            const auto iter = replica_state_map.find(_key);
+            return std::end(replica_state_map) == iter ? nullptr : &iter->second;
+        } // find_entry
+
+        auto entry_at(const key_type& _key) -> entry&
+        {
+            if (auto* e = find_entry(_key); e) {
+                return *e;
             }
 
             THROW(KEY_NOT_FOUND, fmt::format(
-                "[{}:{}] - resource name [{}] not found for [{}]",
-                __FUNCTION__, __LINE__, _leaf_resource_name, _key));
-        } // index_of
+                "[{}:{}] - no key found for [{}]",
+                __FUNCTION__, __LINE__, _key));
+        } // entry_at
 
-        // Only for use when restoring an entry
-        auto insert_entry(const key_type& _key, const json& _entry) -> int
+        template <typename Predicate>
+        auto find_replica(const key_type& _key, Predicate _pred) -> replica_entry*
         {
-            try {
-                std::scoped_lock rst_lock{rst_mutex};
+            auto* e = find_entry(_key);
 
-                replica_state_json_map[_key] = _entry;
-
-                return 0;
-            }
-            catch (const irods::exception& e) {
-                irods::log(LOG_ERROR, fmt::format("[{}:{}] - [{}]", __FUNCTION__, __LINE__, e.client_display_what()));
-                return e.code();
-            }
-            catch (const json::exception& e) {
-                irods::log(LOG_ERROR, fmt::format("[{}:{}] - JSON error:[{}]", __FUNCTION__, __LINE__, e.what()));
-                return SYS_LIBRARY_ERROR;
-            }
-            catch (const std::exception& e) {
-                irods::log(LOG_ERROR, fmt::format("[{}:{}] - [{}]", __FUNCTION__, __LINE__, e.what()));
-                return SYS_INTERNAL_ERR;
+            if (!e) {
+                return nullptr;
             }
-            catch (...) {
-                irods::log(LOG_ERROR, fmt::format("[{}:{}] - unknown error occurred", __FUNCTION__, __LINE__));
-                return SYS_UNKNOWN_ERROR;
+
+            const auto iter = std::find_if(std::begin(e->replicas), std::end(e->replicas), _pred);
+            return std::end(e->replicas) == iter ? nullptr : &*iter;
+        } // find_replica
+
+        auto find_replica_by_number(const key_type& _key, const int _replica_number) -> replica_entry*
+        {
+            return find_replica(_key, [_replica_number](const replica_entry& _r) {
+                return _replica_number == _r.replica_number;
+            });
+        } // find_replica_by_number
+
+        auto find_replica_by_resource(const key_type& _key, const rodsLong_t _leaf_resource_id) -> replica_entry*
+        {
+            return find_replica(_key, [_leaf_resource_id](const replica_entry& _r) {
+                return _leaf_resource_id == _r.resource_id;
+            });
+        } // find_replica_by_resource
+
+        auto replica_at(const key_type& _key, const int _replica_number) -> replica_entry&
+        {
+            if (auto* r = find_replica_by_number(_key, _replica_number); r) {
+                return *r;
             }
-        } // insert_entry
 
-        auto update_impl(
-            const key_type& _key,
-            const int _replica_index,
-            const json& _updates) -> void
+            THROW(KEY_NOT_FOUND, fmt::format(
+                "[{}:{}] - replica number [{}] not found for [{}]",
+                __FUNCTION__, __LINE__, _replica_number, _key));
+        } // replica_at
+
+        auto replica_at_resource(const key_type& _key, const rodsLong_t _leaf_resource_id) -> replica_entry&
         {
-            try {
-                std::scoped_lock rst_lock{rst_mutex};
+            if (auto* r = find_replica_by_resource(_key, _leaf_resource_id); r) {
+                return *r;
+            }
 
-                auto& target_replica = replica_state_json_map.at(_key).at(REPLICAS_KW).at(_replica_index);
+            THROW(KEY_NOT_FOUND, fmt::format(
+                "[{}:{}] - resource id [{}] not found for [{}]",
+                __FUNCTION__, __LINE__, _leaf_resource_id, _key));
+        } // replica_at_resource
 
-                irods::log(LOG_DEBUG8, fmt::format("[{}:{}] - replica[{}],update:[{}]",
-                    __FUNCTION__, __LINE__, target_replica.dump(), _updates.dump()));
+        auto erase_replica(const key_type& _key, const replica_entry& _replica) -> void
+        {
+            auto& replicas = entry_at(_key).replicas;
+            replicas.erase(std::begin(replicas) + (&_replica - replicas.data()));
+        } // erase_replica
 
-                target_replica.at(AFTER_KW).update(_updates);
+        auto update_impl(replica_entry& _replica, const json& _updates) -> void
+        {
+            irods::log(LOG_DEBUG8, fmt::format("[{}:{}] - replica[{}],update:[{}]",
+                __FUNCTION__, __LINE__, _replica.replica_number, _updates.dump()));
 
-                irods::log(LOG_DEBUG8, fmt::format("[{}:{}] - [{}]",
-                    __FUNCTION__, __LINE__, target_replica.dump()));
+            if (!_updates.is_object()) {
+                THROW(SYS_INVALID_INPUT_PARAM, fmt::format("[{}:{}] - updates must be a JSON object", __FUNCTION__, __LINE__));
             }
-            catch (const json::exception& e) {
-                THROW(SYS_LIBRARY_ERROR, fmt::format("[{}:{}] - JSON error:[{}]", __FUNCTION__, __LINE__, e.what()));
+
+            for (const auto& [name, value] : _updates.items()) {
+                set_column(_replica.after, name, value);
             }
         } // update_impl
 
         auto publish_to_catalog_impl(
             RsComm& _comm,
             const key_type& _key,
-            const int _replica_index,
+            const replica_id_type& _replica_id,
             const json& _file_modified_parameters,
             const bool _privileged,
             const rodsLong_t _bytes_written) -> std::tuple<nlohmann::json, int>
         {
             const bool trigger_file_modified = !_file_modified_parameters.empty();
 
-            const auto input = [&]() -> json
+            // Store a backup of this replica state table entry. If anything goes wrong in the data_object_finalize
+            // step, the replica_state_table entry should be restored so that the caller can determine what to do
+            // with the object (e.g. retry, unlock and stale, etc.)
+            entry backup_entry;
+
+            auto input = [&]() -> dof::input
             {
                 std::scoped_lock rst_lock{rst_mutex};
 
-                auto& target_entry = replica_state_json_map.at(_key);
+                auto& target_entry = entry_at(_key);
 
                 if (trigger_file_modified) {
-                    target_entry.at(REPLICAS_KW).at(_replica_index)[FILE_MODIFIED_KW] = _file_modified_parameters;
+                    auto& target_replica = std::visit([&_key](auto&& _id) -> replica_entry& {
+                        if constexpr (std::is_same_v<std::decay_t<decltype(_id)>, std::string_view>) {
+                            return replica_at_resource(_key, leaf_resource_id(_id));
+                        }
+                        else {
+                            return replica_at(_key, _id);
+                        }
+                    }, _replica_id);
+
+                    target_replica.file_modified = _file_modified_parameters;
+
+                    backup_entry = target_entry;
                 }
 
-                return json{
-                    {"irods_admin", _privileged},
-                    {"bytes_written", std::to_string(_bytes_written)},
-                    {REPLICAS_KW, target_entry.at(REPLICAS_KW)},
-                    {"trigger_file_modified", trigger_file_modified}
-                };
+                return dof::input{to_replica_updates(target_entry), _privileged, _bytes_written, trigger_file_modified};
             }();
 
-            // Store a backup of this replica state table entry. If anything goes wrong in the data_object_finalize
-            // step, the replica_state_table entry should be restored so that the caller can determine what to do
-            // with the object (e.g. retry, unlock and stale, etc.)
-            json backup_entry;
-
-            {
-                std::scoped_lock rst_lock{rst_mutex};
-
-                backup_entry = replica_state_json_map.at(_key);
-            }
-
             int ec = 0;
             const auto restore_entry = irods::at_scope_exit{[&]
             {
                 if (ec < 0 && trigger_file_modified) {
-                    if (const auto restore_ec = insert_entry(_key, backup_entry); restore_ec < 0) {
-                        irods::log(LOG_NOTICE, fmt::format(
-                            "failed to restore replica_state_table_entry [error_code=[{}]]", restore_ec));
-                    }
+                    std::scoped_lock rst_lock{rst_mutex};
+                    replica_state_map[_key] = std::move(backup_entry);
                 }
             }};
 
@@ -218,20 +400,18 @@ namespace irods::replica_state_table
             if (trigger_file_modified) {
                 std::scoped_lock rst_lock{rst_mutex};
 
-                replica_state_json_map.erase(_key);
+                replica_state_map.erase(_key);
             }
 
-            char* error_string{};
-            const irods::at_scope_exit free_error_string{[&error_string] { free(error_string); }};
-
-            ec = rs_data_object_finalize(&_comm, input.dump().data(), &error_string);
+            // The replica states are handed to the catalog writer directly rather than being
+            // serialized for the data_object_finalize API.
+            json ret;
+            std::tie(ret, ec) = dof::finalize(_comm, input);
 
             if (ec < 0) {
                 irods::log(LOG_ERROR, fmt::format("failed to publish replica states for [{}]", _key));
             }
 
-            auto ret = json::parse(error_string);
-
             return std::make_tuple(ret, ec);
         } // publish_to_catalog_impl
     } // anonymouse namespace
@@ -242,7 +422,7 @@ namespace irods::replica_state_table
 
         irods::log(LOG_DEBUG9, fmt::format("[{}:{}] - initializing state table", __FUNCTION__, __LINE__));
 
-        replica_state_json_map.clear();
+        replica_state_map.clear();
     } // init
 
     auto deinit() -> void
@@ -251,123 +431,84 @@ namespace irods::replica_state_table
 
         irods::log(LOG_DEBUG9, fmt::format("[{}:{}] - de-initializing state table", __FUNCTION__, __LINE__));
 
-        replica_state_json_map.clear();
+        replica_state_map.clear();
     } // deinit
 
     auto insert(const id::data_object_proxy_t& _obj) -> int
     {
         const auto& key = get_key(_obj);
 
-        try {
-            std::scoped_lock rst_lock{rst_mutex};
-
-            if (std::end(replica_state_json_map) != replica_state_json_map.find(key)) {
-                irods::log(LOG_DEBUG, fmt::format("[{}:{}] - entry exists;path:[{}]", __FUNCTION__, __LINE__, _obj.logical_path()));
-                return 0;
-            }
-
-            json replica_list;
-
-            for (const auto& r : _obj.replicas()) {
-                const auto json_replica = ir::to_json(r);
-
-                replica_list.push_back({
-                    {BEFORE_KW, json_replica},
-                    {AFTER_KW, json_replica}
-                });
-            }
+        std::vector<replica_entry> replicas;
+        replicas.reserve(_obj.replica_count());
 
-            const json entry{
-                {REPLICAS_KW, replica_list},
-                {"logical_path", _obj.logical_path()}
-            };
+        for (const auto& r : _obj.replicas()) {
+            replicas.push_back(to_replica_entry(r));
+        }
 
-            irods::log(LOG_DEBUG9, fmt::format("[{}:{}] - entry:[{}]", __FUNCTION__, __LINE__, entry.dump()));
+        std::scoped_lock rst_lock{rst_mutex};
 
-            replica_state_json_map[key] = entry;
+        const auto [iter, inserted] = replica_state_map.try_emplace(key, entry{std::string{_obj.logical_path()}, std::move(replicas)});
 
-            return 0;
+        if (!inserted) {
+            irods::log(LOG_DEBUG, fmt::format("[{}:{}] - entry exists;path:[{}]", __FUNCTION__, __LINE__, _obj.logical_path()));
         }
-        catch (const json::exception& e) {
-            irods::log(LOG_ERROR, fmt::format("[{}:{}] - JSON error:[{}]", __FUNCTION__, __LINE__, e.what()));
 
-            return SYS_LIBRARY_ERROR;
-        }
+        return 0;
     } // insert
 
     auto insert(const ir::replica_proxy_t& _replica) -> int
     {
-        try {
-            if (!contains(_replica.data_id())) {
-                const auto obj = id::make_data_object_proxy(*_replica.get());
-                return insert(obj);
-            }
-
-            const auto& key = get_key(_replica);
-
-            std::scoped_lock rst_lock{rst_mutex};
-
-            const auto json_replica = ir::to_json(_replica);
+        if (!contains(_replica.data_id())) {
+            const auto obj = id::make_data_object_proxy(*_replica.get());
+            return insert(obj);
+        }
 
-            auto& entry = replica_state_json_map.at(key);
-            entry.at(REPLICAS_KW).push_back(
-                {
-                    {BEFORE_KW, json_replica},
-                    {AFTER_KW, json_replica}
-                }
-            );
+        auto replica = to_replica_entry(_replica);
 
-            irods::log(LOG_DEBUG9, fmt::format("[{}:{}] - entry:[{}]", __FUNCTION__, __LINE__, entry.dump()));
+        std::scoped_lock rst_lock{rst_mutex};
 
-            return 0;
-        }
-        catch (const json::exception& e) {
-            irods::log(LOG_ERROR, fmt::format("[{}:{}] - JSON error:[{}]", __FUNCTION__, __LINE__, e.what()));
+        entry_at(get_key(_replica)).replicas.push_back(std::move(replica));
 
-            return SYS_LIBRARY_ERROR;
-        }
+        return 0;
     } // insert
 
     auto erase(const key_type& _key) -> void
     {
-        if (!contains(_key)) {
-            THROW(KEY_NOT_FOUND, fmt::format(
-                "[{}:{}] - no key found for [{}]",
-                __FUNCTION__, __LINE__, _key));
-        }
+        {
+            std::scoped_lock rst_lock{rst_mutex};
 
-        std::scoped_lock rst_lock{rst_mutex};
+            if (0 == replica_state_map.erase(_key)) {
+                THROW(KEY_NOT_FOUND, fmt::format(
+                    "[{}:{}] - no key found for [{}]",
+                    __FUNCTION__, __LINE__, _key));
+            }
+        }
 
-        replica_state_json_map.erase(_key);
+        // The catalog information for the data object has likely changed since it was opened.
+        irods::hierarchy_resolution_cache::erase(_key);
     } // erase
 
     auto erase(const key_type& _key, const std::string_view _leaf_resource_name) -> void
     {
-        const auto replica_index = index_of(_key, _leaf_resource_name);
+        const auto resc_id = leaf_resource_id(_leaf_resource_name);
 
         std::scoped_lock rst_lock{rst_mutex};
 
-        auto& entry = replica_state_json_map.at(_key).at(REPLICAS_KW);
-
-        return entry.erase(replica_index);
+        erase_replica(_key, replica_at_resource(_key, resc_id));
     } // erase
 
     auto erase(const key_type& _key, const int _replica_number) -> void
     {
-        const auto replica_index = index_of(_key, _replica_number);
-
         std::scoped_lock rst_lock{rst_mutex};
 
-        auto& entry = replica_state_json_map.at(_key).at(REPLICAS_KW);
-
-        return entry.erase(replica_index);
+        erase_replica(_key, replica_at(_key, _replica_number));
     } // erase
 
     auto contains(const key_type& _key) -> bool
     {
         std::scoped_lock rst_lock{rst_mutex};
 
-        return std::end(replica_state_json_map) != replica_state_json_map.find(_key);
+        return find_entry(_key);
     } // contains
 
     auto contains(const key_type& _key, const std::string_view _leaf_resource_name) -> bool
@@ -376,47 +517,25 @@ namespace irods::replica_state_table
             return false;
         }
 
-        const auto resc_id = resc_mgr.hier_to_leaf_id(resc_mgr.get_hier_to_root_for_resc(_leaf_resource_name));
+        const auto resc_id = leaf_resource_id(_leaf_resource_name);
 
         std::scoped_lock rst_lock{rst_mutex};
 
-        for (const auto& e : replica_state_json_map.at(_key).at(REPLICAS_KW)) {
-            if (resc_id == std::stoll(e.at(BEFORE_KW).at("resc_id").get<std::string>())) {
-                return true;
-            }
-        }
-
-        return false;
+        return find_replica_by_resource(_key, resc_id);
     } // contains
 
     auto contains(const key_type& _key, const int _replica_number) -> bool
     {
-        if (!contains(_key)) {
-            return false;
-        }
-
         std::scoped_lock rst_lock{rst_mutex};
 
-        for (const auto& e : replica_state_json_map.at(_key).at(REPLICAS_KW)) {
-            if (_replica_number == std::stoi(e.at(BEFORE_KW).at("data_repl_num").get<std::string>())) {
-                return true;
-            }
-        }
-
-        return false;
+        return find_replica_by_number(_key, _replica_number);
     } // contains
 
     auto at(const key_type& _key) -> json
     {
         std::scoped_lock rst_lock{rst_mutex};
 
-        if (std::end(replica_state_json_map) == replica_state_json_map.find(_key)) {
-            THROW(KEY_NOT_FOUND, fmt::format(
-                "[{}:{}] - no key found for [{}]",
-                __FUNCTION__, __LINE__, _key));
-        }
-
-        return replica_state_json_map.at(_key).at(REPLICAS_KW);
+        return to_json(entry_at(_key));
     } // at
 
     auto at(
@@ -424,35 +543,11 @@ namespace irods::replica_state_table
         const std::string_view _leaf_resource_name,
         const state_type _state) -> json
     {
-        std::scoped_lock rst_lock{rst_mutex};
-
-        const auto resc_id = resc_mgr.hier_to_leaf_id(resc_mgr.get_hier_to_root_for_resc(_leaf_resource_name));
+        const auto resc_id = leaf_resource_id(_leaf_resource_name);
 
-        const auto& replica_json = [&_key, &resc_id]
-        {
-            for (const auto& e : replica_state_json_map.at(_key).at(REPLICAS_KW)) {
-                if (resc_id == std::stoll(e.at(BEFORE_KW).at("resc_id").get<std::string>())) {
-                    return e;
-                }
-            }
+        std::scoped_lock rst_lock{rst_mutex};
 
-            THROW(KEY_NOT_FOUND, fmt::format(
-                "[{}:{}] - no resc id [{}] found for [{}]",
-                __FUNCTION__, __LINE__, resc_id, _key));
-        }();
-
-        switch (_state) {
-            // clang-format off
-            case state_type::before:    return replica_json.at(BEFORE_KW);   break;
-            case state_type::after:     return replica_json.at(AFTER_KW);    break;
-            case state_type::both:      return replica_json;                 break;
-            // clang-format on
-
-            default:
-                THROW(SYS_INVALID_INPUT_PARAM, fmt::format(
-                    "[{}:{}] - invalid state_type",
-                    __FUNCTION__, __LINE__));
-        }
+        return to_json(replica_at_resource(_key, resc_id), _state);
     } // at
 
     auto at(
@@ -462,31 +557,7 @@ namespace irods::replica_state_table
     {
         std::scoped_lock rst_lock{rst_mutex};
 
-        const auto& replica_json = [&_key, &_replica_number]
-        {
-            for (const auto& e : replica_state_json_map.at(_key).at(REPLICAS_KW)) {
-                if (_replica_number == std::stoi(e.at(BEFORE_KW).at("data_repl_num").get<std::string>())) {
-                    return e;
-                }
-            }
-
-            THROW(KEY_NOT_FOUND, fmt::format(
-                "[{}:{}] - no replica number [{}] found for [{}]",
-                __FUNCTION__, __LINE__, _replica_number, _key));
-        }();
-
-        switch (_state) {
-            // clang-format off
-            case state_type::before:    return replica_json.at(BEFORE_KW);   break;
-            case state_type::after:     return replica_json.at(AFTER_KW);    break;
-            case state_type::both:      return replica_json;                 break;
-            // clang-format on
-
-            default:
-                THROW(SYS_INVALID_INPUT_PARAM, fmt::format(
-                    "[{}:{}] - invalid state_type",
-                    __FUNCTION__, __LINE__));
-        }
+        return to_json(replica_at(_key, _replica_number), _state);
     } // at
 
     auto update(
@@ -494,9 +565,16 @@ namespace irods::replica_state_table
         const std::string_view _leaf_resource_name,
         const json& _updates) -> void
     {
-        const auto replica_index = index_of(_key, _leaf_resource_name);
+        const auto resc_id = leaf_resource_id(_leaf_resource_name);
 
-        return update_impl(_key, replica_index, _updates);
+        try {
+            std::scoped_lock rst_lock{rst_mutex};
+
+            update_impl(replica_at_resource(_key, resc_id), _updates);
+        }
+        catch (const json::exception& e) {
+            THROW(SYS_LIBRARY_ERROR, fmt::format("[{}:{}] - JSON error:[{}]", __FUNCTION__, __LINE__, e.what()));
+        }
     } // update
 
     auto update(
@@ -504,18 +582,25 @@ namespace irods::replica_state_table
         const int _replica_number,
         const json& _updates) -> void
     {
-        const auto replica_index = index_of(_key, _replica_number);
+        try {
+            std::scoped_lock rst_lock{rst_mutex};
 
-        return update_impl(_key, replica_index, _updates);
+            update_impl(replica_at(_key, _replica_number), _updates);
+        }
+        catch (const json::exception& e) {
+            THROW(SYS_LIBRARY_ERROR, fmt::format("[{}:{}] - JSON error:[{}]", __FUNCTION__, __LINE__, e.what()));
+        }
     } // update
 
     auto update(
         const key_type& _key,
         const ir::replica_proxy_t& _replica) -> void
     {
-        const auto replica_index = index_of(_key, _replica.resource_id());
+        auto record = to_record(_replica);
 
-        return update_impl(_key, replica_index, ir::to_json(_replica));
+        std::scoped_lock rst_lock{rst_mutex};
+
+        replica_at_resource(_key, _replica.resource_id()).after = std::move(record);
     } // update
 
     auto get_property(
@@ -528,9 +613,13 @@ namespace irods::replica_state_table
             THROW(SYS_INVALID_INPUT_PARAM, fmt::format("state type must be before or after"));
         }
 
-        const auto replica_json = at(_key, _replica_number, _state);
+        const auto member = column(_property_name);
+
+        std::scoped_lock rst_lock{rst_mutex};
+
+        const auto& replica = replica_at(_key, _replica_number);
 
-        return replica_json.at(_property_name.data());
+        return get_column(state_type::before == _state ? replica.before : replica.after, member);
     } // get_property
 
     auto get_property(
@@ -543,16 +632,21 @@ namespace irods::replica_state_table
             THROW(SYS_INVALID_INPUT_PARAM, fmt::format("state type must be before or after"));
         }
 
-        const auto replica_json = at(_key, _leaf_resource_name, _state);
+        const auto member = column(_property_name);
+        const auto resc_id = leaf_resource_id(_leaf_resource_name);
+
+        std::scoped_lock rst_lock{rst_mutex};
 
-        return replica_json.at(_property_name.data());
+        const auto& replica = replica_at_resource(_key, resc_id);
+
+        return get_column(state_type::before == _state ? replica.before : replica.after, member);
     } // get_property
 
     auto get_logical_path(const key_type& _key) -> std::string
     {
         std::scoped_lock rst_lock{rst_mutex};
 
-        return replica_state_json_map.at(_key).at("logical_path").get<std::string>();
+        return entry_at(_key).logical_path;
     } // get_logical_path
 
     namespace publish
@@ -560,17 +654,10 @@ namespace irods::replica_state_table
         auto to_catalog(RsComm& _comm, const context& _ctx) -> std::tuple<nlohmann::json, int>
         {
             try {
-                // Do not attempt to find the index of _replica_number_for_file_modified
-                // if no file_modified parameter is provided. This is a valid use case for
-                // data objects for which a new replica is being created (but not yet).
-                // Just pass some value to satisfy the implementation interface.
-                if (_ctx.file_modified_parameters.empty()) {
-                    return publish_to_catalog_impl(_comm, _ctx.key, -1, {}, _ctx.privileged, _ctx.bytes_written);
-                }
-
-                const auto replica_index = std::visit([&_ctx](auto&& _replica_id) { return index_of(_ctx.key, _replica_id); }, _ctx.replica_id);
-
-                return publish_to_catalog_impl(_comm, _ctx.key, replica_index, _ctx.file_modified_parameters, _ctx.privileged, _ctx.bytes_written);
+                // The replica identified by the context is only needed when a file_modified
+                // parameter is provided. This is a valid use case for data objects for which
+                // a new replica is being created (but not yet).
+                return publish_to_catalog_impl(_comm, _ctx.key, _ctx.replica_id, _ctx.file_modified_parameters, _ctx.privileged, _ctx.bytes_written);
             }
             catch (const json::exception& e) {
                 THROW(SYS_LIBRARY_ERROR, fmt::format("[{}:{}] - JSON error:[{}]", __FUNCTION__, __LINE__, e.what()));
@@ -584,4 +671,3 @@ namespace irods::replica_state_table
         } // to_catalog
     } // namespace publish
 } // namespace irods
-
@@ -0,0 +1,255 @@
+#include "resource_tree_snapshot.hpp"
+
+#include "rodsLog.h"
+
+#include <boost/interprocess/managed_shared_memory.hpp>
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <boost/interprocess/containers/string.hpp>
+#include <boost/interprocess/allocators/allocator.hpp>
+#include <boost/interprocess/sync/named_sharable_mutex.hpp>
+#include <boost/interprocess/sync/scoped_lock.hpp>
+#include <boost/interprocess/sync/sharable_lock.hpp>
+
+#include "json.hpp"
+
+#include <memory>
+#include <utility>
+
+#include <sys/types.h>
+#include <unistd.h>
+
+namespace
+{
+    namespace bi = boost::interprocess;
+
+    using std::chrono::duration_cast;
+    using std::chrono::seconds;
+
+    using json = nlohmann::json;
+
+    using resource_record = irods::experimental::resource_tree_snapshot::resource_record;
+
+    // clang-format off
+    using segment_manager_type = bi::managed_shared_memory::segment_manager;
+    using void_allocator_type  = bi::allocator<void, segment_manager_type>;
+    using char_allocator_type  = bi::allocator<char, segment_manager_type>;
+    using string_type          = bi::basic_string<char, std::char_traits<char>, char_allocator_type>;
+    using clock_type           = std::chrono::system_clock;
+    // clang-format on
+
+    // The shared memory representation of the snapshot. The rows are stored as a
+    // single serialized string so that copying them out only requires one allocation.
+    struct snapshot_type
+    {
+        explicit snapshot_type(const void_allocator_type& _alloc)
+            : generation{}
+            , expiration{}
+            , valid{}
+            , data{_alloc}
+        {
+        }
+
+        std::uint64_t generation;
+        std::int64_t expiration;
+        bool valid;
+        string_type data;
+    }; // struct snapshot_type
+
+    //
+    // Global Variables
+    //
+
+    // The following variables define the names of shared memory objects and other properties.
+    std::string g_segment_name;
+    std::size_t g_segment_size;
+    std::string g_mutex_name;
+
+    // On initialization, holds the PID of the process that initialized the snapshot.
+    // This ensures that only the process that initialized the system can deinitialize it.
+    pid_t g_owner_pid;
+
+    // The following are pointers to the shared memory objects and allocator.
+    // Allocating on the heap allows us to know when the snapshot is constructed/destructed.
+    std::unique_ptr<bi::managed_shared_memory> g_segment;
+    std::unique_ptr<void_allocator_type> g_allocator;
+    std::unique_ptr<bi::named_sharable_mutex> g_mutex;
+    snapshot_type* g_snapshot;
+
+    auto current_timestamp_in_seconds() noexcept -> std::int64_t
+    {
+        return duration_cast<seconds>(clock_type::now().time_since_epoch()).count();
+    }
+
+    // Each record is serialized as an array of its members to keep the snapshot small.
+    auto to_json(const std::vector<resource_record>& _records) -> json
+    {
+        auto rows = json::array();
+
+        for (auto&& r : _records) {
+            rows.push_back(json::array({r.id, r.name, r.zone, r.type, r.class_name, r.location,
+                                        r.vault_path, r.free_space, r.info, r.comments,
+                                        r.create_time, r.modify_time, r.status, r.children,
+                                        r.context, r.parent, r.parent_context}));
+        }
+
+        return rows;
+    } // to_json
+
+    auto from_json(const json& _rows) -> std::vector<resource_record>
+    {
+        std::vector<resource_record> records;
+        records.reserve(_rows.size());
+
+        for (auto&& row : _rows) {
+            auto& r = records.emplace_back();
+            auto i = 0;
+
+            for (auto* member : {&r.id, &r.name, &r.zone, &r.type, &r.class_name, &r.location,
+                                 &r.vault_path, &r.free_space, &r.info, &r.comments,
+                                 &r.create_time, &r.modify_time, &r.status, &r.children,
+                                 &r.context, &r.parent, &r.parent_context})
+            {
+                *member = row.at(i++).get<std::string>();
+            }
+        }
+
+        return records;
+    } // from_json
+} // anonymous namespace
+
+namespace irods::experimental::resource_tree_snapshot
+{
+    auto init(const std::string_view _shm_name, std::size_t _shm_size) -> void
+    {
+        if (getpid() == g_owner_pid) {
+            return;
+        }
+
+        g_segment_name = _shm_name.data();
+        g_segment_size = _shm_size;
+        g_mutex_name = g_segment_name + "_mutex";
+
+        bi::named_sharable_mutex::remove(g_mutex_name.data());
+        bi::shared_memory_object::remove(g_segment_name.data());
+
+        g_owner_pid = getpid();
+        g_segment = std::make_unique<bi::managed_shared_memory>(bi::create_only, g_segment_name.data(), g_segment_size);
+        g_allocator = std::make_unique<void_allocator_type>(g_segment->get_segment_manager());
+        g_mutex = std::make_unique<bi::named_sharable_mutex>(bi::create_only, g_mutex_name.data());
+        g_snapshot = g_segment->construct<snapshot_type>(bi::anonymous_instance)(*g_allocator);
+    } // init
+
+    auto deinit() noexcept -> void
+    {
+        if (getpid() != g_owner_pid) {
+            return;
+        }
+
+        try {
+            g_owner_pid = 0;
+
+            if (g_segment && g_snapshot) {
+                g_segment->destroy_ptr(g_snapshot);
+                g_snapshot = nullptr;
+            }
+
+            // clang-format off
+            if (g_mutex)     { g_mutex.reset(); }
+            if (g_allocator) { g_allocator.reset(); }
+            if (g_segment)   { g_segment.reset(); }
+            // clang-format on
+
+            bi::named_sharable_mutex::remove(g_mutex_name.data());
+            bi::shared_memory_object::remove(g_segment_name.data());
+        }
+        catch (...) {}
+    } // deinit
+
+    auto generation() -> std::uint64_t
+    {
+        if (!g_snapshot) {
+            return 0;
+        }
+
+        bi::sharable_lock lk{*g_mutex};
+        return g_snapshot->generation;
+    } // generation
+
+    auto store(const std::vector<resource_record>& _records,
+               std::uint64_t _generation,
+               seconds _expires_after) -> bool
+    {
+        if (!g_snapshot) {
+            return false;
+        }
+
+        // Serialize before taking the lock to keep the critical section short.
+        const auto data = to_json(_records).dump();
+
+        bi::scoped_lock lk{*g_mutex};
+
+        // The resource table changed while the caller was querying the catalog.
+        if (_generation != g_snapshot->generation) {
+            return false;
+        }
+
+        try {
+            g_snapshot->data.assign(data.data(), data.size());
+            g_snapshot->expiration = current_timestamp_in_seconds() + _expires_after.count();
+            g_snapshot->valid = true;
+
+            return true;
+        }
+        catch (const bi::bad_alloc&) {
+            rodsLog(LOG_WARNING, "Resource tree snapshot does not fit in shared memory [required=%zu, size=%zu].",
+                    data.size(), g_segment_size);
+
+            g_snapshot->data.clear();
+            g_snapshot->valid = false;
+        }
+
+        return false;
+    } // store
+
+    auto load() -> std::optional<std::vector<resource_record>>
+    {
+        if (!g_snapshot) {
+            return std::nullopt;
+        }
+
+        std::string data;
+
+        {
+            bi::sharable_lock lk{*g_mutex};
+
+            if (!g_snapshot->valid || current_timestamp_in_seconds() >= g_snapshot->expiration) {
+                return std::nullopt;
+            }
+
+            data.assign(g_snapshot->data.data(), g_snapshot->data.size());
+        }
+
+        try {
+            return from_json(json::parse(data));
+        }
+        catch (const json::exception& e) {
+            rodsLog(LOG_ERROR, "Could not parse resource tree snapshot [%s].", e.what());
+        }
+
+        return std::nullopt;
+    } // load
+
+    auto invalidate() -> void
+    {
+        if (!g_snapshot) {
+            return;
+        }
+
+        bi::scoped_lock lk{*g_mutex};
+
+        ++g_snapshot->generation;
+        g_snapshot->valid = false;
+        g_snapshot->data.clear();
+        g_snapshot->data.shrink_to_fit();
+    } // invalidate
+} // namespace irods::experimental::resource_tree_snapshot
@@ -26,6 +26,8 @@
 #include "irods_logger.hpp"
 #include "hostname_cache.hpp"
 #include "dns_cache.hpp"
+#include "resource_tree_snapshot.hpp"
+#include "latency_histograms.hpp"
 #include "server_utilities.hpp"
 
 #include <pthread.h>
@@ -344,6 +346,12 @@ int main(int argc, char** argv)
     ix::replica_access_table::init();
     irods::at_scope_exit deinit_replica_access_table{[] { ix::replica_access_table::deinit(); }};
 
+    ix::resource_tree_snapshot::init("irods_resource_tree_snapshot", irods::get_resource_tree_snapshot_shared_memory_size());
+    irods::at_scope_exit deinit_resource_tree_snapshot{[] { ix::resource_tree_snapshot::deinit(); }};
+
+    ix::latency_histograms::init("irods_latency_histograms");
+    irods::at_scope_exit deinit_latency_histograms{[] { ix::latency_histograms::deinit(); }};
+
     remove_leftover_rulebase_pid_files();
 
     irods::parse_and_store_hosts_configuration_file_as_json();
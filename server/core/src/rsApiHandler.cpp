@@ -30,6 +30,7 @@ jmp_buf Jenv;
 #include "irods_hierarchy_parser.hpp"
 #include "irods_api_number_validator.hpp"
 #include "irods_logger.hpp"
+#include "latency_histograms.hpp"
 
 #define MAKE_IRODS_ERROR_MAP
 #include "rodsErrorTable.h"
@@ -149,9 +150,10 @@ int rsApiHandler(rsComm_t*   rsComm,
     char *myInStruct = NULL;
 
     if ( inputStructBBuf->len > 0 ) {
-        status = unpack_struct( inputStructBBuf->buf, ( void ** )( static_cast< void * >( &myInStruct ) ),
-                               ( char* )RsApiTable[apiInx]->inPackInstruct, RodsPackTable, rsComm->irodsProt,
-                               rsComm->cliVersion.relVersion);
+        status = unpack_struct_with_length( inputStructBBuf->buf, inputStructBBuf->len,
+                                           ( void ** )( static_cast< void * >( &myInStruct ) ),
+                                           ( char* )RsApiTable[apiInx]->inPackInstruct, RodsPackTable, rsComm->irodsProt,
+                                           rsComm->cliVersion.relVersion);
         if ( status < 0 ) {
             rodsLog( LOG_NOTICE, "rsApiHandler: unpackStruct error for apiNumber %d, status = %d",
                      apiNumber, status );
@@ -192,40 +194,44 @@ int rsApiHandler(rsComm_t*   rsComm,
     };
 
     int retVal = 0;
-    if ( numArg == 0 ) {
-        retVal = api_entry->call_wrapper(
-                     api_entry.get(),
-                     rsComm );
-    }
-    else if ( numArg == 1 ) {
-        retVal = api_entry->call_wrapper(
-                     api_entry.get(),
-                     rsComm,
-                     myArgv[0] );
-    }
-    else if ( numArg == 2 ) {
-        retVal = api_entry->call_wrapper(
-                     api_entry.get(),
-                     rsComm,
-                     myArgv[0],
-                     myArgv[1] );
-    }
-    else if ( numArg == 3 ) {
-        retVal = api_entry->call_wrapper(
-                     api_entry.get(),
-                     rsComm,
-                     myArgv[0],
-                     myArgv[1],
-                     myArgv[2] );
-    }
-    else if ( numArg == 4 ) {
-        retVal = api_entry->call_wrapper(
-                     api_entry.get(),
-                     rsComm,
-                     myArgv[0],
-                     myArgv[1],
-                     myArgv[2],
-                     myArgv[3]);
+    {
+        ix::latency_histograms::scoped_timer timer{apiNumber, api_entry->operation_name};
+
+        if ( numArg == 0 ) {
+            retVal = api_entry->call_wrapper(
+                         api_entry.get(),
+                         rsComm );
+        }
+        else if ( numArg == 1 ) {
+            retVal = api_entry->call_wrapper(
+                         api_entry.get(),
+                         rsComm,
+                         myArgv[0] );
+        }
+        else if ( numArg == 2 ) {
+            retVal = api_entry->call_wrapper(
+                         api_entry.get(),
+                         rsComm,
+                         myArgv[0],
+                         myArgv[1] );
+        }
+        else if ( numArg == 3 ) {
+            retVal = api_entry->call_wrapper(
+                         api_entry.get(),
+                         rsComm,
+                         myArgv[0],
+                         myArgv[1],
+                         myArgv[2] );
+        }
+        else if ( numArg == 4 ) {
+            retVal = api_entry->call_wrapper(
+                         api_entry.get(),
+                         rsComm,
+                         myArgv[0],
+                         myArgv[1],
+                         myArgv[2],
+                         myArgv[3]);
+        }
     }
 
     if ( retVal != SYS_NO_HANDLER_REPLY_MSG ) {
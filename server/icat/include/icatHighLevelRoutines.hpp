@@ -36,12 +36,15 @@ int chlModDataObjMeta( rsComm_t *rsComm, dataObjInfo_t *dataObjInfo,
                        keyValPair_t *regParam );
 int chlUpdateRescObjCount( const std::string& _resc, int _delta );
 int chlRegDataObj( rsComm_t *rsComm, dataObjInfo_t *dataObjInfo );
+int chlRegDataObjBulk( rsComm_t *rsComm, std::vector<dataObjInfo_t>& dataObjInfos );
 int chlRegRuleExecObj( rsComm_t *rsComm,
                        ruleExecSubmitInp_t *ruleExecSubmitInp );
 int chlRegReplica( rsComm_t *rsComm, dataObjInfo_t *srcDataObjInfo,
                    dataObjInfo_t *dstDataObjInfo, keyValPair_t *condInput );
 int chlUnregDataObj( rsComm_t *rsComm, dataObjInfo_t *dataObjInfo,
                      keyValPair_t *condInput );
+int chlUnregDataObjBulk( rsComm_t *rsComm, std::vector<dataObjInfo_t>& dataObjInfos,
+                         keyValPair_t *condInput );
 int chlRegResc( rsComm_t *rsComm, std::map<std::string, std::string>& _resc_input );
 int chlAddChildResc( rsComm_t* rsComm, std::map<std::string, std::string>& _resc_input );
 int chlDelResc( rsComm_t *rsComm, const std::string& _resc_name, int _dryrun = 0 ); // JMC
@@ -109,6 +112,8 @@ int chlDelRuleExec( rsComm_t *rsComm, const char *ruleExecId );
 
 int chlRenameObject( rsComm_t *rsComm, rodsLong_t objId, const char *newName );
 int chlMoveObject( rsComm_t *rsComm, rodsLong_t objId, rodsLong_t targetCollId );
+int chlMoveCollDataPaths( rsComm_t *rsComm, rodsLong_t rescId, const char *collName,
+                          const char *vaultPath, const char *oldDir, const char *newDir );
 
 int chlRegToken( rsComm_t *rsComm, const char *nameSpace, const char *name, const char *value,
                  const char *value2, const char *value3, const char *comment );
@@ -533,6 +533,60 @@ int chlRegDataObj(
 
 } // chlRegDataObj
 
+// =-=-=-=-=-=-=-
+// chlRegDataObjBulk - Register many new iRODS files (data objects)
+// Input - rsComm_t *rsComm  - the server handle
+//         std::vector<dataObjInfo_t>& - info about each data object. The
+//         data id, collection id and owner of each entry are set on success.
+// Nothing is committed; the caller must commit or roll back.
+int chlRegDataObjBulk(
+    rsComm_t*                   _comm,
+    std::vector<dataObjInfo_t>& _data_obj_infos ) {
+    // =-=-=-=-=-=-=-
+    // call factory for database object
+    irods::database_object_ptr db_obj_ptr;
+    irods::error ret = irods::database_factory(
+                           database_plugin_type,
+                           db_obj_ptr );
+    if ( !ret.ok() ) {
+        irods::log( PASS( ret ) );
+        return ret.code();
+    }
+
+    // =-=-=-=-=-=-=-
+    // resolve a plugin for that object
+    irods::plugin_ptr db_plug_ptr;
+    ret = db_obj_ptr->resolve(
+              irods::DATABASE_INTERFACE,
+              db_plug_ptr );
+    if ( !ret.ok() ) {
+        irods::log(
+            PASSMSG(
+                "failed to resolve database interface",
+                ret ) );
+        return ret.code();
+    }
+
+    // =-=-=-=-=-=-=-
+    // cast plugin and object to db and fco for call
+    irods::first_class_object_ptr ptr = boost::dynamic_pointer_cast <
+                                        irods::first_class_object > ( db_obj_ptr );
+    irods::database_ptr           db = boost::dynamic_pointer_cast <
+                                       irods::database > ( db_plug_ptr );
+
+    // =-=-=-=-=-=-=-
+    // call the operation on the plugin
+    ret = db->call <
+          std::vector<dataObjInfo_t>* > (
+              _comm,
+              irods::DATABASE_OP_REG_DATA_OBJ_BULK,
+              ptr,
+              &_data_obj_infos );
+
+    return ret.code();
+
+} // chlRegDataObjBulk
+
 // =-=-=-=-=-=-=-
 // chlRegReplica - Register a new iRODS replica file (data object)
 // Input - rsComm_t *rsComm  - the server handle
@@ -650,6 +704,64 @@ int chlUnregDataObj(
 
 } // chlUnregDataObj
 
+// =-=-=-=-=-=-=-
+// chlUnregDataObjBulk - Unregister many replicas
+// Input - rsComm_t *rsComm  - the server handle
+//         std::vector<dataObjInfo_t>& - the replicas. The data id, replica
+//         number and logical path of each entry must be set.
+//         keyValPair_t *condInput - used to specify a admin-mode.
+// All of the replicas are unregistered and committed, or none are.
+int chlUnregDataObjBulk(
+    rsComm_t*                   _comm,
+    std::vector<dataObjInfo_t>& _data_obj_infos,
+    keyValPair_t*               _cond_input ) {
+    // =-=-=-=-=-=-=-
+    // call factory for database object
+    irods::database_object_ptr db_obj_ptr;
+    irods::error ret = irods::database_factory(
+                           database_plugin_type,
+                           db_obj_ptr );
+    if ( !ret.ok() ) {
+        irods::log( PASS( ret ) );
+        return ret.code();
+    }
+
+    // =-=-=-=-=-=-=-
+    // resolve a plugin for that object
+    irods::plugin_ptr db_plug_ptr;
+    ret = db_obj_ptr->resolve(
+              irods::DATABASE_INTERFACE,
+              db_plug_ptr );
+    if ( !ret.ok() ) {
+        irods::log(
+            PASSMSG(
+                "failed to resolve database interface",
+                ret ) );
+        return ret.code();
+    }
+
+    // =-=-=-=-=-=-=-
+    // cast plugin and object to db and fco for call
+    irods::first_class_object_ptr ptr = boost::dynamic_pointer_cast <
+                                        irods::first_class_object > ( db_obj_ptr );
+    irods::database_ptr           db = boost::dynamic_pointer_cast <
+                                       irods::database > ( db_plug_ptr );
+
+    // =-=-=-=-=-=-=-
+    // call the operation on the plugin
+    ret = db->call <
+          std::vector<dataObjInfo_t>*,
+          keyValPair_t* > (
+              _comm,
+              irods::DATABASE_OP_UNREG_DATA_OBJ_BULK,
+              ptr,
+              &_data_obj_infos,
+              _cond_input );
+
+    return ret.code();
+
+} // chlUnregDataObjBulk
+
 // =-=-=-=-=-=-=-
 // chlRegRuleExec - Register a new iRODS delayed rule execution object
 // Input - rsComm_t *rsComm  - the server handle
@@ -3061,6 +3173,81 @@ int chlMoveObject(
 
 } // chlMoveObject
 
+// =-=-=-=-=-=-=-
+// chlMoveCollDataPaths - Update the physical paths of the replicas on a
+// resource under a collection whose vault directory has been moved.
+// Input - rsComm_t *rsComm  - the server handle
+//         rodsLong_t rescId - the leaf resource holding the replicas
+//         const char *collName - the logical path of the collection
+//         const char *vaultPath - the vault path of the resource
+//         const char *oldDir - the vault directory before the move
+//         const char *newDir - the vault directory after the move
+// Only the replicas stored under oldDir are updated. Fails without changing
+// the catalog unless every replica on the resource under the collection which
+// is stored in the vault is stored at oldDir followed by its path relative to
+// the collection, and no other replica on the resource is stored under
+// oldDir. The change is not committed, and is not rolled back on failure;
+// that is left to the caller.
+int chlMoveCollDataPaths(
+    rsComm_t*   _comm,
+    rodsLong_t  _resc_id,
+    const char* _coll_name,
+    const char* _vault_path,
+    const char* _old_dir,
+    const char* _new_dir ) {
+    // =-=-=-=-=-=-=-
+    // call factory for database object
+    irods::database_object_ptr db_obj_ptr;
+    irods::error ret = irods::database_factory(
+                           database_plugin_type,
+                           db_obj_ptr );
+    if ( !ret.ok() ) {
+        irods::log( PASS( ret ) );
+        return ret.code();
+    }
+
+    // =-=-=-=-=-=-=-
+    // resolve a plugin for that object
+    irods::plugin_ptr db_plug_ptr;
+    ret = db_obj_ptr->resolve(
+              irods::DATABASE_INTERFACE,
+              db_plug_ptr );
+    if ( !ret.ok() ) {
+        irods::log(
+            PASSMSG(
+                "failed to resolve database interface",
+                ret ) );
+        return ret.code();
+    }
+
+    // =-=-=-=-=-=-=-
+    // cast plugin and object to db and fco for call
+    irods::first_class_object_ptr ptr = boost::dynamic_pointer_cast <
+                                        irods::first_class_object > ( db_obj_ptr );
+    irods::database_ptr           db = boost::dynamic_pointer_cast <
+                                       irods::database > ( db_plug_ptr );
+
+    // =-=-=-=-=-=-=-
+    // call the operation on the plugin
+    ret = db->call <
+          rodsLong_t,
+          const char*,
+          const char*,
+          const char*,
+          const char* > (
+              _comm,
+              irods::DATABASE_OP_MOVE_COLL_DATA_PATHS,
+              ptr,
+              _resc_id,
+              _coll_name,
+              _vault_path,
+              _old_dir,
+              _new_dir );
+
+    return ret.code();
+
+} // chlMoveCollDataPaths
+
 // =-=-=-=-=-=-=-
 // chlRegToken - Register a new token
 int chlRegToken(
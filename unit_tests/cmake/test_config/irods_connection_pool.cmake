@@ -9,7 +9,9 @@ set(IRODS_TEST_INCLUDE_PATH ${CMAKE_BINARY_DIR}/lib/core/include
                             ${CMAKE_SOURCE_DIR}/lib/filesystem/include
                             ${CMAKE_SOURCE_DIR}/server/core/include
                             ${CMAKE_SOURCE_DIR}/server/icat/include
-                            ${IRODS_EXTERNALS_FULLPATH_CATCH2}/include)
+                            ${IRODS_EXTERNALS_FULLPATH_CATCH2}/include
+                            ${IRODS_EXTERNALS_FULLPATH_FMT}/include)
  
 set(IRODS_TEST_LINK_LIBRARIES irods_common
-                              irods_client)
+                              irods_client
+                              ${IRODS_EXTERNALS_FULLPATH_FMT}/lib/libfmt.so)
@@ -0,0 +1,175 @@
+#include "catch.hpp"
+
+#include "rodsClient.h"
+#include "connection_pool.hpp"
+#include "filesystem.hpp"
+#include "api_request_batch.hpp"
+#include "apiNumber.h"
+#include "api_plugin_number.h"
+#include "modAVUMetadata.h"
+#include "objStat.h"
+#include "rmColl.h"
+#include "irods_at_scope_exit.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+TEST_CASE("api_request_batch")
+{
+    namespace fs = irods::experimental::filesystem;
+
+    using batch = irods::experimental::api_request_batch;
+
+    load_client_api_plugins();
+
+    rodsEnv env;
+    _getRodsEnv(env);
+
+    auto conn_pool = irods::make_connection_pool();
+    auto conn = conn_pool->get_connection();
+    const auto sandbox = fs::path{env.rodsHome} / "unit_testing_sandbox";
+
+    if (!fs::client::exists(conn, sandbox)) {
+        REQUIRE(fs::client::create_collection(conn, sandbox));
+    }
+
+    irods::at_scope_exit remove_sandbox{[&conn, &sandbox] {
+        REQUIRE(fs::client::remove_all(conn, sandbox, fs::remove_options::no_trash));
+    }};
+
+    const auto missing = sandbox / "does_not_exist";
+
+    dataObjInp_t stat_sandbox_input{};
+    std::strncpy(stat_sandbox_input.objPath, sandbox.c_str(), MAX_NAME_LEN);
+
+    dataObjInp_t stat_missing_input{};
+    std::strncpy(stat_missing_input.objPath, missing.c_str(), MAX_NAME_LEN);
+
+    rodsObjStat_t* stat_sandbox_output{};
+    rodsObjStat_t* stat_missing_output{};
+
+    irods::at_scope_exit free_outputs{[&] {
+        freeRodsObjStat(stat_sandbox_output);
+        freeRodsObjStat(stat_missing_output);
+    }};
+
+    SECTION("replies are returned in request order")
+    {
+        batch b;
+        b.add(OBJ_STAT_AN, &stat_missing_input, nullptr, reinterpret_cast<void**>(&stat_missing_output));
+        b.add(OBJ_STAT_AN, &stat_sandbox_input, nullptr, reinterpret_cast<void**>(&stat_sandbox_output));
+
+        const auto statuses = b.execute(conn);
+
+        REQUIRE(statuses.size() == 2);
+        CHECK(statuses[0] == USER_FILE_DOES_NOT_EXIST);
+        CHECK(statuses[1] == COLL_OBJ_T);
+
+        REQUIRE(stat_sandbox_output);
+        CHECK(stat_sandbox_output->objType == COLL_OBJ_T);
+
+        // The connection is still in sync with the server.
+        CHECK(fs::client::is_collection(conn, sandbox));
+    }
+
+    SECTION("requests following a failure are skipped when stop_on_error is set")
+    {
+        batch b;
+        b.add(OBJ_STAT_AN, &stat_missing_input, nullptr, reinterpret_cast<void**>(&stat_missing_output));
+        b.add(OBJ_STAT_AN, &stat_sandbox_input, nullptr, reinterpret_cast<void**>(&stat_sandbox_output));
+
+        batch::options options;
+        options.stop_on_error = true;
+
+        const auto statuses = b.execute(conn, options);
+
+        REQUIRE(statuses.size() == 2);
+        CHECK(statuses[0] == USER_FILE_DOES_NOT_EXIST);
+        CHECK(statuses[1] == SYS_BATCH_REQUEST_SKIPPED);
+        CHECK_FALSE(stat_sandbox_output);
+    }
+
+    SECTION("metadata operations are applied")
+    {
+        constexpr int count = 100;
+
+        std::vector<std::string> values;
+        std::vector<modAVUMetadataInp_t> inputs(count);
+
+        for (int i = 0; i < count; ++i) {
+            values.push_back(std::to_string(i));
+        }
+
+        batch b;
+
+        for (int i = 0; i < count; ++i) {
+            auto& input = inputs[i];
+            input.arg0 = const_cast<char*>("add");
+            input.arg1 = const_cast<char*>("-C");
+            input.arg2 = const_cast<char*>(sandbox.c_str());
+            input.arg3 = const_cast<char*>("batched_attribute");
+            input.arg4 = values[i].data();
+            input.arg5 = const_cast<char*>("");
+
+            b.add(MOD_AVU_METADATA_AN, &input);
+        }
+
+        const auto statuses = b.execute(conn);
+
+        REQUIRE(statuses.size() == count);
+        CHECK(std::all_of(std::begin(statuses), std::end(statuses), [](int _ec) { return _ec == 0; }));
+
+        const auto metadata = fs::client::get_metadata(conn, sandbox);
+        CHECK(std::count_if(std::begin(metadata), std::end(metadata), [](const fs::metadata& _md) {
+            return _md.attribute == "batched_attribute";
+        }) == count);
+    }
+
+    SECTION("nested batches are rejected")
+    {
+        bytesBuf_t nested_input{};
+
+        batch b;
+        b.add(BATCH_API_REQUESTS_APN, &nested_input);
+        b.add(OBJ_STAT_AN, &stat_sandbox_input, nullptr, reinterpret_cast<void**>(&stat_sandbox_output));
+
+        const auto statuses = b.execute(conn);
+
+        REQUIRE(statuses.size() == 2);
+        CHECK(statuses[0] == SYS_INVALID_INPUT_PARAM);
+        CHECK(statuses[1] == COLL_OBJ_T);
+    }
+
+    SECTION("requests which exchange more than one reply are rejected")
+    {
+        const auto collection = sandbox / "not_removed";
+        REQUIRE(fs::client::create_collection(conn, collection));
+
+        // A recursive removal reports progress with extra messages.
+        collInp_t rm_coll_input{};
+        std::strncpy(rm_coll_input.collName, collection.c_str(), MAX_NAME_LEN);
+        addKeyVal(&rm_coll_input.condInput, RECURSIVE_OPR__KW, "");
+        addKeyVal(&rm_coll_input.condInput, FORCE_FLAG_KW, "");
+
+        irods::at_scope_exit clear_cond_input{[&rm_coll_input] { clearKeyVal(&rm_coll_input.condInput); }};
+
+        collOprStat_t* rm_coll_output{};
+        irods::at_scope_exit free_rm_coll_output{[&rm_coll_output] { std::free(rm_coll_output); }};
+
+        batch b;
+        b.add(RM_COLL_AN, &rm_coll_input, nullptr, reinterpret_cast<void**>(&rm_coll_output));
+        b.add(OBJ_STAT_AN, &stat_sandbox_input, nullptr, reinterpret_cast<void**>(&stat_sandbox_output));
+
+        const auto statuses = b.execute(conn);
+
+        REQUIRE(statuses.size() == 2);
+        CHECK(statuses[0] == SYS_NOT_SUPPORTED);
+        CHECK(statuses[1] == COLL_OBJ_T);
+
+        // The removal was not executed and the connection is still in sync with the server.
+        CHECK(fs::client::is_collection(conn, collection));
+    }
+}
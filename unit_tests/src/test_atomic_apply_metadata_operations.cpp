@@ -2,13 +2,14 @@
 
 #include "client_connection.hpp"
 #include "atomic_apply_metadata_operations.h"
-#include "filesystem/path.hpp"
+#include "filesystem.hpp"
 #include "irods_at_scope_exit.hpp"
 #include "rodsErrorTable.h"
 #include "getRodsEnv.h"
 
 #include "json.hpp"
 
+#include <algorithm>
 #include <cstdlib>
 #include <string>
 
@@ -311,6 +312,104 @@ TEST_CASE("atomic_apply_metadata_operations")
         REQUIRE(json_error_string == "{}"s);
     }
 
+    SECTION("operations are applied to every entity in 'entity_names'")
+    {
+        const auto sandbox = fs::path{user_home} / "test_atomic_apply_metadata_operations";
+        const auto c1 = sandbox / "c1";
+        const auto c2 = sandbox / "c2";
+
+        REQUIRE(fs::client::create_collections(conn, c1));
+        REQUIRE(fs::client::create_collection(conn, c2));
+
+        irods::at_scope_exit remove_sandbox{[&] {
+            fs::client::remove_all(conn, sandbox, fs::remove_options::no_trash);
+        }};
+
+        const auto json_input = json{
+            {"entity_names", json::array({c1.string(), c2.string(), c1.string()})},
+            {"entity_type", "collection"},
+            {"operations", json::array({
+                {
+                    {"operation", "add"},
+                    {"attribute", "a0"},
+                    {"value", "v0"},
+                    {"units", "u0"}
+                },
+                {
+                    {"operation", "add"},
+                    {"attribute", "a1"},
+                    {"value", "v1"}
+                },
+                {
+                    {"operation", "remove"},
+                    {"attribute", "a1"},
+                    {"value", "v1"}
+                },
+                {
+                    {"operation", "remove"},
+                    {"attribute", "a2"},
+                    {"value", "v2"}
+                },
+                {
+                    {"operation", "add"},
+                    {"attribute", "a2"},
+                    {"value", "v2"}
+                }
+            })}
+        }.dump();
+
+        char* json_error_string{};
+        irods::at_scope_exit free_memory{[&json_error_string] { std::free(json_error_string); }};
+
+        REQUIRE(rc_atomic_apply_metadata_operations(conn_ptr, json_input.c_str(), &json_error_string) == 0);
+        REQUIRE(json_error_string == "{}"s);
+
+        for (auto&& collection : {c1, c2}) {
+            auto md = fs::client::get_metadata(conn, collection);
+
+            std::sort(std::begin(md), std::end(md), [](auto&& _lhs, auto&& _rhs) {
+                return _lhs.attribute < _rhs.attribute;
+            });
+
+            REQUIRE(md.size() == 2);
+            CHECK(md[0].attribute == "a0");
+            CHECK(md[0].value == "v0");
+            CHECK(md[0].units == "u0");
+            CHECK(md[1].attribute == "a2");
+            CHECK(md[1].value == "v2");
+        }
+    }
+
+    SECTION("no entity is modified when one of the entities does not exist")
+    {
+        const auto sandbox = fs::path{user_home} / "test_atomic_apply_metadata_operations";
+
+        REQUIRE(fs::client::create_collection(conn, sandbox));
+
+        irods::at_scope_exit remove_sandbox{[&] {
+            fs::client::remove_all(conn, sandbox, fs::remove_options::no_trash);
+        }};
+
+        const auto json_input = json{
+            {"entity_names", json::array({sandbox.string(), (sandbox / "does_not_exist").string()})},
+            {"entity_type", "collection"},
+            {"operations", json::array({
+                {
+                    {"operation", "add"},
+                    {"attribute", "a0"},
+                    {"value", "v0"}
+                }
+            })}
+        }.dump();
+
+        char* json_error_string{};
+        irods::at_scope_exit free_memory{[&json_error_string] { std::free(json_error_string); }};
+
+        REQUIRE(rc_atomic_apply_metadata_operations(conn_ptr, json_input.c_str(), &json_error_string) == SYS_INVALID_INPUT_PARAM);
+        REQUIRE(contains_error_information(json_error_string));
+        CHECK(fs::client::get_metadata(conn, sandbox).empty());
+    }
+
     SECTION("do not accept empty attribute names")
     {
         const auto json_input = json{
@@ -0,0 +1,110 @@
+#include "catch.hpp"
+
+#include "rodsClient.h"
+#include "connection_pool.hpp"
+#include "filesystem.hpp"
+#include "bulk_data_object_register.h"
+#include "dataObjUnlink.h"
+#include "irods_at_scope_exit.hpp"
+
+#include <json.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+TEST_CASE("bulk_data_object_register")
+{
+    // clang-format off
+    namespace fs = irods::experimental::filesystem;
+    using json   = nlohmann::json;
+    // clang-format on
+
+    load_client_api_plugins();
+
+    rodsEnv env;
+    _getRodsEnv(env);
+
+    auto conn_pool = irods::make_connection_pool();
+    auto conn = conn_pool->get_connection();
+    const auto sandbox = fs::path{env.rodsHome} / "unit_testing_sandbox";
+
+    if (!fs::client::exists(conn, sandbox)) {
+        REQUIRE(fs::client::create_collection(conn, sandbox));
+    }
+
+    // The physical paths do not exist, so the data objects are only unregistered.
+    irods::at_scope_exit remove_sandbox{[&conn, &sandbox] {
+        for (auto&& e : fs::client::recursive_collection_iterator{conn, sandbox}) {
+            if (fs::client::is_data_object(e.status())) {
+                dataObjInp_t input{};
+                input.oprType = UNREG_OPR;
+                std::snprintf(input.objPath, sizeof(input.objPath), "%s", e.path().c_str());
+                addKeyVal(&input.condInput, FORCE_FLAG_KW, "");
+                rcDataObjUnlink(static_cast<rcComm_t*>(conn), &input);
+                clearKeyVal(&input.condInput);
+            }
+        }
+
+        REQUIRE(fs::client::remove_all(conn, sandbox, fs::remove_options::no_trash));
+    }};
+
+    REQUIRE(fs::client::create_collection(conn, sandbox / "a"));
+    REQUIRE(fs::client::create_collection(conn, sandbox / "b"));
+
+    const auto make_entry = [&env](const fs::path& _path, rodsLong_t _size) {
+        return json{
+            {"logical_path", _path.c_str()},
+            {"resource_hierarchy", env.rodsDefResource},
+            {"physical_path", "/tmp/bulk_data_object_register" + _path.string()},
+            {"data_size", _size}
+        };
+    };
+
+    const auto do_register = [&conn](const json& _input, char** _output) {
+        return rc_bulk_data_object_register(static_cast<rcComm_t*>(conn), _input.dump().c_str(), _output);
+    };
+
+    SECTION("data objects in several collections are registered together")
+    {
+        const json input{{"data_objects", {
+            make_entry(sandbox / "a" / "foo", 3),
+            make_entry(sandbox / "a" / "bar", 4),
+            make_entry(sandbox / "b" / "baz", 5)
+        }}};
+
+        char* json_output = nullptr;
+        irods::at_scope_exit free_memory{[&json_output] { std::free(json_output); }};
+
+        REQUIRE(do_register(input, &json_output) == 0);
+
+        const auto output = json::parse(json_output).at("data_objects");
+        REQUIRE(output.size() == 3);
+        CHECK(output[0].at("logical_path") == (sandbox / "a" / "foo").string());
+        CHECK(output[0].at("data_id") != output[1].at("data_id"));
+        CHECK(output[1].at("data_id") != output[2].at("data_id"));
+
+        CHECK(fs::client::data_object_size(conn, sandbox / "a" / "foo") == 3);
+        CHECK(fs::client::data_object_size(conn, sandbox / "a" / "bar") == 4);
+        CHECK(fs::client::data_object_size(conn, sandbox / "b" / "baz") == 5);
+    }
+
+    SECTION("nothing is registered when one entry fails")
+    {
+        const json input{{"data_objects", {
+            make_entry(sandbox / "a" / "foo", 3),
+            make_entry(sandbox / "missing" / "bar", 4)
+        }}};
+
+        char* json_output = nullptr;
+        REQUIRE(do_register(input, &json_output) == CAT_UNKNOWN_COLLECTION);
+        CHECK_FALSE(fs::client::exists(conn, sandbox / "a" / "foo"));
+    }
+
+    SECTION("invalid input is rejected")
+    {
+        char* json_output = nullptr;
+        const json input{{"data_objects", {{{"logical_path", "relative/path"}}}}};
+        REQUIRE(do_register(input, &json_output) == INPUT_ARG_NOT_WELL_FORMED_ERR);
+    }
+}
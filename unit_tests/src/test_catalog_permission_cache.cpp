@@ -0,0 +1,162 @@
+#include "catch.hpp"
+
+#include "catalog_permission_cache.hpp"
+#include "irods_at_scope_exit.hpp"
+
+#include <chrono>
+#include <set>
+#include <string>
+#include <thread>
+
+namespace cpc = irods::catalog_permission_cache;
+
+using namespace std::chrono_literals;
+
+namespace
+{
+    const std::string USER = "rods";
+    const std::string ZONE = "tempZone";
+    const std::string MODIFY = "modify object";
+    const std::string READ = "read object";
+} // anonymous namespace
+
+TEST_CASE("catalog_permission_cache")
+{
+    cpc::init(60s);
+    irods::at_scope_exit cleanup{[] { cpc::deinit(); }};
+
+    REQUIRE(cpc::enabled());
+
+    SECTION("collection entries are keyed by collection, user and access level")
+    {
+        CHECK_FALSE(cpc::lookup_collection("/tempZone/home/rods", USER, ZONE, MODIFY));
+
+        cpc::insert_collection("/tempZone/home/rods", USER, ZONE, MODIFY, {10001, true});
+
+        const auto p = cpc::lookup_collection("/tempZone/home/rods", USER, ZONE, MODIFY);
+        REQUIRE(p);
+        CHECK(p->collection_id == 10001);
+        REQUIRE(p->inheritance);
+        CHECK(*p->inheritance);
+
+        CHECK_FALSE(cpc::lookup_collection("/tempZone/home/rods", USER, ZONE, READ));
+        CHECK_FALSE(cpc::lookup_collection("/tempZone/home/rods", "alice", ZONE, MODIFY));
+        CHECK_FALSE(cpc::lookup_collection("/tempZone/home/rods", USER, "otherZone", MODIFY));
+        CHECK_FALSE(cpc::lookup_collection("/tempZone/home", USER, ZONE, MODIFY));
+
+        const auto stats = cpc::get_statistics();
+        CHECK(stats.hits == 1);
+        CHECK(stats.misses == 5);
+    }
+
+    SECTION("an entry holding the inheritance flag is not replaced by one without it")
+    {
+        cpc::insert_collection("/tempZone/home/rods", USER, ZONE, MODIFY, {10001, false});
+        cpc::insert_collection("/tempZone/home/rods", USER, ZONE, MODIFY, {10001, std::nullopt});
+
+        auto p = cpc::lookup_collection("/tempZone/home/rods", USER, ZONE, MODIFY);
+        REQUIRE(p);
+        REQUIRE(p->inheritance);
+        CHECK_FALSE(*p->inheritance);
+
+        cpc::insert_collection("/tempZone/home/rods", USER, ZONE, MODIFY, {10001, true});
+
+        p = cpc::lookup_collection("/tempZone/home/rods", USER, ZONE, MODIFY);
+        REQUIRE(p);
+        REQUIRE(p->inheritance);
+        CHECK(*p->inheritance);
+    }
+
+    SECTION("erasing a collection erases the collections under it")
+    {
+        cpc::insert_collection("/tempZone/home/rods", USER, ZONE, MODIFY, {1, std::nullopt});
+        cpc::insert_collection("/tempZone/home/rods/a", USER, ZONE, MODIFY, {2, std::nullopt});
+        cpc::insert_collection("/tempZone/home/rods/a/b", USER, ZONE, READ, {3, std::nullopt});
+        cpc::insert_collection("/tempZone/home/rods_other", USER, ZONE, MODIFY, {4, std::nullopt});
+
+        cpc::erase_collection("/tempZone/home/rods");
+
+        CHECK_FALSE(cpc::lookup_collection("/tempZone/home/rods", USER, ZONE, MODIFY));
+        CHECK_FALSE(cpc::lookup_collection("/tempZone/home/rods/a", USER, ZONE, MODIFY));
+        CHECK_FALSE(cpc::lookup_collection("/tempZone/home/rods/a/b", USER, ZONE, READ));
+
+        // Shares a prefix but is not under the erased collection.
+        CHECK(cpc::lookup_collection("/tempZone/home/rods_other", USER, ZONE, MODIFY));
+
+        CHECK(cpc::get_statistics().invalidations == 3);
+    }
+
+    SECTION("group memberships are cached per user")
+    {
+        CHECK_FALSE(cpc::lookup_groups(USER, ZONE));
+
+        cpc::insert_groups(USER, ZONE, {"public", "rodsadmin"});
+
+        const auto groups = cpc::lookup_groups(USER, ZONE);
+        REQUIRE(groups);
+        CHECK(*groups == std::set<std::string>{"public", "rodsadmin"});
+
+        CHECK_FALSE(cpc::lookup_groups("alice", ZONE));
+    }
+
+    SECTION("clear_collections keeps the group memberships")
+    {
+        cpc::insert_collection("/tempZone/home/rods", USER, ZONE, MODIFY, {1, std::nullopt});
+        cpc::insert_groups(USER, ZONE, {"public"});
+
+        cpc::clear_collections();
+
+        CHECK_FALSE(cpc::lookup_collection("/tempZone/home/rods", USER, ZONE, MODIFY));
+        CHECK(cpc::lookup_groups(USER, ZONE));
+
+        cpc::clear();
+
+        CHECK_FALSE(cpc::lookup_groups(USER, ZONE));
+    }
+
+    SECTION("the number of entries is bounded")
+    {
+        // The cache holds at most 1000 collection entries.
+        for (int i = 0; i <= 1000; ++i) {
+            cpc::insert_collection("/tempZone/home/rods/c" + std::to_string(i), USER, ZONE, MODIFY, {i, std::nullopt});
+        }
+
+        CHECK(cpc::get_statistics().invalidations == 1);
+
+        // The oldest entry makes room for the newest one.
+        CHECK_FALSE(cpc::lookup_collection("/tempZone/home/rods/c0", USER, ZONE, MODIFY));
+        CHECK(cpc::lookup_collection("/tempZone/home/rods/c1000", USER, ZONE, MODIFY));
+    }
+}
+
+TEST_CASE("catalog_permission_cache expiration")
+{
+    cpc::init(1s);
+    irods::at_scope_exit cleanup{[] { cpc::deinit(); }};
+
+    cpc::insert_collection("/tempZone/home/rods", USER, ZONE, MODIFY, {1, std::nullopt});
+    cpc::insert_groups(USER, ZONE, {"public"});
+
+    REQUIRE(cpc::lookup_collection("/tempZone/home/rods", USER, ZONE, MODIFY));
+    REQUIRE(cpc::lookup_groups(USER, ZONE));
+
+    std::this_thread::sleep_for(2s);
+
+    CHECK_FALSE(cpc::lookup_collection("/tempZone/home/rods", USER, ZONE, MODIFY));
+    CHECK_FALSE(cpc::lookup_groups(USER, ZONE));
+    CHECK(cpc::get_statistics().invalidations == 2);
+}
+
+TEST_CASE("catalog_permission_cache disabled")
+{
+    cpc::init(0s);
+    irods::at_scope_exit cleanup{[] { cpc::deinit(); }};
+
+    CHECK_FALSE(cpc::enabled());
+
+    cpc::insert_collection("/tempZone/home/rods", USER, ZONE, MODIFY, {1, std::nullopt});
+    cpc::insert_groups(USER, ZONE, {"public"});
+
+    CHECK_FALSE(cpc::lookup_collection("/tempZone/home/rods", USER, ZONE, MODIFY));
+    CHECK_FALSE(cpc::lookup_groups(USER, ZONE));
+}
@@ -4,9 +4,42 @@
 #include "rcConnect.h"
 #include "client_connection.hpp"
 #include "filesystem.hpp"
+#include "getMiscSvrInfo.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <utility>
 
 namespace ix = irods::experimental;
 
+namespace
+{
+    // Returns the read and write system calls made by this process so far, from /proc/self/io.
+    auto syscall_counts() -> std::pair<long long, long long>
+    {
+        std::ifstream in{"/proc/self/io"};
+        long long reads = 0;
+        long long writes = 0;
+
+        for (std::string name; in >> name;) {
+            if (name == "syscr:") {
+                in >> reads;
+            }
+            else if (name == "syscw:") {
+                in >> writes;
+            }
+            else {
+                in.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+            }
+        }
+
+        return {reads, writes};
+    } // syscall_counts
+} // anonymous namespace
+
 TEST_CASE("connect using default constructor", "client_connection")
 {
     ix::client_connection conn;
@@ -121,3 +154,29 @@ TEST_CASE("supports implicit and explicit casts to underlying type", "client_con
     REQUIRE(ix::filesystem::client::exists(*conn_ptr, "/"));
 }
 
+
+TEST_CASE("small api request latency and system calls", "[.][benchmark]")
+{
+    using clock_type = std::chrono::steady_clock;
+
+    constexpr int iterations = 10'000;
+
+    ix::client_connection conn;
+    REQUIRE(conn);
+
+    const auto [reads_before, writes_before] = syscall_counts();
+    const auto start = clock_type::now();
+
+    for (int i = 0; i < iterations; ++i) {
+        miscSvrInfo_t* info{};
+        REQUIRE(rcGetMiscSvrInfo(static_cast<RcComm*>(conn), &info) == 0);
+        std::free(info);
+    }
+
+    const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(clock_type::now() - start);
+    const auto [reads_after, writes_after] = syscall_counts();
+
+    WARN("round trip: " << elapsed.count() / iterations << " microseconds, "
+         "reads per call: " << static_cast<double>(reads_after - reads_before) / iterations << ", "
+         "writes per call: " << static_cast<double>(writes_after - writes_before) / iterations);
+}
@@ -0,0 +1,180 @@
+#include "catch.hpp"
+
+#include "rodsClient.h"
+#include "connection_pool.hpp"
+#include "dstream.hpp"
+#include "transport/default_transport.hpp"
+#include "filesystem.hpp"
+#include "collection_checksum.h"
+#include "irods_at_scope_exit.hpp"
+
+#include <json.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+TEST_CASE("collection_checksum")
+{
+    // clang-format off
+    namespace fs = irods::experimental::filesystem;
+    namespace io = irods::experimental::io;
+    using json   = nlohmann::json;
+    // clang-format on
+
+    load_client_api_plugins();
+
+    rodsEnv env;
+    _getRodsEnv(env);
+
+    auto conn_pool = irods::make_connection_pool();
+    auto conn = conn_pool->get_connection();
+    const auto sandbox = fs::path{env.rodsHome} / "unit_testing_sandbox";
+
+    if (!fs::client::exists(conn, sandbox)) {
+        REQUIRE(fs::client::create_collection(conn, sandbox));
+    }
+
+    irods::at_scope_exit remove_sandbox{[&conn, &sandbox] {
+        REQUIRE(fs::client::remove_all(conn, sandbox, fs::remove_options::no_trash));
+    }};
+
+    REQUIRE(fs::client::create_collection(conn, sandbox / "a"));
+
+    const std::vector<fs::path> data_objects{
+        sandbox / "f1.txt",
+        sandbox / "f2.txt",
+        sandbox / "a" / "f3.txt"
+    };
+
+    // Guarantees that the streams are closed before the checksums are verified.
+    for (auto&& p : data_objects) {
+        io::client::default_transport tp{conn};
+        io::odstream{tp, p} << p.object_name().string();
+    }
+
+    const auto call = [&conn](const json& _input) {
+        char* json_output = nullptr;
+
+        irods::at_scope_exit free_memory{[&json_output] {
+            if (json_output) {
+                std::free(json_output);
+            }
+        }};
+
+        REQUIRE(rc_collection_checksum(static_cast<rcComm_t*>(conn), _input.dump().c_str(), &json_output) == 0);
+
+        return json::parse(json_output);
+    };
+
+    // Runs a job to completion. Returns the results of every batch and the final progress.
+    const auto run = [&call](const json& _input) {
+        json results = json::array();
+        json progress;
+
+        for (auto output = call(_input);; output = call({{"handle", output.at("handle")}})) {
+            for (auto&& r : output.at("results")) {
+                results.push_back(r);
+            }
+
+            progress = output.at("progress");
+
+            if (!output.contains("handle")) {
+                break;
+            }
+        }
+
+        return std::make_pair(results, progress);
+    };
+
+    const auto count_status = [](const json& _results, const std::string& _status) {
+        return std::count_if(std::begin(_results), std::end(_results), [&_status](const json& _r) {
+            return _r.at("status") == _status;
+        });
+    };
+
+    SECTION("missing checksums are reported without being registered")
+    {
+        const auto [results, progress] = run({{"collection", sandbox.c_str()}, {"batch_size", 2}});
+
+        CHECK(progress.at("replicas") == 3);
+        CHECK(progress.at("missing") == 3);
+        CHECK(count_status(results, "missing") == 3);
+
+        for (auto&& p : data_objects) {
+            CHECK(fs::client::data_object_checksum(conn, p).empty());
+        }
+    }
+
+    SECTION("verify only never writes to the catalog")
+    {
+        const auto [results, progress] = run({{"collection", sandbox.c_str()}, {"verify_only", true}, {"compute_missing", true}});
+
+        CHECK(progress.at("missing") == 3);
+        CHECK(progress.at("computed") == 0);
+
+        for (auto&& p : data_objects) {
+            CHECK(fs::client::data_object_checksum(conn, p).empty());
+        }
+    }
+
+    SECTION("missing checksums are computed and then verified")
+    {
+        {
+            const auto [results, progress] = run({{"collection", sandbox.c_str()}, {"compute_missing", true}, {"batch_size", 1}});
+
+            CHECK(progress.at("replicas") == 3);
+            CHECK(progress.at("computed") == 3);
+            CHECK(progress.at("failed") == 0);
+            REQUIRE(count_status(results, "computed") == 3);
+
+            for (auto&& r : results) {
+                const auto checksum = fs::client::data_object_checksum(conn, r.at("logical_path").get<std::string>());
+                CHECK_FALSE(checksum.empty());
+                CHECK(r.at("computed_checksum") == checksum);
+            }
+        }
+
+        const auto [results, progress] = run({{"collection", sandbox.c_str()}, {"verify_only", true}});
+
+        CHECK(results.empty());
+        CHECK(progress.at("replicas") == 3);
+        CHECK(progress.at("verified") == 3);
+    }
+
+    SECTION("only the replicas under the collection are visited")
+    {
+        const auto [results, progress] = run({{"collection", (sandbox / "a").c_str()}});
+
+        CHECK(progress.at("replicas") == 1);
+        REQUIRE(results.size() == 1);
+        CHECK(results[0].at("logical_path") == (sandbox / "a" / "f3.txt").string());
+    }
+
+    SECTION("jobs can be closed before the last batch")
+    {
+        const auto output = call({{"collection", sandbox.c_str()}, {"batch_size", 1}});
+        REQUIRE(output.contains("handle"));
+
+        call({{"handle", output.at("handle")}, {"close", true}});
+
+        char* json_output = nullptr;
+        const auto input = json{{"handle", output.at("handle")}}.dump();
+        REQUIRE(rc_collection_checksum(static_cast<rcComm_t*>(conn), input.c_str(), &json_output) == SYS_INVALID_INPUT_PARAM);
+    }
+
+    SECTION("invalid input is rejected")
+    {
+        char* json_output = nullptr;
+
+        auto input = json{{"collection", data_objects[0].c_str()}}.dump();
+        CHECK(rc_collection_checksum(static_cast<rcComm_t*>(conn), input.c_str(), &json_output) == CAT_NAME_EXISTS_AS_DATAOBJ);
+
+        input = json{{"collection", sandbox.c_str()}, {"batch_size", 0}}.dump();
+        CHECK(rc_collection_checksum(static_cast<rcComm_t*>(conn), input.c_str(), &json_output) == SYS_INVALID_INPUT_PARAM);
+
+        input = json{{"collection", "relative/path"}}.dump();
+        CHECK(rc_collection_checksum(static_cast<rcComm_t*>(conn), input.c_str(), &json_output) == SYS_INVALID_INPUT_PARAM);
+    }
+}
@@ -5,6 +5,19 @@
 #include "filesystem.hpp"
 #include "irods_at_scope_exit.hpp"
 
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <iostream>
+#include <set>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
 TEST_CASE("connection pool")
 {
     rodsEnv env;
@@ -104,5 +117,175 @@ TEST_CASE("connection pool")
 
         REQUIRE(released_conn_ptr);
     }
+
+    SECTION("get_connection blocks until a connection is returned to the pool")
+    {
+        auto conn_pool = irods::make_connection_pool();
+
+        auto conn = conn_pool->get_connection();
+        REQUIRE(conn);
+
+        // The only connection is in use, so waiting for a connection times out.
+        REQUIRE_FALSE(conn_pool->try_get_connection(100ms));
+
+        std::thread t{[&conn] {
+            std::this_thread::sleep_for(200ms);
+            conn = {};
+        }};
+
+        irods::at_scope_exit join{[&t] { t.join(); }};
+
+        // Show that the waiting thread receives the connection once it is returned.
+        auto other_conn = conn_pool->get_connection();
+        REQUIRE(other_conn);
+    }
+
+    SECTION("the pool grows on demand up to the maximum size")
+    {
+        irods::connection_pool_options options;
+        options.min_size = 1;
+        options.max_size = 3;
+
+        auto conn_pool = irods::make_connection_pool(options);
+
+        std::vector<irods::connection_pool::connection_proxy> conns;
+        std::set<rcComm_t*> distinct_conns;
+
+        for (int i = 0; i < options.max_size; ++i) {
+            auto conn = conn_pool->try_get_connection(1s);
+            REQUIRE(conn);
+            distinct_conns.insert(static_cast<rcComm_t*>(conn));
+            conns.push_back(std::move(conn));
+        }
+
+        REQUIRE(distinct_conns.size() == static_cast<std::size_t>(options.max_size));
+
+        // Show that the pool does not grow beyond the maximum size.
+        REQUIRE_FALSE(conn_pool->try_get_connection(100ms));
+
+        // Show that the connections created on demand are usable.
+        namespace fs = irods::experimental::filesystem;
+
+        for (auto& conn : conns) {
+            REQUIRE(fs::client::exists(conn, env.rodsHome));
+        }
+    }
+
+    SECTION("pools with background maintenance hand out usable connections")
+    {
+        irods::connection_pool_options options;
+        options.min_size = 1;
+        options.max_size = 2;
+        options.idle_timeout = 1s;
+        options.health_check_interval = 1s;
+
+        auto conn_pool = irods::make_connection_pool(options);
+
+        {
+            auto c0 = conn_pool->get_connection();
+            auto c1 = conn_pool->get_connection();
+        }
+
+        // Give the background thread time to close the idle connection and check
+        // the remaining one.
+        std::this_thread::sleep_for(3s);
+
+        namespace fs = irods::experimental::filesystem;
+
+        auto c0 = conn_pool->get_connection();
+        auto c1 = conn_pool->get_connection();
+        REQUIRE(fs::client::exists(c0, env.rodsHome));
+        REQUIRE(fs::client::exists(c1, env.rodsHome));
+    }
 }
 
+TEST_CASE("connection pool contention", "[connection_pool][benchmark]")
+{
+    namespace fs = irods::experimental::filesystem;
+
+    rodsEnv env;
+    _getRodsEnv(env);
+
+    constexpr int pool_size = 4;
+    constexpr int thread_count = 16;
+
+    SECTION("waiting threads do not consume CPU")
+    {
+        auto conn_pool = irods::make_connection_pool(pool_size);
+
+        // Hold every connection while the other threads wait.
+        std::vector<irods::connection_pool::connection_proxy> held;
+        for (int i = 0; i < pool_size; ++i) {
+            held.push_back(conn_pool->get_connection());
+        }
+
+        std::atomic<int> acquired{};
+        std::vector<std::thread> threads;
+
+        const auto cpu_start = std::clock();
+
+        for (int i = 0; i < thread_count; ++i) {
+            threads.emplace_back([&conn_pool, &acquired] {
+                auto conn = conn_pool->get_connection();
+                ++acquired;
+            });
+        }
+
+        std::this_thread::sleep_for(1s);
+
+        const auto cpu_seconds = static_cast<double>(std::clock() - cpu_start) / CLOCKS_PER_SEC;
+
+        held.clear();
+
+        for (auto& t : threads) {
+            t.join();
+        }
+
+        std::cout << fmt::format("connection pool: {} threads waited 1s on {} connections using {:.3f}s of CPU time.\n",
+                                 thread_count, pool_size, cpu_seconds);
+
+        REQUIRE(acquired.load() == thread_count);
+
+        // Spinning threads would use roughly one second of CPU time each.
+        REQUIRE(cpu_seconds < 0.5);
+    }
+
+    SECTION("throughput of many threads sharing a small pool")
+    {
+        constexpr int iterations_per_thread = 50;
+
+        auto conn_pool = irods::make_connection_pool(pool_size);
+
+        std::atomic<int> operations{};
+        std::vector<std::thread> threads;
+
+        const auto start = std::chrono::steady_clock::now();
+        const auto cpu_start = std::clock();
+
+        for (int i = 0; i < thread_count; ++i) {
+            threads.emplace_back([&conn_pool, &operations, &env] {
+                for (int j = 0; j < iterations_per_thread; ++j) {
+                    auto conn = conn_pool->get_connection();
+
+                    if (fs::client::exists(conn, env.rodsHome)) {
+                        ++operations;
+                    }
+                }
+            });
+        }
+
+        for (auto& t : threads) {
+            t.join();
+        }
+
+        const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        const auto cpu_seconds = static_cast<double>(std::clock() - cpu_start) / CLOCKS_PER_SEC;
+
+        std::cout << fmt::format("connection pool: {} operations by {} threads on {} connections "
+                                 "in {:.3f}s ({:.1f} ops/s, {:.3f}s of CPU time).\n",
+                                 operations.load(), thread_count, pool_size, elapsed,
+                                 operations.load() / elapsed, cpu_seconds);
+
+        REQUIRE(operations.load() == thread_count * iterations_per_thread);
+    }
+}
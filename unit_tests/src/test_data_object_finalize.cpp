@@ -7,10 +7,13 @@
 #include "data_object_finalize.h"
 #include "data_object_proxy.hpp"
 #include "dataObjRepl.h"
+#include "dataObjWrite.h"
 #include "dstream.hpp"
 #include "filesystem.hpp"
 #include "irods_at_scope_exit.hpp"
 #include "replica.hpp"
+#include "replica_close.h"
+#include "replica_open.h"
 #include "replica_proxy.hpp"
 #include "resource_administration.hpp"
 #include "transport/default_transport.hpp"
@@ -21,8 +24,11 @@
 
 #include <cstdlib>
 #include <chrono>
+#include <cstring>
 #include <iostream>
+#include <string>
 #include <thread>
+#include <vector>
 
 namespace fs = irods::experimental::filesystem;
 namespace id = irods::experimental::data_object;
@@ -261,3 +267,114 @@ TEST_CASE("invalid inputs", "[invalid]")
         CHECK(!output.at("error_message").get<std::string>().empty());
     }
 }
+
+TEST_CASE("close latency by replica count", "[.][benchmark]")
+{
+    using namespace std::string_literals;
+    namespace adm = irods::experimental::administration;
+
+    load_client_api_plugins();
+
+    constexpr int max_replica_count = 10;
+    constexpr int iterations = 50;
+
+    std::vector<std::string> resources;
+
+    for (int i = 0; i < max_replica_count; ++i) {
+        resources.push_back(fmt::format("data_object_finalize_benchmark_resc_{}", i));
+    }
+
+    irods::at_scope_exit remove_resources{[&resources] {
+        irods::experimental::client_connection conn;
+        RcComm& comm = static_cast<RcComm&>(conn);
+
+        for (auto&& r : resources) {
+            adm::client::remove_resource(comm, r);
+        }
+    }};
+
+    {
+        irods::experimental::client_connection conn;
+        RcComm& comm = static_cast<RcComm&>(conn);
+
+        for (auto&& r : resources) {
+            if (const auto [ec, exists] = adm::client::resource_exists(comm, r); exists) {
+                REQUIRE(adm::client::remove_resource(comm, r));
+            }
+
+            REQUIRE(unit_test_utils::add_ufs_resource(comm, r, "vault_for_"s + r));
+        }
+    }
+
+    // reset connection so resources exist
+    irods::experimental::client_connection conn;
+    RcComm& comm = static_cast<RcComm&>(conn);
+
+    rodsEnv env;
+    _getRodsEnv(env);
+
+    const auto sandbox = fs::path{env.rodsHome} / "test_data_object_finalize_benchmark";
+
+    if (!fs::client::exists(comm, sandbox)) {
+        REQUIRE(fs::client::create_collection(comm, sandbox));
+    }
+
+    irods::at_scope_exit remove_sandbox{[&sandbox] {
+        irods::experimental::client_connection conn;
+        RcComm& comm = static_cast<RcComm&>(conn);
+
+        REQUIRE(fs::client::remove_all(comm, sandbox, fs::remove_options::no_trash));
+    }};
+
+    for (const int replica_count : {1, 3, 10}) {
+        const auto target_object = sandbox / fmt::format("object_with_{}_replicas", replica_count);
+
+        {
+            io::client::default_transport tp{comm};
+            io::odstream{tp, target_object, io::root_resource_name{resources[0]}};
+        }
+
+        for (int i = 1; i < replica_count; ++i) {
+            REQUIRE(unit_test_utils::replicate_data_object(comm, target_object.c_str(), resources[i]));
+        }
+
+        std::chrono::steady_clock::duration elapsed{};
+
+        for (int i = 0; i < iterations; ++i) {
+            DataObjInp open_input{};
+            std::strcpy(open_input.objPath, target_object.c_str());
+            open_input.openFlags = O_WRONLY;
+            addKeyVal(&open_input.condInput, RESC_NAME_KW, resources[0].c_str());
+            irods::at_scope_exit clear_open_input{[&open_input] { clearKeyVal(&open_input.condInput); }};
+
+            char* json_output{};
+            irods::at_scope_exit free_json_output{[&json_output] { std::free(json_output); }};
+
+            const auto fd = rc_replica_open(&comm, &open_input, &json_output);
+            REQUIRE(fd >= 3);
+
+            std::string contents = "benchmark";
+
+            OpenedDataObjInp write_input{};
+            write_input.l1descInx = fd;
+
+            BytesBuf bbuf{};
+            bbuf.buf = contents.data();
+            bbuf.len = static_cast<int>(contents.size());
+
+            REQUIRE(rcDataObjWrite(&comm, &write_input, &bbuf) == bbuf.len);
+
+            const auto close_input = json{{"fd", fd}}.dump();
+
+            const auto start = std::chrono::steady_clock::now();
+            REQUIRE(rc_replica_close(&comm, close_input.c_str()) == 0);
+            elapsed += std::chrono::steady_clock::now() - start;
+        }
+
+        const auto mean = std::chrono::duration_cast<std::chrono::microseconds>(elapsed / iterations);
+        std::cout << fmt::format("replicas: {}, mean close latency: {} us\n", replica_count, mean.count());
+
+        auto [op, lm] = id::make_data_object_proxy(comm, target_object);
+        CHECK(op.replica_count() == replica_count);
+    }
+}
@@ -12,7 +12,10 @@
 #include <boost/filesystem.hpp>
 #include <fmt/format.h>
 
+#include <algorithm>
 #include <chrono>
+#include <cstdlib>
+#include <cstring>
 #include <string_view>
 
 #include <unistd.h>
@@ -303,6 +306,129 @@ TEST_CASE("dstream", "[iostreams]")
         ds.read(buf, 2);
         REQUIRE(std::string_view(buf, 2) == "cd");
     }
+
+    SECTION("small sequential reads and seeks return the correct bytes")
+    {
+        const auto path = sandbox / "data_object.txt";
+
+        // Large enough for the server to read ahead several times.
+        std::string contents(1024 * 1024, '\0');
+        for (std::size_t i = 0; i < contents.size(); ++i) {
+            contents[i] = static_cast<char>('a' + i % 26);
+        }
+
+        {
+            io::client::native_transport tp{conn};
+            io::odstream{tp, path}.write(contents.data(), contents.size());
+        }
+
+        DataObjInp open_inp{};
+        std::strncpy(open_inp.objPath, path.c_str(), sizeof(open_inp.objPath) - 1);
+        open_inp.openFlags = O_RDONLY;
+
+        const auto fd = rcDataObjOpen(static_cast<rcComm_t*>(conn), &open_inp);
+        REQUIRE(fd > 2);
+
+        irods::at_scope_exit close_fd{[&conn, fd] {
+            OpenedDataObjInp close_inp{};
+            close_inp.l1descInx = fd;
+            REQUIRE(rcDataObjClose(static_cast<rcComm_t*>(conn), &close_inp) >= 0);
+        }};
+
+        const auto read_and_compare = [&conn, &contents, fd](std::size_t _offset, int _length) {
+            char buf[4096]{};
+
+            OpenedDataObjInp read_inp{};
+            read_inp.l1descInx = fd;
+            read_inp.len = _length;
+
+            bytesBuf_t bbuf{};
+            bbuf.buf = buf;
+            bbuf.len = _length;
+
+            const auto bytes_read = rcDataObjRead(static_cast<rcComm_t*>(conn), &read_inp, &bbuf);
+            const auto expected = std::min<std::size_t>(_length, contents.size() - _offset);
+            REQUIRE(bytes_read == static_cast<int>(expected));
+            REQUIRE(std::string_view(buf, expected) == std::string_view(contents).substr(_offset, expected));
+        };
+
+        std::size_t offset = 0;
+
+        for (int i = 0; i < 100; ++i, offset += 1000) {
+            read_and_compare(offset, 1000);
+        }
+
+        // Seek relative to the current position. The server has read ahead of the client.
+        OpenedDataObjInp seek_inp{};
+        seek_inp.l1descInx = fd;
+        seek_inp.offset = -500;
+        seek_inp.whence = SEEK_CUR;
+
+        FileLseekOut* seek_out{};
+        REQUIRE(rcDataObjLseek(static_cast<rcComm_t*>(conn), &seek_inp, &seek_out) >= 0);
+        irods::at_scope_exit free_seek_out{[&seek_out] { std::free(seek_out); }};
+        offset -= 500;
+        REQUIRE(seek_out->offset == static_cast<rodsLong_t>(offset));
+
+        // Read through the end of the data object.
+        for (; offset < contents.size(); offset += 4096) {
+            read_and_compare(offset, 4096);
+        }
+    }
+
+    SECTION("sequential reads of unaligned sizes are not cut short by the read-ahead buffer")
+    {
+        const auto path = sandbox / "data_object.txt";
+
+        std::string contents(256 * 1024 + 123, '\0');
+        for (std::size_t i = 0; i < contents.size(); ++i) {
+            contents[i] = static_cast<char>('a' + i % 26);
+        }
+
+        {
+            io::client::native_transport tp{conn};
+            io::odstream{tp, path}.write(contents.data(), contents.size());
+        }
+
+        DataObjInp open_inp{};
+        std::strncpy(open_inp.objPath, path.c_str(), sizeof(open_inp.objPath) - 1);
+        open_inp.openFlags = O_RDONLY;
+
+        const auto fd = rcDataObjOpen(static_cast<rcComm_t*>(conn), &open_inp);
+        REQUIRE(fd > 2);
+
+        irods::at_scope_exit close_fd{[&conn, fd] {
+            OpenedDataObjInp close_inp{};
+            close_inp.l1descInx = fd;
+            REQUIRE(rcDataObjClose(static_cast<rcComm_t*>(conn), &close_inp) >= 0);
+        }};
+
+        // None of the sizes divides the read-ahead windows they cause, so most requests are
+        // larger than what is left in the buffer.
+        constexpr int lengths[] = {1000, 1777, 3333, 4096, 777};
+
+        std::size_t offset = 0;
+
+        for (std::size_t i = 0; offset < contents.size(); ++i) {
+            const auto length = lengths[i % std::size(lengths)];
+            char buf[4096]{};
+
+            OpenedDataObjInp read_inp{};
+            read_inp.l1descInx = fd;
+            read_inp.len = length;
+
+            bytesBuf_t bbuf{};
+            bbuf.buf = buf;
+            bbuf.len = length;
+
+            const auto bytes_read = rcDataObjRead(static_cast<rcComm_t*>(conn), &read_inp, &bbuf);
+            const auto expected = std::min<std::size_t>(length, contents.size() - offset);
+            REQUIRE(bytes_read == static_cast<int>(expected));
+            REQUIRE(std::string_view(buf, expected) == std::string_view(contents).substr(offset, expected));
+
+            offset += expected;
+        }
+    }
 }
 
 auto get_hostname() noexcept -> std::string
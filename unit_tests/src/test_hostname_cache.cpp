@@ -4,8 +4,15 @@
 #include "irods_at_scope_exit.hpp"
 
 #include <string_view>
+#include <string>
 #include <chrono>
 #include <thread>
+#include <vector>
+#include <iostream>
+
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
 
 namespace hnc = irods::experimental::net::hostname_cache;
 
@@ -69,3 +76,64 @@ TEST_CASE("hostname_cache")
     }
 }
 
+
+TEST_CASE("hostname_cache contention", "[benchmark]")
+{
+    hnc::init("irods_hostname_cache_test", 1'000'000);
+    irods::at_scope_exit cleanup{[] { hnc::deinit(); }};
+
+    constexpr int key_count = 500;
+    constexpr int process_count = 16;
+    constexpr int lookups_per_process = 200'000;
+
+    const auto make_key = [](int _i) { return "host_" + std::to_string(_i); };
+    const auto make_alias = [](int _i) { return "host_" + std::to_string(_i) + ".irods.org"; };
+
+    for (int i = 0; i < key_count; ++i) {
+        REQUIRE(hnc::insert_or_assign(make_key(i), make_alias(i), 600s));
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+
+    // Every child looks up the same keys, like agents resolving the same hosts. The first
+    // child keeps updating the entries while the others read them. A child exits with a
+    // non-zero status if it observes a missing or inconsistent entry.
+    std::vector<pid_t> children;
+
+    for (int p = 0; p < process_count; ++p) {
+        const auto pid = fork();
+        REQUIRE(pid >= 0);
+
+        if (0 == pid) {
+            int errors = 0;
+
+            for (int n = 0; n < lookups_per_process; ++n) {
+                const auto i = n % key_count;
+
+                if (0 == p) {
+                    hnc::insert_or_assign(make_key(i), make_alias(i), 600s);
+                }
+                else if (const auto alias = hnc::lookup(make_key(i)); !alias || *alias != make_alias(i)) {
+                    ++errors;
+                }
+            }
+
+            _exit(errors > 0 ? 1 : 0);
+        }
+
+        children.push_back(pid);
+    }
+
+    for (auto pid : children) {
+        int status = 0;
+        REQUIRE(waitpid(pid, &status, 0) == pid);
+        REQUIRE(WIFEXITED(status));
+        REQUIRE(WEXITSTATUS(status) == 0);
+    }
+
+    const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const auto operations = static_cast<double>(process_count) * lookups_per_process;
+
+    std::cout << "hostname_cache: " << process_count << " processes performed " << operations
+              << " operations in " << elapsed << "s (" << operations / elapsed << " ops/s).\n";
+}
@@ -0,0 +1,170 @@
+#include "catch.hpp"
+
+#include "latency_histograms.hpp"
+#include "irods_at_scope_exit.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <optional>
+#include <string>
+
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace lh = irods::experimental::latency_histograms;
+
+using namespace std::chrono_literals;
+
+namespace
+{
+    auto find_histogram(lh::category _kind, const std::string& _name) -> std::optional<lh::histogram>
+    {
+        const auto all = lh::histograms();
+        const auto iter = std::find_if(std::begin(all), std::end(all), [&](const lh::histogram& _h) {
+            return _h.kind == _kind && _h.name == _name;
+        });
+
+        if (std::end(all) == iter) {
+            return std::nullopt;
+        }
+
+        return *iter;
+    }
+} // anonymous namespace
+
+TEST_CASE("latency_histograms")
+{
+    const std::string api_name = "api_obj_stat";
+    const std::string plugin_operation = "resource_read";
+    const std::string db_operation = "database_reg_data_obj";
+
+    SECTION("recording does nothing when not initialized")
+    {
+        REQUIRE_FALSE(lh::enabled());
+
+        lh::record_api(633, api_name, 1ms);
+        { lh::scoped_timer timer{plugin_operation}; }
+
+        CHECK(lh::histograms().empty());
+        CHECK(lh::to_prometheus_text().empty());
+    }
+
+    lh::init("irods_latency_histograms_test", 4);
+    irods::at_scope_exit cleanup{[] { lh::deinit(); }};
+
+    REQUIRE(lh::enabled());
+
+    SECTION("latencies are counted in buckets")
+    {
+        lh::record_api(633, api_name, 500ns);
+        lh::record_api(633, api_name, 1500ns);
+        lh::record_api(633, api_name, 1600ns);
+        lh::record_api(633, api_name, 1h);
+        lh::record_api(633, api_name, 2h);
+
+        const auto h = find_histogram(lh::category::api, api_name);
+        REQUIRE(h);
+        CHECK(h->api_number == 633);
+        CHECK(h->count == 5);
+        CHECK(h->sum == 500ns + 1500ns + 1600ns + 1h + 2h);
+
+        REQUIRE(h->buckets.size() == 4);
+        CHECK(h->buckets[0].upper_bound == 1024ns);
+        CHECK(h->buckets[0].count == 1);
+        CHECK(h->buckets[1].upper_bound == 1536ns);
+        CHECK(h->buckets[1].count == 1);
+        CHECK(h->buckets[2].upper_bound == 1792ns);
+        CHECK(h->buckets[2].count == 1);
+        CHECK(h->buckets[3].count == 2);
+        CHECK(h->buckets[3].upper_bound == std::chrono::nanoseconds::max());
+
+        // Between 1 microsecond and 18 minutes, buckets are at most 25% wide.
+        lh::record_api(700, api_name, 3ms);
+
+        const auto other = lh::histograms();
+        const auto iter = std::find_if(std::begin(other), std::end(other), [](auto& _h) { return _h.api_number == 700; });
+        REQUIRE(iter != std::end(other));
+        REQUIRE(iter->buckets.size() == 1);
+        CHECK(iter->buckets[0].upper_bound > 3ms);
+        CHECK(iter->buckets[0].upper_bound <= 3ms * 1.25);
+    }
+
+    SECTION("database operations are separated from plugin operations")
+    {
+        { lh::scoped_timer timer{plugin_operation}; }
+        { lh::scoped_timer timer{db_operation}; }
+
+        CHECK(find_histogram(lh::category::plugin_operation, plugin_operation));
+        CHECK(find_histogram(lh::category::database_operation, db_operation));
+        CHECK_FALSE(find_histogram(lh::category::plugin_operation, db_operation));
+    }
+
+    SECTION("latencies recorded by child processes are visible to the parent")
+    {
+        if (const auto pid = fork(); 0 == pid) {
+            lh::record_api(633, api_name, 2ms);
+            lh::record_plugin_operation(plugin_operation, 2ms);
+            _exit(0);
+        }
+        else {
+            REQUIRE(pid > 0);
+            waitpid(pid, nullptr, 0);
+        }
+
+        lh::record_api(633, api_name, 2ms);
+
+        const auto h = find_histogram(lh::category::api, api_name);
+        REQUIRE(h);
+        CHECK(h->count == 2);
+
+        CHECK(find_histogram(lh::category::plugin_operation, plugin_operation));
+    }
+
+    SECTION("latencies are not recorded once the maximum number of histograms is reached")
+    {
+        for (int api_number = 1; api_number <= 5; ++api_number) {
+            lh::record_api(api_number, api_name, 1ms);
+        }
+
+        CHECK(lh::histograms().size() == 4);
+    }
+
+    SECTION("histograms are rendered in the Prometheus text format")
+    {
+        lh::record_api(633, api_name, 1500ns);
+        lh::record_api(633, api_name, 3ms);
+        lh::record_plugin_operation(db_operation, 20us);
+
+        const auto text = lh::to_prometheus_text("host\"1");
+
+        CHECK(text.find("# TYPE irods_api_latency_seconds histogram\n") != std::string::npos);
+        CHECK(text.find(R"_(irods_api_latency_seconds_bucket{host="host\"1",api_number="633",api_name="api_obj_stat",le="1.536e-06"} 1)_") != std::string::npos);
+        CHECK(text.find(R"_(irods_api_latency_seconds_bucket{host="host\"1",api_number="633",api_name="api_obj_stat",le="+Inf"} 2)_") != std::string::npos);
+        CHECK(text.find(R"_(irods_api_latency_seconds_count{host="host\"1",api_number="633",api_name="api_obj_stat"} 2)_") != std::string::npos);
+        CHECK(text.find(R"_(irods_database_operation_latency_seconds_count{host="host\"1",operation="database_reg_data_obj"} 1)_") != std::string::npos);
+        CHECK(text.find("irods_plugin_operation_latency_seconds") == std::string::npos);
+    }
+}
+
+TEST_CASE("latency_histograms overhead", "[.][benchmark]")
+{
+    lh::init("irods_latency_histograms_test", 16);
+    irods::at_scope_exit cleanup{[] { lh::deinit(); }};
+
+    const std::string api_name = "api_obj_stat";
+    const std::string operation = "resource_read";
+    constexpr int iterations = 1'000'000;
+
+    const auto start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < iterations; ++i) {
+        lh::scoped_timer api_timer{633, api_name};
+        lh::scoped_timer operation_timer{operation};
+    }
+
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    // Two timers per iteration.
+    CHECK(elapsed / (2 * iterations) < 500ns);
+}
@@ -0,0 +1,180 @@
+#include "catch.hpp"
+
+#include "rodsClient.h"
+#include "connection_pool.hpp"
+#include "dstream.hpp"
+#include "transport/default_transport.hpp"
+#include "filesystem.hpp"
+#include "list_collection.h"
+#include "irods_at_scope_exit.hpp"
+
+#include <json.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+TEST_CASE("list_collection")
+{
+    // clang-format off
+    namespace fs = irods::experimental::filesystem;
+    namespace io = irods::experimental::io;
+    using json   = nlohmann::json;
+    // clang-format on
+
+    load_client_api_plugins();
+
+    rodsEnv env;
+    _getRodsEnv(env);
+
+    auto conn_pool = irods::make_connection_pool();
+    auto conn = conn_pool->get_connection();
+    const auto sandbox = fs::path{env.rodsHome} / "unit_testing_sandbox";
+
+    if (!fs::client::exists(conn, sandbox)) {
+        REQUIRE(fs::client::create_collection(conn, sandbox));
+    }
+
+    irods::at_scope_exit remove_sandbox{[&conn, &sandbox] {
+        REQUIRE(fs::client::remove_all(conn, sandbox, fs::remove_options::no_trash));
+    }};
+
+    REQUIRE(fs::client::create_collection(conn, sandbox / "a"));
+    REQUIRE(fs::client::create_collection(conn, sandbox / "b"));
+
+    // The sizes are the reverse of the order of the names.
+    const std::vector<std::pair<std::string, std::string>> data_objects{
+        {"f1.txt", "333"},
+        {"f2.txt", "22"},
+        {"f3.txt", "1"}
+    };
+
+    // Guarantees that the streams are closed before the catalog is queried.
+    for (auto&& [name, contents] : data_objects) {
+        io::client::default_transport tp{conn};
+        io::odstream{tp, sandbox / name} << contents;
+    }
+
+    const auto list = [&conn](const json& _input) {
+        char* json_output = nullptr;
+
+        irods::at_scope_exit free_memory{[&json_output] {
+            if (json_output) {
+                std::free(json_output);
+            }
+        }};
+
+        REQUIRE(rc_list_collection(static_cast<rcComm_t*>(conn), _input.dump().c_str(), &json_output) == 0);
+
+        return json::parse(json_output);
+    };
+
+    // Returns the names of the entries of every page of a listing.
+    const auto list_names = [&list](const json& _input) {
+        std::vector<std::string> names;
+
+        for (auto page = list(_input);; page = list({{"handle", page.at("handle")}})) {
+            for (auto&& e : page.at("entries")) {
+                names.push_back(e.at(1).get<std::string>());
+            }
+
+            if (!page.contains("handle")) {
+                break;
+            }
+        }
+
+        return names;
+    };
+
+    SECTION("data objects are listed before collections with the requested columns")
+    {
+        const auto output = list({{"collection", sandbox.c_str()}, {"columns", {"size", "replicas", "checksum"}}});
+
+        REQUIRE(output.at("columns") == json::array({"type", "name", "size", "replicas", "checksum"}));
+        REQUIRE_FALSE(output.contains("handle"));
+
+        const auto& entries = output.at("entries");
+        REQUIRE(entries.size() == 5);
+
+        CHECK(entries[0] == json::array({"d", "f1.txt", 3, 1, ""}));
+        CHECK(entries[1] == json::array({"d", "f2.txt", 2, 1, ""}));
+        CHECK(entries[2] == json::array({"d", "f3.txt", 1, 1, ""}));
+        CHECK(entries[3] == json::array({"c", "a", nullptr, nullptr, nullptr}));
+        CHECK(entries[4] == json::array({"c", "b", nullptr, nullptr, nullptr}));
+    }
+
+    SECTION("entries are returned in pages")
+    {
+        const auto names = list_names({{"collection", sandbox.c_str()}, {"page_size", 2}});
+        CHECK(names == std::vector<std::string>{"f1.txt", "f2.txt", "f3.txt", "a", "b"});
+    }
+
+    SECTION("entries are sorted by the server")
+    {
+        CHECK(list_names({{"collection", sandbox.c_str()}, {"sort", "size"}, {"page_size", 2}}) ==
+              std::vector<std::string>{"f3.txt", "f2.txt", "f1.txt", "a", "b"});
+
+        CHECK(list_names({{"collection", sandbox.c_str()}, {"descending", true}}) ==
+              std::vector<std::string>{"f3.txt", "f2.txt", "f1.txt", "b", "a"});
+    }
+
+    SECTION("listings can be closed before the last page")
+    {
+        const auto output = list({{"collection", sandbox.c_str()}, {"page_size", 1}});
+        REQUIRE(output.contains("handle"));
+
+        list({{"handle", output.at("handle")}, {"close", true}});
+
+        char* json_output = nullptr;
+        const auto input = json{{"handle", output.at("handle")}}.dump();
+        REQUIRE(rc_list_collection(static_cast<rcComm_t*>(conn), input.c_str(), &json_output) == SYS_INVALID_INPUT_PARAM);
+    }
+
+    SECTION("invalid input is rejected")
+    {
+        char* json_output = nullptr;
+        const auto input = json{{"collection", sandbox.c_str()}, {"columns", json::array({"resource"})}}.dump();
+        REQUIRE(rc_list_collection(static_cast<rcComm_t*>(conn), input.c_str(), &json_output) == INPUT_ARG_NOT_WELL_FORMED_ERR);
+    }
+
+    SECTION("collections with a single quote in their path are left to rcOpenCollection")
+    {
+        const auto quoted = sandbox / "it's";
+        REQUIRE(fs::client::create_collection(conn, quoted));
+
+        {
+            io::client::default_transport tp{conn};
+            io::odstream{tp, quoted / "f4.txt"} << "f4";
+        }
+
+        char* json_output = nullptr;
+        const auto input = json{{"collection", quoted.c_str()}}.dump();
+        REQUIRE(rc_list_collection(static_cast<rcComm_t*>(conn), input.c_str(), &json_output) == SYS_NOT_SUPPORTED);
+
+        std::vector<std::string> paths;
+
+        for (auto&& e : fs::client::collection_iterator{conn, quoted}) {
+            paths.push_back(e.path().string());
+        }
+
+        CHECK(paths == std::vector<std::string>{(quoted / "f4.txt").string()});
+    }
+
+    SECTION("the collection iterator returns the same entries when prefetching")
+    {
+        const auto collect = [&conn, &sandbox](fs::client::collection_options _opts) {
+            std::vector<std::string> paths;
+
+            for (auto&& e : fs::client::collection_iterator{conn, sandbox, _opts}) {
+                paths.push_back(e.path().string());
+            }
+
+            std::sort(std::begin(paths), std::end(paths));
+
+            return paths;
+        };
+
+        CHECK(collect(fs::client::collection_options::prefetch) == collect(fs::client::collection_options::none));
+    }
+}
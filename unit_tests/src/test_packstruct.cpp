@@ -4,9 +4,19 @@
 #include "irods_server_properties.hpp"
 #include "rcGlobalExtern.h"
 #include "irods_at_scope_exit.hpp"
+#include "rcMisc.h"
+#include "rodsGenQuery.h"
 
+#include <boost/endian/conversion.hpp>
+
+#include <chrono>
+#include <cstdint>
 #include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
 #include <string_view>
+#include <vector>
 
 TEST_CASE("packstruct xml encoding")
 {
@@ -104,3 +114,374 @@ TEST_CASE("packstruct xml encoding")
     }
 }
 
+
+namespace
+{
+    auto make_data_obj_inp(const std::string& _path, const std::vector<std::pair<std::string, std::string>>& _kvps) -> DataObjInp
+    {
+        DataObjInp input{};
+        std::strncpy(input.objPath, _path.c_str(), sizeof(input.objPath) - 1);
+        input.createMode = 0600;
+        input.openFlags = -42;
+        input.offset = -1234567890123LL;
+        input.dataSize = 9876543210987LL;
+        input.numThreads = 16;
+        input.oprType = 7;
+
+        for (auto&& [k, v] : _kvps) {
+            addKeyVal(&input.condInput, k.c_str(), v.c_str());
+        }
+
+        return input;
+    }
+
+    auto round_trip(const DataObjInp& _input, irodsProt_t _protocol) -> void
+    {
+        BytesBuf* packed = nullptr;
+        irods::at_scope_exit free_packed{[&packed] { freeBBuf(packed); }};
+
+        REQUIRE(pack_struct(&_input, &packed, "DataObjInp_PI", nullptr, 0, _protocol, nullptr) == 0);
+        REQUIRE(packed);
+
+        DataObjInp* unpacked = nullptr;
+        irods::at_scope_exit free_unpacked{[&unpacked] {
+            if (unpacked) {
+                clearKeyVal(&unpacked->condInput);
+                std::free(unpacked);
+            }
+        }};
+
+        REQUIRE(unpack_struct_with_length(packed->buf, packed->len, (void**) &unpacked, "DataObjInp_PI", nullptr, _protocol, nullptr) == 0);
+        REQUIRE(unpacked);
+
+        CHECK(std::string_view{unpacked->objPath} == _input.objPath);
+        CHECK(unpacked->createMode == _input.createMode);
+        CHECK(unpacked->openFlags == _input.openFlags);
+        CHECK(unpacked->offset == _input.offset);
+        CHECK(unpacked->dataSize == _input.dataSize);
+        CHECK(unpacked->numThreads == _input.numThreads);
+        CHECK(unpacked->oprType == _input.oprType);
+        CHECK(unpacked->specColl == nullptr);
+        REQUIRE(unpacked->condInput.len == _input.condInput.len);
+
+        for (int i = 0; i < _input.condInput.len; ++i) {
+            CHECK(std::string_view{unpacked->condInput.keyWord[i]} == _input.condInput.keyWord[i]);
+            CHECK(std::string_view{unpacked->condInput.value[i]} == _input.condInput.value[i]);
+        }
+    }
+
+    auto make_gen_query_out(int _rows, int _columns, int _column_width) -> GenQueryOut
+    {
+        GenQueryOut out{};
+        out.rowCnt = _rows;
+        out.attriCnt = _columns;
+        out.continueInx = 1;
+        out.totalRowCount = _rows;
+
+        for (int c = 0; c < _columns; ++c) {
+            auto& r = out.sqlResult[c];
+            r.attriInx = COL_DATA_NAME + c;
+            r.len = _column_width;
+            r.value = static_cast<char*>(std::calloc(_rows, _column_width));
+
+            for (int i = 0; i < _rows; ++i) {
+                std::snprintf(r.value + i * _column_width, _column_width, "/tempZone/home/rods/<coll_%d>/file & %d", c, i);
+            }
+        }
+
+        return out;
+    }
+
+    // Unpacks the first _len bytes of a BINARY_PROT DataObjInp from a buffer of exactly that
+    // size, so that any read past the end is outside the allocation.
+    auto unpack_binary_prefix(const BytesBuf& _packed, std::size_t _len) -> int
+    {
+        std::vector<char> prefix(static_cast<const char*>(_packed.buf), static_cast<const char*>(_packed.buf) + _len);
+
+        DataObjInp* unpacked = nullptr;
+        const auto ec = unpack_struct_with_length(prefix.data(), static_cast<int>(_len), (void**) &unpacked, "DataObjInp_PI", nullptr, BINARY_PROT, nullptr);
+
+        if (unpacked) {
+            clearKeyVal(&unpacked->condInput);
+            std::free(unpacked);
+        }
+
+        return ec;
+    }
+} // anonymous namespace
+
+TEST_CASE("packstruct binary encoding")
+{
+    const auto input = make_data_obj_inp(R"_(/tempZone/home/rods/aaa`'"<&test&>"'`_file)_",
+                                         {{"resc_hier", "demoResc;child"}, {"metadata", "a<b>&c;d"}, {"empty", ""}});
+    irods::at_scope_exit free_input{[&input] { clearKeyVal(const_cast<KeyValPair*>(&input.condInput)); }};
+
+    SECTION("round trip")
+    {
+        round_trip(input, BINARY_PROT);
+    }
+
+    SECTION("strings are length-prefixed and not escaped")
+    {
+        BytesBuf* packed = nullptr;
+        irods::at_scope_exit free_packed{[&packed] { freeBBuf(packed); }};
+
+        REQUIRE(pack_struct(&input, &packed, "DataObjInp_PI", nullptr, 0, BINARY_PROT, nullptr) == 0);
+
+        const auto path_len = static_cast<std::uint32_t>(std::strlen(input.objPath));
+        const auto* bytes = static_cast<const unsigned char*>(packed->buf);
+
+        // The length of objPath is the first field, stored in little-endian byte order.
+        CHECK(bytes[0] == (path_len & 0xff));
+        CHECK(bytes[1] == ((path_len >> 8) & 0xff));
+        CHECK(bytes[2] == 0);
+        CHECK(bytes[3] == 0);
+        CHECK(std::string_view(reinterpret_cast<const char*>(bytes + 4), path_len) == input.objPath);
+    }
+
+    SECTION("is smaller than the xml encoding")
+    {
+        BytesBuf* binary = nullptr;
+        BytesBuf* xml = nullptr;
+        irods::at_scope_exit free_packed{[&binary, &xml] { freeBBuf(binary); freeBBuf(xml); }};
+
+        REQUIRE(pack_struct(&input, &binary, "DataObjInp_PI", nullptr, 0, BINARY_PROT, nullptr) == 0);
+        REQUIRE(pack_struct(&input, &xml, "DataObjInp_PI", nullptr, 0, XML_PROT, nullptr) == 0);
+
+        CHECK(binary->len < xml->len);
+    }
+
+    SECTION("message header")
+    {
+        msgHeader_t header{};
+        std::strncpy(header.type, RODS_API_REQ_T, sizeof(header.type) - 1);
+        header.msgLen = 123;
+        header.errorLen = 0;
+        header.bsLen = 1 << 30;
+        header.intInfo = -808000;
+
+        BytesBuf* packed = nullptr;
+        irods::at_scope_exit free_packed{[&packed] { freeBBuf(packed); }};
+
+        REQUIRE(pack_struct(&header, &packed, "MsgHeader_PI", nullptr, 0, BINARY_PROT, nullptr) == 0);
+
+        // Binary headers are told apart from XML headers by their first byte.
+        REQUIRE(static_cast<const char*>(packed->buf)[0] != '<');
+
+        msgHeader_t* unpacked = nullptr;
+        irods::at_scope_exit free_unpacked{[&unpacked] { std::free(unpacked); }};
+
+        REQUIRE(unpack_struct_with_length(packed->buf, packed->len, (void**) &unpacked, "MsgHeader_PI", nullptr, BINARY_PROT, nullptr) == 0);
+        CHECK(std::string_view{unpacked->type} == RODS_API_REQ_T);
+        CHECK(unpacked->msgLen == header.msgLen);
+        CHECK(unpacked->errorLen == header.errorLen);
+        CHECK(unpacked->bsLen == header.bsLen);
+        CHECK(unpacked->intInfo == header.intInfo);
+    }
+
+    SECTION("input without a length is rejected")
+    {
+        BytesBuf* packed = nullptr;
+        irods::at_scope_exit free_packed{[&packed] { freeBBuf(packed); }};
+
+        REQUIRE(pack_struct(&input, &packed, "DataObjInp_PI", nullptr, 0, BINARY_PROT, nullptr) == 0);
+
+        DataObjInp* unpacked = nullptr;
+        CHECK(unpack_struct(packed->buf, (void**) &unpacked, "DataObjInp_PI", nullptr, BINARY_PROT, nullptr) == USER_PACKSTRUCT_INPUT_ERR);
+        CHECK(unpacked == nullptr);
+    }
+
+    SECTION("strings longer than the packing instruction allows are rejected")
+    {
+        BytesBuf* packed = nullptr;
+        irods::at_scope_exit free_packed{[&packed] { freeBBuf(packed); }};
+
+        msgHeader_t header{};
+        std::memset(header.type, 'x', sizeof(header.type));
+
+        CHECK(pack_struct(&header, &packed, "MsgHeader_PI", nullptr, 0, BINARY_PROT, nullptr) == USER_PACKSTRUCT_INPUT_ERR);
+    }
+}
+
+TEST_CASE("packstruct genquery output round trip")
+{
+    auto out = make_gen_query_out(250, 3, 64);
+    irods::at_scope_exit free_out{[&out] { clearGenQueryOut(&out); }};
+
+    for (auto protocol : {NATIVE_PROT, XML_PROT, BINARY_PROT}) {
+        DYNAMIC_SECTION("protocol " << protocol)
+        {
+            BytesBuf* packed = nullptr;
+            irods::at_scope_exit free_packed{[&packed] { freeBBuf(packed); }};
+
+            REQUIRE(pack_struct(&out, &packed, "GenQueryOut_PI", nullptr, 0, protocol, nullptr) == 0);
+
+            GenQueryOut* unpacked = nullptr;
+            irods::at_scope_exit free_unpacked{[&unpacked] { freeGenQueryOut(&unpacked); }};
+
+            REQUIRE(unpack_struct_with_length(packed->buf, packed->len, (void**) &unpacked, "GenQueryOut_PI", nullptr, protocol, nullptr) == 0);
+            REQUIRE(unpacked->rowCnt == out.rowCnt);
+            REQUIRE(unpacked->attriCnt == out.attriCnt);
+
+            for (int c = 0; c < out.attriCnt; ++c) {
+                const auto& expected = out.sqlResult[c];
+                const auto& actual = unpacked->sqlResult[c];
+
+                REQUIRE(actual.attriInx == expected.attriInx);
+                REQUIRE(actual.len == expected.len);
+
+                for (int i = 0; i < out.rowCnt; ++i) {
+                    REQUIRE(std::string_view{actual.value + i * actual.len} == expected.value + i * expected.len);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("packstruct round trip fuzzing")
+{
+    // A fixed seed keeps failures reproducible.
+    std::mt19937 gen{20221019};
+    std::uniform_int_distribution<int> printable{0x20, 0x7e};
+    std::uniform_int_distribution<int> length{0, 200};
+    std::uniform_int_distribution<int> kvp_count{0, 8};
+
+    const auto random_string = [&](int _max_length) {
+        std::string s(std::min(length(gen), _max_length), ' ');
+        for (auto& c : s) {
+            c = static_cast<char>(printable(gen));
+        }
+        return s;
+    };
+
+    for (int iteration = 0; iteration < 200; ++iteration) {
+        std::vector<std::pair<std::string, std::string>> kvps;
+        for (int i = kvp_count(gen); i > 0; --i) {
+            // Keywords are never empty in practice.
+            kvps.emplace_back("k" + random_string(NAME_LEN - 2), random_string(MAX_NAME_LEN - 1));
+        }
+
+        auto input = make_data_obj_inp(random_string(MAX_NAME_LEN - 1), kvps);
+        irods::at_scope_exit free_input{[&input] { clearKeyVal(&input.condInput); }};
+
+        // The XML encoding formats doubles into 20 bytes, which limits them to 18 digits and a sign.
+        input.offset = std::uniform_int_distribution<rodsLong_t>{-999'999'999'999'999'999, 999'999'999'999'999'999}(gen);
+        input.openFlags = std::uniform_int_distribution<int>{}(gen);
+
+        for (auto protocol : {NATIVE_PROT, XML_PROT, BINARY_PROT}) {
+            round_trip(input, protocol);
+        }
+
+        BytesBuf* packed = nullptr;
+        irods::at_scope_exit free_packed{[&packed] { freeBBuf(packed); }};
+
+        REQUIRE(pack_struct(&input, &packed, "DataObjInp_PI", nullptr, 0, BINARY_PROT, nullptr) == 0);
+
+        // Truncated input is rejected. Without keywords, the input ends with the null markers
+        // of the empty keyword arrays, which are not required to decode the structure.
+        const auto truncated_len = std::uniform_int_distribution<int>{0, packed->len - 1}(gen);
+        const auto ec = unpack_binary_prefix(*packed, truncated_len);
+
+        if (!kvps.empty()) {
+            CHECK(ec < 0);
+        }
+
+        // A string length larger than the rest of the input is rejected before anything is
+        // copied or allocated. objPath is the first field.
+        std::uint32_t oversized = std::uniform_int_distribution<std::uint32_t>{static_cast<std::uint32_t>(packed->len)}(gen);
+        oversized = boost::endian::native_to_little(oversized);
+        std::memcpy(packed->buf, &oversized, sizeof(oversized));
+        CHECK(unpack_binary_prefix(*packed, packed->len) < 0);
+    }
+}
+
+TEST_CASE("packstruct binary input is bounded")
+{
+    const auto input = make_data_obj_inp("/tempZone/home/rods/file", {{"resc_hier", "demoResc"}});
+    irods::at_scope_exit free_input{[&input] { clearKeyVal(const_cast<KeyValPair*>(&input.condInput)); }};
+
+    BytesBuf* packed = nullptr;
+    irods::at_scope_exit free_packed{[&packed] { freeBBuf(packed); }};
+
+    REQUIRE(pack_struct(&input, &packed, "DataObjInp_PI", nullptr, 0, BINARY_PROT, nullptr) == 0);
+
+    SECTION("every truncation is rejected")
+    {
+        for (int len = 0; len < packed->len; ++len) {
+            CAPTURE(len);
+            CHECK(unpack_binary_prefix(*packed, len) < 0);
+        }
+
+        CHECK(unpack_binary_prefix(*packed, packed->len) == 0);
+    }
+
+    SECTION("the largest string length is rejected")
+    {
+        const std::uint32_t oversized = 0xffffffff;
+        std::memcpy(packed->buf, &oversized, sizeof(oversized));
+        CHECK(unpack_binary_prefix(*packed, packed->len) == USER_PACKSTRUCT_INPUT_ERR);
+    }
+
+    SECTION("a keyword count larger than the input is rejected")
+    {
+        // The keyword count follows objPath, the fixed-size fields and the null specColl of DataObjInp.
+        const auto path_len = std::strlen(input.objPath);
+        const auto offset = sizeof(std::uint32_t) + path_len +
+                            4 * sizeof(int) + 2 * sizeof(rodsLong_t) +
+                            sizeof(std::uint32_t) + std::strlen(NULL_PTR_PACK_STR);
+
+        REQUIRE(offset + sizeof(int) <= static_cast<std::size_t>(packed->len));
+
+        std::int32_t count;
+        std::memcpy(&count, static_cast<char*>(packed->buf) + offset, sizeof(count));
+        REQUIRE(boost::endian::little_to_native(count) == 1);
+
+        count = boost::endian::native_to_little(std::int32_t{1 << 28});
+        std::memcpy(static_cast<char*>(packed->buf) + offset, &count, sizeof(count));
+        CHECK(unpack_binary_prefix(*packed, packed->len) < 0);
+    }
+}
+
+TEST_CASE("packstruct encode and decode throughput", "[.][benchmark]")
+{
+    constexpr int rows = 5000;
+    constexpr int iterations = 20;
+
+    auto out = make_gen_query_out(rows, 4, 256);
+    irods::at_scope_exit free_out{[&out] { clearGenQueryOut(&out); }};
+
+    for (auto protocol : {NATIVE_PROT, XML_PROT, BINARY_PROT}) {
+        using clock_type = std::chrono::steady_clock;
+
+        clock_type::duration encode_time{};
+        clock_type::duration decode_time{};
+        int packed_size = 0;
+
+        for (int i = 0; i < iterations; ++i) {
+            BytesBuf* packed = nullptr;
+            irods::at_scope_exit free_packed{[&packed] { freeBBuf(packed); }};
+
+            auto start = clock_type::now();
+            REQUIRE(pack_struct(&out, &packed, "GenQueryOut_PI", nullptr, 0, protocol, nullptr) == 0);
+            encode_time += clock_type::now() - start;
+            packed_size = packed->len;
+
+            GenQueryOut* unpacked = nullptr;
+            irods::at_scope_exit free_unpacked{[&unpacked] { freeGenQueryOut(&unpacked); }};
+
+            start = clock_type::now();
+            REQUIRE(unpack_struct_with_length(packed->buf, packed->len, (void**) &unpacked, "GenQueryOut_PI", nullptr, protocol, nullptr) == 0);
+            decode_time += clock_type::now() - start;
+        }
+
+        using std::chrono::microseconds;
+        using std::chrono::duration_cast;
+
+        std::cout << "protocol=" << protocol
+                  << " rows=" << rows
+                  << " packed_bytes=" << packed_size
+                  << " encode_us=" << duration_cast<microseconds>(encode_time).count() / iterations
+                  << " decode_us=" << duration_cast<microseconds>(decode_time).count() / iterations
+                  << '\n';
+    }
+}
@@ -8,6 +8,7 @@
 #include <sys/types.h>
 #include <unistd.h>
 
+#include <chrono>
 #include <string>
 #include <utility>
 #include <vector>
@@ -284,6 +285,39 @@ TEST_CASE("replica state table", "[basic]")
         }
     }
 
+    SECTION("unknown and malformed columns are rejected")
+    {
+        constexpr int target_replica_number = 1;
+
+        const auto error_code = [](auto&& _op) -> int {
+            try {
+                _op();
+            }
+            catch (const irods::exception& e) {
+                return e.code();
+            }
+
+            return 0;
+        };
+
+        CHECK(SYS_INVALID_INPUT_PARAM == error_code([] {
+            rst::update(DATA_ID_1, target_replica_number, nlohmann::json{{"no_such_column", "value"}});
+        }));
+
+        CHECK(SYS_INVALID_INPUT_PARAM == error_code([] {
+            rst::get_property(DATA_ID_1, target_replica_number, "no_such_column", rst::state_type::after);
+        }));
+
+        CHECK(SYS_INVALID_INPUT_PARAM == error_code([] {
+            rst::update(DATA_ID_1, target_replica_number, nlohmann::json{{"data_size", "not a number"}});
+        }));
+
+        // Numeric columns accept JSON numbers as well as strings.
+        REQUIRE_NOTHROW(rst::update(DATA_ID_1, target_replica_number, nlohmann::json{{"data_size", SIZE_2}}));
+        CHECK(SIZE_2 == std::stoll(rst::get_property(DATA_ID_1, target_replica_number, "data_size", rst::state_type::after)));
+        CHECK(SIZE_1 == std::stoll(rst::get_property(DATA_ID_1, target_replica_number, "data_size", rst::state_type::before)));
+    }
+
     CHECK_NOTHROW(rst::erase(DATA_ID_1));
     CHECK_FALSE(rst::contains(DATA_ID_1));
     rst::deinit();
@@ -411,3 +445,68 @@ TEST_CASE("logical_locking", "[basic]")
     rst::deinit();
 }
 
+
+TEST_CASE("replica state table churn", "[.][benchmark]")
+{
+    using clock_type = std::chrono::steady_clock;
+
+    constexpr int replica_count = 32;
+    constexpr int iterations = 10'000;
+    constexpr int writes_per_open = 8;
+
+    rst::init();
+
+    DataObjInfo* head{};
+    DataObjInfo* prev{};
+
+    for (int i = 0; i < replica_count; ++i) {
+        auto [proxy, lm] = irods::experimental::replica::make_replica_proxy();
+        proxy.logical_path(LOGICAL_PATH_1);
+        proxy.size(SIZE_1);
+        proxy.replica_number(i);
+        proxy.data_id(DATA_ID_1);
+        proxy.replica_status(GOOD_REPLICA);
+        proxy.resource_id(i);
+
+        DataObjInfo* curr = lm.release();
+        if (!head) {
+            head = curr;
+        }
+        else {
+            prev->next = curr;
+        }
+        prev = curr;
+    }
+
+    const auto replica_list_lm = irods::experimental::lifetime_manager{*head};
+    const auto obj = irods::experimental::data_object::make_data_object_proxy(*head);
+
+    // The last replica is the one being written, which is the worst case for lookups.
+    auto [target, target_lm] = irods::experimental::replica::duplicate_replica(*prev);
+
+    const auto start = clock_type::now();
+
+    for (int i = 0; i < iterations; ++i) {
+        // open
+        REQUIRE(0 == rst::insert(obj));
+        rst::update(DATA_ID_1, replica_count - 1, nlohmann::json{{"data_is_dirty", std::to_string(INTERMEDIATE_REPLICA)}});
+
+        // write
+        for (int w = 0; w < writes_per_open; ++w) {
+            target.size(SIZE_1 + w);
+            rst::update(DATA_ID_1, target);
+            CHECK(!rst::get_property(DATA_ID_1, replica_count - 1, "data_size", rst::state_type::after).empty());
+        }
+
+        // close, which serializes the entry for the catalog
+        rst::update(DATA_ID_1, replica_count - 1, nlohmann::json{{"data_is_dirty", std::to_string(GOOD_REPLICA)}});
+        CHECK(replica_count == rst::at(DATA_ID_1).size());
+        rst::erase(DATA_ID_1);
+    }
+
+    const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(clock_type::now() - start);
+
+    WARN("open/write/close cycle with " << replica_count << " replicas: " << elapsed.count() / iterations << " microseconds");
+
+    rst::deinit();
+}
@@ -0,0 +1,121 @@
+#include "catch.hpp"
+
+#include "rodsClient.h"
+#include "connection_pool.hpp"
+#include "dstream.hpp"
+#include "transport/default_transport.hpp"
+#include "filesystem.hpp"
+#include "sync_manifest_diff.h"
+#include "irods_at_scope_exit.hpp"
+
+#include <json.hpp>
+
+#include <cstdlib>
+#include <string>
+
+TEST_CASE("sync_manifest_diff")
+{
+    // clang-format off
+    namespace fs = irods::experimental::filesystem;
+    namespace io = irods::experimental::io;
+    using json   = nlohmann::json;
+    // clang-format on
+
+    load_client_api_plugins();
+
+    rodsEnv env;
+    _getRodsEnv(env);
+
+    auto conn_pool = irods::make_connection_pool();
+    auto conn = conn_pool->get_connection();
+    const auto sandbox = fs::path{env.rodsHome} / "unit_testing_sandbox";
+
+    if (!fs::client::exists(conn, sandbox)) {
+        REQUIRE(fs::client::create_collection(conn, sandbox));
+    }
+
+    irods::at_scope_exit remove_sandbox{[&conn, &sandbox] {
+        REQUIRE(fs::client::remove_all(conn, sandbox, fs::remove_options::no_trash));
+    }};
+
+    REQUIRE(fs::client::create_collection(conn, sandbox / "a"));
+
+    // Guarantees that the stream is closed before the catalog is queried.
+    {
+        io::client::default_transport tp{conn};
+        io::odstream{tp, sandbox / "a" / "foo.txt"} << "hello";
+    }
+
+    const auto diff = [&conn](const json& _input) {
+        char* json_output = nullptr;
+
+        irods::at_scope_exit free_memory{[&json_output] {
+            if (json_output) {
+                std::free(json_output);
+            }
+        }};
+
+        REQUIRE(rc_sync_manifest_diff(static_cast<rcComm_t*>(conn), _input.dump().c_str(), &json_output) == 0);
+
+        return json::parse(json_output);
+    };
+
+    SECTION("only differing entries are returned")
+    {
+        const auto output = diff({
+            {"collection", sandbox.c_str()},
+            {"comparison", "size"},
+            {"collections", {"", "a", "b"}},
+            {"entries", {
+                {{"path", "a/foo.txt"}, {"size", 5}},
+                {{"path", "a/bar.txt"}, {"size", 5}},
+                {{"path", "b/baz.txt"}, {"size", 1}}
+            }}
+        });
+
+        REQUIRE(output.at("missing_collections") == json::array({"b"}));
+
+        const auto& entries = output.at("entries");
+        REQUIRE(entries.size() == 2);
+        CHECK(entries[0].at("path") == "a/bar.txt");
+        CHECK(entries[0].at("reason") == "missing");
+        CHECK(entries[1].at("path") == "b/baz.txt");
+        CHECK(entries[1].at("reason") == "missing");
+    }
+
+    SECTION("size mismatches are reported")
+    {
+        const auto output = diff({
+            {"collection", sandbox.c_str()},
+            {"comparison", "size"},
+            {"collections", json::array({"a"})},
+            {"entries", json::array({{{"path", "a/foo.txt"}, {"size", 6}}})}
+        });
+
+        const auto& entries = output.at("entries");
+        REQUIRE(entries.size() == 1);
+        CHECK(entries[0].at("reason") == "size");
+        CHECK(entries[0].at("data_size") == 5);
+    }
+
+    SECTION("data objects without a checksum are reported when comparing checksums")
+    {
+        const auto output = diff({
+            {"collection", sandbox.c_str()},
+            {"comparison", "checksum"},
+            {"collections", json::array({"a"})},
+            {"entries", json::array({{{"path", "a/foo.txt"}, {"size", 5}, {"checksum", "sha2:LPJNul+wow4m6DsqxbninhsWHlwfp0JecwQzYpOLmCQ="}}})}
+        });
+
+        const auto& entries = output.at("entries");
+        REQUIRE(entries.size() == 1);
+        CHECK(entries[0].at("reason") == "no_checksum");
+    }
+
+    SECTION("invalid input is rejected")
+    {
+        char* json_output = nullptr;
+        const auto input = json{{"collection", "relative/path"}, {"collections", json::array()}, {"entries", json::array()}}.dump();
+        REQUIRE(rc_sync_manifest_diff(static_cast<rcComm_t*>(conn), input.c_str(), &json_output) == INPUT_ARG_NOT_WELL_FORMED_ERR);
+    }
+}
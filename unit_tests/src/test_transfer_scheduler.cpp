@@ -0,0 +1,196 @@
+#include "catch.hpp"
+
+#include "getRodsEnv.h"
+#include "rcConnect.h"
+#include "rodsClient.h"
+#include "rodsErrorTable.h"
+#include "transfer_scheduler.hpp"
+#include "irods_at_scope_exit.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <thread>
+
+TEST_CASE("transfer_scheduler")
+{
+    rodsEnv env;
+    _getRodsEnv(env);
+
+    rErrMsg_t errors;
+    auto* conn = rcConnect(env.rodsHost, env.rodsPort, env.rodsUserName, env.rodsZone, 0, &errors);
+    REQUIRE(conn);
+
+    irods::at_scope_exit disconnect{[conn] { rcDisconnect(conn); }};
+
+    REQUIRE(clientLogin(conn) == 0);
+
+    SECTION("transfers run concurrently within the thread budget")
+    {
+        irods::transfer_scheduler::options opts;
+        opts.connections = 4;
+        opts.thread_budget = 6;
+        opts.portal_threads = 3;
+        opts.large_file_threshold = 1000;
+
+        std::atomic<int> active{};
+        std::atomic<int> threads_in_use{};
+        std::atomic<int> max_active{};
+        std::atomic<int> max_threads_in_use{};
+        std::atomic<int> completed{};
+        std::atomic<int> bad_grants{};
+
+        irods::transfer_scheduler scheduler{opts, *conn, nullptr};
+
+        for (int i = 0; i < 40; ++i) {
+            // Every fourth transfer is "large" and should be granted portal threads.
+            const rodsLong_t size = (i % 4 == 0) ? 2000 : 10;
+
+            const auto ec = scheduler.schedule(std::to_string(i), size, [&, size](rcComm_t&, int _num_threads) {
+                const int granted = size > opts.large_file_threshold ? _num_threads : 1;
+
+                // Catch assertions are not thread-safe, so count violations instead.
+                if (size > opts.large_file_threshold && (_num_threads < 1 || _num_threads > opts.portal_threads)) {
+                    ++bad_grants;
+                }
+
+                const auto a = ++active;
+                const auto t = threads_in_use += granted;
+
+                for (auto m = max_active.load(); a > m && !max_active.compare_exchange_weak(m, a);) {}
+                for (auto m = max_threads_in_use.load(); t > m && !max_threads_in_use.compare_exchange_weak(m, t);) {}
+
+                std::this_thread::sleep_for(std::chrono::milliseconds{10});
+
+                threads_in_use -= granted;
+                --active;
+                ++completed;
+
+                return 0;
+            });
+
+            REQUIRE(ec == 0);
+        }
+
+        REQUIRE(scheduler.wait() == 0);
+        REQUIRE(completed == 40);
+        REQUIRE(bad_grants == 0);
+        REQUIRE(max_active <= opts.connections);
+        REQUIRE(max_threads_in_use <= opts.thread_budget);
+    }
+
+    SECTION("restart position only advances over contiguous completions")
+    {
+        namespace fs = boost::filesystem;
+
+        const auto restart_file = fs::temp_directory_path() / fs::unique_path("irods_transfer_scheduler_%%%%%%");
+
+        rodsRestart_t restart{};
+        restart.fd = open(restart_file.c_str(), O_RDWR | O_CREAT, 0600);
+        REQUIRE(restart.fd > 0);
+
+        irods::at_scope_exit cleanup{[&restart, &restart_file] {
+            close(restart.fd);
+            fs::remove(restart_file);
+        }};
+
+        irods::transfer_scheduler::options opts;
+        opts.connections = 3;
+
+        {
+            irods::transfer_scheduler scheduler{opts, *conn, &restart};
+
+            for (int i = 0; i < 10; ++i) {
+                // The first transfer finishes last.
+                const auto delay = std::chrono::milliseconds{i == 0 ? 200 : 5};
+
+                REQUIRE(scheduler.schedule("/path/" + std::to_string(i), 1, [delay](rcComm_t&, int) {
+                    std::this_thread::sleep_for(delay);
+                    return 0;
+                }) == 0);
+            }
+
+            REQUIRE(scheduler.wait() == 0);
+        }
+
+        REQUIRE(restart.curCnt == 10);
+        REQUIRE(restart.doneCnt == 10);
+        REQUIRE(std::string{restart.lastDonePath} == "/path/9");
+    }
+
+    SECTION("the walker reads the restart state while transfers complete")
+    {
+        namespace fs = boost::filesystem;
+
+        const auto restart_file = fs::temp_directory_path() / fs::unique_path("irods_transfer_scheduler_%%%%%%");
+
+        rodsRestart_t restart{};
+        restart.fd = open(restart_file.c_str(), O_RDWR | O_CREAT, 0600);
+        REQUIRE(restart.fd > 0);
+
+        irods::at_scope_exit cleanup{[&restart, &restart_file] {
+            close(restart.fd);
+            fs::remove(restart_file);
+        }};
+
+        irods::transfer_scheduler::options opts;
+        opts.connections = 3;
+
+        irods::transfer_scheduler scheduler{opts, *conn, &restart};
+
+        int last_count = 0;
+
+        for (int i = 0; i < 20; ++i) {
+            // As chkStateForResume does, read the restart state before every transfer.
+            const auto count = scheduler.check_restart_state([&restart] { return restart.curCnt; });
+            REQUIRE(count >= last_count);
+            REQUIRE(count <= i);
+            last_count = count;
+
+            REQUIRE(scheduler.schedule("/path/" + std::to_string(i), 1, [](rcComm_t&, int) {
+                std::this_thread::sleep_for(std::chrono::milliseconds{2});
+                return 0;
+            }) == 0);
+        }
+
+        REQUIRE(scheduler.wait() == 0);
+        REQUIRE(scheduler.check_restart_state([&restart] { return restart.curCnt; }) == 20);
+    }
+
+    SECTION("a failed transfer stops the restart position and rejects new work")
+    {
+        namespace fs = boost::filesystem;
+
+        const auto restart_file = fs::temp_directory_path() / fs::unique_path("irods_transfer_scheduler_%%%%%%");
+
+        rodsRestart_t restart{};
+        restart.fd = open(restart_file.c_str(), O_RDWR | O_CREAT, 0600);
+        REQUIRE(restart.fd > 0);
+
+        irods::at_scope_exit cleanup{[&restart, &restart_file] {
+            close(restart.fd);
+            fs::remove(restart_file);
+        }};
+
+        irods::transfer_scheduler::options opts;
+        opts.connections = 1;
+
+        irods::transfer_scheduler scheduler{opts, *conn, &restart};
+
+        REQUIRE(scheduler.schedule("/path/0", 1, [](rcComm_t&, int) { return 0; }) == 0);
+        REQUIRE(scheduler.schedule("/path/1", 1, [](rcComm_t&, int) { return USER_FILE_DOES_NOT_EXIST; }) == 0);
+
+        REQUIRE(scheduler.wait() == USER_FILE_DOES_NOT_EXIST);
+        REQUIRE(restart.curCnt == 1);
+        REQUIRE(std::string{restart.lastDonePath} == "/path/0");
+
+        REQUIRE(scheduler.schedule("/path/2", 1, [](rcComm_t&, int) { return 0; }) < 0);
+    }
+}